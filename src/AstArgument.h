@@ -29,6 +29,7 @@
 #include <memory>
 #include <ostream>
 #include <string>
+#include <string_view>
 #include <utility>
 #include <vector>
 
@@ -201,7 +202,7 @@ public:
             : AstConstant(symTable.lookup(c)), symTable(symTable) {}
 
     /** @return String representation of this Constant */
-    const std::string& getConstant() const {
+    std::string_view getConstant() const {
         return symTable.resolve(getIndex());
     }
 
@@ -20,6 +20,7 @@
 #include "SrcLocation.h"
 #include "Util.h"
 
+#include <array>
 #include <limits>
 #include <memory>
 #include <typeinfo>
@@ -33,6 +34,93 @@ namespace souffle {
 
 class AstNodeMapper;
 
+/**
+ * A size-segregated pool allocator backing all AST node allocations.
+ *
+ * Frontend transformers clone subtrees heavily, producing tens of
+ * millions of short-lived small allocations. The pool bump-allocates
+ * nodes out of large chunks and recycles freed nodes through per-size
+ * free lists, so clone-and-discard passes reuse the same hot memory
+ * across transformer runs instead of round-tripping through the system
+ * allocator.
+ *
+ * The AST is built and transformed strictly sequentially; the pool is
+ * therefore not synchronized.
+ */
+class AstNodePool {
+public:
+    static AstNodePool& instance() {
+        // deliberately leaked so nodes held by statics can still be
+        // released safely during program shutdown
+        static auto* pool = new AstNodePool();
+        return *pool;
+    }
+
+    void* allocate(std::size_t size) {
+        const std::size_t index = sizeClass(size);
+        if (index >= NUM_CLASSES) {
+            return ::operator new(size);
+        }
+        if (FreeNode* node = freeLists[index]) {
+            freeLists[index] = node->next;
+            return node;
+        }
+        const std::size_t bytes = (index + 1) * ALIGNMENT;
+        if (static_cast<std::size_t>(chunkEnd - chunkPos) < bytes) {
+            chunks.push_back(std::make_unique<char[]>(CHUNK_SIZE));
+            chunkPos = chunks.back().get();
+            chunkEnd = chunkPos + CHUNK_SIZE;
+        }
+        void* res = chunkPos;
+        chunkPos += bytes;
+        return res;
+    }
+
+    void deallocate(void* ptr, std::size_t size) {
+        const std::size_t index = sizeClass(size);
+        if (index >= NUM_CLASSES) {
+            ::operator delete(ptr);
+            return;
+        }
+        auto* node = static_cast<FreeNode*>(ptr);
+        node->next = freeLists[index];
+        freeLists[index] = node;
+    }
+
+private:
+    AstNodePool() = default;
+
+    /** Freed nodes are threaded into per-size free lists in place */
+    struct FreeNode {
+        FreeNode* next;
+    };
+
+    /** Allocation granularity; chunks are max-aligned, and bumping in
+     * multiples of the maximum alignment keeps every node max-aligned */
+    static constexpr std::size_t ALIGNMENT = alignof(std::max_align_t);
+
+    /** Allocations above the largest size class - none of the node
+     * types come close - fall through to the system allocator */
+    static constexpr std::size_t NUM_CLASSES = 512 / ALIGNMENT;
+
+    /** Size of the chunks the nodes are bump-allocated from */
+    static constexpr std::size_t CHUNK_SIZE = 1 << 18;
+
+    static std::size_t sizeClass(std::size_t size) {
+        return (size + ALIGNMENT - 1) / ALIGNMENT - 1;
+    }
+
+    /** The memory chunks the pool hands out nodes from */
+    std::vector<std::unique_ptr<char[]>> chunks;
+
+    /** Bump pointer and limit within the newest chunk */
+    char* chunkPos = nullptr;
+    char* chunkEnd = nullptr;
+
+    /** Heads of the per-size-class free lists */
+    std::array<FreeNode*, NUM_CLASSES> freeLists{};
+};
+
 /**
  *  @class AstNode
  *  @brief Abstract class for syntactic elements in a Datalog program.
@@ -41,6 +129,17 @@ class AstNode {
 public:
     virtual ~AstNode() = default;
 
+    /** Nodes are allocated from the dedicated pool; the virtual
+     * destructor guarantees the sized delete receives the size of the
+     * most-derived node type, selecting the matching free list */
+    static void* operator new(std::size_t size) {
+        return AstNodePool::instance().allocate(size);
+    }
+
+    static void operator delete(void* ptr, std::size_t size) {
+        AstNodePool::instance().deallocate(ptr, size);
+    }
+
     /** Return source location of the AstNode */
     SrcLocation getSrcLoc() const {
         return location;
@@ -21,7 +21,9 @@
 #include "profile/ProgramRun.h"
 #include "profile/Reader.h"
 #include "profile/Relation.h"
+#include <fstream>
 #include <limits>
+#include <sstream>
 #include <string>
 
 namespace souffle {
@@ -36,6 +38,57 @@ void AstProfileUse::run(const AstTranslationUnit& translationUnit) {
         std::string filename = Global::config().get("profile-use");
         profile::Reader(filename, programRun).processFile();
     }
+    // a statistics catalog written by a previous evaluation serves as the
+    // default cost-model input; an explicit profile takes precedence
+    if (Global::config().has("stats-file")) {
+        loadCatalog(Global::config().get("stats-file"));
+    }
+}
+
+/**
+ * Load a statistics catalog written by a previous evaluation; a missing or
+ * stale catalog is silently ignored, since the first run of a program has
+ * no statistics yet
+ */
+void AstProfileUse::loadCatalog(const std::string& filename) {
+    std::ifstream in(filename);
+    if (!in) {
+        return;
+    }
+    std::string header;
+    if (!std::getline(in, header) || header != "souffle-stats\t1") {
+        return;
+    }
+    std::string line;
+    while (std::getline(in, line)) {
+        std::stringstream fields(line);
+        std::string kind;
+        std::string name;
+        if (!std::getline(fields, kind, '\t') || !std::getline(fields, name, '\t')) {
+            continue;
+        }
+        if (kind == "relation") {
+            size_t arity = 0;
+            size_t cardinality = 0;
+            fields >> arity;
+            fields.ignore();
+            fields >> cardinality;
+            catalog[name].cardinality = cardinality;
+            catalog[name].columnDistincts.resize(arity, 0);
+        } else if (kind == "column") {
+            size_t column = 0;
+            size_t distinct = 0;
+            fields >> column;
+            fields.ignore();
+            fields >> distinct;
+            auto pos = catalog.find(name);
+            if (pos != catalog.end() && column < pos->second.columnDistincts.size()) {
+                pos->second.columnDistincts[column] = distinct;
+            }
+        }
+        // index hit counts are recorded in the catalog but concern the
+        // RAM level; they carry no information for the AST cost model
+    }
 }
 
 /**
@@ -47,7 +100,7 @@ void AstProfileUse::print(std::ostream& os) const {}
  * Check whether relation size is defined in profile
  */
 bool AstProfileUse::hasRelationSize(const AstRelationIdentifier& rel) {
-    return programRun->getRelation(rel.getName()) != nullptr;
+    return programRun->getRelation(rel.getName()) != nullptr || catalog.count(rel.getName()) != 0;
 }
 
 /**
@@ -56,9 +109,43 @@ bool AstProfileUse::hasRelationSize(const AstRelationIdentifier& rel) {
 size_t AstProfileUse::getRelationSize(const AstRelationIdentifier& rel) {
     if (const auto* profRel = programRun->getRelation(rel.getName())) {
         return profRel->size();
-    } else {
-        return std::numeric_limits<size_t>::max();
     }
+    auto pos = catalog.find(rel.getName());
+    if (pos != catalog.end()) {
+        return pos->second.cardinality;
+    }
+    return std::numeric_limits<size_t>::max();
+}
+
+/**
+ * Get the number of fixed-point iterations of a relation from the profile;
+ * non-recursive relations and relations without profile data yield 1
+ */
+size_t AstProfileUse::getIterations(const AstRelationIdentifier& rel) {
+    if (const auto* profRel = programRun->getRelation(rel.getName())) {
+        size_t iterations = profRel->getIterations().size();
+        return iterations > 0 ? iterations : 1;
+    }
+    return 1;
+}
+
+/**
+ * Check whether the number of distinct values of a column is known
+ */
+bool AstProfileUse::hasColumnDistinct(const AstRelationIdentifier& rel, size_t column) {
+    auto pos = catalog.find(rel.getName());
+    return pos != catalog.end() && column < pos->second.columnDistincts.size();
+}
+
+/**
+ * Get the number of distinct values of a column from the statistics catalog
+ */
+size_t AstProfileUse::getColumnDistinct(const AstRelationIdentifier& rel, size_t column) {
+    auto pos = catalog.find(rel.getName());
+    if (pos != catalog.end() && column < pos->second.columnDistincts.size()) {
+        return pos->second.columnDistincts[column];
+    }
+    return std::numeric_limits<size_t>::max();
 }
 
 }  // end of namespace souffle
@@ -22,7 +22,10 @@
 #include "profile/ProgramRun.h"
 #include <cstddef>
 #include <iostream>
+#include <map>
 #include <memory>
+#include <string>
+#include <vector>
 
 namespace souffle {
 
@@ -34,6 +37,18 @@ private:
     /** performance model of profile run */
     std::shared_ptr<profile::ProgramRun> programRun;
 
+    /** statistics of one relation from a statistics catalog */
+    struct RelationStats {
+        size_t cardinality = 0;
+        std::vector<size_t> columnDistincts;
+    };
+
+    /** statistics catalog of an earlier run, used when no profile is given */
+    std::map<std::string, RelationStats> catalog;
+
+    /** Load a statistics catalog written by a previous evaluation */
+    void loadCatalog(const std::string& filename);
+
 public:
     /** Name of analysis */
     static constexpr const char* name = "profile-use";
@@ -51,6 +66,15 @@ public:
 
     /** Return size of relation in the profile */
     size_t getRelationSize(const AstRelationIdentifier& rel);
+
+    /** Return the number of fixed-point iterations recorded for a relation in the profile */
+    size_t getIterations(const AstRelationIdentifier& rel);
+
+    /** Check whether the number of distinct values of a column is known */
+    bool hasColumnDistinct(const AstRelationIdentifier& rel, size_t column);
+
+    /** Return the number of distinct values of a column from the statistics catalog */
+    size_t getColumnDistinct(const AstRelationIdentifier& rel, size_t column);
 };
 
 }  // end of namespace souffle
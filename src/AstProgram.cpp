@@ -120,6 +120,14 @@ AstFunctorDeclaration* AstProgram::getFunctorDeclaration(const std::string& name
     return (pos == functors.end()) ? nullptr : pos->second.get();
 }
 
+std::vector<const AstFunctorDeclaration*> AstProgram::getFunctorDeclarations() const {
+    std::vector<const AstFunctorDeclaration*> res;
+    for (const auto& cur : functors) {
+        res.push_back(cur.second.get());
+    }
+    return res;
+}
+
 /* Add a clause to the program */
 void AstProgram::addClause(std::unique_ptr<AstClause> clause) {
     assert(clause && "NULL clause");
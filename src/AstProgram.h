@@ -74,6 +74,9 @@ public:
     /** Get functor declaration */
     AstFunctorDeclaration* getFunctorDeclaration(const std::string& name) const;
 
+    /** Get all functor declarations in the program */
+    std::vector<const AstFunctorDeclaration*> getFunctorDeclarations() const;
+
     /** Get all relations in the program */
     std::vector<AstRelation*> getRelations() const;
 
@@ -59,9 +59,27 @@
 /* Relation uses a union relation */
 #define EQREL_RELATION (0x100)
 
+/* Relation uses a column-major (structure-of-arrays) data structure */
+#define COLUMNAR_RELATION (0x200)
+
+/* Relation uses a bitset data structure */
+#define BITSET_RELATION (0x400)
+
 /* Relation warnings are suppressed */
 #define SUPPRESSED_RELATION (0x800)
 
+/* Relation drops tuples subsumed by a smaller last attribute */
+#define SUBSUMPTION_RELATION (0x1000)
+
+/* Relation keeps the first tuple inserted for each key (all attributes but the last) */
+#define FUNCTIONAL_RELATION (0x2000)
+
+/* Relation picks its data structure at runtime after sampling the inserted data */
+#define AUTO_RELATION (0x4000)
+
+/* Relation groups tuples by their first attribute for prefix-bound scans */
+#define GROUPED_RELATION (0x8000)
+
 namespace souffle {
 
 /*!
@@ -94,6 +112,12 @@ public:
         attributes.push_back(std::move(attr));
     }
 
+    /** Remove the declared type at position @p idx */
+    void removeAttribute(size_t idx) {
+        assert(idx < attributes.size() && "Attribute index out of bounds");
+        attributes.erase(attributes.begin() + idx);
+    }
+
     /** Return the arity of this relation */
     size_t getArity() const {
         return attributes.size();
@@ -123,6 +147,18 @@ public:
             representation = RelationRepresentation::BRIE;
         } else if (q & BTREE_RELATION) {
             representation = RelationRepresentation::BTREE;
+        } else if (q & COLUMNAR_RELATION) {
+            representation = RelationRepresentation::COLUMNAR;
+        } else if (q & BITSET_RELATION) {
+            representation = RelationRepresentation::BITSET;
+        } else if (q & SUBSUMPTION_RELATION) {
+            representation = RelationRepresentation::SUBSUMPTION;
+        } else if (q & FUNCTIONAL_RELATION) {
+            representation = RelationRepresentation::FUNCTIONAL;
+        } else if (q & GROUPED_RELATION) {
+            representation = RelationRepresentation::GROUPED;
+        } else if (q & AUTO_RELATION) {
+            representation = RelationRepresentation::AUTO;
         }
 
         if (q & INPUT_RELATION) {
@@ -313,6 +349,11 @@ public:
     std::vector<AstStore*> getStores() const {
         return toPtrVector(stores);
     }
+
+    /** Removes all output directives from this relation */
+    void clearStores() {
+        stores.clear();
+    }
     std::vector<AstLoad*> getLoads() const {
         return toPtrVector(loads);
     }
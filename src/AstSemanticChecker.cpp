@@ -701,8 +701,7 @@ void AstSemanticChecker::checkRelationDeclaration(ErrorReport& report, const Typ
 }
 
 void AstSemanticChecker::checkRelation(ErrorReport& report, const TypeEnvironment& typeEnv,
-        const AstProgram& program, const AstRelation& relation, const RecursiveClauses& recursiveClauses,
-        const IOType& ioTypes) {
+        const AstProgram& program, const AstRelation& relation, const IOType& ioTypes) {
     if (relation.getRepresentation() == RelationRepresentation::EQREL) {
         if (relation.getArity() == 2) {
             if (relation.getAttribute(0)->getTypeName() != relation.getAttribute(1)->getTypeName()) {
@@ -716,14 +715,32 @@ void AstSemanticChecker::checkRelation(ErrorReport& report, const TypeEnvironmen
         }
     }
 
-    // start with declaration
-    checkRelationDeclaration(report, typeEnv, program, relation, ioTypes);
+    if (relation.getRepresentation() == RelationRepresentation::BITSET && relation.getArity() != 1) {
+        report.addError("Bitset relation " + toString(relation.getName()) + " is not unary",
+                relation.getSrcLoc());
+    }
+
+    if (relation.getRepresentation() == RelationRepresentation::SUBSUMPTION && relation.getArity() < 2) {
+        report.addError("Subsumption relation " + toString(relation.getName()) +
+                                " requires a key and a measure attribute",
+                relation.getSrcLoc());
+    }
+
+    if (relation.getRepresentation() == RelationRepresentation::FUNCTIONAL && relation.getArity() < 2) {
+        report.addError("Functional relation " + toString(relation.getName()) +
+                                " requires a key and a value attribute",
+                relation.getSrcLoc());
+    }
 
-    // check clauses
-    for (AstClause* c : relation.getClauses()) {
-        checkClause(report, program, *c, recursiveClauses);
+    if (relation.getRepresentation() == RelationRepresentation::GROUPED && relation.getArity() < 2) {
+        report.addError("Grouped relation " + toString(relation.getName()) +
+                                " requires a key and a grouped attribute",
+                relation.getSrcLoc());
     }
 
+    // start with declaration
+    checkRelationDeclaration(report, typeEnv, program, relation, ioTypes);
+
     // check whether this relation is empty
     if (relation.clauseSize() == 0 && !ioTypes.isInput(&relation) && !relation.isSuppressed()) {
         report.addWarning(
@@ -733,13 +750,42 @@ void AstSemanticChecker::checkRelation(ErrorReport& report, const TypeEnvironmen
 
 void AstSemanticChecker::checkRules(ErrorReport& report, const TypeEnvironment& typeEnv,
         const AstProgram& program, const RecursiveClauses& recursiveClauses, const IOType& ioTypes) {
+    // relation-level checks run sequentially -- they may touch the global
+    // configuration -- while the clauses are collected for the checks below
+    std::vector<const AstClause*> clauses;
     for (AstRelation* cur : program.getRelations()) {
-        checkRelation(report, typeEnv, program, *cur, recursiveClauses, ioTypes);
+        checkRelation(report, typeEnv, program, *cur, ioTypes);
+        for (AstClause* clause : cur->getClauses()) {
+            clauses.push_back(clause);
+        }
     }
-
     for (AstClause* cur : program.getOrphanClauses()) {
+        clauses.push_back(cur);
+    }
+
+    // the per-clause checks only read the program and the precomputed
+    // analyses, so they are spread over all available threads; every thread
+    // collects diagnostics into a private report and the results are merged
+    // at the end -- diagnostics live in an ordered set, so the merged report
+    // is independent of the thread interleaving
+#ifdef _OPENMP
+#pragma omp parallel
+    {
+        ErrorReport threadReport(report);
+#pragma omp for schedule(dynamic) nowait
+        for (size_t i = 0; i < clauses.size(); i++) {
+            checkClause(threadReport, program, *clauses[i], recursiveClauses);
+        }
+#pragma omp critical(merge_semantic_check_reports)
+        for (const Diagnostic& cur : threadReport.getDiagnostics()) {
+            report.addDiagnostic(cur);
+        }
+    }
+#else
+    for (const AstClause* cur : clauses) {
         checkClause(report, program, *cur, recursiveClauses);
     }
+#endif
 }
 
 // ----- types --------
@@ -65,7 +65,7 @@ private:
     static void checkRelationDeclaration(ErrorReport& report, const TypeEnvironment& typeEnv,
             const AstProgram& program, const AstRelation& relation, const IOType& ioTypes);
     static void checkRelation(ErrorReport& report, const TypeEnvironment& typeEnv, const AstProgram& program,
-            const AstRelation& relation, const RecursiveClauses& recursiveClauses, const IOType& ioTypes);
+            const AstRelation& relation, const IOType& ioTypes);
     static void checkRules(ErrorReport& report, const TypeEnvironment& typeEnv, const AstProgram& program,
             const RecursiveClauses& recursiveClauses, const IOType& ioTypes);
 
@@ -15,9 +15,11 @@
  ***********************************************************************/
 
 #include "AstTransforms.h"
+#include "AstArgument.h"
 #include "AstAttribute.h"
 #include "AstClause.h"
 #include "AstGroundAnalysis.h"
+#include "AstIO.h"
 #include "AstLiteral.h"
 #include "AstNode.h"
 #include "AstProgram.h"
@@ -29,6 +31,8 @@
 #include "AstUtils.h"
 #include "AstVisitor.h"
 #include "BinaryConstraintOps.h"
+#include "ErrorReport.h"
+#include "Global.h"
 #include "GraphUtils.h"
 #include "PrecedenceGraph.h"
 #include "TypeSystem.h"
@@ -1102,7 +1106,7 @@ bool NormaliseConstraintsTransformer::transform(AstTranslationUnit& translationU
                 changeCount++;
 
                 // create new variable name (with appropriate suffix)
-                std::string constantValue = stringConstant->getConstant();
+                std::string constantValue(stringConstant->getConstant());
                 std::stringstream newVariableName;
                 newVariableName << boundPrefix << changeCount << "_" << constantValue << "_s";
 
@@ -1197,4 +1201,130 @@ bool RemoveTypecastsTransformer::transform(AstTranslationUnit& translationUnit)
     return update.changed;
 }
 
+bool PointQueryTransformer::transform(AstTranslationUnit& translationUnit) {
+    AstProgram& program = *translationUnit.getProgram();
+    const std::string query = Global::config().get("query");
+
+    const AstRelationIdentifier queryRelName("@query");
+    if (program.getRelation(queryRelName) != nullptr) {
+        // the query relation has already been set up
+        return false;
+    }
+
+    auto fail = [&](const std::string& message) {
+        translationUnit.getErrorReport().addError(
+                "cannot evaluate query '" + query + "': " + message, SrcLocation());
+        return false;
+    };
+
+    auto trim = [](std::string str) {
+        str.erase(0, str.find_first_not_of(" \t"));
+        str.erase(str.find_last_not_of(" \t") + 1);
+        return str;
+    };
+
+    // parse the shape of the atom: <relation>(<arg>,...,<arg>)
+    size_t open = query.find('(');
+    size_t close = query.rfind(')');
+    if (open == std::string::npos || close == std::string::npos || close < open ||
+            !trim(query.substr(close + 1)).empty()) {
+        return fail("expected an atom of the form relation(arg,...,arg)");
+    }
+
+    std::string nameText = trim(query.substr(0, open));
+    if (nameText.empty()) {
+        return fail("missing relation name");
+    }
+
+    AstRelationIdentifier relName(splitString(nameText, '.'));
+    AstRelation* relation = program.getRelation(relName);
+    if (relation == nullptr) {
+        return fail("no relation named " + nameText);
+    }
+
+    // split the arguments at top-level commas, keeping string literals intact
+    std::vector<std::string> argTexts;
+    std::string argsText = query.substr(open + 1, close - open - 1);
+    if (!trim(argsText).empty()) {
+        std::string current;
+        bool inString = false;
+        for (char c : argsText) {
+            if (c == '"') {
+                inString = !inString;
+            }
+            if (c == ',' && !inString) {
+                argTexts.push_back(trim(current));
+                current.clear();
+            } else {
+                current += c;
+            }
+        }
+        if (inString) {
+            return fail("unterminated string literal");
+        }
+        argTexts.push_back(trim(current));
+    }
+
+    if (argTexts.size() != relation->getArity()) {
+        return fail("relation " + nameText + " has arity " + std::to_string(relation->getArity()));
+    }
+
+    // build the body atom over the queried relation and a head repeating its
+    // arguments, turning underscores into fresh variables so that every
+    // matching tuple appears in the answer
+    auto queryRelation = std::make_unique<AstRelation>();
+    queryRelation->setName(queryRelName);
+    auto head = std::make_unique<AstAtom>(queryRelName);
+    auto body = std::make_unique<AstAtom>(relName);
+
+    for (size_t i = 0; i < argTexts.size(); i++) {
+        const std::string& text = argTexts[i];
+        std::unique_ptr<AstArgument> arg;
+        if (text.empty()) {
+            return fail("missing argument");
+        } else if (text == "_") {
+            arg = std::make_unique<AstVariable>("+query" + std::to_string(i));
+        } else if (text[0] == '"') {
+            if (text.size() < 2 || text.back() != '"') {
+                return fail("malformed string literal " + text);
+            }
+            arg = std::make_unique<AstStringConstant>(
+                    translationUnit.getSymbolTable(), text.substr(1, text.size() - 2));
+        } else if (text.find_first_not_of("0123456789", text[0] == '-' ? 1 : 0) == std::string::npos &&
+                   !(text[0] == '-' && text.size() == 1)) {
+            arg = std::make_unique<AstNumberConstant>(std::stoi(text));
+        } else if (text.find_first_not_of(
+                           "abcdefghijklmnopqrstuvwxyzABCDEFGHIJKLMNOPQRSTUVWXYZ0123456789_?") !=
+                           std::string::npos ||
+                   isdigit(text[0]) != 0) {
+            return fail("malformed argument " + text);
+        } else {
+            arg = std::make_unique<AstVariable>(text);
+        }
+        head->addArgument(std::unique_ptr<AstArgument>(arg->clone()));
+        body->addArgument(std::move(arg));
+        queryRelation->addAttribute(std::unique_ptr<AstAttribute>(relation->getAttribute(i)->clone()));
+    }
+
+    // the query relation becomes the only output, so downstream passes --
+    // in particular the magic set transformation -- only have to compute
+    // the subset of the program reaching the queried constants
+    for (AstRelation* rel : program.getRelations()) {
+        rel->clearStores();
+    }
+
+    auto queryClause = std::make_unique<AstClause>();
+    queryClause->setHead(std::move(head));
+    queryClause->addToBody(std::move(body));
+
+    auto store = std::make_unique<AstStore>();
+    store->setName(queryRelName);
+    store->addKVP("IO", "stdout");
+    queryRelation->addStore(std::move(store));
+
+    program.appendRelation(std::move(queryRelation));
+    program.appendClause(std::move(queryClause));
+    return true;
+}
+
 }  // end of namespace souffle
@@ -204,6 +204,21 @@ private:
     bool transform(AstTranslationUnit& translationUnit) override;
 };
 
+/**
+ * Transformation pass to drop relation columns whose values are never
+ * observed by any rule, narrowing the relation schema and projecting the
+ * dropped columns away at load time.
+ */
+class DeadColumnEliminationTransformer : public AstTransformer {
+public:
+    std::string getName() const override {
+        return "DeadColumnEliminationTransformer";
+    }
+
+private:
+    bool transform(AstTranslationUnit& translationUnit) override;
+};
+
 /**
  * Transformation pass to add provenance information
  */
@@ -347,6 +362,23 @@ private:
     bool transform(AstTranslationUnit& translationUnit) override;
 };
 
+/**
+ * Transformation pass restricting the program to a single query atom given
+ * on the command line: the atom becomes the only output of the program, so
+ * the magic set transformation can specialize the rules towards its
+ * constant arguments and only the needed subset of each relation is
+ * computed.
+ */
+class PointQueryTransformer : public AstTransformer {
+public:
+    std::string getName() const override {
+        return "PointQueryTransformer";
+    }
+
+private:
+    bool transform(AstTranslationUnit& translationUnit) override;
+};
+
 /**
  * Transformation to remove typecasts.
  */
@@ -184,7 +184,7 @@ std::vector<IODirectives> AstTranslator::getOutputIODirectives(
 
             if (Global::config().has("provenance")) {
                 std::vector<std::string> originalAttributeNames(
-                        attributeNames.begin(), attributeNames.end() - 2);
+                        attributeNames.begin(), attributeNames.end() - 1);
                 ioDirective.set("attributeNames", toString(join(originalAttributeNames, delimiter)));
             } else {
                 ioDirective.set("attributeNames", toString(join(attributeNames, delimiter)));
@@ -345,9 +345,9 @@ std::unique_ptr<RamCondition> AstTranslator::translateConstraint(
             const auto* atom = neg.getAtom();
             auto arity = atom->getArity();
 
-            // account for two extra provenance columns
+            // account for the extra provenance column
             if (Global::config().has("provenance")) {
-                arity -= 2;
+                arity -= 1;
             }
 
             std::vector<std::unique_ptr<RamExpression>> values;
@@ -356,14 +356,22 @@ std::unique_ptr<RamCondition> AstTranslator::translateConstraint(
                 values.push_back(translator.translateValue(atom->getArgument(i), index));
             }
 
-            // we don't care about the provenance columns when doing the existence check
+            // we don't care about the provenance column when doing the existence check
             if (Global::config().has("provenance")) {
                 values.push_back(std::make_unique<RamUndefValue>());
-                values.push_back(std::make_unique<RamUndefValue>());
             }
 
             // add constraint
             if (arity > 0) {
+                // for subsumption relations a tuple also counts as present if a
+                // tuple with the same key but a smaller measure exists
+                const AstRelation* rel = getAtomRelation(atom, translator.program);
+                if (rel != nullptr && rel->getRepresentation() == RelationRepresentation::SUBSUMPTION &&
+                        !Global::config().has("provenance") &&
+                        !isRamUndefValue(values[arity - 1].get())) {
+                    return std::make_unique<RamNegation>(std::make_unique<RamSubsumptionCheck>(
+                            translator.translateRelation(atom), std::move(values)));
+                }
                 return std::make_unique<RamNegation>(std::make_unique<RamExistenceCheck>(
                         translator.translateRelation(atom), std::move(values)));
             } else {
@@ -377,9 +385,9 @@ std::unique_ptr<RamCondition> AstTranslator::translateConstraint(
             const AstAtom* atom = neg.getAtom();
             auto arity = atom->getArity();
 
-            // account for two extra provenance columns
+            // account for the extra provenance column
             if (Global::config().has("provenance")) {
-                arity -= 2;
+                arity -= 1;
             }
 
             std::vector<std::unique_ptr<RamExpression>> values;
@@ -390,11 +398,10 @@ std::unique_ptr<RamCondition> AstTranslator::translateConstraint(
                 values.push_back(translator.translateValue(arg, index));
             }
 
-            // we don't care about the provenance columns when doing the existence check
+            // add the packed annotation carrying the height bound for
+            // provenanceNotExists
             if (Global::config().has("provenance")) {
-                values.push_back(std::make_unique<RamUndefValue>());
-                // add the height annotation for provenanceNotExists
-                values.push_back(translator.translateValue(atom->getArgument(arity + 1), index));
+                values.push_back(translator.translateValue(atom->getArgument(arity), index));
             }
 
             // add constraint
@@ -436,6 +443,37 @@ std::unique_ptr<AstClause> AstTranslator::ClauseTranslator::getReorderedClause(
     return nullptr;
 }
 
+void AstTranslator::attachAlternativePlans(
+        RamStatement* rule, const AstClause& clause, const AstClause& originalClause, const int version) {
+    // fallback plans are only consulted by the interpreter's rule watchdog
+    if (!Global::config().has("rule-budget")) {
+        return;
+    }
+
+    auto* query = dynamic_cast<RamQuery*>(rule);
+    if (query == nullptr) {
+        return;
+    }
+
+    const auto plan = clause.getExecutionPlan();
+    if (plan == nullptr) {
+        return;
+    }
+
+    // every order of the .plan evaluates the same rule; the orders not
+    // chosen for this version form a pool of semantically equivalent
+    // fallbacks the watchdog can switch to at run-time
+    for (const auto& order : plan->getOrders()) {
+        if (order.first == version) {
+            continue;
+        }
+        auto alternative = ClauseTranslator(*this).translateClause(clause, originalClause, order.first);
+        if (const auto* altQuery = dynamic_cast<const RamQuery*>(alternative.get())) {
+            query->addAlternative(std::unique_ptr<RamOperation>(altQuery->getOperation().clone()));
+        }
+    }
+}
+
 AstTranslator::ClauseTranslator::arg_list* AstTranslator::ClauseTranslator::getArgList(
         const AstNode* curNode, std::map<const AstNode*, std::unique_ptr<arg_list>>& nodeArgs) const {
     if (!nodeArgs.count(curNode)) {
@@ -544,7 +582,7 @@ std::unique_ptr<RamOperation> AstTranslator::ClauseTranslator::createOperation(c
     if (Global::config().has("provenance") &&
             ((!Global::config().has("compile") && !Global::config().has("dl-program") &&
                     !Global::config().has("generate")))) {
-        auto arity = head->getArity() - 2;
+        auto arity = head->getArity() - 1;
 
         std::vector<std::unique_ptr<RamExpression>> values;
 
@@ -558,8 +596,7 @@ std::unique_ptr<RamOperation> AstTranslator::ClauseTranslator::createOperation(c
             values.push_back(translator.translateValue(arg, valueIndex));
         }
 
-        // add two unnamed args for provenance columns
-        values.push_back(std::make_unique<RamUndefValue>());
+        // add an unnamed arg for the provenance column
         values.push_back(std::make_unique<RamUndefValue>());
 
         if (isVolatile) {
@@ -592,12 +629,11 @@ std::unique_ptr<RamOperation> AstTranslator::ProvenanceClauseTranslator::createO
             values.push_back(translator.translateValue(con->getLHS(), valueIndex));
             values.push_back(translator.translateValue(con->getRHS(), valueIndex));
         } else if (auto neg = dynamic_cast<AstProvenanceNegation*>(lit)) {
-            for (size_t i = 0; i < neg->getAtom()->getArguments().size() - 2; ++i) {
+            for (size_t i = 0; i < neg->getAtom()->getArguments().size() - 1; ++i) {
                 auto arg = neg->getAtom()->getArguments()[i];
                 values.push_back(translator.translateValue(arg, valueIndex));
             }
             values.push_back(std::make_unique<RamNumber>(-1));
-            values.push_back(std::make_unique<RamNumber>(-1));
         }
     }
 
@@ -903,6 +939,42 @@ std::unique_ptr<RamStatement> AstTranslator::translateNonRecursiveRelation(
     // the ram table reference
     std::unique_ptr<RamRelationReference> rrel = translateRelation(&rel);
 
+    // a ground fact with constant arguments only, eligible for the
+    // table-backed bulk insert
+    auto isConstantFact = [&](const AstClause* clause) {
+        if (!clause->isFact() || rel.getArity() == 0 ||
+                clause->getHead()->getArguments().size() != rel.getArity()) {
+            return false;
+        }
+        for (const AstArgument* arg : clause->getHead()->getArguments()) {
+            if (dynamic_cast<const AstConstant*>(arg) == nullptr) {
+                return false;
+            }
+        }
+        return true;
+    };
+
+    // batch all constant ground facts into one statement backed by a flat
+    // tuple table; translating each fact into its own statement dominates
+    // both translation and execution time for fact-heavy programs
+    std::vector<RamDomain> factTable;
+    for (const AstClause* clause : rel.getClauses()) {
+        if (!isConstantFact(clause)) {
+            continue;
+        }
+        for (const AstArgument* arg : clause->getHead()->getArguments()) {
+            factTable.push_back(static_cast<const AstConstant*>(arg)->getIndex());
+        }
+    }
+    if (!factTable.empty()) {
+        std::unique_ptr<RamStatement> facts = std::make_unique<RamFactTable>(
+                std::unique_ptr<RamRelationReference>(rrel->clone()), std::move(factTable));
+        std::ostringstream ds;
+        ds << "ground facts of " << rel.getName() << "\nin file " << rel.getSrcLoc();
+        facts = std::make_unique<RamDebugInfo>(std::move(facts), ds.str());
+        appendStmt(res, std::move(facts));
+    }
+
     /* iterate over all clauses that belong to the relation */
     for (AstClause* clause : rel.getClauses()) {
         // skip recursive rules
@@ -910,9 +982,17 @@ std::unique_ptr<RamStatement> AstTranslator::translateNonRecursiveRelation(
             continue;
         }
 
+        // skip facts covered by the table-backed bulk insert
+        if (isConstantFact(clause)) {
+            continue;
+        }
+
         // translate clause
         std::unique_ptr<RamStatement> rule = ClauseTranslator(*this).translateClause(*clause, *clause);
 
+        // attach the unused orders of the clause's plan as fallbacks
+        attachAlternativePlans(rule.get(), *clause, *clause, 0);
+
         // add logging
         if (Global::config().has("profile")) {
             const std::string& relationName = toString(rel.getName());
@@ -993,6 +1073,19 @@ void AstTranslator::nameUnnamedVariables(AstClause* clause) {
 }
 
 /** generate RAM code for recursive relations in a strongly-connected component */
+namespace {
+/** Determine whether a relation is written to a file, i.e., has a store
+ * directive that is not a print-size directive. */
+bool hasFileStore(const AstRelation* rel) {
+    for (const AstStore* store : rel->getStores()) {
+        if (dynamic_cast<const AstPrintSize*>(store) == nullptr) {
+            return true;
+        }
+    }
+    return false;
+}
+}  // namespace
+
 std::unique_ptr<RamStatement> AstTranslator::translateRecursiveRelation(
         const std::set<const AstRelation*>& scc, const RecursiveClauses* recursiveClauses) {
     // initialize sections
@@ -1000,6 +1093,43 @@ std::unique_ptr<RamStatement> AstTranslator::translateRecursiveRelation(
     std::unique_ptr<RamSequence> updateTable(new RamSequence());
     std::unique_ptr<RamStatement> postamble;
 
+    // Under --gauss-seidel the relations of the scc are evaluated
+    // sequentially with suppliers preceding their consumers, and each
+    // relation's delta is swapped in place, so rules of relations later in
+    // the order already see the tuples derived in the same iteration.
+    const bool feedDeltas = Global::config().has("gauss-seidel");
+    std::vector<const AstRelation*> sccOrder;
+    if (feedDeltas) {
+        // order the relations by a depth-first search over their intra-scc
+        // dependencies, emitting a relation after its suppliers so that most
+        // dependency edges feed forward within an iteration
+        std::set<const AstRelation*> visited;
+        std::function<void(const AstRelation*)> visit = [&](const AstRelation* r) {
+            if (scc.find(r) == scc.end() || !visited.insert(r).second) {
+                return;
+            }
+            for (size_t i = 0; i < r->clauseSize(); i++) {
+                const AstClause* cl = r->getClause(i);
+                if (!recursiveClauses->recursive(cl)) {
+                    continue;
+                }
+                for (const AstAtom* atom : cl->getAtoms()) {
+                    visit(getAtomRelation(atom, program));
+                }
+            }
+            sccOrder.push_back(r);
+        };
+        for (const AstRelation* rel : scc) {
+            visit(rel);
+        }
+    } else {
+        sccOrder.assign(scc.begin(), scc.end());
+    }
+
+    // the update statements of each relation, applied in place under
+    // --gauss-seidel instead of collectively at the end of an iteration
+    std::map<const AstRelation*, std::unique_ptr<RamStatement>> inPlaceUpdates;
+
     // --- create preamble ---
 
     // mappings for temporary relations
@@ -1009,7 +1139,7 @@ std::unique_ptr<RamStatement> AstTranslator::translateRecursiveRelation(
 
     /* Compute non-recursive clauses for relations in scc and push
        the results in their delta tables. */
-    for (const AstRelation* rel : scc) {
+    for (const AstRelation* rel : sccOrder) {
         std::unique_ptr<RamStatement> updateRelTable;
 
         /* create two temporary tables for relaxed semi-naive evaluation */
@@ -1045,18 +1175,43 @@ std::unique_ptr<RamStatement> AstTranslator::translateRecursiveRelation(
         /* Generate code for non-recursive part of relation */
         appendStmt(preamble, translateNonRecursiveRelation(*rel, recursiveClauses));
 
+        /* Warm-start: seed the fixpoint with the relation's result from a
+         * previous run. The previous tuples enter both the full and the
+         * delta state, so a monotone program re-checks them within a single
+         * iteration instead of re-deriving them over the full recursion
+         * depth. They must enter the delta as well: restricting it to new
+         * tuples would silently drop consequences of old tuples joined
+         * against newly added input tuples, since neither side would ever
+         * appear in a delta. A missing file only logs a warning, leaving
+         * the relation to start cold. */
+        if (Global::config().has("warm-start-dir") && hasFileStore(rel)) {
+            appendStmt(preamble,
+                    std::make_unique<RamLoad>(std::unique_ptr<RamRelationReference>(rrel[rel]->clone()),
+                            getInputIODirectives(
+                                    rel, Global::config().get("warm-start-dir"), ".csv")));
+        }
+
         /* Generate merge operation for temp tables */
         appendStmt(preamble,
                 std::make_unique<RamMerge>(std::unique_ptr<RamRelationReference>(relDelta[rel]->clone()),
                         std::unique_ptr<RamRelationReference>(rrel[rel]->clone())));
 
         /* Add update operations of relations to parallel statements */
-        updateTable->add(std::move(updateRelTable));
+        if (feedDeltas) {
+            inPlaceUpdates[rel] = std::move(updateRelTable);
+        } else {
+            updateTable->add(std::move(updateRelTable));
+        }
     }
 
     // --- build main loop ---
 
-    std::unique_ptr<RamParallel> loopSeq(new RamParallel());
+    std::unique_ptr<RamListStatement> loopSeq;
+    if (feedDeltas) {
+        loopSeq = std::make_unique<RamSequence>();
+    } else {
+        loopSeq = std::make_unique<RamParallel>();
+    }
 
     // create a utility to check SCC membership
     auto isInSameSCC = [&](const AstRelation* rel) {
@@ -1064,7 +1219,7 @@ std::unique_ptr<RamStatement> AstTranslator::translateRecursiveRelation(
     };
 
     /* Compute temp for the current tables */
-    for (const AstRelation* rel : scc) {
+    for (const AstRelation* rel : sccOrder) {
         std::unique_ptr<RamStatement> loopRelSeq;
 
         /* Find clauses for relation rel */
@@ -1117,6 +1272,22 @@ std::unique_ptr<RamStatement> AstTranslator::translateRecursiveRelation(
                 std::unique_ptr<RamStatement> rule =
                         ClauseTranslator(*this).translateClause(*r1, *cl, version);
 
+                /* guard the rule with an emptiness check on its delta operand,
+                   so iterations in which the operand gained nothing skip the
+                   version with a single test before any scan is set up */
+                if (auto* query = dynamic_cast<RamQuery*>(rule.get())) {
+                    const RamOperation* root = &query->getOperation();
+                    query->rewrite(root,
+                            std::make_unique<RamFilter>(
+                                    std::make_unique<RamNegation>(std::make_unique<RamEmptinessCheck>(
+                                            std::unique_ptr<RamRelationReference>(
+                                                    relDelta[atomRelation]->clone()))),
+                                    std::unique_ptr<RamOperation>(root->clone())));
+                }
+
+                /* attach the unused orders of the clause's plan as fallbacks */
+                attachAlternativePlans(rule.get(), *r1, *cl, version);
+
                 /* add logging */
                 if (Global::config().has("profile")) {
                     const std::string& relationName = toString(rel->getName());
@@ -1147,12 +1318,12 @@ std::unique_ptr<RamStatement> AstTranslator::translateRecursiveRelation(
         }
 
         // if there was no rule, continue
-        if (!loopRelSeq) {
+        if (!loopRelSeq && !feedDeltas) {
             continue;
         }
 
         // label all versions
-        if (Global::config().has("profile")) {
+        if (loopRelSeq && Global::config().has("profile")) {
             const std::string& relationName = toString(rel->getName());
             const SrcLocation& srcLocation = rel->getSrcLoc();
             const std::string logTimerStatement = LogStatement::tRecursiveRelation(relationName, srcLocation);
@@ -1161,6 +1332,12 @@ std::unique_ptr<RamStatement> AstTranslator::translateRecursiveRelation(
                     std::unique_ptr<RamRelationReference>(relNew[rel]->clone()));
         }
 
+        /* update the relation in place, so rules of relations later in the
+           evaluation order see the tuples derived in this iteration */
+        if (feedDeltas) {
+            appendStmt(loopRelSeq, std::move(inPlaceUpdates[rel]));
+        }
+
         /* add rule computations of a relation to parallel statement */
         loopSeq->add(std::move(loopRelSeq));
     }
@@ -1172,17 +1349,25 @@ std::unique_ptr<RamStatement> AstTranslator::translateRecursiveRelation(
     };
 
     std::unique_ptr<RamCondition> exitCond;
-    for (const AstRelation* rel : scc) {
-        addCondition(exitCond, std::make_unique<RamEmptinessCheck>(
-                                       std::unique_ptr<RamRelationReference>(relNew[rel]->clone())));
+    for (const AstRelation* rel : sccOrder) {
+        // with in-place updates the new relations are already swapped and
+        // cleared when the exit condition runs, so the deltas are checked
+        addCondition(exitCond,
+                std::make_unique<RamEmptinessCheck>(std::unique_ptr<RamRelationReference>(
+                        feedDeltas ? relDelta[rel]->clone() : relNew[rel]->clone())));
     }
 
     /* construct fixpoint loop  */
     std::unique_ptr<RamStatement> res;
     if (preamble) appendStmt(res, std::move(preamble));
-    if (!loopSeq->getStatements().empty() && exitCond && updateTable) {
-        appendStmt(res, std::make_unique<RamLoop>(std::move(loopSeq),
-                                std::make_unique<RamExit>(std::move(exitCond)), std::move(updateTable)));
+    if (!loopSeq->getStatements().empty() && exitCond) {
+        if (feedDeltas) {
+            appendStmt(res, std::make_unique<RamLoop>(
+                                    std::move(loopSeq), std::make_unique<RamExit>(std::move(exitCond))));
+        } else if (updateTable) {
+            appendStmt(res, std::make_unique<RamLoop>(std::move(loopSeq),
+                                    std::make_unique<RamExit>(std::move(exitCond)), std::move(updateTable)));
+        }
     }
     if (postamble) {
         appendStmt(res, std::move(postamble));
@@ -1203,7 +1388,7 @@ std::unique_ptr<RamStatement> AstTranslator::makeSubproofSubroutine(const AstCla
 
     // add constraint for each argument in head of atom
     AstAtom* head = intermediateClause->getHead();
-    for (size_t i = 0; i < head->getArguments().size() - 2; i++) {
+    for (size_t i = 0; i < head->getArguments().size() - 1; i++) {
         auto arg = head->getArgument(i);
 
         if (auto var = dynamic_cast<AstVariable*>(arg)) {
@@ -1219,7 +1404,7 @@ std::unique_ptr<RamStatement> AstTranslator::makeSubproofSubroutine(const AstCla
     }
 
     // index of level argument in argument list
-    size_t levelIndex = head->getArguments().size() - 2;
+    size_t levelIndex = head->getArguments().size() - 1;
 
     // add level constraints
     for (size_t i = 0; i < intermediateClause->getBodyLiterals().size(); i++) {
@@ -1227,7 +1412,9 @@ std::unique_ptr<RamStatement> AstTranslator::makeSubproofSubroutine(const AstCla
         if (auto atom = dynamic_cast<AstAtom*>(lit)) {
             auto arity = atom->getArity();
 
-            // arity - 1 is the level number in body atoms
+            // arity - 1 is the packed annotation in body atoms; as the height
+            // occupies the high-order bits, comparing packed values against
+            // the packed height bound compares heights
             intermediateClause->addToBody(std::make_unique<AstBinaryConstraint>(BinaryConstraintOp::LT,
                     std::unique_ptr<AstArgument>(atom->getArgument(arity - 1)->clone()),
                     std::make_unique<AstSubroutineArgument>(levelIndex)));
@@ -1330,13 +1517,12 @@ std::unique_ptr<RamStatement> AstTranslator::makeNegationSubproofSubroutine(cons
             atom->apply(varsToArgs);
 
             // add each value (subroutine argument) to the search query
-            for (size_t i = 0; i < atom->getArity() - 2; i++) {
+            for (size_t i = 0; i < atom->getArity() - 1; i++) {
                 auto arg = atom->getArgument(i);
                 query.push_back(translateValue(arg, ValueIndex()));
             }
 
-            // fill up query with nullptrs for the provenance columns
-            query.push_back(std::make_unique<RamUndefValue>());
+            // fill up query with a nullptr for the provenance column
             query.push_back(std::make_unique<RamUndefValue>());
 
             // ensure the length of query tuple is correct
@@ -1358,7 +1544,7 @@ std::unique_ptr<RamStatement> AstTranslator::makeNegationSubproofSubroutine(cons
             std::vector<std::unique_ptr<RamExpression>> returnAtom;
             returnAtom.push_back(std::make_unique<RamUndefValue>());
             // the actual atom
-            for (size_t i = 0; i < atom->getArity() - 2; i++) {
+            for (size_t i = 0; i < atom->getArity() - 1; i++) {
                 returnAtom.push_back(translateValue(atom->getArgument(i), ValueIndex()));
             }
 
@@ -1395,7 +1581,7 @@ std::unique_ptr<RamStatement> AstTranslator::makeNegationSubproofSubroutine(cons
                 returnLit.push_back(translateValue(binaryConstraint->getRHS(), ValueIndex()));
             } else if (auto negation = dynamic_cast<AstNegation*>(con)) {
                 auto vals = negation->getAtom()->getArguments();
-                for (size_t i = 0; i < vals.size() - 2; i++) {
+                for (size_t i = 0; i < vals.size() - 1; i++) {
                     returnLit.push_back(translateValue(vals[i], ValueIndex()));
                 }
             }
@@ -1497,6 +1683,37 @@ void AstTranslator::translateProgram(const AstTranslationUnit& translationUnit)
     };
 #endif
 
+    // in parallel-strata mode, mutually independent SCCs are grouped into
+    // levels and each level is executed as a parallel block; the grouping
+    // is inhibited whenever the serial stratum order is observable, i.e.
+    // when profiling or a communication engine is in use
+    const bool parallelStrata = Global::config().has("parallel-strata") &&
+                                !Global::config().has("profile") && !Global::config().has("engine");
+
+    // compute the level of each SCC in the condensed dependency graph,
+    // i.e. the length of the longest path of predecessor SCCs; SCCs of
+    // equal level are mutually independent
+    std::map<size_t, size_t> sccLevel;
+    if (parallelStrata) {
+        for (const auto& scc : sccOrder.order()) {
+            size_t level = 0;
+            for (const auto& pred : sccGraph.getPredecessorSCCs(scc)) {
+                level = std::max(level, sccLevel.at(pred) + 1);
+            }
+            sccLevel[scc] = level;
+        }
+    }
+
+    // the strata of each level, to be wrapped into a parallel block
+    std::map<size_t, std::vector<std::unique_ptr<RamStatement>>> strataOfLevel;
+
+    // the relations to be dropped once a given level has completed; a
+    // relation expiring at some position of the topological order may be
+    // read by any stratum up to that position, hence it is dropped only
+    // after the highest level seen so far has completed
+    std::map<size_t, std::vector<const AstRelation*>> expiredAtLevel;
+    size_t highestLevelSoFar = 0;
+
     // maintain the index of the SCC within the topological order
     size_t indexOfScc = 0;
 
@@ -1626,6 +1843,14 @@ void AstTranslator::translateProgram(const AstTranslationUnit& translationUnit)
                 for (const auto& relation : externNonOutPreds) {
                     makeRamDrop(current, relation);
                 }
+            } else if (parallelStrata) {
+                // in parallel-strata mode, defer the drop of expired
+                // relations until the current level has completed, as a
+                // concurrently executed stratum may still read them
+                highestLevelSoFar = std::max(highestLevelSoFar, sccLevel.at(scc));
+                for (const auto& relation : internExps) {
+                    expiredAtLevel[highestLevelSoFar].push_back(relation);
+                }
             } else {
                 // otherwise, drop all  relations expired as per the topological order
                 for (const auto& relation : internExps) {
@@ -1635,14 +1860,47 @@ void AstTranslator::translateProgram(const AstTranslationUnit& translationUnit)
         }
 
         if (current) {
-            // append the current SCC as a stratum to the sequence
-            appendStmt(res, std::make_unique<RamStratum>(std::move(current), indexOfScc));
+            // append the current SCC as a stratum to the sequence, or
+            // collect it into its level in parallel-strata mode
+            auto stratum = std::make_unique<RamStratum>(std::move(current), indexOfScc);
+            if (parallelStrata) {
+                strataOfLevel[sccLevel.at(scc)].push_back(std::move(stratum));
+            } else {
+                appendStmt(res, std::move(stratum));
+            }
 
             // increment the index of the current SCC
             indexOfScc++;
         }
     }
 
+    if (parallelStrata) {
+        // emit the levels in order; strata of the same level are wrapped
+        // into a parallel block, followed by a cleanup stratum dropping
+        // the relations that expired within the level
+        size_t indexOfCleanup = sccGraph.getNumberOfSCCs();
+        for (auto& level : strataOfLevel) {
+            if (level.second.size() == 1) {
+                // a single stratum => no parallel block required
+                appendStmt(res, std::move(level.second.front()));
+            } else {
+                auto parallelBlock = std::make_unique<RamParallel>();
+                for (auto& stratum : level.second) {
+                    parallelBlock->add(std::move(stratum));
+                }
+                appendStmt(res, std::move(parallelBlock));
+            }
+            const auto& expired = expiredAtLevel[level.first];
+            if (!expired.empty()) {
+                std::unique_ptr<RamStatement> cleanup;
+                for (const auto& relation : expired) {
+                    makeRamDrop(cleanup, relation);
+                }
+                appendStmt(res, std::make_unique<RamStratum>(std::move(cleanup), indexOfCleanup++));
+            }
+        }
+    }
+
 #ifdef USE_MPI
     if (Global::config().get("engine") == "mpi") {
         // make a new ram statement for the master process
@@ -367,6 +367,11 @@ private:
         ProvenanceClauseTranslator(AstTranslator& translator) : ClauseTranslator(translator) {}
     };
 
+    /** attach the remaining execution-plan orders of a clause to a
+     * translated rule as alternative plans for the run-time watchdog */
+    void attachAlternativePlans(RamStatement* rule, const AstClause& clause,
+            const AstClause& originalClause, const int version);
+
     /**
      * translate RAM code for the non-recursive clauses of the given relation.
      *
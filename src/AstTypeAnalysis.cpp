@@ -324,6 +324,122 @@ AstClause* createAnnotatedClause(
     return annotatedClause;
 }
 
+namespace {
+
+/** The memoized typing of a single argument, stored by type name. */
+struct ArgumentTypeMemo {
+    bool present = false;
+    bool all = false;
+    std::vector<AstTypeIdentifier> typeNames;
+};
+
+/**
+ * A memo of per-clause typing results that survives analysis invalidation.
+ *
+ * Transformers invalidate all cached analyses whenever they change the
+ * program, which re-runs the full type inference fixpoint although most
+ * clauses are untouched between pipeline stages. Typing a clause only
+ * depends on the clause itself, the type and functor declarations and the
+ * attribute types of the referenced relations; results are therefore keyed
+ * by the printed clause, stored per argument in depth-first visit order, and
+ * the whole memo is discarded when the declaration context changes. Type
+ * sets are kept by type name and re-bound to the type environment of the
+ * current run, as the environment object is rebuilt on every invalidation.
+ */
+struct TypeAnalysisMemo {
+    std::string contextFingerprint;
+    std::map<std::string, std::vector<ArgumentTypeMemo>> clauses;
+};
+
+TypeAnalysisMemo& getTypeAnalysisMemo() {
+    static TypeAnalysisMemo memo;
+    return memo;
+}
+
+/**
+ * Renders everything besides the clauses themselves that the per-clause
+ * typing depends on: type declarations, functor declarations and the
+ * attribute types of all relations.
+ */
+std::string getTypingContextFingerprint(const AstProgram& program) {
+    std::stringstream context;
+    for (const AstType* type : program.getTypes()) {
+        context << *type << "\n";
+    }
+    for (const AstFunctorDeclaration* functor : program.getFunctorDeclarations()) {
+        context << *functor << "\n";
+    }
+    for (const AstRelation* rel : program.getRelations()) {
+        context << rel->getName();
+        for (const AstAttribute* attr : rel->getAttributes()) {
+            context << " " << attr->getTypeName();
+        }
+        context << "\n";
+    }
+    return context.str();
+}
+
+/**
+ * Attempts to re-bind the memoized typing of the given clause to the current
+ * type environment; returns false if no valid memo exists.
+ */
+bool reuseClauseTypes(const TypeAnalysisMemo& memo, const std::string& key, const AstClause& clause,
+        const TypeEnvironment& env, std::map<const AstArgument*, TypeSet>& argumentTypes) {
+    auto pos = memo.clauses.find(key);
+    if (pos == memo.clauses.end()) {
+        return false;
+    }
+
+    std::vector<const AstArgument*> args;
+    visitDepthFirst(clause, [&](const AstArgument& arg) { args.push_back(&arg); });
+    if (args.size() != pos->second.size()) {
+        return false;
+    }
+
+    std::map<const AstArgument*, TypeSet> reboundTypes;
+    for (size_t i = 0; i < args.size(); i++) {
+        const ArgumentTypeMemo& cur = pos->second[i];
+        if (!cur.present) {
+            continue;
+        }
+        TypeSet types(cur.all);
+        for (const AstTypeIdentifier& name : cur.typeNames) {
+            if (!env.isType(name)) {
+                // the memo references a type no longer present
+                return false;
+            }
+            types.insert(env.getType(name));
+        }
+        reboundTypes[args[i]] = types;
+    }
+
+    argumentTypes.insert(reboundTypes.begin(), reboundTypes.end());
+    return true;
+}
+
+/** Memoizes the freshly computed typing of the given clause. */
+void storeClauseTypes(TypeAnalysisMemo& memo, const std::string& key, const AstClause& clause,
+        const std::map<const AstArgument*, TypeSet>& argumentTypes) {
+    std::vector<ArgumentTypeMemo> entry;
+    visitDepthFirst(clause, [&](const AstArgument& arg) {
+        ArgumentTypeMemo cur;
+        auto pos = argumentTypes.find(&arg);
+        if (pos != argumentTypes.end()) {
+            cur.present = true;
+            cur.all = pos->second.isAll();
+            if (!cur.all) {
+                for (const Type& type : pos->second) {
+                    cur.typeNames.push_back(type.getName());
+                }
+            }
+        }
+        entry.push_back(std::move(cur));
+    });
+    memo.clauses[key] = std::move(entry);
+}
+
+}  // namespace
+
 void TypeAnalysis::run(const AstTranslationUnit& translationUnit) {
     // Check if debugging information is being generated and note where logs should be sent
     std::ostream* debugStream = nullptr;
@@ -331,18 +447,45 @@ void TypeAnalysis::run(const AstTranslationUnit& translationUnit) {
         debugStream = &analysisLogs;
     }
     auto* typeEnvAnalysis = translationUnit.getAnalysis<TypeEnvironmentAnalysis>();
+    const TypeEnvironment& env = typeEnvAnalysis->getTypeEnvironment();
+
+    // the memo only applies while the declaration context is stable, and is
+    // bypassed entirely when debug output is requested since annotated
+    // clauses and solver logs are only produced by a full solve
+    TypeAnalysisMemo& memo = getTypeAnalysisMemo();
+    if (debugStream != nullptr) {
+        memo.clauses.clear();
+        memo.contextFingerprint.clear();
+    } else {
+        std::string fingerprint = getTypingContextFingerprint(*translationUnit.getProgram());
+        if (fingerprint != memo.contextFingerprint) {
+            memo.clauses.clear();
+            memo.contextFingerprint = std::move(fingerprint);
+        }
+    }
+
     for (const AstRelation* rel : translationUnit.getProgram()->getRelations()) {
         for (const AstClause* clause : rel->getClauses()) {
+            // re-use the memoized typing of an unchanged clause if available
+            std::string key;
+            if (debugStream == nullptr) {
+                key = toString(*clause);
+                if (reuseClauseTypes(memo, key, *clause, env, argumentTypes)) {
+                    continue;
+                }
+            }
+
             // Perform the type analysis
             std::map<const AstArgument*, TypeSet> clauseArgumentTypes =
-                    analyseTypes(typeEnvAnalysis->getTypeEnvironment(), *clause, translationUnit.getProgram(),
-                            debugStream);
+                    analyseTypes(env, *clause, translationUnit.getProgram(), debugStream);
             argumentTypes.insert(clauseArgumentTypes.begin(), clauseArgumentTypes.end());
 
             if (debugStream != nullptr) {
                 // Store an annotated clause for printing purposes
                 AstClause* annotatedClause = createAnnotatedClause(clause, clauseArgumentTypes);
                 annotatedClauses.emplace_back(annotatedClause);
+            } else {
+                storeClauseTypes(memo, key, *clause, clauseArgumentTypes);
             }
         }
     }
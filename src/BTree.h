@@ -17,9 +17,11 @@
 
 #pragma once
 
+#include "MemoryPool.h"
 #include "ParallelUtils.h"
 #include "Util.h"
 
+#include <algorithm>
 #include <cassert>
 #include <iostream>
 #include <iterator>
@@ -27,6 +29,12 @@
 #include <utility>
 #include <vector>
 
+#if defined(__AVX2__)
+#include <immintrin.h>
+#elif defined(__ARM_NEON) && defined(__aarch64__)
+#include <arm_neon.h>
+#endif
+
 namespace souffle {
 
 namespace detail {
@@ -197,6 +205,159 @@ struct binary_search : public search_strategy {
     }
 };
 
+/**
+ * A vectorized search strategy for looking up keys in b-tree nodes.
+ *
+ * For nodes storing plain 32-bit integer keys in contiguous memory the
+ * lookup is performed by comparing whole SIMD registers of keys at once
+ * (AVX2: 8 keys, NEON: 4 keys per instruction). For any other key,
+ * iterator or comparator type -- or when the compiler does not target a
+ * supported instruction set -- it transparently degrades to a linear
+ * scan, which was the previous default for integer keys.
+ */
+struct simd_search : public search_strategy {
+    /**
+     * Required user-defined default constructor.
+     */
+    simd_search() = default;
+
+    /**
+     * Obtains an iterator referencing an element equivalent to the
+     * given key in the given range. If no such element is present,
+     * a reference to the first element not less than the given key
+     * is returned.
+     */
+    template <typename Key, typename Iter, typename Comp>
+    inline Iter operator()(const Key& k, Iter a, Iter b, Comp& comp) const {
+        return lower_bound(k, a, b, comp);
+    }
+
+    /**
+     * Obtains a reference to the first element in the given range that
+     * is not less than the given key.
+     */
+    template <typename Key, typename Iter, typename Comp>
+    inline Iter lower_bound(const Key& k, Iter a, Iter b, Comp& comp) const {
+        return lower_bound_impl(k, a, b, comp, is_vectorizable<Key, Iter, Comp>());
+    }
+
+    /**
+     * Obtains a reference to the first element in the given range that
+     * such that the given key is less than the referenced element.
+     */
+    template <typename Key, typename Iter, typename Comp>
+    inline Iter upper_bound(const Key& k, Iter a, Iter b, Comp& comp) const {
+        return upper_bound_impl(k, a, b, comp, is_vectorizable<Key, Iter, Comp>());
+    }
+
+private:
+    /**
+     * Determines statically whether the vectorized code path is applicable:
+     * signed 32-bit integer keys, stored contiguously (pointer iterators),
+     * ordered by the default comparator.
+     */
+    template <typename Key, typename Iter, typename Comp>
+    struct is_vectorizable
+            : public std::integral_constant<bool,
+#if defined(__AVX2__) || (defined(__ARM_NEON) && defined(__aarch64__))
+                      std::is_integral<Key>::value && std::is_signed<Key>::value && sizeof(Key) == 4 &&
+                              std::is_pointer<Iter>::value && std::is_same<Comp, comparator<Key>>::value
+#else
+                      false
+#endif
+                      > {
+    };
+
+    // the scalar fall-back utilized for non-vectorizable instances
+    linear_search fallback;
+
+    template <typename Key, typename Iter, typename Comp>
+    inline Iter lower_bound_impl(const Key& k, Iter a, Iter b, Comp& comp, std::false_type) const {
+        return fallback.lower_bound(k, a, b, comp);
+    }
+
+    template <typename Key, typename Iter, typename Comp>
+    inline Iter upper_bound_impl(const Key& k, Iter a, Iter b, Comp& comp, std::false_type) const {
+        return fallback.upper_bound(k, a, b, comp);
+    }
+
+#if defined(__AVX2__)
+
+    template <typename Key, typename Iter, typename Comp>
+    inline Iter lower_bound_impl(const Key& k, Iter a, Iter b, Comp& /* comp */, std::true_type) const {
+        const __m256i vk = _mm256_set1_epi32(k);
+        // skip blocks of 8 keys that are all less than k
+        while (b - a >= 8) {
+            __m256i vs = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(&*a));
+            int lt = _mm256_movemask_ps(_mm256_castsi256_ps(_mm256_cmpgt_epi32(vk, vs)));
+            if (lt != 0xFF) {
+                return a + __builtin_ctz(~lt & 0xFF);
+            }
+            a += 8;
+        }
+        while (a < b && *a < k) {
+            ++a;
+        }
+        return a;
+    }
+
+    template <typename Key, typename Iter, typename Comp>
+    inline Iter upper_bound_impl(const Key& k, Iter a, Iter b, Comp& /* comp */, std::true_type) const {
+        const __m256i vk = _mm256_set1_epi32(k);
+        // skip blocks of 8 keys that are all less than or equal to k
+        while (b - a >= 8) {
+            __m256i vs = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(&*a));
+            int gt = _mm256_movemask_ps(_mm256_castsi256_ps(_mm256_cmpgt_epi32(vs, vk)));
+            if (gt != 0) {
+                return a + __builtin_ctz(gt);
+            }
+            a += 8;
+        }
+        while (a < b && !(k < *a)) {
+            ++a;
+        }
+        return a;
+    }
+
+#elif defined(__ARM_NEON) && defined(__aarch64__)
+
+    template <typename Key, typename Iter, typename Comp>
+    inline Iter lower_bound_impl(const Key& k, Iter a, Iter b, Comp& /* comp */, std::true_type) const {
+        const int32x4_t vk = vdupq_n_s32(k);
+        // skip blocks of 4 keys that are all less than k
+        while (b - a >= 4) {
+            uint32x4_t lt = vcltq_s32(vld1q_s32(&*a), vk);
+            if (vminvq_u32(lt) == 0) {
+                break;
+            }
+            a += 4;
+        }
+        while (a < b && *a < k) {
+            ++a;
+        }
+        return a;
+    }
+
+    template <typename Key, typename Iter, typename Comp>
+    inline Iter upper_bound_impl(const Key& k, Iter a, Iter b, Comp& /* comp */, std::true_type) const {
+        const int32x4_t vk = vdupq_n_s32(k);
+        // skip blocks of 4 keys that are all less than or equal to k
+        while (b - a >= 4) {
+            uint32x4_t le = vcleq_s32(vld1q_s32(&*a), vk);
+            if (vminvq_u32(le) == 0) {
+                break;
+            }
+            a += 4;
+        }
+        while (a < b && !(k < *a)) {
+            ++a;
+        }
+        return a;
+    }
+
+#endif
+};
+
 // ---------- search strategies selection --------------
 
 /**
@@ -210,13 +371,16 @@ struct strategy_selection {
 
 struct linear : public strategy_selection<linear_search> {};
 struct binary : public strategy_selection<binary_search> {};
+struct simd : public strategy_selection<simd_search> {};
 
 // by default every key utilizes binary search
 template <typename Key>
 struct default_strategy : public binary {};
 
+// plain integer keys utilize the vectorized strategy, which degrades
+// to the former linear scan on targets without SIMD support
 template <>
-struct default_strategy<int> : public linear {};
+struct default_strategy<int> : public simd {};
 
 template <typename... Ts>
 struct default_strategy<std::tuple<Ts...>> : public linear {};
@@ -353,6 +517,7 @@ protected:
     };
 
     struct inner_node;
+    struct leaf_node;
 
     /**
      * The actual, generic node implementation covering the operations
@@ -378,20 +543,45 @@ protected:
         // a simple constructor
         node(bool inner) : base(inner) {}
 
-        // a destructor cleaning up nodes
-        ~node() {
-            if (this->inner) {
-                asInnerNode().cleanup();
+        /**
+         * Creates a new leaf node backed by the given memory pool.
+         */
+        static leaf_node* makeLeaf(MemoryPool& pool) {
+            return new (pool.allocate(sizeof(leaf_node))) leaf_node();
+        }
+
+        /**
+         * Creates a new inner node backed by the given memory pool.
+         */
+        static inner_node* makeInner(MemoryPool& pool) {
+            return new (pool.allocate(sizeof(inner_node))) inner_node();
+        }
+
+        /**
+         * Destroys the tree rooted by the given node by explicitly invoking
+         * node destructors -- the actual memory is owned by the pool the
+         * nodes have been created by and is released by resetting it.
+         */
+        static void destroy(node* node) {
+            if (node->isInner()) {
+                auto& inner = node->asInnerNode();
+                for (size_type i = 0; i <= node->numElements; ++i) {
+                    destroy(inner.children[i]);
+                }
+                inner.~inner_node();
+            } else {
+                static_cast<leaf_node*>(node)->~leaf_node();
             }
         }
 
         /**
-         * A deep-copy operation creating a clone of this node.
+         * A deep-copy operation creating a clone of this node, allocating
+         * the copy within the given memory pool.
          */
-        node* clone() const {
+        node* clone(MemoryPool& pool) const {
             // create a clone of this node
-            node* res = (this->isInner()) ? static_cast<node*>(new inner_node())
-                                          : static_cast<node*>(new leaf_node());
+            node* res = (this->isInner()) ? static_cast<node*>(makeInner(pool))
+                                          : static_cast<node*>(makeLeaf(pool));
 
             // copy basic fields
             res->position = this->position;
@@ -409,7 +599,7 @@ protected:
             // copy child nodes recursively
             auto* ires = (inner_node*)res;
             for (size_type i = 0; i <= this->numElements; ++i) {
-                ires->children[i] = this->getChild(i)->clone();
+                ires->children[i] = this->getChild(i)->clone(pool);
                 ires->children[i]->parent = res;
             }
 
@@ -547,14 +737,15 @@ protected:
          * @param idx  .. the position of the insert causing the split
          */
 #ifdef IS_PARALLEL
-        void split(node** root, lock_type& root_lock, int idx, std::vector<node*>& locked_nodes) {
+        void split(node** root, lock_type& root_lock, MemoryPool& pool, int idx,
+                std::vector<node*>& locked_nodes) {
             assert(this->lock.is_write_locked());
             assert(!this->parent || this->parent->lock.is_write_locked());
             assert((this->parent != nullptr) || root_lock.is_write_locked());
             assert(this->isLeaf() || souffle::contains(locked_nodes, this));
             assert(!this->parent || souffle::contains(locked_nodes, const_cast<node*>(this->parent)));
 #else
-        void split(node** root, lock_type& root_lock, int idx) {
+        void split(node** root, lock_type& root_lock, MemoryPool& pool, int idx) {
 #endif
             assert(this->numElements == maxKeys);
 
@@ -562,8 +753,8 @@ protected:
             int split_point = getSplitPoint(idx);
 
             // create a new sibling node
-            node* sibling = (this->inner) ? static_cast<node*>(new inner_node())
-                                          : static_cast<node*>(new leaf_node());
+            node* sibling = (this->inner) ? static_cast<node*>(makeInner(pool))
+                                          : static_cast<node*>(makeLeaf(pool));
 
 #ifdef IS_PARALLEL
             // lock sibling
@@ -587,15 +778,23 @@ protected:
                 }
             }
 
+            // link the new leaf into the chain of leaves
+            if (!this->inner) {
+                auto* leftLeaf = static_cast<leaf_node*>(this);
+                auto* rightLeaf = static_cast<leaf_node*>(sibling);
+                rightLeaf->next = leftLeaf->next;
+                leftLeaf->next = rightLeaf;
+            }
+
             // update number of elements
             this->numElements = split_point;
             sibling->numElements = maxKeys - split_point - 1;
 
             // update parent
 #ifdef IS_PARALLEL
-            grow_parent(root, root_lock, sibling, locked_nodes);
+            grow_parent(root, root_lock, pool, sibling, locked_nodes);
 #else
-            grow_parent(root, root_lock, sibling);
+            grow_parent(root, root_lock, pool, sibling);
 #endif
         }
 
@@ -612,14 +811,15 @@ protected:
          */
         // TODO: remove root_lock ... no longer needed
 #ifdef IS_PARALLEL
-        int rebalance_or_split(node** root, lock_type& root_lock, int idx, std::vector<node*>& locked_nodes) {
+        int rebalance_or_split(node** root, lock_type& root_lock, MemoryPool& pool, int idx,
+                std::vector<node*>& locked_nodes) {
             assert(this->lock.is_write_locked());
             assert(!this->parent || this->parent->lock.is_write_locked());
             assert((this->parent != nullptr) || root_lock.is_write_locked());
             assert(this->isLeaf() || souffle::contains(locked_nodes, this));
             assert(!this->parent || souffle::contains(locked_nodes, const_cast<node*>(this->parent)));
 #else
-        int rebalance_or_split(node** root, lock_type& root_lock, int idx) {
+        int rebalance_or_split(node** root, lock_type& root_lock, MemoryPool& pool, int idx) {
 #endif
 
             // this node is full ... and needs some space
@@ -637,7 +837,7 @@ protected:
                 // lock access to left sibling
                 if (!left->lock.try_start_write()) {
                     // left node is currently updated => skip balancing and split
-                    split(root, root_lock, idx, locked_nodes);
+                    split(root, root_lock, pool, idx, locked_nodes);
                     return 0;
                 }
 #endif
@@ -708,9 +908,9 @@ protected:
 
             // Option B) split node
 #ifdef IS_PARALLEL
-            split(root, root_lock, idx, locked_nodes);
+            split(root, root_lock, pool, idx, locked_nodes);
 #else
-            split(root, root_lock, idx);
+            split(root, root_lock, pool, idx);
 #endif
             return 0;  // = no re-balancing
         }
@@ -725,21 +925,22 @@ protected:
          * @param sibling .. the new right-sibling to be add to the parent node
          */
 #ifdef IS_PARALLEL
-        void grow_parent(node** root, lock_type& root_lock, node* sibling, std::vector<node*>& locked_nodes) {
+        void grow_parent(node** root, lock_type& root_lock, MemoryPool& pool, node* sibling,
+                std::vector<node*>& locked_nodes) {
             assert(this->lock.is_write_locked());
             assert(!this->parent || this->parent->lock.is_write_locked());
             assert((this->parent != nullptr) || root_lock.is_write_locked());
             assert(this->isLeaf() || souffle::contains(locked_nodes, this));
             assert(!this->parent || souffle::contains(locked_nodes, const_cast<node*>(this->parent)));
 #else
-        void grow_parent(node** root, lock_type& root_lock, node* sibling) {
+        void grow_parent(node** root, lock_type& root_lock, MemoryPool& pool, node* sibling) {
 #endif
 
             if (this->parent == nullptr) {
                 assert(*root == this);
 
                 // create a new root node
-                auto* new_root = new inner_node();
+                auto* new_root = makeInner(pool);
                 new_root->numElements = 1;
                 new_root->keys[0] = keys[this->numElements];
 
@@ -761,9 +962,9 @@ protected:
 
 #ifdef IS_PARALLEL
                 parent->insert_inner(
-                        root, root_lock, pos, this, keys[this->numElements], sibling, locked_nodes);
+                        root, root_lock, pool, pos, this, keys[this->numElements], sibling, locked_nodes);
 #else
-                parent->insert_inner(root, root_lock, pos, this, keys[this->numElements], sibling);
+                parent->insert_inner(root, root_lock, pool, pos, this, keys[this->numElements], sibling);
 #endif
             }
         }
@@ -777,12 +978,14 @@ protected:
          * @param newNode .. the new right-child of the inserted key
          */
 #ifdef IS_PARALLEL
-        void insert_inner(node** root, lock_type& root_lock, unsigned pos, node* predecessor, const Key& key,
+        void insert_inner(node** root, lock_type& root_lock, MemoryPool& pool, unsigned pos,
+                node* predecessor, const Key& key,
                 node* newNode, std::vector<node*>& locked_nodes) {
             assert(this->lock.is_write_locked());
             assert(souffle::contains(locked_nodes, this));
 #else
-        void insert_inner(node** root, lock_type& root_lock, unsigned pos, node* predecessor, const Key& key,
+        void insert_inner(node** root, lock_type& root_lock, MemoryPool& pool, unsigned pos,
+                node* predecessor, const Key& key,
                 node* newNode) {
 #endif
 
@@ -796,9 +999,9 @@ protected:
 
                 // split this node
 #ifdef IS_PARALLEL
-                pos -= rebalance_or_split(root, root_lock, pos, locked_nodes);
+                pos -= rebalance_or_split(root, root_lock, pool, pos, locked_nodes);
 #else
-                pos -= rebalance_or_split(root, root_lock, pos);
+                pos -= rebalance_or_split(root, root_lock, pool, pos);
 #endif
 
                 // complete insertion within new sibling if necessary
@@ -820,9 +1023,9 @@ protected:
                         if (other->getChild(i) == predecessor) break;
 
                     pos = (i > other->numElements) ? 0 : i;
-                    other->insert_inner(root, root_lock, pos, predecessor, key, newNode, locked_nodes);
+                    other->insert_inner(root, root_lock, pool, pos, predecessor, key, newNode, locked_nodes);
 #else
-                    other->insert_inner(root, root_lock, pos, predecessor, key, newNode);
+                    other->insert_inner(root, root_lock, pool, pos, predecessor, key, newNode);
 #endif
                     return;
                 }
@@ -1062,20 +1265,17 @@ protected:
 
         // a simple default constructor initializing member fields
         inner_node() : node(true) {}
-
-        // a destruction operation clearing up child nodes recursively
-        void cleanup() {
-            for (unsigned i = 0; i <= this->numElements; ++i) {
-                delete children[i];
-            }
-        }
     };
 
     /**
-     * The data type representing leaf nodes of the b-tree. It does not
-     * add any capabilities to the generic node type.
+     * The data type representing leaf nodes of the b-tree. It extends
+     * the generic node type by a link to the next leaf in key order,
+     * utilized to prefetch and locate the successor leaf during scans.
      */
     struct leaf_node : public node {
+        // the next leaf in key order, maintained by node splits
+        leaf_node* next = nullptr;
+
         // a simple default constructor initializing member fields
         leaf_node() : node(false) {}
     };
@@ -1093,6 +1293,11 @@ public:
         // the index of the element currently addressed within the referenced node
         field_index_type pos = 0;
 
+        // the leaf containing the in-order successor of the inner element
+        // currently addressed, recorded while climbing out of a leaf; it
+        // saves the re-descend through the inner nodes when available
+        leaf_node const* nextLeaf = nullptr;
+
     public:
         // default constructor -- creating an end-iterator
         iterator() : cur(nullptr) {}
@@ -1101,12 +1306,13 @@ public:
         iterator(node const* cur, field_index_type pos) : cur(cur), pos(pos) {}
 
         // a copy constructor
-        iterator(const iterator& other) : cur(other.cur), pos(other.pos) {}
+        iterator(const iterator& other) : cur(other.cur), pos(other.pos), nextLeaf(other.nextLeaf) {}
 
         // an assignment operator
         iterator& operator=(const iterator& other) {
             cur = other.cur;
             pos = other.pos;
+            nextLeaf = other.nextLeaf;
             return *this;
         }
 
@@ -1134,14 +1340,27 @@ public:
 
             // otherwise it is a bit more tricky
 
-            // A) currently in an inner node => go to the left-most child
+            // A) currently in an inner node => go to the next leaf in order
             if (cur->isInner()) {
-                cur = cur->getChildren()[pos + 1];
-                while (!cur->isLeaf()) {
-                    cur = cur->getChildren()[0];
+                if (nextLeaf != nullptr) {
+                    // the chain of leaves knows the successor leaf already;
+                    // no need to re-descend through the inner nodes
+                    cur = nextLeaf;
+                    nextLeaf = nullptr;
+                } else {
+                    cur = cur->getChildren()[pos + 1];
+                    while (!cur->isLeaf()) {
+                        cur = cur->getChildren()[0];
+                    }
                 }
                 pos = 0;
 
+                // fetch the leaf after this one ahead of time; scans reach
+                // it long before the hardware prefetcher would
+                if (const auto* after = static_cast<leaf_node const*>(cur)->next) {
+                    __builtin_prefetch(after->keys);
+                }
+
                 // nodes may be empty due to biased insertion
                 if (!cur->isEmpty()) {
                     return *this;
@@ -1152,6 +1371,9 @@ public:
             assert(cur->isLeaf());
             assert(pos == cur->getNumElements());
 
+            // remember where the in-order successor of the inner element
+            // we are climbing to is located
+            nextLeaf = static_cast<leaf_node const*>(cur)->next;
             while (cur != nullptr && pos == cur->getNumElements()) {
                 pos = cur->getPositionInParent();
                 cur = cur->getParent();
@@ -1197,7 +1419,9 @@ public:
         }
     };
 
-    using operation_hints = btree_operation_hints<1>;
+    // remember the last two distinct nodes per operation, covering
+    // bimodal access patterns alternating between two index regions
+    using operation_hints = btree_operation_hints<2>;
 
 protected:
 #ifdef IS_PARALLEL
@@ -1217,6 +1441,9 @@ protected:
     // a pointer to the left-most node of this tree (initial note for iteration)
     leaf_node* leftmost;
 
+    // the memory pool all nodes of this tree are allocated from
+    MemoryPool pool;
+
     /* -------------- operator hint statistics ----------------- */
 
     // an aggregation of statistical values of the hint utilization
@@ -1257,7 +1484,8 @@ public:
 
     // a move constructor
     btree(btree&& other)
-            : comp(other.comp), weak_comp(other.weak_comp), root(other.root), leftmost(other.leftmost) {
+            : comp(other.comp), weak_comp(other.weak_comp), root(other.root), leftmost(other.leftmost),
+              pool(std::move(other.pool)) {
         other.root = nullptr;
         other.leftmost = nullptr;
     }
@@ -1268,13 +1496,6 @@ public:
         *this = set;
     }
 
-protected:
-    /**
-     * An internal constructor enabling the specific creation of a tree
-     * based on internal parameters.
-     */
-    btree(size_type size, node* root, leaf_node* leftmost) : root(root), leftmost(leftmost) {}
-
 public:
     // the destructor freeing all contained nodes
     ~btree() {
@@ -1323,7 +1544,7 @@ public:
             }
 
             // create new node
-            leftmost = new leaf_node();
+            leftmost = node::makeLeaf(pool);
             leftmost->numElements = 1;
             leftmost->keys[0] = k;
             root = leftmost;
@@ -1515,7 +1736,7 @@ public:
 
                 // split this node
                 auto old_root = root;
-                idx -= cur->rebalance_or_split(const_cast<node**>(&root), root_lock, idx, parents);
+                idx -= cur->rebalance_or_split(const_cast<node**>(&root), root_lock, pool, idx, parents);
 
                 // release parent lock
                 for (auto it = parents.rbegin(); it != parents.rend(); ++it) {
@@ -1567,7 +1788,7 @@ public:
         // special handling for inserting first element
         if (empty()) {
             // create new node
-            leftmost = new leaf_node();
+            leftmost = node::makeLeaf(pool);
             leftmost->numElements = 1;
             leftmost->keys[0] = k;
             root = leftmost;
@@ -1642,7 +1863,7 @@ public:
 
             if (cur->numElements >= node::maxKeys) {
                 // split this node
-                idx -= cur->rebalance_or_split(&root, root_lock, idx);
+                idx -= cur->rebalance_or_split(&root, root_lock, pool, idx);
 
                 // insert element in right fragment
                 if (((size_type)idx) > cur->numElements) {
@@ -1676,7 +1897,14 @@ public:
      */
     template <typename Iter>
     void insert(const Iter& a, const Iter& b) {
-        // TODO: improve this beyond a naive insert
+        // fast path: a sorted range loaded into an empty tree is assembled
+        // bottom-up, avoiding the repeated node splits of incremental inserts
+        if (empty() && a != b &&
+                std::is_sorted(a, b, [&](const Key& x, const Key& y) { return this->less(x, y); })) {
+            build(a, b);
+            return;
+        }
+
         operation_hints hints;
         // a naive insert so far .. seems to work fine
         for (auto it = a; it != b; ++it) {
@@ -1685,6 +1913,37 @@ public:
         }
     }
 
+    /**
+     * Bulk-loads the given sorted range of elements into this (empty) tree
+     * by materializing leaf and inner nodes bottom-up at maximal fill. The
+     * input must be ordered with respect to the tree's comparator; for set
+     * instances duplicated elements are skipped.
+     */
+    template <typename Iter>
+    void build(const Iter& a, const Iter& b) {
+        assert(empty() && "bulk-load is only supported on empty trees");
+
+        // count the number of elements to be stored (ignoring duplicates in sets)
+        size_type num = 0;
+        for (auto it = a; it != b; ++num) {
+            next_distinct(it, b);
+        }
+        if (num == 0) {
+            return;
+        }
+
+        // determine the capacity of a sub-tree of any given height ...
+        std::vector<size_type> capacity(1, node::maxKeys);
+        while (capacity.back() < num) {
+            capacity.push_back(node::maxKeys + (node::maxKeys + 1) * capacity.back());
+        }
+
+        // ... and assemble a tree of minimal height accordingly
+        auto cur = a;
+        root = materializeSubtree(cur, b, num, capacity.size() - 1, capacity);
+        assert(cur == b);
+    }
+
     /**
      * Inserts all elements of the given b-tree into this tree.
      * This can be a more effective alternative to the ordered insertion
@@ -1720,15 +1979,67 @@ public:
     }
 
     /**
-     * Partitions the full range of this set into up to a given number of chunks.
-     * The chunks will cover approximately the same number of elements. Also, the
-     * number of chunks will only approximate the desired number of chunks.
+     * Partitions the full range of this set into up to a given number of
+     * chunks suitable for parallel processing. The chunks are first collected
+     * along the subtree structure (see getChunks()); since subtrees of equal
+     * height may differ in size by a factor exponential in their height, the
+     * chunks are then counted and those dominating the average are fragmented
+     * further -- spreading the work of a heavily skewed key range across all
+     * threads instead of leaving it with a single one. The counting pass
+     * costs one traversal of the tree, amortized against the parallel work
+     * the partition feeds.
      *
      * @param num .. the number of chunks requested
      * @return a list of chunks partitioning this tree
      */
     std::vector<chunk> partition(size_type num) const {
-        return getChunks(num);
+        auto chunks = getChunks(num);
+        if (chunks.size() < 2) {
+            return chunks;
+        }
+
+        // the granularity of the split points remembered while counting
+        const size_type step = 256;
+        // the factor by which a chunk must exceed the average to be re-split
+        const size_type skewFactor = 2;
+
+        // count each chunk, remembering intermediate positions such that
+        // heavy chunks can be fragmented without a second traversal
+        std::vector<size_type> sizes(chunks.size(), 0);
+        std::vector<std::vector<iterator>> marks(chunks.size());
+        size_type total = 0;
+        for (std::size_t i = 0; i < chunks.size(); ++i) {
+            size_type count = 0;
+            for (auto it = chunks[i].begin(); it != chunks[i].end(); ++it) {
+                if (count != 0 && count % step == 0) {
+                    marks[i].push_back(it);
+                }
+                ++count;
+            }
+            sizes[i] = count;
+            total += count;
+        }
+
+        const size_type mean = std::max<size_type>(total / chunks.size(), 1);
+
+        std::vector<chunk> res;
+        res.reserve(chunks.size());
+        for (std::size_t i = 0; i < chunks.size(); ++i) {
+            if (sizes[i] <= skewFactor * mean || marks[i].empty()) {
+                res.push_back(chunks[i]);
+                continue;
+            }
+            // fragment the dominating chunk into approximately mean-sized
+            // pieces at the granularity of the remembered split points
+            const size_type stride = std::max<size_type>(mean / step, 1);
+            iterator last = chunks[i].begin();
+            for (size_type j = stride - 1; j < marks[i].size(); j += stride) {
+                res.push_back(chunk(last, marks[i][j]));
+                last = marks[i][j];
+            }
+            res.push_back(chunk(last, chunks[i].end()));
+        }
+        return res;
     }
 
     std::vector<chunk> getChunks(size_type num) const {
@@ -1754,6 +2065,59 @@ public:
         return find(k, hints) != end();
     }
 
+    /**
+     * Tests a batch of keys for membership, writing one flag per key.
+     * The descents proceed in lockstep rounds over a small group of
+     * probes: each round advances every pending probe by one node and
+     * prefetches the node its next round will visit, so the cache
+     * misses of the independent descents overlap instead of
+     * serializing one root-to-leaf walk after the other.
+     */
+    void containsBatch(const Key* keys, std::size_t count, bool* result) const {
+        if (empty()) {
+            for (std::size_t i = 0; i < count; ++i) {
+                result[i] = false;
+            }
+            return;
+        }
+        constexpr std::size_t groupSize = 8;
+        for (std::size_t first = 0; first < count; first += groupSize) {
+            const std::size_t numProbes = std::min(groupSize, count - first);
+            node* cur[groupSize];
+            bool done[groupSize] = {};
+            for (std::size_t i = 0; i < numProbes; ++i) {
+                cur[i] = root;
+            }
+            std::size_t pending = numProbes;
+            while (pending > 0) {
+                for (std::size_t i = 0; i < numProbes; ++i) {
+                    if (done[i]) {
+                        continue;
+                    }
+                    const Key& k = keys[first + i];
+                    auto a = &(cur[i]->keys[0]);
+                    auto b = &(cur[i]->keys[cur[i]->numElements]);
+                    auto pos = search(k, a, b, comp);
+                    if (pos < b && equal(*pos, k)) {
+                        result[first + i] = true;
+                        done[i] = true;
+                        --pending;
+                        continue;
+                    }
+                    if (!cur[i]->inner) {
+                        result[first + i] = false;
+                        done[i] = true;
+                        --pending;
+                        continue;
+                    }
+                    node* next = cur[i]->getChild(pos - a);
+                    __builtin_prefetch(next->keys);
+                    cur[i] = next;
+                }
+            }
+        }
+    }
+
     /**
      * Locates the given key within this tree and returns an iterator
      * referencing its position. If not found, an end-iterator will be returned.
@@ -1931,11 +2295,66 @@ public:
         }
     }
 
+    /**
+     * Obtains an upper boundary with respect to an alternative comparator --
+     * hence an iterator referencing the first element strictly greater than
+     * the given key under that comparator. The alternative comparator must
+     * be consistent with the tree's order in the sense that it never ranks
+     * two elements opposite to the tree's comparator, e.g. a comparison on
+     * a prefix of the indexed columns. Allows skipping all elements sharing
+     * a key prefix in a single descent when scanning for distinct prefixes.
+     */
+    template <typename AltComparator>
+    iterator upper_bound(const Key& k, AltComparator& altComp) const {
+        if (empty()) {
+            return end();
+        }
+
+        node* cur = root;
+        iterator res = end();
+        while (true) {
+            auto a = &(cur->keys[0]);
+            auto b = &(cur->keys[cur->numElements]);
+
+            auto pos = search.upper_bound(k, a, b, altComp);
+            auto idx = pos - a;
+
+            if (!cur->inner) {
+                return (pos != b) ? iterator(cur, idx) : res;
+            }
+
+            if (pos != b) {
+                res = iterator(cur, idx);
+            }
+
+            cur = cur->getChild(idx);
+        }
+    }
+
     /**
      * Clears this tree.
      */
     void clear() {
-        delete root;
+        if (root && !std::is_trivially_destructible<Key>::value) {
+            node::destroy(root);
+        }
+        pool.reset();
+        root = nullptr;
+        leftmost = nullptr;
+    }
+
+    /**
+     * Clears this tree while keeping its node memory for subsequent
+     * insertions. Intended for trees that are cleared and re-filled with a
+     * similar shape right after, e.g. the delta relations at semi-naive
+     * iteration boundaries, where it avoids returning the node chunks to
+     * the system just to request them back.
+     */
+    void recycle() {
+        if (root && !std::is_trivially_destructible<Key>::value) {
+            node::destroy(root);
+        }
+        pool.recycle();
         root = nullptr;
         leftmost = nullptr;
     }
@@ -1949,6 +2368,7 @@ public:
         // swap the content
         std::swap(root, other.root);
         std::swap(leftmost, other.leftmost);
+        pool.swap(other.pool);
     }
 
     // Implementation of the assignment operation for trees.
@@ -1965,7 +2385,7 @@ public:
         }
 
         // clone content (deep copy)
-        root = other.root->clone();
+        root = other.root->clone(pool);
 
         // update leftmost reference
         auto tmp = root;
@@ -2019,6 +2439,11 @@ public:
         return (empty()) ? 0 : root->countNodes();
     }
 
+    // Determines the number of keys each node can hold.
+    static constexpr size_type getNodeCapacity() {
+        return node::maxKeys;
+    }
+
     // Determines the amount of memory used by this data structure
     size_type getMemoryUsage() const {
         return sizeof(*this) + (empty() ? 0 : root->getMemoryUsage());
@@ -2101,13 +2526,15 @@ public:
                                            std::random_access_iterator_tag>::value,
             R>::type
     load(const Iter& a, const Iter& b) {
+        R res;
+
         // quick exit - empty range
         if (a == b) {
-            return R();
+            return res;
         }
 
-        // resolve tree recursively
-        auto root = buildSubTree(a, b - 1);
+        // resolve tree recursively within the pool of the resulting tree
+        auto root = buildSubTree(res.pool, a, b - 1);
 
         // find leftmost node
         node* leftmost = root;
@@ -2116,7 +2543,9 @@ public:
         }
 
         // build result
-        return R(b - a, root, static_cast<leaf_node*>(leftmost));
+        res.root = root;
+        res.leftmost = static_cast<leaf_node*>(leftmost);
+        return res;
     }
 
 protected:
@@ -2160,7 +2589,7 @@ private:
 
     // Utility function for the load operation above.
     template <typename Iter>
-    static node* buildSubTree(const Iter& a, const Iter& b) {
+    static node* buildSubTree(MemoryPool& pool, const Iter& a, const Iter& b) {
         const int N = node::maxKeys;
 
         // divide range in N+1 sub-ranges
@@ -2169,7 +2598,7 @@ private:
         // terminal case: length is less then maxKeys
         if (length <= N) {
             // create a leaf node
-            node* res = new leaf_node();
+            node* res = node::makeLeaf(pool);
             res->numElements = length;
 
             for (int i = 0; i < length; ++i) {
@@ -2189,7 +2618,7 @@ private:
         }
 
         // create inner node
-        node* res = new inner_node();
+        node* res = node::makeInner(pool);
         res->numElements = numKeys;
 
         Iter c = a;
@@ -2198,7 +2627,7 @@ private:
             res->keys[i] = c[step];
 
             // get sub-tree
-            auto child = buildSubTree(c, c + (step - 1));
+            auto child = buildSubTree(pool, c, c + (step - 1));
             child->parent = res;
             child->position = i;
             res->getChildren()[i] = child;
@@ -2207,7 +2636,7 @@ private:
         }
 
         // and the remaining part
-        auto child = buildSubTree(c, b);
+        auto child = buildSubTree(pool, c, b);
         child->parent = res;
         child->position = numKeys;
         res->getChildren()[numKeys] = child;
@@ -2215,6 +2644,72 @@ private:
         // done
         return res;
     }
+
+    /**
+     * Moves the given iterator to the next distinct element in the covered
+     * range -- thereby skipping over duplicates in case this tree is a set.
+     */
+    template <typename Iter>
+    void next_distinct(Iter& cur, const Iter& b) const {
+        auto last = cur;
+        ++cur;
+        if (isSet) {
+            while (cur != b && equal(*last, *cur)) {
+                ++cur;
+            }
+        }
+    }
+
+    /**
+     * Materializes a sub-tree of the given height covering the given number
+     * of elements obtained from the given sorted stream of elements. Nodes
+     * are filled to capacity where possible; elements between sibling
+     * sub-trees are retained as separator keys in their parent. Utilized by
+     * the bulk-load operation above.
+     */
+    template <typename Iter>
+    node* materializeSubtree(Iter& cur, const Iter& b, size_type num, unsigned height,
+            const std::vector<size_type>& capacity) {
+        // terminal case: assemble a leaf node
+        if (height == 0) {
+            assert(num <= node::maxKeys);
+            auto* res = node::makeLeaf(pool);
+            res->numElements = num;
+            for (size_type i = 0; i < num; ++i) {
+                res->keys[i] = *cur;
+                next_distinct(cur, b);
+            }
+            if (!leftmost) {
+                leftmost = res;
+            }
+            return res;
+        }
+
+        // recursive case: determine the number of children ...
+        auto childCapacity = capacity[height - 1];
+        size_type numChildren = (num + childCapacity + 1) / (childCapacity + 1);
+        assert(numChildren >= 2 && numChildren <= node::maxKeys + 1);
+
+        // ... and distribute the elements not serving as separator keys evenly
+        size_type numRest = num - (numChildren - 1);
+        size_type share = numRest / numChildren;
+        size_type overhang = numRest % numChildren;
+
+        auto* res = node::makeInner(pool);
+        res->numElements = numChildren - 1;
+        for (size_type i = 0; i < numChildren; ++i) {
+            auto* child =
+                    materializeSubtree(cur, b, share + ((i < overhang) ? 1 : 0), height - 1, capacity);
+            child->parent = res;
+            child->position = i;
+            res->children[i] = child;
+            if (i < numChildren - 1) {
+                res->keys[i] = *cur;
+                next_distinct(cur, b);
+            }
+        }
+        return res;
+    }
 };  // namespace souffle
 
 // Instantiation of static member search.
@@ -2267,12 +2762,6 @@ public:
     // A move constructor.
     btree_set(btree_set&& other) : super(std::move(other)) {}
 
-private:
-    // A constructor required by the bulk-load facility.
-    template <typename s, typename n, typename l>
-    btree_set(s size, n* root, l* leftmost) : super(size, root, leftmost) {}
-
-public:
     // Support for the assignment operator.
     btree_set& operator=(const btree_set& other) {
         super::operator=(other);
@@ -2328,12 +2817,6 @@ public:
     // A move constructor.
     btree_multiset(btree_multiset&& other) : super(std::move(other)) {}
 
-private:
-    // A constructor required by the bulk-load facility.
-    template <typename s, typename n, typename l>
-    btree_multiset(s size, n* root, l* leftmost) : super(size, root, leftmost) {}
-
-public:
     // Support for the assignment operator.
     btree_multiset& operator=(const btree_multiset& other) {
         super::operator=(other);
@@ -0,0 +1,127 @@
+/*
+ * Souffle - A Datalog Compiler
+ * Copyright (c) 2019, The Souffle Developers. All rights reserved.
+ * Licensed under the Universal Permissive License v 1.0 as shown at:
+ * - https://opensource.org/licenses/UPL
+ * - <souffle root>/licenses/SOUFFLE-UPL.txt
+ */
+
+/************************************************************************
+ *
+ * @file BloomFilter.h
+ *
+ * A Bloom filter guarding membership probes into large relations.
+ * Negated literals compile into contains() calls that usually miss;
+ * consulting the filter first turns most misses into two cache-resident
+ * bit probes instead of a full tree descent.
+ *
+ ***********************************************************************/
+
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+namespace souffle {
+
+/**
+ * A Bloom filter over tuple hashes. The filter is built once from a
+ * completed relation and consulted before the relation's own membership
+ * check; a negative answer is definite, a positive one is confirmed by
+ * the underlying data structure. An unbuilt filter answers positively
+ * for every query, such that probing degrades to the plain membership
+ * check when the building stratum did not run (e.g. on an incremental
+ * re-run or a single-stratum execution).
+ */
+class BloomFilter {
+public:
+    /**
+     * Computes the hash of a tuple, mixing all components.
+     * @param tuple the tuple to be hashed
+     * @return the tuple's hash value
+     */
+    template <typename Tuple>
+    static uint64_t hash(const Tuple& tuple) {
+        // FNV-1a over the tuple components
+        uint64_t h = 14695981039346656037ull;
+        for (std::size_t i = 0; i < Tuple::arity; i++) {
+            h ^= static_cast<uint64_t>(static_cast<uint32_t>(tuple[i]));
+            h *= 1099511628211ull;
+        }
+        return h;
+    }
+
+    /**
+     * Builds the filter from the tuples of the given relation, sized
+     * from its cardinality. Any previous content is discarded.
+     * @param relation the relation to index
+     */
+    template <typename Relation>
+    void build(const Relation& relation) {
+        // ~10 bits per element with two probes keeps the false-positive
+        // rate in the low percent range
+        const std::size_t bitsPerElement = 10;
+        std::size_t bits = 64;
+        while (bits < relation.size() * bitsPerElement) {
+            bits <<= 1;
+        }
+        words.assign(bits / 64, 0);
+        mask = bits - 1;
+        for (const auto& tuple : relation) {
+            add(hash(tuple));
+        }
+    }
+
+    /**
+     * Adds a tuple hash to the filter.
+     * @param h the hash of the tuple to add
+     */
+    void add(uint64_t h) {
+        setBit(h & mask);
+        setBit(rehash(h) & mask);
+    }
+
+    /**
+     * Tests whether a tuple with the given hash may be contained.
+     * @param h the hash of the tuple to probe for
+     * @return false if the tuple is definitely absent, true otherwise
+     */
+    bool mayContain(uint64_t h) const {
+        // an unbuilt filter cannot rule anything out
+        if (words.empty()) {
+            return true;
+        }
+        return testBit(h & mask) && testBit(rehash(h) & mask);
+    }
+
+    /**
+     * Discards the filter's content, reverting it to the unbuilt state.
+     */
+    void clear() {
+        words.clear();
+        mask = 0;
+    }
+
+private:
+    /** Derives a second, independent hash from the primary one */
+    static uint64_t rehash(uint64_t h) {
+        h *= 0x9e3779b97f4a7c15ull;
+        return h ^ (h >> 29);
+    }
+
+    void setBit(uint64_t bit) {
+        words[bit >> 6] |= (uint64_t(1) << (bit & 63));
+    }
+
+    bool testBit(uint64_t bit) const {
+        return (words[bit >> 6] & (uint64_t(1) << (bit & 63))) != 0;
+    }
+
+    /** the bit array, in 64-bit words; empty until built */
+    std::vector<uint64_t> words;
+
+    /** the bit-index mask; the number of bits is a power of two */
+    uint64_t mask = 0;
+};
+
+}  // end of namespace souffle
@@ -27,6 +27,7 @@
 #pragma once
 
 #include "CompiledTuple.h"
+#include "MemoryPool.h"
 #include "RamTypes.h"
 #include "Util.h"
 
@@ -36,6 +37,10 @@
 #include <iterator>
 #include <utility>
 
+#if defined(__AVX2__)
+#include <immintrin.h>
+#endif
+
 namespace souffle {
 
 namespace detail {
@@ -77,6 +82,71 @@ struct default_merge {
     }
 };
 
+#if defined(__AVX2__)
+
+/**
+ * A lookup table mapping each byte value to the list of positions of its
+ * set bits, utilized for expanding bit masks into position lists in bulk.
+ */
+struct bit_position_table {
+    // the (up to 8) bit positions set in each byte value, padded with zeros
+    alignas(16) uint8_t positions[256][8];
+
+    // the number of bits set in each byte value
+    uint8_t count[256];
+
+    bit_position_table() {
+        for (unsigned byte = 0; byte < 256; ++byte) {
+            uint8_t cnt = 0;
+            for (uint8_t pos = 0; pos < 8; ++pos) {
+                if (byte & (1u << pos)) {
+                    positions[byte][cnt++] = pos;
+                }
+            }
+            count[byte] = cnt;
+            for (uint8_t pos = cnt; pos < 8; ++pos) {
+                positions[byte][pos] = 0;
+            }
+        }
+    }
+};
+
+#endif
+
+/**
+ * Expands the given bit mask into the list of positions of its set bits,
+ * in ascending order. The output buffer must provide space for 64 entries.
+ *
+ * @param mask the bit mask to be expanded
+ * @param out the buffer the positions are written to
+ * @return the number of positions written
+ */
+inline uint8_t expandBitMask(uint64_t mask, uint8_t* out) {
+#if defined(__AVX2__)
+    // expand the mask byte-wise through the position table; for each byte
+    // the 8 candidate positions are shifted to their in-word position and
+    // compacted by advancing the output cursor by the byte's bit count
+    static const bit_position_table table;
+    uint8_t count = 0;
+    for (unsigned i = 0; i < 8; ++i) {
+        auto byte = static_cast<uint8_t>(mask >> (i * 8));
+        __m128i pos = _mm_loadl_epi64(reinterpret_cast<const __m128i*>(table.positions[byte]));
+        pos = _mm_add_epi8(pos, _mm_set1_epi8(static_cast<char>(i * 8)));
+        _mm_storel_epi64(reinterpret_cast<__m128i*>(out + count), pos);
+        count += table.count[byte];
+    }
+    return count;
+#else
+    // the scalar fall-back consuming one set bit at a time
+    uint8_t count = 0;
+    while (mask != 0) {
+        out[count++] = static_cast<uint8_t>(__builtin_ctzll(mask));
+        mask &= mask - 1;
+    }
+    return count;
+#endif
+}
+
 }  // end namespace detail
 
 /**
@@ -175,6 +245,11 @@ private:
         index_type firstOffset;
     };
 
+    // the memory pool all nodes of this array are allocated from; it is
+    // declared before the root information since cloning constructors
+    // allocate nodes while initializing the latter
+    MemoryPool pool{4 * sizeof(Node)};
+
     union {
         RootInfo unsynced;         // for sequential operations
         volatile RootInfo synced;  // for synchronized operations
@@ -192,7 +267,7 @@ public:
      * array instance.
      */
     SparseArray(const SparseArray& other)
-            : unsynced(RootInfo{clone(other.unsynced.root, other.unsynced.levels), other.unsynced.levels,
+            : unsynced(RootInfo{clone(pool, other.unsynced.root, other.unsynced.levels), other.unsynced.levels,
                       other.unsynced.offset, nullptr, other.unsynced.firstOffset}) {
         if (unsynced.root) {
             unsynced.root->parent = nullptr;
@@ -206,7 +281,8 @@ public:
      * handed in array.
      */
     SparseArray(SparseArray&& other)
-            : unsynced(RootInfo{other.unsynced.root, other.unsynced.levels, other.unsynced.offset,
+            : pool(std::move(other.pool)),
+              unsynced(RootInfo{other.unsynced.root, other.unsynced.levels, other.unsynced.offset,
                       other.unsynced.first, other.unsynced.firstOffset}) {
         other.unsynced.root = nullptr;
         other.unsynced.levels = 0;
@@ -234,7 +310,7 @@ public:
 
         // copy content
         unsynced.levels = other.unsynced.levels;
-        unsynced.root = clone(other.unsynced.root, unsynced.levels);
+        unsynced.root = clone(pool, other.unsynced.root, unsynced.levels);
         if (unsynced.root) unsynced.root->parent = nullptr;
         unsynced.offset = other.unsynced.offset;
         unsynced.first = (unsynced.root) ? findFirst(unsynced.root, unsynced.levels) : nullptr;
@@ -252,6 +328,9 @@ public:
         // clean this one
         clean();
 
+        // take over the node storage of the other array
+        pool = std::move(other.pool);
+
         // harvest content
         unsynced.root = other.unsynced.root;
         unsynced.levels = other.unsynced.levels;
@@ -292,43 +371,12 @@ public:
         return res;
     }
 
-private:
-    /**
-     * Computes the memory usage of the given sub-tree.
-     */
-    static std::size_t getMemoryUsage(const Node* node, int level) {
-        // support null-nodes
-        if (!node) return 0;
-
-        // add size of current node
-        std::size_t res = sizeof(Node);
-
-        // sum up memory usage of child nodes
-        if (level > 0) {
-            for (int i = 0; i < NUM_CELLS; i++) {
-                res += getMemoryUsage(node->cell[i].ptr, level - 1);
-            }
-        }
-
-        // done
-        return res;
-    }
-
-public:
     /**
      * Computes the total memory usage of this data structure.
      */
     std::size_t getMemoryUsage() const {
-        // the memory of the wrapper class
-        std::size_t res = sizeof(*this);
-
-        // add nodes
-        if (unsynced.root) {
-            res += getMemoryUsage(unsynced.root, unsynced.levels);
-        }
-
-        // done
-        return res;
+        // the memory of the wrapper class plus the node storage of the pool
+        return sizeof(*this) + pool.getMemoryUsage();
     }
 
     /**
@@ -350,6 +398,12 @@ public:
     struct op_context {
         index_type lastIndex{0};
         Node* lastNode{nullptr};
+        // the parent of the last accessed leaf and the base of its key span;
+        // dense key streams step through neighbouring leaves, which the
+        // parent reaches with a single indexed load instead of repeating the
+        // full root-to-leaf descent
+        index_type lastParentIndex{0};
+        Node* lastParent{nullptr};
         op_context() = default;
     };
 
@@ -561,6 +615,56 @@ private:
             return ctxt.lastNode->cell[i & INDEX_MASK];
         }
 
+        // check whether the cached parent covers the requested index, in
+        // which case the target leaf is a sibling of the last one and can be
+        // reached (or created) with a single indexed load
+        if (ctxt.lastParent && getLevelMask(2) != 0 && ctxt.lastParentIndex == (i & getLevelMask(2))) {
+            Node* node = ctxt.lastParent;
+            std::atomic<Node*>& aNext = node->cell[getIndex(i, 1)].aptr;
+            Node* next = aNext;
+            if (!next) {
+                // create the missing sibling leaf, as in the full descent below
+                Node* newNext = newNode();
+                newNext->parent = node;
+
+                // try to update next
+                if (!aNext.compare_exchange_strong(next, newNext)) {
+                    // some other thread was faster => use its version; the
+                    // temporary node is reclaimed by the pool on reset
+                } else {
+                    // the locally created next is the new next
+                    next = newNext;
+
+                    // compute offset of this node
+                    auto off = i & ~INDEX_MASK;
+
+                    // fast over-approximation of whether a update is necessary
+                    if (off < unsynced.firstOffset) {
+                        // update first reference if this one is the smallest
+                        auto firstInfo = getFirstInfo();
+                        while (off < firstInfo.offset) {
+                            firstInfo.node = next;
+                            firstInfo.offset = off;
+                            if (!tryUpdateFirstInfo(firstInfo)) {
+                                // there was some concurrent update => check again
+                                firstInfo = getFirstInfo();
+                            }
+                        }
+                    }
+                }
+
+                // now next should be defined
+                assert(next);
+            }
+
+            // update context
+            ctxt.lastIndex = (i & ~INDEX_MASK);
+            ctxt.lastNode = next;
+
+            // return reference to proper cell
+            return next->cell[i & INDEX_MASK];
+        }
+
         // get snapshot of root
         auto info = getRootInfo();
 
@@ -592,8 +696,8 @@ private:
                 return info.root->cell[i & INDEX_MASK];
             }
 
-            // somebody else was faster => use standard insertion procedure
-            delete info.root;
+            // somebody else was faster => use standard insertion procedure;
+            // the temporary node is reclaimed by the pool on reset
 
             // retrieve new root info
             info = getRootInfo();
@@ -617,6 +721,7 @@ private:
 
         // navigate to node
         Node* node = info.root;
+        Node* leafParent = nullptr;
         unsigned level = info.levels;
         while (level != 0) {
             // get X coordinate
@@ -635,8 +740,8 @@ private:
 
                 // try to update next
                 if (!aNext.compare_exchange_strong(next, newNext)) {
-                    // some other thread was faster => use updated next
-                    delete newNext;
+                    // some other thread was faster => use its version; the
+                    // temporary node is reclaimed by the pool on reset
                 } else {
                     // the locally created next is the new next
                     next = newNext;
@@ -667,12 +772,17 @@ private:
             }
 
             // continue one level below
+            leafParent = node;
             node = next;
         }
 
         // update context
         ctxt.lastIndex = (i & ~INDEX_MASK);
         ctxt.lastNode = node;
+        if (leafParent) {
+            ctxt.lastParentIndex = (i & getLevelMask(2));
+            ctxt.lastParent = leafParent;
+        }
 
         // return reference to cell
         return node->cell[i & INDEX_MASK];
@@ -732,8 +842,21 @@ public:
             return ctxt.lastNode->cell[i & INDEX_MASK].value;
         }
 
+        // check whether the cached parent covers the requested index, making
+        // the target leaf reachable with a single indexed load
+        if (ctxt.lastParent && getLevelMask(2) != 0 && ctxt.lastParentIndex == (i & getLevelMask(2))) {
+            Node* next = ctxt.lastParent->cell[getIndex(i, 1)].ptr;
+            if (!next) return detail::default_factory<value_type>()();
+
+            // remember context
+            ctxt.lastIndex = (i & ~INDEX_MASK);
+            ctxt.lastNode = next;
+            return next->cell[i & INDEX_MASK].value;
+        }
+
         // navigate to value
         Node* node = unsynced.root;
+        Node* leafParent = nullptr;
         unsigned level = unsynced.levels;
         while (level != 0) {
             // get X coordinate
@@ -749,12 +872,17 @@ public:
             if (!next) return detail::default_factory<value_type>()();
 
             // continue one level below
+            leafParent = node;
             node = next;
         }
 
         // remember context
         ctxt.lastIndex = (i & ~INDEX_MASK);
         ctxt.lastNode = node;
+        if (leafParent) {
+            ctxt.lastParentIndex = (i & getLevelMask(2));
+            ctxt.lastParent = leafParent;
+        }
 
         // return reference to cell
         return node->cell[i & INDEX_MASK].value;
@@ -769,13 +897,13 @@ private:
      * @param src the node to be cloned
      * @param levels the height of the cloned node
      */
-    static void merge(const Node* parent, Node*& trg, const Node* src, int levels) {
+    static void merge(MemoryPool& pool, const Node* parent, Node*& trg, const Node* src, int levels) {
         // if other side is null => done
         if (!src) return;
 
         // if the trg sub-tree is empty, clone the corresponding branch
         if (trg == nullptr) {
-            trg = clone(src, levels);
+            trg = clone(pool, src, levels);
             if (trg) trg->parent = parent;
             return;  // done
         }
@@ -793,7 +921,7 @@ private:
 
         // the recursive step
         for (int i = 0; i < NUM_CELLS; ++i) {
-            merge(trg, trg->cell[i].ptr, src->cell[i].ptr, levels - 1);
+            merge(pool, trg, trg->cell[i].ptr, src->cell[i].ptr, levels - 1);
         }
     }
 
@@ -842,7 +970,7 @@ public:
         }
 
         // merge sub-branches from here
-        merge((*node)->parent, *node, other.unsynced.root, level);
+        merge(pool, (*node)->parent, *node, other.unsynced.root, level);
 
         // update first
         if (unsynced.firstOffset > other.unsynced.firstOffset) {
@@ -1200,30 +1328,18 @@ private:
     /**
      * Creates new nodes and initializes them with 0.
      */
-    static Node* newNode() {
-        auto* res = new Node();
+    Node* newNode() {
+        auto* res = new (pool.allocate(sizeof(Node))) Node();
         std::memset(res->cell, 0, sizeof(Cell) * NUM_CELLS);
         return res;
     }
 
     /**
-     * Destroys a node and all its sub-nodes recursively.
-     */
-    static void freeNodes(Node* node, int level) {
-        if (!node) return;
-        if (level != 0) {
-            for (int i = 0; i < NUM_CELLS; i++) {
-                freeNodes(node->cell[i].ptr, level - 1);
-            }
-        }
-        delete node;
-    }
-
-    /**
-     * Conducts a cleanup of the internal tree structure.
+     * Conducts a cleanup of the internal tree structure by releasing
+     * the backing memory pool at once.
      */
     void clean() {
-        freeNodes(unsynced.root, unsynced.levels);
+        pool.reset();
         unsynced.root = nullptr;
         unsynced.levels = 0;
     }
@@ -1231,12 +1347,12 @@ private:
     /**
      * Clones the given node and all its sub-nodes.
      */
-    static Node* clone(const Node* node, int level) {
+    static Node* clone(MemoryPool& pool, const Node* node, int level) {
         // support null-pointers
         if (!node) return nullptr;
 
         // create a clone
-        auto* res = new Node();
+        auto* res = new (pool.allocate(sizeof(Node))) Node();
 
         // handle leaf level
         if (level == 0) {
@@ -1249,7 +1365,7 @@ private:
 
         // for inner nodes clone each child
         for (int i = 0; i < NUM_CELLS; i++) {
-            auto cur = clone(node->cell[i].ptr, level - 1);
+            auto cur = clone(pool, node->cell[i].ptr, level - 1);
             if (cur) cur->parent = res;
             res->cell[i].ptr = cur;
         }
@@ -1338,8 +1454,7 @@ private:
             // success => final step, update parent of old root
             oldRoot->parent = info.root;
         } else {
-            // throw away temporary new node
-            delete newRoot;
+            // the temporary new node is reclaimed by the pool on reset
         }
     }
 
@@ -1550,7 +1665,10 @@ public:
     // ---------------------------------------------------------------------
 
     /**
-     * An iterator iterating over all indices set to 1.
+     * An iterator iterating over all indices set to 1. Whenever a new mask
+     * is entered, the positions of all its set bits are expanded into a
+     * position buffer in bulk (SIMD supported), such that stepping through
+     * the mask degenerates to walking a small array.
      */
     class iterator : public std::iterator<std::forward_iterator_tag, index_type> {
         using nested_iterator = typename data_store_t::iterator;
@@ -1558,8 +1676,16 @@ public:
         // the iterator through the underlying sparse data structure
         nested_iterator iter;
 
-        // the currently consumed mask
-        uint64_t mask = 0;
+        // the bulk-decoded positions of the set bits in the current mask
+        uint8_t positions[BITS_PER_ENTRY];
+
+        // the number of decoded positions
+        short count = 0;
+
+        // the buffer position of the currently visited bit; -1 indicates
+        // that the current value has been provided externally and the
+        // decoded positions are all still to be visited
+        short pos = 0;
 
         // the value currently pointed to
         index_type value;
@@ -1568,13 +1694,15 @@ public:
         // default constructor -- creating an end-iterator
         iterator() = default;
 
-        iterator(const nested_iterator& iter)
-                : iter(iter), mask(toMask(iter->second)), value(iter->first << LEAF_INDEX_WIDTH) {
-            moveToNextInMask();
+        iterator(const nested_iterator& iter) : iter(iter), value(iter->first << LEAF_INDEX_WIDTH) {
+            count = detail::expandBitMask(toMask(iter->second), positions);
+            if (count > 0) value |= positions[0];
         }
 
         iterator(const nested_iterator& iter, uint64_t m, index_type value)
-                : iter(iter), mask(m), value(value) {}
+                : iter(iter), pos(-1), value(value) {
+            count = detail::expandBitMask(m, positions);
+        }
 
         // a copy constructor
         iterator(const iterator& other) = default;
@@ -1585,7 +1713,7 @@ public:
         // the equality operator as required by the iterator concept
         bool operator==(const iterator& other) const {
             // only equivalent if pointing to the end
-            return iter == other.iter && mask == other.mask;
+            return iter == other.iter && (count - pos) == (other.count - other.pos);
         }
 
         // the not-equality operator as required by the iterator concept
@@ -1605,17 +1733,25 @@ public:
 
         // the increment operator as required by the iterator concept
         iterator& operator++() {
-            // progress in current mask
-            if (moveToNextInMask()) return *this;
+            // progress in the current position buffer
+            if (++pos < count) {
+                value &= ~LEAF_INDEX_MASK;
+                value |= positions[pos];
+                return *this;
+            }
 
             // go to next entry
             ++iter;
 
-            // update value
+            // decode the next mask in bulk
             if (!iter.isEnd()) {
                 value = iter->first << LEAF_INDEX_WIDTH;
-                mask = toMask(iter->second);
-                moveToNextInMask();
+                count = detail::expandBitMask(toMask(iter->second), positions);
+                pos = 0;
+                if (count > 0) value |= positions[0];
+            } else {
+                count = 0;
+                pos = 0;
             }
 
             // done
@@ -1627,7 +1763,12 @@ public:
         }
 
         void print(std::ostream& out) const {
-            out << "SparseBitMapIter(" << iter << " -> " << std::bitset<64>(mask) << " @ " << value << ")";
+            // re-assemble the remaining portion of the current mask
+            std::bitset<64> mask;
+            for (short i = (pos < 0) ? 0 : pos + 1; i < count; ++i) {
+                mask.set(positions[i]);
+            }
+            out << "SparseBitMapIter(" << iter << " -> " << mask << " @ " << value << ")";
         }
 
         // enables this iterator core to be printed (for debugging)
@@ -1640,25 +1781,6 @@ public:
             static_assert(sizeof(value_t) == sizeof(uint64_t), "Fixed for 64-bit compiler.");
             return reinterpret_cast<const uint64_t&>(value);
         }
-
-    private:
-        bool moveToNextInMask() {
-            // check if there is something left
-            if (mask == 0) return false;
-
-            // get position of leading 1
-            auto pos = __builtin_ctzll(mask);
-
-            // consume this bit
-            mask &= ~(1llu << pos);
-
-            // update value
-            value &= ~LEAF_INDEX_MASK;
-            value |= pos;
-
-            // done
-            return true;
-        }
     };
 
     /**
@@ -1795,6 +1917,18 @@ public:
         return static_cast<const Derived&>(*this).contains((entry_type){{RamDomain(values)...}});
     }
 
+    /**
+     * Tests a batch of entries for membership, writing one flag per
+     * entry. All probes of the batch share one operation context, so
+     * runs of nearby keys reuse the cached path into the trie.
+     */
+    void containsBatch(const entry_type* entries, std::size_t count, bool* result) const {
+        typename Derived::op_context ctxt;
+        for (std::size_t i = 0; i < count; ++i) {
+            result[i] = static_cast<const Derived&>(*this).contains(entries[i], ctxt);
+        }
+    }
+
     // ---------------------------------------------------------------------
     //                           Iterator
     // ---------------------------------------------------------------------
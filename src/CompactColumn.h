@@ -0,0 +1,152 @@
+/*
+ * Souffle - A Datalog Compiler
+ * Copyright (c) 2019, The Souffle Developers. All rights reserved.
+ * Licensed under the Universal Permissive License v 1.0 as shown at:
+ * - https://opensource.org/licenses/UPL
+ * - <souffle root>/licenses/SOUFFLE-UPL.txt
+ */
+
+/************************************************************************
+ *
+ * @file CompactColumn.h
+ *
+ * A growable column of RamDomain values stored in the narrowest physical
+ * width (8, 16, 32 or 64 bit) that fits the values observed so far. Most
+ * columns of real-world programs hold small ordinals, so storing them at
+ * their observed width cuts the memory bandwidth of scans; values are
+ * widened back to RamDomain only when an operation reads them.
+ *
+ ***********************************************************************/
+
+#pragma once
+
+#include "RamTypes.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <vector>
+
+namespace souffle {
+
+/**
+ * @class CompactColumn
+ * @brief An append-only value column with automatic width selection
+ *
+ * The column starts at a single byte per value and widens itself when an
+ * appended value does not fit, rewriting the stored prefix once; widening
+ * is monotone and happens at most three times over the column's lifetime.
+ */
+class CompactColumn {
+public:
+    /** @brief Number of values stored in this column */
+    std::size_t size() const {
+        switch (widthBytes) {
+            case 1: return narrow8.size();
+            case 2: return narrow16.size();
+            case 4: return narrow32.size();
+            default: return wide64.size();
+        }
+    }
+
+    /** @brief Append a value, widening the column if it does not fit */
+    void push_back(RamDomain value) {
+        const std::size_t required = widthFor(value);
+        if (required > widthBytes) {
+            widen(required);
+        }
+        switch (widthBytes) {
+            case 1: narrow8.push_back(static_cast<int8_t>(value)); break;
+            case 2: narrow16.push_back(static_cast<int16_t>(value)); break;
+            case 4: narrow32.push_back(static_cast<int32_t>(value)); break;
+            default: wide64.push_back(static_cast<int64_t>(value)); break;
+        }
+    }
+
+    /** @brief Read a value, widened back to RamDomain */
+    RamDomain operator[](std::size_t index) const {
+        switch (widthBytes) {
+            case 1: return static_cast<RamDomain>(narrow8[index]);
+            case 2: return static_cast<RamDomain>(narrow16[index]);
+            case 4: return static_cast<RamDomain>(narrow32[index]);
+            default: return static_cast<RamDomain>(wide64[index]);
+        }
+    }
+
+    /** @brief Remove all values, resetting the column to its narrowest width */
+    void clear() {
+        narrow8.clear();
+        narrow8.shrink_to_fit();
+        narrow16.clear();
+        narrow16.shrink_to_fit();
+        narrow32.clear();
+        narrow32.shrink_to_fit();
+        wide64.clear();
+        wide64.shrink_to_fit();
+        widthBytes = 1;
+    }
+
+    /** @brief Number of bytes held by this column, including unused capacity */
+    std::size_t getMemoryUsage() const {
+        return narrow8.capacity() * sizeof(int8_t) + narrow16.capacity() * sizeof(int16_t) +
+               narrow32.capacity() * sizeof(int32_t) + wide64.capacity() * sizeof(int64_t);
+    }
+
+private:
+    /** @brief The narrowest width in bytes capable of holding the given value */
+    static std::size_t widthFor(RamDomain value) {
+        if (value >= std::numeric_limits<int8_t>::min() && value <= std::numeric_limits<int8_t>::max()) {
+            return 1;
+        }
+        if (value >= std::numeric_limits<int16_t>::min() && value <= std::numeric_limits<int16_t>::max()) {
+            return 2;
+        }
+        if (value >= std::numeric_limits<int32_t>::min() && value <= std::numeric_limits<int32_t>::max()) {
+            return 4;
+        }
+        return 8;
+    }
+
+    /** @brief Rewrite the stored values at the given wider width */
+    void widen(std::size_t bytes) {
+        const std::size_t numValues = size();
+        if (bytes == 2) {
+            narrow16.reserve(numValues);
+            for (std::size_t i = 0; i < numValues; i++) {
+                narrow16.push_back(static_cast<int16_t>((*this)[i]));
+            }
+        } else if (bytes == 4) {
+            narrow32.reserve(numValues);
+            for (std::size_t i = 0; i < numValues; i++) {
+                narrow32.push_back(static_cast<int32_t>((*this)[i]));
+            }
+        } else {
+            wide64.reserve(numValues);
+            for (std::size_t i = 0; i < numValues; i++) {
+                wide64.push_back(static_cast<int64_t>((*this)[i]));
+            }
+        }
+        narrow8.clear();
+        narrow8.shrink_to_fit();
+        if (bytes > 2) {
+            narrow16.clear();
+            narrow16.shrink_to_fit();
+        }
+        if (bytes > 4) {
+            narrow32.clear();
+            narrow32.shrink_to_fit();
+        }
+        widthBytes = bytes;
+    }
+
+    /** the values at their current width; only one vector is populated */
+    std::vector<int8_t> narrow8;
+    std::vector<int16_t> narrow16;
+    std::vector<int32_t> narrow32;
+    std::vector<int64_t> wide64;
+
+    /** the current physical width of the column in bytes */
+    std::size_t widthBytes = 1;
+};
+
+}  // end of namespace souffle
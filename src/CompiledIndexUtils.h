@@ -320,6 +320,22 @@ struct concat<index<C1...>, index<C2...>> {
     using type = index<C1..., C2...>;
 };
 
+// -- a utility reversing the column order of an index --
+//   e.g. index<1,0,2>   =>    index<2,0,1>
+
+template <typename I>
+struct reverse;
+
+template <>
+struct reverse<index<>> {
+    using type = index<>;
+};
+
+template <unsigned First, unsigned... Rest>
+struct reverse<index<First, Rest...>> {
+    using type = typename concat<typename reverse<index<Rest...>>::type, index<First>>::type;
+};
+
 // -- obtains a full index for a given arity --
 
 template <unsigned arity>
@@ -650,8 +666,12 @@ public:
         index.clear();
     }
 
+    void recycle() {
+        index.recycle();
+    }
+
     std::vector<range<iterator>> partition() const {
-        return index.getChunks(400);
+        return index.partition(400);
     }
 
     static void printDescription(std::ostream& out) {
@@ -759,6 +779,10 @@ public:
         index.clear();
     }
 
+    void recycle() {
+        index.recycle();
+    }
+
     /**
      * Return a list of iterators, s.t. we can process in parallel.
      * "an approximation of the number of sub-ranges to be included in the resulting partition."
@@ -770,7 +794,7 @@ public:
      */
     std::vector<range<iterator>> partition() const {
         std::vector<range<iterator>> res;
-        for (const auto& cur : index.getChunks(400)) {
+        for (const auto& cur : index.partition(400)) {
             res.push_back(make_range(derefIter(cur.begin()), derefIter(cur.end())));
         }
         return res;
@@ -824,11 +848,28 @@ struct aux_order<Pos> {
     void order_out(tuple_type&, const tuple_type&) const {}
 };
 
+template <unsigned Pos, unsigned... Order>
+struct aux_is_identity;
+
+template <unsigned Pos, unsigned First, unsigned... Rest>
+struct aux_is_identity<Pos, First, Rest...> {
+    enum { value = (Pos == First) && aux_is_identity<Pos + 1, Rest...>::value };
+};
+
+template <unsigned Pos>
+struct aux_is_identity<Pos> {
+    enum { value = 1 };
+};
+
 template <typename Index>
 struct order;
 
 template <unsigned... Columns>
 struct order<index<Columns...>> {
+    // true if the index order equals the tuple order, in which case
+    // order_in and order_out are plain copies
+    enum { is_identity = aux_is_identity<0, Columns...>::value };
+
     template <typename tuple_type>
     void order_in(tuple_type& res, const tuple_type& in) const {
         aux_order<0, Columns...>().order_in(res, in);
@@ -883,6 +924,11 @@ public:
         data.clear();
     }
 
+    void recycle() {
+        // the trie does not support node recycling
+        data.clear();
+    }
+
     // ---------------------------------------------
     //                Iterators
     // ---------------------------------------------
@@ -893,14 +939,18 @@ public:
         // the wrapped iterator
         nested_iterator nested;
 
-        // the value currently pointed to
-        tuple_type value;
+        // the current element re-ordered into tuple order; only materialized
+        // on the first dereference, so pure advances -- e.g. emptiness or
+        // range-size checks over an existence-flavored join -- never pay the
+        // re-ordering copy
+        mutable tuple_type value;
+        mutable bool materialized = false;
 
     public:
         // default constructor -- creating an end-iterator
         iterator() = default;
 
-        iterator(const nested_iterator& iter) : nested(iter), value(orderOut(*iter)) {}
+        iterator(const nested_iterator& iter) : nested(iter) {}
 
         // a copy constructor
         iterator(const iterator& other) = default;
@@ -921,18 +971,27 @@ public:
 
         // the deref operator as required by the iterator concept
         const tuple_type& operator*() const {
+            // an identity order stores the tuple as-is -- bind directly to
+            // the key storage of the underlying structure without copying
+            if (order<Index>::is_identity) {
+                return *nested;
+            }
+            if (!materialized) {
+                value = orderOut(*nested);
+                materialized = true;
+            }
             return value;
         }
 
         // support for the pointer operator
         const tuple_type* operator->() const {
-            return &value;
+            return &**this;
         }
 
         // the increment operator as required by the iterator concept
         iterator& operator++() {
             ++nested;
-            value = orderOut(*nested);
+            materialized = false;
             return *this;
         }
     };
@@ -1066,6 +1125,11 @@ public:
         data.clear();
     }
 
+    void recycle() {
+        // the equivalence relation does not support node recycling
+        data.clear();
+    }
+
     // ---------------------------------------------
     //                Iterators
     // ---------------------------------------------
@@ -1076,15 +1140,17 @@ public:
         // the wrapped iterator
         nested_iterator nested;
 
-        // the value currently pointed to
-        tuple_type value;
+        // the current element re-ordered into tuple order; only materialized
+        // on the first dereference, so pure advances -- e.g. emptiness or
+        // range-size checks -- never pay the re-ordering copy
+        mutable tuple_type value;
+        mutable bool materialized = false;
 
     public:
         // default constructor -- creating an end-iterator
         iterator() = default;
-        ;
 
-        iterator(const nested_iterator& iter) : nested(iter), value(orderOut(*iter)){};
+        iterator(const nested_iterator& iter) : nested(iter){};
 
         // a copy constructor
         iterator(const iterator& other) = default;
@@ -1105,18 +1171,27 @@ public:
 
         // the deref operator as required by the iterator concept
         const tuple_type& operator*() const {
+            // an identity order stores the pair as-is -- bind directly to
+            // the key storage of the underlying structure without copying
+            if (order<Index>::is_identity) {
+                return *nested;
+            }
+            if (!materialized) {
+                value = orderOut(*nested);
+                materialized = true;
+            }
             return value;
         }
 
         // support for the pointer operator
         const tuple_type* operator->() const {
-            return &value;
+            return &**this;
         }
 
         // the increment operator as required by the iterator concept
         iterator& operator++() {
             ++nested;
-            value = orderOut(*nested);
+            materialized = false;
             return *this;
         }
     };
@@ -1151,11 +1226,31 @@ public:
 
     template <typename SubIndex>
     range<iterator> equalRange(const tuple_type& tuple, operation_hints& ctxt) const {
-        static_assert(is_compatible_with<SubIndex, Index>::value, "Invalid sub-index query!");
+        return equalRangeInternal<SubIndex>(tuple, ctxt);
+    }
+
+private:
+    template <typename SubIndex>
+    typename std::enable_if<is_compatible_with<SubIndex, Index>::value, range<iterator>>::type
+    equalRangeInternal(const tuple_type& tuple, operation_hints& ctxt) const {
         auto r = data.template getBoundaries<SubIndex::size>(orderIn(tuple), ctxt);
         return make_range(iterator(r.begin()), iterator(r.end()));
     }
 
+    /**
+     * Covers queries binding only the posterior column of the index order. Those are
+     * answered through the posterior iterator of the equivalence relation, enumerating
+     * the members of the bound element's class instead of filtering the full closure.
+     */
+    template <typename SubIndex>
+    typename std::enable_if<!is_compatible_with<SubIndex, Index>::value, range<iterator>>::type
+    equalRangeInternal(const tuple_type& tuple, operation_hints&) const {
+        static_assert(is_compatible_with<SubIndex, typename reverse<Index>::type>::value,
+                "Invalid sub-index query!");
+        return make_range(iterator(data.posteriorIt(orderIn(tuple)[1])), iterator(data.end()));
+    }
+
+public:
     static void printDescription(std::ostream& out) {
         out << "disjoint-set-index(" << Index() << ")";
     }
@@ -1177,6 +1272,26 @@ private:
         return res;
     }
 };
+
+// -- determines whether a query on a sub-index can be answered directly by a --
+// -- table organized according to a given index --
+
+// by default, the sub-index needs to be compatible with a prefix of the index order
+template <typename SubIndex, typename Index, typename Table>
+struct is_direct_query {
+    enum { value = is_compatible_with<SubIndex, Index>::value };
+};
+
+// a disjoint-set index additionally covers queries binding only the posterior
+// column, exploiting the symmetry of the maintained equivalence relation
+template <typename SubIndex, typename Index, typename TableIndex>
+struct is_direct_query<SubIndex, Index, DisjointSetIndex<TableIndex>> {
+    enum {
+        value = is_compatible_with<SubIndex, Index>::value ||
+                is_compatible_with<SubIndex, typename reverse<Index>::type>::value
+    };
+};
+
 // -------------------------------------------------------------
 
 /* A direct index factory only supporting direct indices */
@@ -1340,6 +1455,11 @@ public:
         nested.clear();
     }
 
+    void recycle() {
+        index.recycle();
+        nested.recycle();
+    }
+
     index_t& getIndex(const First&) {
         return index;
     }
@@ -1436,6 +1556,8 @@ public:
 
     void clear() {}
 
+    void recycle() {}
+
     template <typename I>
     std::vector<range<iterator>> partition(const I&) const {
         assert(false && "No Index to partition!");
@@ -0,0 +1,24 @@
+/*
+ * Souffle - A Datalog Compiler
+ * Copyright (c) 2020, The Souffle Developers. All rights reserved.
+ * Licensed under the Universal Permissive License v 1.0 as shown at:
+ * - https://opensource.org/licenses/UPL
+ * - <souffle root>/licenses/SOUFFLE-UPL.txt
+ */
+
+/************************************************************************
+ *
+ * @file CompiledInstantiations.cpp
+ *
+ * Emits the definitions of the template instantiations shared by all
+ * compiled programs, built once into libsouffleinstantiations.
+ *
+ ***********************************************************************/
+
+#include "CompiledInstantiations.h"
+
+namespace souffle {
+
+SOUFFLE_INSTANTIATE_COMMON()
+
+}  // end of namespace souffle
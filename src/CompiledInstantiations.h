@@ -0,0 +1,71 @@
+/*
+ * Souffle - A Datalog Compiler
+ * Copyright (c) 2020, The Souffle Developers. All rights reserved.
+ * Licensed under the Universal Permissive License v 1.0 as shown at:
+ * - https://opensource.org/licenses/UPL
+ * - <souffle root>/licenses/SOUFFLE-UPL.txt
+ */
+
+/************************************************************************
+ *
+ * @file CompiledInstantiations.h
+ *
+ * Declares the template instantiations shared by all compiled programs.
+ *
+ ***********************************************************************/
+
+#pragma once
+
+#include "souffle/BTree.h"
+#include "souffle/Brie.h"
+#include "souffle/CompiledIndexUtils.h"
+#include "souffle/CompiledTuple.h"
+#include "souffle/RamTypes.h"
+
+#include <memory>
+
+namespace souffle {
+
+/**
+ * The data structures almost every generated program instantiates: tries
+ * and b-trees over tuples of small arity, ordered by the identity index
+ * which serves as the master index of generated relations. Left to the
+ * compiler, these templates are re-instantiated per index per relation
+ * in every program, which dominates compile time and memory on large
+ * programs. When SOUFFLE_SHARED_INSTANTIATIONS is defined, this header
+ * declares them extern and the program links against the definitions
+ * pre-compiled once into libsouffleinstantiations; souffle-compile
+ * enables this automatically when the library is installed. Without the
+ * macro the header is inert, so embedded builds that compile with a
+ * plain C++ compiler remain self-contained.
+ *
+ * The instantiation list is expanded twice: with 'extern' below, and
+ * without by CompiledInstantiations.cpp to emit the definitions.
+ * Explicitly instantiating btree_set alone would not cover its btree
+ * base class, which holds the actual implementation, so the base is
+ * listed with its default parameters spelled out.
+ */
+#define SOUFFLE_INSTANTIATE_ARITY(prefix, Arity, ...)                                                        \
+    prefix template class btree_set<ram::Tuple<RamDomain, Arity>,                                            \
+            ram::index_utils::comparator<__VA_ARGS__>>;                                                      \
+    prefix template class detail::btree<ram::Tuple<RamDomain, Arity>,                                        \
+            ram::index_utils::comparator<__VA_ARGS__>, std::allocator<ram::Tuple<RamDomain, Arity>>, 256,    \
+            detail::default_strategy<ram::Tuple<RamDomain, Arity>>::type, true,                              \
+            ram::index_utils::comparator<__VA_ARGS__>, detail::updater<ram::Tuple<RamDomain, Arity>>>;       \
+    prefix template class Trie<Arity>;
+
+#define SOUFFLE_INSTANTIATE_COMMON(prefix)                          \
+    SOUFFLE_INSTANTIATE_ARITY(prefix, 1, 0)                         \
+    SOUFFLE_INSTANTIATE_ARITY(prefix, 2, 0, 1)                      \
+    SOUFFLE_INSTANTIATE_ARITY(prefix, 3, 0, 1, 2)                   \
+    SOUFFLE_INSTANTIATE_ARITY(prefix, 4, 0, 1, 2, 3)                \
+    SOUFFLE_INSTANTIATE_ARITY(prefix, 5, 0, 1, 2, 3, 4)             \
+    SOUFFLE_INSTANTIATE_ARITY(prefix, 6, 0, 1, 2, 3, 4, 5)          \
+    SOUFFLE_INSTANTIATE_ARITY(prefix, 7, 0, 1, 2, 3, 4, 5, 6)       \
+    SOUFFLE_INSTANTIATE_ARITY(prefix, 8, 0, 1, 2, 3, 4, 5, 6, 7)
+
+#ifdef SOUFFLE_SHARED_INSTANTIATIONS
+SOUFFLE_INSTANTIATE_COMMON(extern)
+#endif
+
+}  // end of namespace souffle
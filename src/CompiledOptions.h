@@ -17,6 +17,7 @@
 
 #pragma once
 
+#include "Global.h"
 #include "Util.h"
 
 #include <iostream>
@@ -73,6 +74,11 @@ protected:
      */
     size_t stratumIndex;
 
+    /**
+     * symbol table snapshot filename; empty if snapshotting is disabled
+     */
+    std::string symtab_name;
+
 public:
     // all argument constructor
     CmdOptions(const char* s, const char* id, const char* od, bool pe, const char* pfn, size_t nj,
@@ -129,6 +135,13 @@ public:
         return stratumIndex;
     }
 
+    /**
+     * get filename of the symbol table snapshot
+     */
+    const std::string& getSymbolTableName() const {
+        return symtab_name;
+    }
+
     /**
      * Parses the given command line parameters, handles -h help requests or errors
      * and returns whether the parsing was successful or not.
@@ -150,6 +163,7 @@ public:
         // long options
         option longOptions[] = {{"facts", true, nullptr, 'F'}, {"output", true, nullptr, 'D'},
                 {"profile", true, nullptr, 'p'}, {"jobs", true, nullptr, 'j'}, {"index", true, nullptr, 'i'},
+                {"symbol-table", true, nullptr, 's'}, {"config", true, nullptr, 'c'},
                 // the terminal option -- needs to be null
                 {nullptr, false, nullptr, 0}};
 #pragma GCC diagnostic pop
@@ -157,8 +171,12 @@ public:
         // check whether all options are fine
         bool ok = true;
 
+        // whether -j was given explicitly; command-line flags take
+        // precedence over options-file overrides
+        bool jobsGiven = false;
+
         int c; /* command-line arguments processing */
-        while ((c = getopt_long(argc, argv, "D:F:hp:j:i:", longOptions, nullptr)) != EOF) {
+        while ((c = getopt_long(argc, argv, "D:F:hp:j:i:s:c:", longOptions, nullptr)) != EOF) {
             switch (c) {
                 /* Fact directories */
                 case 'F':
@@ -185,6 +203,7 @@ public:
                     profile_name = optarg;
                     break;
                 case 'j':
+                    jobsGiven = true;
 #ifdef _OPENMP
                     if (std::string(optarg) == "auto") {
                         num_jobs = 0;
@@ -201,9 +220,21 @@ public:
                     std::cerr << "\nWarning: OpenMP was not enabled in compilation\n\n";
 #endif
                     break;
+                case 'c':
+                    if (!existFile(optarg)) {
+                        printf("Options file %s does not exists!\n", optarg);
+                        ok = false;
+                    } else if (!Global::config().loadOverrides(optarg)) {
+                        printf("Options file %s could not be read!\n", optarg);
+                        ok = false;
+                    }
+                    break;
                 case 'i':
                     stratumIndex = (size_t)std::stoull(optarg);
                     break;
+                case 's':
+                    symtab_name = optarg;
+                    break;
                 default:
                     printHelpPage(exec_name);
                     return false;
@@ -214,6 +245,27 @@ public:
         input_dir = fact_dir;
         output_dir = out_dir;
 
+#ifdef _OPENMP
+        // apply a thread-count override from the options file unless -j
+        // was given on the command line
+        if (!jobsGiven && Global::config().has("jobs")) {
+            const std::string& jobs = Global::config().get("jobs");
+            if (jobs == "auto") {
+                num_jobs = 0;
+            } else {
+                int num = atoi(jobs.c_str());
+                if (num > 0) {
+                    num_jobs = num;
+                } else {
+                    std::cerr << "Invalid number of jobs in options file: " << jobs << "\n";
+                    ok = false;
+                }
+            }
+        }
+#else
+        (void)jobsGiven;
+#endif
+
         // return success state
         return ok;
     }
@@ -246,6 +298,13 @@ private:
 #endif
         std::cerr << "    -i <N>, --index=<N>          -- Specify index of stratum to be executed\n";
         std::cerr << "                                    (or each in order if omitted)\n";
+        std::cerr << "    -s <file>, --symbol-table=<file> -- Restore the symbol table from the given\n";
+        std::cerr << "                                    snapshot before loading facts, and dump it\n";
+        std::cerr << "                                    there after the run\n";
+        std::cerr << "    -c <file>, --config=<file>   -- Read runtime tuning overrides from the given\n";
+        std::cerr << "                                    options file (key=value per line); recognized\n";
+        std::cerr << "                                    keys include jobs, jobs-stratum-<N> and\n";
+        std::cerr << "                                    no-bloom-filters\n";
         std::cerr << "    -h                           -- prints this help page.\n";
         std::cerr << "--------------------------------------------------------------------\n";
         std::cerr << " Copyright (c) 2016 Oracle and/or its affiliates.\n";
@@ -20,10 +20,12 @@
 #include "ParallelUtils.h"
 #include "Util.h"
 
+#include <array>
+#include <atomic>
+#include <cassert>
+#include <cstdint>
 #include <limits>
-#include <memory>
 #include <unordered_map>
-#include <vector>
 
 namespace souffle {
 
@@ -72,71 +74,123 @@ bool isNull(RamDomain ref) {
 
 namespace detail {
 
+/**
+ * The key type stored in the tuple-to-reference map.
+ *
+ * Records are the idiom for composite keys, and the common case is a
+ * pair of domain values. With the default 32-bit domain such a pair
+ * collapses losslessly into a single 64-bit word, so probing the map
+ * hashes and compares one machine word instead of walking the tuple.
+ */
+template <typename Tuple>
+struct RecordKey {
+    using type = Tuple;
+    static const type& make(const Tuple& tuple) {
+        return tuple;
+    }
+};
+
+#if RAM_DOMAIN_SIZE == 32
+template <>
+struct RecordKey<ram::Tuple<RamDomain, 2>> {
+    using type = uint64_t;
+    static type make(const ram::Tuple<RamDomain, 2>& tuple) {
+        return (static_cast<uint64_t>(static_cast<uint32_t>(tuple[0])) << 32) |
+               static_cast<uint32_t>(tuple[1]);
+    }
+};
+#endif
+
 /**
  * A bidirectional mapping between tuples and reference indices.
+ *
+ * References are resolved without any locking from an arena of tuple
+ * blocks published through atomic pointers, while packing only contends
+ * on one of the hash-selected stripes guarding the tuple-to-reference
+ * map, so concurrently executed rules packing records scale with the
+ * number of threads.
  */
 template <typename Tuple>
 class RecordMap {
     // create blocks of a million entries
     static const std::size_t BLOCK_SIZE = 1 << 20;
 
+    /** The number of blocks maintained, covering up to 2^32 references */
+    static constexpr std::size_t MAX_BLOCKS = (static_cast<std::size_t>(1) << 32) / BLOCK_SIZE;
+
+    /** The number of stripes of the tuple-to-reference map (a power of 2) */
+    static constexpr std::size_t STRIPE_COUNT = 64;
+
     /** The definition of the tuple type handled by this instance */
     using tuple_type = Tuple;
 
     /** The definition of the type of a tuple block */
     using block_type = std::array<tuple_type, BLOCK_SIZE>;
 
-    /** The type utilized for the block index */
-    using block_index_type = std::vector<std::unique_ptr<block_type>>;
+    /** The key type of the tuple-to-reference map (see RecordKey) */
+    using key_type = typename RecordKey<tuple_type>::type;
+
+    /** A stripe covering a hash-selected subset of the stored tuples */
+    struct Stripe {
+        /** a lock for sequentializing updates of this stripe */
+        Lock access;
+
+        /** The mapping from tuples to references/indices */
+        std::unordered_map<key_type, RamDomain> r2i;
+    };
 
-    /** The mapping from tuples to references/indices */
-    std::unordered_map<tuple_type, RamDomain> r2i;
+    /** The striped mapping from tuples to references/indices */
+    std::array<Stripe, STRIPE_COUNT> stripes;
 
     /** The mapping from indices to tuples */
-    block_index_type i2r;
+    std::array<std::atomic<block_type*>, MAX_BLOCKS> i2r{};
 
-    /** a lock for the pack operation */
-    Lock pack_lock;
+    /** a lock for sequentializing the allocation of tuple blocks */
+    Lock alloc;
+
+    /** The next free reference; index 0 is skipped for the Nil element */
+    std::atomic<RamDomain> counter{1};
 
 public:
     RecordMap() = default;
 
+    ~RecordMap() {
+        for (auto& block : i2r) {
+            delete block.load(std::memory_order_relaxed);
+        }
+    }
+
     /**
      * Packs the given tuple -- and may create a new reference if necessary.
      */
     RamDomain pack(const tuple_type& tuple) {
-        RamDomain index;
-
-        {
-            // lock pack operation
-            auto leas = pack_lock.acquire();  // lock hold till end of scope
-            (void)leas;                       // avoid warning
-
-            // try lookup
-            auto pos = r2i.find(tuple);
-            if (pos != r2i.end()) {
-                // take the previously assigned value
-                index = pos->second;
-            } else {
-                // add tuple to index
-                index = r2i.size() + 1;  // since 0 is skipped for the Nil element
-                r2i[tuple] = index;
-
-                // assert that new index is smaller than the range
-                assert(index != std::numeric_limits<RamDomain>::max());
-
-                if (index / BLOCK_SIZE == i2r.size()) {
-                    i2r.push_back(std::make_unique<block_type>());
-                }
-
-                // create entry for unpacking
-                auto& list = i2r[index / BLOCK_SIZE];
-
-                // insert tuple
-                (*list)[index % BLOCK_SIZE] = tuple;
-            }
+        const auto& key = RecordKey<tuple_type>::make(tuple);
+
+        // only the stripe covering this tuple needs to be locked
+        auto& stripe = stripes[std::hash<key_type>()(key) & (STRIPE_COUNT - 1)];
+        auto leas = stripe.access.acquire();  // lock hold till end of scope
+        (void)leas;                           // avoid warning
+
+        // try lookup
+        auto pos = stripe.r2i.find(key);
+        if (pos != stripe.r2i.end()) {
+            // take the previously assigned value
+            return pos->second;
         }
 
+        // claim the next free reference
+        RamDomain index = counter.fetch_add(1);
+
+        // assert that new index is smaller than the range
+        assert(index != std::numeric_limits<RamDomain>::max());
+        assert(static_cast<std::size_t>(index) / BLOCK_SIZE < MAX_BLOCKS && "record arena exhausted");
+
+        // create entry for unpacking
+        (*getBlock(index / BLOCK_SIZE))[index % BLOCK_SIZE] = tuple;
+
+        // add tuple to index
+        stripe.r2i[key] = index;
+
         // done
         return index;
     }
@@ -145,8 +199,27 @@ public:
      * Obtains a pointer to the tuple addressed by the given index.
      */
     const tuple_type& unpack(RamDomain index) {
-        // just look up the right spot
-        return (*(i2r[index / BLOCK_SIZE]))[index % BLOCK_SIZE];
+        // just look up the right spot -- no synchronization required
+        return (*i2r[index / BLOCK_SIZE].load(std::memory_order_acquire))[index % BLOCK_SIZE];
+    }
+
+private:
+    /**
+     * Obtains the tuple block of the given index, allocating it on
+     * first access.
+     */
+    block_type* getBlock(std::size_t blockIndex) {
+        block_type* block = i2r[blockIndex].load(std::memory_order_acquire);
+        if (block == nullptr) {
+            auto leas = alloc.acquire();  // lock hold till end of scope
+            (void)leas;                   // avoid warning
+            block = i2r[blockIndex].load(std::memory_order_relaxed);
+            if (block == nullptr) {
+                block = new block_type();
+                i2r[blockIndex].store(block, std::memory_order_release);
+            }
+        }
+        return block;
     }
 };
 
@@ -453,6 +453,12 @@ public:
         indices.clear();
     }
 
+    /* as purge(), but keeps index node memory for re-filling the relation */
+    void recycle() {
+        data.clear();
+        indices.recycle();
+    }
+
     auto partition() -> decltype(indices.partition(primary_index())) {
         return indices.partition(primary_index());
     }
@@ -604,6 +610,11 @@ public:
         indices.clear();
     }
 
+    /* as purge(), but keeps index node memory for re-filling the relation */
+    void recycle() {
+        indices.recycle();
+    }
+
     auto partition() -> decltype(indices.partition(primary_index())) {
         return indices.partition(primary_index());
     }
@@ -799,6 +810,10 @@ public:
         present = false;
     }
 
+    void recycle() {
+        present = false;
+    }
+
     std::vector<range<iterator>> partition() const {
         return toVector(make_range(begin(), end()));
     }
@@ -904,13 +919,13 @@ public:
 
 private:
     template <typename I>
-    typename std::enable_if<index_utils::is_compatible_with<I, Index>::value, range<iterator>>::type
+    typename std::enable_if<index_utils::is_direct_query<I, Index, table_t>::value, range<iterator>>::type
     equalRangeInternal(const tuple_type& value, operation_context& ctxt) const {
         return data.template equalRange<I>(value, ctxt);
     }
 
     template <typename I>
-    typename std::enable_if<!index_utils::is_compatible_with<I, Index>::value,
+    typename std::enable_if<!index_utils::is_direct_query<I, Index, table_t>::value,
             range<iterator_utils::filter_iterator<iterator, I>>>::type
     equalRangeInternal(const tuple_type& value, operation_context&) const {
         return make_range(iterator_utils::filter_iterator<iterator, I>(begin(), end(), value),
@@ -955,6 +970,11 @@ public:
         data.clear();
     }
 
+    /* as purge(), but keeps index node memory for re-filling the relation */
+    void recycle() {
+        data.recycle();
+    }
+
     std::vector<range<iterator>> partition() const {
         return data.partition();
     }
@@ -1273,6 +1293,11 @@ public:
         indices.clear();
     }
 
+    void recycle() {
+        // the hash-based structures do not support node recycling
+        indices.clear();
+    }
+
     std::vector<range<iterator>> partition() const {
         range<iterator> full(begin(), end());
         return full.partition(100);
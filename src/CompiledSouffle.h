@@ -16,19 +16,25 @@
 
 #pragma once
 
+#include "souffle/BloomFilter.h"
 #include "souffle/Brie.h"
+#include "souffle/CompactColumn.h"
 #include "souffle/CompiledIndexUtils.h"
+#include "souffle/CompiledInstantiations.h"
 #include "souffle/CompiledOptions.h"
 #include "souffle/CompiledRecord.h"
 #include "souffle/CompiledRelation.h"
 #include "souffle/CompiledTuple.h"
 #include "souffle/IODirectives.h"
 #include "souffle/IOSystem.h"
+#include "souffle/JoinHashTable.h"
 #include "souffle/Logger.h"
+#include "souffle/OffloadSnapshot.h"
 #include "souffle/ParallelUtils.h"
 #include "souffle/ProfileEvent.h"
 #include "souffle/RamTypes.h"
 #include "souffle/SignalHandler.h"
+#include "souffle/SouffleCInterface.h"
 #include "souffle/SouffleInterface.h"
 #include "souffle/SymbolTable.h"
 #include "souffle/Util.h"
@@ -37,6 +43,7 @@
 #include "souffle/Mpi.h"
 #endif
 
+#include <algorithm>
 #include <array>
 #include <atomic>
 #include <cassert>
@@ -55,6 +62,22 @@
 #include <omp.h>
 #endif
 
+/**
+ * Function attributes used to split the generated code into hot and cold
+ * parts. Each rule body is outlined into its own function carrying the
+ * hot attribute, keeping its loops tight and out of the megabyte-scale
+ * run function; one-off work such as I/O and profiling is outlined with
+ * the cold attribute so it does not dilute the instruction cache of the
+ * evaluation loops.
+ */
+#ifdef __GNUC__
+#define SOUFFLE_RULE_ATTRIBUTES __attribute__((noinline, hot))
+#define SOUFFLE_COLD_ATTRIBUTES __attribute__((noinline, cold))
+#else
+#define SOUFFLE_RULE_ATTRIBUTES
+#define SOUFFLE_COLD_ATTRIBUTES
+#endif
+
 namespace souffle {
 
 extern "C" {
@@ -123,6 +146,32 @@ public:
         }
         relation.insert(t);
     }
+    void insert(const RamDomain* data, std::size_t numTuples) override {
+        // insert the whole buffer through a single operation context,
+        // bypassing the per-tuple dispatch of the generic interface
+        auto ctxt = relation.createContext();
+        TupleType t;
+        for (std::size_t i = 0; i < numTuples; i++, data += Arity) {
+            for (size_t j = 0; j < Arity; j++) {
+                t[j] = data[j];
+            }
+            relation.insert(t, ctxt);
+        }
+    }
+    std::size_t extract(RamDomain* const* columns) const override {
+        // scan the underlying data structure directly, bypassing the
+        // per-field dispatch of the generic iterators
+        std::size_t row = 0;
+        for (const auto& t : relation) {
+            for (size_t j = 0; j < Arity; j++) {
+                if (columns[j] != nullptr) {
+                    columns[j][row] = t[j];
+                }
+            }
+            ++row;
+        }
+        return row;
+    }
     bool contains(const tuple& arg) const override {
         TupleType t;
         assert(arg.size() == Arity && "wrong tuple arity");
@@ -196,19 +245,19 @@ public:
         }
     };
     iterator begin() const {
-        return iterator(data);
+        return iterator(data.load(std::memory_order_acquire));
     }
     iterator end() const {
         return iterator();
     }
     void insert(const t_tuple& t) {
-        data = true;
+        insert();
     }
     void insert(const t_tuple& t, context& /* ctxt */) {
-        data = true;
+        insert();
     }
     void insert(const RamDomain* ramDomain) {
-        data = true;
+        insert();
     }
     template <typename T>
     void insertAll(T& other) {
@@ -217,24 +266,32 @@ public:
         }
     }
     bool insert() {
-        bool result = data;
-        data = true;
-        return !result;
+        // nullary guard relations are checked far more often than they are
+        // set; an acquire/release flag keeps both sides a plain load/store
+        // on common architectures, and the exchange decides the first
+        // inserter under concurrent evaluation
+        if (data.load(std::memory_order_acquire)) {
+            return false;
+        }
+        return !data.exchange(true, std::memory_order_acq_rel);
     }
     bool contains(const t_tuple& t) const {
-        return data;
+        return data.load(std::memory_order_acquire);
     }
     bool contains(const t_tuple& t, context& /* ctxt */) const {
-        return data;
+        return data.load(std::memory_order_acquire);
     }
     std::size_t size() const {
-        return data ? 1 : 0;
+        return data.load(std::memory_order_acquire) ? 1 : 0;
+    }
+    std::size_t getMemoryUsage() const {
+        return sizeof(*this);
     }
     bool empty() const {
-        return !data;
+        return !data.load(std::memory_order_acquire);
     }
     void purge() {
-        data = false;
+        data.store(false, std::memory_order_release);
     }
     void printHintStatistics(std::ostream& o, std::string prefix) const {}
 };
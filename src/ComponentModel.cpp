@@ -171,6 +171,47 @@ struct ComponentContent {
     }
 };
 
+/**
+ * The memoized pre-renaming body of an instantiated component. Instantiating
+ * the same component with the same actual type parameters derives identical
+ * content up to the instance name prefix, so repeated instantiations can
+ * stamp out clones of an earlier body instead of re-walking the component
+ * hierarchy and re-checking the same clause sets.
+ */
+struct InstantiationBody {
+    ComponentContent content;
+    std::vector<std::unique_ptr<AstClause>> orphans;
+};
+
+/** A cache of instantiated component bodies indexed by the component type with its actual parameters. */
+using InstantiationCache = std::map<std::string, InstantiationBody>;
+
+/**
+ * Deep-copies instantiated component content and the orphan clauses it
+ * produced into the given targets.
+ */
+void cloneInto(const ComponentContent& content, const std::vector<std::unique_ptr<AstClause>>& orphans,
+        ComponentContent& contentOut, std::vector<std::unique_ptr<AstClause>>& orphansOut) {
+    for (const auto& cur : content.types) {
+        contentOut.types.emplace_back(cur->clone());
+    }
+    for (const auto& cur : content.relations) {
+        contentOut.relations.emplace_back(cur->clone());
+    }
+    for (const auto& cur : content.loads) {
+        contentOut.loads.emplace_back(cur->clone());
+    }
+    for (const auto& cur : content.printSizes) {
+        contentOut.printSizes.emplace_back(cur->clone());
+    }
+    for (const auto& cur : content.stores) {
+        contentOut.stores.emplace_back(cur->clone());
+    }
+    for (const auto& cur : orphans) {
+        orphansOut.emplace_back(cur->clone());
+    }
+}
+
 /**
  * Recursively computes the set of relations (and included clauses) introduced
  * by this init statement enclosed within the given scope.
@@ -178,7 +219,8 @@ struct ComponentContent {
 ComponentContent getInstantiatedContent(const AstComponentInit& componentInit,
         const AstComponent* enclosingComponent, const ComponentLookup& componentLookup,
         std::vector<std::unique_ptr<AstClause>>& orphans, ErrorReport& report,
-        const TypeBinding& binding = TypeBinding(), unsigned int maxDepth = MAX_INSTANTIATION_DEPTH);
+        const TypeBinding& binding = TypeBinding(), unsigned int maxDepth = MAX_INSTANTIATION_DEPTH,
+        InstantiationCache* cache = nullptr);
 
 /**
  * Collects clones of all the content in the given component and its base components.
@@ -335,7 +377,7 @@ void collectContent(const AstComponent& component, const TypeBinding& binding,
 ComponentContent getInstantiatedContent(const AstComponentInit& componentInit,
         const AstComponent* enclosingComponent, const ComponentLookup& componentLookup,
         std::vector<std::unique_ptr<AstClause>>& orphans, ErrorReport& report, const TypeBinding& binding,
-        unsigned int maxDepth) {
+        unsigned int maxDepth, InstantiationCache* cache) {
     // start with an empty list
     ComponentContent res;
 
@@ -357,39 +399,66 @@ ComponentContent getInstantiatedContent(const AstComponentInit& componentInit,
     const auto& actualParams = componentInit.getComponentType()->getTypeParameters();
     TypeBinding activeBinding = binding.extend(formalParams, actualParams);
 
-    // instantiated nested components
-    for (const auto& cur : component->getInstantiations()) {
-        // get nested content
-        ComponentContent nestedContent = getInstantiatedContent(
-                *cur, component, componentLookup, orphans, report, activeBinding, maxDepth - 1);
-
-        // add types
-        for (auto& type : nestedContent.types) {
-            res.add(type, report);
+    // check whether the body of this component, with these actual type
+    // parameters, has already been instantiated; outside any enclosing
+    // binding the derived content is identical up to the instance name, so
+    // a memoized body can be stamped out instead of being re-derived
+    std::string cacheKey;
+    bool reused = false;
+    if (cache != nullptr && orphans.empty()) {
+        cacheKey = toString(*componentInit.getComponentType());
+        auto memo = cache->find(cacheKey);
+        if (memo != cache->end()) {
+            cloneInto(memo->second.content, memo->second.orphans, res, orphans);
+            reused = true;
         }
+    }
 
-        // add relations
-        for (auto& rel : nestedContent.relations) {
-            res.add(rel, report);
-        }
+    if (!reused) {
+        const size_t issuesBefore = report.getNumIssues();
 
-        // add IO directives
-        for (auto& io : nestedContent.loads) {
-            res.add(io, report);
-        }
-        for (auto& io : nestedContent.printSizes) {
-            res.add(io, report);
+        // instantiated nested components
+        for (const auto& cur : component->getInstantiations()) {
+            // get nested content
+            ComponentContent nestedContent = getInstantiatedContent(
+                    *cur, component, componentLookup, orphans, report, activeBinding, maxDepth - 1);
+
+            // add types
+            for (auto& type : nestedContent.types) {
+                res.add(type, report);
+            }
+
+            // add relations
+            for (auto& rel : nestedContent.relations) {
+                res.add(rel, report);
+            }
+
+            // add IO directives
+            for (auto& io : nestedContent.loads) {
+                res.add(io, report);
+            }
+            for (auto& io : nestedContent.printSizes) {
+                res.add(io, report);
+            }
+            for (auto& io : nestedContent.stores) {
+                res.add(io, report);
+            }
         }
-        for (auto& io : nestedContent.stores) {
-            res.add(io, report);
+
+        // collect all content in this component
+        std::set<std::string> overridden;
+        collectContent(*component, activeBinding, enclosingComponent, componentLookup, res, orphans,
+                overridden, report, maxDepth);
+
+        // memoize the pre-renaming body; instantiations that reported issues
+        // stay uncached so every later instantiation reproduces them
+        if (!cacheKey.empty() && report.getNumIssues() == issuesBefore) {
+            InstantiationBody body;
+            cloneInto(res, orphans, body.content, body.orphans);
+            (*cache)[cacheKey] = std::move(body);
         }
     }
 
-    // collect all content in this component
-    std::set<std::string> overridden;
-    collectContent(*component, activeBinding, enclosingComponent, componentLookup, res, orphans, overridden,
-            report, maxDepth);
-
     // update type names
     std::map<AstTypeIdentifier, AstTypeIdentifier> typeNameMapping;
     for (const auto& cur : res.types) {
@@ -517,11 +586,17 @@ bool ComponentInstantiationTransformer::transform(AstTranslationUnit& translatio
 
     auto* componentLookup = translationUnit.getAnalysis<ComponentLookup>();
 
+    // memoized bodies of components already instantiated with the same
+    // actual type parameters
+    InstantiationCache instantiationCache;
+
     for (const auto& cur : program.instantiations) {
         std::vector<std::unique_ptr<AstClause>> orphans;
 
-        ComponentContent content = getInstantiatedContent(
-                *cur, nullptr, *componentLookup, orphans, translationUnit.getErrorReport());
+        ComponentContent content =
+                getInstantiatedContent(*cur, nullptr, *componentLookup, orphans,
+                        translationUnit.getErrorReport(), TypeBinding(), MAX_INSTANTIATION_DEPTH,
+                        &instantiationCache);
         for (auto& type : content.types) {
             program.types.insert(std::make_pair(type->getName(), std::move(type)));
         }
@@ -0,0 +1,278 @@
+/*
+ * Souffle - A Datalog Compiler
+ * Copyright (c) 2019, The Souffle Developers. All rights reserved.
+ * Licensed under the Universal Permissive License v 1.0 as shown at:
+ * - https://opensource.org/licenses/UPL
+ * - <souffle root>/licenses/SOUFFLE-UPL.txt
+ */
+
+/************************************************************************
+ *
+ * @file DeadColumnEliminationTransformer.cpp
+ *
+ * Define classes and functionality related to dead-column elimination,
+ * i.e. removing relation columns whose values are never observed by any
+ * rule body and are not part of any visible output.
+ *
+ ***********************************************************************/
+
+#include "AstArgument.h"
+#include "AstClause.h"
+#include "AstIO.h"
+#include "AstIOTypeAnalysis.h"
+#include "AstLiteral.h"
+#include "AstNode.h"
+#include "AstProgram.h"
+#include "AstRelation.h"
+#include "AstRelationIdentifier.h"
+#include "AstTransforms.h"
+#include "AstTranslationUnit.h"
+#include "AstVisitor.h"
+#include "Global.h"
+#include "RelationRepresentation.h"
+#include <algorithm>
+#include <cstddef>
+#include <map>
+#include <memory>
+#include <set>
+#include <sstream>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace souffle {
+
+/**
+ * Determine whether a column of the given relation may be dropped without
+ * affecting the visible semantics of the program. A body occurrence keeps a
+ * column alive unless its argument is anonymous or a variable used nowhere
+ * else in the clause; a head occurrence keeps it alive unless its value is a
+ * direct term that can simply be omitted.
+ */
+static void markLiveColumns(const AstClause* clause,
+        std::map<AstRelationIdentifier, std::vector<bool>>& liveColumns) {
+    // count variable occurrences across the whole clause
+    std::map<std::string, size_t> varOccurrences;
+    visitDepthFirst(*clause, [&](const AstVariable& var) { varOccurrences[var.getName()]++; });
+
+    visitDepthFirst(*clause, [&](const AstAtom& atom) {
+        auto pos = liveColumns.find(atom.getName());
+        if (pos == liveColumns.end()) {
+            return;
+        }
+        std::vector<bool>& columns = pos->second;
+        if (atom.getArity() != columns.size()) {
+            // unexpected arity mismatch - keep the relation untouched
+            std::fill(columns.begin(), columns.end(), true);
+            return;
+        }
+
+        if (&atom == clause->getHead()) {
+            // head occurrence: the column can be dropped if its value is a
+            // direct term whose computation can simply be omitted
+            for (size_t i = 0; i < atom.getArity(); i++) {
+                const AstArgument* arg = atom.getArgument(i);
+                if (dynamic_cast<const AstUnnamedVariable*>(arg) != nullptr ||
+                        dynamic_cast<const AstVariable*>(arg) != nullptr ||
+                        dynamic_cast<const AstConstant*>(arg) != nullptr) {
+                    continue;
+                }
+                columns[i] = true;
+            }
+        } else {
+            // body occurrence: the column is dead only if the rule never
+            // looks at its value
+            for (size_t i = 0; i < atom.getArity(); i++) {
+                const AstArgument* arg = atom.getArgument(i);
+                if (dynamic_cast<const AstUnnamedVariable*>(arg) != nullptr) {
+                    continue;
+                }
+                if (const auto* var = dynamic_cast<const AstVariable*>(arg)) {
+                    if (varOccurrences[var->getName()] == 1) {
+                        continue;
+                    }
+                }
+                columns[i] = true;
+            }
+        }
+    });
+}
+
+/**
+ * Rewrite the load directives of a narrowed relation so that dropped columns
+ * are projected away by the reader and never parsed, reusing the existing
+ * "columns" facility of the CSV read stream.
+ */
+static void projectLoadDirectives(AstRelation* rel, const std::vector<bool>& keptColumns) {
+    for (AstLoad* load : rel->getLoads()) {
+        // recover the current attribute-to-file-column mapping
+        std::vector<std::string> fileColumns;
+        const auto& directives = load->getIODirectiveMap();
+        auto pos = directives.find("columns");
+        if (pos != directives.end()) {
+            std::istringstream iss(pos->second);
+            std::string column;
+            while (std::getline(iss, column, ':')) {
+                fileColumns.push_back(column);
+            }
+        } else {
+            for (size_t i = 0; i < keptColumns.size(); i++) {
+                fileColumns.push_back(std::to_string(i));
+            }
+        }
+
+        // restrict the mapping to the surviving attributes
+        std::stringstream projected;
+        bool first = true;
+        for (size_t i = 0; i < keptColumns.size() && i < fileColumns.size(); i++) {
+            if (!keptColumns[i]) {
+                continue;
+            }
+            if (!first) {
+                projected << ":";
+            }
+            projected << fileColumns[i];
+            first = false;
+        }
+        load->addKVP("columns", projected.str());
+    }
+}
+
+bool DeadColumnEliminationTransformer::transform(AstTranslationUnit& translationUnit) {
+    // provenance instrumentation relies on the original tuple layout
+    if (Global::config().has("provenance")) {
+        return false;
+    }
+
+    AstProgram& program = *translationUnit.getProgram();
+    auto* ioTypes = translationUnit.getAnalysis<IOType>();
+
+    // relations read by an aggregate must keep their full width, as
+    // projection may merge duplicate tuples and change the aggregate value
+    std::set<AstRelationIdentifier> usedInAggregate;
+    visitDepthFirst(program, [&](const AstAggregator& aggregator) {
+        visitDepthFirst(aggregator, [&](const AstAtom& atom) { usedInAggregate.insert(atom.getName()); });
+    });
+
+    // collect all clauses of the program
+    std::vector<AstClause*> clauses;
+    for (AstRelation* rel : program.getRelations()) {
+        for (AstClause* clause : rel->getClauses()) {
+            clauses.push_back(clause);
+        }
+    }
+    for (AstClause* clause : program.getOrphanClauses()) {
+        clauses.push_back(clause);
+    }
+
+    // set up a liveness vector for every relation that may be narrowed
+    std::map<AstRelationIdentifier, std::vector<bool>> liveColumns;
+    for (AstRelation* rel : program.getRelations()) {
+        if (rel->getArity() == 0 || rel->isInline() || rel->isOverridable()) {
+            continue;
+        }
+        auto representation = rel->getRepresentation();
+        if (representation != RelationRepresentation::DEFAULT &&
+                representation != RelationRepresentation::BTREE) {
+            continue;
+        }
+        // outputs and printsize targets expose tuples or their count
+        if (ioTypes->isOutput(rel) || ioTypes->isPrintSize(rel)) {
+            continue;
+        }
+        if (usedInAggregate.find(rel->getName()) != usedInAggregate.end()) {
+            continue;
+        }
+        // load-side projection is only available in the CSV reader
+        bool projectableLoads = true;
+        for (const AstLoad* load : rel->getLoads()) {
+            const auto& directives = load->getIODirectiveMap();
+            auto pos = directives.find("IO");
+            if (pos != directives.end() && pos->second != "file" && pos->second != "stdin") {
+                projectableLoads = false;
+            }
+        }
+        if (!projectableLoads) {
+            continue;
+        }
+        liveColumns[rel->getName()] = std::vector<bool>(rel->getArity(), false);
+    }
+    if (liveColumns.empty()) {
+        return false;
+    }
+
+    // compute column liveness across all clauses
+    for (const AstClause* clause : clauses) {
+        markLiveColumns(clause, liveColumns);
+    }
+
+    // keep the live columns of each relation that actually shrinks
+    std::map<AstRelationIdentifier, std::vector<bool>> keptColumns;
+    for (auto& entry : liveColumns) {
+        std::vector<bool>& columns = entry.second;
+        size_t numLive = std::count(columns.begin(), columns.end(), true);
+        if (numLive == columns.size()) {
+            continue;
+        }
+        if (numLive == 0) {
+            // retain a single column to avoid introducing nullary relations
+            columns[0] = true;
+        }
+        keptColumns[entry.first] = columns;
+    }
+    if (keptColumns.empty()) {
+        return false;
+    }
+
+    // node mapper replacing atoms of narrowed relations by their projection
+    struct ColumnRemover : public AstNodeMapper {
+        const std::map<AstRelationIdentifier, std::vector<bool>>& keptColumns;
+
+        ColumnRemover(const std::map<AstRelationIdentifier, std::vector<bool>>& keptColumns)
+                : keptColumns(keptColumns) {}
+
+        std::unique_ptr<AstNode> operator()(std::unique_ptr<AstNode> node) const override {
+            node->apply(*this);
+            if (auto* atom = dynamic_cast<AstAtom*>(node.get())) {
+                auto pos = keptColumns.find(atom->getName());
+                if (pos != keptColumns.end() && atom->getArity() == pos->second.size()) {
+                    auto narrowed = std::make_unique<AstAtom>(atom->getName());
+                    narrowed->setSrcLoc(atom->getSrcLoc());
+                    for (size_t i = 0; i < pos->second.size(); i++) {
+                        if (pos->second[i]) {
+                            narrowed->addArgument(
+                                    std::unique_ptr<AstArgument>(atom->getArgument(i)->clone()));
+                        }
+                    }
+                    return std::move(narrowed);
+                }
+            }
+            return node;
+        }
+    };
+
+    // rewrite all atoms referring to narrowed relations
+    ColumnRemover remover(keptColumns);
+    for (AstClause* clause : clauses) {
+        clause->apply(remover);
+    }
+
+    // narrow the schemas and push the projection into the load directives
+    for (const auto& entry : keptColumns) {
+        AstRelation* rel = program.getRelation(entry.first);
+        const std::vector<bool>& columns = entry.second;
+
+        projectLoadDirectives(rel, columns);
+
+        // drop attributes back to front to keep earlier indices stable
+        for (size_t i = columns.size(); i-- > 0;) {
+            if (!columns[i]) {
+                rel->removeAttribute(i);
+            }
+        }
+    }
+
+    return true;
+}
+
+}  // end of namespace souffle
@@ -107,6 +107,45 @@ void DebugReportSection::printContent(std::ostream& out) const {
     out << "</div>\n";
 }
 
+DebugReportSection DebugReportSection::indexCopy() const {
+    DebugReportSection copy;
+    copy.id = id;
+    copy.title = title;
+    for (const DebugReportSection& subsection : subsections) {
+        copy.subsections.push_back(subsection.indexCopy());
+    }
+    return copy;
+}
+
+DebugReport::~DebugReport() {
+    if (!empty()) {
+        std::ofstream debugReportStream(Global::config().get("debug-report"));
+        debugReportStream << *this;
+    }
+    if (!bodyFileName.empty()) {
+        bodyStream.close();
+        remove(bodyFileName.c_str());
+    }
+}
+
+void DebugReport::addSection(const DebugReportSection& section) {
+    if (bodyFileName.empty()) {
+        bodyFileName = tempFile();
+        bodyStream.open(bodyFileName);
+    }
+    section.printContent(bodyStream);
+    bodyStream.flush();
+    sections.push_back(section.indexCopy());
+}
+
+bool DebugReport::sameAsLastReport(const std::string& kind, const std::string& content) {
+    const size_t hash = std::hash<std::string>()(content);
+    auto pos = lastContentHash.find(kind);
+    const bool same = pos != lastContentHash.end() && pos->second == hash;
+    lastContentHash[kind] = hash;
+    return same;
+}
+
 void DebugReport::print(std::ostream& out) const {
     out << "<!DOCTYPE html>\n";
     out << "<html>\n";
@@ -142,8 +181,12 @@ void DebugReport::print(std::ostream& out) const {
     for (const DebugReportSection& section : sections) {
         section.printIndex(out);
     }
-    for (const DebugReportSection& section : sections) {
-        section.printContent(out);
+    // the section contents were streamed to the spill file as the
+    // sections were added; replay it instead of re-printing them
+    if (!bodyFileName.empty()) {
+        bodyStream.flush();
+        std::ifstream bodyFile(bodyFileName);
+        out << bodyFile.rdbuf();
     }
     out << "<a href='#'>(return to top)</a>\n";
     out << "</body>\n";
@@ -218,36 +261,57 @@ bool DebugReporter::transform(AstTranslationUnit& translationUnit) {
 
 void DebugReporter::generateDebugReport(
         AstTranslationUnit& translationUnit, const std::string& id, std::string title) {
+    DebugReport& report = translationUnit.getDebugReport();
+
+    // sub-sections whose source text is identical to the one last reported
+    // collapse into a short note; most transformers touch only the datalog
+    // program, so this keeps repeated analysis output and in particular the
+    // costly dot graph rendering out of the report
+    auto unchangedSection = [](const std::string& id, std::string title) {
+        return DebugReportSection(
+                id, std::move(title), {}, "<p>(unchanged from the previous report section)</p>\n");
+    };
+    auto codeSection = [&](const std::string& kind, std::string title, std::string code) {
+        if (report.sameAsLastReport(kind, code)) {
+            return unchangedSection(id + "-" + kind, std::move(title));
+        }
+        return getCodeSection(id + "-" + kind, std::move(title), std::move(code));
+    };
+    auto dotGraphSection = [&](const std::string& kind, std::string title, const std::string& dotSpec) {
+        if (report.sameAsLastReport(kind, dotSpec)) {
+            return unchangedSection(id + "-" + kind, std::move(title));
+        }
+        return getDotGraphSection(id + "-" + kind, std::move(title), dotSpec);
+    };
+
     std::stringstream datalogSpec;
     translationUnit.getProgram()->print(datalogSpec);
-
-    DebugReportSection datalogSection = getCodeSection(id + "-dl", "Datalog", datalogSpec.str());
+    DebugReportSection datalogSection = codeSection("dl", "Datalog", datalogSpec.str());
 
     std::stringstream typeAnalysis;
     translationUnit.getAnalysis<TypeAnalysis>()->print(typeAnalysis);
-    DebugReportSection typeAnalysisSection = getCodeSection(id + "-ta", "Type Analysis", typeAnalysis.str());
+    DebugReportSection typeAnalysisSection = codeSection("ta", "Type Analysis", typeAnalysis.str());
 
     std::stringstream typeEnvironmentAnalysis;
     translationUnit.getAnalysis<TypeEnvironmentAnalysis>()->print(typeEnvironmentAnalysis);
     DebugReportSection typeEnvironmentAnalysisSection =
-            getCodeSection(id + "-tea", "Type Environment Analysis", typeEnvironmentAnalysis.str());
+            codeSection("tea", "Type Environment Analysis", typeEnvironmentAnalysis.str());
 
     std::stringstream precGraphDot;
     translationUnit.getAnalysis<PrecedenceGraph>()->print(precGraphDot);
     DebugReportSection precedenceGraphSection =
-            getDotGraphSection(id + "-prec-graph", "Precedence Graph", precGraphDot.str());
+            dotGraphSection("prec-graph", "Precedence Graph", precGraphDot.str());
 
     std::stringstream sccGraphDot;
     translationUnit.getAnalysis<SCCGraph>()->print(sccGraphDot);
-    DebugReportSection sccGraphSection =
-            getDotGraphSection(id + "-scc-graph", "SCC Graph", sccGraphDot.str());
+    DebugReportSection sccGraphSection = dotGraphSection("scc-graph", "SCC Graph", sccGraphDot.str());
 
     std::stringstream topsortSCCGraph;
     translationUnit.getAnalysis<TopologicallySortedSCCGraph>()->print(topsortSCCGraph);
     DebugReportSection topsortSCCGraphSection =
-            getCodeSection(id + "-topsort-scc-graph", "SCC Topological Sort Order", topsortSCCGraph.str());
+            codeSection("topsort-scc-graph", "SCC Topological Sort Order", topsortSCCGraph.str());
 
-    translationUnit.getDebugReport().addSection(DebugReportSection(id, std::move(title),
+    report.addSection(DebugReportSection(id, std::move(title),
             {datalogSection, typeAnalysisSection, typeEnvironmentAnalysisSection, precedenceGraphSection,
                     sccGraphSection, topsortSCCGraphSection},
             ""));
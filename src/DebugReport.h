@@ -19,6 +19,7 @@
 #include "Global.h"
 
 #include <fstream>
+#include <map>
 #include <memory>
 #include <ostream>
 #include <set>
@@ -66,7 +67,15 @@ public:
         return !subsections.empty();
     }
 
+    /**
+     * Returns a copy carrying only the data printIndex() needs; the
+     * section bodies, which dominate the report size, are dropped.
+     */
+    DebugReportSection indexCopy() const;
+
 private:
+    DebugReportSection() = default;
+
     std::string id;
     std::string title;
     std::vector<DebugReportSection> subsections;
@@ -80,22 +89,31 @@ private:
 
 /**
  * Class representing a HTML report, consisting of a list of sections.
+ *
+ * Section bodies are streamed to a spill file on disk as sections are
+ * added, so the memory held by the report stays bounded by the index
+ * skeleton no matter how many transformation stages are recorded.
  */
 class DebugReport {
 public:
-    ~DebugReport() {
-        if (!empty()) {
-            std::ofstream debugReportStream(Global::config().get("debug-report"));
-            debugReportStream << *this;
-        }
-    }
+    ~DebugReport();
+
     bool empty() const {
         return sections.empty();
     }
 
-    void addSection(const DebugReportSection& section) {
-        sections.push_back(section);
-    }
+    /**
+     * Adds the given section to the report, streaming its content to
+     * disk immediately; only the index information is retained.
+     */
+    void addSection(const DebugReportSection& section);
+
+    /**
+     * Tests whether the given content equals the content the section
+     * kind was last reported with, remembering it for the next stage.
+     * Repeated content can be elided from the report by the caller.
+     */
+    bool sameAsLastReport(const std::string& kind, const std::string& content);
 
     /**
      * Outputs a complete HTML document to the given stream,
@@ -110,7 +128,15 @@ public:
     }
 
 private:
+    /** Index-only copies of the added sections */
     std::vector<DebugReportSection> sections;
+
+    /** Spill file receiving the section contents as they are added */
+    std::string bodyFileName;
+    mutable std::ofstream bodyStream;
+
+    /** Per section kind, the hash of the content last reported for it */
+    std::map<std::string, size_t> lastContentHash;
 };
 
 /**
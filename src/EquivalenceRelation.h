@@ -103,14 +103,19 @@ public:
     void insertAll(const EquivalenceRelation<TupleType>& other) {
         other.genAllDisjointSetLists();
 
-        // iterate over partitions at a time
+        // merging whole forests happens under exclusive access (the RAM merge
+        // statements between semi-naive iterations are sequential), so the
+        // per-element union protocol is overkill: every partition of other is
+        // a single set, hence its root in this forest is resolved once and
+        // every member is linked straight under it with plain stores
         for (typename StatesMap::chunk it : other.equivalencePartition.getChunks(MAX_THREADS)) {
             for (auto& p : it) {
                 value_type rep = p.first;
                 StatesList& pl = *p.second;
                 const size_t ksize = pl.size();
+                parent_t root = this->sds.ds.findNode(this->sds.toDense(rep));
                 for (size_t i = 0; i < ksize; ++i) {
-                    this->sds.unionNodes(rep, pl.get(i));
+                    root = this->sds.ds.unionNodesExclusive(root, this->sds.toDense(pl.get(i)));
                 }
             }
         }
@@ -160,10 +165,15 @@ public:
                 std::tie(el, std::ignore) = *it;
                 rep = other.sds.findNode(el);
                 if (repsCovered.count(rep) != 0) {
-                    this->insert(el, rep);
+                    // extension is exclusive as well; skip the containment
+                    // check and the synchronised union of insert()
+                    this->sds.unionNodesExclusive(el, rep);
                 }
             }
         }
+
+        // invalidate iterators unconditionally
+        this->statesMapStale.store(true, std::memory_order_relaxed);
     }
 
     /**
@@ -225,6 +235,23 @@ public:
         return retVal;
     }
 
+    /**
+     * Memory held by the relation, covering the disjoint set, both direction
+     * mappings, and the cached per-set element lists.
+     * @return the number of bytes held
+     */
+    size_t getMemoryUsage() const {
+        statesLock.lock_shared();
+
+        size_t bytes = sds.getMemoryUsage() + equivalencePartition.getMemoryUsage();
+        for (auto& e : this->equivalencePartition) {
+            bytes += e.second->getMemoryUsage();
+        }
+
+        statesLock.unlock_shared();
+        return bytes;
+    }
+
     // an almighty iterator for several types of iteration.
     // Unfortunately, subclassing isn't an option with souffle
     //   - we don't deal with pointers (so no virtual)
@@ -253,7 +280,7 @@ public:
 
         // WITHIN: iterator for everything within the same DJset (used for EquivalenceRelation.partition())
         explicit iterator(const EquivalenceRelation* br, const StatesBucket within)
-                : br(br), ityp(IterType::WITHIN), djSetList(within) {
+                : br(br), ityp(IterType::WITHIN), djSetList(within), anteriorBound(within->size()) {
             // empty dj set
             if (djSetList->size() == 0) {
                 isEndVal = true;
@@ -263,6 +290,23 @@ public:
             updatePosterior();
         }
 
+        // WITHIN (sliced): iterator over the pairs of a single DJset whose anterior element lies within
+        // the index range [anteriorBegin, anteriorEnd) - used for EquivalenceRelation.partition() to
+        // split the pair space of large disjoint sets into balanced chunks
+        explicit iterator(const EquivalenceRelation* br, const StatesBucket within, size_t anteriorBegin,
+                size_t anteriorEnd)
+                : br(br), ityp(IterType::WITHIN), djSetList(within), cAnteriorIndex(anteriorBegin),
+                  anteriorBound(anteriorEnd) {
+            // empty dj set or empty slice
+            if (djSetList->size() == 0 || anteriorBegin >= anteriorEnd) {
+                isEndVal = true;
+                return;
+            }
+
+            updateAnterior();
+            updatePosterior();
+        }
+
         // ANTERIOR: iterator that yields all (former, _) \in djset(former) (djset(former) === within)
         explicit iterator(const EquivalenceRelation* br, const value_type former, const StatesBucket within)
                 : br(br), ityp(IterType::ANTERIOR), djSetList(within) {
@@ -274,6 +318,17 @@ public:
             updatePosterior();
         }
 
+        // POSTERIOR: iterator that yields all (_, latter) \in djset(latter) (the dual of ANTERIOR)
+        explicit iterator(const EquivalenceRelation* br, const StatesBucket within, const value_type latter)
+                : br(br), ityp(IterType::POSTERIOR), djSetList(within) {
+            if (djSetList->size() == 0) {
+                isEndVal = true;
+            }
+
+            updateAnterior();
+            setPosterior(latter);
+        }
+
         // ANTPOST: iterator that yields all (former, latter) \in djset(former), (djset(former) ==
         // djset(latter) == within)
         explicit iterator(const EquivalenceRelation* br, const value_type former, value_type latter,
@@ -380,6 +435,15 @@ public:
                     }
                     updatePosterior();
 
+                    break;
+                case IterType::POSTERIOR:
+                    // step anterior along one, and if we can't, then we're done.
+                    if (++cAnteriorIndex == djSetList->size()) {
+                        isEndVal = true;
+                        return *this;
+                    }
+                    updateAnterior();
+
                     break;
                 case IterType::ANTPOST:
                     // fixed anterior and posterior literally only points to one, so if we increment, its the
@@ -391,8 +455,9 @@ public:
                     // see if we can't move the posterior along
                     if (++cPosteriorIndex == djSetList->size()) {
                         // move anterior along one
-                        // see if we can't move the anterior along one
-                        if (++cAnteriorIndex == djSetList->size()) {
+                        // see if we can't move the anterior along one (the bound is the set size,
+                        // or the end of the slice for partition-generated iterators)
+                        if (++cAnteriorIndex == anteriorBound) {
                             isEndVal = true;
                             return *this;
                         }
@@ -417,7 +482,7 @@ public:
         bool isEndVal = false;
 
         // all the different types of iterator this can be
-        enum IterType { ALL, ANTERIOR, ANTPOST, WITHIN };
+        enum IterType { ALL, ANTERIOR, POSTERIOR, ANTPOST, WITHIN };
         IterType ityp;
 
         TupleType cPair;
@@ -431,6 +496,8 @@ public:
         size_t cAnteriorIndex = 0;
         // used for ALL, and ANTERIOR (just a current index in the cList)
         size_t cPosteriorIndex = 0;
+        // used for WITHIN (the anterior index this iterator stops at)
+        size_t anteriorBound = 0;
     };
 
 public:
@@ -565,6 +632,26 @@ public:
         return iterator(this, anteriorVal, (*found).second);
     }
 
+    /**
+     * Creates an iterator that generates all pairs (X, B)
+     * for a given B, and X are elements within B's disjoint set.
+     * If B is not an element of this relation, the end() iterator is returned.
+     * @param posteriorVal: The second value of the tuple to be generated for
+     * @return the iterator representing this.
+     */
+    iterator posteriorIt(value_type posteriorVal) const {
+        // an element unknown to this relation has no pairs associated
+        if (!containsElement(posteriorVal)) return end();
+
+        genAllDisjointSetLists();
+
+        // locate the blocklist that the posterior val resides in
+        auto found = equivalencePartition.find({sds.findNode(posteriorVal), nullptr});
+        assert(found != equivalencePartition.end() && "iterator called on partition that doesn't exist");
+
+        return iterator(this, (*found).second, posteriorVal);
+    }
+
     /**
      * Creates an iterator that generates the pair (A, B)
      * for a given A and B. If A and B don't exist, or aren't in the same set,
@@ -603,6 +690,9 @@ public:
      * Generate an approximate number of iterators for parallel iteration
      * The iterators returned are not necessarily equal in size, but in practise are approximately similarly
      * sized
+     * Disjoint sets whose pair space exceeds the chunk size are split within the set, by slicing their
+     * implicit (anterior x posterior) pair space along the anterior axis. This keeps the chunks balanced
+     * even when a single equivalence class covers most of the relation.
      * Depending on the structure of the data, there can be more or less partitions returned than requested.
      * @param chunks the number of requested partitions
      * @return a list of the iterators as ranges
@@ -615,27 +705,23 @@ public:
         if (numPairs == 0) return {};
         if (numPairs == 1 || chunks <= 1) return {souffle::make_range(begin(), end())};
 
-        // if there's more dj sets than requested chunks, then just return an iter per dj set
-        std::vector<souffle::range<iterator>> ret;
-        if (chunks <= equivalencePartition.size()) {
-            for (auto& p : equivalencePartition) {
-                ret.push_back(souffle::make_range(closure(p.first), end()));
-            }
-            return ret;
-        }
+        // the targeted number of pairs per chunk
+        const size_t perchunk = std::max<size_t>(numPairs / chunks, 1);
 
-        // keep it simple stupid
-        // just go through and if the size of the binrel is > numpairs/chunks, then generate an anteriorIt for
-        // each
-        const size_t perchunk = numPairs / chunks;
+        std::vector<souffle::range<iterator>> ret;
         for (const auto& itp : equivalencePartition) {
             const size_t s = itp.second->size();
-            if (s * s > perchunk) {
-                for (const auto& i : *itp.second) {
-                    ret.push_back(souffle::make_range(anteriorIt(i), end()));
-                }
-            } else {
+            if (s * s <= perchunk) {
+                // small set => covered by a single chunk
                 ret.push_back(souffle::make_range(closure(itp.first), end()));
+            } else {
+                // large set => slice its pair space along the anterior axis, with each
+                // anterior row contributing s pairs
+                const size_t rowsPerChunk = std::max<size_t>(perchunk / s, 1);
+                for (size_t row = 0; row < s; row += rowsPerChunk) {
+                    ret.push_back(souffle::make_range(
+                            iterator(this, itp.second, row, std::min(row + rowsPerChunk, s)), end()));
+                }
             }
         }
 
@@ -685,6 +771,10 @@ private:
         // btree version
         emptyPartition();
 
+        // fully compress the underlying trees in parallel first, such that the
+        // per-node find operations below are constant-time
+        this->sds.flatten();
+
         size_t dSetSize = this->sds.ds.a_blocks.size();
         for (size_t i = 0; i < dSetSize; ++i) {
             typename TupleType::value_type sparseVal = this->sds.toSparse(i);
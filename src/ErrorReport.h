@@ -180,6 +180,10 @@ public:
         diagnostics.insert(diagnostic);
     }
 
+    const std::set<Diagnostic>& getDiagnostics() const {
+        return diagnostics;
+    }
+
     void print(std::ostream& out) const {
         for (const Diagnostic& diagnostic : diagnostics) {
             out << diagnostic;
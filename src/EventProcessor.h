@@ -376,6 +376,101 @@ public:
     }
 } recursiveRelationNumberProcessor;
 
+/**
+ * Non-Recursive Relation Hardware Counter Profile Event Processor
+ */
+const class NonRecursiveRelationCounterProcessor : public EventProcessor {
+public:
+    NonRecursiveRelationCounterProcessor() {
+        EventProcessorSingleton::instance().registerEventProcessor("@p-nonrecursive-relation", this);
+    }
+    /** process event input */
+    void process(ProfileDatabase& db, const std::vector<std::string>& signature, va_list& args) override {
+        const std::string& relation = signature[1];
+        size_t cycles = va_arg(args, size_t);
+        size_t cacheMisses = va_arg(args, size_t);
+        size_t branchMisses = va_arg(args, size_t);
+        db.addSizeEntry({"program", "relation", relation, "cpu-cycles"}, cycles);
+        db.addSizeEntry({"program", "relation", relation, "cache-misses"}, cacheMisses);
+        db.addSizeEntry({"program", "relation", relation, "branch-misses"}, branchMisses);
+    }
+} nonRecursiveRelationCounterProcessor;
+
+/**
+ * Non-Recursive Rule Hardware Counter Profile Event Processor
+ */
+const class NonRecursiveRuleCounterProcessor : public EventProcessor {
+public:
+    NonRecursiveRuleCounterProcessor() {
+        EventProcessorSingleton::instance().registerEventProcessor("@p-nonrecursive-rule", this);
+    }
+    /** process event input */
+    void process(ProfileDatabase& db, const std::vector<std::string>& signature, va_list& args) override {
+        const std::string& relation = signature[1];
+        const std::string& rule = signature[3];
+        size_t cycles = va_arg(args, size_t);
+        size_t cacheMisses = va_arg(args, size_t);
+        size_t branchMisses = va_arg(args, size_t);
+        db.addSizeEntry({"program", "relation", relation, "non-recursive-rule", rule, "cpu-cycles"}, cycles);
+        db.addSizeEntry(
+                {"program", "relation", relation, "non-recursive-rule", rule, "cache-misses"}, cacheMisses);
+        db.addSizeEntry(
+                {"program", "relation", relation, "non-recursive-rule", rule, "branch-misses"}, branchMisses);
+    }
+} nonRecursiveRuleCounterProcessor;
+
+/**
+ * Recursive Relation Hardware Counter Profile Event Processor
+ */
+const class RecursiveRelationCounterProcessor : public EventProcessor {
+public:
+    RecursiveRelationCounterProcessor() {
+        EventProcessorSingleton::instance().registerEventProcessor("@p-recursive-relation", this);
+    }
+    /** process event input */
+    void process(ProfileDatabase& db, const std::vector<std::string>& signature, va_list& args) override {
+        const std::string& relation = signature[1];
+        size_t cycles = va_arg(args, size_t);
+        size_t cacheMisses = va_arg(args, size_t);
+        size_t branchMisses = va_arg(args, size_t);
+        std::string iteration = std::to_string(va_arg(args, size_t));
+        db.addSizeEntry({"program", "relation", relation, "iteration", iteration, "cpu-cycles"}, cycles);
+        db.addSizeEntry(
+                {"program", "relation", relation, "iteration", iteration, "cache-misses"}, cacheMisses);
+        db.addSizeEntry(
+                {"program", "relation", relation, "iteration", iteration, "branch-misses"}, branchMisses);
+    }
+} recursiveRelationCounterProcessor;
+
+/**
+ * Recursive Rule Hardware Counter Profile Event Processor
+ */
+const class RecursiveRuleCounterProcessor : public EventProcessor {
+public:
+    RecursiveRuleCounterProcessor() {
+        EventProcessorSingleton::instance().registerEventProcessor("@p-recursive-rule", this);
+    }
+    /** process event input */
+    void process(ProfileDatabase& db, const std::vector<std::string>& signature, va_list& args) override {
+        const std::string& relation = signature[1];
+        const std::string& version = signature[2];
+        const std::string& rule = signature[4];
+        size_t cycles = va_arg(args, size_t);
+        size_t cacheMisses = va_arg(args, size_t);
+        size_t branchMisses = va_arg(args, size_t);
+        std::string iteration = std::to_string(va_arg(args, size_t));
+        db.addSizeEntry({"program", "relation", relation, "iteration", iteration, "recursive-rule", rule,
+                                version, "cpu-cycles"},
+                cycles);
+        db.addSizeEntry({"program", "relation", relation, "iteration", iteration, "recursive-rule", rule,
+                                version, "cache-misses"},
+                cacheMisses);
+        db.addSizeEntry({"program", "relation", relation, "iteration", iteration, "recursive-rule", rule,
+                                version, "branch-misses"},
+                branchMisses);
+    }
+} recursiveRuleCounterProcessor;
+
 /**
  * Recursive Relation Copy Timing Profile Event Processor
  */
@@ -535,6 +630,77 @@ public:
 
 } relationReadsProcessor;
 
+/**
+ * Relation Memory Processor
+ */
+const class RelationMemoryProcessor : public EventProcessor {
+public:
+    RelationMemoryProcessor() {
+        EventProcessorSingleton::instance().registerEventProcessor("@relation-memory", this);
+    }
+    /** process event input */
+    void process(ProfileDatabase& db, const std::vector<std::string>& signature, va_list& args) override {
+        const std::string& relation = signature[1];
+        size_t bytes = va_arg(args, size_t);
+        db.addSizeEntry({"program", "relation", relation, "memory"}, bytes);
+    }
+
+} relationMemoryProcessor;
+
+/**
+ * Index Hits Processor
+ */
+const class IndexHitsProcessor : public EventProcessor {
+public:
+    IndexHitsProcessor() {
+        EventProcessorSingleton::instance().registerEventProcessor("@index-hits", this);
+    }
+    /** process event input */
+    void process(ProfileDatabase& db, const std::vector<std::string>& signature, va_list& args) override {
+        const std::string& relation = signature[1];
+        const std::string& order = signature[2];
+        size_t hits = va_arg(args, size_t);
+        db.addSizeEntry({"program", "relation", relation, "index", order}, hits);
+    }
+
+} indexHitsProcessor;
+
+/**
+ * Index Structure Statistics Processor
+ */
+const class IndexStatsProcessor : public EventProcessor {
+public:
+    IndexStatsProcessor() {
+        EventProcessorSingleton::instance().registerEventProcessor("@index-stats", this);
+    }
+    /** process event input */
+    void process(ProfileDatabase& db, const std::vector<std::string>& signature, va_list& args) override {
+        const std::string& relation = signature[1];
+        const std::string& order = signature[2];
+        const std::string& metric = signature[3];
+        size_t value = va_arg(args, size_t);
+        db.addSizeEntry({"program", "relation", relation, "index-stats", order, metric}, value);
+    }
+
+} indexStatsProcessor;
+
+/**
+ * Statement Sample Processor
+ */
+const class StatementSampleProcessor : public EventProcessor {
+public:
+    StatementSampleProcessor() {
+        EventProcessorSingleton::instance().registerEventProcessor("@sample", this);
+    }
+    /** process event input */
+    void process(ProfileDatabase& db, const std::vector<std::string>& signature, va_list& args) override {
+        const std::string& statement = signature[1];
+        size_t samples = va_arg(args, size_t);
+        db.addSizeEntry({"program", "statement-samples", statement}, samples);
+    }
+
+} statementSampleProcessor;
+
 /**
  * Config entry processor
  */
@@ -18,10 +18,17 @@
 
 #include "ExplainProvenanceImpl.h"
 
+#include <atomic>
 #include <csignal>
+#include <fstream>
+#include <future>
 #include <iostream>
+#include <netinet/in.h>
 #include <regex>
+#include <sstream>
 #include <string>
+#include <sys/socket.h>
+#include <thread>
 #include <unistd.h>
 
 #ifdef USE_NCURSES
@@ -59,6 +66,49 @@ private:
     ExplainConfig() = default;
 };
 
+/**
+ * Parse tuple, split into relation name and values
+ * @param str The string to parse, should be something like "R(x1, x2, x3, ...)"
+ */
+inline std::pair<std::string, std::vector<std::string>> parseTuple(const std::string& str) {
+    std::string relName;
+    std::vector<std::string> args;
+
+    // regex for matching tuples
+    // values matches numbers or strings enclosed in quotation marks
+    std::regex relRegex(
+            "([a-zA-Z0-9_.-]*)[[:blank:]]*\\(([[:blank:]]*([0-9]+|\"[^\"]*\")([[:blank:]]*,[[:blank:]]*(["
+            "0-"
+            "9]+|\"[^\"]*\"))*)?\\)",
+            std::regex_constants::extended);
+    std::smatch relMatch;
+
+    // first check that format matches correctly
+    // and extract relation name
+    if (!std::regex_match(str, relMatch, relRegex) || relMatch.size() < 3) {
+        return std::make_pair(relName, args);
+    }
+
+    // set relation name
+    relName = relMatch[1];
+
+    // extract each argument
+    std::string argsList = relMatch[2];
+    std::smatch argsMatcher;
+    std::regex argRegex(R"([0-9]+|"[^"]*")", std::regex_constants::extended);
+
+    while (std::regex_search(argsList, argsMatcher, argRegex)) {
+        // match the start of the arguments
+        std::string currentArg = argsMatcher[0];
+        args.push_back(currentArg);
+
+        // use the rest of the arguments
+        argsList = argsMatcher.suffix().str();
+    }
+
+    return std::make_pair(relName, args);
+}
+
 class Explain {
 public:
     ExplainProvenance& prov;
@@ -168,6 +218,13 @@ public:
             } catch (std::exception& e) {
                 printError("Usage: rule <relation name> <rule number>\n");
             }
+        } else if (command[0] == "batch") {
+            auto files = command.size() == 2 ? split(command[1], ' ') : std::vector<std::string>();
+            if (files.size() != 2) {
+                printError("Usage: batch <query-file> <output-file>\n");
+                return true;
+            }
+            batchExplain(files[0], files[1]);
         } else if (command[0] == "measure") {
             try {
                 printInfo(prov.measureRelation(command[1]));
@@ -207,6 +264,8 @@ public:
                     "subproof <relation>(<label>): Prints derivation tree for a subproof, label is\n"
                     "    generated if a derivation tree exceeds height limit\n"
                     "rule <relation name> <rule number>: Prints a rule\n"
+                    "batch <query-file> <output-file>: Explains a file of explain queries, one per\n"
+                    "    line, writing their JSON proof trees in query order\n"
                     "output <filename>: Write output into a file, or provide empty filename to\n"
                     "    disable output\n"
                     "format <json|proof>: switch format between json and proof-trees\n"
@@ -236,47 +295,83 @@ private:
     virtual void printError(const std::string& error) = 0;
 
     /**
-     * Parse tuple, split into relation name and values
-     * @param str The string to parse, should be something like "R(x1, x2, x3, ...)"
+     * Evaluate a file of explain queries, one tuple per line, and write a
+     * single JSON document with one proof tree per query in query order.
+     * The queries are evaluated by a pool of worker threads; they share the
+     * proof-subtree cache of the provenance instance, so subproofs common
+     * across the batch are expanded only once, and each tree is rendered
+     * into its own buffer to keep the workers off the output stream.
      */
-    std::pair<std::string, std::vector<std::string>> parseTuple(const std::string& str) {
-        std::string relName;
-        std::vector<std::string> args;
-
-        // regex for matching tuples
-        // values matches numbers or strings enclosed in quotation marks
-        std::regex relRegex(
-                "([a-zA-Z0-9_.-]*)[[:blank:]]*\\(([[:blank:]]*([0-9]+|\"[^\"]*\")([[:blank:]]*,[[:blank:]]*(["
-                "0-"
-                "9]+|\"[^\"]*\"))*)?\\)",
-                std::regex_constants::extended);
-        std::smatch relMatch;
-
-        // first check that format matches correctly
-        // and extract relation name
-        if (!std::regex_match(str, relMatch, relRegex) || relMatch.size() < 3) {
-            return std::make_pair(relName, args);
+    void batchExplain(const std::string& queryFileName, const std::string& outputFileName) {
+        std::ifstream queryFile(queryFileName);
+        if (!queryFile.is_open()) {
+            printError("Could not open query file " + queryFileName + "\n");
+            return;
+        }
+
+        // parse all queries up front; malformed lines are reported but do
+        // not abort the remaining queries
+        std::vector<std::pair<std::string, std::vector<std::string>>> queries;
+        std::string line;
+        while (getline(queryFile, line)) {
+            if (line.empty()) {
+                continue;
+            }
+            auto query = parseTuple(line);
+            if (query.first.empty()) {
+                printError("Ignoring malformed query: " + line + "\n");
+                continue;
+            }
+            queries.push_back(std::move(query));
         }
 
-        // set relation name
-        relName = relMatch[1];
+        std::ofstream outputFile(outputFileName);
+        if (!outputFile.is_open()) {
+            printError("Could not open output file " + outputFileName + "\n");
+            return;
+        }
 
-        // extract each argument
-        std::string argsList = relMatch[2];
-        std::smatch argsMatcher;
-        std::regex argRegex(R"([0-9]+|"[^"]*")", std::regex_constants::extended);
+        const size_t depthLimit = ExplainConfig::getExplainConfig().depthLimit;
 
-        while (std::regex_search(argsList, argsMatcher, argRegex)) {
-            // match the start of the arguments
-            std::string currentArg = argsMatcher[0];
-            args.push_back(currentArg);
+        std::vector<std::string> trees(queries.size());
+        std::atomic<size_t> nextQuery(0);
+        auto worker = [&]() {
+            size_t i;
+            while ((i = nextQuery++) < queries.size()) {
+                auto tree = prov.explain(queries[i].first, queries[i].second, depthLimit);
+                std::stringstream ss;
+                tree->printJSON(ss, 1);
+                trees[i] = ss.str();
+            }
+        };
 
-            // use the rest of the arguments
-            argsList = argsMatcher.suffix().str();
+        size_t numWorkers = std::thread::hardware_concurrency();
+        if (numWorkers == 0) {
+            numWorkers = 1;
+        }
+        std::vector<std::future<void>> workers;
+        for (size_t i = 1; i < numWorkers; i++) {
+            workers.push_back(std::async(std::launch::async, worker));
+        }
+        worker();
+        for (auto& w : workers) {
+            w.wait();
         }
 
-        return std::make_pair(relName, args);
+        outputFile << "{ \"proofs\": [\n";
+        for (size_t i = 0; i < trees.size(); i++) {
+            if (i != 0) {
+                outputFile << ",\n";
+            }
+            outputFile << trees[i];
+        }
+        outputFile << "],\n";
+        prov.printRulesJSON(outputFile);
+        outputFile << "}\n";
+
+        printInfo("Explained " + std::to_string(queries.size()) + " tuples\n");
     }
+
 };
 
 class ExplainConsole : public Explain {
@@ -527,6 +622,182 @@ private:
 };
 #endif
 
+/**
+ * A socket front end serving provenance queries to many clients at once,
+ * e.g. a triage dashboard. Evaluation has finished by the time explain is
+ * reachable, so the relations and the proof machinery are read-only and
+ * queries from different connections execute fully in parallel -- the same
+ * property the batch mode of the interactive interface relies on.
+ *
+ * Each accepted connection is served by its own thread speaking a
+ * line-based protocol: the client sends one command per line and receives
+ * a JSON document followed by a blank line in return. Supported commands:
+ *     explain <relation>(<value>, ...)   derivation tree of the tuple
+ *     subproof <relation>(<label>)       derivation tree of a subproof
+ *     rule <relation> <number>           text of a rule
+ *     setdepth <depth>                   tree height limit, per connection
+ *     quit                               closes the connection
+ * The depth limit is tracked per connection rather than in the global
+ * ExplainConfig, so one client changing it does not affect the trees
+ * served to another.
+ */
+class ExplainServer {
+public:
+    ExplainServer(ExplainProvenance& prov, int port) : prov(prov), port(port) {}
+
+    /* Accept and serve connections until the process is terminated */
+    void serve() {
+        int listener = socket(AF_INET, SOCK_STREAM, 0);
+        if (listener < 0) {
+            std::cerr << "Could not create explain server socket\n";
+            return;
+        }
+
+        // allow quick restarts on the same port
+        int enable = 1;
+        setsockopt(listener, SOL_SOCKET, SO_REUSEADDR, &enable, sizeof(enable));
+
+        sockaddr_in address{};
+        address.sin_family = AF_INET;
+        address.sin_addr.s_addr = htonl(INADDR_ANY);
+        address.sin_port = htons(port);
+        if (bind(listener, reinterpret_cast<sockaddr*>(&address), sizeof(address)) < 0 ||
+                listen(listener, SOMAXCONN) < 0) {
+            std::cerr << "Could not listen on explain server port " << port << "\n";
+            close(listener);
+            return;
+        }
+
+        std::cout << "Explain server listening on port " << port << "\n";
+
+        while (true) {
+            int connection = accept(listener, nullptr, nullptr);
+            if (connection < 0) {
+                break;
+            }
+            std::thread([this, connection]() { handleConnection(connection); }).detach();
+        }
+
+        close(listener);
+    }
+
+private:
+    ExplainProvenance& prov;
+    int port;
+
+    /* Serve one connection; runs in its own thread */
+    void handleConnection(int connection) {
+        size_t depthLimit = ExplainConfig::getExplainConfig().depthLimit;
+        std::string buffer;
+        char chunk[4096];
+        ssize_t bytes;
+
+        while ((bytes = read(connection, chunk, sizeof(chunk))) > 0) {
+            buffer.append(chunk, bytes);
+
+            size_t eol;
+            while ((eol = buffer.find('\n')) != std::string::npos) {
+                std::string line = buffer.substr(0, eol);
+                buffer.erase(0, eol + 1);
+                if (!line.empty() && line.back() == '\r') {
+                    line.pop_back();
+                }
+                if (line.empty()) {
+                    continue;
+                }
+                if (line == "exit" || line == "q" || line == "quit") {
+                    close(connection);
+                    return;
+                }
+                if (!sendResponse(connection, processQuery(line, depthLimit))) {
+                    close(connection);
+                    return;
+                }
+            }
+        }
+
+        close(connection);
+    }
+
+    /* Evaluate a single command line and render its JSON response */
+    std::string processQuery(const std::string& line, size_t& depthLimit) {
+        std::vector<std::string> command = split(line, ' ', 1);
+
+        if (command[0] == "explain" && command.size() == 2) {
+            auto query = parseTuple(command[1]);
+            if (query.first.empty()) {
+                return error("Usage: explain relation_name(<element1>, <element2>, ...)");
+            }
+            return printTree(prov.explain(query.first, query.second, depthLimit));
+        } else if (command[0] == "subproof" && command.size() == 2) {
+            auto query = parseTuple(command[1]);
+            if (query.first.empty() || query.second.size() != 1) {
+                return error("Usage: subproof relation_name(<label>)");
+            }
+            try {
+                return printTree(prov.explainSubproof(query.first, std::stoi(query.second[0]), depthLimit));
+            } catch (std::exception& e) {
+                return error("Usage: subproof relation_name(<label>)");
+            }
+        } else if (command[0] == "rule" && command.size() == 2) {
+            auto query = split(command[1], ' ');
+            if (query.size() != 2) {
+                return error("Usage: rule <relation name> <rule number>");
+            }
+            try {
+                return "{ \"rule\": \"" + stringify(prov.getRule(query[0], std::stoi(query[1]))) +
+                       "\"}\n\n";
+            } catch (std::exception& e) {
+                return error("Usage: rule <relation name> <rule number>");
+            }
+        } else if (command[0] == "setdepth" && command.size() == 2) {
+            try {
+                depthLimit = std::stoi(command[1]);
+            } catch (std::exception& e) {
+                return error("<" + command[1] + "> is not a valid depth");
+            }
+            return "{ \"depth\": " + std::to_string(depthLimit) + "}\n\n";
+        }
+
+        return error(
+                "Commands: explain <relation>(<element1>, ...), subproof <relation>(<label>), "
+                "rule <relation name> <rule number>, setdepth <depth>, quit");
+    }
+
+    /* Render a derivation tree as the JSON document of the response */
+    std::string printTree(std::unique_ptr<TreeNode> tree) {
+        if (!tree) {
+            return error("Tuple not found");
+        }
+
+        std::stringstream ss;
+        ss << "{ \"proof\":\n";
+        tree->printJSON(ss, 1);
+        ss << ",";
+        prov.printRulesJSON(ss);
+        ss << "}\n\n";
+        return ss.str();
+    }
+
+    /* Render an error response */
+    std::string error(const std::string& message) {
+        return "{ \"error\": \"" + stringify(message) + "\"}\n\n";
+    }
+
+    /* Write a full response to a connection */
+    bool sendResponse(int connection, const std::string& response) {
+        size_t written = 0;
+        while (written < response.size()) {
+            ssize_t bytes = write(connection, response.data() + written, response.size() - written);
+            if (bytes <= 0) {
+                return false;
+            }
+            written += bytes;
+        }
+        return true;
+    }
+};
+
 inline void explain(SouffleProgram& prog, bool ncurses = false) {
     ExplainProvenanceImpl prov(prog);
 
@@ -543,6 +814,28 @@ inline void explain(SouffleProgram& prog, bool ncurses = false) {
     }
 }
 
+/**
+ * Serve provenance queries over a TCP socket instead of the interactive
+ * interface; mode is the value of the provenance option, either "server"
+ * for the default port or "server:<port>".
+ */
+inline void explainServer(SouffleProgram& prog, const std::string& mode) {
+    int port = 14321;
+    auto colon = mode.find(':');
+    if (colon != std::string::npos) {
+        try {
+            port = std::stoi(mode.substr(colon + 1));
+        } catch (std::exception& e) {
+            std::cerr << "Invalid explain server port in \"" << mode << "\"\n";
+            return;
+        }
+    }
+
+    ExplainProvenanceImpl prov(prog);
+    ExplainServer server(prov, port);
+    server.serve();
+}
+
 // this is necessary because ncurses.h defines TRUE and FALSE macros, and they otherwise clash with our parser
 #ifdef USE_NCURSES
 #undef TRUE
@@ -22,8 +22,10 @@
 
 #include <algorithm>
 #include <chrono>
+#include <future>
 #include <map>
 #include <memory>
+#include <mutex>
 #include <sstream>
 #include <string>
 #include <vector>
@@ -37,7 +39,9 @@ public:
     }
 
     void setup() override {
-        // for each clause, store a mapping from the head relation name to body relation names
+        // for each clause, an info relation maps the head relation name to body relation names;
+        // only register the info relations here, their tuples are scanned lazily on the first
+        // query touching the head relation so that the explain prompt is available immediately
         for (auto& rel : prog.getAllRelations()) {
             std::string name = rel->getName();
 
@@ -46,25 +50,7 @@ public:
                 continue;
             }
 
-            // find all the info tuples
-            for (auto& tuple : *rel) {
-                std::vector<std::string> bodyLiterals;
-
-                RamDomain ruleNum;
-                tuple >> ruleNum;
-
-                for (size_t i = 1; i < rel->getArity() - 1; i++) {
-                    std::string bodyLit;
-                    tuple >> bodyLit;
-                    bodyLiterals.push_back(bodyLit);
-                }
-
-                std::string rule;
-                tuple >> rule;
-
-                info.insert({std::make_pair(name.substr(0, name.find(".@info")), ruleNum), bodyLiterals});
-                rules.insert({std::make_pair(name.substr(0, name.find(".@info")), ruleNum), rule});
-            }
+            pendingInfo[name.substr(0, name.find(".@info"))].push_back(rel);
         }
     }
 
@@ -79,7 +65,8 @@ public:
             return std::make_unique<LeafNode>(relName + "(" + joinedArgsStr + ")");
         }
 
-        assert(info.find(std::make_pair(relName, ruleNum)) != info.end() && "invalid rule for tuple");
+        auto bodyRelations = getRuleInfo(relName, ruleNum);
+        assert(!bodyRelations.empty() && "invalid rule for tuple");
 
         // if depth limit exceeded
         if (depthLimit <= 1) {
@@ -87,6 +74,7 @@ public:
             tuple.push_back(levelNum);
 
             // find if subproof exists already
+            std::lock_guard<std::mutex> guard(proofMutex);
             size_t idx = 0;
             auto it = std::find(subproofs.begin(), subproofs.end(), tuple);
             if (it != subproofs.end()) {
@@ -99,6 +87,19 @@ public:
             return std::make_unique<LeafNode>("subproof " + relName + "(" + std::to_string(idx) + ")");
         }
 
+        // a derivation of height levelNum is fully expanded whenever the
+        // depth limit exceeds it, in which case the subtree is identical for
+        // all subsequent queries and can be served from the cache
+        auto cacheKey = std::make_pair(relName, tuple);
+        bool cacheable = depthLimit > (size_t)levelNum;
+        if (cacheable) {
+            std::lock_guard<std::mutex> guard(proofMutex);
+            auto cached = subtreeCache.find(cacheKey);
+            if (cached != subtreeCache.end()) {
+                return cached->second->clone();
+            }
+        }
+
         auto internalNode = std::make_unique<InnerNode>(
                 relName + "(" + joinedArgsStr + ")", "(R" + std::to_string(ruleNum) + ")");
 
@@ -106,15 +107,15 @@ public:
         std::vector<RamDomain> ret;
         std::vector<bool> err;
 
-        // add level number to tuple
-        tuple.push_back(levelNum);
+        // add the packed height bound to the tuple; the rule bits are zero as
+        // the subroutine only compares heights
+        tuple.push_back(packProvenance(0, levelNum));
 
         // execute subroutine to get subproofs
         prog.executeSubroutine(relName + "_" + std::to_string(ruleNum) + "_subproof", tuple, ret, err);
 
         // recursively get nodes for subproofs
         size_t tupleCurInd = 0;
-        auto bodyRelations = info[std::make_pair(relName, ruleNum)];
 
         // start from begin + 1 because the first element represents the head atom
         for (auto it = bodyRelations.begin() + 1; it < bodyRelations.end(); it++) {
@@ -136,9 +137,9 @@ public:
             // traverse subroutine return
             size_t arity;
             if (isConstraint) {
-                // we only handle binary constraints, and assume arity is 4 to account for hidden provenance
-                // annotations
-                arity = 4;
+                // we only handle binary constraints, and assume arity is 3 to account for the hidden
+                // provenance annotation
+                arity = 3;
             } else {
                 arity = prog.getRelation(bodyRelAtomName)->getArity();
             }
@@ -148,13 +149,13 @@ public:
             std::vector<RamDomain> subproofTuple;
             std::vector<bool> subproofTupleError;
 
-            for (; tupleCurInd < tupleEnd - 2; tupleCurInd++) {
+            for (; tupleCurInd < tupleEnd - 1; tupleCurInd++) {
                 subproofTuple.push_back(ret[tupleCurInd]);
                 subproofTupleError.push_back(err[tupleCurInd]);
             }
 
-            int subproofRuleNum = ret[tupleCurInd];
-            int subproofLevelNum = ret[tupleCurInd + 1];
+            int subproofRuleNum = provenanceRuleNumber(ret[tupleCurInd]);
+            int subproofLevelNum = provenanceLevelNumber(ret[tupleCurInd]);
 
             // for a negation, display the corresponding tuple and do not recurse
             if (bodyRel[0] == '!') {
@@ -187,6 +188,11 @@ public:
             tupleCurInd = tupleEnd;
         }
 
+        if (cacheable) {
+            std::lock_guard<std::mutex> guard(proofMutex);
+            subtreeCache[std::move(cacheKey)] = internalNode->clone();
+        }
+
         return std::move(internalNode);
     }
 
@@ -234,7 +240,7 @@ public:
         }
 
         // atom meta information stored for the current rule
-        auto atoms = info[std::make_pair(relName, ruleNum)];
+        auto atoms = getRuleInfo(relName, ruleNum);
 
         // the info stores the set of atoms, if there is only 1 atom, then it must be the head, so it must be
         // a fact
@@ -285,7 +291,7 @@ public:
         std::map<std::string, char> variableTypes;
 
         // atom meta information stored for the current rule
-        auto atoms = info[std::make_pair(relName, ruleNum)];
+        auto atoms = getRuleInfo(relName, ruleNum);
 
         // atoms[0] represents variables in the head atom
         auto headVariables = splitString(atoms[0], ',');
@@ -392,9 +398,9 @@ public:
             // traverse subroutine return
             size_t arity;
             if (isConstraint) {
-                // we only handle binary constraints, and assume arity is 4 to account for hidden provenance
-                // annotations
-                arity = 4;
+                // we only handle binary constraints, and assume arity is 3 to account for the hidden
+                // provenance annotation
+                arity = 3;
             } else {
                 arity = prog.getRelation(bodyRelAtomName)->getArity();
             }
@@ -403,7 +409,7 @@ public:
             std::vector<RamDomain> atomValues;
             std::vector<bool> atomErrs;
             size_t j = returnCounter;
-            for (; j < returnCounter + arity - 2; j++) {
+            for (; j < returnCounter + arity - 1; j++) {
                 atomValues.push_back(ret[j]);
                 atomErrs.push_back(err[j]);
             }
@@ -442,6 +448,7 @@ public:
     }
 
     std::string getRule(std::string relName, size_t ruleNum) override {
+        materializeRuleInfo(relName);
         auto key = make_pair(relName, ruleNum);
 
         auto rule = rules.find(key);
@@ -453,6 +460,7 @@ public:
     }
 
     std::vector<std::string> getRules(std::string relName) override {
+        materializeRuleInfo(relName);
         std::vector<std::string> relRules;
         // go through all rules
         for (auto& rule : rules) {
@@ -491,7 +499,7 @@ public:
             }
 
             std::vector<RamDomain> currentTuple;
-            for (size_t i = 0; i < rel->getArity() - 2; i++) {
+            for (size_t i = 0; i < rel->getArity() - 1; i++) {
                 RamDomain n;
                 if (*rel->getAttrType(i) == 's') {
                     std::string s;
@@ -504,14 +512,13 @@ public:
                 currentTuple.push_back(n);
             }
 
-            RamDomain ruleNum;
-            tuple >> ruleNum;
-
-            RamDomain levelNum;
-            tuple >> levelNum;
+            RamDomain annotation;
+            tuple >> annotation;
 
             std::cout << "Tuples expanded: "
-                      << explain(relName, currentTuple, ruleNum, levelNum, 20)->getSize();
+                      << explain(relName, currentTuple, provenanceRuleNumber(annotation),
+                                 provenanceLevelNumber(annotation), 20)
+                                 ->getSize();
             numTuples++;
             proc++;
 
@@ -532,6 +539,7 @@ public:
     }
 
     void printRulesJSON(std::ostream& os) override {
+        materializeAllRuleInfo();
         os << "\"rules\": [\n";
         bool first = true;
         for (auto const& cur : rules) {
@@ -548,10 +556,114 @@ public:
 private:
     std::map<std::pair<std::string, size_t>, std::vector<std::string>> info;
     std::map<std::pair<std::string, size_t>, std::string> rules;
+    /** info relations whose tuples have not been scanned yet, keyed by head relation name */
+    std::map<std::string, std::vector<Relation*>> pendingInfo;
+    /** guards the lazily materialized rule structures; queries of a batch
+     * explain run touch them concurrently */
+    std::mutex infoMutex;
+    /** guards the subproof labels and the subtree cache for the same reason */
+    std::mutex proofMutex;
     std::vector<std::vector<RamDomain>> subproofs;
+    /** memoized fully expanded subtrees, keyed by relation name and tuple;
+     * shared subproofs are hence probed only once per explain session */
+    std::map<std::pair<std::string, std::vector<RamDomain>>, std::unique_ptr<TreeNode>> subtreeCache;
     std::vector<std::string> constraintList = {
             "=", "!=", "<", "<=", ">=", ">", "match", "contains", "not_match", "not_contains"};
 
+    /** Scan a single info relation into the given rule structures */
+    void scanInfoRelation(Relation* rel,
+            std::map<std::pair<std::string, size_t>, std::vector<std::string>>& infoOut,
+            std::map<std::pair<std::string, size_t>, std::string>& rulesOut) {
+        std::string name = rel->getName();
+        std::string headRel = name.substr(0, name.find(".@info"));
+
+        // find all the info tuples
+        for (auto& tuple : *rel) {
+            std::vector<std::string> bodyLiterals;
+
+            RamDomain ruleNum;
+            tuple >> ruleNum;
+
+            for (size_t i = 1; i < rel->getArity() - 1; i++) {
+                std::string bodyLit;
+                tuple >> bodyLit;
+                bodyLiterals.push_back(bodyLit);
+            }
+
+            std::string rule;
+            tuple >> rule;
+
+            infoOut.insert({std::make_pair(headRel, ruleNum), bodyLiterals});
+            rulesOut.insert({std::make_pair(headRel, ruleNum), rule});
+        }
+    }
+
+    /** Scan the info relations of a single head relation on its first use;
+     * the caller must hold the info lock */
+    void unsafeMaterializeRuleInfo(const std::string& relName) {
+        auto pending = pendingInfo.find(relName);
+        if (pending == pendingInfo.end()) {
+            return;
+        }
+
+        for (auto* rel : pending->second) {
+            scanInfoRelation(rel, info, rules);
+        }
+        pendingInfo.erase(pending);
+    }
+
+    /** Scan the info relations of a single head relation on its first use */
+    void materializeRuleInfo(const std::string& relName) {
+        std::lock_guard<std::mutex> guard(infoMutex);
+        unsafeMaterializeRuleInfo(relName);
+    }
+
+    /** Look up the atoms of a rule, materializing the rule structures of its
+     * head relation on first touch; holds the info lock throughout, so
+     * concurrent batch queries stay safe; yields an empty vector for an
+     * unknown rule */
+    std::vector<std::string> getRuleInfo(const std::string& relName, size_t ruleNum) {
+        std::lock_guard<std::mutex> guard(infoMutex);
+        unsafeMaterializeRuleInfo(relName);
+
+        auto it = info.find(std::make_pair(relName, ruleNum));
+        return it == info.end() ? std::vector<std::string>() : it->second;
+    }
+
+    /** Scan all remaining info relations, one scan per background thread; the
+     * scans only read program relations and fill task-local maps, so they can
+     * proceed concurrently and are merged serially afterwards */
+    void materializeAllRuleInfo() {
+        std::lock_guard<std::mutex> guard(infoMutex);
+
+        std::vector<Relation*> relations;
+        for (auto& pending : pendingInfo) {
+            relations.insert(relations.end(), pending.second.begin(), pending.second.end());
+        }
+
+        struct ScanResult {
+            std::map<std::pair<std::string, size_t>, std::vector<std::string>> info;
+            std::map<std::pair<std::string, size_t>, std::string> rules;
+        };
+        std::vector<ScanResult> results(relations.size());
+
+        std::vector<std::future<void>> scans;
+        for (size_t i = 0; i < relations.size(); i++) {
+            scans.push_back(std::async(std::launch::async, [this, &relations, &results, i]() {
+                scanInfoRelation(relations[i], results[i].info, results[i].rules);
+            }));
+        }
+        for (auto& scan : scans) {
+            scan.wait();
+        }
+
+        for (auto& result : results) {
+            info.insert(result.info.begin(), result.info.end());
+            rules.insert(result.rules.begin(), result.rules.end());
+        }
+        pendingInfo.clear();
+    }
+
     std::pair<int, int> findTuple(const std::string& relName, std::vector<RamDomain> tup) {
         auto rel = prog.getRelation(relName);
 
@@ -564,7 +676,7 @@ private:
             bool match = true;
             std::vector<RamDomain> currentTuple;
 
-            for (size_t i = 0; i < rel->getArity() - 2; i++) {
+            for (size_t i = 0; i < rel->getArity() - 1; i++) {
                 RamDomain n;
                 if (*rel->getAttrType(i) == 's') {
                     std::string s;
@@ -583,13 +695,10 @@ private:
             }
 
             if (match) {
-                RamDomain ruleNum;
-                tuple >> ruleNum;
-
-                RamDomain levelNum;
-                tuple >> levelNum;
+                RamDomain annotation;
+                tuple >> annotation;
 
-                return std::make_pair(ruleNum, levelNum);
+                return std::make_pair(provenanceRuleNumber(annotation), provenanceLevelNumber(annotation));
             }
         }
 
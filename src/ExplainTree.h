@@ -93,6 +93,9 @@ public:
         return height;
     }
 
+    // create a deep copy of the node and its sub-trees
+    virtual std::unique_ptr<TreeNode> clone() const = 0;
+
     // place the node
     virtual void place(uint32_t xpos, uint32_t ypos) = 0;
 
@@ -131,6 +134,16 @@ public:
         children.push_back(std::move(child));
     }
 
+    // copy node text, label and sub-trees
+    std::unique_ptr<TreeNode> clone() const override {
+        auto copy = std::make_unique<InnerNode>(txt, label);
+        copy->setSize(size);
+        for (const std::unique_ptr<TreeNode>& k : children) {
+            copy->add_child(k->clone());
+        }
+        return std::move(copy);
+    }
+
     // place node and its sub-trees
     void place(uint32_t x, uint32_t y) override {
         // there must exist at least one kid
@@ -198,6 +211,13 @@ class LeafNode : public TreeNode {
 public:
     LeafNode(const std::string& t = "") : TreeNode(t) {}
 
+    // copy leaf node
+    std::unique_ptr<TreeNode> clone() const override {
+        auto copy = std::make_unique<LeafNode>(txt);
+        copy->setSize(size);
+        return std::move(copy);
+    }
+
     // place leaf node
     void place(uint32_t x, uint32_t y) override {
         xpos = x;
@@ -16,6 +16,7 @@
 
 #pragma once
 
+#include <fstream>
 #include <iostream>
 #include <map>
 #include <string>
@@ -117,6 +118,40 @@ public:
     const std::string& help() const {
         return _help;
     }
+    /* Overlay the configuration with the entries of the given options file, so performance-relevant
+       settings can be tuned at run time without recompiling. Each line holds one 'key=value' pair or a
+       bare 'key'; blank lines and lines starting with '#' are ignored. Defined inline so compiled
+       programs can read overrides without linking Global.cpp. Returns whether the file could be opened. */
+    bool loadOverrides(const std::string& filename) {
+        std::ifstream in(filename);
+        if (!in.is_open()) {
+            return false;
+        }
+        std::string line;
+        while (std::getline(in, line)) {
+            const auto first = line.find_first_not_of(" \t\r");
+            if (first == std::string::npos || line[first] == '#') {
+                continue;
+            }
+            const auto last = line.find_last_not_of(" \t\r");
+            line = line.substr(first, last - first + 1);
+            const auto eq = line.find('=');
+            if (eq == std::string::npos) {
+                set(line);
+                continue;
+            }
+            std::string key = line.substr(0, eq);
+            std::string value = line.substr(eq + 1);
+            const auto keyEnd = key.find_last_not_of(" \t");
+            key = (keyEnd == std::string::npos) ? "" : key.substr(0, keyEnd + 1);
+            const auto valueBegin = value.find_first_not_of(" \t");
+            value = (valueBegin == std::string::npos) ? "" : value.substr(valueBegin);
+            if (!key.empty()) {
+                set(key, value);
+            }
+        }
+        return true;
+    }
 
 private:
     /* The help text, printed if there is an error in the command line arguments. */
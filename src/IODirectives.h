@@ -55,6 +55,10 @@ public:
         return directives.count(key) > 0;
     }
 
+    const std::map<std::string, std::string>& getDirectiveMap() const {
+        return directives;
+    }
+
     const std::string& getFileName() const {
         return get("filename");
     }
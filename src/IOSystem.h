@@ -16,9 +16,11 @@
 
 #include "IODirectives.h"
 #include "ReadStream.h"
+#include "ReadStreamBinary.h"
 #include "ReadStreamCSV.h"
 #include "SymbolTable.h"
 #include "WriteStream.h"
+#include "WriteStreamBinary.h"
 #include "WriteStreamCSV.h"
 
 #ifdef USE_SQLITE
@@ -74,8 +76,11 @@ public:
 private:
     IOSystem() {
         registerReadStreamFactory(std::make_shared<ReadFileCSVFactory>());
+        registerReadStreamFactory(std::make_shared<ReadFileCSVParallelFactory>());
         registerReadStreamFactory(std::make_shared<ReadCinCSVFactory>());
+        registerReadStreamFactory(std::make_shared<ReadFileBinaryFactory>());
         registerWriteStreamFactory(std::make_shared<WriteFileCSVFactory>());
+        registerWriteStreamFactory(std::make_shared<WriteFileBinaryFactory>());
         registerWriteStreamFactory(std::make_shared<WriteCoutCSVFactory>());
         registerWriteStreamFactory(std::make_shared<WriteCoutPrintSizeFactory>());
 #ifdef USE_SQLITE
@@ -16,8 +16,10 @@
 
 #include "AstArgument.h"
 #include "AstClause.h"
+#include "AstIOTypeAnalysis.h"
 #include "AstLiteral.h"
 #include "AstNode.h"
+#include "AstProfileUse.h"
 #include "AstProgram.h"
 #include "AstRelation.h"
 #include "AstRelationIdentifier.h"
@@ -26,6 +28,9 @@
 #include "AstVisitor.h"
 #include "BinaryConstraintOps.h"
 #include "FunctorOps.h"
+#include "Global.h"
+#include "PrecedenceGraph.h"
+#include "RelationRepresentation.h"
 #include "Util.h"
 #include <cassert>
 #include <cstddef>
@@ -952,10 +957,99 @@ std::vector<AstClause*> getInlinedClause(AstProgram& program, const AstClause& c
     }
 }
 
+// the largest profiled size and defining clause count up to which an
+// intermediate relation is considered cheap enough to inline automatically
+static const size_t AUTO_INLINE_MAX_SIZE = 1000;
+static const size_t AUTO_INLINE_MAX_CLAUSES = 4;
+
+/**
+ * Marks small single-use intermediate relations for inlining, extending the
+ * explicitly annotated set. A relation qualifies if it sits alone in a
+ * non-recursive stratum, feeds exactly one consumer, is not subject to IO,
+ * and stays clear of the constructs the inliner cannot handle (negation,
+ * aggregators, counter arguments). Sizes come from the profile of a previous
+ * run where available; the defining clause count bounds the clause blowup
+ * otherwise. Returns true if any relation was marked.
+ */
+bool markAutoInlineRelations(AstTranslationUnit& translationUnit) {
+    AstProgram& program = *translationUnit.getProgram();
+    auto* ioTypes = translationUnit.getAnalysis<IOType>();
+    auto* precedenceGraph = translationUnit.getAnalysis<PrecedenceGraph>();
+    auto* sccGraph = translationUnit.getAnalysis<SCCGraph>();
+    auto* profileUse = translationUnit.getAnalysis<AstProfileUse>();
+
+    // relations that appear negated, under an aggregator, or in an atom with
+    // a counter argument cannot be inlined safely
+    std::set<AstRelationIdentifier> excluded;
+    visitDepthFirst(program, [&](const AstNegation& neg) { excluded.insert(neg.getAtom()->getName()); });
+    visitDepthFirst(program, [&](const AstAggregator& aggr) {
+        visitDepthFirst(aggr, [&](const AstAtom& atom) { excluded.insert(atom.getName()); });
+    });
+    visitDepthFirst(program, [&](const AstAtom& atom) {
+        visitDepthFirst(atom, [&](const AstCounter& /* ctr */) { excluded.insert(atom.getName()); });
+    });
+
+    bool changed = false;
+    for (AstRelation* rel : program.getRelations()) {
+        if (rel->isInline() || rel->isOverridable() || rel->clauseSize() == 0) {
+            continue;
+        }
+        if (rel->getRepresentation() != RelationRepresentation::DEFAULT &&
+                rel->getRepresentation() != RelationRepresentation::BTREE) {
+            continue;
+        }
+        if (ioTypes->isIO(rel) || excluded.find(rel->getName()) != excluded.end()) {
+            continue;
+        }
+
+        // only relations alone in a non-recursive stratum can be inlined
+        // without creating cycles between inlined relations
+        const size_t scc = sccGraph->getSCC(rel);
+        if (sccGraph->isRecursive(scc) || sccGraph->getInternalRelations(scc).size() != 1) {
+            continue;
+        }
+
+        // glue relations feed exactly one consumer
+        const auto& consumers = precedenceGraph->graph().successors(rel);
+        if (consumers.size() != 1 || *consumers.begin() == rel) {
+            continue;
+        }
+
+        // keep materialized relations that are known or likely to be large
+        if (profileUse->hasRelationSize(rel->getName()) &&
+                profileUse->getRelationSize(rel->getName()) > AUTO_INLINE_MAX_SIZE) {
+            continue;
+        }
+        if (rel->clauseSize() > AUTO_INLINE_MAX_CLAUSES) {
+            continue;
+        }
+
+        // the defining clauses themselves must not use counter arguments
+        bool usesCounter = false;
+        for (const AstClause* clause : rel->getClauses()) {
+            visitDepthFirst(*clause, [&](const AstCounter& /* ctr */) { usesCounter = true; });
+        }
+        if (usesCounter) {
+            continue;
+        }
+
+        rel->setQualifier(rel->getQualifier() | INLINE_RELATION);
+        changed = true;
+    }
+    return changed;
+}
+
 bool InlineRelationsTransformer::transform(AstTranslationUnit& translationUnit) {
     bool changed = false;
     AstProgram& program = *translationUnit.getProgram();
 
+    // automatically extend the inlined set to small single-use intermediate
+    // relations when requested; provenance needs every relation materialized
+    // for explanation, so the automatic mode is disabled there
+    if (Global::config().has("auto-inline") && !Global::config().has("provenance")) {
+        changed |= markAutoInlineRelations(translationUnit);
+    }
+
     // Replace constants in the head of inlined clauses with (constrained) variables.
     // This is done to simplify atom unification, particularly when negations are involved.
     normaliseInlinedHeads(program);
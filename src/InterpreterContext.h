@@ -30,6 +30,10 @@ namespace souffle {
 
 /**
  * Evaluation context for Interpreter operations
+ *
+ * The context is a flat frame of tuple slots and view slots, sized once by
+ * the generator for the whole generated tree and reused across all query
+ * executions, so rule evaluation performs no per-execution allocation.
  */
 class InterpreterContext {
     using ViewPtr = std::unique_ptr<IndexView>;
@@ -42,24 +46,21 @@ class InterpreterContext {
     std::vector<bool>* returnErrors = nullptr;
     /** @brief Subroutine arguments */
     const std::vector<RamDomain>* args = nullptr;
-    /** @bref Allocated data */
-    std::vector<std::unique_ptr<RamDomain[]>> allocatedDataContainer;
     /** @brief Views */
     std::vector<std::unique_ptr<IndexView>> views;
 
 public:
-    InterpreterContext(size_t size = 0) : data(size) {}
+    InterpreterContext(size_t size = 0, size_t numViews = 0) : data(size), views(numViews) {}
 
     /** This constructor is used when program enter a new scope.
-     * Only Subroutine value needs to be copied */
+     * The frame is sized like the parent's; only subroutine state is shared. */
     InterpreterContext(InterpreterContext& ctxt)
-            : returnValues(ctxt.returnValues), returnErrors(ctxt.returnErrors), args(ctxt.args) {}
+            : data(ctxt.data.size()), returnValues(ctxt.returnValues), returnErrors(ctxt.returnErrors),
+              args(ctxt.args), views(ctxt.views.size()) {}
     virtual ~InterpreterContext() = default;
 
     const RamDomain*& operator[](size_t index) {
-        if (index >= data.size()) {
-            data.resize((index + 1));
-        }
+        assert(index < data.size() && "tuple slot out of range");
         return data[index];
     }
 
@@ -67,16 +68,6 @@ public:
         return data[index];
     }
 
-    /** @brief Allocate a tuple.
-     *  allocatedDataContainer has the ownership of those tuples. */
-    RamDomain* allocateNewTuple(size_t size) {
-        std::unique_ptr<RamDomain[]> newTuple(new RamDomain[size]);
-        allocatedDataContainer.push_back(std::move(newTuple));
-
-        // Return the reference as raw pointer.
-        return allocatedDataContainer.back().get();
-    }
-
     /** @brief Get subroutine return value */
     std::vector<RamDomain>& getReturnValues() const {
         return *returnValues;
@@ -122,10 +113,7 @@ public:
 
     /** @brief Create a view in the environment */
     void createView(const InterpreterRelation& rel, size_t indexPos, size_t viewPos) {
-        ViewPtr view;
-        if (views.size() < viewPos + 1) {
-            views.resize(viewPos + 1);
-        }
+        assert(viewPos < views.size() && "view slot out of range");
         views[viewPos] = rel.getView(indexPos);
     }
 
@@ -18,12 +18,22 @@
 #include "InterpreterGenerator.h"
 #include "InterpreterRecords.h"
 #include "Logger.h"
+#include "ParallelUtils.h"
 #include "SignalHandler.h"
 #include <cassert>
 #include <csignal>
+#include <fstream>
 #include <regex>
+#include <string_view>
+#include <unordered_set>
 #include <ffi.h>
 
+// Use the label-address extension for threaded dispatch where available
+// (gcc/clang); other compilers fall back to an ordinary switch statement.
+#if defined(__GNUC__) || defined(__clang__)
+#define USE_COMPUTED_GOTO 1
+#endif
+
 namespace souffle {
 
 void InterpreterEngine::createRelation(
@@ -35,10 +45,33 @@ void InterpreterEngine::createRelation(
     if (id.getRepresentation() == RelationRepresentation::EQREL) {
         res = std::make_unique<InterpreterEqRelation>(
                 id.getArity(), id.getName(), std::vector<std::string>(), orderSet);
+    } else if (id.getRepresentation() == RelationRepresentation::BITSET) {
+        res = std::make_unique<InterpreterBitsetRelation>(
+                id.getArity(), id.getName(), std::vector<std::string>(), orderSet);
+    } else if (id.getRepresentation() == RelationRepresentation::BRIE && !isProvenance &&
+               id.getArity() <= 12) {
+        // wider tuples exceed the arities the trie factory instantiates
+        // and keep the default b-tree representation instead
+        res = std::make_unique<InterpreterBrieRelation>(
+                id.getArity(), id.getName(), std::vector<std::string>(), orderSet);
+    } else if (id.getRepresentation() == RelationRepresentation::FUNCTIONAL) {
+        res = std::make_unique<InterpreterFunctionalRelation>(
+                id.getArity(), id.getName(), std::vector<std::string>(), orderSet);
+    } else if (id.getRepresentation() == RelationRepresentation::AUTO && !isProvenance) {
+        res = std::make_unique<InterpreterAutoRelation>(
+                id.getArity(), id.getName(), std::vector<std::string>(), orderSet);
     } else {
         if (isProvenance) {
-            res = std::make_unique<InterpreterRelation>(id.getArity(), id.getName(),
-                    std::vector<std::string>(), orderSet, createBTreeProvenanceIndex);
+            // relations never written by a rule carry constant annotation
+            // columns; the plain b-tree layout loads faster and still
+            // answers the data-column searches of explain queries
+            if (isInputOnlyRelation(id)) {
+                res = std::make_unique<InterpreterRelation>(
+                        id.getArity(), id.getName(), std::vector<std::string>(), orderSet);
+            } else {
+                res = std::make_unique<InterpreterRelation>(id.getArity(), id.getName(),
+                        std::vector<std::string>(), orderSet, createBTreeProvenanceIndex);
+            }
         } else {
             res = std::make_unique<InterpreterRelation>(
                     id.getArity(), id.getName(), std::vector<std::string>(), orderSet);
@@ -56,15 +89,508 @@ InterpreterEngine::RelationHandle& InterpreterEngine::getRelationHandle(const si
 }
 
 void InterpreterEngine::dropRelation(const size_t relId) {
+    if (relations[relId] != nullptr) {
+        joinPendingStore(relations[relId]->getName());
+    }
     relations[relId].reset(nullptr);
 }
 
 void InterpreterEngine::swapRelation(const size_t ramRel1, const size_t ramRel2) {
     RelationHandle& rel1 = getRelationHandle(ramRel1);
     RelationHandle& rel2 = getRelationHandle(ramRel2);
+    joinPendingStore(rel1->getName());
+    joinPendingStore(rel2->getName());
     std::swap(rel1, rel2);
 }
 
+void InterpreterEngine::buildLastStratumWrite() {
+    if (!lastStratumWriteValid) {
+        visitDepthFirst(*tUnit.getProgram()->getMain(), [&](const RamStratum& cur) {
+            const int index = cur.getIndex();
+            visitDepthFirst(cur, [&](const RamProject& project) {
+                lastStratumWrite[project.getRelation().getName()] = index;
+            });
+            visitDepthFirst(cur, [&](const RamMerge& merge) {
+                lastStratumWrite[merge.getTargetRelation().getName()] = index;
+            });
+            visitDepthFirst(cur, [&](const RamSwap& swap) {
+                lastStratumWrite[swap.getFirstRelation().getName()] = index;
+                lastStratumWrite[swap.getSecondRelation().getName()] = index;
+            });
+            visitDepthFirst(cur, [&](const RamClear& clear) {
+                lastStratumWrite[clear.getRelation().getName()] = index;
+            });
+            visitDepthFirst(cur, [&](const RamLoad& load) {
+                lastStratumWrite[load.getRelation().getName()] = index;
+            });
+            visitDepthFirst(cur, [&](const RamFact& fact) {
+                lastStratumWrite[fact.getRelation().getName()] = index;
+            });
+            visitDepthFirst(cur, [&](const RamFactTable& facts) {
+                lastStratumWrite[facts.getRelation().getName()] = index;
+            });
+        });
+        lastStratumWriteValid = true;
+    }
+}
+
+void InterpreterEngine::compactFinishedRelations(const int stratum) {
+    buildLastStratumWrite();
+    // compact all relations the completed stratum wrote last
+    for (auto& handle : relations) {
+        if (handle == nullptr) {
+            continue;
+        }
+        auto pos = lastStratumWrite.find(handle->getName());
+        if (pos != lastStratumWrite.end() && pos->second == stratum) {
+            joinPendingStore(handle->getName());
+            handle->compact();
+        }
+    }
+}
+
+void InterpreterEngine::restoreSnapshot() {
+    const std::string dir = Global::config().get("checkpoint-dir");
+    // the completed-strata manifest; a fresh directory resumes nothing
+    std::ifstream manifest(dir + "/completed");
+    int stratum;
+    while (manifest >> stratum) {
+        completedStrata.insert(stratum);
+    }
+    if (completedStrata.empty()) {
+        return;
+    }
+    // restore the symbol table first, in its original insertion order,
+    // such that symbol indices embedded in records remain valid
+    std::ifstream symbols(dir + "/symbols", std::ios::in | std::ios::binary);
+    uint64_t numSymbols = 0;
+    symbols.read(reinterpret_cast<char*>(&numSymbols), sizeof(numSymbols));
+    std::string symbol;
+    for (uint64_t i = 0; i < numSymbols; ++i) {
+        uint32_t length = 0;
+        symbols.read(reinterpret_cast<char*>(&length), sizeof(length));
+        symbol.resize(length);
+        symbols.read(&symbol[0], length);
+        getSymbolTable().lookup(symbol);
+    }
+    // restore the record maps, reproducing all reference values
+    std::ifstream records(dir + "/records", std::ios::in | std::ios::binary);
+    if (records.is_open()) {
+        restoreRecordMaps(records);
+    }
+}
+
+void InterpreterEngine::checkpointStratum(const RamStratum& stratum) {
+    const std::string dir = Global::config().get("checkpoint-dir");
+    buildLastStratumWrite();
+    const int index = stratum.getIndex();
+    // snapshot all relations this stratum wrote last; relations written
+    // by later strata are captured when those complete
+    for (auto& handle : relations) {
+        if (handle == nullptr) {
+            continue;
+        }
+        auto pos = lastStratumWrite.find(handle->getName());
+        if (pos == lastStratumWrite.end() || pos->second != index) {
+            continue;
+        }
+        const RamRelation* rel = tUnit.getProgram()->getRelation(handle->getName());
+        if (rel == nullptr) {
+            continue;
+        }
+        std::vector<bool> symbolMask;
+        for (auto& attribute : rel->getAttributeTypeQualifiers()) {
+            symbolMask.push_back(attribute[0] == 's');
+        }
+        IODirectives ioDirectives;
+        ioDirectives.setIOType("binary");
+        ioDirectives.setFileName(dir + "/" + handle->getName() + ".bin");
+        try {
+            IOSystem::getInstance()
+                    .getWriter(symbolMask, getSymbolTable(), ioDirectives,
+                            Global::config().has("provenance"))
+                    ->writeAll(*handle);
+        } catch (std::exception& e) {
+            std::cerr << "Error writing checkpoint: " << e.what() << "\n";
+            return;
+        }
+    }
+    // snapshot the symbol table and the record maps; both only grow, so
+    // rewriting them after each stratum captures a consistent superset
+    {
+        std::ofstream symbols(dir + "/symbols", std::ios::out | std::ios::binary);
+        uint64_t numSymbols = getSymbolTable().size();
+        symbols.write(reinterpret_cast<const char*>(&numSymbols), sizeof(numSymbols));
+        for (uint64_t i = 0; i < numSymbols; ++i) {
+            std::string_view symbol = getSymbolTable().resolve(i);
+            uint32_t length = symbol.size();
+            symbols.write(reinterpret_cast<const char*>(&length), sizeof(length));
+            symbols.write(symbol.data(), length);
+        }
+    }
+    {
+        std::ofstream records(dir + "/records", std::ios::out | std::ios::binary);
+        saveRecordMaps(records);
+    }
+    // mark the stratum completed only after all its data has been written
+    std::ofstream manifest(dir + "/completed", std::ios::out | std::ios::app);
+    manifest << index << "\n";
+}
+
+void InterpreterEngine::replayStratum(const RamStratum& stratum) {
+    buildLastStratumWrite();
+    // relations dropped within the stratum never outlive it
+    std::set<std::string> dropped;
+    visitDepthFirst(stratum, [&](const RamDrop& drop) { dropped.insert(drop.getRelation().getName()); });
+    // re-create the relations the stratum would have created
+    visitDepthFirst(stratum, [&](const RamCreate& create) {
+        const RamRelation& rel = create.getRelation();
+        if (dropped.find(rel.getName()) != dropped.end()) {
+            return;
+        }
+        createRelation(rel, isa->getIndexes(rel), generator.getRelationId(rel));
+    });
+    // re-populate the relations this stratum wrote last from the snapshot
+    const std::string dir = Global::config().get("checkpoint-dir");
+    const int index = stratum.getIndex();
+    for (auto& handle : relations) {
+        if (handle == nullptr) {
+            continue;
+        }
+        auto pos = lastStratumWrite.find(handle->getName());
+        if (pos == lastStratumWrite.end() || pos->second != index) {
+            continue;
+        }
+        const RamRelation* rel = tUnit.getProgram()->getRelation(handle->getName());
+        if (rel == nullptr || !existFile(dir + "/" + handle->getName() + ".bin")) {
+            continue;
+        }
+        std::vector<bool> symbolMask;
+        for (auto& attribute : rel->getAttributeTypeQualifiers()) {
+            symbolMask.push_back(attribute[0] == 's');
+        }
+        IODirectives ioDirectives;
+        ioDirectives.setIOType("binary");
+        ioDirectives.setFileName(dir + "/" + handle->getName() + ".bin");
+        try {
+            IOSystem::getInstance()
+                    .getReader(symbolMask, getSymbolTable(), ioDirectives,
+                            Global::config().has("provenance"))
+                    ->readAll(*handle);
+        } catch (std::exception& e) {
+            std::cerr << "Error reading checkpoint: " << e.what() << "\n";
+        }
+    }
+}
+
+bool InterpreterEngine::isMemoizableStratum(const RamStratum& stratum) {
+    // memoization must be unobservable: provenance and profiling inspect
+    // the evaluation itself, loads and stores touch files, and an exit
+    // may cut the whole evaluation short
+    if (isProvenance || profileEnabled) {
+        return false;
+    }
+    bool pure = true;
+    visitDepthFirst(stratum, [&](const RamLoad&) { pure = false; });
+    visitDepthFirst(stratum, [&](const RamStore&) { pure = false; });
+    visitDepthFirst(stratum, [&](const RamExit&) { pure = false; });
+    if (!pure) {
+        return false;
+    }
+    // record references are table-relative and not remapped by the binary
+    // format; only number and symbol columns survive a run boundary
+    bool simpleTypes = true;
+    visitDepthFirst(stratum, [&](const RamRelationReference& ref) {
+        for (auto& attribute : ref.get()->getAttributeTypeQualifiers()) {
+            if (attribute[0] != 'i' && attribute[0] != 's') {
+                simpleTypes = false;
+            }
+        }
+    });
+    if (!simpleTypes) {
+        return false;
+    }
+    // every relation the stratum writes must receive its final content
+    // here or be dropped before the stratum ends; otherwise a later
+    // writer would miss this stratum's contribution on a hit
+    buildLastStratumWrite();
+    std::set<std::string> dropped;
+    visitDepthFirst(stratum, [&](const RamDrop& drop) { dropped.insert(drop.getRelation().getName()); });
+    const int index = stratum.getIndex();
+    bool finalWrites = true;
+    auto checkWrite = [&](const std::string& name) {
+        if (dropped.find(name) != dropped.end()) {
+            return;
+        }
+        auto pos = lastStratumWrite.find(name);
+        if (pos == lastStratumWrite.end() || pos->second != index) {
+            finalWrites = false;
+        }
+    };
+    visitDepthFirst(stratum, [&](const RamProject& project) { checkWrite(project.getRelation().getName()); });
+    visitDepthFirst(stratum, [&](const RamMerge& merge) { checkWrite(merge.getTargetRelation().getName()); });
+    visitDepthFirst(stratum, [&](const RamSwap& swap) {
+        checkWrite(swap.getFirstRelation().getName());
+        checkWrite(swap.getSecondRelation().getName());
+    });
+    visitDepthFirst(stratum, [&](const RamClear& clear) { checkWrite(clear.getRelation().getName()); });
+    visitDepthFirst(stratum, [&](const RamFact& fact) { checkWrite(fact.getRelation().getName()); });
+    visitDepthFirst(stratum, [&](const RamFactTable& facts) { checkWrite(facts.getRelation().getName()); });
+    return finalWrites;
+}
+
+uint64_t InterpreterEngine::memoKey(const RamStratum& stratum) {
+    const uint64_t base = 14695981039346656037ull;
+    const uint64_t prime = 1099511628211ull;
+    uint64_t h = base;
+    auto mixBytes = [&](const void* data, size_t size) {
+        const auto* bytes = static_cast<const unsigned char*>(data);
+        for (size_t i = 0; i < size; ++i) {
+            h = (h ^ bytes[i]) * prime;
+        }
+    };
+    auto mixString = [&](const std::string& str) {
+        uint64_t length = str.size();
+        mixBytes(&length, sizeof(length));
+        mixBytes(str.data(), str.size());
+    };
+    // the stratum's program text keys the computation itself
+    std::stringstream ram;
+    ram << stratum;
+    mixString(ram.str());
+    // relations created inside the stratum start empty; every other
+    // referenced relation is an input whose content shapes the result
+    std::set<std::string> created;
+    visitDepthFirst(
+            stratum, [&](const RamCreate& create) { created.insert(create.getRelation().getName()); });
+    std::set<std::string> referenced;
+    visitDepthFirst(stratum, [&](const RamRelationReference& ref) { referenced.insert(ref.get()->getName()); });
+    for (const auto& name : referenced) {
+        if (created.find(name) != created.end()) {
+            continue;
+        }
+        const RamRelation* rel = tUnit.getProgram()->getRelation(name);
+        const InterpreterRelation* input = nullptr;
+        for (auto& handle : relations) {
+            if (handle != nullptr && handle->getName() == name) {
+                input = handle.get();
+                break;
+            }
+        }
+        mixString(name);
+        if (rel == nullptr || input == nullptr) {
+            continue;
+        }
+        uint64_t size = input->size();
+        mixBytes(&size, sizeof(size));
+        std::vector<bool> symbolMask;
+        for (auto& attribute : rel->getAttributeTypeQualifiers()) {
+            symbolMask.push_back(attribute[0] == 's');
+        }
+        // symbol indices differ between runs, so symbol columns are hashed
+        // by content; tuples are combined commutatively, making the digest
+        // independent of the resulting iteration order as well
+        uint64_t digest = 0;
+        const size_t arity = input->getArity();
+        for (const RamDomain* tuple : *input) {
+            uint64_t th = base;
+            for (size_t col = 0; col < arity; ++col) {
+                if (symbolMask[col]) {
+                    std::string_view symbol = getSymbolTable().resolve(tuple[col]);
+                    for (char c : symbol) {
+                        th = (th ^ static_cast<unsigned char>(c)) * prime;
+                    }
+                    th = (th ^ 0xff) * prime;
+                } else {
+                    for (size_t i = 0; i < sizeof(RamDomain); ++i) {
+                        th = (th ^ ((static_cast<uint64_t>(tuple[col]) >> (i * 8)) & 0xff)) * prime;
+                    }
+                }
+            }
+            digest += th;
+        }
+        mixBytes(&digest, sizeof(digest));
+    }
+    return h;
+}
+
+bool InterpreterEngine::reuseMemoizedStratum(const RamStratum& stratum, uint64_t key) {
+    std::stringstream name;
+    name << Global::config().get("memo-dir") << "/" << std::hex << key;
+    const std::string prefix = name.str();
+    // the marker is written last; without it the entry is incomplete
+    if (!existFile(prefix + ".ok")) {
+        return false;
+    }
+    buildLastStratumWrite();
+    const int index = stratum.getIndex();
+    // relations dropped within the stratum never outlive it
+    std::set<std::string> dropped;
+    visitDepthFirst(stratum, [&](const RamDrop& drop) { dropped.insert(drop.getRelation().getName()); });
+    // all output files must be present before any relation is touched
+    std::vector<const RamRelation*> outputs;
+    for (const auto& entry : lastStratumWrite) {
+        if (entry.second != index || dropped.find(entry.first) != dropped.end()) {
+            continue;
+        }
+        const RamRelation* rel = tUnit.getProgram()->getRelation(entry.first);
+        if (rel == nullptr || !existFile(prefix + "." + entry.first + ".bin")) {
+            return false;
+        }
+        outputs.push_back(rel);
+    }
+    // create the relations the stratum would have created
+    visitDepthFirst(stratum, [&](const RamCreate& create) {
+        const RamRelation& rel = create.getRelation();
+        if (dropped.find(rel.getName()) != dropped.end()) {
+            return;
+        }
+        createRelation(rel, isa->getIndexes(rel), generator.getRelationId(rel));
+    });
+    // populate the outputs from the memo entry; a failure part-way
+    // through leaves them purged so normal evaluation starts clean
+    for (const RamRelation* rel : outputs) {
+        InterpreterRelation* output = nullptr;
+        for (auto& handle : relations) {
+            if (handle != nullptr && handle->getName() == rel->getName()) {
+                output = handle.get();
+                break;
+            }
+        }
+        std::vector<bool> symbolMask;
+        for (auto& attribute : rel->getAttributeTypeQualifiers()) {
+            symbolMask.push_back(attribute[0] == 's');
+        }
+        IODirectives ioDirectives;
+        ioDirectives.setIOType("binary");
+        ioDirectives.setFileName(prefix + "." + rel->getName() + ".bin");
+        bool failed = output == nullptr;
+        if (!failed) {
+            try {
+                IOSystem::getInstance()
+                        .getReader(symbolMask, getSymbolTable(), ioDirectives,
+                                Global::config().has("provenance"))
+                        ->readAll(*output);
+            } catch (std::exception& e) {
+                std::cerr << "Error reading memo entry: " << e.what() << "\n";
+                failed = true;
+            }
+        }
+        if (failed) {
+            for (auto& handle : relations) {
+                if (handle == nullptr) {
+                    continue;
+                }
+                auto pos = lastStratumWrite.find(handle->getName());
+                if (pos != lastStratumWrite.end() && pos->second == index) {
+                    handle->purge();
+                }
+            }
+            return false;
+        }
+    }
+    return true;
+}
+
+void InterpreterEngine::memoizeStratum(const RamStratum& stratum, uint64_t key) {
+    std::stringstream name;
+    name << Global::config().get("memo-dir") << "/" << std::hex << key;
+    const std::string prefix = name.str();
+    buildLastStratumWrite();
+    const int index = stratum.getIndex();
+    // store all relations this stratum wrote last; relations it dropped
+    // have no handle anymore and are of no use to a later run anyway
+    for (auto& handle : relations) {
+        if (handle == nullptr) {
+            continue;
+        }
+        auto pos = lastStratumWrite.find(handle->getName());
+        if (pos == lastStratumWrite.end() || pos->second != index) {
+            continue;
+        }
+        const RamRelation* rel = tUnit.getProgram()->getRelation(handle->getName());
+        if (rel == nullptr) {
+            continue;
+        }
+        std::vector<bool> symbolMask;
+        for (auto& attribute : rel->getAttributeTypeQualifiers()) {
+            symbolMask.push_back(attribute[0] == 's');
+        }
+        IODirectives ioDirectives;
+        ioDirectives.setIOType("binary");
+        ioDirectives.setFileName(prefix + "." + handle->getName() + ".bin");
+        try {
+            IOSystem::getInstance()
+                    .getWriter(symbolMask, getSymbolTable(), ioDirectives,
+                            Global::config().has("provenance"))
+                    ->writeAll(*handle);
+        } catch (std::exception& e) {
+            std::cerr << "Error writing memo entry: " << e.what() << "\n";
+            return;
+        }
+    }
+    // mark the entry complete only after all its outputs are on disk
+    std::ofstream marker(prefix + ".ok");
+    marker << index << "\n";
+}
+
+void InterpreterEngine::dumpRelationStatistics(const std::string& filename) {
+    std::ofstream out(filename);
+    if (!out) {
+        std::cerr << "Error opening statistics file " << filename << "\n";
+        return;
+    }
+    // a version header so later readers can reject stale catalogs
+    out << "souffle-stats\t1\n";
+    for (auto& handle : relations) {
+        if (handle == nullptr || handle->getName()[0] == '@') {
+            continue;
+        }
+        const size_t arity = handle->getArity();
+        out << "relation\t" << handle->getName() << "\t" << arity << "\t" << handle->size() << "\n";
+        // per-column distinct counts; the relation is materialized anyway,
+        // so they are counted exactly in a single scan
+        std::vector<std::unordered_set<RamDomain>> distinct(arity);
+        for (const RamDomain* tuple : *handle) {
+            for (size_t i = 0; i < arity; ++i) {
+                distinct[i].insert(tuple[i]);
+            }
+        }
+        for (size_t i = 0; i < arity; ++i) {
+            out << "column\t" << handle->getName() << "\t" << i << "\t" << distinct[i].size() << "\n";
+        }
+        for (size_t i = 0; i < handle->getNumIndexes(); ++i) {
+            std::stringstream order;
+            for (auto column : handle->getIndexOrder(i).getOrder()) {
+                order << (order.tellp() == 0 ? "" : "-") << column;
+            }
+            out << "index\t" << handle->getName() << "\t" << order.str() << "\t"
+                << handle->getIndexHits(i) << "\n";
+        }
+    }
+}
+
+void InterpreterEngine::emitStructureStats(const InterpreterRelation& rel, int stratumIndex) {
+    auto& profiler = ProfileEventSingleton::instance();
+    for (size_t i = 0; i < rel.getNumIndexes(); ++i) {
+        std::stringstream order;
+        for (auto column : rel.getIndexOrder(i).getOrder()) {
+            order << (order.tellp() == 0 ? "" : "-") << column;
+        }
+        const StructureStats stats = rel.getIndexStats(i);
+        const std::string prefix = "@index-stats;" + rel.getName() + ";" + order.str() + ";";
+        profiler.makeQuantityEvent(prefix + "elements", stats.elements, stratumIndex);
+        profiler.makeQuantityEvent(prefix + "nodes", stats.nodes, stratumIndex);
+        profiler.makeQuantityEvent(prefix + "depth", stats.depth, stratumIndex);
+        if (stats.nodes != 0 && stats.nodeCapacity != 0) {
+            profiler.makeQuantityEvent(prefix + "fill",
+                    100 * stats.elements / (stats.nodes * stats.nodeCapacity), stratumIndex);
+        }
+        profiler.makeQuantityEvent(prefix + "memory", stats.memory, stratumIndex);
+        profiler.makeQuantityEvent(prefix + "hits", rel.getIndexHits(i), stratumIndex);
+    }
+}
+
 int InterpreterEngine::incCounter() {
     return counter++;
 }
@@ -88,6 +614,43 @@ void* InterpreterEngine::getMethodHandle(const std::string& method) {
     return nullptr;
 }
 
+void InterpreterEngine::resolveFunctorCalls() {
+    if (functorCallsResolved) {
+        return;
+    }
+    functorCallsResolved = true;
+    // resolve every user-defined operator of the program once, ahead of
+    // evaluation; looking the symbol up and preparing the call interface
+    // per evaluated tuple costs more than the call itself for small
+    // functors, and an up-front pass keeps the evaluation path lock-free
+    visitDepthFirst(*tUnit.getProgram(), [&](const RamUserDefinedOperator& op) {
+        auto& entry = functorCalls[&op];
+        if (entry != nullptr) {
+            return;
+        }
+        const std::string& name = op.getName();
+        const std::string& type = op.getType();
+        const size_t arity = op.getArgCount();
+        entry = std::make_unique<FunctorCall>();
+        entry->fn = reinterpret_cast<void (*)()>(getMethodHandle(name));
+        if (entry->fn == nullptr) {
+            std::cerr << "Cannot find user-defined operator " << name << std::endl;
+            exit(1);
+        }
+        entry->argTypes.resize(arity);
+        for (size_t i = 0; i < arity; i++) {
+            entry->argTypes[i] = (type[i] == 'S') ? &ffi_type_pointer : &ffi_type_uint32;
+        }
+        ffi_type* returnType = (type[arity] == 'N') ? &ffi_type_uint32 : &ffi_type_pointer;
+        if (ffi_prep_cif(&entry->cif, FFI_DEFAULT_ABI, arity, returnType, entry->argTypes.data()) !=
+                FFI_OK) {
+            std::cerr << "Failed to prepare CIF for user-defined operator ";
+            std::cerr << name << std::endl;
+            exit(1);
+        }
+    });
+}
+
 std::vector<InterpreterEngine::RelationHandle>& InterpreterEngine::getRelationMap() {
     return relations;
 }
@@ -146,6 +709,320 @@ void InterpreterEngine::resetIterationNumber() {
     iteration = 0;
 }
 
+bool InterpreterEngine::planExpired() {
+    if (std::chrono::steady_clock::now() >= planDeadline) {
+        planAborted = true;
+    }
+    return planAborted;
+}
+
+bool InterpreterEngine::isInputOnlyRelation(const RamRelation& rel) {
+    if (!ruleWrittenComputed) {
+        const RamProgram& prog = *tUnit.getProgram();
+        visitDepthFirst(prog, [&](const RamProject& project) {
+            ruleWrittenRelations.insert(project.getRelation().getName());
+        });
+        visitDepthFirst(prog, [&](const RamMerge& merge) {
+            ruleWrittenRelations.insert(merge.getTargetRelation().getName());
+        });
+        visitDepthFirst(prog, [&](const RamSwap& swap) {
+            ruleWrittenRelations.insert(swap.getFirstRelation().getName());
+            ruleWrittenRelations.insert(swap.getSecondRelation().getName());
+        });
+        ruleWrittenComputed = true;
+    }
+    return ruleWrittenRelations.find(rel.getName()) == ruleWrittenRelations.end();
+}
+
+size_t InterpreterEngine::chooseStratumThreads(const RamStratum& stratum) {
+    // tuples per additional thread; below this, thread startup and the
+    // barriers of the parallel loops cost more than the parallelism gains
+    const size_t threadGrain = 10000;
+
+    // freshly loaded input is not measurable before the stratum runs;
+    // assume there is enough work for the full team
+    bool hasLoad = false;
+    visitDepthFirst(stratum, [&](const RamLoad& /*load*/) { hasLoad = true; });
+    if (hasLoad) {
+        return numOfThreads;
+    }
+
+    // sum the tuples available as input; relations the stratum creates
+    // itself are not yet populated and count as empty
+    size_t workload = 0;
+    std::set<const RamRelation*> seen;
+    visitDepthFirst(stratum, [&](const RamRelationReference& ref) {
+        const RamRelation* rel = ref.get();
+        if (!seen.insert(rel).second) {
+            return;
+        }
+        size_t idx = generator.getRelationId(*rel);
+        if (idx < relations.size() && relations[idx] != nullptr) {
+            workload += relations[idx]->size();
+        }
+    });
+    // tuples parked for a streamed scan never materialize in their
+    // relation; count them from the buffer instead
+    visitDepthFirst(stratum, [&](const RamScan& scan) {
+        auto streamed = streamedBuffers.find(scan.getRelation().getName());
+        if (streamed != streamedBuffers.end()) {
+            const size_t width = scan.getRelation().getAttributeTypeQualifiers().size();
+            workload += streamed->second.size() / width;
+        }
+    });
+    return std::min(workload / threadGrain + 1, numOfThreads);
+}
+
+void InterpreterEngine::prefetchLoads() {
+    // symbols below this count keep their ordinals under --stable-ordinals
+    preloadSymbolCount = getSymbolTable().size();
+    visitDepthFirst(*tUnit.getProgram()->getMain(), [&](const RamStratum& stratum) {
+        // strata replayed from a resumed snapshot skip their loads
+        if (completedStrata.find(stratum.getIndex()) != completedStrata.end()) {
+            return;
+        }
+        visitDepthFirst(stratum, [&](const RamLoad& load) {
+            // nullary relations carry no tuple data worth staging
+            if (load.getRelation().getAttributeTypeQualifiers().empty()) {
+                return;
+            }
+            stagedLoads[&load] = std::async(std::launch::async, [this, &load]() {
+                StagedTuples result{true, {}};
+                for (IODirectives ioDirectives : load.getIODirectives()) {
+                    try {
+                        std::vector<bool> symbolMask;
+                        for (auto& cur : load.getRelation().getAttributeTypeQualifiers()) {
+                            symbolMask.push_back(cur[0] == 's');
+                        }
+                        auto reader = IOSystem::getInstance().getReader(symbolMask, getSymbolTable(),
+                                ioDirectives, Global::config().has("provenance"));
+                        if (!reader->readAllInto(result.second)) {
+                            // the stream cannot parse concurrently with
+                            // evaluation; leave the whole load to the
+                            // synchronous path
+                            result.first = false;
+                            return result;
+                        }
+                    } catch (std::exception& e) {
+                        std::cerr << "Error loading data: " << e.what() << "\n";
+                    }
+                }
+                return result;
+            });
+        });
+    });
+}
+
+void InterpreterEngine::renumberStagedSymbols() {
+    // wait for every staged parse, visiting the load statements in program
+    // order -- the order a sequential run consumes them; the symbol table is
+    // quiescent once all parses joined
+    std::vector<std::pair<const RamLoad*, StagedTuples>> ordered;
+    visitDepthFirst(*tUnit.getProgram()->getMain(), [&](const RamLoad& load) {
+        auto staged = stagedLoads.find(&load);
+        if (staged != stagedLoads.end()) {
+            ordered.emplace_back(&load, staged->second.get());
+        }
+    });
+
+    // symbols known before loading keep their ordinals; symbols introduced by
+    // the staged parses are renumbered by first appearance in program and
+    // tuple order, which is exactly the assignment a sequential load produces
+    const size_t baseline = preloadSymbolCount;
+    const size_t total = getSymbolTable().size();
+    const size_t unassigned = total;
+    std::vector<size_t> mapping(total, unassigned);
+    for (size_t i = 0; i < baseline; ++i) {
+        mapping[i] = i;
+    }
+    size_t next = baseline;
+    for (auto& cur : ordered) {
+        if (!cur.second.first) {
+            continue;
+        }
+        const auto& qualifiers = cur.first->getRelation().getAttributeTypeQualifiers();
+        const size_t width = qualifiers.size();
+        std::vector<size_t> symbolColumns;
+        for (size_t col = 0; col < width; ++col) {
+            if (qualifiers[col][0] == 's') {
+                symbolColumns.push_back(col);
+            }
+        }
+        if (symbolColumns.empty()) {
+            continue;
+        }
+        auto& tuples = cur.second.second;
+        const size_t count = tuples.size() / width;
+        for (size_t row = 0; row < count; ++row) {
+            for (const size_t col : symbolColumns) {
+                auto& value = tuples[row * width + col];
+                const auto old = static_cast<size_t>(value);
+                if (mapping[old] == unassigned) {
+                    mapping[old] = next++;
+                }
+                value = static_cast<RamDomain>(mapping[old]);
+            }
+        }
+    }
+    // symbols of loads that failed to stage -- and re-parse on the synchronous
+    // path later -- keep their relative order behind the staged ones
+    for (size_t i = baseline; i < total; ++i) {
+        if (mapping[i] == unassigned) {
+            mapping[i] = next++;
+        }
+    }
+    getSymbolTable().rearrange(mapping);
+
+    // hand the rewritten buffers back to the load statements as ready futures
+    for (auto& cur : ordered) {
+        std::promise<StagedTuples> ready;
+        ready.set_value(std::move(cur.second));
+        stagedLoads[cur.first] = ready.get_future();
+    }
+}
+
+void InterpreterEngine::identifyStreamedLoads() {
+    // a streamed relation stays empty, which a resumed snapshot would
+    // replay and a memo key would hash; both need the tuples materialized
+    if (Global::config().has("checkpoint-dir") || Global::config().has("memo-dir")) {
+        return;
+    }
+    // provenance adds annotation columns and subroutines probing the relations
+    if (isProvenance) {
+        return;
+    }
+    const RamProgram& program = *tUnit.getProgram();
+    const RamStatement& main = *program.getMain();
+
+    // classify every reference to a relation: its loads, the full scans
+    // reading it, and any other use, which keeps the relation materialized
+    struct RelationUses {
+        std::vector<const RamLoad*> loads;
+        std::vector<const RamScan*> scans;
+        bool other = false;
+    };
+    std::map<std::string, RelationUses> uses;
+    visitDepthFirst(main, [&](const RamRelationStatement& stmt) {
+        const std::string& name = stmt.getRelation().getName();
+        if (const auto* load = dynamic_cast<const RamLoad*>(&stmt)) {
+            uses[name].loads.push_back(load);
+        } else if (dynamic_cast<const RamCreate*>(&stmt) == nullptr &&
+                   dynamic_cast<const RamDrop*>(&stmt) == nullptr) {
+            // stores, clears, facts, log sizes, ... observe the content
+            uses[name].other = true;
+        }
+    });
+    visitDepthFirst(main, [&](const RamBinRelationStatement& stmt) {
+        uses[stmt.getFirstRelation().getName()].other = true;
+        uses[stmt.getSecondRelation().getName()].other = true;
+    });
+    visitDepthFirst(main, [&](const RamRelationOperation& op) {
+        const std::string& name = op.getRelation().getName();
+        if (const auto* scan = dynamic_cast<const RamScan*>(&op)) {
+            uses[name].scans.push_back(scan);
+        } else {
+            // index operations, choices and aggregates probe the indexes
+            uses[name].other = true;
+        }
+    });
+    visitDepthFirst(main, [&](const RamAbstractExistenceCheck& check) {
+        uses[check.getRelation().getName()].other = true;
+    });
+    visitDepthFirst(main, [&](const RamEmptinessCheck& check) {
+        uses[check.getRelation().getName()].other = true;
+    });
+    visitDepthFirst(main, [&](const RamProject& project) {
+        uses[project.getRelation().getName()].other = true;
+    });
+    for (const auto& subroutine : program.getSubroutines()) {
+        visitDepthFirst(*subroutine.second, [&](const RamRelationReference& ref) {
+            uses[ref.get()->getName()].other = true;
+        });
+    }
+
+    // a scan consumes the staged tuples exactly once if it is the outer
+    // loop of a query executed once: the query has no alternative plans
+    // the watchdog could restart it with, and neither statement sits in a
+    // loop or in a branch of a parallel section racing against the other.
+    // counters are evaluated per scanned tuple, so a body drawing from one
+    // must see the relation deduplicated, and a break makes the result
+    // depend on the iteration order; both disqualify their query, since
+    // the staged buffer holds the raw file rows in file order
+    std::map<const RamScan*, const RamQuery*> rootScans;
+    visitDepthFirst(main, [&](const RamQuery& query) {
+        if (!query.getAlternatives().empty()) {
+            return;
+        }
+        bool orderSensitive = false;
+        visitDepthFirst(query, [&](const RamAutoIncrement& /*counter*/) { orderSensitive = true; });
+        visitDepthFirst(query, [&](const RamBreak& /*break*/) { orderSensitive = true; });
+        if (orderSensitive) {
+            return;
+        }
+        const RamOperation* root = &query.getOperation();
+        if (const auto* filter = dynamic_cast<const RamFilter*>(root)) {
+            root = &filter->getOperation();
+        }
+        if (const auto* scan = dynamic_cast<const RamScan*>(root)) {
+            rootScans[scan] = &query;
+        }
+    });
+    std::set<const RamNode*> repeated;
+    visitDepthFirst(main, [&](const RamLoop& loop) {
+        visitDepthFirst(loop, [&](const RamLoad& load) { repeated.insert(&load); });
+        visitDepthFirst(loop, [&](const RamQuery& query) { repeated.insert(&query); });
+    });
+    visitDepthFirst(main, [&](const RamParallel& parallel) {
+        visitDepthFirst(parallel, [&](const RamLoad& load) { repeated.insert(&load); });
+        visitDepthFirst(parallel, [&](const RamQuery& query) { repeated.insert(&query); });
+    });
+
+    // the depth-first traversal visits the remaining, strictly sequential
+    // statements in execution order
+    std::map<const RamNode*, size_t> order;
+    size_t position = 0;
+    visitDepthFirst(main, [&](const RamNode& node) { order[&node] = position++; });
+
+    for (const auto& entry : uses) {
+        const RelationUses& use = entry.second;
+        if (use.other || use.loads.size() != 1 || use.scans.size() != 1) {
+            continue;
+        }
+        const RamLoad* load = use.loads.front();
+        const RamScan* scan = use.scans.front();
+        // nullary relations carry no tuple data worth parking
+        if (load->getRelation().getAttributeTypeQualifiers().empty()) {
+            continue;
+        }
+        auto query = rootScans.find(scan);
+        if (query == rootScans.end()) {
+            continue;
+        }
+        if (repeated.count(load) != 0 || repeated.count(query->second) != 0) {
+            continue;
+        }
+        if (order[load] > order[query->second]) {
+            continue;
+        }
+        streamedLoads.insert(load);
+    }
+}
+
+void InterpreterEngine::joinPendingStore(const std::string& relName) {
+    auto pos = pendingStores.find(relName);
+    if (pos != pendingStores.end()) {
+        pos->second.wait();
+        pendingStores.erase(pos);
+    }
+}
+
+void InterpreterEngine::joinPendingStores() {
+    for (auto& cur : pendingStores) {
+        cur.second.wait();
+    }
+    pendingStores.clear();
+}
+
 void InterpreterEngine::executeMain() {
     SignalHandler::instance()->set();
     if (Global::config().has("verbose")) {
@@ -153,12 +1030,33 @@ void InterpreterEngine::executeMain() {
     }
     auto* program = tUnit.getProgram()->getMain();
     auto entry = generator.generateTree(*program);
-    InterpreterContext ctxt;
+    SignalHandler::instance()->setProgressSlots(generator.getNumDebugStatements());
+    resolveFunctorCalls();
+    if (Global::config().has("resume")) {
+        restoreSnapshot();
+    }
+    identifyStreamedLoads();
+    if (Global::config().has("pipeline-load")) {
+        prefetchLoads();
+        // reproducible runs renumber the concurrently assigned ordinals
+        // before evaluation begins
+        if (Global::config().has("stable-ordinals")) {
+            renumberStagedSymbols();
+        }
+    }
+    if (Global::config().has("profile-sampling")) {
+        ProfileEventSingleton::instance().setOutputFile(Global::config().get("profile-sampling"));
+        ProfileEventSingleton::instance().startSampler();
+    }
+    // one flat frame, sized by the generator, reused across all queries
+    InterpreterContext ctxt(generator.getFrameSize(), generator.getMaxViews());
     if (!profileEnabled) {
-        InterpreterContext ctxt;
         execute(entry.get(), ctxt);
     } else {
         ProfileEventSingleton::instance().setOutputFile(Global::config().get("profile"));
+        if (Global::config().has("profile-binary") && !Global::config().has("live-profile")) {
+            ProfileEventSingleton::instance().enableStreaming();
+        }
         // Prepare the frequency table for threaded use
         visitDepthFirst(*program, [&](const RamTupleOperation& node) {
             if (!node.getProfileText().empty()) {
@@ -188,7 +1086,6 @@ void InterpreterEngine::executeMain() {
         visitDepthFirst(*program, [&](const RamQuery& rule) { ++ruleCount; });
         ProfileEventSingleton::instance().makeConfigRecord("ruleCount", std::to_string(ruleCount));
 
-        InterpreterContext ctxt;
         execute(entry.get(), ctxt);
         ProfileEventSingleton::instance().stopTimer();
         for (auto const& cur : frequencies) {
@@ -200,23 +1097,154 @@ void InterpreterEngine::executeMain() {
             ProfileEventSingleton::instance().makeQuantityEvent(
                     "@relation-reads;" + cur.first, cur.second, 0);
         }
+        // record how often each index was consulted; indexes that were
+        // never hit are candidates for being dropped
+        for (auto& handle : relations) {
+            if (handle == nullptr || handle->getName()[0] == '@') {
+                continue;
+            }
+            for (size_t i = 0; i < handle->getNumIndexes(); ++i) {
+                std::stringstream order;
+                for (auto column : handle->getIndexOrder(i).getOrder()) {
+                    order << (order.tellp() == 0 ? "" : "-") << column;
+                }
+                ProfileEventSingleton::instance().makeQuantityEvent(
+                        "@index-hits;" + handle->getName() + ";" + order.str(), handle->getIndexHits(i), 0);
+            }
+        }
+    }
+    if (Global::config().has("profile-sampling")) {
+        ProfileEventSingleton::instance().stopSampler();
+    }
+    if (Global::config().has("stats-file")) {
+        dumpRelationStatistics(Global::config().get("stats-file"));
     }
+    joinPendingStores();
     SignalHandler::instance()->reset();
 }
 void InterpreterEngine::executeSubroutine(const std::string& name, const std::vector<RamDomain>& args,
         std::vector<RamDomain>& ret, std::vector<bool>& err) {
-    InterpreterContext ctxt;
+    std::lock_guard<std::mutex> guard(subroutineMutex);
+    auto entry = generator.generateTree(tUnit.getProgram()->getSubroutine(name));
+    SignalHandler::instance()->setProgressSlots(generator.getNumDebugStatements());
+    resolveFunctorCalls();
+
+    InterpreterContext ctxt(generator.getFrameSize(), generator.getMaxViews());
     ctxt.setReturnValues(ret);
     ctxt.setReturnErrors(err);
     ctxt.setArguments(args);
-
-    auto entry = generator.generateTree(tUnit.getProgram()->getSubroutine(name));
     execute(entry.get(), ctxt);
 }
 
+void InterpreterEngine::printExplainAnalysis(std::ostream& os) {
+    // reproduce the RAM pretty-printer, annotating every timed scope with
+    // its measured runtime and every profiled tuple operation with the
+    // number of times it was executed during the run
+    std::function<void(const RamStatement&, int)> print = [&](const RamStatement& stmt, int tabpos) {
+        if (const auto* sequence = dynamic_cast<const RamSequence*>(&stmt)) {
+            for (const auto* cur : sequence->getStatements()) {
+                print(*cur, tabpos);
+            }
+        } else if (const auto* parallel = dynamic_cast<const RamParallel*>(&stmt)) {
+            os << times(" ", tabpos) << "PARALLEL" << std::endl;
+            for (const auto* cur : parallel->getStatements()) {
+                print(*cur, tabpos + 1);
+            }
+            os << times(" ", tabpos) << "END PARALLEL" << std::endl;
+        } else if (const auto* loop = dynamic_cast<const RamLoop*>(&stmt)) {
+            os << times(" ", tabpos) << "LOOP" << std::endl;
+            print(loop->getBody(), tabpos + 1);
+            os << times(" ", tabpos) << "END LOOP" << std::endl;
+        } else if (const auto* stratum = dynamic_cast<const RamStratum*>(&stmt)) {
+            os << times(" ", tabpos) << "BEGIN_STRATUM " << stratum->getIndex() << std::endl;
+            print(stratum->getBody(), tabpos + 1);
+            os << times(" ", tabpos) << "END_STRATUM " << stratum->getIndex() << std::endl;
+        } else if (const auto* relTimer = dynamic_cast<const RamLogRelationTimer*>(&stmt)) {
+            os << times(" ", tabpos) << "START_TIMER ON " << relTimer->getRelation().getName() << " \""
+               << stringify(relTimer->getMessage()) << "\"";
+            auto pos = explainTimes.find(relTimer->getMessage());
+            if (pos != explainTimes.end()) {
+                os << "  -- actual time: " << pos->second.count() / 1000.0 << "ms";
+            }
+            os << std::endl;
+            print(relTimer->getStatement(), tabpos + 1);
+            os << times(" ", tabpos) << "END_TIMER" << std::endl;
+        } else if (const auto* timer = dynamic_cast<const RamLogTimer*>(&stmt)) {
+            os << times(" ", tabpos) << "START_TIMER \"" << stringify(timer->getMessage()) << "\"";
+            auto pos = explainTimes.find(timer->getMessage());
+            if (pos != explainTimes.end()) {
+                os << "  -- actual time: " << pos->second.count() / 1000.0 << "ms";
+            }
+            os << std::endl;
+            print(timer->getStatement(), tabpos + 1);
+            os << times(" ", tabpos) << "END_TIMER" << std::endl;
+        } else if (const auto* debug = dynamic_cast<const RamDebugInfo*>(&stmt)) {
+            os << times(" ", tabpos) << "BEGIN_DEBUG \"" << stringify(debug->getMessage()) << "\""
+               << std::endl;
+            print(debug->getStatement(), tabpos + 1);
+            os << times(" ", tabpos) << "END_DEBUG" << std::endl;
+        } else if (const auto* query = dynamic_cast<const RamQuery*>(&stmt)) {
+            stmt.print(os, tabpos);
+            visitDepthFirst(*query, [&](const RamTupleOperation& op) {
+                if (op.getProfileText().empty()) {
+                    return;
+                }
+                auto pos = frequencies.find(op.getProfileText());
+                if (pos == frequencies.end()) {
+                    return;
+                }
+                size_t total = 0;
+                for (const auto& cur : pos->second) {
+                    total += cur;
+                }
+                os << times(" ", tabpos + 1) << "-- actual tuples: " << total << "  ("
+                   << op.getProfileText() << ")" << std::endl;
+            });
+        } else {
+            stmt.print(os, tabpos);
+        }
+    };
+    auto* main = tUnit.getProgram()->getMain();
+    if (main != nullptr) {
+        print(*main, 0);
+    }
+}
+
 RamDomain InterpreterEngine::execute(const InterpreterNode* node, InterpreterContext& ctxt) {
 #define DEBUG(Kind) std::cout << "Running Node: " << #Kind << "\n";
 
+#ifdef USE_COMPUTED_GOTO
+// Threaded dispatch: the node type tag directly indexes a static table of
+// label addresses (computed goto). Compared to a switch statement this
+// saves the range check and gives every operation its own indirect branch,
+// which predicts considerably better in the interpretation loop.
+#define CASE(Kind) \
+    LBL_##Kind : { \
+        const auto* cur = static_cast<const Ram##Kind*>(node->getShadow());
+
+#define CASE_NO_CAST(Kind) LBL_##Kind : {
+#define ESAC(Kind)                                                        \
+    assert(false && "Program reach end of the scope but didn't return."); \
+    }
+
+    // the dispatch table, kept in sync with enum InterpreterNodeType
+    static const void* const dispatch_table[] = {
+            &&LBL_Number, &&LBL_PrecomputedNumber, &&LBL_TupleElement, &&LBL_AutoIncrement,
+            &&LBL_IntrinsicOperator,
+            &&LBL_UserDefinedOperator, &&LBL_PackRecord, &&LBL_SubroutineArgument, &&LBL_True, &&LBL_False,
+            &&LBL_Conjunction, &&LBL_Negation, &&LBL_EmptinessCheck, &&LBL_ExistenceCheck,
+            &&LBL_ProvenanceExistenceCheck, &&LBL_SubsumptionCheck, &&LBL_Constraint, &&LBL_TupleOperation,
+            &&LBL_Scan,
+            &&LBL_ParallelScan, &&LBL_IndexScan, &&LBL_ParallelIndexScan, &&LBL_HashScan, &&LBL_Choice,
+            &&LBL_ParallelChoice, &&LBL_IndexChoice, &&LBL_ParallelIndexChoice, &&LBL_UnpackRecord,
+            &&LBL_Aggregate, &&LBL_ParallelAggregate, &&LBL_IndexAggregate, &&LBL_Break, &&LBL_Filter, &&LBL_Split, &&LBL_Project,
+            &&LBL_ScanFilterProject, &&LBL_IndexScanFilterProject,
+            &&LBL_SubroutineReturnValue, &&LBL_Sequence, &&LBL_Parallel, &&LBL_Loop, &&LBL_Exit,
+            &&LBL_LogRelationTimer, &&LBL_LogTimer, &&LBL_DebugInfo, &&LBL_Stratum, &&LBL_Create,
+            &&LBL_Clear, &&LBL_Drop, &&LBL_LogSize, &&LBL_Load, &&LBL_Store, &&LBL_Fact, &&LBL_FactTable,
+            &&LBL_Query, &&LBL_Merge, &&LBL_Swap};
+    goto* dispatch_table[node->getType()];
+#else
 #define CASE(Kind)     \
     case (I_##Kind): { \
         const auto* cur = static_cast<const Ram##Kind*>(node->getShadow());
@@ -227,10 +1255,16 @@ RamDomain InterpreterEngine::execute(const InterpreterNode* node, InterpreterCon
     }
 
     switch (node->getType()) {
+#endif
         CASE(Number)
         return cur->getConstant();
         ESAC(Number)
 
+        CASE_NO_CAST(PrecomputedNumber)
+        // value of a functor chain folded at generation time
+        return static_cast<RamDomain>(node->getData(0));
+        ESAC(PrecomputedNumber)
+
         CASE(TupleElement)
         return ctxt[cur->getTupleId()][cur->getElement()];
         ESAC(TupleElement)
@@ -257,7 +1291,7 @@ RamDomain InterpreterEngine::execute(const InterpreterNode* node, InterpreterCon
             case FunctorOp::TONUMBER: {
                 RamDomain result = 0;
                 try {
-                    result = stord(getSymbolTable().resolve(execute(node->getChild(0), ctxt)));
+                    result = stord(std::string(getSymbolTable().resolve(execute(node->getChild(0), ctxt))));
                 } catch (...) {
                     std::cerr << "error: wrong string provided by to_number(\"";
                     std::cerr << getSymbolTable().resolve(execute(node->getChild(0), ctxt));
@@ -266,8 +1300,11 @@ RamDomain InterpreterEngine::execute(const InterpreterNode* node, InterpreterCon
                 }
                 return result;
             }
-            case FunctorOp::TOSTRING:
-                return getSymbolTable().lookup(std::to_string(execute(node->getChild(0), ctxt)));
+            case FunctorOp::TOSTRING: {
+                RamDomain num = execute(node->getChild(0), ctxt);
+                return StringFunctorMemo::instance().getOrCompute(StringFunctorMemo::TOSTRING, 1, num, 0, 0,
+                        [&]() { return getSymbolTable().lookup(std::to_string(num)); });
+            }
             /** Binary Functor Operators */
             case FunctorOp::ADD: {
                 BINARY_OP(+);
@@ -317,6 +1354,22 @@ RamDomain InterpreterEngine::execute(const InterpreterNode* node, InterpreterCon
                 return result;
             }
             case FunctorOp::CAT: {
+                // small concatenations over recurring arguments are served
+                // from the per-thread memo
+                if (args.size() <= 3) {
+                    RamDomain ord[3] = {0, 0, 0};
+                    for (size_t i = 0; i < args.size(); i++) {
+                        ord[i] = execute(node->getChild(i), ctxt);
+                    }
+                    return StringFunctorMemo::instance().getOrCompute(
+                            StringFunctorMemo::CAT, args.size(), ord[0], ord[1], ord[2], [&]() {
+                                std::stringstream ss;
+                                for (size_t i = 0; i < args.size(); i++) {
+                                    ss << getSymbolTable().resolve(ord[i]);
+                                }
+                                return getSymbolTable().lookup(ss.str());
+                            });
+                }
                 std::stringstream ss;
                 for (size_t i = 0; i < args.size(); i++) {
                     ss << getSymbolTable().resolve(execute(node->getChild(i), ctxt));
@@ -326,17 +1379,21 @@ RamDomain InterpreterEngine::execute(const InterpreterNode* node, InterpreterCon
             /** Ternary Functor Operators */
             case FunctorOp::SUBSTR: {
                 auto symbol = execute(node->getChild(0), ctxt);
-                const std::string& str = getSymbolTable().resolve(symbol);
                 auto idx = execute(node->getChild(1), ctxt);
                 auto len = execute(node->getChild(2), ctxt);
-                std::string sub_str;
-                try {
-                    sub_str = str.substr(idx, len);
-                } catch (...) {
-                    std::cerr << "warning: wrong index position provided by substr(\"";
-                    std::cerr << str << "\"," << (int32_t)idx << "," << (int32_t)len << ") functor.\n";
-                }
-                return getSymbolTable().lookup(sub_str);
+                return StringFunctorMemo::instance().getOrCompute(
+                        StringFunctorMemo::SUBSTR, 3, symbol, idx, len, [&]() {
+                            std::string_view str = getSymbolTable().resolve(symbol);
+                            std::string sub_str;
+                            try {
+                                sub_str = str.substr(idx, len);
+                            } catch (...) {
+                                std::cerr << "warning: wrong index position provided by substr(\"";
+                                std::cerr << str << "\"," << (int32_t)idx << "," << (int32_t)len
+                                          << ") functor.\n";
+                            }
+                            return getSymbolTable().lookup(sub_str);
+                        });
             }
             /** Undefined */
             default: {
@@ -347,19 +1404,12 @@ RamDomain InterpreterEngine::execute(const InterpreterNode* node, InterpreterCon
         ESAC(IntrinsicOperator)
 
         CASE(UserDefinedOperator)
-        // get name and type
-        const std::string& name = cur->getName();
         const std::string& type = cur->getType();
-
-        auto fn = reinterpret_cast<void (*)()>(getMethodHandle(name));
-        if (fn == nullptr) {
-            std::cerr << "Cannot find user-defined operator " << name << std::endl;
-            exit(1);
-        }
-        // prepare dynamic call environment
         size_t arity = cur->getArgCount();
-        ffi_cif cif;
-        ffi_type* args[arity];
+
+        // the entry point and call interface were resolved up front;
+        // only the argument values change between evaluated tuples
+        FunctorCall& call = *functorCalls.find(cur)->second;
         void* values[arity];
         RamDomain intVal[arity];
         const char* strVal[arity];
@@ -369,33 +1419,16 @@ RamDomain InterpreterEngine::execute(const InterpreterNode* node, InterpreterCon
         for (size_t i = 0; i < arity; i++) {
             RamDomain arg = execute(node->getChild(i), ctxt);
             if (type[i] == 'S') {
-                args[i] = &ffi_type_pointer;
-                strVal[i] = getSymbolTable().resolve(arg).c_str();
+                strVal[i] = getSymbolTable().resolve(arg).data();
                 values[i] = &strVal[i];
             } else {
-                args[i] = &ffi_type_uint32;
                 intVal[i] = arg;
                 values[i] = &intVal[i];
             }
         }
 
         // call external function
-        if (type[arity] == 'N') {
-            // Initialize for numerical return value
-            if (ffi_prep_cif(&cif, FFI_DEFAULT_ABI, arity, &ffi_type_uint32, args) != FFI_OK) {
-                std::cerr << "Failed to prepare CIF for user-defined operator ";
-                std::cerr << name << std::endl;
-                exit(1);
-            }
-        } else {
-            // Initialize for string return value
-            if (ffi_prep_cif(&cif, FFI_DEFAULT_ABI, arity, &ffi_type_pointer, args) != FFI_OK) {
-                std::cerr << "Failed to prepare CIF for user-defined operator ";
-                std::cerr << name << std::endl;
-                exit(1);
-            }
-        }
-        ffi_call(&cif, fn, &rc, values);
+        ffi_call(&call.cif, call.fn, &rc, values);
         RamDomain result;
         if (type[arity] == 'N') {
             result = ((RamDomain)rc);
@@ -450,6 +1483,10 @@ RamDomain InterpreterEngine::execute(const InterpreterNode* node, InterpreterCon
         }
         // for total we use the exists test
         if (isa->isTotalSignature(cur)) {
+            // an all-constant pattern was assembled at generation time
+            if (node->hasConstBounds()) {
+                return rel.contains(TupleRef(node->getConstLow(), arity));
+            }
             RamDomain tuple[arity];
             for (size_t i = 0; i < arity; i++) {
                 tuple[i] = execute(node->getChild(i), ctxt);
@@ -457,6 +1494,12 @@ RamDomain InterpreterEngine::execute(const InterpreterNode* node, InterpreterCon
             return rel.contains(TupleRef(tuple, arity));
         }
 
+        size_t viewPos = node->getData(1);
+        if (node->hasConstBounds()) {
+            return ctxt.getView(viewPos)->contains(
+                    TupleRef(node->getConstLow(), arity), TupleRef(node->getConstHigh(), arity));
+        }
+
         // for partial we search for lower and upper boundaries
         RamDomain low[arity];
         RamDomain high[arity];
@@ -464,7 +1507,6 @@ RamDomain InterpreterEngine::execute(const InterpreterNode* node, InterpreterCon
             low[i] = node->getChild(i) != nullptr ? execute(node->getChild(i), ctxt) : MIN_RAM_DOMAIN;
             high[i] = node->getChild(i) != nullptr ? low[i] : MAX_RAM_DOMAIN;
         }
-        size_t viewPos = node->getData(1);
         return ctxt.getView(viewPos)->contains(TupleRef(low, arity), TupleRef(high, arity));
         ESAC(ExistenceCheck)
 
@@ -475,14 +1517,12 @@ RamDomain InterpreterEngine::execute(const InterpreterNode* node, InterpreterCon
         // for partial we search for lower and upper boundaries
         RamDomain low[arity];
         RamDomain high[arity];
-        for (size_t i = 0; i < arity - 2; i++) {
+        for (size_t i = 0; i < arity - 1; i++) {
             low[i] = node->getChild(i) ? execute(node->getChild(i), ctxt) : MIN_RAM_DOMAIN;
             high[i] = node->getChild(i) ? low[i] : MAX_RAM_DOMAIN;
         }
 
-        low[arity - 2] = MIN_RAM_DOMAIN;
         low[arity - 1] = MIN_RAM_DOMAIN;
-        high[arity - 2] = MAX_RAM_DOMAIN;
         high[arity - 1] = MAX_RAM_DOMAIN;
 
         // obtain view
@@ -490,6 +1530,29 @@ RamDomain InterpreterEngine::execute(const InterpreterNode* node, InterpreterCon
         return ctxt.getView(viewPos)->contains(TupleRef(low, arity), TupleRef(high, arity));
         ESAC(ProvenanceExistenceCheck)
 
+        CASE(SubsumptionCheck)
+        // construct the pattern tuple
+        size_t arity = cur->getRelation().getArity();
+
+        if (profileEnabled && !cur->getRelation().isTemp()) {
+            reads[cur->getRelation().getName()]++;
+        }
+
+        // match the key attributes exactly; a dominating tuple carries a
+        // smaller or equal measure in the last attribute
+        RamDomain low[arity];
+        RamDomain high[arity];
+        for (size_t i = 0; i < arity - 1; i++) {
+            low[i] = node->getChild(i) ? execute(node->getChild(i), ctxt) : MIN_RAM_DOMAIN;
+            high[i] = node->getChild(i) ? low[i] : MAX_RAM_DOMAIN;
+        }
+        low[arity - 1] = MIN_RAM_DOMAIN;
+        high[arity - 1] = execute(node->getChild(arity - 1), ctxt);
+
+        size_t viewPos = node->getData(1);
+        return ctxt.getView(viewPos)->contains(TupleRef(low, arity), TupleRef(high, arity));
+        ESAC(SubsumptionCheck)
+
         CASE(Constraint)
         switch (cur->getOperator()) {
             case (BinaryConstraintOp::EQ):
@@ -507,11 +1570,11 @@ RamDomain InterpreterEngine::execute(const InterpreterNode* node, InterpreterCon
             case (BinaryConstraintOp::MATCH): {
                 RamDomain left = execute(node->getChild(0), ctxt);
                 RamDomain right = execute(node->getChild(1), ctxt);
-                const std::string& pattern = getSymbolTable().resolve(left);
-                const std::string& text = getSymbolTable().resolve(right);
+                std::string_view pattern = getSymbolTable().resolve(left);
+                std::string_view text = getSymbolTable().resolve(right);
                 bool result = false;
                 try {
-                    result = std::regex_match(text, std::regex(pattern));
+                    result = std::regex_match(text.begin(), text.end(), std::regex(pattern.begin(), pattern.end()));
                 } catch (...) {
                     std::cerr << "warning: wrong pattern provided for match(\"" << pattern << "\",\"" << text
                               << "\").\n";
@@ -521,11 +1584,11 @@ RamDomain InterpreterEngine::execute(const InterpreterNode* node, InterpreterCon
             case (BinaryConstraintOp::NOT_MATCH): {
                 RamDomain left = execute(node->getChild(0), ctxt);
                 RamDomain right = execute(node->getChild(1), ctxt);
-                const std::string& pattern = getSymbolTable().resolve(left);
-                const std::string& text = getSymbolTable().resolve(right);
+                std::string_view pattern = getSymbolTable().resolve(left);
+                std::string_view text = getSymbolTable().resolve(right);
                 bool result = false;
                 try {
-                    result = !std::regex_match(text, std::regex(pattern));
+                    result = !std::regex_match(text.begin(), text.end(), std::regex(pattern.begin(), pattern.end()));
                 } catch (...) {
                     std::cerr << "warning: wrong pattern provided for !match(\"" << pattern << "\",\"" << text
                               << "\").\n";
@@ -535,16 +1598,16 @@ RamDomain InterpreterEngine::execute(const InterpreterNode* node, InterpreterCon
             case (BinaryConstraintOp::CONTAINS): {
                 RamDomain left = execute(node->getChild(0), ctxt);
                 RamDomain right = execute(node->getChild(1), ctxt);
-                const std::string& pattern = getSymbolTable().resolve(left);
-                const std::string& text = getSymbolTable().resolve(right);
-                return text.find(pattern) != std::string::npos;
+                std::string_view pattern = getSymbolTable().resolve(left);
+                std::string_view text = getSymbolTable().resolve(right);
+                return text.find(pattern) != std::string_view::npos;
             }
             case (BinaryConstraintOp::NOT_CONTAINS): {
                 RamDomain left = execute(node->getChild(0), ctxt);
                 RamDomain right = execute(node->getChild(1), ctxt);
-                const std::string& pattern = getSymbolTable().resolve(left);
-                const std::string& text = getSymbolTable().resolve(right);
-                return text.find(pattern) == std::string::npos;
+                std::string_view pattern = getSymbolTable().resolve(left);
+                std::string_view text = getSymbolTable().resolve(right);
+                return text.find(pattern) == std::string_view::npos;
             }
             default:
                 assert(false && "unsupported operator");
@@ -566,11 +1629,39 @@ RamDomain InterpreterEngine::execute(const InterpreterNode* node, InterpreterCon
         ESAC(TupleOperation)
 
         CASE(Scan)
+        // a single-scan input relation streams from its parked buffer;
+        // its tuples were never materialized
+        auto streamed = streamedBuffers.find(cur->getRelation().getName());
+        if (streamed != streamedBuffers.end()) {
+            const std::vector<RamDomain>& buffer = streamed->second;
+            const size_t width = cur->getRelation().getAttributeTypeQualifiers().size();
+            const size_t count = buffer.size() / width;
+            size_t ticks = 0;
+            for (size_t i = 0; i < count; ++i) {
+                if (watchdogActive && (planAborted || ((++ticks & 0x3FF) == 0 && planExpired()))) {
+                    return false;
+                }
+                ctxt[cur->getTupleId()] = &buffer[i * width];
+                if (!execute(node->getChild(0), ctxt)) {
+                    break;
+                }
+            }
+            // the single consuming scan is done with the tuples
+            streamedBuffers.erase(streamed);
+            return true;
+        }
+
         // get the targeted relation
         auto& rel = getRelation(node->getData(0));
 
         // use simple iterator
+        size_t ticks = 0;
         for (const RamDomain* tuple : rel) {
+            // under the rule watchdog, give up on the current plan once
+            // its deadline passed; the clock is polled every 1024 tuples
+            if (watchdogActive && (planAborted || ((++ticks & 0x3FF) == 0 && planExpired()))) {
+                return false;
+            }
             ctxt[cur->getTupleId()] = tuple;
             if (!execute(node->getChild(0), ctxt)) {
                 break;
@@ -581,9 +1672,63 @@ RamDomain InterpreterEngine::execute(const InterpreterNode* node, InterpreterCon
 
         CASE(ParallelScan)
         auto preamble = node->getPreamble();
+
+        // a single-scan input relation streams from its parked buffer,
+        // claiming runs of rows as the partitioned scan below claims
+        // runs of partitions
+        auto streamed = streamedBuffers.find(cur->getRelation().getName());
+        if (streamed != streamedBuffers.end()) {
+            const std::vector<RamDomain>& buffer = streamed->second;
+            const size_t width = cur->getRelation().getAttributeTypeQualifiers().size();
+            const size_t numRows = buffer.size() / width;
+            const size_t streamTeam = numOfThreads > 0 ? numOfThreads : MAX_THREADS;
+            std::atomic<size_t> rowCursor(0);
+
+            PARALLEL_START;
+            InterpreterContext newCtxt(ctxt);
+            auto viewInfo = preamble->getViewInfoForNested();
+            for (const auto& info : viewInfo) {
+                newCtxt.createView(*getRelationHandle(info[0]), info[1], info[2]);
+            }
+            size_t ticks = 0;
+            while (true) {
+                if (watchdogActive && planAborted) {
+                    break;
+                }
+                size_t claimed = std::min(rowCursor.load(std::memory_order_relaxed), numRows);
+                size_t run = std::max<size_t>((numRows - claimed) / (2 * streamTeam), 1);
+                size_t begin = rowCursor.fetch_add(run, std::memory_order_relaxed);
+                if (begin >= numRows) {
+                    break;
+                }
+                size_t end = std::min(begin + run, numRows);
+                for (size_t row = begin; row < end; ++row) {
+                    if (watchdogActive && (planAborted || ((++ticks & 0x3FF) == 0 && planExpired()))) {
+                        break;
+                    }
+                    newCtxt[cur->getTupleId()] = &buffer[row * width];
+                    if (!execute(node->getChild(0), newCtxt)) {
+                        break;
+                    }
+                }
+            }
+            PARALLEL_END;
+            // the single consuming scan is done with the tuples
+            streamedBuffers.erase(streamed);
+            return true;
+        }
+
         auto& rel = getRelation(node->getData(0));
 
-        auto pStream = rel.partitionScan(numOfThreads);
+        auto pStream = rel.partitionScan(NUM_WORK_CHUNKS(numOfThreads));
+
+        // guided self-scheduling: partitions are claimed from a shared
+        // cursor in runs that shrink as the scan progresses -- large runs
+        // keep the scheduling overhead low early on, small runs even out
+        // the finish of the threads
+        const size_t numParts = pStream.end() - pStream.begin();
+        const size_t team = numOfThreads > 0 ? numOfThreads : MAX_THREADS;
+        std::atomic<size_t> partCursor(0);
 
         PARALLEL_START;
         InterpreterContext newCtxt(ctxt);
@@ -591,44 +1736,133 @@ RamDomain InterpreterEngine::execute(const InterpreterNode* node, InterpreterCon
         for (const auto& info : viewInfo) {
             newCtxt.createView(*getRelationHandle(info[0]), info[1], info[2]);
         }
-        pfor(auto it = pStream.begin(); it < pStream.end(); it++) {
-            for (const TupleRef& val : *it) {
-                newCtxt[cur->getTupleId()] = val.getBase();
-                if (!execute(node->getChild(0), newCtxt)) {
-                    break;
+        size_t ticks = 0;
+        while (true) {
+            // under the rule watchdog, all threads wind down once the
+            // deadline passed; any thread may raise the abort flag
+            if (watchdogActive && planAborted) {
+                break;
+            }
+            // claim a run proportional to the partitions still unclaimed
+            size_t claimed = std::min(partCursor.load(std::memory_order_relaxed), numParts);
+            size_t run = std::max<size_t>((numParts - claimed) / (2 * team), 1);
+            size_t begin = partCursor.fetch_add(run, std::memory_order_relaxed);
+            if (begin >= numParts) {
+                break;
+            }
+            size_t end = std::min(begin + run, numParts);
+            for (auto it = pStream.begin() + begin; it != pStream.begin() + end; ++it) {
+                for (const TupleRef& val : *it) {
+                    if (watchdogActive && (planAborted || ((++ticks & 0x3FF) == 0 && planExpired()))) {
+                        break;
+                    }
+                    newCtxt[cur->getTupleId()] = val.getBase();
+                    if (!execute(node->getChild(0), newCtxt)) {
+                        break;
+                    }
+                }
+            }
+        }
+        PARALLEL_END;
+        return true;
+        ESAC(ParallelScan)
+
+        CASE(IndexScan)
+        // create pattern tuple for range query
+        size_t arity = cur->getRelation().getArity();
+        // inequality bound expressions are appended behind the nested operation
+        const size_t boundsBase = arity + 1;
+        const bool hasBounds = node->getChildren().size() > boundsBase;
+        const RamDomain* low;
+        const RamDomain* hig;
+        RamDomain lowBuffer[arity];
+        RamDomain higBuffer[arity];
+        if (node->hasConstBounds()) {
+            // an all-constant pattern was assembled at generation time
+            low = node->getConstLow();
+            hig = node->getConstHigh();
+        } else {
+            for (size_t i = 0; i < arity; i++) {
+                if (node->getChild(i) != nullptr) {
+                    lowBuffer[i] = execute(node->getChild(i), ctxt);
+                    higBuffer[i] = lowBuffer[i];
+                } else {
+                    lowBuffer[i] = hasBounds && node->getChild(boundsBase + i) != nullptr
+                                           ? execute(node->getChild(boundsBase + i), ctxt)
+                                           : MIN_RAM_DOMAIN;
+                    higBuffer[i] = hasBounds && node->getChild(boundsBase + arity + i) != nullptr
+                                           ? execute(node->getChild(boundsBase + arity + i), ctxt)
+                                           : MAX_RAM_DOMAIN;
+                }
+            }
+            low = lowBuffer;
+            hig = higBuffer;
+        }
+
+        size_t viewId = node->getData(0);
+        auto& view = ctxt.getView(viewId);
+        // conduct range query
+        size_t ticks = 0;
+        for (auto data : view->range(TupleRef(low, arity), TupleRef(hig, arity))) {
+            if (watchdogActive && (planAborted || ((++ticks & 0x3FF) == 0 && planExpired()))) {
+                return false;
+            }
+            ctxt[cur->getTupleId()] = &data[0];
+            if (!execute(node->getChild(arity), ctxt)) {
+                break;
+            }
+        }
+        return true;
+        ESAC(IndexScan)
+
+        CASE(HashScan)
+        auto& rel = getRelation(node->getData(0));
+        size_t arity = rel.getArity();
+
+        // locate the transient hash table of this scan, building it on
+        // first use; concurrent probes from a parallel loop share it
+        const JoinHashTable* table;
+        {
+            auto lease = joinTablesLock.acquire();
+            (void)lease;
+            auto& entry = joinTables[cur];
+            if (entry == nullptr) {
+                std::vector<size_t> keyColumns;
+                for (size_t i = 0; i < arity; i++) {
+                    if (node->getChild(i) != nullptr) {
+                        keyColumns.push_back(i);
+                    }
+                }
+                entry = std::make_unique<JoinHashTable>(std::move(keyColumns), arity);
+                entry->reserve(rel.size());
+                for (const RamDomain* tuple : rel) {
+                    entry->insert(tuple);
                 }
             }
+            table = entry.get();
         }
-        PARALLEL_END;
-        return true;
-        ESAC(ParallelScan)
 
-        CASE(IndexScan)
-        // create pattern tuple for range query
-        size_t arity = cur->getRelation().getArity();
-        RamDomain low[arity];
-        RamDomain hig[arity];
+        // evaluate the probe key over the bound columns
+        RamDomain key[arity];
+        size_t numKeys = 0;
         for (size_t i = 0; i < arity; i++) {
             if (node->getChild(i) != nullptr) {
-                low[i] = execute(node->getChild(i), ctxt);
-                hig[i] = low[i];
-            } else {
-                low[i] = MIN_RAM_DOMAIN;
-                hig[i] = MAX_RAM_DOMAIN;
+                key[numKeys++] = execute(node->getChild(i), ctxt);
             }
         }
 
-        size_t viewId = node->getData(0);
-        auto& view = ctxt.getView(viewId);
-        // conduct range query
-        for (auto data : view->range(TupleRef(low, arity), TupleRef(hig, arity))) {
-            ctxt[cur->getTupleId()] = &data[0];
+        size_t ticks = 0;
+        for (const RamDomain* tuple : table->equalRange(key)) {
+            if (watchdogActive && (planAborted || ((++ticks & 0x3FF) == 0 && planExpired()))) {
+                return false;
+            }
+            ctxt[cur->getTupleId()] = tuple;
             if (!execute(node->getChild(arity), ctxt)) {
                 break;
             }
         }
         return true;
-        ESAC(IndexScan)
+        ESAC(HashScan)
 
         CASE(ParallelIndexScan)
         auto preamble = node->getPreamble();
@@ -636,20 +1870,43 @@ RamDomain InterpreterEngine::execute(const InterpreterNode* node, InterpreterCon
 
         // create pattern tuple for range query
         size_t arity = rel.getArity();
-        RamDomain low[arity];
-        RamDomain hig[arity];
-        for (size_t i = 0; i < arity; i++) {
-            if (node->getChild(i)) {
-                low[i] = execute(node->getChild(i), ctxt);
-                hig[i] = low[i];
-            } else {
-                low[i] = MIN_RAM_DOMAIN;
-                hig[i] = MAX_RAM_DOMAIN;
+        // inequality bound expressions are appended behind the nested operation
+        const size_t boundsBase = arity + 1;
+        const bool hasBounds = node->getChildren().size() > boundsBase;
+        const RamDomain* low;
+        const RamDomain* hig;
+        RamDomain lowBuffer[arity];
+        RamDomain higBuffer[arity];
+        if (node->hasConstBounds()) {
+            // an all-constant pattern was assembled at generation time
+            low = node->getConstLow();
+            hig = node->getConstHigh();
+        } else {
+            for (size_t i = 0; i < arity; i++) {
+                if (node->getChild(i)) {
+                    lowBuffer[i] = execute(node->getChild(i), ctxt);
+                    higBuffer[i] = lowBuffer[i];
+                } else {
+                    lowBuffer[i] = hasBounds && node->getChild(boundsBase + i) != nullptr
+                                           ? execute(node->getChild(boundsBase + i), ctxt)
+                                           : MIN_RAM_DOMAIN;
+                    higBuffer[i] = hasBounds && node->getChild(boundsBase + arity + i) != nullptr
+                                           ? execute(node->getChild(boundsBase + arity + i), ctxt)
+                                           : MAX_RAM_DOMAIN;
+                }
             }
+            low = lowBuffer;
+            hig = higBuffer;
         }
 
         size_t indexPos = node->getData(1);
-        auto pStream = rel.partitionRange(indexPos, TupleRef(low, arity), TupleRef(hig, arity), numOfThreads);
+        auto pStream = rel.partitionRange(
+                indexPos, TupleRef(low, arity), TupleRef(hig, arity), NUM_WORK_CHUNKS(numOfThreads));
+
+        // the same guided self-scheduling as in ParallelScan
+        const size_t numParts = pStream.end() - pStream.begin();
+        const size_t team = numOfThreads > 0 ? numOfThreads : MAX_THREADS;
+        std::atomic<size_t> partCursor(0);
 
         PARALLEL_START;
         InterpreterContext newCtxt(ctxt);
@@ -657,11 +1914,27 @@ RamDomain InterpreterEngine::execute(const InterpreterNode* node, InterpreterCon
         for (const auto& info : viewInfo) {
             newCtxt.createView(*getRelationHandle(info[0]), info[1], info[2]);
         }
-        pfor(auto it = pStream.begin(); it < pStream.end(); it++) {
-            for (const TupleRef& val : *it) {
-                newCtxt[cur->getTupleId()] = val.getBase();
-                if (!execute(node->getChild(arity), newCtxt)) {
-                    break;
+        size_t ticks = 0;
+        while (true) {
+            if (watchdogActive && planAborted) {
+                break;
+            }
+            size_t claimed = std::min(partCursor.load(std::memory_order_relaxed), numParts);
+            size_t run = std::max<size_t>((numParts - claimed) / (2 * team), 1);
+            size_t begin = partCursor.fetch_add(run, std::memory_order_relaxed);
+            if (begin >= numParts) {
+                break;
+            }
+            size_t end = std::min(begin + run, numParts);
+            for (auto it = pStream.begin() + begin; it != pStream.begin() + end; ++it) {
+                for (const TupleRef& val : *it) {
+                    if (watchdogActive && (planAborted || ((++ticks & 0x3FF) == 0 && planExpired()))) {
+                        break;
+                    }
+                    newCtxt[cur->getTupleId()] = val.getBase();
+                    if (!execute(node->getChild(arity), newCtxt)) {
+                        break;
+                    }
                 }
             }
         }
@@ -689,7 +1962,7 @@ RamDomain InterpreterEngine::execute(const InterpreterNode* node, InterpreterCon
         auto preamble = node->getPreamble();
         auto& rel = getRelation(node->getData(0));
 
-        auto pStream = rel.partitionScan(numOfThreads);
+        auto pStream = rel.partitionScan(NUM_WORK_CHUNKS(numOfThreads));
         auto viewInfo = preamble->getViewInfoForNested();
         PARALLEL_START;
         InterpreterContext newCtxt(ctxt);
@@ -712,16 +1985,33 @@ RamDomain InterpreterEngine::execute(const InterpreterNode* node, InterpreterCon
         CASE(IndexChoice)
         // create pattern tuple for range query
         size_t arity = cur->getRelation().getArity();
-        RamDomain low[arity];
-        RamDomain hig[arity];
-        for (size_t i = 0; i < arity; i++) {
-            if (node->getChild(i) != nullptr) {
-                low[i] = execute(node->getChild(i), ctxt);
-                hig[i] = low[i];
-            } else {
-                low[i] = MIN_RAM_DOMAIN;
-                hig[i] = MAX_RAM_DOMAIN;
+        // inequality bound expressions are appended behind condition and nested operation
+        const size_t boundsBase = arity + 2;
+        const bool hasBounds = node->getChildren().size() > boundsBase;
+        const RamDomain* low;
+        const RamDomain* hig;
+        RamDomain lowBuffer[arity];
+        RamDomain higBuffer[arity];
+        if (node->hasConstBounds()) {
+            // an all-constant pattern was assembled at generation time
+            low = node->getConstLow();
+            hig = node->getConstHigh();
+        } else {
+            for (size_t i = 0; i < arity; i++) {
+                if (node->getChild(i) != nullptr) {
+                    lowBuffer[i] = execute(node->getChild(i), ctxt);
+                    higBuffer[i] = lowBuffer[i];
+                } else {
+                    lowBuffer[i] = hasBounds && node->getChild(boundsBase + i) != nullptr
+                                           ? execute(node->getChild(boundsBase + i), ctxt)
+                                           : MIN_RAM_DOMAIN;
+                    higBuffer[i] = hasBounds && node->getChild(boundsBase + arity + i) != nullptr
+                                           ? execute(node->getChild(boundsBase + arity + i), ctxt)
+                                           : MAX_RAM_DOMAIN;
+                }
             }
+            low = lowBuffer;
+            hig = higBuffer;
         }
 
         size_t viewId = node->getData(0);
@@ -746,20 +2036,38 @@ RamDomain InterpreterEngine::execute(const InterpreterNode* node, InterpreterCon
 
         // create pattern tuple for range query
         size_t arity = rel.getArity();
-        RamDomain low[arity];
-        RamDomain hig[arity];
-        for (size_t i = 0; i < arity; i++) {
-            if (node->getChild(i) != nullptr) {
-                low[i] = execute(node->getChild(i), ctxt);
-                hig[i] = low[i];
-            } else {
-                low[i] = MIN_RAM_DOMAIN;
-                hig[i] = MAX_RAM_DOMAIN;
+        // inequality bound expressions are appended behind condition and nested operation
+        const size_t boundsBase = arity + 2;
+        const bool hasBounds = node->getChildren().size() > boundsBase;
+        const RamDomain* low;
+        const RamDomain* hig;
+        RamDomain lowBuffer[arity];
+        RamDomain higBuffer[arity];
+        if (node->hasConstBounds()) {
+            // an all-constant pattern was assembled at generation time
+            low = node->getConstLow();
+            hig = node->getConstHigh();
+        } else {
+            for (size_t i = 0; i < arity; i++) {
+                if (node->getChild(i) != nullptr) {
+                    lowBuffer[i] = execute(node->getChild(i), ctxt);
+                    higBuffer[i] = lowBuffer[i];
+                } else {
+                    lowBuffer[i] = hasBounds && node->getChild(boundsBase + i) != nullptr
+                                           ? execute(node->getChild(boundsBase + i), ctxt)
+                                           : MIN_RAM_DOMAIN;
+                    higBuffer[i] = hasBounds && node->getChild(boundsBase + arity + i) != nullptr
+                                           ? execute(node->getChild(boundsBase + arity + i), ctxt)
+                                           : MAX_RAM_DOMAIN;
+                }
             }
+            low = lowBuffer;
+            hig = higBuffer;
         }
 
         size_t indexPos = node->getData(1);
-        auto pStream = rel.partitionRange(indexPos, TupleRef(low, arity), TupleRef(hig, arity), numOfThreads);
+        auto pStream = rel.partitionRange(
+                indexPos, TupleRef(low, arity), TupleRef(hig, arity), NUM_WORK_CHUNKS(numOfThreads));
 
         PARALLEL_START;
         InterpreterContext newCtxt(ctxt);
@@ -871,6 +2179,113 @@ RamDomain InterpreterEngine::execute(const InterpreterNode* node, InterpreterCon
         }
         ESAC(Aggregate)
 
+        CASE(ParallelAggregate)
+        auto preamble = node->getPreamble();
+        const InterpreterRelation& rel = getRelation(node->getData(0));
+
+        // initialize result
+        RamDomain init = 0;
+        switch (cur->getFunction()) {
+            case souffle::MIN:
+                init = MAX_RAM_DOMAIN;
+                break;
+            case souffle::MAX:
+                init = MIN_RAM_DOMAIN;
+                break;
+            case souffle::COUNT:
+                init = 0;
+                break;
+            case souffle::SUM:
+                init = 0;
+                break;
+        }
+        RamDomain res = init;
+
+        auto pStream = rel.partitionScan(NUM_WORK_CHUNKS(numOfThreads));
+
+        PARALLEL_START;
+        InterpreterContext newCtxt(ctxt);
+        auto viewInfo = preamble->getViewInfoForNested();
+        for (const auto& info : viewInfo) {
+            newCtxt.createView(*getRelationHandle(info[0]), info[1], info[2]);
+        }
+        // per-thread partial aggregate over the partitions
+        RamDomain partRes = init;
+        pfor(auto it = pStream.begin(); it < pStream.end(); it++) {
+            for (const TupleRef& val : *it) {
+                newCtxt[cur->getTupleId()] = val.getBase();
+
+                if (!execute(node->getChild(0), newCtxt)) {
+                    continue;
+                }
+
+                // count is easy
+                if (cur->getFunction() == souffle::COUNT) {
+                    ++partRes;
+                    continue;
+                }
+
+                // eval target expression
+                RamDomain value = execute(node->getChild(1), newCtxt);
+
+                switch (cur->getFunction()) {
+                    case souffle::MIN:
+                        partRes = std::min(partRes, value);
+                        break;
+                    case souffle::MAX:
+                        partRes = std::max(partRes, value);
+                        break;
+                    case souffle::COUNT:
+                        break;
+                    case souffle::SUM:
+                        partRes += value;
+                        break;
+                }
+            }
+        }
+        // combine the per-thread partials with the aggregate's monoid
+        AGGREGATE_COMBINE
+        {
+            switch (cur->getFunction()) {
+                case souffle::MIN:
+                    res = std::min(res, partRes);
+                    break;
+                case souffle::MAX:
+                    res = std::max(res, partRes);
+                    break;
+                case souffle::COUNT:
+                case souffle::SUM:
+                    res += partRes;
+                    break;
+            }
+        }
+        PARALLEL_END;
+
+        // in a parallel query the views for nested operations are only
+        // created inside parallel operations; the nested part continues
+        // sequentially, so create them in the current context
+        auto& viewsForNested = preamble->getViewInfoForNested();
+        for (const auto& info : viewsForNested) {
+            ctxt.createView(*getRelationHandle(info[0]), info[1], info[2]);
+        }
+
+        // write result to environment
+        RamDomain tuple[1];
+        tuple[0] = res;
+        ctxt[cur->getTupleId()] = tuple;
+
+        if (cur->getFunction() == souffle::MAX && res == MIN_RAM_DOMAIN) {
+            // no maximum found
+            return true;
+        } else if (cur->getFunction() == souffle::MIN && res == MAX_RAM_DOMAIN) {
+            // no minimum found
+            return true;
+        } else {
+            // run nested part - using base class visitor
+            return execute(node->getChild(2), ctxt);
+        }
+        ESAC(ParallelAggregate)
+
         CASE(IndexAggregate)
         // initialize result
         RamDomain res = 0;
@@ -893,17 +2308,34 @@ RamDomain InterpreterEngine::execute(const InterpreterNode* node, InterpreterCon
         size_t arity = cur->getRelation().getArity();
 
         // get lower and upper boundaries for iteration
-        RamDomain low[arity];
-        RamDomain hig[arity];
-
-        for (size_t i = 0; i < arity; i++) {
-            if (node->getChild(i) != nullptr) {
-                low[i] = execute(node->getChild(i), ctxt);
-                hig[i] = low[i];
-            } else {
-                low[i] = MIN_RAM_DOMAIN;
-                hig[i] = MAX_RAM_DOMAIN;
+        // inequality bound expressions are appended behind condition, expression,
+        // and nested operation
+        const size_t boundsBase = arity + 3;
+        const bool hasBounds = node->getChildren().size() > boundsBase;
+        const RamDomain* low;
+        const RamDomain* hig;
+        RamDomain lowBuffer[arity];
+        RamDomain higBuffer[arity];
+        if (node->hasConstBounds()) {
+            // an all-constant pattern was assembled at generation time
+            low = node->getConstLow();
+            hig = node->getConstHigh();
+        } else {
+            for (size_t i = 0; i < arity; i++) {
+                if (node->getChild(i) != nullptr) {
+                    lowBuffer[i] = execute(node->getChild(i), ctxt);
+                    higBuffer[i] = lowBuffer[i];
+                } else {
+                    lowBuffer[i] = hasBounds && node->getChild(boundsBase + i) != nullptr
+                                           ? execute(node->getChild(boundsBase + i), ctxt)
+                                           : MIN_RAM_DOMAIN;
+                    higBuffer[i] = hasBounds && node->getChild(boundsBase + arity + i) != nullptr
+                                           ? execute(node->getChild(boundsBase + arity + i), ctxt)
+                                           : MAX_RAM_DOMAIN;
+                }
             }
+            low = lowBuffer;
+            hig = higBuffer;
         }
 
         size_t viewId = node->getData(1);
@@ -989,6 +2421,16 @@ RamDomain InterpreterEngine::execute(const InterpreterNode* node, InterpreterCon
         return result;
         ESAC(Filter)
 
+        CASE_NO_CAST(Split)
+        // evaluate each fused body in the current tuple environment
+        for (const auto& body : node->getChildren()) {
+            if (!execute(body.get(), ctxt)) {
+                return false;
+            }
+        }
+        return true;
+        ESAC(Split)
+
         CASE(Project)
         size_t arity = cur->getRelation().getArity();
         RamDomain tuple[arity];
@@ -1002,6 +2444,168 @@ RamDomain InterpreterEngine::execute(const InterpreterNode* node, InterpreterCon
         return true;
         ESAC(Project)
 
+        CASE_NO_CAST(ScanFilterProject)
+        // superinstruction for the dominant scan -> filter* -> project
+        // chain: the whole pipeline runs in straight-line code with a
+        // single dispatch per tuple instead of one per chain operation
+        const auto* scan = static_cast<const RamScan*>(node->getShadow());
+        InterpreterRelation& target = getRelation(node->getData(1));
+        const size_t numConditions = node->getData(2);
+        const size_t tupleId = node->getData(3);
+        const size_t outArity = node->getChildren().size() - numConditions;
+        RamDomain tuple[outArity];
+        size_t ticks = 0;
+        // a single-scan input relation streams from its parked buffer;
+        // without an index there is no distinct-prefix shortcut to take
+        auto streamed = streamedBuffers.find(scan->getRelation().getName());
+        if (streamed != streamedBuffers.end()) {
+            const std::vector<RamDomain>& buffer = streamed->second;
+            const size_t width = scan->getRelation().getAttributeTypeQualifiers().size();
+            const size_t count = buffer.size() / width;
+            for (size_t row = 0; row < count; ++row) {
+                if (watchdogActive && (planAborted || ((++ticks & 0x3FF) == 0 && planExpired()))) {
+                    return false;
+                }
+                ctxt[tupleId] = &buffer[row * width];
+                bool match = true;
+                for (size_t i = 0; i < numConditions; i++) {
+                    if (!execute(node->getChild(i), ctxt)) {
+                        match = false;
+                        break;
+                    }
+                }
+                if (!match) {
+                    continue;
+                }
+                for (size_t i = 0; i < outArity; i++) {
+                    tuple[i] = execute(node->getChild(numConditions + i), ctxt);
+                }
+                target.insert(tuple);
+            }
+            streamedBuffers.erase(streamed);
+            return true;
+        }
+        auto& rel = getRelation(node->getData(0));
+        // a filter-free projection whose copied columns lead the order of
+        // the scanned index only ever produces one head tuple per distinct
+        // column prefix; enumerate one representative per prefix and skip
+        // all its duplicates instead of probing the target for each
+        if (node->getData(4) == 1) {
+            const size_t numColumns = node->getData(5);
+            const auto& lexOrder = rel.getIndexOrder(0).getOrder();
+            bool leading = numColumns <= lexOrder.size();
+            for (size_t i = 0; leading && i < numColumns; i++) {
+                bool projected = false;
+                for (size_t j = 0; j < numColumns; j++) {
+                    if (static_cast<size_t>(lexOrder[i]) == node->getData(6 + j)) {
+                        projected = true;
+                        break;
+                    }
+                }
+                leading = projected;
+            }
+            if (leading) {
+                for (auto data : rel.scanDistinctPrefix(numColumns)) {
+                    if (watchdogActive && (planAborted || ((++ticks & 0x3FF) == 0 && planExpired()))) {
+                        return false;
+                    }
+                    ctxt[tupleId] = &data[0];
+                    for (size_t i = 0; i < outArity; i++) {
+                        tuple[i] = execute(node->getChild(numConditions + i), ctxt);
+                    }
+                    target.insert(tuple);
+                }
+                return true;
+            }
+        }
+        for (const RamDomain* data : rel) {
+            if (watchdogActive && (planAborted || ((++ticks & 0x3FF) == 0 && planExpired()))) {
+                return false;
+            }
+            ctxt[tupleId] = data;
+            bool match = true;
+            for (size_t i = 0; i < numConditions; i++) {
+                if (!execute(node->getChild(i), ctxt)) {
+                    match = false;
+                    break;
+                }
+            }
+            if (!match) {
+                continue;
+            }
+            for (size_t i = 0; i < outArity; i++) {
+                tuple[i] = execute(node->getChild(numConditions + i), ctxt);
+            }
+            target.insert(tuple);
+        }
+        return true;
+        ESAC(ScanFilterProject)
+
+        CASE_NO_CAST(IndexScanFilterProject)
+        // superinstruction for an index scan whose body is a chain of
+        // filters ending in a projection; see ScanFilterProject
+        const auto* cur = static_cast<const RamIndexScan*>(node->getShadow());
+        size_t arity = cur->getRelation().getArity();
+        const size_t numConditions = node->getData(2);
+        const size_t tupleId = node->getData(3);
+        const size_t outArity = node->getData(4);
+        // inequality bound expressions are appended behind the projection values
+        const size_t boundsBase = arity + numConditions + outArity;
+        const bool hasBounds = node->getChildren().size() > boundsBase;
+        const RamDomain* low;
+        const RamDomain* hig;
+        RamDomain lowBuffer[arity];
+        RamDomain higBuffer[arity];
+        if (node->hasConstBounds()) {
+            // an all-constant pattern was assembled at generation time
+            low = node->getConstLow();
+            hig = node->getConstHigh();
+        } else {
+            for (size_t i = 0; i < arity; i++) {
+                if (node->getChild(i) != nullptr) {
+                    lowBuffer[i] = execute(node->getChild(i), ctxt);
+                    higBuffer[i] = lowBuffer[i];
+                } else {
+                    lowBuffer[i] = hasBounds && node->getChild(boundsBase + i) != nullptr
+                                           ? execute(node->getChild(boundsBase + i), ctxt)
+                                           : MIN_RAM_DOMAIN;
+                    higBuffer[i] = hasBounds && node->getChild(boundsBase + arity + i) != nullptr
+                                           ? execute(node->getChild(boundsBase + arity + i), ctxt)
+                                           : MAX_RAM_DOMAIN;
+                }
+            }
+            low = lowBuffer;
+            hig = higBuffer;
+        }
+
+        size_t viewId = node->getData(0);
+        auto& view = ctxt.getView(viewId);
+        InterpreterRelation& target = getRelation(node->getData(1));
+        RamDomain tuple[outArity];
+        size_t ticks = 0;
+        for (auto data : view->range(TupleRef(low, arity), TupleRef(hig, arity))) {
+            if (watchdogActive && (planAborted || ((++ticks & 0x3FF) == 0 && planExpired()))) {
+                return false;
+            }
+            ctxt[tupleId] = &data[0];
+            bool match = true;
+            for (size_t i = 0; i < numConditions; i++) {
+                if (!execute(node->getChild(arity + i), ctxt)) {
+                    match = false;
+                    break;
+                }
+            }
+            if (!match) {
+                continue;
+            }
+            for (size_t i = 0; i < outArity; i++) {
+                tuple[i] = execute(node->getChild(arity + numConditions + i), ctxt);
+            }
+            target.insert(tuple);
+        }
+        return true;
+        ESAC(IndexScanFilterProject)
+
         CASE(SubroutineReturnValue)
         for (size_t i = 0; i < cur->getValues().size(); ++i) {
             if (node->getChild(i) == nullptr) {
@@ -1023,18 +2627,56 @@ RamDomain InterpreterEngine::execute(const InterpreterNode* node, InterpreterCon
         ESAC(Sequence)
 
         CASE_NO_CAST(Parallel)
-        for (const auto& child : node->getChildren()) {
-            if (!execute(child.get(), ctxt)) {
-                return false;
+        auto& children = node->getChildren();
+        if (children.size() == 1) {
+            return execute(children[0].get(), ctxt);
+        }
+        // each branch is given its own copy of the context, such that
+        // concurrently executed statements do not interfere on views
+        std::atomic<bool> success(true);
+        PARALLEL_START;
+        pfor(size_t i = 0; i < children.size(); i++) {
+            InterpreterContext branchCtxt(ctxt);
+            if (!execute(children[i].get(), branchCtxt)) {
+                success = false;
             }
         }
-        return true;
+        PARALLEL_END;
+        return success;
         ESAC(Parallel)
 
         CASE_NO_CAST(Loop)
         resetIterationNumber();
-        while (execute(node->getChild(0), ctxt)) {
-            incIterationNumber();
+#ifdef _OPENMP
+        if (activeThreads > 1) {
+            // live feedback: once the deltas of the fixpoint shrink, the
+            // iterations become too short to amortize the parallel
+            // barriers -- drop to serial execution for the long tail and
+            // restore the team if an iteration grows large again
+            const long minParallelIterationUs = 1000;
+            bool serial = false;
+            for (;;) {
+                time_point start = now();
+                bool repeat = execute(node->getChild(0), ctxt);
+                bool tooShort = duration_in_us(start, now()) < minParallelIterationUs;
+                if (tooShort != serial) {
+                    serial = tooShort;
+                    omp_set_num_threads(serial ? 1 : activeThreads);
+                }
+                if (!repeat) {
+                    break;
+                }
+                incIterationNumber();
+            }
+            if (serial) {
+                omp_set_num_threads(activeThreads);
+            }
+        } else
+#endif
+        {
+            while (execute(node->getChild(0), ctxt)) {
+                incIterationNumber();
+            }
         }
         resetIterationNumber();
         return true;
@@ -1045,18 +2687,40 @@ RamDomain InterpreterEngine::execute(const InterpreterNode* node, InterpreterCon
         ESAC(Exit)
 
         CASE(LogRelationTimer)
-        Logger logger(cur->getMessage().c_str(), getIterationNumber(),
-                std::bind(&InterpreterRelation::size, &getRelation(node->getData(0))));
-        return execute(node->getChild(0), ctxt);
+        auto explainStart = now();
+        RamDomain result;
+        {
+            Logger logger(cur->getMessage().c_str(), getIterationNumber(),
+                    std::bind(&InterpreterRelation::size, &getRelation(node->getData(0))));
+            result = execute(node->getChild(0), ctxt);
+        }
+        {
+            auto lease = explainTimesLock.acquire();
+            (void)lease;
+            explainTimes[cur->getMessage()] +=
+                    std::chrono::duration_cast<std::chrono::microseconds>(now() - explainStart);
+        }
+        return result;
         ESAC(LogRelationTimer)
 
         CASE(LogTimer)
-        Logger logger(cur->getMessage().c_str(), getIterationNumber());
-        return execute(node->getChild(0), ctxt);
+        auto explainStart = now();
+        RamDomain result;
+        {
+            Logger logger(cur->getMessage().c_str(), getIterationNumber());
+            result = execute(node->getChild(0), ctxt);
+        }
+        {
+            auto lease = explainTimesLock.acquire();
+            (void)lease;
+            explainTimes[cur->getMessage()] +=
+                    std::chrono::duration_cast<std::chrono::microseconds>(now() - explainStart);
+        }
+        return result;
         ESAC(LogTimer)
 
         CASE(DebugInfo)
-        SignalHandler::instance()->setMsg(cur->getMessage().c_str());
+        SignalHandler::instance()->enterStatement(node->getData(0), cur->getMessage().c_str());
         return execute(node->getChild(0), ctxt);
         ESAC(DebugInfo)
 
@@ -1075,7 +2739,78 @@ RamDomain InterpreterEngine::execute(const InterpreterNode* node, InterpreterCon
                         cur->getIndex(), "relation", rel.first, "arity", std::to_string(rel.second));
             }
         }
-        return execute(node->getChild(0), ctxt);
+        {
+            // a stratum already completed by a resumed snapshot is not
+            // re-evaluated; its state is re-established from disk
+            if (completedStrata.find(cur->getIndex()) != completedStrata.end()) {
+                replayStratum(*cur);
+                return true;
+            }
+            // a memoizable stratum whose cache key matches an entry from a
+            // previous run is restored from disk instead of re-evaluated
+            bool memoize = false;
+            uint64_t memoEntry = 0;
+            if (Global::config().has("memo-dir") && isMemoizableStratum(*cur)) {
+                memoEntry = memoKey(*cur);
+                if (reuseMemoizedStratum(*cur, memoEntry)) {
+                    if (!isProvenance) {
+                        compactFinishedRelations(cur->getIndex());
+                    }
+                    if (Global::config().has("checkpoint-dir")) {
+                        checkpointStratum(*cur);
+                    }
+                    return true;
+                }
+                memoize = true;
+            }
+#ifdef _OPENMP
+            // per-stratum parallelism control: strata with little input
+            // lose more to thread startup and barriers than they gain
+            if (numOfThreads > 1) {
+                activeThreads = chooseStratumThreads(*cur);
+                omp_set_num_threads(activeThreads);
+            }
+#endif
+            RamDomain result = execute(node->getChild(0), ctxt);
+#ifdef _OPENMP
+            if (numOfThreads > 1 && activeThreads != numOfThreads) {
+                activeThreads = numOfThreads;
+                omp_set_num_threads(activeThreads);
+            }
+#endif
+            // all relations this stratum wrote last are read-only from here
+            // on; rebuild them into their compact representation
+            if (!isProvenance) {
+                compactFinishedRelations(cur->getIndex());
+            }
+            if (profileEnabled) {
+                // record the final memory footprint of every relation this
+                // stratum wrote last
+                buildLastStratumWrite();
+                const bool structureStats = Global::config().has("data-structure-stats");
+                for (auto& handle : relations) {
+                    if (handle == nullptr || handle->getName()[0] == '@') {
+                        continue;
+                    }
+                    auto pos = lastStratumWrite.find(handle->getName());
+                    if (pos != lastStratumWrite.end() && pos->second == cur->getIndex()) {
+                        ProfileEventSingleton::instance().makeQuantityEvent(
+                                "@relation-memory;" + handle->getName(), handle->getMemoryUsage(),
+                                cur->getIndex());
+                        if (structureStats) {
+                            emitStructureStats(*handle, cur->getIndex());
+                        }
+                    }
+                }
+            }
+            if (memoize) {
+                memoizeStratum(*cur, memoEntry);
+            }
+            if (Global::config().has("checkpoint-dir")) {
+                checkpointStratum(*cur);
+            }
+            return result;
+        }
         ESAC(Stratum)
 
         CASE(Create)
@@ -1084,11 +2819,15 @@ RamDomain InterpreterEngine::execute(const InterpreterNode* node, InterpreterCon
         ESAC(Create)
 
         CASE_NO_CAST(Clear)
+        joinPendingStore(getRelation(node->getData(0)).getName());
         getRelation(node->getData(0)).purge();
         return true;
         ESAC(Clear)
 
         CASE_NO_CAST(Drop)
+        // free the parked tuples of a streamed relation whose guarded
+        // consuming scan never ran
+        streamedBuffers.erase(getRelation(node->getData(0)).getName());
         dropRelation(node->getData(0));
         return true;
         ESAC(Drop)
@@ -1101,6 +2840,92 @@ RamDomain InterpreterEngine::execute(const InterpreterNode* node, InterpreterCon
         ESAC(LogSize)
 
         CASE(Load)
+        joinPendingStore(getRelation(node->getData(0)).getName());
+        // a load proven single-scan parks its tuples for the consuming
+        // scan instead of materializing them into the relation
+        const bool streamed = streamedLoads.find(cur) != streamedLoads.end();
+        // consume tuples parsed ahead of time by a background I/O thread
+        auto staged = stagedLoads.find(cur);
+        if (staged != stagedLoads.end()) {
+            auto result = staged->second.get();
+            stagedLoads.erase(staged);
+            if (result.first) {
+                if (streamed) {
+                    streamedBuffers[cur->getRelation().getName()] = std::move(result.second);
+                    return true;
+                }
+                InterpreterRelation& relation = getRelation(node->getData(0));
+                const std::size_t width = cur->getRelation().getAttributeTypeQualifiers().size();
+                const std::size_t count = result.second.size() / width;
+                // the annotation-widened provenance btrees build much
+                // faster from sorted runs than from random inserts
+                if (isProvenance) {
+                    relation.insertBatch(result.second.data(), count);
+                    return true;
+                }
+#ifdef _OPENMP
+#pragma omp parallel for schedule(dynamic, 1024)
+#endif
+                for (std::size_t i = 0; i < count; ++i) {
+                    relation.insert(&result.second[i * width]);
+                }
+                return true;
+            }
+        }
+        if (streamed) {
+            std::vector<RamDomain> buffer;
+            bool parked = true;
+            for (IODirectives ioDirectives : cur->getIODirectives()) {
+                try {
+                    std::vector<bool> symbolMask;
+                    for (auto& attr : cur->getRelation().getAttributeTypeQualifiers()) {
+                        symbolMask.push_back(attr[0] == 's');
+                    }
+                    auto reader = IOSystem::getInstance().getReader(symbolMask, getSymbolTable(),
+                            ioDirectives, Global::config().has("provenance"));
+                    if (!reader->readAllInto(buffer)) {
+                        // a reader without buffered parsing; materialize as
+                        // usual and let the scan fall back to the relation
+                        parked = false;
+                        break;
+                    }
+                } catch (std::exception& e) {
+                    std::cerr << "Error loading data: " << e.what() << "\n";
+                }
+            }
+            if (parked) {
+                streamedBuffers[cur->getRelation().getName()] = std::move(buffer);
+                return true;
+            }
+        }
+        // without the load pipeline, provenance-mode loads still go through
+        // the sorted batch path; see the staged branch above
+        const std::size_t width = cur->getRelation().getAttributeTypeQualifiers().size();
+        if (isProvenance && width > 0) {
+            std::vector<RamDomain> buffer;
+            bool buffered = true;
+            for (IODirectives ioDirectives : cur->getIODirectives()) {
+                try {
+                    std::vector<bool> symbolMask;
+                    for (auto& attr : cur->getRelation().getAttributeTypeQualifiers()) {
+                        symbolMask.push_back(attr[0] == 's');
+                    }
+                    auto reader = IOSystem::getInstance().getReader(symbolMask, getSymbolTable(),
+                            ioDirectives, Global::config().has("provenance"));
+                    if (!reader->readAllInto(buffer)) {
+                        // a reader without buffered parsing; insert as usual
+                        buffered = false;
+                        break;
+                    }
+                } catch (std::exception& e) {
+                    std::cerr << "Error loading data: " << e.what() << "\n";
+                }
+            }
+            if (buffered) {
+                getRelation(node->getData(0)).insertBatch(buffer.data(), buffer.size() / width);
+                return true;
+            }
+        }
         for (IODirectives ioDirectives : cur->getIODirectives()) {
             try {
                 InterpreterRelation& relation = getRelation(node->getData(0));
@@ -1120,20 +2945,32 @@ RamDomain InterpreterEngine::execute(const InterpreterNode* node, InterpreterCon
         ESAC(Load)
 
         CASE(Store)
-        for (IODirectives ioDirectives : cur->getIODirectives()) {
-            try {
-                std::vector<bool> symbolMask;
-                for (auto& cur : cur->getRelation().getAttributeTypeQualifiers()) {
-                    symbolMask.push_back(cur[0] == 's');
+        InterpreterRelation& relation = getRelation(node->getData(0));
+        auto writeOut = [this, cur, &relation]() {
+            for (IODirectives ioDirectives : cur->getIODirectives()) {
+                try {
+                    std::vector<bool> symbolMask;
+                    for (auto& attr : cur->getRelation().getAttributeTypeQualifiers()) {
+                        symbolMask.push_back(attr[0] == 's');
+                    }
+                    IOSystem::getInstance()
+                            .getWriter(symbolMask, getSymbolTable(), ioDirectives,
+                                    Global::config().has("provenance"))
+                            ->writeAll(relation);
+                } catch (std::exception& e) {
+                    std::cerr << e.what();
+                    exit(1);
                 }
-                IOSystem::getInstance()
-                        .getWriter(symbolMask, getSymbolTable(), ioDirectives,
-                                Global::config().has("provenance"))
-                        ->writeAll(getRelation(node->getData(0)));
-            } catch (std::exception& e) {
-                std::cerr << e.what();
-                exit(1);
             }
+        };
+        if (Global::config().has("pipeline-store")) {
+            // hand the write to a background I/O thread; the stratum
+            // schedule never mutates a relation after it was stored, and
+            // the remaining mutation sites join the pending write first
+            joinPendingStore(relation.getName());
+            pendingStores[relation.getName()] = std::async(std::launch::async, writeOut);
+        } else {
+            writeOut();
         }
         return true;
         ESAC(Store)
@@ -1149,6 +2986,18 @@ RamDomain InterpreterEngine::execute(const InterpreterNode* node, InterpreterCon
         return true;
         ESAC(Fact)
 
+        CASE(FactTable)
+        {
+            const std::vector<RamDomain>& table = cur->getTable();
+            const size_t arity = cur->getRelation().getArity();
+            InterpreterRelation& rel = getRelation(node->getData(0));
+            for (size_t i = 0; i < table.size(); i += arity) {
+                rel.insert(&table[i]);
+            }
+        }
+        return true;
+        ESAC(FactTable)
+
         CASE_NO_CAST(Query)
         InterpreterPreamble* preamble = node->getPreamble();
 
@@ -1183,7 +3032,43 @@ RamDomain InterpreterEngine::execute(const InterpreterNode* node, InterpreterCon
                 ctxt.createView(*getRelationHandle(info[0]), info[1], info[2]);
             }
         }
-        execute(node->getChild(0), ctxt);
+
+        // run the plan; when the rule watchdog is armed and the query
+        // carries alternative plans, a plan exceeding its budget is
+        // unwound and the next alternative is tried -- the last one
+        // without a deadline. Re-execution is safe since inserts are
+        // set-based: tuples the aborted plan already produced are
+        // simply deduplicated.
+        const size_t numPlans = node->getChildren().size();
+        if (ruleBudget == 0 || numPlans == 1) {
+            execute(node->getChild(0), ctxt);
+        } else {
+            for (size_t plan = 0; plan < numPlans; plan++) {
+                watchdogActive = plan + 1 < numPlans;
+                planAborted = false;
+                if (watchdogActive) {
+                    planDeadline = std::chrono::steady_clock::now() + std::chrono::seconds(ruleBudget);
+                }
+                if (plan == 1 && preamble->isParallel) {
+                    // the aborted plan created its views per worker thread;
+                    // the serial alternatives need them in this context
+                    auto& viewsForNested = preamble->getViewInfoForNested();
+                    for (auto& info : viewsForNested) {
+                        ctxt.createView(*getRelationHandle(info[0]), info[1], info[2]);
+                    }
+                }
+                execute(node->getChild(plan), ctxt);
+                if (!watchdogActive || !planAborted) {
+                    break;
+                }
+            }
+            watchdogActive = false;
+            planAborted = false;
+        }
+        // discard hash-join tables built for this query
+        if (!joinTables.empty()) {
+            joinTables.clear();
+        }
         return true;
         ESAC(Query)
 
@@ -1192,6 +3077,9 @@ RamDomain InterpreterEngine::execute(const InterpreterNode* node, InterpreterCon
         InterpreterRelation& src = getRelation(node->getData(0));
         InterpreterRelation& trg = getRelation(node->getData(1));
 
+        joinPendingStore(src.getName());
+        joinPendingStore(trg.getName());
+
         if (dynamic_cast<InterpreterEqRelation*>(&trg) != nullptr) {
             // expand src with the new knowledge generated by insertion.
             src.extend(trg);
@@ -1205,12 +3093,26 @@ RamDomain InterpreterEngine::execute(const InterpreterNode* node, InterpreterCon
 
         CASE_NO_CAST(Swap)
         swapRelation(node->getData(0), node->getData(1));
+        // secondary delta indexes that no rule version read during the past
+        // iteration stop being maintained for the remaining iterations
+        getRelation(node->getData(0)).releaseIdleIndexes();
+        getRelation(node->getData(1)).releaseIdleIndexes();
+        // near-empty deltas of long-tail fixpoints still hold the tree
+        // grown for the early wide frontiers; rebuild them between
+        // iterations to return the slack memory
+        getRelation(node->getData(0)).compactIfSparse();
+        getRelation(node->getData(1)).compactIfSparse();
         return true;
         ESAC(Swap)
 
+#ifdef USE_COMPUTED_GOTO
+    assert(false && "Unhandled\n");
+    return 0;
+#else
         default:
             assert(false && "Unhandled\n");
     }
+#endif
 }
 
 }  // namespace souffle
@@ -21,14 +21,20 @@
 #include "InterpreterNode.h"
 #include "InterpreterPreamble.h"
 #include "InterpreterRelation.h"
+#include "JoinHashTable.h"
 #include "RamTranslationUnit.h"
 #include "RamVisitor.h"
+#include <chrono>
 #include <deque>
+#include <future>
 #include <map>
 #include <memory>
+#include <mutex>
+#include <set>
 #include <string>
 #include <vector>
 #include <dlfcn.h>
+#include <ffi.h>
 
 namespace souffle {
 
@@ -46,12 +52,18 @@ public:
     InterpreterEngine(RamTranslationUnit& tUnit)
             : isProvenance(Global::config().has("provenance")),
               profileEnabled(Global::config().has("profile")),
-              numOfThreads(std::stoi(Global::config().get("jobs"))), tUnit(tUnit),
+              numOfThreads(std::stoi(Global::config().get("jobs"))),
+              ruleBudget(Global::config().has("rule-budget")
+                              ? std::stoul(Global::config().get("rule-budget"))
+                              : 0),
+              tUnit(tUnit),
               isa(tUnit.getAnalysis<RamIndexAnalysis>()), generator(isa) {
 #ifdef _OPENMP
         if (numOfThreads > 0) {
             omp_set_num_threads(numOfThreads);
         }
+        pinThreads(numOfThreads);
+        activeThreads = numOfThreads;
 #endif
     }
     /** @brief Execute the main program */
@@ -59,6 +71,8 @@ public:
     /** @brief Execute the subroutine program */
     void executeSubroutine(const std::string& name, const std::vector<RamDomain>& args,
             std::vector<RamDomain>& ret, std::vector<bool>& err);
+    /** @brief Print the executed RAM program, annotated with measured times and tuple counts */
+    void printExplainAnalysis(std::ostream& os);
 
 private:
     /** @brief Create a relation */
@@ -67,6 +81,44 @@ private:
     void dropRelation(const size_t relId);
     /** @brief Swap the content of two relations */
     void swapRelation(const size_t ramRel1, const size_t ramRel2);
+    /** @brief Compact all relations that received their last update in the given stratum */
+    void compactFinishedRelations(const int stratum);
+    /** @brief Determine for each relation the last stratum updating it */
+    void buildLastStratumWrite();
+    /** @brief Snapshot the relations a completed stratum wrote last, plus symbols and records */
+    void checkpointStratum(const RamStratum& stratum);
+    /** @brief Re-establish the state of a stratum completed in a previous run from its snapshot */
+    void replayStratum(const RamStratum& stratum);
+    /** @brief Load the completed-strata manifest, symbol table and record maps of a snapshot */
+    void restoreSnapshot();
+    /** @brief Determine whether skipping a stratum's evaluation on a memo hit is unobservable */
+    bool isMemoizableStratum(const RamStratum& stratum);
+    /** @brief Compute the memo cache key of a stratum from its RAM text and its input relations */
+    uint64_t memoKey(const RamStratum& stratum);
+    /** @brief Restore the output relations of a stratum from a matching memo entry, if any */
+    bool reuseMemoizedStratum(const RamStratum& stratum, uint64_t key);
+    /** @brief Store the output relations of an evaluated stratum as a memo entry */
+    void memoizeStratum(const RamStratum& stratum, uint64_t key);
+    /** @brief Write per-relation cardinalities, column distinct counts and index hits to a file */
+    void dumpRelationStatistics(const std::string& filename);
+    /** @brief Record per-index structure statistics of a relation in the profile log */
+    void emitStructureStats(const InterpreterRelation& rel, int stratumIndex);
+    /** @brief Start parsing all input fact files on background I/O threads */
+    void prefetchLoads();
+    /** @brief Renumber symbols assigned during parallel loading into the order a sequential load
+     * would have produced, rewriting the staged tuple buffers accordingly */
+    void renumberStagedSymbols();
+    /** @brief Determine the loads whose relation is consumed by exactly one full scan;
+     * their tuples bypass materialization and stream through the scan's rule */
+    void identifyStreamedLoads();
+    /** @brief Wait for a background store of the given relation, if one is in flight */
+    void joinPendingStore(const std::string& relName);
+    /** @brief Wait for all background stores still in flight */
+    void joinPendingStores();
+    /** @brief Pick the thread count for a stratum from the size of its input relations */
+    size_t chooseStratumThreads(const RamStratum& stratum);
+    /** @brief Determine whether a relation is only ever written by facts and loads */
+    bool isInputOnlyRelation(const RamRelation& rel);
     /** @brief Return a relation on the given index */
     InterpreterRelation& getRelation(const size_t idx);
     /** @brief Return a reference to the relation on the given index */
@@ -77,8 +129,12 @@ private:
     RamTranslationUnit& getTranslationUnit();
     /** @brief Execute the program */
     RamDomain execute(const InterpreterNode*, InterpreterContext&);
+    /** @brief Check the plan running under the watchdog against its deadline */
+    bool planExpired();
     /** @brief Return method handler */
     void* getMethodHandle(const std::string& method);
+    /** @brief Resolve all user-defined operators of the program ahead of evaluation */
+    void resolveFunctorCalls();
     /** @brief Load DLL */
     const std::vector<void*>& loadDLL();
     /** @brief Return current iteration number for loop operation */
@@ -102,6 +158,16 @@ private:
     const bool profileEnabled;
     /** Number of threads enabled for this program */
     size_t numOfThreads;
+    /** Thread count granted to the stratum currently executing */
+    size_t activeThreads = 1;
+    /** Seconds a rule plan may run before the watchdog abandons it; 0 disables the watchdog */
+    const size_t ruleBudget;
+    /** Whether the plan currently executing runs under a deadline */
+    bool watchdogActive = false;
+    /** Deadline of the plan currently under the watchdog */
+    std::chrono::steady_clock::time_point planDeadline;
+    /** Raised once the running plan exceeded its budget; unwinds its scans */
+    std::atomic<bool> planAborted{false};
     /** Profile counter */
     std::atomic<RamDomain> counter{0};
     /** Loop iteration counter */
@@ -110,6 +176,46 @@ private:
     std::map<std::string, std::deque<std::atomic<size_t>>> frequencies;
     /** Profile for relation reads */
     std::map<std::string, std::atomic<size_t>> reads;
+    /** Accumulated runtime per timed scope, feeding the explain output */
+    std::map<std::string, std::chrono::microseconds> explainTimes;
+    /** Synchronizes time accumulation across parallel strata */
+    Lock explainTimesLock;
+    /** Index of the last stratum updating each relation */
+    std::map<std::string, int> lastStratumWrite;
+    /** Relations written by a rule; lazily computed, guarded by the flag below */
+    std::set<std::string> ruleWrittenRelations;
+    bool ruleWrittenComputed = false;
+    /** Whether the last-write map has been computed yet */
+    bool lastStratumWriteValid = false;
+    /** Strata already completed by the snapshot being resumed */
+    std::set<int> completedStrata;
+    /** A staged load: whether staging succeeded, and the parsed tuples */
+    using StagedTuples = std::pair<bool, std::vector<RamDomain>>;
+    /** Input tuples parsed ahead of time per load statement */
+    std::map<const RamLoad*, std::future<StagedTuples>> stagedLoads;
+    /** Number of symbols present before the staged loads started parsing */
+    size_t preloadSymbolCount = 0;
+    /** Loads proven single-scan; their tuples are parked for the consuming scan */
+    std::set<const RamLoad*> streamedLoads;
+    /** Parked input tuples awaiting their single consuming scan, per relation */
+    std::map<std::string, std::vector<RamDomain>> streamedBuffers;
+    /** Output writes running on background I/O threads, per relation */
+    std::map<std::string, std::future<void>> pendingStores;
+    /** A resolved user-defined operator call: its entry point and the
+     * prepared call interface, built once instead of per evaluated tuple */
+    struct FunctorCall {
+        void (*fn)();
+        ffi_cif cif;
+        std::vector<ffi_type*> argTypes;
+    };
+    /** Resolved user-defined operator calls per RAM operator */
+    std::map<const RamNode*, std::unique_ptr<FunctorCall>> functorCalls;
+    /** Whether the user-defined operators have been resolved yet */
+    bool functorCallsResolved = false;
+    /** Transient hash-join tables per hash scan, alive for one query */
+    std::map<const RamNode*, std::unique_ptr<JoinHashTable>> joinTables;
+    /** Synchronizes the construction of hash-join tables */
+    Lock joinTablesLock;
     /** DLL */
     std::vector<void*> dll;
     /** Program */
@@ -118,6 +224,9 @@ private:
     RamIndexAnalysis* isa;
     /** Interpreter program generator */
     NodeGenerator generator;
+    /** Serializes subroutine invocations; the generator state they rebuild is
+     * shared, so concurrent callers such as batch explain must take turns */
+    std::mutex subroutineMutex;
 };
 
 }  // namespace souffle
@@ -17,11 +17,15 @@
 
 #pragma once
 
+#include "Global.h"
 #include "InterpreterNode.h"
 #include "InterpreterPreamble.h"
 #include "InterpreterRecords.h"
 #include "RamIndexAnalysis.h"
+#include "RamTypes.h"
 #include "RamVisitor.h"
+#include <algorithm>
+#include <cmath>
 #include <memory>
 
 namespace souffle {
@@ -44,28 +48,51 @@ public:
      */
     NodePtr generateTree(const RamNode& root) {
         // Encode all relation, indexPos and viewId.
+        frameSize = 0;
+        maxViews = 0;
         visitDepthFirst(root, [&](const RamNode& node) {
-            if (dynamic_cast<const RamQuery*>(&node) != nullptr) {
+            if (const auto* query = dynamic_cast<const RamQuery*>(&node)) {
                 newQueryBlock();
+                // the alternative plans of a query are hidden from visitors;
+                // encode their nodes into the view block of the query itself
+                for (const RamOperation* alt : query->getAlternatives()) {
+                    visitDepthFirst(*alt, [&](const RamNode& cur) { encodeNode(cur); });
+                }
             }
-            if (const auto* create = dynamic_cast<const RamCreate*>(&node)) {
-                encodeRelation(create->getRelation());
-            }
-            if (const auto* indexSearch = dynamic_cast<const RamIndexOperation*>(&node)) {
-                encodeIndexPos(*indexSearch);
-                encodeView(indexSearch);
-            } else if (const auto* exists = dynamic_cast<const RamExistenceCheck*>(&node)) {
-                encodeIndexPos(*exists);
-                encodeView(exists);
-            } else if (const auto* provExists = dynamic_cast<const RamProvenanceExistenceCheck*>(&node)) {
-                encodeIndexPos(*provExists);
-                encodeView(provExists);
-            }
+            encodeNode(node);
         });
         // Parse program
         return visit(root);
     }
 
+    /**
+     * @brief Return the number of progress slots handed out to debug-info statements.
+     */
+    size_t getNumDebugStatements() const {
+        return numDebugStatements;
+    }
+
+    /**
+     * @brief Return the number of tuple slots a frame of the generated tree requires.
+     */
+    size_t getFrameSize() const {
+        return frameSize;
+    }
+
+    /**
+     * @brief Return the largest number of views alive in any query of the generated tree.
+     */
+    size_t getMaxViews() const {
+        return maxViews;
+    }
+
+    /**
+     * @brief Return the relation id assigned to the given relation during generation.
+     */
+    size_t getRelationId(const RamRelation& rel) {
+        return encodeRelation(rel);
+    }
+
     NodePtr visitNumber(const RamNumber& num) override {
         return std::make_unique<InterpreterNode>(I_Number, &num);
     }
@@ -83,6 +110,14 @@ public:
         for (const auto& arg : op.getArguments()) {
             children.push_back(visit(arg));
         }
+        // purely numeric functors over constant arguments are evaluated once
+        // here; as children fold bottom-up, whole constant chains collapse
+        // into a single precomputed node without per-tuple dispatch
+        RamDomain value = 0;
+        if (foldIntrinsicOperator(op, children, value)) {
+            return std::make_unique<InterpreterNode>(
+                    I_PrecomputedNumber, &op, NodePtrVec{}, std::vector<size_t>{static_cast<size_t>(value)});
+        }
         return std::make_unique<InterpreterNode>(I_IntrinsicOperator, &op, std::move(children));
     }
 
@@ -142,8 +177,11 @@ public:
         std::vector<size_t> data;
         data.push_back(encodeRelation(exists.getRelation()));
         data.push_back(encodeView(&exists));
-        return std::make_unique<InterpreterNode>(
+        auto res = std::make_unique<InterpreterNode>(
                 I_ExistenceCheck, &exists, std::move(children), std::move(data));
+        size_t arity = exists.getValues().size();
+        foldConstantBounds(*res, arity, arity);
+        return res;
     }
 
     NodePtr visitProvenanceExistenceCheck(const RamProvenanceExistenceCheck& provExists) override {
@@ -157,11 +195,35 @@ public:
                 I_ProvenanceExistenceCheck, &provExists, std::move(children), std::move(data));
     }
 
+    NodePtr visitSubsumptionCheck(const RamSubsumptionCheck& subsumes) override {
+        NodePtrVec children;
+        for (const auto& value : subsumes.getValues()) {
+            children.push_back(visit(value));
+        }
+        std::vector<size_t> data;
+        data.push_back(encodeRelation(subsumes.getRelation()));
+        data.push_back(encodeView(&subsumes));
+        return std::make_unique<InterpreterNode>(
+                I_SubsumptionCheck, &subsumes, std::move(children), std::move(data));
+    }
+
     // -- comparison operators --
     NodePtr visitConstraint(const RamConstraint& relOp) override {
         NodePtrVec children;
         children.push_back(visit(relOp.getLHS()));
         children.push_back(visit(relOp.getRHS()));
+        // numeric comparisons whose operands folded to constants are decided
+        // here instead of being re-evaluated for every tuple
+        RamDomain lhs = 0;
+        RamDomain rhs = 0;
+        bool result = false;
+        if (getConstant(children[0], lhs) && getConstant(children[1], rhs) &&
+                foldConstraint(relOp.getOperator(), lhs, rhs, result)) {
+            if (result) {
+                return std::make_unique<InterpreterNode>(I_True, &relOp);
+            }
+            return std::make_unique<InterpreterNode>(I_False, &relOp);
+        }
         return std::make_unique<InterpreterNode>(I_Constraint, &relOp, std::move(children));
     }
 
@@ -176,6 +238,49 @@ public:
     }
 
     NodePtr visitScan(const RamScan& scan) override {
+        // fuse the dominant scan -> filter* -> project chain into a single
+        // superinstruction, saving the per-tuple dispatch hops; profiling
+        // needs the individual nodes for its frequency counters
+        std::vector<const RamCondition*> conditions;
+        const RamProject* project = matchFilterProject(scan.getOperation(), conditions);
+        if (project != nullptr && !Global::config().has("profile")) {
+            NodePtrVec children;
+            for (const RamCondition* condition : conditions) {
+                children.push_back(visit(*condition));
+            }
+            for (const auto& value : project->getValues()) {
+                children.push_back(visit(value));
+            }
+            std::vector<size_t> data;
+            data.push_back(encodeRelation(scan.getRelation()));
+            data.push_back(encodeRelation(project->getRelation()));
+            data.push_back(conditions.size());
+            data.push_back(scan.getTupleId());
+            // a filter-free projection copying source columns unchanged can
+            // skip duplicates of those columns at runtime if they form a
+            // prefix of the scan order; record the copied columns so the
+            // engine can check them against the order of the scanned index
+            bool plainProjection = conditions.empty();
+            std::set<size_t> projected;
+            for (const auto& value : project->getValues()) {
+                const auto* element = dynamic_cast<const RamTupleElement*>(value);
+                if (element == nullptr || element->getTupleId() != scan.getTupleId()) {
+                    plainProjection = false;
+                    break;
+                }
+                projected.insert(element->getElement());
+            }
+            data.push_back(plainProjection ? 1 : 0);
+            if (plainProjection) {
+                data.push_back(projected.size());
+                for (const size_t column : projected) {
+                    data.push_back(column);
+                }
+            }
+            return std::make_unique<InterpreterNode>(
+                    I_ScanFilterProject, &scan, std::move(children), std::move(data));
+        }
+
         NodePtrVec children;
         children.push_back(visitTupleOperation(scan));
         std::vector<size_t> data;
@@ -195,14 +300,58 @@ public:
     }
 
     NodePtr visitIndexScan(const RamIndexScan& scan) override {
+        // fuse an index scan whose body is a chain of filters ending in a
+        // projection, as for visitScan above
+        std::vector<const RamCondition*> conditions;
+        const RamProject* project = matchFilterProject(scan.getOperation(), conditions);
+        if (project != nullptr && !Global::config().has("profile")) {
+            NodePtrVec children;
+            for (const auto& value : scan.getRangePattern()) {
+                children.push_back(visit(value));
+            }
+            for (const RamCondition* condition : conditions) {
+                children.push_back(visit(*condition));
+            }
+            for (const auto& value : project->getValues()) {
+                children.push_back(visit(value));
+            }
+            appendRangeBounds(scan, children);
+            std::vector<size_t> data;
+            data.push_back(encodeView(&scan));
+            data.push_back(encodeRelation(project->getRelation()));
+            data.push_back(conditions.size());
+            data.push_back(scan.getTupleId());
+            data.push_back(project->getValues().size());
+            auto res = std::make_unique<InterpreterNode>(
+                    I_IndexScanFilterProject, &scan, std::move(children), std::move(data));
+            size_t arity = scan.getRelation().getArity();
+            foldConstantBounds(*res, arity, arity + conditions.size() + project->getValues().size());
+            return res;
+        }
+
         NodePtrVec children;
         for (const auto& value : scan.getRangePattern()) {
             children.push_back(visit(value));
         }
         children.push_back(visitTupleOperation(scan));
+        appendRangeBounds(scan, children);
         std::vector<size_t> data;
         data.push_back((encodeView(&scan)));
-        return std::make_unique<InterpreterNode>(I_IndexScan, &scan, std::move(children), std::move(data));
+        auto res = std::make_unique<InterpreterNode>(I_IndexScan, &scan, std::move(children), std::move(data));
+        size_t arity = scan.getRelation().getArity();
+        foldConstantBounds(*res, arity, arity + 1);
+        return res;
+    }
+
+    NodePtr visitHashScan(const RamHashScan& hscan) override {
+        NodePtrVec children;
+        for (const auto& value : hscan.getRangePattern()) {
+            children.push_back(visit(value));
+        }
+        children.push_back(visitTupleOperation(hscan));
+        std::vector<size_t> data;
+        data.push_back(encodeRelation(hscan.getRelation()));
+        return std::make_unique<InterpreterNode>(I_HashScan, &hscan, std::move(children), std::move(data));
     }
 
     NodePtr visitParallelIndexScan(const RamParallelIndexScan& piscan) override {
@@ -211,12 +360,15 @@ public:
             children.push_back(visit(value));
         }
         children.push_back(visitTupleOperation(piscan));
+        appendRangeBounds(piscan, children);
         std::vector<size_t> data;
         data.push_back((encodeRelation(piscan.getRelation())));
         data.push_back((encodeIndexPos(piscan)));
         auto res = std::make_unique<InterpreterNode>(
                 I_ParallelIndexScan, &piscan, std::move(children), std::move(data));
         res->setPreamble(parentQueryPreamble);
+        size_t arity = piscan.getRelation().getArity();
+        foldConstantBounds(*res, arity, arity + 1);
         return res;
     }
 
@@ -248,10 +400,14 @@ public:
         }
         children.push_back(visit(choice.getCondition()));
         children.push_back(visitTupleOperation(choice));
+        appendRangeBounds(choice, children);
         std::vector<size_t> data;
         data.push_back((encodeView(&choice)));
-        return std::make_unique<InterpreterNode>(
+        auto res = std::make_unique<InterpreterNode>(
                 I_IndexChoice, &choice, std::move(children), std::move(data));
+        size_t arity = choice.getRelation().getArity();
+        foldConstantBounds(*res, arity, arity + 2);
+        return res;
     }
 
     NodePtr visitParallelIndexChoice(const RamParallelIndexChoice& ichoice) override {
@@ -261,12 +417,15 @@ public:
         }
         children.push_back(visit(ichoice.getCondition()));
         children.push_back(visit(ichoice.getOperation()));
+        appendRangeBounds(ichoice, children);
         std::vector<size_t> data;
         data.push_back((encodeRelation(ichoice.getRelation())));
         data.push_back((encodeIndexPos(ichoice)));
         auto res = std::make_unique<InterpreterNode>(
                 I_ParallelIndexChoice, &ichoice, std::move(children), std::move(data));
         res->setPreamble(parentQueryPreamble);
+        size_t arity = ichoice.getRelation().getArity();
+        foldConstantBounds(*res, arity, arity + 2);
         return res;
     }
 
@@ -289,6 +448,19 @@ public:
                 I_Aggregate, &aggregate, std::move(children), std::move(data));
     }
 
+    NodePtr visitParallelAggregate(const RamParallelAggregate& aggregate) override {
+        NodePtrVec children;
+        children.push_back(visit(aggregate.getCondition()));
+        children.push_back(visit(aggregate.getExpression()));
+        children.push_back(visitTupleOperation(aggregate));
+        std::vector<size_t> data;
+        data.push_back((encodeRelation(aggregate.getRelation())));
+        auto res = std::make_unique<InterpreterNode>(
+                I_ParallelAggregate, &aggregate, std::move(children), std::move(data));
+        res->setPreamble(parentQueryPreamble);
+        return res;
+    }
+
     NodePtr visitIndexAggregate(const RamIndexAggregate& aggregate) override {
         NodePtrVec children;
         for (const auto& value : aggregate.getRangePattern()) {
@@ -297,11 +469,15 @@ public:
         children.push_back(visit(aggregate.getCondition()));
         children.push_back(visit(aggregate.getExpression()));
         children.push_back(visitTupleOperation(aggregate));
+        appendRangeBounds(aggregate, children);
         std::vector<size_t> data;
         data.push_back((encodeRelation(aggregate.getRelation())));
         data.push_back((encodeView(&aggregate)));
-        return std::make_unique<InterpreterNode>(
+        auto res = std::make_unique<InterpreterNode>(
                 I_IndexAggregate, &aggregate, std::move(children), std::move(data));
+        size_t arity = aggregate.getRelation().getArity();
+        foldConstantBounds(*res, arity, arity + 3);
+        return res;
     }
 
     NodePtr visitBreak(const RamBreak& breakOp) override {
@@ -318,6 +494,14 @@ public:
         return std::make_unique<InterpreterNode>(I_Filter, &filter, std::move(children));
     }
 
+    NodePtr visitSplit(const RamSplit& split) override {
+        NodePtrVec children;
+        for (const auto& body : split.getBodies()) {
+            children.push_back(visit(*body));
+        }
+        return std::make_unique<InterpreterNode>(I_Split, &split, std::move(children));
+    }
+
     NodePtr visitProject(const RamProject& project) override {
         NodePtrVec children;
         for (const auto& value : project.getValues()) {
@@ -346,7 +530,6 @@ public:
     }
 
     NodePtr visitParallel(const RamParallel& parallel) override {
-        // Parallel statements are executed in sequence for now.
         NodePtrVec children;
         for (const auto& value : parallel.getStatements()) {
             children.push_back(visit(value));
@@ -384,7 +567,10 @@ public:
     NodePtr visitDebugInfo(const RamDebugInfo& dbg) override {
         NodePtrVec children;
         children.push_back(visit(dbg.getStatement()));
-        return std::make_unique<InterpreterNode>(I_DebugInfo, &dbg, std::move(children));
+        // assign the statement its progress slot (See SignalHandler)
+        std::vector<size_t> data;
+        data.push_back(numDebugStatements++);
+        return std::make_unique<InterpreterNode>(I_DebugInfo, &dbg, std::move(children), std::move(data));
     }
 
     NodePtr visitStratum(const RamStratum& stratum) override {
@@ -439,6 +625,12 @@ public:
         return std::make_unique<InterpreterNode>(I_Fact, &fact, std::move(children), std::move(data));
     }
 
+    NodePtr visitFactTable(const RamFactTable& facts) override {
+        std::vector<size_t> data;
+        data.push_back((encodeRelation(facts.getRelation())));
+        return std::make_unique<InterpreterNode>(I_FactTable, &facts, NodePtrVec{}, std::move(data));
+    }
+
     NodePtr visitQuery(const RamQuery& query) override {
         std::shared_ptr<InterpreterPreamble> preamble = std::make_shared<InterpreterPreamble>();
         parentQueryPreamble = preamble;
@@ -483,6 +675,18 @@ public:
         NodePtrVec children;
         children.push_back(visit(*next));
 
+        // generate the alternative plans attached for the rule watchdog;
+        // their views join the nested view set of the query
+        for (const RamOperation* alt : query.getAlternatives()) {
+            visitDepthFirst(*alt, [&](const RamNode& node) {
+                if (requireView(&node) == true) {
+                    const auto& rel = getRelationRefForView(&node);
+                    preamble->addViewInfoForNested(encodeRelation(rel), indexTable[&node], encodeView(&node));
+                };
+            });
+            children.push_back(visit(*alt));
+        }
+
         auto res = std::make_unique<InterpreterNode>(I_Query, &query, std::move(children));
         res->setPreamble(parentQueryPreamble);
         return res;
@@ -524,6 +728,12 @@ private:
     size_t viewId = 0;
     /** Next available location to encode a relation */
     size_t relId = 0;
+    /** Next available progress slot for a debug-info statement */
+    size_t numDebugStatements = 0;
+    /** Number of tuple slots required by a frame of the generated tree */
+    size_t frameSize = 0;
+    /** Largest number of views alive in any query of the generated tree */
+    size_t maxViews = 0;
     /** Environment encoding, store a mapping from RamNode to its View id. */
     std::unordered_map<const RamNode*, size_t> viewTable;
     /** Environment encoding, store a mapping from RamRelation to its id */
@@ -542,6 +752,7 @@ private:
 
     /** @brief Get a valid view id for encoding */
     size_t getNextViewId() {
+        maxViews = std::max(maxViews, viewId + 1);
         return viewId++;
     }
 
@@ -559,6 +770,39 @@ private:
         return i;
     };
 
+    /** @brief Append the bound expressions of a range-restricted index operation
+     *
+     * The lower and upper bounds are appended behind the regular children of
+     * the node (lower bounds first), such that the child layout of operations
+     * without bounds remains unchanged.
+     */
+    /**
+     * @brief Matches a body consisting of a chain of filters ending in a
+     * projection, collecting the filter conditions along the way; returns
+     * the projection, or nullptr if the body has any other shape.
+     */
+    const RamProject* matchFilterProject(
+            const RamOperation& nested, std::vector<const RamCondition*>& conditions) const {
+        const RamOperation* op = &nested;
+        while (const auto* filter = dynamic_cast<const RamFilter*>(op)) {
+            conditions.push_back(&filter->getCondition());
+            op = &filter->getOperation();
+        }
+        return dynamic_cast<const RamProject*>(op);
+    }
+
+    void appendRangeBounds(const RamIndexOperation& op, NodePtrVec& children) {
+        if (!op.hasRangeBounds()) {
+            return;
+        }
+        for (const auto& value : op.getRangeLowerBound()) {
+            children.push_back(visit(value));
+        }
+        for (const auto& value : op.getRangeUpperBound()) {
+            children.push_back(visit(value));
+        }
+    }
+
     /** @brief Encode and return the View id of an operation. */
     size_t encodeView(const RamNode* node) {
         auto pos = viewTable.find(node);
@@ -581,6 +825,184 @@ private:
         return id;
     }
 
+    /** @brief Encode the frame, relation, index and view requirements of a single node */
+    void encodeNode(const RamNode& node) {
+        if (const auto* tupleOp = dynamic_cast<const RamTupleOperation*>(&node)) {
+            frameSize = std::max(frameSize, static_cast<size_t>(tupleOp->getTupleId()) + 1);
+        }
+        if (const auto* create = dynamic_cast<const RamCreate*>(&node)) {
+            encodeRelation(create->getRelation());
+        }
+        if (dynamic_cast<const RamHashScan*>(&node) != nullptr) {
+            // hash scans probe a transient hash table; no index or view is encoded
+        } else if (const auto* indexSearch = dynamic_cast<const RamIndexOperation*>(&node)) {
+            encodeIndexPos(*indexSearch);
+            encodeView(indexSearch);
+        } else if (const auto* exists = dynamic_cast<const RamExistenceCheck*>(&node)) {
+            encodeIndexPos(*exists);
+            encodeView(exists);
+        } else if (const auto* provExists = dynamic_cast<const RamProvenanceExistenceCheck*>(&node)) {
+            encodeIndexPos(*provExists);
+            encodeView(provExists);
+        } else if (const auto* subsumes = dynamic_cast<const RamSubsumptionCheck*>(&node)) {
+            encodeIndexPos(*subsumes);
+            encodeView(subsumes);
+        }
+    }
+
+    /**
+     * @brief Precompute the search bounds of an index operation whose pattern
+     * (and inequality bounds, if present) consist of constants only.
+     *
+     * The bounds are attached to the node, letting the engine probe the view
+     * directly instead of re-assembling the pattern tuple on every call --
+     * the common case of a point lookup with a constant key. Patterns with
+     * any non-constant entry keep being assembled per execution.
+     */
+    static void foldConstantBounds(InterpreterNode& node, size_t arity, size_t boundsBase) {
+        const auto& children = node.getChildren();
+        const bool hasBounds = children.size() > boundsBase;
+        std::vector<RamDomain> low(arity);
+        std::vector<RamDomain> high(arity);
+        for (size_t i = 0; i < arity; i++) {
+            if (children[i] != nullptr) {
+                if (!getConstant(children[i], low[i])) {
+                    return;
+                }
+                high[i] = low[i];
+            } else {
+                low[i] = MIN_RAM_DOMAIN;
+                high[i] = MAX_RAM_DOMAIN;
+                if (hasBounds && children[boundsBase + i] != nullptr &&
+                        !getConstant(children[boundsBase + i], low[i])) {
+                    return;
+                }
+                if (hasBounds && children[boundsBase + arity + i] != nullptr &&
+                        !getConstant(children[boundsBase + arity + i], high[i])) {
+                    return;
+                }
+            }
+        }
+        node.setConstBounds(std::move(low), std::move(high));
+    }
+
+    /** @brief Obtain the constant value of a generated expression node, if it has one */
+    static bool getConstant(const NodePtr& node, RamDomain& value) {
+        if (node->getType() == I_Number) {
+            value = static_cast<const RamNumber*>(node->getShadow())->getConstant();
+            return true;
+        }
+        if (node->getType() == I_PrecomputedNumber) {
+            value = static_cast<RamDomain>(node->getData(0));
+            return true;
+        }
+        return false;
+    }
+
+    /**
+     * @brief Evaluate a purely numeric functor over constant arguments at
+     * generation time. String functors depend on the symbol table and are
+     * left to the engine, as are divisions by a constant zero so that the
+     * arithmetic error surfaces at run time.
+     */
+    static bool foldIntrinsicOperator(
+            const RamIntrinsicOperator& op, const NodePtrVec& children, RamDomain& value) {
+        std::vector<RamDomain> args(children.size());
+        for (size_t i = 0; i < children.size(); i++) {
+            if (!getConstant(children[i], args[i])) {
+                return false;
+            }
+        }
+        switch (op.getOperator()) {
+            case FunctorOp::ORD:
+                value = args[0];
+                return true;
+            case FunctorOp::NEG:
+                value = -args[0];
+                return true;
+            case FunctorOp::BNOT:
+                value = ~args[0];
+                return true;
+            case FunctorOp::LNOT:
+                value = !args[0];
+                return true;
+            case FunctorOp::ADD:
+                value = args[0] + args[1];
+                return true;
+            case FunctorOp::SUB:
+                value = args[0] - args[1];
+                return true;
+            case FunctorOp::MUL:
+                value = args[0] * args[1];
+                return true;
+            case FunctorOp::DIV:
+                if (args[1] == 0) {
+                    return false;
+                }
+                value = args[0] / args[1];
+                return true;
+            case FunctorOp::EXP:
+                value = static_cast<RamDomain>(std::pow(args[0], args[1]));
+                return true;
+            case FunctorOp::MOD:
+                if (args[1] == 0) {
+                    return false;
+                }
+                value = args[0] % args[1];
+                return true;
+            case FunctorOp::BAND:
+                value = args[0] & args[1];
+                return true;
+            case FunctorOp::BOR:
+                value = args[0] | args[1];
+                return true;
+            case FunctorOp::BXOR:
+                value = args[0] ^ args[1];
+                return true;
+            case FunctorOp::LAND:
+                value = args[0] && args[1];
+                return true;
+            case FunctorOp::LOR:
+                value = args[0] || args[1];
+                return true;
+            case FunctorOp::MAX:
+                value = *std::max_element(args.begin(), args.end());
+                return true;
+            case FunctorOp::MIN:
+                value = *std::min_element(args.begin(), args.end());
+                return true;
+            default:
+                return false;
+        }
+    }
+
+    /** @brief Decide a numeric comparison over constant operands at generation time */
+    static bool foldConstraint(BinaryConstraintOp op, RamDomain lhs, RamDomain rhs, bool& result) {
+        switch (op) {
+            case BinaryConstraintOp::EQ:
+                result = lhs == rhs;
+                return true;
+            case BinaryConstraintOp::NE:
+                result = lhs != rhs;
+                return true;
+            case BinaryConstraintOp::LT:
+                result = lhs < rhs;
+                return true;
+            case BinaryConstraintOp::LE:
+                result = lhs <= rhs;
+                return true;
+            case BinaryConstraintOp::GT:
+                result = lhs > rhs;
+                return true;
+            case BinaryConstraintOp::GE:
+                result = lhs >= rhs;
+                return true;
+            default:
+                // string comparisons need the symbol table
+                return false;
+        }
+    }
+
     /**
      * @brief Find all operations under the root node that requires a view.
      * Return a list of InterpreterNodes.
@@ -599,6 +1021,10 @@ private:
      * Return true if the given operation requires a view.
      */
     bool requireView(const RamNode* node) {
+        // hash scans probe a transient hash table rather than a view
+        if (dynamic_cast<const RamHashScan*>(node) != nullptr) {
+            return false;
+        }
         if (dynamic_cast<const RamAbstractExistenceCheck*>(node) != nullptr) {
             return true;
         } else if (dynamic_cast<const RamIndexOperation*>(node) != nullptr) {
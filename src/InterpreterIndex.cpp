@@ -18,6 +18,9 @@
 #include "CompiledIndexUtils.h"
 #include "Util.h"
 #include <atomic>
+#ifdef _OPENMP
+#include <omp.h>
+#endif
 
 namespace souffle {
 
@@ -63,6 +66,15 @@ bool Order::valid() const {
     return true;
 }
 
+bool Order::isIdentity() const {
+    for (std::size_t i = 0; i < order.size(); i++) {
+        if (order[i] != int(i)) {
+            return false;
+        }
+    }
+    return true;
+}
+
 bool Order::operator==(const Order& other) const {
     return order == other.order;
 }
@@ -84,8 +96,11 @@ std::ostream& operator<<(std::ostream& out, const Order& order) {
  * nested data structure is required.
  */
 class NullaryIndex : public InterpreterIndex {
-    // indicates whether the one single element is present or not.
-    std::atomic<bool> present;
+    // indicates whether the one single element is present or not;
+    // nullary guard relations are checked far more often than they are
+    // set, so reads use acquire loads and stay a plain load on common
+    // architectures
+    std::atomic<bool> present{false};
 
     // a source adaptation, iterating through the optionally present
     // entry in this relation.
@@ -137,11 +152,15 @@ public:
     }
 
     bool empty() const override {
-        return !present;
+        return !present.load(std::memory_order_acquire);
     }
 
     std::size_t size() const override {
-        return present ? 1 : 0;
+        return present.load(std::memory_order_acquire) ? 1 : 0;
+    }
+
+    std::size_t getMemoryUsage() const override {
+        return sizeof(*this);
     }
 
     IndexViewPtr createView() const override {
@@ -150,27 +169,31 @@ public:
 
     bool insert(const TupleRef& tuple) override {
         assert(tuple.size() == 0);
-        bool res = present;
-        present = true;
-        return res;
+        if (present.load(std::memory_order_acquire)) {
+            return false;
+        }
+        // the exchange decides the first inserter under concurrent evaluation
+        return !present.exchange(true, std::memory_order_acq_rel);
     }
 
     void insert(const InterpreterIndex& src) override {
         assert(src.getArity() == 0);
-        present = present | !src.empty();
+        if (!src.empty()) {
+            present.store(true, std::memory_order_release);
+        }
     }
 
     bool contains(const TupleRef& tuple) const override {
         assert(tuple.size() == 0);
-        return present;
+        return present.load(std::memory_order_acquire);
     }
 
     bool contains(const TupleRef&, const TupleRef&) const override {
-        return present;
+        return present.load(std::memory_order_acquire);
     }
 
     Stream scan() const override {
-        return std::make_unique<Source>(present);
+        return std::make_unique<Source>(present.load(std::memory_order_acquire));
     }
 
     PartitionedStream partitionScan(int) const override {
@@ -190,7 +213,7 @@ public:
     }
 
     void clear() override {
-        present = false;
+        present.store(false, std::memory_order_release);
     }
 };
 
@@ -211,6 +234,10 @@ protected:
     // the order to be simulated
     Order order;
 
+    // whether the order is the identity, allowing the per-tuple
+    // encode/decode permutations to be skipped
+    bool identity;
+
     // the internal data structure
     Structure data;
 
@@ -220,6 +247,9 @@ protected:
     class Source : public Stream::Source {
         const Order& order;
 
+        // whether elements can be passed through without re-ordering
+        bool direct;
+
         // the begin and end of the stream
         iter cur;
         iter end;
@@ -228,10 +258,20 @@ protected:
         std::array<Entry, Stream::BUFFER_SIZE> buffer;
 
     public:
-        Source(const Order& order, iter begin, iter end) : order(order), cur(begin), end(end) {}
+        Source(const Order& order, bool direct, iter begin, iter end)
+                : order(order), direct(direct), cur(begin), end(end) {}
 
         int load(TupleRef* out, int max) override {
             int c = 0;
+            if (direct) {
+                while (cur != end && c < max) {
+                    buffer[c] = *cur;
+                    out[c] = buffer[c];
+                    ++cur;
+                    ++c;
+                }
+                return c;
+            }
             while (cur != end && c < max) {
                 buffer[c] = order.decode(*cur);
                 out[c] = buffer[c];
@@ -242,15 +282,21 @@ protected:
         }
 
         std::unique_ptr<Stream::Source> clone() override {
-            Source* source = new Source(order, cur, end);
+            Source* source = new Source(order, direct, cur, end);
             source->buffer = this->buffer;
             return std::unique_ptr<Stream::Source>(source);
         }
     };
 
+    // encodes an entry into the maintained order, bypassing the
+    // permutation for identity orders
+    Entry encode(const Entry& entry) const {
+        return identity ? entry : order.encode(entry);
+    }
+
     virtual souffle::range<iter> bounds(const TupleRef& low, const TupleRef& high, Hints& hints) const {
-        Entry a = order.encode(low.asTuple<Arity>());
-        Entry b = order.encode(high.asTuple<Arity>());
+        Entry a = encode(low.asTuple<Arity>());
+        Entry b = encode(high.asTuple<Arity>());
         // Transfer upper_bound to a equivalent lower bound
         bool fullIndexSearch = true;
         for (size_t i = Arity; i-- > 0;) {
@@ -278,7 +324,7 @@ protected:
         GenericIndexView(const GenericIndex& index) : index(index) {}
 
         bool contains(const TupleRef& tuple) const override {
-            return index.data.contains(index.order.encode(tuple.asTuple<Arity>()), hints);
+            return index.data.contains(index.encode(tuple.asTuple<Arity>()), hints);
         }
 
         bool contains(const TupleRef& low, const TupleRef& high) const override {
@@ -287,7 +333,7 @@ protected:
 
         Stream range(const TupleRef& low, const TupleRef& high) const override {
             auto range = index.bounds(low, high, hints);
-            return std::make_unique<Source>(index.order, range.begin(), range.end());
+            return std::make_unique<Source>(index.order, index.identity, range.begin(), range.end());
         }
 
         size_t getArity() const override {
@@ -296,7 +342,7 @@ protected:
     };
 
 public:
-    GenericIndex(const Order& order) : order(order) {}
+    GenericIndex(const Order& order) : order(order), identity(order.isIdentity()) {}
 
     IndexViewPtr createView() const override {
         return std::make_unique<GenericIndexView>(*this);
@@ -314,8 +360,12 @@ public:
         return data.size();
     }
 
+    std::size_t getMemoryUsage() const override {
+        return data.getMemoryUsage();
+    }
+
     bool insert(const TupleRef& tuple) override {
-        return data.insert(order.encode(tuple.asTuple<Arity>()));
+        return data.insert(encode(tuple.asTuple<Arity>()));
     }
 
     void insert(const InterpreterIndex& src) override {
@@ -325,6 +375,56 @@ public:
         }
     }
 
+protected:
+    /**
+     * Inserts a batch of row-major tuples by encoding and sorting it into
+     * the maintained lexicographic order first: every thread sorts one
+     * contiguous run and inserts it with its own operation hints, so
+     * consecutive inserts land on the cached leaf almost every time.
+     * Only the tree-backed adapters expose this through insertBatch; the
+     * member is instantiated on demand, keeping structures without hinted
+     * insertion out of its requirements.
+     */
+    void insertSorted(const RamDomain* tuples, std::size_t count) {
+        const auto lexLess = [](const Entry& a, const Entry& b) {
+            for (std::size_t col = 0; col < static_cast<std::size_t>(Arity); ++col) {
+                if (a[col] != b[col]) {
+                    return a[col] < b[col];
+                }
+            }
+            return false;
+        };
+        std::vector<Entry> encoded(count);
+#ifdef _OPENMP
+#pragma omp parallel for schedule(static)
+#endif
+        for (std::size_t i = 0; i < count; ++i) {
+            encoded[i] = encode(TupleRef(tuples + i * Arity, Arity).asTuple<Arity>());
+        }
+#ifdef _OPENMP
+#pragma omp parallel
+        {
+            const std::size_t team = omp_get_num_threads();
+            const std::size_t chunk = (count + team - 1) / team;
+            const std::size_t begin = std::min<std::size_t>(omp_get_thread_num() * chunk, count);
+            const std::size_t end = std::min(begin + chunk, count);
+            std::sort(encoded.begin() + begin, encoded.begin() + end, lexLess);
+            Hints hints;
+            for (std::size_t i = begin; i < end; ++i) {
+                data.insert(encoded[i], hints);
+            }
+        }
+#else
+        std::sort(encoded.begin(), encoded.end(), lexLess);
+        Hints hints;
+        for (const Entry& entry : encoded) {
+            data.insert(entry, hints);
+        }
+#endif
+    }
+
+public:
+
     bool contains(const TupleRef& tuple) const override {
         return GenericIndexView(*this).contains(tuple);
     }
@@ -334,7 +434,7 @@ public:
     }
 
     Stream scan() const override {
-        return std::make_unique<Source>(order, data.begin(), data.end());
+        return std::make_unique<Source>(order, identity, data.begin(), data.end());
     }
 
     PartitionedStream partitionScan(int partitionCount) const override {
@@ -342,7 +442,7 @@ public:
         std::vector<Stream> res;
         res.reserve(chunks.size());
         for (const auto& cur : chunks) {
-            res.push_back(std::make_unique<Source>(order, cur.begin(), cur.end()));
+            res.push_back(std::make_unique<Source>(order, identity, cur.begin(), cur.end()));
         }
         return std::move(res);
     }
@@ -358,7 +458,7 @@ public:
         std::vector<Stream> res;
         res.reserve(partitionCount);
         for (const auto& cur : range.partition(partitionCount)) {
-            res.push_back(std::make_unique<Source>(order, cur.begin(), cur.end()));
+            res.push_back(std::make_unique<Source>(order, identity, cur.begin(), cur.end()));
         }
         return std::move(res);
     }
@@ -368,52 +468,97 @@ public:
     }
 };
 
-/* B-Tree Indirect indexes */
-class IndirectIndex : public InterpreterIndex {
-public:
-    /* lexicographical comparison operation on two tuple pointers */
-    struct comparator {
-        const std::vector<int> order;
-
-        /* constructor to initialize state */
-        comparator(std::vector<int> order) : order(std::move(order)) {}
-
-        /* comparison function */
-        int operator()(const TupleRef& x, const TupleRef& y) const {
-            for (auto& i : order) {
-                if (x[i] < y[i]) {
-                    return -1;
-                }
-                if (x[i] > y[i]) {
-                    return 1;
-                }
+/* lexicographical comparison operation on two tuple pointers, following
+ * a runtime column order of arbitrary length */
+struct indirect_comparator {
+    const std::vector<int> order;
+
+    /* constructor to initialize state */
+    indirect_comparator(std::vector<int> order) : order(std::move(order)) {}
+
+    /* comparison function */
+    int operator()(const TupleRef& x, const TupleRef& y) const {
+        for (auto& i : order) {
+            if (x[i] < y[i]) {
+                return -1;
+            }
+            if (x[i] > y[i]) {
+                return 1;
             }
-            return 0;
         }
+        return 0;
+    }
+
+    /* less comparison */
+    bool less(const TupleRef& x, const TupleRef& y) const {
+        return operator()(x, y) < 0;
+    }
 
-        /* less comparison */
-        bool less(const TupleRef& x, const TupleRef& y) const {
-            return operator()(x, y) < 0;
+    /* equal comparison */
+    bool equal(const TupleRef& x, const TupleRef& y) const {
+        for (auto& i : order) {
+            if (x[i] != y[i]) {
+                return false;
+            }
         }
+        return true;
+    }
+};
 
-        /* equal comparison */
-        bool equal(const TupleRef& x, const TupleRef& y) const {
-            for (auto& i : order) {
-                if (x[i] != y[i]) {
-                    return false;
-                }
+/* lexicographical comparison operation on two tuple pointers over a
+ * compile-time number of columns; the fixed trip count lets the compiler
+ * unroll every comparison into a handful of straight-line compares,
+ * while the column order itself remains runtime data */
+template <std::size_t N>
+struct fixed_indirect_comparator {
+    std::array<int, N> order;
+
+    /* constructor to initialize state */
+    fixed_indirect_comparator(const std::vector<int>& columns) {
+        assert(columns.size() == N);
+        std::copy_n(columns.begin(), N, order.begin());
+    }
+
+    /* comparison function */
+    int operator()(const TupleRef& x, const TupleRef& y) const {
+        for (std::size_t i = 0; i < N; ++i) {
+            if (x[order[i]] < y[order[i]]) {
+                return -1;
+            }
+            if (x[order[i]] > y[order[i]]) {
+                return 1;
             }
-            return true;
         }
-    };
+        return 0;
+    }
+
+    /* less comparison */
+    bool less(const TupleRef& x, const TupleRef& y) const {
+        return operator()(x, y) < 0;
+    }
+
+    /* equal comparison */
+    bool equal(const TupleRef& x, const TupleRef& y) const {
+        for (std::size_t i = 0; i < N; ++i) {
+            if (x[order[i]] != y[order[i]]) {
+                return false;
+            }
+        }
+        return true;
+    }
+};
 
+/* B-Tree Indirect indexes */
+template <typename Comparator>
+class IndirectIndex : public InterpreterIndex {
+public:
     /* btree for storing tuple pointers with a given lexicographical order */
-    using index_set = btree_multiset<TupleRef, comparator, std::allocator<TupleRef>, 512>;
+    using index_set = btree_multiset<TupleRef, Comparator, std::allocator<TupleRef>, 512>;
     using Hints = typename index_set::operation_hints;
 
     class Source : public Stream::Source {
         // the begin and end of the stream
-        using iter = btree_multiset<TupleRef, comparator, std::allocator<TupleRef>, 512>::iterator;
+        using iter = typename index_set::iterator;
         iter cur;
         iter end;
 
@@ -468,8 +613,8 @@ public:
     };
 
     IndirectIndex(std::vector<int> order)
-            : theOrder(std::move(order)), set(comparator(theOrder), comparator(theOrder)),
-              arity(order.size()) {}
+            : theOrder(std::move(order)), set(Comparator(theOrder), Comparator(theOrder)),
+              arity(theOrder.size()) {}
 
     IndexViewPtr createView() const override {
         return std::make_unique<IndirectIndexView>(*this);
@@ -487,6 +632,10 @@ public:
         return set.size();
     }
 
+    std::size_t getMemoryUsage() const override {
+        return set.getMemoryUsage();
+    }
+
     bool insert(const TupleRef& tuple) override {
         return set.insert(tuple, operation_hints);
     }
@@ -539,7 +688,7 @@ private:
     index_set set;
 
     /** Operation hints */
-    index_set::btree_operation_hints<1> operation_hints;
+    typename index_set::operation_hints operation_hints;
 
     /** Arity as the relation arity, not necessary the order size in indirect index */
     size_t arity;
@@ -557,18 +706,112 @@ using t_tuple = typename ram::Tuple<RamDomain, Arity>;
 template <std::size_t Arity>
 struct InterpreterProvenanceUpdater {
     void update(t_tuple<Arity>& old_t, const t_tuple<Arity>& new_t) {
-        old_t[Arity - 2] = new_t[Arity - 2];
         old_t[Arity - 1] = new_t[Arity - 1];
     }
 };
 
+/* lexicographical comparison on the leading columns of two tuples, used
+ * to skip ahead over all duplicates of a key prefix in one descent */
+template <std::size_t Arity>
+struct prefix_comparator {
+    size_t length;
+
+    int operator()(const t_tuple<Arity>& a, const t_tuple<Arity>& b) const {
+        for (size_t i = 0; i < length; ++i) {
+            if (a[i] < b[i]) {
+                return -1;
+            }
+            if (a[i] > b[i]) {
+                return 1;
+            }
+        }
+        return 0;
+    }
+    bool less(const t_tuple<Arity>& a, const t_tuple<Arity>& b) const {
+        return operator()(a, b) < 0;
+    }
+    bool equal(const t_tuple<Arity>& a, const t_tuple<Arity>& b) const {
+        return operator()(a, b) == 0;
+    }
+};
+
+/**
+ * Summarizes the physical shape of a b-tree for the
+ * --data-structure-stats profile events.
+ */
+template <typename BTree>
+StructureStats summarizeBTree(const BTree& data) {
+    StructureStats stats;
+    stats.elements = data.size();
+    stats.nodes = data.getNumNodes();
+    stats.depth = data.getDepth();
+    stats.nodeCapacity = data.getNodeCapacity();
+    stats.memory = data.getMemoryUsage();
+    return stats;
+}
+
 /**
  * A index adapter for B-trees, using the generic index adapter.
  */
 template <std::size_t Arity>
 class BTreeIndex : public GenericIndex<btree_set<t_tuple<Arity>, comparator<Arity>>> {
+    using Base = GenericIndex<btree_set<t_tuple<Arity>, comparator<Arity>>>;
+    using Structure = btree_set<t_tuple<Arity>, comparator<Arity>>;
+
 public:
-    using GenericIndex<btree_set<t_tuple<Arity>, comparator<Arity>>>::GenericIndex;
+    using Base::Base;
+
+    StructureStats getStructureStats() const override {
+        return summarizeBTree(this->data);
+    }
+
+    void insertBatch(const RamDomain* tuples, std::size_t count) override {
+        this->insertSorted(tuples, count);
+    }
+
+    /**
+     * A source enumerating one representative per distinct key prefix;
+     * after each tuple it seeks past the remaining duplicates of that
+     * prefix with a prefix upper bound instead of iterating them.
+     */
+    class DistinctPrefixSource : public Stream::Source {
+        const Order& order;
+
+        // whether elements can be passed through without re-ordering
+        bool direct;
+
+        prefix_comparator<Arity> comp;
+
+        const Structure& data;
+        typename Structure::iterator cur;
+
+        // an internal buffer for re-ordered elements
+        std::array<t_tuple<Arity>, Stream::BUFFER_SIZE> buffer;
+
+    public:
+        DistinctPrefixSource(const Order& order, bool direct, size_t prefixLength, const Structure& data)
+                : order(order), direct(direct), comp{prefixLength}, data(data), cur(data.begin()) {}
+
+        int load(TupleRef* out, int max) override {
+            int c = 0;
+            while (cur != data.end() && c < max) {
+                const t_tuple<Arity> entry = *cur;
+                buffer[c] = direct ? entry : order.decode(entry);
+                out[c] = buffer[c];
+                ++c;
+                cur = data.upper_bound(entry, comp);
+            }
+            return c;
+        }
+
+        std::unique_ptr<Stream::Source> clone() override {
+            return std::make_unique<DistinctPrefixSource>(*this);
+        }
+    };
+
+    Stream scanDistinctPrefix(size_t prefixLength) const override {
+        return std::make_unique<DistinctPrefixSource>(this->order, this->identity, prefixLength, this->data);
+    }
 };
 
 /**
@@ -577,12 +820,20 @@ public:
 template <std::size_t Arity>
 class BTreeProvenanceIndex
         : public GenericIndex<btree_set<t_tuple<Arity>, comparator<Arity>, std::allocator<t_tuple<Arity>>,
-                  256, typename detail::default_strategy<t_tuple<Arity>>::type, comparator<Arity - 2>,
+                  256, typename detail::default_strategy<t_tuple<Arity>>::type, comparator<Arity - 1>,
                   InterpreterProvenanceUpdater<Arity>>> {
 public:
     using GenericIndex<btree_set<t_tuple<Arity>, comparator<Arity>, std::allocator<t_tuple<Arity>>, 256,
-            typename detail::default_strategy<t_tuple<Arity>>::type, comparator<Arity - 2>,
+            typename detail::default_strategy<t_tuple<Arity>>::type, comparator<Arity - 1>,
             InterpreterProvenanceUpdater<Arity>>>::GenericIndex;
+
+    StructureStats getStructureStats() const override {
+        return summarizeBTree(this->data);
+    }
+
+    void insertBatch(const RamDomain* tuples, std::size_t count) override {
+        this->insertSorted(tuples, count);
+    }
 };
 
 /**
@@ -615,6 +866,315 @@ protected:
     }
 };
 
+/**
+ * A compact, sorted-array set mimicking the interface the generic index
+ * adapter requires from a b-tree. Insertions append to the array; lookups
+ * sort it on demand and use binary search. It is intended for relations
+ * that are no longer updated, where it replaces the b-tree nodes with a
+ * minimal-footprint, cache-friendly representation.
+ */
+template <typename Tuple>
+class CompactSet {
+    // the stored entries; sorted unless dirty
+    mutable std::vector<Tuple> entries;
+
+    // indicates whether entries have been appended since the last sort
+    mutable bool dirty = false;
+
+    void ensure() const {
+        if (dirty) {
+            std::sort(entries.begin(), entries.end());
+            entries.erase(std::unique(entries.begin(), entries.end()), entries.end());
+            entries.shrink_to_fit();
+            dirty = false;
+        }
+    }
+
+public:
+    using element_type = Tuple;
+    using iterator = typename std::vector<Tuple>::const_iterator;
+    struct operation_hints {};
+
+    bool insert(const Tuple& tuple) {
+        entries.push_back(tuple);
+        dirty = true;
+        return true;
+    }
+
+    bool contains(const Tuple& tuple, operation_hints&) const {
+        ensure();
+        return std::binary_search(entries.begin(), entries.end(), tuple);
+    }
+
+    iterator lower_bound(const Tuple& tuple, operation_hints&) const {
+        ensure();
+        return std::lower_bound(entries.begin(), entries.end(), tuple);
+    }
+
+    iterator begin() const {
+        ensure();
+        return entries.begin();
+    }
+
+    iterator end() const {
+        ensure();
+        return entries.end();
+    }
+
+    std::size_t size() const {
+        ensure();
+        return entries.size();
+    }
+
+    bool empty() const {
+        ensure();
+        return entries.empty();
+    }
+
+    std::size_t getMemoryUsage() const {
+        return sizeof(*this) + entries.capacity() * sizeof(Tuple);
+    }
+
+    void clear() {
+        entries.clear();
+        entries.shrink_to_fit();
+        dirty = false;
+    }
+
+    std::vector<souffle::range<iterator>> partition(int chunks) const {
+        ensure();
+        std::vector<souffle::range<iterator>> res;
+        std::size_t n = entries.size();
+        std::size_t step = n / chunks + 1;
+        for (std::size_t i = 0; i < n; i += step) {
+            res.push_back(make_range(entries.cbegin() + i, entries.cbegin() + std::min(i + step, n)));
+        }
+        if (res.empty()) {
+            res.push_back(make_range(begin(), end()));
+        }
+        return res;
+    }
+};
+
+/**
+ * A index adapter for compact sorted arrays, using the generic index adapter.
+ */
+template <std::size_t Arity>
+class CompactIndex : public GenericIndex<CompactSet<t_tuple<Arity>>> {
+public:
+    using GenericIndex<CompactSet<t_tuple<Arity>>>::GenericIndex;
+};
+
+/**
+ * A bitset index for unary relations over a dense ordinal domain.
+ * Each non-negative value is represented by a single bit, providing
+ * O(1) insert and contains and word-at-a-time iteration.
+ */
+class BitsetIndex : public InterpreterIndex {
+    // number of bits per word
+    static constexpr std::size_t BITS = 64;
+
+    // bit v % BITS of words[v / BITS] represents the value v
+    std::vector<uint64_t> words;
+
+    // the number of set bits
+    std::size_t count = 0;
+
+    // a lock synchronising concurrent inserts
+    Lock insert_lock;
+
+    // a source adaptation, iterating word at a time through the
+    // values within the range [from,to)
+    class Source : public Stream::Source {
+        const std::vector<uint64_t>& words;
+
+        // the next candidate value and the exclusive upper bound
+        int64_t next;
+        int64_t to;
+
+        // an internal buffer for materialized values
+        std::array<RamDomain, Stream::BUFFER_SIZE> buffer;
+
+    public:
+        Source(const std::vector<uint64_t>& words, int64_t from, int64_t to)
+                : words(words), next(from), to(to) {}
+
+        int load(TupleRef* out, int max) override {
+            int c = 0;
+            while (next < to && c < max) {
+                std::size_t word = next / BITS;
+                if (word >= words.size()) {
+                    break;
+                }
+                uint64_t bits = words[word] >> (next % BITS);
+                if (bits == 0) {
+                    next = (word + 1) * BITS;
+                    continue;
+                }
+                next += __builtin_ctzll(bits);
+                if (next >= to) {
+                    break;
+                }
+                buffer[c] = static_cast<RamDomain>(next);
+                out[c] = TupleRef(&buffer[c], 1);
+                ++next;
+                ++c;
+            }
+            return c;
+        }
+
+        std::unique_ptr<Stream::Source> clone() override {
+            Source* source = new Source(words, next, to);
+            source->buffer = this->buffer;
+            return std::unique_ptr<Stream::Source>(source);
+        }
+    };
+
+    // The bitset index view -- does not require any hints.
+    struct BitsetIndexView : public IndexView {
+        const BitsetIndex& index;
+
+        BitsetIndexView(const BitsetIndex& index) : index(index) {}
+
+        bool contains(const TupleRef& entry) const override {
+            return index.contains(entry);
+        }
+
+        bool contains(const TupleRef& low, const TupleRef& high) const override {
+            return index.contains(low, high);
+        }
+
+        Stream range(const TupleRef& low, const TupleRef& high) const override {
+            return index.range(low, high);
+        }
+
+        size_t getArity() const override {
+            return 1;
+        }
+    };
+
+    // converts the given bounds into a [from,to) value interval
+    std::pair<int64_t, int64_t> interval(const TupleRef& low, const TupleRef& high) const {
+        int64_t from = std::max(static_cast<int64_t>(low[0]), int64_t(0));
+        int64_t to = std::min(
+                static_cast<int64_t>(high[0]) + 1, static_cast<int64_t>(words.size() * BITS));
+        return {from, to};
+    }
+
+public:
+    size_t getArity() const override {
+        return 1;
+    }
+
+    bool empty() const override {
+        return count == 0;
+    }
+
+    std::size_t size() const override {
+        return count;
+    }
+
+    std::size_t getMemoryUsage() const override {
+        return sizeof(*this) + words.capacity() * sizeof(uint64_t);
+    }
+
+    IndexViewPtr createView() const override {
+        return std::make_unique<BitsetIndexView>(*this);
+    }
+
+    bool insert(const TupleRef& tuple) override {
+        assert(tuple.size() == 1);
+        assert(tuple[0] >= 0 && "bitset relations require non-negative values");
+        auto lease = insert_lock.acquire();
+        (void)lease;
+        std::size_t word = static_cast<std::size_t>(tuple[0]) / BITS;
+        if (word >= words.size()) {
+            words.resize(word + 1, 0);
+        }
+        uint64_t mask = uint64_t(1) << (static_cast<std::size_t>(tuple[0]) % BITS);
+        if ((words[word] & mask) != 0) {
+            return false;
+        }
+        words[word] |= mask;
+        ++count;
+        return true;
+    }
+
+    void insert(const InterpreterIndex& src) override {
+        for (const auto& cur : src.scan()) {
+            insert(cur);
+        }
+    }
+
+    bool contains(const TupleRef& tuple) const override {
+        assert(tuple.size() == 1);
+        if (tuple[0] < 0) {
+            return false;
+        }
+        std::size_t word = static_cast<std::size_t>(tuple[0]) / BITS;
+        return word < words.size() &&
+               (words[word] & (uint64_t(1) << (static_cast<std::size_t>(tuple[0]) % BITS))) != 0;
+    }
+
+    bool contains(const TupleRef& low, const TupleRef& high) const override {
+        auto bounds = interval(low, high);
+        for (int64_t next = bounds.first; next < bounds.second;) {
+            std::size_t word = next / BITS;
+            uint64_t bits = words[word] >> (next % BITS);
+            if (bits == 0) {
+                next = (word + 1) * BITS;
+                continue;
+            }
+            return next + __builtin_ctzll(bits) < bounds.second;
+        }
+        return false;
+    }
+
+    Stream scan() const override {
+        return std::make_unique<Source>(words, 0, words.size() * BITS);
+    }
+
+    PartitionedStream partitionScan(int partitionCount) const override {
+        std::vector<Stream> res;
+        std::size_t n = words.size();
+        std::size_t step = n / partitionCount + 1;
+        for (std::size_t w = 0; w < n; w += step) {
+            res.push_back(std::make_unique<Source>(
+                    words, w * BITS, std::min(w + step, n) * BITS));
+        }
+        if (res.empty()) {
+            res.push_back(scan());
+        }
+        return std::move(res);
+    }
+
+    Stream range(const TupleRef& low, const TupleRef& high) const override {
+        auto bounds = interval(low, high);
+        return std::make_unique<Source>(words, bounds.first, bounds.second);
+    }
+
+    PartitionedStream partitionRange(
+            const TupleRef& low, const TupleRef& high, int partitionCount) const override {
+        auto bounds = interval(low, high);
+        std::vector<Stream> res;
+        int64_t n = bounds.second - bounds.first;
+        int64_t step = n / partitionCount + 1;
+        for (int64_t from = bounds.first; from < bounds.second; from += step) {
+            res.push_back(std::make_unique<Source>(
+                    words, from, std::min(from + step, bounds.second)));
+        }
+        if (res.empty()) {
+            res.push_back(range(low, high));
+        }
+        return std::move(res);
+    }
+
+    void clear() override {
+        words.clear();
+        count = 0;
+    }
+};
+
 std::unique_ptr<InterpreterIndex> createBTreeIndex(const Order& order) {
     switch (order.size()) {
         case 0:
@@ -651,8 +1211,9 @@ std::unique_ptr<InterpreterIndex> createBTreeIndex(const Order& order) {
 std::unique_ptr<InterpreterIndex> createBTreeProvenanceIndex(const Order& order) {
     switch (order.size()) {
         case 0:
+            assert(false && "Provenance relation with arity < 1.");
         case 1:
-            assert(false && "Provenance relation with arity < 2.");
+            return std::make_unique<BTreeProvenanceIndex<1>>(order);
         case 2:
             return std::make_unique<BTreeProvenanceIndex<2>>(order);
         case 3:
@@ -719,7 +1280,25 @@ std::unique_ptr<InterpreterIndex> createBrieIndex(const Order& order) {
 
 std::unique_ptr<InterpreterIndex> createIndirectIndex(const Order& order) {
     assert(order.size() != 0 && "IndirectIndex does not work with nullary relation\n");
-    return std::make_unique<IndirectIndex>(order.getOrder());
+    // common arities get a comparator with a compile-time column count,
+    // turning each comparison into straight-line code; longer orders fall
+    // back to the runtime loop
+    switch (order.size()) {
+        case 1:
+            return std::make_unique<IndirectIndex<fixed_indirect_comparator<1>>>(order.getOrder());
+        case 2:
+            return std::make_unique<IndirectIndex<fixed_indirect_comparator<2>>>(order.getOrder());
+        case 3:
+            return std::make_unique<IndirectIndex<fixed_indirect_comparator<3>>>(order.getOrder());
+        case 4:
+            return std::make_unique<IndirectIndex<fixed_indirect_comparator<4>>>(order.getOrder());
+        case 5:
+            return std::make_unique<IndirectIndex<fixed_indirect_comparator<5>>>(order.getOrder());
+        case 6:
+            return std::make_unique<IndirectIndex<fixed_indirect_comparator<6>>>(order.getOrder());
+        default:
+            return std::make_unique<IndirectIndex<indirect_comparator>>(order.getOrder());
+    }
 }
 
 std::unique_ptr<InterpreterIndex> createEqrelIndex(const Order& order) {
@@ -727,4 +1306,42 @@ std::unique_ptr<InterpreterIndex> createEqrelIndex(const Order& order) {
     return std::make_unique<EqrelIndex>(order);
 }
 
+std::unique_ptr<InterpreterIndex> createBitsetIndex(const Order& order) {
+    assert(order.size() == 1 && "Bitset index requires a unary relation");
+    return std::make_unique<BitsetIndex>();
+}
+
+std::unique_ptr<InterpreterIndex> createCompactIndex(const Order& order) {
+    switch (order.size()) {
+        case 0:
+            return std::make_unique<NullaryIndex>();
+        case 1:
+            return std::make_unique<CompactIndex<1>>(order);
+        case 2:
+            return std::make_unique<CompactIndex<2>>(order);
+        case 3:
+            return std::make_unique<CompactIndex<3>>(order);
+        case 4:
+            return std::make_unique<CompactIndex<4>>(order);
+        case 5:
+            return std::make_unique<CompactIndex<5>>(order);
+        case 6:
+            return std::make_unique<CompactIndex<6>>(order);
+        case 7:
+            return std::make_unique<CompactIndex<7>>(order);
+        case 8:
+            return std::make_unique<CompactIndex<8>>(order);
+        case 9:
+            return std::make_unique<CompactIndex<9>>(order);
+        case 10:
+            return std::make_unique<CompactIndex<10>>(order);
+        case 11:
+            return std::make_unique<CompactIndex<11>>(order);
+        case 12:
+            return std::make_unique<CompactIndex<12>>(order);
+    }
+    assert(false && "Requested arity not yet supported. Feel free to add it.");
+    return {};
+}
+
 }  // namespace souffle
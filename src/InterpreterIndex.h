@@ -148,6 +148,12 @@ public:
      */
     bool valid() const;
 
+    /**
+     * Determines whether this order keeps components in their
+     * natural sequence, i.e. encoding and decoding are no-ops.
+     */
+    bool isIdentity() const;
+
     template <std::size_t Arity>
     ram::Tuple<RamDomain, Arity> encode(const ram::Tuple<RamDomain, Arity>& entry) const {
         ram::Tuple<RamDomain, Arity> res;
@@ -377,6 +383,27 @@ public:
 // A general handler type for index views.
 using IndexViewPtr = std::unique_ptr<IndexView>;
 
+/**
+ * A summary of the physical shape of an index structure, as recorded
+ * in the profile log by the --data-structure-stats mode.
+ */
+struct StructureStats {
+    /** The number of tuples stored */
+    std::size_t elements = 0;
+
+    /** The number of tree nodes, or 0 where the structure has no node layout */
+    std::size_t nodes = 0;
+
+    /** The depth of the structure, or 0 where the structure has no node layout */
+    std::size_t depth = 0;
+
+    /** The number of elements a node can hold, or 0 where the structure has no node layout */
+    std::size_t nodeCapacity = 0;
+
+    /** The number of bytes of memory held */
+    std::size_t memory = 0;
+};
+
 /**
  * An index is an abstraction of a data structure
  */
@@ -404,6 +431,22 @@ public:
      */
     virtual std::size_t size() const = 0;
 
+    /**
+     * Obtains the number of bytes of memory held by this index.
+     */
+    virtual std::size_t getMemoryUsage() const = 0;
+
+    /**
+     * Obtains a summary of the physical shape of this index; structures
+     * without a node layout report elements and memory only.
+     */
+    virtual StructureStats getStructureStats() const {
+        StructureStats stats;
+        stats.elements = size();
+        stats.memory = getMemoryUsage();
+        return stats;
+    }
+
     /**
      * Inserts a tuple into this index.
      */
@@ -414,6 +457,18 @@ public:
      */
     virtual void insert(const InterpreterIndex& src) = 0;
 
+    /**
+     * Inserts a batch of tuples, given as count x arity elements in
+     * row-major order. The default inserts one tuple at a time; the
+     * tree-backed adapters override it with a sorted construction path.
+     */
+    virtual void insertBatch(const RamDomain* tuples, std::size_t count) {
+        const std::size_t arity = getArity();
+        for (std::size_t i = 0; i < count; ++i) {
+            insert(TupleRef(tuples + i * arity, arity));
+        }
+    }
+
     /**
      * Tests whether the given tuple is present in this index or not.
      */
@@ -429,6 +484,17 @@ public:
      */
     virtual Stream scan() const = 0;
 
+    /**
+     * Returns a stream yielding one representative tuple per distinct
+     * prefix of the given length of the index order. The base
+     * implementation falls back to a full scan, so callers must treat
+     * the prefix skipping purely as an optimization and tolerate
+     * repeated prefixes.
+     */
+    virtual Stream scanDistinctPrefix(size_t /* prefixLength */) const {
+        return scan();
+    }
+
     /**
      * Returns a partitioned stream covering the entire index content.
      */
@@ -480,4 +546,10 @@ std::unique_ptr<InterpreterIndex> createIndirectIndex(const Order&);
 // A factory for Eqrel index.
 std::unique_ptr<InterpreterIndex> createEqrelIndex(const Order&);
 
+// A factory for bitset index.
+std::unique_ptr<InterpreterIndex> createBitsetIndex(const Order&);
+
+// A factory for a compact sorted-array index for read-only relations.
+std::unique_ptr<InterpreterIndex> createCompactIndex(const Order&);
+
 }  // end of namespace souffle
@@ -25,11 +25,13 @@
 
 #include "InterpreterPreamble.h"
 #include "RamNode.h"
+#include "RamTypes.h"
 
 namespace souffle {
 
 enum InterpreterNodeType {
     I_Number,
+    I_PrecomputedNumber,
     I_TupleElement,
     I_AutoIncrement,
     I_IntrinsicOperator,
@@ -43,22 +45,28 @@ enum InterpreterNodeType {
     I_EmptinessCheck,
     I_ExistenceCheck,
     I_ProvenanceExistenceCheck,
+    I_SubsumptionCheck,
     I_Constraint,
     I_TupleOperation,
     I_Scan,
     I_ParallelScan,
     I_IndexScan,
     I_ParallelIndexScan,
+    I_HashScan,
     I_Choice,
     I_ParallelChoice,
     I_IndexChoice,
     I_ParallelIndexChoice,
     I_UnpackRecord,
     I_Aggregate,
+    I_ParallelAggregate,
     I_IndexAggregate,
     I_Break,
     I_Filter,
+    I_Split,
     I_Project,
+    I_ScanFilterProject,
+    I_IndexScanFilterProject,
     I_SubroutineReturnValue,
     I_Sequence,
     I_Parallel,
@@ -75,6 +83,7 @@ enum InterpreterNodeType {
     I_Load,
     I_Store,
     I_Fact,
+    I_FactTable,
     I_Query,
     I_Merge,
     I_Swap,
@@ -128,11 +137,35 @@ public:
         return children;
     }
 
+    /** @brief check whether precomputed search bounds are attached */
+    inline bool hasConstBounds() const {
+        return !constLow.empty();
+    }
+
+    /** @brief get the precomputed lower search bound */
+    inline const RamDomain* getConstLow() const {
+        return constLow.data();
+    }
+
+    /** @brief get the precomputed upper search bound */
+    inline const RamDomain* getConstHigh() const {
+        return constHigh.data();
+    }
+
+    /** @brief attach precomputed search bounds */
+    inline void setConstBounds(std::vector<RamDomain> low, std::vector<RamDomain> high) {
+        constLow = std::move(low);
+        constHigh = std::move(high);
+    }
+
 protected:
     enum InterpreterNodeType type;
     const RamNode* shadow;
     std::vector<std::unique_ptr<InterpreterNode>> children;
     std::shared_ptr<InterpreterPreamble> preamble = nullptr;
     std::vector<size_t> data;
+    /** search bounds of an all-constant pattern, precomputed at generation time; empty otherwise */
+    std::vector<RamDomain> constLow;
+    std::vector<RamDomain> constHigh;
 };
 }  // namespace souffle
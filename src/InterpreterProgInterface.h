@@ -41,6 +41,29 @@ public:
         relation.insert(t.data);
     }
 
+    /** Insert a buffer of tuples */
+    void insert(const RamDomain* data, std::size_t numTuples) override {
+        const size_t arity = relation.getArity();
+        for (std::size_t i = 0; i < numTuples; i++, data += arity) {
+            relation.insert(data);
+        }
+    }
+
+    /** Copy the tuples into caller-provided column arrays */
+    std::size_t extract(RamDomain* const* columns) const override {
+        const size_t arity = relation.getArity();
+        std::size_t row = 0;
+        for (const RamDomain* tuple : relation) {
+            for (size_t j = 0; j < arity; j++) {
+                if (columns[j] != nullptr) {
+                    columns[j][row] = tuple[j];
+                }
+            }
+            ++row;
+        }
+        return row;
+    }
+
     /** Check whether tuple exists */
     bool contains(const tuple& t) const override {
         return relation.contains(TupleRef(&t.data[0], t.size()));
@@ -118,7 +141,7 @@ protected:
             // construct the tuple to return
             for (size_t i = 0; i < ramRelationInterface->getArity(); i++) {
                 if (*(ramRelationInterface->getAttrType(i)) == 's') {
-                    std::string s = ramRelationInterface->getSymbolTable().resolve((*it)[i]);
+                    std::string s(ramRelationInterface->getSymbolTable().resolve((*it)[i]));
                     tup << s;
                 } else {
                     tup << (*it)[i];
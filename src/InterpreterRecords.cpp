@@ -15,9 +15,15 @@
  ***********************************************************************/
 
 #include "InterpreterRecords.h"
+#include "ParallelUtils.h"
+#include <array>
+#include <atomic>
 #include <cassert>
+#include <cstdint>
+#include <istream>
 #include <limits>
-#include <map>
+#include <memory>
+#include <ostream>
 #include <unordered_map>
 #include <vector>
 
@@ -27,50 +33,114 @@ namespace {
 
 using namespace std;
 
+/**
+ * A hash function for the flat representation of a record.
+ */
+struct RecordTupleHash {
+    size_t operator()(const vector<RamDomain>& tuple) const {
+        size_t seed = tuple.size();
+        for (const RamDomain value : tuple) {
+            seed ^= static_cast<size_t>(value) + 0x9e3779b9 + (seed << 6) + (seed >> 2);
+        }
+        return seed;
+    }
+};
+
 /**
  * A bidirectional mapping between tuples and reference indices.
+ *
+ * References are resolved without any locking from an arena of packed
+ * tuples organized in fixed-size blocks, while packing only contends on
+ * one of the hash-selected stripes guarding the tuple-to-reference map,
+ * mirroring the record handling of the compiled execution.
  */
 class InterpreterRecordMap {
+    /** The number of tuples packed into each arena block */
+    static constexpr size_t BLOCK_SIZE = 1 << 20;
+
+    /** The number of blocks maintained, covering up to 2^32 references */
+    static constexpr size_t MAX_BLOCKS = (static_cast<size_t>(1) << 32) / BLOCK_SIZE;
+
+    /** The number of stripes of the tuple-to-reference map (a power of 2) */
+    static constexpr size_t STRIPE_COUNT = 64;
+
+    /** A stripe covering a hash-selected subset of the stored tuples */
+    struct Stripe {
+        /** A lock for sequentializing updates of this stripe */
+        Lock access;
+
+        /** The mapping from tuples to references/indices */
+        unordered_map<vector<RamDomain>, RamDomain, RecordTupleHash> r2i;
+
+        /** The mapping for pairs, keyed by one 64-bit word (see packPair);
+         * replaces r2i for arity-2 maps of a 32-bit domain */
+        unordered_map<uint64_t, RamDomain> pairR2i;
+    };
+
     /** The arity of the stored tuples */
     int arity;
 
-    /** The mapping from tuples to references/indices */
-    map<vector<RamDomain>, RamDomain> r2i;
+    /** The striped mapping from tuples to references/indices */
+    array<Stripe, STRIPE_COUNT> stripes;
+
+    /** The arena of packed tuples, indexed by reference */
+    array<atomic<RamDomain*>, MAX_BLOCKS> blocks{};
 
-    /** The mapping from indices to tuples */
-    vector<vector<RamDomain>> i2r;
+    /** A lock for sequentializing the allocation of arena blocks */
+    Lock alloc;
+
+    /** The next free reference; index 0 encodes the Nil record */
+    atomic<RamDomain> counter{1};
 
 public:
-    InterpreterRecordMap(int arity) : arity(arity), i2r(1) {}  // note: index 0 element left free
+    InterpreterRecordMap(int arity) : arity(arity) {}
+
+    ~InterpreterRecordMap() {
+        for (auto& block : blocks) {
+            delete[] block.load(memory_order_relaxed);
+        }
+    }
 
     /**
      * Packs the given tuple -- and may create a new reference if necessary.
      */
     RamDomain pack(const RamDomain* tuple) {
-        vector<RamDomain> tmp(arity);
-        for (int i = 0; i < arity; i++) {
-            tmp[i] = tuple[i];
+        // pairs are the idiom for composite keys; with the default 32-bit
+        // domain they collapse losslessly into a single 64-bit map key,
+        // hashed and compared in one word without a tuple allocation
+        if (sizeof(RamDomain) == 4 && arity == 2) {
+            return packPair(tuple);
         }
 
-        RamDomain index;
-#pragma omp critical(record_pack)
-        {
-            auto pos = r2i.find(tmp);
-            if (pos != r2i.end()) {
-                index = pos->second;
-            } else {
-#pragma omp critical(record_unpack)
-                {
-                    i2r.push_back(tmp);
-                    index = i2r.size() - 1;
-                    r2i[tmp] = index;
-
-                    // assert that new index is smaller than the range
-                    assert(index != std::numeric_limits<RamDomain>::max());
-                }
-            }
+        vector<RamDomain> tmp(tuple, tuple + arity);
+
+        // only the stripe covering this tuple needs to be locked
+        auto& stripe = stripes[RecordTupleHash()(tmp) & (STRIPE_COUNT - 1)];
+        auto lease = stripe.access.acquire();
+        (void)lease;  // avoid warning
+
+        // try lookup
+        auto pos = stripe.r2i.find(tmp);
+        if (pos != stripe.r2i.end()) {
+            // take the previously assigned value
+            return pos->second;
+        }
+
+        // claim the next free reference
+        RamDomain index = counter.fetch_add(1);
+
+        // assert that new index is smaller than the range
+        assert(index != numeric_limits<RamDomain>::max());
+        assert(static_cast<size_t>(index) / BLOCK_SIZE < MAX_BLOCKS && "arena exhausted");
+
+        // create entry for unpacking
+        RamDomain* slot = getBlock(index / BLOCK_SIZE) + (index % BLOCK_SIZE) * arity;
+        for (int i = 0; i < arity; i++) {
+            slot[i] = tmp[i];
         }
 
+        // add tuple to index
+        stripe.r2i.emplace(move(tmp), index);
         return index;
     }
 
@@ -78,27 +148,105 @@ public:
      * Obtains a pointer to the tuple addressed by the given index.
      */
     RamDomain* unpack(RamDomain index) {
-        RamDomain* res;
+        // just look up the right spot -- no synchronization required
+        return blocks[index / BLOCK_SIZE].load(memory_order_acquire) + (index % BLOCK_SIZE) * arity;
+    }
 
-#pragma omp critical(record_unpack)
-        res = &(i2r[index][0]);
+    /**
+     * Obtains the arity of the stored tuples.
+     */
+    int getArity() const {
+        return arity;
+    }
 
-        return res;
+    /**
+     * Obtains the next free reference; all references below are assigned.
+     */
+    RamDomain getCounter() const {
+        return counter.load(memory_order_acquire);
+    }
+
+private:
+    /**
+     * Packs an arity-2 tuple through the single-word keyed maps.
+     */
+    RamDomain packPair(const RamDomain* tuple) {
+        const uint64_t key = (static_cast<uint64_t>(static_cast<uint32_t>(tuple[0])) << 32) |
+                             static_cast<uint32_t>(tuple[1]);
+
+        // only the stripe covering this pair needs to be locked
+        auto& stripe = stripes[hash<uint64_t>()(key) & (STRIPE_COUNT - 1)];
+        auto lease = stripe.access.acquire();
+        (void)lease;  // avoid warning
+
+        // try lookup
+        auto pos = stripe.pairR2i.find(key);
+        if (pos != stripe.pairR2i.end()) {
+            // take the previously assigned value
+            return pos->second;
+        }
+
+        // claim the next free reference
+        RamDomain index = counter.fetch_add(1);
+        assert(index != numeric_limits<RamDomain>::max());
+        assert(static_cast<size_t>(index) / BLOCK_SIZE < MAX_BLOCKS && "arena exhausted");
+
+        // create entry for unpacking
+        RamDomain* slot = getBlock(index / BLOCK_SIZE) + (index % BLOCK_SIZE) * 2;
+        slot[0] = tuple[0];
+        slot[1] = tuple[1];
+
+        // add pair to index
+        stripe.pairR2i.emplace(key, index);
+        return index;
+    }
+
+    /**
+     * Obtains the arena block of the given index, allocating it on
+     * first access.
+     */
+    RamDomain* getBlock(size_t blockIndex) {
+        RamDomain* block = blocks[blockIndex].load(memory_order_acquire);
+        if (block == nullptr) {
+            auto lease = alloc.acquire();
+            (void)lease;  // avoid warning
+            block = blocks[blockIndex].load(memory_order_relaxed);
+            if (block == nullptr) {
+                block = new RamDomain[BLOCK_SIZE * arity];
+                blocks[blockIndex].store(block, memory_order_release);
+            }
+        }
+        return block;
     }
 };
 
+/** The maximal record arity for which maps are maintained */
+constexpr size_t MAX_RECORD_ARITY = 1024;
+
+/** A fixed table of lazily created maps, such that obtaining the map
+ * of an arity does not require locking */
+array<atomic<InterpreterRecordMap*>, MAX_RECORD_ARITY> maps{};
+vector<unique_ptr<InterpreterRecordMap>> owner;
+Lock mapAlloc;
+
 /**
  * The static access function for record maps of certain arities.
  */
 InterpreterRecordMap& getForArity(int arity) {
-    // the static container -- filled on demand
-    static unordered_map<int, InterpreterRecordMap> maps;
-    auto pos = maps.find(arity);
-    if (pos == maps.end()) {
-        maps.emplace(arity, arity);
-    }
+    assert(arity >= 0 && static_cast<size_t>(arity) < MAX_RECORD_ARITY && "unsupported record arity");
 
-    return maps.find(arity)->second;
+    InterpreterRecordMap* map = maps[arity].load(memory_order_acquire);
+    if (map == nullptr) {
+        auto lease = mapAlloc.acquire();
+        (void)lease;  // avoid warning
+        map = maps[arity].load(memory_order_relaxed);
+        if (map == nullptr) {
+            owner.push_back(std::make_unique<InterpreterRecordMap>(arity));
+            map = owner.back().get();
+            maps[arity].store(map, memory_order_release);
+        }
+    }
+    return *map;
 }
 }  // namespace
 
@@ -124,4 +272,40 @@ void createRecordMap(int arity) {
     getForArity(arity);
 }
 
+void saveRecordMaps(std::ostream& out) {
+    auto lease = mapAlloc.acquire();
+    (void)lease;  // avoid warning
+    uint32_t numMaps = owner.size();
+    out.write(reinterpret_cast<const char*>(&numMaps), sizeof(numMaps));
+    for (const auto& map : owner) {
+        int32_t arity = map->getArity();
+        uint64_t count = map->getCounter();
+        out.write(reinterpret_cast<const char*>(&arity), sizeof(arity));
+        out.write(reinterpret_cast<const char*>(&count), sizeof(count));
+        // index 0 encodes the Nil record and is never stored
+        for (uint64_t index = 1; index < count; ++index) {
+            out.write(reinterpret_cast<const char*>(map->unpack(index)), arity * sizeof(RamDomain));
+        }
+    }
+}
+
+void restoreRecordMaps(std::istream& in) {
+    uint32_t numMaps = 0;
+    in.read(reinterpret_cast<char*>(&numMaps), sizeof(numMaps));
+    for (uint32_t i = 0; i < numMaps; ++i) {
+        int32_t arity = 0;
+        uint64_t count = 0;
+        in.read(reinterpret_cast<char*>(&arity), sizeof(arity));
+        in.read(reinterpret_cast<char*>(&count), sizeof(count));
+        auto& map = getForArity(arity);
+        vector<RamDomain> tuple(arity);
+        for (uint64_t index = 1; index < count; ++index) {
+            in.read(reinterpret_cast<char*>(tuple.data()), arity * sizeof(RamDomain));
+            RamDomain ref = map.pack(tuple.data());
+            (void)ref;
+            assert(static_cast<uint64_t>(ref) == index && "record references must be stable");
+        }
+    }
+}
+
 }  // end of namespace souffle
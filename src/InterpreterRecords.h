@@ -18,6 +18,8 @@
 
 #include "RamTypes.h"
 
+#include <iosfwd>
+
 namespace souffle {
 
 /**
@@ -46,4 +48,17 @@ bool isNullInterpreter(RamDomain ref);
  */
 void createRecordMap(int arity);
 
+/**
+ * Writes the content of all record maps to the given stream, in a binary
+ * format suitable for restoreRecordMaps.
+ */
+void saveRecordMaps(std::ostream& out);
+
+/**
+ * Re-creates record maps from a stream written by saveRecordMaps. To be
+ * invoked on empty maps; re-packing the tuples in their original order
+ * reproduces the original reference values.
+ */
+void restoreRecordMaps(std::istream& in);
+
 }  // end of namespace souffle
@@ -18,14 +18,18 @@
 #include "BTree.h"
 #include "Brie.h"
 #include "EquivalenceRelation.h"
+#include "ParallelUtils.h"
+#include "ProfileEvent.h"
 #include "Util.h"
 
+#include <limits>
+
 namespace souffle {
 
 InterpreterRelation::InterpreterRelation(std::size_t arity, const std::string& name,
         const std::vector<std::string>& attributeTypes, const MinIndexSelection& orderSet,
         IndexFactory factory)
-        : relName(name), arity(arity), attributeTypes(attributeTypes) {
+        : relName(name), arity(arity), attributeTypes(attributeTypes), factory(factory) {
     for (auto order : orderSet.getAllOrders()) {
         // Expand the order to a total order
         std::set<int> set;
@@ -38,38 +42,136 @@ InterpreterRelation::InterpreterRelation(std::size_t arity, const std::string& n
             }
         }
         indexes.push_back(factory(Order(order)));
+        indexOrders.push_back(Order(order));
     }
 
     // Use the first index as default main index
     main = indexes[0].get();
+
+    indexHits = std::make_unique<std::atomic<size_t>[]>(indexes.size());
+    for (std::size_t i = 0; i < indexes.size(); ++i) {
+        indexHits[i] = 0;
+    }
+
+    // Only the main index is maintained eagerly; secondary indexes are
+    // populated once they are accessed for the first time
+    materialized = std::make_unique<std::atomic<bool>[]>(indexes.size());
+    for (std::size_t i = 0; i < indexes.size(); ++i) {
+        materialized[i] = (i == 0);
+    }
+}
+
+InterpreterIndex* InterpreterRelation::getIndex(const size_t& indexPos) const {
+    assert(indexPos < indexes.size());
+    if (!materialized[indexPos]) {
+        auto lease = materializeLock.acquire();
+        (void)lease;  // avoid warning;
+        if (!materialized[indexPos]) {
+            // bulk-build the deferred index from the main index; large
+            // relations are loaded partition-wise in parallel
+            InterpreterIndex& index = *indexes[indexPos];
+            if (main->size() > 10000) {
+                auto pStream = main->partitionScan(NUM_WORK_CHUNKS(0));
+                PARALLEL_START;
+                pfor(auto it = pStream.begin(); it < pStream.end(); it++) {
+                    for (const TupleRef& cur : *it) {
+                        index.insert(cur);
+                    }
+                }
+                PARALLEL_END;
+            } else {
+                for (const auto& cur : main->scan()) {
+                    index.insert(cur);
+                }
+            }
+            // force any deferred internal reorganisation (e.g. the sort of a
+            // compact index) while still holding the lock
+            index.size();
+            materialized[indexPos] = true;
+        }
+    }
+    return indexes[indexPos].get();
+}
+
+void InterpreterRelation::compact() {
+    // the compact index factory only covers the supported tuple sizes
+    if (arity == 0 || arity > 12) {
+        return;
+    }
+    for (std::size_t i = 0; i < indexes.size(); ++i) {
+        // skip previously removed indexes
+        if (indexes[i] == nullptr) {
+            continue;
+        }
+        auto compacted = createCompactIndex(indexOrders[i]);
+        // indexes that have not been accessed yet are empty; they are
+        // bulk-built from the main index once they are first used
+        if (materialized[i]) {
+            compacted->insert(*indexes[i]);
+        }
+        // force the sorting of the compact index eagerly, such that later
+        // concurrent read accesses do not race on the deferred sort
+        compacted->size();
+        bool isMain = indexes[i].get() == main;
+        indexes[i] = std::move(compacted);
+        if (isMain) {
+            main = indexes[i].get();
+        }
+    }
 }
 
 void InterpreterRelation::removeIndex(const size_t& indexPos) {
     // All but one index can be removed, default full index can't be removed.
     assert(indexes.size() > 1 || indexPos != 0);
     indexes[indexPos].reset(nullptr);
+    materialized[indexPos] = false;
 }
 
 IndexViewPtr InterpreterRelation::getView(const size_t& indexPos) const {
     assert(indexPos < indexes.size());
-    return indexes[indexPos]->createView();
+    indexHits[indexPos].fetch_add(1, std::memory_order_relaxed);
+    return getIndex(indexPos)->createView();
 }
 
 bool InterpreterRelation::insert(const TupleRef& tuple) {
     if (!main->insert(tuple)) {
         return false;
     }
-    for (const auto& cur : indexes) {
-        if (cur.get() == main) {
-            continue;
+    for (std::size_t i = 1; i < indexes.size(); ++i) {
+        // secondary indexes that have not been accessed yet are only
+        // populated on their first use
+        if (materialized[i]) {
+            indexes[i]->insert(tuple);
         }
-        cur->insert(tuple);
     }
     return true;
 }
 
+void InterpreterRelation::insertBatch(const RamDomain* tuples, std::size_t count) {
+    main->insertBatch(tuples, count);
+    // secondary indexes deduplicate on their own; those not accessed yet
+    // are bulk-built from the main index once they are first used
+    for (std::size_t i = 1; i < indexes.size(); ++i) {
+        if (indexes[i] != nullptr && materialized[i]) {
+            indexes[i]->insertBatch(tuples, count);
+        }
+    }
+}
+
 void InterpreterRelation::insert(const InterpreterRelation& other) {
-    // TODO: cover this in a smarter way
+    // merge large relations partition-wise in parallel; insertions into the
+    // underlying indexes are thread-safe
+    if (other.size() > 10000) {
+        auto pStream = other.partitionScan(NUM_WORK_CHUNKS(0));
+        PARALLEL_START;
+        pfor(auto it = pStream.begin(); it < pStream.end(); it++) {
+            for (const TupleRef& cur : *it) {
+                insert(cur);
+            }
+        }
+        PARALLEL_END;
+        return;
+    }
     for (const auto& cur : other.scan()) {
         insert(cur);
     }
@@ -80,30 +182,86 @@ bool InterpreterRelation::contains(const TupleRef& tuple) const {
 }
 
 bool InterpreterRelation::contains(const size_t& indexPos, const TupleRef& low, const TupleRef& high) const {
-    return indexes[indexPos]->contains(low, high);
+    indexHits[indexPos].fetch_add(1, std::memory_order_relaxed);
+    return getIndex(indexPos)->contains(low, high);
 }
 
 Stream InterpreterRelation::scan() const {
     return main->scan();
 }
 
+Stream InterpreterRelation::scanDistinctPrefix(size_t prefixLength) const {
+    return main->scanDistinctPrefix(prefixLength);
+}
+
 PartitionedStream InterpreterRelation::partitionScan(size_t partitionCount) const {
     return main->partitionScan(partitionCount);
 }
 
 Stream InterpreterRelation::range(const size_t& indexPos, const TupleRef& low, const TupleRef& high) const {
-    auto& pos = indexes[indexPos];
-    return pos->range(low, high);
+    indexHits[indexPos].fetch_add(1, std::memory_order_relaxed);
+    return getIndex(indexPos)->range(low, high);
 }
 
 PartitionedStream InterpreterRelation::partitionRange(
         const size_t& indexPos, const TupleRef& low, const TupleRef& high, size_t partitionCount) const {
-    auto& pos = indexes[indexPos];
-    return pos->partitionRange(low, high, partitionCount);
+    indexHits[indexPos].fetch_add(1, std::memory_order_relaxed);
+    return getIndex(indexPos)->partitionRange(low, high, partitionCount);
+}
+
+void InterpreterRelation::compactIfSparse() {
+    // lower bound of the useful footprint: the retained tuple payload
+    const size_t payload = size() * arity * sizeof(RamDomain);
+    const size_t footprint = getMemoryUsage();
+    if (footprint < COMPACTION_MIN_BYTES || payload * COMPACTION_SLACK >= footprint) {
+        return;
+    }
+    for (std::size_t i = 0; i < indexes.size(); ++i) {
+        // skip previously removed indexes
+        if (indexes[i] == nullptr) {
+            continue;
+        }
+        auto rebuilt = factory(indexOrders[i]);
+        // indexes that have not been accessed yet are empty; they are
+        // bulk-built from the main index once they are first used
+        if (materialized[i]) {
+            rebuilt->insert(*indexes[i]);
+        }
+        bool isMain = indexes[i].get() == main;
+        indexes[i] = std::move(rebuilt);
+        if (isMain) {
+            main = indexes[i].get();
+        }
+    }
+}
+
+void InterpreterRelation::releaseIdleIndexes() {
+    // the first call only records the baseline; earlier hits cannot be
+    // attributed to a single iteration
+    if (idleSnapshot == nullptr) {
+        idleSnapshot = std::make_unique<size_t[]>(indexes.size());
+        for (std::size_t i = 0; i < indexes.size(); ++i) {
+            idleSnapshot[i] = indexHits[i].load(std::memory_order_relaxed);
+        }
+        return;
+    }
+    for (std::size_t i = 1; i < indexes.size(); ++i) {
+        const size_t hits = indexHits[i].load(std::memory_order_relaxed);
+        if (indexes[i] != nullptr && materialized[i] && hits == idleSnapshot[i]) {
+            // unread for a full iteration: stop maintaining the index; a
+            // later access bulk-rebuilds it from the main index
+            indexes[i]->clear();
+            materialized[i] = false;
+        }
+        idleSnapshot[i] = hits;
+    }
 }
 
 void InterpreterRelation::swap(InterpreterRelation& other) {
     indexes.swap(other.indexes);
+    std::swap(materialized, other.materialized);
+    std::swap(indexHits, other.indexHits);
+    std::swap(idleSnapshot, other.idleSnapshot);
 }
 
 size_t InterpreterRelation::getLevel() const {
@@ -126,6 +284,16 @@ bool InterpreterRelation::empty() const {
     return main->empty();
 }
 
+size_t InterpreterRelation::getMemoryUsage() const {
+    size_t bytes = 0;
+    for (std::size_t i = 0; i < indexes.size(); ++i) {
+        if (materialized[i]) {
+            bytes += indexes[i]->getMemoryUsage();
+        }
+    }
+    return bytes;
+}
+
 void InterpreterRelation::purge() {
     for (auto& index : indexes) {
         index->clear();
@@ -151,6 +319,118 @@ void InterpreterEqRelation::extend(const InterpreterRelation& rel) {
     this->main->extend(otherEqRel->main);
 }
 
+InterpreterBitsetRelation::InterpreterBitsetRelation(size_t arity, const std::string& name,
+        const std::vector<std::string>& attributeTypes, const MinIndexSelection& orderSet)
+        : InterpreterRelation(arity, name, attributeTypes, orderSet, createBitsetIndex) {
+    assert(arity == 1 && "bitset relations must be unary");
+}
+
+InterpreterBrieRelation::InterpreterBrieRelation(size_t arity, const std::string& name,
+        const std::vector<std::string>& attributeTypes, const MinIndexSelection& orderSet)
+        : InterpreterRelation(arity, name, attributeTypes, orderSet, createBrieIndex) {
+    assert(arity <= 12 && "the trie factory only covers tuple sizes up to 12");
+}
+
+InterpreterFunctionalRelation::InterpreterFunctionalRelation(size_t arity, const std::string& name,
+        const std::vector<std::string>& attributeTypes, const MinIndexSelection& orderSet)
+        : InterpreterRelation(arity, name, attributeTypes, orderSet) {
+    assert(arity >= 2 && "functional relations require a key and a value attribute");
+    keyIndex = createBTreeIndex(Order::create(arity));
+}
+
+bool InterpreterFunctionalRelation::insert(const TupleRef& tuple) {
+    // the key index stores one tuple per key with a zeroed value attribute;
+    // its insert accepts exactly the first tuple of each key, so a losing
+    // insert leaves the established tuple in place
+    std::vector<RamDomain> key(tuple.getBase(), tuple.getBase() + arity);
+    key[arity - 1] = 0;
+    if (!keyIndex->insert(TupleRef(key.data(), arity))) {
+        return false;
+    }
+    return InterpreterRelation::insert(tuple);
+}
+
+void InterpreterFunctionalRelation::purge() {
+    InterpreterRelation::purge();
+    keyIndex->clear();
+}
+
+InterpreterAutoRelation::InterpreterAutoRelation(size_t arity, const std::string& name,
+        const std::vector<std::string>& attributeTypes, const MinIndexSelection& orderSet)
+        : InterpreterRelation(arity, name, attributeTypes, orderSet),
+          minValues(arity, std::numeric_limits<RamDomain>::max()),
+          maxValues(arity, std::numeric_limits<RamDomain>::min()) {
+    // the trie factory only covers the supported tuple sizes; for other
+    // arities the b-tree is the only candidate and sampling is pointless
+    if (arity == 0 || arity > 12) {
+        decided = true;
+    }
+}
+
+bool InterpreterAutoRelation::insert(const TupleRef& tuple) {
+    // the fast path once the representation is settled
+    if (decided.load(std::memory_order_acquire)) {
+        return InterpreterRelation::insert(tuple);
+    }
+    auto lease = samplingLock.acquire();
+    (void)lease;  // avoid warning;
+    if (!decided.load(std::memory_order_relaxed)) {
+        for (std::size_t i = 0; i < arity; ++i) {
+            const RamDomain val = tuple[i];
+            minValues[i] = std::min(minValues[i], val);
+            maxValues[i] = std::max(maxValues[i], val);
+            sawNegative = sawNegative || (val < 0);
+        }
+        if (++sampled >= SAMPLE_LIMIT) {
+            decide();
+        }
+    }
+    return InterpreterRelation::insert(tuple);
+}
+
+void InterpreterAutoRelation::decide() {
+    // the populated fraction of the volume spanned by the observed values
+    // approximates the key-prefix density the trie benefits from
+    double volume = 1.0;
+    for (std::size_t i = 0; i < arity; ++i) {
+        volume *= static_cast<double>(maxValues[i]) - static_cast<double>(minValues[i]) + 1.0;
+    }
+    const bool dense = !sawNegative && static_cast<double>(size()) * DENSITY_SLACK >= volume;
+    if (dense) {
+        // switching the factory keeps later rebuilds (e.g. compactIfSparse)
+        // on the chosen structure
+        factory = createBrieIndex;
+        for (std::size_t i = 0; i < indexes.size(); ++i) {
+            // skip previously removed indexes
+            if (indexes[i] == nullptr) {
+                continue;
+            }
+            auto rebuilt = factory(indexOrders[i]);
+            // indexes that have not been accessed yet are empty; they are
+            // bulk-built from the main index once they are first used
+            if (materialized[i]) {
+                auto pStream = indexes[i]->partitionScan(NUM_WORK_CHUNKS(0));
+                PARALLEL_START;
+                pfor(auto it = pStream.begin(); it < pStream.end(); it++) {
+                    for (const TupleRef& cur : *it) {
+                        rebuilt->insert(cur);
+                    }
+                }
+                PARALLEL_END;
+            }
+            bool isMain = indexes[i].get() == main;
+            indexes[i] = std::move(rebuilt);
+            if (isMain) {
+                main = indexes[i].get();
+            }
+        }
+    }
+    // record the decision for the profile log
+    ProfileEventSingleton::instance().makeQuantityEvent(
+            "@auto-representation;" + relName + (dense ? ";brie" : ";btree"), sampled, 0);
+    decided.store(true, std::memory_order_release);
+}
+
 InterpreterIndirectRelation::InterpreterIndirectRelation(size_t arity, const std::string& name,
         const std::vector<std::string>& attributeTypes, const MinIndexSelection& orderSet)
         : InterpreterRelation(arity, name, attributeTypes, orderSet, createIndirectIndex) {}
@@ -172,9 +452,11 @@ bool InterpreterIndirectRelation::insert(const TupleRef& tuple) {
         newTuple[i] = tuple[i];
     }
 
-    // update all indexes with new tuple
-    for (auto& cur : indexes) {
-        cur->insert(TupleRef(newTuple, arity));
+    // update the main index and all materialized secondary indexes
+    for (std::size_t i = 0; i < indexes.size(); ++i) {
+        if (materialized[i]) {
+            indexes[i]->insert(TupleRef(newTuple, arity));
+        }
     }
 
     // increment relation size
@@ -195,4 +477,8 @@ void InterpreterIndirectRelation::purge() {
     numTuples = 0;
 }
 
+size_t InterpreterIndirectRelation::getMemoryUsage() const {
+    return InterpreterRelation::getMemoryUsage() + blockList.size() * BLOCK_SIZE * sizeof(RamDomain);
+}
+
 }  // namespace souffle
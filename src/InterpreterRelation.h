@@ -19,6 +19,9 @@
 #include "InterpreterIndex.h"
 #include "RamIndexAnalysis.h"
 
+#include <atomic>
+#include <memory>
+
 namespace souffle {
 /**
  * A relation, composed of a collection of indexes.
@@ -26,7 +29,9 @@ namespace souffle {
 class InterpreterRelation {
 public:
     /**
-     * Creates a relation, build all necessary indexes.
+     * Creates a relation, allocating all necessary indexes. Only the main
+     * index is maintained eagerly; secondary indexes are populated from the
+     * main index on their first access.
      */
     InterpreterRelation(std::size_t arity, const std::string& name,
             const std::vector<std::string>& attributeTypes, const MinIndexSelection& orderSet,
@@ -105,6 +110,12 @@ public:
      */
     void insert(const InterpreterRelation& other);
 
+    /**
+     * Add a batch of tuples, given as count x arity elements in row-major
+     * order. Tree-backed indexes build the batch from sorted runs.
+     */
+    virtual void insertBatch(const RamDomain* tuples, std::size_t count);
+
     /**
      * Tests whether this relation contains the given tuple.
      */
@@ -120,6 +131,13 @@ public:
      */
     Stream scan() const;
 
+    /**
+     * Obtains a stream yielding one representative tuple per distinct
+     * prefix of the given length of the main index order; index types
+     * without prefix-skipping support fall back to a full scan.
+     */
+    Stream scanDistinctPrefix(size_t prefixLength) const;
+
     /**
      * Obtains a partitioned stream list for parallel computation
      */
@@ -181,6 +199,11 @@ public:
      */
     bool empty() const;
 
+    /**
+     * Return the number of bytes held by the materialized indexes.
+     */
+    virtual size_t getMemoryUsage() const;
+
     /**
      * Clear all indexes
      */
@@ -196,7 +219,75 @@ public:
      */
     virtual void extend(const InterpreterRelation& rel);
 
+    /**
+     * Rebuilds all indexes into a compact, read-optimized representation.
+     * To be invoked once the relation received its last update; further
+     * insertions remain possible but are no longer efficient.
+     */
+    virtual void compact();
+
+    /**
+     * Rebuilds all indexes freshly if the relation holds far less data
+     * than its allocated node footprint. Deltas of long-tail recursive
+     * strata shrink to a few tuples while keeping the tree grown for the
+     * early wide frontiers alive; invoked between fixpoint iterations to
+     * return the slack memory.
+     */
+    virtual void compactIfSparse();
+
+    /**
+     * Dematerializes secondary indexes that no operation consulted since
+     * the previous call. Invoked at fixpoint iteration boundaries on the
+     * delta relations: an index whose reading rule versions stopped firing
+     * is no longer maintained across the remaining iterations, and the
+     * deferred-materialization path rebuilds it from the main index should
+     * a later iteration read it after all.
+     */
+    void releaseIdleIndexes();
+
+    /**
+     * Return the number of maintained indexes.
+     */
+    size_t getNumIndexes() const {
+        return indexes.size();
+    }
+
+    /**
+     * Return the total order the index at the given position maintains.
+     */
+    const Order& getIndexOrder(const size_t& indexPos) const {
+        assert(indexPos < indexOrders.size());
+        return indexOrders[indexPos];
+    }
+
+    /**
+     * Return the number of times the index at the given position has been
+     * consulted; indexes that were never hit are candidates for removal.
+     */
+    size_t getIndexHits(const size_t& indexPos) const {
+        assert(indexPos < indexes.size());
+        return indexHits[indexPos].load(std::memory_order_relaxed);
+    }
+
+    /**
+     * Return the structure statistics of the index at the given position;
+     * indexes whose materialization is still deferred report empty stats.
+     */
+    StructureStats getIndexStats(const size_t& indexPos) const {
+        assert(indexPos < indexes.size());
+        if (!materialized[indexPos]) {
+            return StructureStats();
+        }
+        return indexes[indexPos]->getStructureStats();
+    }
+
 protected:
+    /**
+     * Obtains the index at the given position, populating it from the main
+     * index first in case it has not been accessed before.
+     */
+    InterpreterIndex* getIndex(const size_t& indexPos) const;
+
     // Relation name
     std::string relName;
 
@@ -206,12 +297,38 @@ protected:
     // Relation attributes types
     std::vector<std::string> attributeTypes;
 
+    // do not bother recovering less than this much index memory
+    static const size_t COMPACTION_MIN_BYTES = 1 << 20;
+
+    // footprint-to-payload ratio above which a sparse relation is rebuilt
+    static const size_t COMPACTION_SLACK = 8;
+
+    // the factory the indexes were created with, used for rebuilds
+    IndexFactory factory;
+
     // a map of managed indexes
     std::vector<std::unique_ptr<InterpreterIndex>> indexes;
 
+    // the total orders the managed indexes are maintained in
+    std::vector<Order> indexOrders;
+
     // a pointer to the main index within the managed index
     InterpreterIndex* main;
 
+    // flags whether the index at the corresponding position has been
+    // populated; deferred secondary indexes are bulk-built on first access
+    mutable std::unique_ptr<std::atomic<bool>[]> materialized;
+
+    // synchronizes the deferred construction of secondary indexes
+    mutable Lock materializeLock;
+
+    // per-index hit counters, incremented whenever an index is consulted
+    mutable std::unique_ptr<std::atomic<size_t>[]> indexHits;
+
+    // hit counts at the previous releaseIdleIndexes() call; indexes whose
+    // counter did not advance in between are dematerialized
+    std::unique_ptr<size_t[]> idleSnapshot;
+
     // relation level
     size_t level = 0;
 };  // namespace souffle
@@ -226,6 +343,107 @@ public:
 
     /** Extend this relation with new knowledge generated by inserting all tuples from a relation */
     void extend(const InterpreterRelation& rel) override;
+
+    /** Equivalence relations are already stored compactly; nothing to do */
+    void compact() override {}
+
+    /** Disjoint-set forests do not retain slack nodes; nothing to do */
+    void compactIfSparse() override {}
+};
+
+/**
+ * Interpreter Bitset Relation
+ */
+class InterpreterBitsetRelation : public InterpreterRelation {
+public:
+    InterpreterBitsetRelation(size_t arity, const std::string& relName,
+            const std::vector<std::string>& attributeTypes, const MinIndexSelection& orderSet);
+
+    /** Bitsets are already stored compactly; nothing to do */
+    void compact() override {}
+
+    /** Bitsets do not retain slack nodes; nothing to do */
+    void compactIfSparse() override {}
+};
+
+/**
+ * Interpreter Brie Relation
+ */
+class InterpreterBrieRelation : public InterpreterRelation {
+public:
+    InterpreterBrieRelation(size_t arity, const std::string& relName,
+            const std::vector<std::string>& attributeTypes, const MinIndexSelection& orderSet);
+
+    /** Tries are shaped by their content alone; a rebuild reproduces the same structure */
+    void compact() override {}
+
+    /** See compact() */
+    void compactIfSparse() override {}
+};
+
+/**
+ * Interpreter Functional Relation
+ */
+class InterpreterFunctionalRelation : public InterpreterRelation {
+public:
+    InterpreterFunctionalRelation(size_t arity, const std::string& relName,
+            const std::vector<std::string>& attributeTypes, const MinIndexSelection& orderSet);
+
+    /** Insert tuple unless its key (all attributes but the last) is already mapped */
+    bool insert(const TupleRef& tuple) override;
+
+    /** Clear all indexes */
+    void purge() override;
+
+private:
+    /** Tuples with zeroed value attribute, deciding key ownership at insert time */
+    std::unique_ptr<InterpreterIndex> keyIndex;
+};
+
+/**
+ * Interpreter Auto Relation
+ *
+ * Starts out b-tree backed and samples the values of the first inserted
+ * tuples; once enough data has been observed, the populated fraction of
+ * the spanned key space decides whether the indexes are migrated to the
+ * trie structure (which wins on dense key prefixes) or remain on the
+ * b-tree. The decision is recorded as a profile event.
+ */
+class InterpreterAutoRelation : public InterpreterRelation {
+public:
+    InterpreterAutoRelation(size_t arity, const std::string& relName,
+            const std::vector<std::string>& attributeTypes, const MinIndexSelection& orderSet);
+
+    /** Insert tuple, sampling its values until the representation is chosen */
+    bool insert(const TupleRef& tuple) override;
+
+private:
+    /** Chooses the representation, rebuilding all indexes if the trie won */
+    void decide();
+
+    /** Number of tuples sampled before the representation is chosen */
+    static const size_t SAMPLE_LIMIT = 1 << 20;
+
+    /** A key space counts as dense when at least a 1/DENSITY_SLACK
+     * fraction of the volume spanned by the observed values is populated */
+    static const size_t DENSITY_SLACK = 16;
+
+    /** Per-column minimum / maximum values observed so far */
+    std::vector<RamDomain> minValues;
+    std::vector<RamDomain> maxValues;
+
+    /** Whether a negative value has been observed; the trie orders by the
+     * unsigned interpretation and would change the scan order of signed data */
+    bool sawNegative = false;
+
+    /** Number of tuples sampled so far */
+    size_t sampled = 0;
+
+    /** Whether the representation decision has been made */
+    std::atomic<bool> decided{false};
+
+    /** Serializes sampling and migration against parallel inserts */
+    Lock samplingLock;
 };
 
 /**
@@ -243,6 +461,16 @@ public:
     /** Clear all indexes */
     void purge() override;
 
+    /** Indirect indexes reference the externally maintained tuple blocks;
+     * rebuilding them would not reclaim that storage */
+    void compact() override {}
+
+    /** See compact() */
+    void compactIfSparse() override {}
+
+    /** Account for the tuple blocks on top of the index memory */
+    size_t getMemoryUsage() const override;
+
 private:
     /** Size of blocks containing tuples */
     static const int BLOCK_SIZE = 1024;
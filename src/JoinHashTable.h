@@ -0,0 +1,209 @@
+/*
+ * Souffle - A Datalog Compiler
+ * Copyright (c) 2019, The Souffle Developers. All rights reserved.
+ * Licensed under the Universal Permissive License v 1.0 as shown at:
+ * - https://opensource.org/licenses/UPL
+ * - <souffle root>/licenses/SOUFFLE-UPL.txt
+ */
+
+/************************************************************************
+ *
+ * @file JoinHashTable.h
+ *
+ * A transient open-addressing hash table supporting hash joins. The
+ * table maps the bound columns of a join to the tuples exhibiting them
+ * and is built once on the smaller side of a one-shot join, where
+ * maintaining a persistent btree index for a single traversal would be
+ * wasted work. Used by both the interpreter and synthesised code.
+ *
+ ***********************************************************************/
+
+#pragma once
+
+#include "RamTypes.h"
+
+#include <cassert>
+#include <cstddef>
+#include <functional>
+#include <vector>
+
+namespace souffle {
+
+/**
+ * @class JoinHashTable
+ * @brief A multimap from key columns to tuples with linear probing
+ *
+ * Tuples are stored in insertion order in a flat array; the slot table
+ * holds offsets into it. Duplicate keys occupy consecutive probe slots,
+ * such that a probe enumerates all matches of a key before reaching an
+ * empty slot.
+ */
+class JoinHashTable {
+public:
+    JoinHashTable(std::vector<std::size_t> keyColumns, std::size_t arity)
+            : keyColumns(std::move(keyColumns)), arity(arity) {
+        assert(!this->keyColumns.empty() && "hash join requires at least one bound column");
+    }
+
+    /** @brief Pre-size the slot table for the given number of tuples */
+    void reserve(std::size_t numTuples) {
+        std::size_t required = 2 * numTuples;
+        std::size_t capacity = minCapacity;
+        while (capacity < required) {
+            capacity <<= 1;
+        }
+        if (capacity > slots.size()) {
+            rehash(capacity);
+        }
+    }
+
+    /** @brief Insert a tuple of the configured arity */
+    void insert(const RamDomain* tuple) {
+        if (2 * (numTuples + 1) > slots.size()) {
+            rehash(slots.empty() ? minCapacity : 2 * slots.size());
+        }
+        std::size_t offset = tuples.size();
+        tuples.insert(tuples.end(), tuple, tuple + arity);
+        place(offset);
+        ++numTuples;
+    }
+
+    std::size_t size() const {
+        return numTuples;
+    }
+
+    /** @brief Iterator over the tuples matching one probe key */
+    class iterator {
+    public:
+        iterator(const JoinHashTable* table, const RamDomain* key, std::size_t pos)
+                : table(table), key(key), pos(pos) {
+            seek();
+        }
+
+        const RamDomain* operator*() const {
+            return &table->tuples[table->slots[pos] - 1];
+        }
+
+        iterator& operator++() {
+            pos = (pos + 1) & (table->slots.size() - 1);
+            seek();
+            return *this;
+        }
+
+        bool operator==(const iterator& other) const {
+            return pos == other.pos;
+        }
+
+        bool operator!=(const iterator& other) const {
+            return pos != other.pos;
+        }
+
+    private:
+        /** advance to the next slot matching the key, or to the end */
+        void seek() {
+            while (pos != npos) {
+                std::size_t slot = table->slots[pos];
+                if (slot == 0) {
+                    pos = npos;
+                    break;
+                }
+                if (table->matches(slot - 1, key)) {
+                    break;
+                }
+                pos = (pos + 1) & (table->slots.size() - 1);
+            }
+        }
+
+        const JoinHashTable* table;
+        const RamDomain* key;
+        std::size_t pos;
+    };
+
+    /** @brief The range of tuples matching one probe key */
+    class range {
+    public:
+        range(iterator begin, iterator end) : from(begin), to(end) {}
+        iterator begin() const {
+            return from;
+        }
+        iterator end() const {
+            return to;
+        }
+
+    private:
+        iterator from;
+        iterator to;
+    };
+
+    /**
+     * @brief Probe the table with the given key values, ordered by the
+     * configured key columns
+     */
+    range equalRange(const RamDomain* key) const {
+        if (slots.empty()) {
+            return range(iterator(this, key, npos), iterator(this, key, npos));
+        }
+        std::size_t pos = hash(key) & (slots.size() - 1);
+        return range(iterator(this, key, pos), iterator(this, key, npos));
+    }
+
+private:
+    static constexpr std::size_t npos = static_cast<std::size_t>(-1);
+    static constexpr std::size_t minCapacity = 16;
+
+    /** @brief Check whether the tuple at the given offset exhibits the key */
+    bool matches(std::size_t offset, const RamDomain* key) const {
+        const RamDomain* tuple = &tuples[offset];
+        for (std::size_t i = 0; i < keyColumns.size(); ++i) {
+            if (tuple[keyColumns[i]] != key[i]) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    std::size_t hash(const RamDomain* key) const {
+        std::size_t seed = 0;
+        for (std::size_t i = 0; i < keyColumns.size(); ++i) {
+            seed ^= std::hash<RamDomain>()(key[i]) + 0x9e3779b9 + (seed << 6) + (seed >> 2);
+        }
+        return seed;
+    }
+
+    /** @brief Find an empty slot for the tuple at the given offset */
+    void place(std::size_t offset) {
+        const RamDomain* tuple = &tuples[offset];
+        std::size_t seed = 0;
+        for (std::size_t column : keyColumns) {
+            seed ^= std::hash<RamDomain>()(tuple[column]) + 0x9e3779b9 + (seed << 6) + (seed >> 2);
+        }
+        std::size_t pos = seed & (slots.size() - 1);
+        while (slots[pos] != 0) {
+            pos = (pos + 1) & (slots.size() - 1);
+        }
+        slots[pos] = offset + 1;
+    }
+
+    void rehash(std::size_t capacity) {
+        slots.assign(capacity, 0);
+        for (std::size_t offset = 0; offset < tuples.size(); offset += arity) {
+            place(offset);
+        }
+    }
+
+    /** columns forming the probe key, in probe order */
+    const std::vector<std::size_t> keyColumns;
+
+    /** number of columns per tuple */
+    const std::size_t arity;
+
+    /** all inserted tuples, flattened */
+    std::vector<RamDomain> tuples;
+
+    /** 1-based offsets into the tuple array; 0 marks an empty slot */
+    std::vector<std::size_t> slots;
+
+    std::size_t numTuples = 0;
+};
+
+}  // end of namespace souffle
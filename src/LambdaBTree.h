@@ -85,7 +85,7 @@ public:
             }
 
             // create new node
-            this->leftmost = new typename parenttype::leaf_node();
+            this->leftmost = parenttype::node::makeLeaf(this->pool);
             this->leftmost->numElements = 1;
             // call the functor as we've successfully inserted
             typename Functor::result_type res = f(k);
@@ -309,8 +309,8 @@ public:
 
                 // split this node
                 auto old_root = this->root;
-                idx -= cur->rebalance_or_split(
-                        const_cast<typename parenttype::node**>(&this->root), this->root_lock, idx, parents);
+                idx -= cur->rebalance_or_split(const_cast<typename parenttype::node**>(&this->root),
+                        this->root_lock, this->pool, idx, parents);
 
                 // release parent lock
                 for (auto it = parents.rbegin(); it != parents.rend(); ++it) {
@@ -363,7 +363,7 @@ public:
         // special handling for inserting first element
         if (this->empty()) {
             // create new node
-            this->leftmost = new typename parenttype::leaf_node();
+            this->leftmost = parenttype::node::makeLeaf(this->pool);
             this->leftmost->numElements = 1;
             // call the functor as we've successfully inserted
             typename Functor::result_type res = f(k);
@@ -441,7 +441,7 @@ public:
             if (cur->numElements >= parenttype::node::maxKeys) {
                 // split this node
                 idx -= cur->rebalance_or_split(
-                        const_cast<typename parenttype::node**>(&this->root), this->root_lock, idx);
+                        const_cast<typename parenttype::node**>(&this->root), this->root_lock, this->pool, idx);
 
                 // insert element in right fragment
                 if (((typename parenttype::size_type)idx) > cur->numElements) {
@@ -44,6 +44,7 @@ public:
         struct rusage ru {};
         getrusage(RUSAGE_SELF, &ru);
         startMaxRSS = ru.ru_maxrss;
+        startCounters = PerfCounters::instance().sample();
         // Assume that if we are logging the progress of an event then we care about usage during that time.
         ProfileEventSingleton::instance().resetTimerInterval();
     }
@@ -54,6 +55,10 @@ public:
         size_t endMaxRSS = ru.ru_maxrss;
         ProfileEventSingleton::instance().makeTimingEvent(
                 label, start, now(), startMaxRSS, endMaxRSS, size() - preSize, iteration);
+        if (PerfCounters::instance().isAvailable()) {
+            ProfileEventSingleton::instance().makeCounterEvent(
+                    label, PerfCounters::instance().sample() - startCounters, iteration);
+        }
     }
 
 private:
@@ -63,5 +68,6 @@ private:
     size_t iteration;
     std::function<size_t()> size;
     size_t preSize;
+    PerfCounters::Sample startCounters;
 };
 }  // end of namespace souffle
@@ -19,17 +19,21 @@
 #include "AstIO.h"
 #include "AstIOTypeAnalysis.h"
 #include "AstNode.h"
+#include "AstProfileUse.h"
 #include "AstProgram.h"
 #include "AstRelation.h"
 #include "AstTransforms.h"
 #include "AstTranslationUnit.h"
 #include "BinaryConstraintOps.h"
+#include "DebugReport.h"
 #include "Global.h"
 #include "IODirectives.h"
+#include "PrecedenceGraph.h"
 #include "RelationRepresentation.h"
 #include "SrcLocation.h"
 #include "Util.h"
 #include <cassert>
+#include <sstream>
 #include <utility>
 
 namespace souffle {
@@ -1062,6 +1066,102 @@ void replaceUnderscores(AstProgram* program) {
 // -- -- Replace the clause with H :- mag(H), T.
 // -- Add the fact m_G_f...f to S
 // Remove all old idb rules
+// the minimum number of tuples the magic predicates must be predicted to
+// save before the transformation is applied to a stratum; below this the
+// extra predicates and rules cost more than the avoided derivations
+static const size_t MAGIC_SETUP_COST = 1000;
+
+/**
+ * Estimates, per SCC, whether the magic predicates pay for themselves and
+ * extends the ignored-atom set with the relations of the SCCs where they do
+ * not. The estimate combines relation sizes -- taken from a profile of a
+ * previous run where available, and from the defined fact counts otherwise
+ * -- with the fraction of bound argument positions in the adorned clause
+ * heads: the saved derivations scale with the bound fraction of the tuples
+ * of the stratum, so strata that are small or barely bound are left
+ * untransformed. The per-SCC decisions are appended to the debug report.
+ */
+static void gateOnEstimatedCost(AstTranslationUnit& translationUnit,
+        const std::vector<std::vector<AdornedClause>>& allAdornedClauses,
+        std::set<AstRelationIdentifier>& ignoredAtoms) {
+    auto* sccGraph = translationUnit.getAnalysis<SCCGraph>();
+    auto* profileUse = translationUnit.getAnalysis<AstProfileUse>();
+
+    // the estimated size of a relation: profiled size if available,
+    // otherwise the number of facts defined for it
+    auto relationSize = [&](const AstRelation* rel) {
+        if (profileUse->hasRelationSize(rel->getName())) {
+            return profileUse->getRelationSize(rel->getName());
+        }
+        size_t facts = 0;
+        for (const AstClause* clause : rel->getClauses()) {
+            if (clause->isFact()) {
+                facts++;
+            }
+        }
+        return facts;
+    };
+
+    // count the bound and total argument positions per relation over all
+    // adorned clause heads
+    std::map<AstRelationIdentifier, std::pair<size_t, size_t>> boundCounts;
+    for (const auto& adornedClauses : allAdornedClauses) {
+        for (const AdornedClause& cur : adornedClauses) {
+            auto& counts = boundCounts[cur.getClause()->getHead()->getName()];
+            for (const char c : cur.getHeadAdornment()) {
+                counts.second++;
+                if (c == 'b') {
+                    counts.first++;
+                }
+            }
+        }
+    }
+
+    std::stringstream summary;
+    for (size_t scc = 0; scc < sccGraph->getNumberOfSCCs(); scc++) {
+        size_t totalSize = 0;
+        size_t bound = 0;
+        size_t total = 0;
+        bool anyAdorned = false;
+        std::vector<AstRelationIdentifier> members;
+        for (const AstRelation* rel : sccGraph->getInternalRelations(scc)) {
+            totalSize += relationSize(rel);
+            members.push_back(rel->getName());
+            auto pos = boundCounts.find(rel->getName());
+            if (pos != boundCounts.end()) {
+                anyAdorned = true;
+                bound += pos->second.first;
+                total += pos->second.second;
+            }
+        }
+
+        // only strata the adornment machinery covers are subject to the gate
+        if (!anyAdorned) {
+            continue;
+        }
+
+        const double boundRatio = total == 0 ? 0.0 : static_cast<double>(bound) / total;
+        const double predictedSavings = totalSize * boundRatio;
+        const bool apply = predictedSavings > MAGIC_SETUP_COST;
+
+        if (!apply) {
+            for (const AstRelationIdentifier& name : members) {
+                ignoredAtoms.insert(name);
+            }
+        }
+
+        summary << "SCC " << scc << " {" << join(members, ", ") << "}: estimated size " << totalSize
+                << ", bound ratio " << boundRatio << ", predicted saved tuples " << predictedSavings << " ("
+                << (profileUse->hasRelationSize(members[0]) ? "profiled" : "fact-count estimate") << ") => "
+                << (apply ? "transformed" : "skipped") << "\n";
+    }
+
+    if (!Global::config().get("debug-report").empty()) {
+        translationUnit.getDebugReport().addSection(DebugReportSection(
+                "magic-set-cost-model", "Magic Set Cost Model", {}, summary.str()));
+    }
+}
+
 bool MagicSetTransformer::transform(AstTranslationUnit& translationUnit) {
     AstProgram* program = translationUnit.getProgram();
     auto* ioTypes = translationUnit.getAnalysis<IOType>();
@@ -1094,6 +1194,10 @@ bool MagicSetTransformer::transform(AstTranslationUnit& translationUnit) {
         ignoredAtoms.insert(relation);
     }
 
+    // ignore the strata where the magic predicates are predicted to cost
+    // more than the derivations they save
+    gateOnEstimatedCost(translationUnit, allAdornedClauses, ignoredAtoms);
+
     // perform magic set algorithm for each output
     for (size_t querynum = 0; querynum < outputQueries.size(); querynum++) {
         AstRelationIdentifier outputQuery = outputQueries[querynum];
@@ -0,0 +1,390 @@
+/*
+ * Souffle - A Datalog Compiler
+ * Copyright (c) 2018, The Souffle Developers. All rights reserved
+ * Licensed under the Universal Permissive License v 1.0 as shown at:
+ * - https://opensource.org/licenses/UPL
+ * - <souffle root>/licenses/SOUFFLE-UPL.txt
+ */
+
+/************************************************************************
+ *
+ * @file MemoryPool.h
+ *
+ * An arena-style memory pool for the nodes of index structures. Nodes of
+ * one container instance are packed into large, contiguous chunks and the
+ * entire pool can be released in (near) constant time when the owning
+ * container is purged -- avoiding both allocator contention under
+ * parallel inserts and heap fragmentation when large relations are
+ * dropped between strata.
+ *
+ * When a spill directory is configured (via the --spill-dir option or
+ * the SOUFFLE_SPILL_DIR environment variable), chunks are backed by
+ * memory-mapped, unlinked temporary files in that directory instead of
+ * the heap. The OS can then page cold segments out to disk, degrading
+ * to disk bandwidth for relations exceeding main memory instead of
+ * triggering the OOM killer.
+ *
+ * When huge pages are enabled (via the --huge-pages option or the
+ * SOUFFLE_HUGE_PAGES environment variable), chunks spanning at least one
+ * huge page are backed by huge-page mappings -- pre-reserved hugetlb
+ * pages when available, transparent huge pages otherwise -- cutting TLB
+ * pressure on scan-heavy strata with large working sets.
+ *
+ ***********************************************************************/
+
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdlib>
+#include <mutex>
+#include <new>
+#include <string>
+#include <utility>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+
+namespace souffle {
+
+/**
+ * A chunked bump allocator. Memory is handed out from the current chunk
+ * through a single atomic increment; when a chunk is exhausted a new,
+ * geometrically grown chunk is appended. Individual deallocations are
+ * not supported -- all memory is returned at once by reset() or the
+ * destructor, which makes releasing a fully built index O(#chunks).
+ *
+ * All allocations are aligned to cache-line boundaries, such that nodes
+ * of index structures never straddle a cache line. The allocation fast
+ * path is thread safe and lock free; chunk growth is serialized
+ * internally.
+ */
+class MemoryPool {
+    // the alignment granted to all allocations (one cache line)
+    enum { ALIGNMENT = 64 };
+
+    /**
+     * The header of a chunk of memory; the usable memory area
+     * is located directly behind the header.
+     */
+    struct alignas(ALIGNMENT) Chunk {
+        // the next (older) chunk in the chain of chunks
+        Chunk* next;
+
+        // the usable size of this chunk in bytes
+        std::size_t size;
+
+        // the bump pointer within this chunk
+        std::atomic<std::size_t> used;
+
+        // whether this chunk is backed by a memory-mapped spill file
+        bool mapped;
+    };
+
+    // the default size of the first chunk requested
+    enum { DEFAULT_INITIAL_SIZE = 1 << 14 };
+
+    // the upper limit for the geometric chunk growth
+    enum { MAX_CHUNK_SIZE = 1 << 26 };
+
+    // the chunk memory is currently handed out from (head of the chunk chain)
+    std::atomic<Chunk*> current{nullptr};
+
+    // recycled chunks available for reuse, oldest (smallest) first
+    Chunk* freeChunks = nullptr;
+
+    // the size of the next chunk to be created
+    std::size_t nextChunkSize;
+
+    // a lock synchronizing the creation of new chunks
+    std::mutex growthLock;
+
+public:
+    /**
+     * Creates an empty pool; the given size determines the size of the
+     * first chunk, subsequent chunks are grown geometrically.
+     */
+    MemoryPool(std::size_t initialSize = DEFAULT_INITIAL_SIZE) : nextChunkSize(align(initialSize)) {}
+
+    // pools must not be copied -- handed out memory would be owned twice
+    MemoryPool(const MemoryPool&) = delete;
+    MemoryPool& operator=(const MemoryPool&) = delete;
+
+    // a move constructor taking over the chunks of another pool
+    MemoryPool(MemoryPool&& other)
+            : current(other.current.load(std::memory_order_relaxed)), freeChunks(other.freeChunks),
+              nextChunkSize(other.nextChunkSize) {
+        other.current.store(nullptr, std::memory_order_relaxed);
+        other.freeChunks = nullptr;
+    }
+
+    // a move assignment taking over the chunks of another pool
+    MemoryPool& operator=(MemoryPool&& other) {
+        if (this == &other) return *this;
+        reset();
+        current.store(other.current.load(std::memory_order_relaxed), std::memory_order_relaxed);
+        freeChunks = other.freeChunks;
+        nextChunkSize = other.nextChunkSize;
+        other.current.store(nullptr, std::memory_order_relaxed);
+        other.freeChunks = nullptr;
+        return *this;
+    }
+
+    ~MemoryPool() {
+        reset();
+    }
+
+    /**
+     * Obtains a block of memory of the given size from this pool. The
+     * resulting memory remains valid until the pool is reset or destroyed;
+     * it can not be freed individually.
+     */
+    void* allocate(std::size_t size) {
+        size = align(size);
+        while (true) {
+            // fast path -- bump the counter of the current chunk
+            Chunk* chunk = current.load(std::memory_order_acquire);
+            if (chunk) {
+                auto pos = chunk->used.fetch_add(size, std::memory_order_relaxed);
+                if (pos + size <= chunk->size) {
+                    return data(chunk) + pos;
+                }
+            }
+
+            // slow path -- append a new chunk (unless another thread did)
+            std::lock_guard<std::mutex> guard(growthLock);
+            if (current.load(std::memory_order_acquire) == chunk) {
+                grow(size);
+            }
+        }
+    }
+
+    /**
+     * Releases all chunks of this pool at once, invalidating all memory
+     * previously handed out. Note that no destructors are invoked -- it is
+     * the responsibility of the owning container to destroy non-trivial
+     * content before resetting the pool.
+     */
+    void reset() {
+        release(current.load(std::memory_order_relaxed));
+        release(freeChunks);
+        current.store(nullptr, std::memory_order_relaxed);
+        freeChunks = nullptr;
+    }
+
+    /**
+     * Logically releases all memory handed out by this pool while keeping
+     * the chunks themselves for subsequent allocations. All previously
+     * handed out memory is invalidated, but no memory is returned to the
+     * system -- re-filling the pool with a similar shape, as the delta
+     * relations of a semi-naive iteration do, then reuses the retained
+     * chunks instead of paying an allocation (and page-fault) storm at
+     * every iteration boundary. As with reset(), no destructors are
+     * invoked.
+     */
+    void recycle() {
+        Chunk* chunk = current.load(std::memory_order_relaxed);
+        while (chunk) {
+            Chunk* next = chunk->next;
+            chunk->next = freeChunks;
+            freeChunks = chunk;
+            chunk = next;
+        }
+        current.store(nullptr, std::memory_order_relaxed);
+    }
+
+    /**
+     * Configures the directory used for spilling chunks to disk. To be
+     * invoked once at startup, before any pool starts allocating; an
+     * empty string disables spilling. The initial value is taken from
+     * the SOUFFLE_SPILL_DIR environment variable, such that compiled
+     * programs inherit the setting from the driver.
+     */
+    static void setSpillDirectory(const std::string& dir) {
+        spillDirectory() = dir;
+    }
+
+    /**
+     * Configures whether chunks should be backed by huge pages. To be
+     * invoked once at startup, before any pool starts allocating. The
+     * initial value is taken from the SOUFFLE_HUGE_PAGES environment
+     * variable, such that compiled programs inherit the setting from
+     * the driver.
+     */
+    static void setHugePages(bool enable) {
+        hugePagesEnabled() = enable;
+    }
+
+    /**
+     * Exchanges the content of this and the given pool.
+     */
+    void swap(MemoryPool& other) {
+        Chunk* tmp = current.load(std::memory_order_relaxed);
+        current.store(other.current.load(std::memory_order_relaxed), std::memory_order_relaxed);
+        other.current.store(tmp, std::memory_order_relaxed);
+        std::swap(freeChunks, other.freeChunks);
+        std::swap(nextChunkSize, other.nextChunkSize);
+    }
+
+    /**
+     * Determines the total amount of memory reserved by this pool,
+     * including recycled chunks awaiting reuse.
+     */
+    std::size_t getMemoryUsage() const {
+        std::size_t res = 0;
+        for (Chunk* chunk = current.load(std::memory_order_relaxed); chunk; chunk = chunk->next) {
+            res += sizeof(Chunk) + chunk->size;
+        }
+        for (Chunk* chunk = freeChunks; chunk; chunk = chunk->next) {
+            res += sizeof(Chunk) + chunk->size;
+        }
+        return res;
+    }
+
+private:
+    // rounds the given size up to the granted cache-line alignment
+    static std::size_t align(std::size_t size) {
+        return (size + ALIGNMENT - 1) & ~std::size_t(ALIGNMENT - 1);
+    }
+
+    // obtains the start of the usable memory area of a chunk
+    static char* data(Chunk* chunk) {
+        return reinterpret_cast<char*>(chunk + 1);
+    }
+
+    // the directory chunks are spilled to; empty when spilling is disabled
+    static std::string& spillDirectory() {
+        static std::string dir = []() {
+            const char* env = std::getenv("SOUFFLE_SPILL_DIR");
+            return env ? std::string(env) : std::string();
+        }();
+        return dir;
+    }
+
+    // the size of a huge page on the supported platforms
+    enum { HUGE_PAGE_SIZE = 1 << 21 };
+
+    // whether chunks should be backed by huge pages
+    static bool& hugePagesEnabled() {
+        static bool enabled = std::getenv("SOUFFLE_HUGE_PAGES") != nullptr;
+        return enabled;
+    }
+
+    // maps an anonymous huge-page backed chunk of at least the given total
+    // size; the size is rounded up to whole huge pages and reported back
+    // through the parameter. Returns nullptr on failure.
+    static Chunk* mapHugeChunk(std::size_t& bytes) {
+        bytes = (bytes + HUGE_PAGE_SIZE - 1) & ~std::size_t(HUGE_PAGE_SIZE - 1);
+#ifdef MAP_HUGETLB
+        void* mem = mmap(nullptr, bytes, PROT_READ | PROT_WRITE,
+                MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB, -1, 0);
+        if (mem != MAP_FAILED) {
+            return static_cast<Chunk*>(mem);
+        }
+#endif
+        // no pre-reserved hugetlb pages available -- fall back to a regular
+        // anonymous mapping and advise the kernel to use transparent huge
+        // pages for it
+        void* mem2 = mmap(nullptr, bytes, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+        if (mem2 == MAP_FAILED) {
+            return nullptr;
+        }
+#ifdef MADV_HUGEPAGE
+        madvise(mem2, bytes, MADV_HUGEPAGE);
+#endif
+        return static_cast<Chunk*>(mem2);
+    }
+
+    // maps a chunk of the given total size onto an unlinked temporary
+    // file in the given directory; returns nullptr on failure
+    static Chunk* mapChunk(const std::string& dir, std::size_t bytes) {
+        std::string path = dir + "/souffle-spill-XXXXXX";
+        int fd = mkstemp(&path[0]);
+        if (fd < 0) {
+            return nullptr;
+        }
+        // unlink right away -- the disk space is reclaimed once the
+        // mapping is removed or the process terminates
+        unlink(path.c_str());
+        if (ftruncate(fd, bytes) != 0) {
+            close(fd);
+            return nullptr;
+        }
+        void* mem = mmap(nullptr, bytes, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+        close(fd);
+        return (mem == MAP_FAILED) ? nullptr : static_cast<Chunk*>(mem);
+    }
+
+    // frees all chunks of the given chain
+    static void release(Chunk* chunk) {
+        while (chunk) {
+            Chunk* next = chunk->next;
+            if (chunk->mapped) {
+                munmap(chunk, sizeof(Chunk) + chunk->size);
+            } else {
+                std::free(chunk);
+            }
+            chunk = next;
+        }
+    }
+
+    // appends a new chunk capable of holding at least the given size
+    void grow(std::size_t size) {
+        // prefer re-using a recycled chunk over requesting new memory
+        for (Chunk **prev = &freeChunks, *cur = freeChunks; cur; prev = &cur->next, cur = cur->next) {
+            if (cur->size >= size) {
+                *prev = cur->next;
+                cur->next = current.load(std::memory_order_relaxed);
+                cur->used.store(0, std::memory_order_relaxed);
+                current.store(cur, std::memory_order_release);
+                return;
+            }
+        }
+
+        std::size_t chunkSize = nextChunkSize;
+        while (chunkSize < size) {
+            chunkSize *= 2;
+        }
+        Chunk* chunk = nullptr;
+        bool mapped = false;
+        const std::string& dir = spillDirectory();
+        if (!dir.empty()) {
+            chunk = mapChunk(dir, sizeof(Chunk) + chunkSize);
+            mapped = (chunk != nullptr);
+            // on failure fall back to the heap below -- running in RAM
+            // is preferable to aborting the evaluation
+        }
+        if (!chunk && hugePagesEnabled() && sizeof(Chunk) + chunkSize >= std::size_t(HUGE_PAGE_SIZE)) {
+            std::size_t bytes = sizeof(Chunk) + chunkSize;
+            chunk = mapHugeChunk(bytes);
+            if (chunk) {
+                mapped = true;
+                // the mapping was rounded up to whole huge pages; hand the
+                // surplus out as usable chunk memory
+                chunkSize = bytes - sizeof(Chunk);
+            }
+        }
+        if (!chunk) {
+            // the chunk start must honour the granted cache-line alignment
+            void* mem = nullptr;
+            if (posix_memalign(&mem, ALIGNMENT, sizeof(Chunk) + chunkSize) != 0) {
+                mem = nullptr;
+            }
+            chunk = static_cast<Chunk*>(mem);
+        }
+        if (!chunk) {
+            throw std::bad_alloc();
+        }
+        chunk->mapped = mapped;
+        chunk->next = current.load(std::memory_order_relaxed);
+        chunk->size = chunkSize;
+        chunk->used.store(0, std::memory_order_relaxed);
+        if (nextChunkSize < std::size_t(MAX_CHUNK_SIZE)) {
+            nextChunkSize = chunkSize * 2;
+        }
+        current.store(chunk, std::memory_order_release);
+    }
+};
+
+}  // end namespace souffle
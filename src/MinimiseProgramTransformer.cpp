@@ -23,8 +23,11 @@
 #include "AstTransforms.h"
 #include "AstTranslationUnit.h"
 #include "AstVisitor.h"
+#include "Util.h"
+#include <algorithm>
 #include <map>
 #include <memory>
+#include <sstream>
 #include <stack>
 #include <string>
 #include <vector>
@@ -251,33 +254,73 @@ bool isValidPermutation(
 }
 
 /**
- * Check whether two clauses are bijectively equivalent.
+ * Check whether the clause is in the fragment covered by the duplicate check:
+ * all body literals are atoms and all arguments are primitive.
  */
-bool areBijectivelyEquivalent(const AstClause* left, const AstClause* right) {
-    // only check bijective equivalence for a subset of the possible clauses
-    auto isValidClause = [&](const AstClause* clause) {
-        // check that all body literals are atoms
-        // i.e. avoid clauses with constraints or negations
-        // TODO (azreika): extend to constraints and negations
-        for (AstLiteral* lit : clause->getBodyLiterals()) {
-            if (dynamic_cast<AstAtom*>(lit) == nullptr) {
-                return false;
-            }
+bool isDeduplicableClause(const AstClause* clause) {
+    // check that all body literals are atoms
+    // i.e. avoid clauses with constraints or negations
+    // TODO (azreika): extend to constraints and negations
+    for (AstLiteral* lit : clause->getBodyLiterals()) {
+        if (dynamic_cast<AstAtom*>(lit) == nullptr) {
+            return false;
         }
+    }
+
+    // check that all arguments are either constants or variables
+    // i.e. only allow primitive arguments
+    bool valid = true;
+    visitDepthFirst(*clause, [&](const AstArgument& arg) {
+        if (dynamic_cast<const AstVariable*>(&arg) == nullptr &&
+                dynamic_cast<const AstConstant*>(&arg) == nullptr) {
+            valid = false;
+        }
+    });
+    return valid;
+}
 
-        // check that all arguments are either constants or variables
-        // i.e. only allow primitive arguments
-        bool valid = true;
-        visitDepthFirst(*clause, [&](const AstArgument& arg) {
-            if (dynamic_cast<const AstVariable*>(&arg) == nullptr &&
-                    dynamic_cast<const AstConstant*>(&arg) == nullptr) {
-                valid = false;
+/**
+ * Computes a canonical signature of a deduplicable clause that is invariant
+ * under body atom permutation and variable renaming: bijectively equivalent
+ * clauses always have equal signatures, so only clauses sharing a signature
+ * need to undergo the expensive pairwise equivalence check.
+ */
+std::string getCanonicalSignature(const AstClause* clause) {
+    auto atomSignature = [](const AstAtom* atom) {
+        std::stringstream sig;
+        sig << atom->getName();
+        for (const AstArgument* arg : atom->getArguments()) {
+            if (const auto* constant = dynamic_cast<const AstConstant*>(arg)) {
+                sig << ",c" << constant->getIndex();
+            } else {
+                sig << ",v";
             }
-        });
-        return valid;
+        }
+        return sig.str();
     };
 
-    if (!isValidClause(left) || !isValidClause(right)) {
+    // the body atom order is irrelevant for equivalence, so sort the per-atom
+    // signatures to make the clause signature permutation invariant
+    std::vector<std::string> bodySignatures;
+    for (AstLiteral* lit : clause->getBodyLiterals()) {
+        bodySignatures.push_back(atomSignature(lit->getAtom()));
+    }
+    std::sort(bodySignatures.begin(), bodySignatures.end());
+
+    std::stringstream signature;
+    signature << atomSignature(clause->getHead()->getAtom());
+    for (const auto& cur : bodySignatures) {
+        signature << ";" << cur;
+    }
+    return signature.str();
+}
+
+/**
+ * Check whether two clauses are bijectively equivalent.
+ */
+bool areBijectivelyEquivalent(const AstClause* left, const AstClause* right) {
+    // only check bijective equivalence for a subset of the possible clauses
+    if (!isDeduplicableClause(left) || !isDeduplicableClause(right)) {
         return false;
     }
 
@@ -324,27 +367,49 @@ bool MinimiseProgramTransformer::transform(AstTranslationUnit& translationUnit)
     // split up each relation's rules into equivalene classes
     // TODO (azreika): consider turning this into an ast analysis instead
     for (AstRelation* rel : program.getRelations()) {
-        std::vector<std::vector<AstClause*>> equivalenceClasses;
-
+        // bucket the deduplicable clauses by their canonical signature;
+        // clauses in different buckets can never be bijectively equivalent,
+        // so the quadratic pairwise check only runs within a bucket and
+        // minimisation stays near-linear for programs with many distinct
+        // rules (clauses outside the deduplicable fragment are always kept)
+        std::map<std::string, std::vector<AstClause*>> buckets;
         for (AstClause* clause : rel->getClauses()) {
-            bool added = false;
+            if (isDeduplicableClause(clause)) {
+                buckets[getCanonicalSignature(clause)].push_back(clause);
+            }
+        }
 
-            for (std::vector<AstClause*>& eqClass : equivalenceClasses) {
-                AstClause* rep = eqClass[0];
+        for (auto& bucket : buckets) {
+            std::vector<std::vector<AstClause*>> equivalenceClasses;
 
-                if (areBijectivelyEquivalent(rep, clause)) {
-                    // clause belongs to an existing equivalence class, so delete it
-                    eqClass.push_back(clause);
-                    clausesToDelete.push_back(clause);
-                    added = true;
-                    break;
-                }
+            // textually identical clauses are always equivalent (repeated
+            // component instantiation produces many of those), so compare
+            // printed forms before entering the permutation search
+            std::map<const AstClause*, std::string> rendering;
+            for (AstClause* clause : bucket.second) {
+                rendering[clause] = toString(*clause);
             }
 
-            if (!added) {
-                // clause does not belong to any existing equivalence class, so keep it
-                std::vector<AstClause*> clauseToAdd = {clause};
-                equivalenceClasses.push_back(clauseToAdd);
+            for (AstClause* clause : bucket.second) {
+                bool added = false;
+
+                for (std::vector<AstClause*>& eqClass : equivalenceClasses) {
+                    AstClause* rep = eqClass[0];
+
+                    if (rendering[rep] == rendering[clause] || areBijectivelyEquivalent(rep, clause)) {
+                        // clause belongs to an existing equivalence class, so delete it
+                        eqClass.push_back(clause);
+                        clausesToDelete.push_back(clause);
+                        added = true;
+                        break;
+                    }
+                }
+
+                if (!added) {
+                    // clause does not belong to any existing equivalence class, so keep it
+                    std::vector<AstClause*> clauseToAdd = {clause};
+                    equivalenceClasses.push_back(clauseToAdd);
+                }
             }
         }
     }
@@ -17,7 +17,9 @@
 #pragma once
 
 #include <cassert>
+#include <cstdint>
 #include <functional>
+#include <map>
 #include <memory>
 #include <set>
 #include <stdexcept>
@@ -466,5 +468,95 @@ inline void recv(T& data, const size_t length, Status& status) {
     }
 }
 }  // namespace
+
+/* hash-partitioned exchange */
+namespace {
+
+template <typename S>
+inline int rankOf(const std::vector<S>& tuple, const std::vector<int>& ranks) {
+    // an FNV-1a hash over the tuple elements
+    uint64_t hash = 14695981039346656037ull;
+    for (const auto element : tuple) {
+        hash ^= (uint64_t)element;
+        hash *= 1099511628211ull;
+    }
+    return ranks.at(hash % ranks.size());
+}
+
+template <typename S, typename T>
+inline void partition(const T& data, const size_t length, const std::vector<int>& ranks,
+        std::map<int, std::vector<S>>& buffers) {
+    for (const auto rank : ranks) {
+        buffers[rank];
+    }
+    std::vector<S> tuple(length);
+    for (const auto& element : data) {
+        for (size_t j = 0; j < length; ++j) {
+            tuple[j] = element[j];
+        }
+        auto& buffer = buffers.at(rankOf(tuple, ranks));
+        buffer.insert(buffer.end(), tuple.begin(), tuple.end());
+    }
+}
+
+template <typename S, typename T>
+inline void insert(const std::vector<S>& buffer, const size_t length, T& data) {
+    auto it = buffer.begin();
+    while (it != buffer.end()) {
+        auto element = std::unique_ptr<S[]>(new S[length]());
+        for (size_t i = 0; i < length; ++i) {
+            element[i] = *it;
+            ++it;
+        }
+        const auto* ptr = element.get();
+        data.insert(ptr);
+    }
+}
+
+// scatters the tuples of the given container over the given group of ranks,
+// sending each member exactly one message holding the share of tuples it owns
+// under hash partitioning; each member collects its share with recv<S>(data,
+// length, source, tag)
+template <typename S, typename T>
+inline void scatter(const T& data, const size_t length, const std::vector<int>& ranks, const int tag) {
+    assert(length > 0);
+    std::map<int, std::vector<S>> buffers;
+    partition(data, length, ranks, buffers);
+    for (const auto& pair : buffers) {
+        send(pair.second, pair.first, tag);
+    }
+}
+
+// exchanges the tuples of the given container among the given group of ranks
+// such that afterwards every tuple resides in the output container of exactly
+// the rank that owns it under hash partitioning; must be invoked collectively
+// by all members of the group, e.g. at an iteration boundary
+template <typename S, typename T, typename U>
+inline void exchange(const T& data, U& out, const size_t length, const std::vector<int>& ranks,
+        const int tag) {
+    assert(length > 0);
+    const auto rank = commRank();
+    std::map<int, std::vector<S>> buffers;
+    partition(data, length, ranks, buffers);
+    // the local share needs no transfer
+    insert(buffers.at(rank), length, out);
+    // exchange the remote shares pairwise; the lower rank of each pair sends
+    // before it receives, so that the synchronous sends cannot deadlock
+    for (const auto peer : ranks) {
+        if (peer == rank) {
+            continue;
+        }
+        if (rank < peer) {
+            send(buffers.at(peer), peer, tag);
+            auto status = probe(peer, tag);
+            recv<S>(out, length, status);
+        } else {
+            auto status = probe(peer, tag);
+            recv<S>(out, length, status);
+            send(buffers.at(peer), peer, tag);
+        }
+    }
+}
+}  // namespace
 }  // end of namespace mpi
 }  // end of namespace souffle
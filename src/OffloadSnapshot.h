@@ -0,0 +1,167 @@
+/*
+ * Souffle - A Datalog Compiler
+ * Copyright (c) 2019, The Souffle Developers. All rights reserved.
+ * Licensed under the Universal Permissive License v 1.0 as shown at:
+ * - https://opensource.org/licenses/UPL
+ * - <souffle root>/licenses/SOUFFLE-UPL.txt
+ */
+
+/************************************************************************
+ *
+ * @file OffloadSnapshot.h
+ *
+ * A transient, flat sorted-array copy of a relation, supporting the
+ * experimental accelerator offload path of synthesised code. Tuples are
+ * stored row-major in a contiguous array so a whole relation can be
+ * mapped to a device with a single transfer; lookups on the device are
+ * binary searches over rows sorted on the bound columns of a scan.
+ *
+ ***********************************************************************/
+
+#pragma once
+
+#include "RamTypes.h"
+
+#include <algorithm>
+#include <cstddef>
+#include <numeric>
+#include <vector>
+
+namespace souffle {
+namespace offload {
+
+/**
+ * @class Snapshot
+ * @brief A row-major flat copy of a relation taken before an offloaded query
+ *
+ * The snapshot is built on the host by iterating the source relation,
+ * optionally sorted on selected columns, and then accessed on the device
+ * through its raw data pointer only; the class itself never crosses the
+ * host/device boundary.
+ */
+class Snapshot {
+public:
+    explicit Snapshot(std::size_t arity) : arity(arity) {}
+
+    /** @brief Pre-size the tuple array for the given number of tuples */
+    void reserve(std::size_t numTuples) {
+        elements.reserve(numTuples * arity);
+    }
+
+    /** @brief Append a single value; tuples are appended column by column */
+    void append(RamDomain value) {
+        elements.push_back(value);
+    }
+
+    /** @brief Number of complete tuples in the snapshot */
+    std::size_t rows() const {
+        return arity == 0 ? 0 : elements.size() / arity;
+    }
+
+    /** @brief Raw row-major tuple data, for mapping to a device */
+    const RamDomain* data() const {
+        return elements.data();
+    }
+
+    /**
+     * @brief Sort the rows lexicographically on the given columns
+     *
+     * Columns not listed keep no particular order; a range query on the
+     * listed columns is a pair of binary searches afterwards.
+     */
+    void sort(const std::vector<std::size_t>& columns) {
+        const std::size_t numRows = rows();
+        std::vector<std::size_t> order(numRows);
+        std::iota(order.begin(), order.end(), 0);
+        std::sort(order.begin(), order.end(), [&](std::size_t lhs, std::size_t rhs) {
+            const RamDomain* lhsRow = &elements[lhs * arity];
+            const RamDomain* rhsRow = &elements[rhs * arity];
+            for (std::size_t column : columns) {
+                if (lhsRow[column] != rhsRow[column]) {
+                    return lhsRow[column] < rhsRow[column];
+                }
+            }
+            return false;
+        });
+        std::vector<RamDomain> sorted;
+        sorted.reserve(elements.size());
+        for (std::size_t row : order) {
+            sorted.insert(sorted.end(), &elements[row * arity], &elements[row * arity + arity]);
+        }
+        elements.swap(sorted);
+    }
+
+private:
+    /** Row-major tuple data */
+    std::vector<RamDomain> elements;
+
+    /** Number of columns per tuple */
+    std::size_t arity;
+};
+
+// the search routines below run inside offloaded regions and must be
+// compiled for the device as well as for the host
+#if defined(SOUFFLE_USE_OFFLOAD) && defined(_OPENMP)
+#pragma omp declare target
+#endif
+
+/**
+ * @brief Index of the first row whose bound columns compare not less
+ * than the given key, on rows sorted by those columns
+ */
+inline std::size_t lowerBound(const RamDomain* data, std::size_t numRows, std::size_t arity,
+        const std::size_t* columns, const RamDomain* key, std::size_t keyLength) {
+    std::size_t low = 0;
+    std::size_t high = numRows;
+    while (low < high) {
+        const std::size_t mid = low + (high - low) / 2;
+        const RamDomain* row = data + mid * arity;
+        bool less = false;
+        for (std::size_t i = 0; i < keyLength; i++) {
+            if (row[columns[i]] != key[i]) {
+                less = row[columns[i]] < key[i];
+                break;
+            }
+        }
+        if (less) {
+            low = mid + 1;
+        } else {
+            high = mid;
+        }
+    }
+    return low;
+}
+
+/**
+ * @brief Index one past the last row whose bound columns compare equal
+ * to the given key, on rows sorted by those columns
+ */
+inline std::size_t upperBound(const RamDomain* data, std::size_t numRows, std::size_t arity,
+        const std::size_t* columns, const RamDomain* key, std::size_t keyLength) {
+    std::size_t low = 0;
+    std::size_t high = numRows;
+    while (low < high) {
+        const std::size_t mid = low + (high - low) / 2;
+        const RamDomain* row = data + mid * arity;
+        bool greater = false;
+        for (std::size_t i = 0; i < keyLength; i++) {
+            if (row[columns[i]] != key[i]) {
+                greater = row[columns[i]] > key[i];
+                break;
+            }
+        }
+        if (greater) {
+            high = mid;
+        } else {
+            low = mid + 1;
+        }
+    }
+    return low;
+}
+
+#if defined(SOUFFLE_USE_OFFLOAD) && defined(_OPENMP)
+#pragma omp end declare target
+#endif
+
+}  // end of namespace offload
+}  // end of namespace souffle
@@ -42,6 +42,13 @@
 #define task_spawn
 #define task_sync
 
+// support for parallel aggregate reduction: per-thread partial results
+// are combined in a critical section; a barrier ensures all partials
+// are in before a single thread resumes the remaining loop nest
+#define AGGREGATE_COMBINE _Pragma("omp critical (aggregate_combine)")
+#define AGGREGATE_BARRIER _Pragma("omp barrier")
+#define AGGREGATE_SINGLE _Pragma("omp single")
+
 // section start / end => corresponding OpenMP pragmas
 // NOTE: disabled since it causes performance losses
 //#define SECTIONS_START _Pragma("omp parallel sections") {
@@ -54,6 +61,14 @@
 #define SECTION_START {
 #define SECTION_END }
 
+// parallel execution of independent strata; unlike the plain sections
+// above these are truly concurrent, since a whole stratum provides
+// enough work to outweigh the sectioning overhead
+#define STRATA_SECTIONS_START _Pragma("omp parallel sections") {
+#define STRATA_SECTIONS_END }
+#define STRATA_SECTION_START _Pragma("omp section") {
+#define STRATA_SECTION_END }
+
 // a macro to create an operation context
 #define CREATE_OP_CONTEXT(NAME, INIT) auto NAME = INIT;
 #define READ_OP_CONTEXT(NAME) NAME
@@ -71,6 +86,11 @@
 #define task_spawn
 #define task_sync
 
+// aggregate reduction collapses to plain sequential statements
+#define AGGREGATE_COMBINE
+#define AGGREGATE_BARRIER
+#define AGGREGATE_SINGLE
+
 // sections are processed sequentially
 #define SECTIONS_START {
 #define SECTIONS_END }
@@ -79,6 +99,12 @@
 #define SECTION_START {
 #define SECTION_END }
 
+// strata sections are processed sequentially
+#define STRATA_SECTIONS_START {
+#define STRATA_SECTIONS_END }
+#define STRATA_SECTION_START {
+#define STRATA_SECTION_END }
+
 // a macro to create an operation context
 #define CREATE_OP_CONTEXT(NAME, INIT) auto NAME = INIT;
 #define READ_OP_CONTEXT(NAME) NAME
@@ -98,6 +124,164 @@
 #define MAX_THREADS (1)
 #endif
 
+/**
+ * The factor by which parallel iteration spaces are over-partitioned.
+ *
+ * The dynamic schedule utilized by pfor turns the list of partitions into
+ * a shared work queue: whenever a thread finishes its current chunk it
+ * grabs the next unprocessed one. By handing out considerably more chunks
+ * than there are threads, an oversized partition no longer serializes the
+ * entire loop -- idle threads simply steal the remaining chunks.
+ */
+#define WORK_STEALING_FACTOR 16
+
+// the number of chunks an iteration space should be split into such that
+// the dynamic loop schedule can re-balance skewed workloads; a non-positive
+// thread count is interpreted as "all available threads"
+#define NUM_WORK_CHUNKS(threads) ((((threads) > 0 ? (threads) : MAX_THREADS)) * WORK_STEALING_FACTOR)
+
+#if defined(IS_PARALLEL) && defined(__linux__)
+
+#include <sched.h>
+#include <unistd.h>
+
+#include <cstdlib>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+namespace souffle {
+
+/**
+ * The NUMA topology of the host as exposed through the Linux sysfs
+ * interface -- a list of memory nodes, each holding the ids of its CPUs.
+ * On machines without NUMA information a single node covering all online
+ * CPUs is assumed.
+ */
+class NumaTopology {
+    // the CPU ids associated to each node
+    std::vector<std::vector<int>> nodes;
+
+    NumaTopology() {
+        for (int node = 0;; ++node) {
+            std::ifstream in("/sys/devices/system/node/node" + std::to_string(node) + "/cpulist");
+            if (!in) break;
+            std::string list;
+            std::getline(in, list);
+            auto cpus = parseCpuList(list);
+            if (!cpus.empty()) {
+                nodes.push_back(std::move(cpus));
+            }
+        }
+        if (nodes.empty()) {
+            // no NUMA information available => treat all CPUs as one node
+            std::vector<int> all;
+            for (int cpu = 0; cpu < sysconf(_SC_NPROCESSORS_ONLN); ++cpu) {
+                all.push_back(cpu);
+            }
+            nodes.push_back(std::move(all));
+        }
+    }
+
+public:
+    /** obtains the topology of the host this process is running on */
+    static const NumaTopology& get() {
+        static const NumaTopology topology;
+        return topology;
+    }
+
+    /** obtains the number of memory nodes */
+    std::size_t getNumNodes() const {
+        return nodes.size();
+    }
+
+    /** obtains the ids of the CPUs located on the given node */
+    const std::vector<int>& getCpus(std::size_t node) const {
+        return nodes[node];
+    }
+
+private:
+    // parses a sysfs CPU list of the shape "0-15,32-47" into the
+    // covered CPU ids
+    static std::vector<int> parseCpuList(const std::string& list) {
+        std::vector<int> res;
+        std::stringstream in(list);
+        while (in.good()) {
+            int first = -1;
+            in >> first;
+            if (first < 0) break;
+            int last = first;
+            if (in.peek() == '-') {
+                in.ignore();
+                in >> last;
+            }
+            for (int cpu = first; cpu <= last; ++cpu) {
+                res.push_back(cpu);
+            }
+            if (in.peek() != ',') break;
+            in.ignore();
+        }
+        return res;
+    }
+};
+
+/**
+ * Pins the OpenMP worker threads to concrete CPUs, filling the NUMA nodes
+ * of the host one after another. Combined with the first-touch placement
+ * policy of the OS this keeps the data a thread builds on the memory node
+ * the thread stays on, instead of scattering pages as threads migrate
+ * between sockets.
+ *
+ * Pinning is opt-in through the SOUFFLE_PIN_THREADS environment variable;
+ * an explicitly configured OpenMP affinity takes precedence.
+ */
+inline void pinThreads(int numThreads) {
+    // only pin when requested
+    const char* env = std::getenv("SOUFFLE_PIN_THREADS");
+    if (env == nullptr || *env == '\0' || *env == '0') return;
+
+    // an explicitly configured OpenMP / GOMP affinity takes precedence
+    if (std::getenv("OMP_PROC_BIND") != nullptr || std::getenv("GOMP_CPU_AFFINITY") != nullptr ||
+            std::getenv("KMP_AFFINITY") != nullptr) {
+        return;
+    }
+
+    // flatten the topology, node by node
+    const auto& topology = NumaTopology::get();
+    std::vector<int> cpus;
+    for (std::size_t node = 0; node < topology.getNumNodes(); ++node) {
+        const auto& nodeCpus = topology.getCpus(node);
+        cpus.insert(cpus.end(), nodeCpus.begin(), nodeCpus.end());
+    }
+    if (cpus.empty()) return;
+
+    if (numThreads <= 0) {
+        numThreads = MAX_THREADS;
+    }
+
+#pragma omp parallel num_threads(numThreads)
+    {
+        cpu_set_t set;
+        CPU_ZERO(&set);
+        CPU_SET(cpus[omp_get_thread_num() % cpus.size()], &set);
+        sched_setaffinity(0, sizeof(set), &set);
+    }
+}
+
+}  // end of namespace souffle
+
+#else
+
+namespace souffle {
+
+// thread pinning is only supported for parallel execution on Linux
+inline void pinThreads(int /* numThreads */) {}
+
+}  // end of namespace souffle
+
+#endif
+
 #ifdef IS_PARALLEL
 
 #include <mutex>
@@ -379,18 +563,26 @@ public:
     void start_write() {
         detail::Waiter wait;
 
-        // set last bit => make it odd
-        auto v = version.fetch_or(0x1, std::memory_order_acquire);
+        // get a snapshot of the lease version
+        auto v = version.load(std::memory_order_relaxed);
+
+        while (true) {
+            // spin on plain reads while there is a write in progress --
+            // thereby avoiding the cache-line invalidations a failing
+            // read-modify-write operation would cause on other cores
+            while ((v & 0x1) == 1) {
+                // wait for a moment
+                wait();
+                // get an updated version
+                v = version.load(std::memory_order_relaxed);
+            }
 
-        // check for concurrent writes
-        while ((v & 0x1) == 1) {
-            // wait for a moment
-            wait();
-            // get an updated version
-            v = version.fetch_or(0x1, std::memory_order_acquire);
+            // set last bit => make it odd
+            if (version.compare_exchange_weak(
+                        v, v | 0x1, std::memory_order_acquire, std::memory_order_relaxed)) {
+                return;  // done
+            }
         }
-
-        // done
     }
 
     /**
@@ -400,8 +592,11 @@ public:
      * @return true if write permission has been granted, false otherwise.
      */
     bool try_start_write() {
-        auto v = version.fetch_or(0x1, std::memory_order_acquire);
-        return !(v & 0x1);
+        // give up without touching the cache line exclusively if there
+        // is a write in progress
+        auto v = version.load(std::memory_order_relaxed);
+        if (v & 0x1) return false;
+        return version.compare_exchange_strong(v, v | 0x1, std::memory_order_acquire, std::memory_order_relaxed);
     }
 
     /**
@@ -413,19 +608,14 @@ public:
      *      be granted, false otherwise.
      */
     bool try_upgrade_to_write(const Lease& lease) {
-        auto v = version.fetch_or(0x1, std::memory_order_acquire);
-
-        // check whether write privileges have been gained
-        if (v & 0x1) return false;  // there is another writer already
-
-        // check whether there was no write since the gain of the read lock
-        if (lease.version == v) return true;
+        auto v = version.load(std::memory_order_relaxed);
 
-        // if there was, undo write update
-        abort_write();
+        // check whether there was a write since the gain of the read lock
+        // (or whether one is in progress) before claiming the cache line
+        if (v != lease.version) return false;
 
-        // operation failed
-        return false;
+        // attempt to set last bit => make it odd
+        return version.compare_exchange_strong(v, v | 0x1, std::memory_order_acquire, std::memory_order_relaxed);
     }
 
     /**
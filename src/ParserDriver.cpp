@@ -31,12 +31,88 @@
 #include "Util.h"
 #include <memory>
 #include <utility>
+#include <vector>
+
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
 
 using YY_BUFFER_STATE = struct yy_buffer_state*;
 extern YY_BUFFER_STATE yy_scan_string(const char*, yyscan_t scanner);
+extern YY_BUFFER_STATE yy_scan_buffer(char*, size_t, yyscan_t scanner);
 extern int yylex_destroy(yyscan_t scanner);
 extern int yylex_init_extra(scanner_data* data, yyscan_t* scanner);
-extern void yyset_in(FILE* in_str, yyscan_t scanner);
+
+namespace {
+
+/**
+ * Whole-input buffer for the scanner. Regular files are memory-mapped
+ * copy-on-write; other streams - notably the pre-processor pipe - are
+ * drained in large chunks. Either way the scanner tokenizes one
+ * contiguous buffer through yy_scan_buffer, ending in the two
+ * terminator characters flex requires, instead of refilling a small
+ * stdio buffer throughout the parse.
+ */
+class ScannerBuffer {
+public:
+    ScannerBuffer(FILE* in) {
+        struct stat status;
+        int fd = fileno(in);
+        auto pageSize = static_cast<size_t>(sysconf(_SC_PAGESIZE));
+        if (fd >= 0 && fstat(fd, &status) == 0 && S_ISREG(status.st_mode) && status.st_size > 0) {
+            // the zero-filled tail of the last page has to offer room for
+            // the two terminators
+            size_t tail = static_cast<size_t>(status.st_size) % pageSize;
+            if (tail != 0 && tail + 2 <= pageSize) {
+                void* map = mmap(nullptr, static_cast<size_t>(status.st_size) + 2,
+                        PROT_READ | PROT_WRITE, MAP_PRIVATE, fd, 0);
+                if (map != MAP_FAILED) {
+                    base = static_cast<char*>(map);
+                    size = static_cast<size_t>(status.st_size) + 2;
+                    mapped = true;
+                    return;
+                }
+            }
+        }
+        // fall back to draining the stream into one buffer
+        char chunk[1 << 16];
+        size_t bytes;
+        while ((bytes = fread(chunk, 1, sizeof(chunk), in)) > 0) {
+            storage.insert(storage.end(), chunk, chunk + bytes);
+        }
+        storage.push_back('\0');
+        storage.push_back('\0');
+        base = storage.data();
+        size = storage.size();
+    }
+
+    ScannerBuffer(const ScannerBuffer&) = delete;
+    ScannerBuffer& operator=(const ScannerBuffer&) = delete;
+
+    ~ScannerBuffer() {
+        if (mapped) {
+            munmap(base, size);
+        }
+    }
+
+    /** The start of the buffer; writable, as the scanner terminates tokens in place. */
+    char* getBase() const {
+        return base;
+    }
+
+    /** The size of the buffer, including the two terminators. */
+    size_t getSize() const {
+        return size;
+    }
+
+private:
+    std::vector<char> storage;
+    char* base = nullptr;
+    size_t size = 0;
+    bool mapped = false;
+};
+
+}  // namespace
 
 namespace souffle {
 
@@ -52,7 +128,8 @@ std::unique_ptr<AstTranslationUnit> ParserDriver::parse(const std::string& filen
     scanner_data data;
     data.yyfilename = filename.c_str();
     yylex_init_extra(&data, &scanner);
-    yyset_in(in, scanner);
+    ScannerBuffer buffer(in);
+    yy_scan_buffer(buffer.getBase(), buffer.getSize(), scanner);
 
     yy::parser parser(*this, scanner);
     parser.set_debug_level(trace_parsing);
@@ -3,13 +3,71 @@
 #include "ParallelUtils.h"
 #include <array>
 #include <atomic>
+#include <cassert>
 #include <cstring>
 #include <iostream>
 #include <list>
+#include <new>
+
+#include <sys/mman.h>
 
 using std::size_t;
 namespace souffle {
 
+namespace piggylist_detail {
+
+/** block sizes from this number of bytes upwards are backed by whole huge pages */
+constexpr size_t HUGE_PAGE_THRESHOLD = 1ul << 21;
+
+/**
+ * Allocates a block of the given number of elements. Multi-megabyte blocks
+ * are mapped directly and advised onto transparent huge pages, sparing the
+ * TLB when lists grow to gigabytes; smaller blocks come from the heap.
+ * Whether the block was mapped is reported through the out-parameter and
+ * must be passed back to freeBlock.
+ */
+template <class T>
+T* allocateBlock(size_t numElements, bool& mapped) {
+    const size_t bytes = numElements * sizeof(T);
+    if (bytes >= HUGE_PAGE_THRESHOLD) {
+        void* mem = mmap(nullptr, bytes, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+        if (mem != MAP_FAILED) {
+#ifdef MADV_HUGEPAGE
+            madvise(mem, bytes, MADV_HUGEPAGE);
+#endif
+            mapped = true;
+            T* block = static_cast<T*>(mem);
+            // default-initialise the elements, as new T[] would
+            for (size_t i = 0; i < numElements; ++i) {
+                new (block + i) T;
+            }
+            return block;
+        }
+        // on failure fall through to the heap -- huge pages are an
+        // optimisation, not a requirement
+    }
+    mapped = false;
+    return new T[numElements];
+}
+
+/** Releases a block obtained from allocateBlock; a nullptr is a no-op */
+template <class T>
+void freeBlock(T* block, size_t numElements, bool mapped) {
+    if (block == nullptr) {
+        return;
+    }
+    if (mapped) {
+        for (size_t i = 0; i < numElements; ++i) {
+            block[i].~T();
+        }
+        munmap(block, numElements * sizeof(T));
+    } else {
+        delete[] block;
+    }
+}
+
+}  // namespace piggylist_detail
+
 /**
  * A PiggyList that allows insertAt functionality.
  * This means we can't append, as we don't know the next available element.
@@ -34,7 +92,10 @@ public:
                 const size_t blockSize = INITIALBLOCKSIZE << i;
 
                 // allocate that in the new container
-                this->blockLookupTable[i].store(new T[blockSize]);
+                bool mapped = false;
+                this->blockLookupTable[i].store(
+                        piggylist_detail::allocateBlock<T>(blockSize, mapped));
+                this->blockIsMapped[i] = mapped;
 
                 // then copy the stuff over
                 std::memcpy(this->blockLookupTable[i].load(), other.blockLookupTable[i].load(),
@@ -74,13 +135,20 @@ public:
         // series
         size_t blockNum = (63 - __builtin_clzll(index + INITIALBLOCKSIZE)) - BLOCKBITS;
 
-        // allocate the block if not allocated
+        // allocate the block if not allocated; racing threads compete via
+        // compare-and-swap on the slot instead of serialising on a lock,
+        // so concurrent inserts into existing blocks never wait
         if (blockLookupTable[blockNum].load() == nullptr) {
-            slock.lock();
-            if (blockLookupTable[blockNum].load() == nullptr) {
-                blockLookupTable[blockNum].store(new T[INITIALBLOCKSIZE << blockNum]);
+            const size_t blockSize = INITIALBLOCKSIZE << blockNum;
+            bool mapped = false;
+            T* candidate = piggylist_detail::allocateBlock<T>(blockSize, mapped);
+            T* expected = nullptr;
+            if (blockLookupTable[blockNum].compare_exchange_strong(expected, candidate)) {
+                blockIsMapped[blockNum] = mapped;
+            } else {
+                // another thread published the block first
+                piggylist_detail::freeBlock(candidate, blockSize, mapped);
             }
-            slock.unlock();
         }
 
         this->get(index) = value;
@@ -93,6 +161,18 @@ public:
         freeList();
         numElements.store(0);
     }
+
+    /** @return the number of bytes held by this list, including unused block capacity */
+    size_t getMemoryUsage() const {
+        size_t bytes = sizeof(*this);
+        for (size_t i = 0; i < maxContainers; ++i) {
+            if (blockLookupTable[i].load() != nullptr) {
+                bytes += (INITIALBLOCKSIZE << i) * sizeof(T);
+            }
+        }
+        return bytes;
+    }
+
     const size_t BLOCKBITS = 16ul;
     const size_t INITIALBLOCKSIZE = (1ul << BLOCKBITS);
 
@@ -103,21 +183,21 @@ public:
     static constexpr size_t maxContainers = 64;
     std::array<std::atomic<T*>, maxContainers> blockLookupTable = {};
 
-    // for parallel node insertions
-    mutable SpinLock slock;
+    // whether a block is backed by a huge-page mapping rather than the heap
+    std::array<bool, maxContainers> blockIsMapped = {};
 
     /**
      * Free the arrays allocated within the linked list nodes
      */
     void freeList() {
-        slock.lock();
         // delete all - deleting a nullptr is a no-op
         for (size_t i = 0; i < maxContainers; ++i) {
-            delete[] blockLookupTable[i].load();
+            piggylist_detail::freeBlock(
+                    blockLookupTable[i].load(), INITIALBLOCKSIZE << i, blockIsMapped[i]);
             // reset the container within to be empty.
             blockLookupTable[i].store(nullptr);
+            blockIsMapped[i] = false;
         }
-        slock.unlock();
     }
 };
 
@@ -134,15 +214,16 @@ public:
         container_size.store(other.container_size.load());
         m_size.store(other.m_size.load());
         // copy each chunk from other into this
-        // the size of the next container to allocate
-        size_t cSize = BLOCKSIZE;
-        for (size_t i = 0; i < other.num_containers; ++i) {
-            this->blockLookupTable[i] = new T[cSize];
-            std::memcpy(this->blockLookupTable[i], other.blockLookupTable[i], cSize * sizeof(T));
-            cSize <<= 1;
+        for (size_t i = 0; i < max_conts; ++i) {
+            if (other.blockLookupTable[i].load() != nullptr) {
+                const size_t cSize = BLOCKSIZE << i;
+                bool mapped = false;
+                this->blockLookupTable[i].store(piggylist_detail::allocateBlock<T>(cSize, mapped));
+                this->blockIsMapped[i] = mapped;
+                std::memcpy(this->blockLookupTable[i].load(), other.blockLookupTable[i].load(),
+                        cSize * sizeof(T));
+            }
         }
-        // if this isn't the case, uhh
-        assert((cSize >> 1) == container_size.load());
     }
 
     /** move constructor */
@@ -165,47 +246,24 @@ public:
     };
 
     inline T* getBlock(size_t blocknum) const {
-        return this->blockLookupTable[blocknum];
+        return this->blockLookupTable[blocknum].load();
+    }
+
+    /** @return the number of bytes held by this list, including unused block capacity */
+    size_t getMemoryUsage() const {
+        return sizeof(*this) + container_size.load() * sizeof(T);
     }
 
     size_t append(T element) {
         size_t new_index = m_size.fetch_add(1, std::memory_order_acquire);
-
-        // will this not fit?
-        if (container_size < new_index + 1) {
-            sl.lock();
-            // check and add as many containers as required
-            while (container_size < new_index + 1) {
-                blockLookupTable[num_containers] = new T[allocsize];
-                num_containers += 1;
-                container_size += allocsize;
-                // double the number elements that will be allocated next time
-                allocsize <<= 1;
-            }
-            sl.unlock();
-        }
-
+        ensureBlock(new_index);
         this->get(new_index) = element;
         return new_index;
     }
 
     size_t createNode() {
         size_t new_index = m_size.fetch_add(1, std::memory_order_acquire);
-
-        // will this not fit?
-        if (container_size < new_index + 1) {
-            sl.lock();
-            // check and add as many containers as required
-            while (container_size < new_index + 1) {
-                blockLookupTable[num_containers] = new T[allocsize];
-                num_containers += 1;
-                container_size += allocsize;
-                // double the number elements that will be allocated next time
-                allocsize <<= 1;
-            }
-            sl.unlock();
-        }
-
+        ensureBlock(new_index);
         return new_index;
     }
 
@@ -229,8 +287,6 @@ public:
         freeList();
         m_size = 0;
         num_containers = 0;
-
-        allocsize = BLOCKSIZE;
         container_size = 0;
     }
 
@@ -283,29 +339,51 @@ public:
     const size_t BLOCKBITS = 16ul;
     const size_t BLOCKSIZE = (1ul << BLOCKBITS);
 
-    // number of inserted
+    // number of blocks currently allocated
     std::atomic<size_t> num_containers;
-    size_t allocsize = BLOCKSIZE;
     std::atomic<size_t> container_size;
     std::atomic<size_t> m_size;
 
     // > 2^64 elements can be stored (default initialise to nullptrs)
     static constexpr size_t max_conts = 64;
-    std::array<T*, max_conts> blockLookupTable = {};
+    std::array<std::atomic<T*>, max_conts> blockLookupTable = {};
 
-    // for parallel node insertions
-    mutable SpinLock sl;
+    // whether a block is backed by a huge-page mapping rather than the heap
+    std::array<bool, max_conts> blockIsMapped = {};
+
+    /**
+     * Ensure the block containing the given index exists. Threads race the
+     * allocation via compare-and-swap on the block slot -- the block number
+     * of an index is deterministic, so no lock is needed and inserts into
+     * already existing blocks proceed without waiting.
+     */
+    void ensureBlock(size_t index) {
+        size_t blockNum = (63 - __builtin_clzll(index + BLOCKSIZE)) - BLOCKBITS;
+        if (blockLookupTable[blockNum].load() == nullptr) {
+            const size_t blockSize = BLOCKSIZE << blockNum;
+            bool mapped = false;
+            T* candidate = piggylist_detail::allocateBlock<T>(blockSize, mapped);
+            T* expected = nullptr;
+            if (blockLookupTable[blockNum].compare_exchange_strong(expected, candidate)) {
+                blockIsMapped[blockNum] = mapped;
+                num_containers += 1;
+                container_size += blockSize;
+            } else {
+                // another thread published the block first
+                piggylist_detail::freeBlock(candidate, blockSize, mapped);
+            }
+        }
+    }
 
     /**
      * Free the arrays allocated within the linked list nodes
      */
     void freeList() {
-        sl.lock();
-        // we don't know which ones are taken up!
-        for (size_t i = 0; i < num_containers; ++i) {
-            delete[] blockLookupTable[i];
+        for (size_t i = 0; i < max_conts; ++i) {
+            piggylist_detail::freeBlock(blockLookupTable[i].load(), BLOCKSIZE << i, blockIsMapped[i]);
+            blockLookupTable[i].store(nullptr);
+            blockIsMapped[i] = false;
         }
-        sl.unlock();
     }
 };
 
@@ -18,11 +18,14 @@
 
 #include "EventProcessor.h"
 #include "ProfileDatabase.h"
+#include "SignalHandler.h"
 #include "Util.h"
+#include <array>
 #include <atomic>
 #include <cassert>
 #include <chrono>
 #include <ctime>
+#include <fstream>
 #include <functional>
 #include <iomanip>
 #include <iostream>
@@ -36,8 +39,302 @@
 #include <sys/resource.h>
 #include <sys/time.h>
 
+#ifdef __linux__
+#include <linux/perf_event.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
 namespace souffle {
 
+/**
+ * A set of hardware performance counters sampled around logged RAM
+ * statements.
+ *
+ * The counters -- CPU cycles, last-level cache misses and branch
+ * mispredictions -- are opened once per process via perf_event and
+ * free-run for the lifetime of the program; events record the deltas
+ * between two samples. The counters are inherited by worker threads
+ * spawned after they are opened, so parallel sections are accounted
+ * for as well. On platforms without perf_event, or when access to the
+ * performance monitoring unit is denied, sampling is silently disabled
+ * and no counter events are emitted.
+ */
+class PerfCounters {
+public:
+    /** A single sample of all monitored counters */
+    struct Sample {
+        uint64_t cycles = 0;
+        uint64_t cacheMisses = 0;
+        uint64_t branchMisses = 0;
+
+        Sample operator-(const Sample& other) const {
+            Sample result;
+            result.cycles = cycles - other.cycles;
+            result.cacheMisses = cacheMisses - other.cacheMisses;
+            result.branchMisses = branchMisses - other.branchMisses;
+            return result;
+        }
+    };
+
+    /** get instance */
+    static PerfCounters& instance() {
+        static PerfCounters singleton;
+        return singleton;
+    }
+
+    /** check whether hardware counters could be opened */
+    bool isAvailable() const {
+        return available;
+    }
+
+    /** take a sample of the current counter values */
+    Sample sample() const {
+        Sample result;
+#ifdef __linux__
+        if (available) {
+            readCounter(fds[0], result.cycles);
+            readCounter(fds[1], result.cacheMisses);
+            readCounter(fds[2], result.branchMisses);
+        }
+#endif
+        return result;
+    }
+
+private:
+    PerfCounters() {
+#ifdef __linux__
+        fds[0] = openCounter(PERF_COUNT_HW_CPU_CYCLES);
+        fds[1] = openCounter(PERF_COUNT_HW_CACHE_MISSES);
+        fds[2] = openCounter(PERF_COUNT_HW_BRANCH_MISSES);
+        available = fds[0] != -1 && fds[1] != -1 && fds[2] != -1;
+        if (!available) {
+            for (int& fd : fds) {
+                if (fd != -1) {
+                    close(fd);
+                    fd = -1;
+                }
+            }
+        }
+#endif
+    }
+
+    ~PerfCounters() {
+#ifdef __linux__
+        for (int fd : fds) {
+            if (fd != -1) {
+                close(fd);
+            }
+        }
+#endif
+    }
+
+#ifdef __linux__
+    /** open a single free-running, thread-inherited hardware counter */
+    static int openCounter(uint64_t config) {
+        struct perf_event_attr attr {};
+        attr.type = PERF_TYPE_HARDWARE;
+        attr.size = sizeof(attr);
+        attr.config = config;
+        attr.inherit = 1;
+        attr.exclude_kernel = 1;
+        attr.exclude_hv = 1;
+        return syscall(__NR_perf_event_open, &attr, 0, -1, -1, 0);
+    }
+
+    /** read the current value of the given counter */
+    static void readCounter(int fd, uint64_t& value) {
+        if (read(fd, &value, sizeof(value)) != sizeof(value)) {
+            value = 0;
+        }
+    }
+
+    /** file descriptors of the monitored counters */
+    int fds[3] = {-1, -1, -1};
+#endif
+
+    /** whether all counters could be opened */
+    bool available = false;
+};
+
+namespace profile {
+
+/**
+ * A streaming binary profile log.
+ *
+ * Event records are appended to the log file as they occur instead of
+ * being accumulated in the profile database, keeping the memory overhead
+ * of profiling bounded and avoiding the serialization stall at shutdown.
+ * Each record consists of a fixed-size header -- the event kind, the
+ * lengths of up to two trailing strings and six 64-bit payload values --
+ * followed by the string data of the event.
+ */
+class ProfileBinaryLog {
+public:
+    /** The kinds of streamed event records */
+    enum Kind : uint8_t {
+        TIMING = 1,
+        QUANTITY = 2,
+        TIMEPOINT = 3,
+        UTILISATION = 4,
+        TEXT = 5,
+        CONFIG = 6,
+        COUNTER = 7,
+    };
+
+    /** magic number of binary profile logs ("SPRF") */
+    static constexpr uint32_t MAGIC = 0x46525053;
+
+    /** version of the binary log format */
+    static constexpr uint32_t VERSION = 1;
+
+    /** Open the given file for streamed writing, truncating previous content */
+    void open(const std::string& filename) {
+        std::lock_guard<std::mutex> guard(lock);
+        out.open(filename, std::ios::binary | std::ios::trunc);
+        if (!out.is_open()) {
+            std::cerr << "Cannot open profile log file <" + filename + ">";
+            return;
+        }
+        write(MAGIC);
+        write(VERSION);
+    }
+
+    /** Append a single event record to the log */
+    void append(Kind kind, const std::string& text, const std::array<uint64_t, 6>& args = {},
+            const std::string& aux = "") {
+        std::lock_guard<std::mutex> guard(lock);
+        if (!out.is_open()) {
+            return;
+        }
+        write(static_cast<uint8_t>(kind));
+        write(static_cast<uint32_t>(text.size()));
+        write(static_cast<uint32_t>(aux.size()));
+        for (const uint64_t& arg : args) {
+            write(arg);
+        }
+        out.write(text.data(), text.size());
+        out.write(aux.data(), aux.size());
+    }
+
+    /** Finish writing the log */
+    void close() {
+        std::lock_guard<std::mutex> guard(lock);
+        if (out.is_open()) {
+            out.close();
+        }
+    }
+
+    /** Check whether the given file is a binary profile log */
+    static bool isBinaryLog(const std::string& filename) {
+        std::ifstream in(filename, std::ios::binary);
+        uint32_t magic = 0;
+        in.read(reinterpret_cast<char*>(&magic), sizeof(magic));
+        return in.good() && magic == MAGIC;
+    }
+
+    /** Deliver a single event record into a profile database */
+    static void dispatch(ProfileDatabase& database, uint8_t kind, const std::string& text,
+            const std::string& aux, const std::array<uint64_t, 6>& args) {
+        auto& processor = EventProcessorSingleton::instance();
+        switch (kind) {
+            case TIMING:
+                processor.process(database, text.c_str(), microseconds(args[0]), microseconds(args[1]),
+                        static_cast<size_t>(args[2]), static_cast<size_t>(args[3]),
+                        static_cast<size_t>(args[4]), static_cast<size_t>(args[5]));
+                break;
+            case QUANTITY:
+                processor.process(
+                        database, text.c_str(), static_cast<size_t>(args[0]), static_cast<int>(args[1]));
+                break;
+            case TIMEPOINT:
+                processor.process(database, text.c_str(), microseconds(args[0]));
+                break;
+            case UTILISATION:
+                processor.process(database, text.c_str(), microseconds(args[0]), args[1], args[2],
+                        static_cast<size_t>(args[3]));
+                break;
+            case TEXT:
+                processor.process(database, text.c_str(), aux.c_str());
+                break;
+            case CONFIG:
+                processor.process(database, "@config", text.c_str(), aux.c_str());
+                break;
+            case COUNTER:
+                processor.process(database, text.c_str(), static_cast<size_t>(args[0]),
+                        static_cast<size_t>(args[1]), static_cast<size_t>(args[2]),
+                        static_cast<size_t>(args[3]));
+                break;
+            default:
+                throw std::runtime_error("Unknown record in binary profile log.");
+        }
+    }
+
+    /** Replay all event records of the given log file into a profile database */
+    static void replay(const std::string& filename, ProfileDatabase& database) {
+        std::ifstream in(filename, std::ios::binary);
+        if (!in.is_open()) {
+            throw std::runtime_error("Log file could not be opened.");
+        }
+        uint32_t magic = 0;
+        uint32_t version = 0;
+        read(in, magic);
+        read(in, version);
+        if (!in.good() || magic != MAGIC) {
+            throw std::runtime_error("Log file is not a binary profile log.");
+        }
+        if (version != VERSION) {
+            throw std::runtime_error("Unsupported binary profile log version.");
+        }
+
+        while (true) {
+            uint8_t kind = 0;
+            read(in, kind);
+            if (!in.good()) {
+                break;
+            }
+            uint32_t textLength = 0;
+            uint32_t auxLength = 0;
+            std::array<uint64_t, 6> args{};
+            read(in, textLength);
+            read(in, auxLength);
+            for (uint64_t& arg : args) {
+                read(in, arg);
+            }
+            std::string text(textLength, '\0');
+            in.read(&text[0], textLength);
+            std::string aux(auxLength, '\0');
+            in.read(&aux[0], auxLength);
+            if (!in.good()) {
+                // ignore the truncated tail of an aborted run
+                break;
+            }
+            dispatch(database, kind, text, aux, args);
+        }
+    }
+
+private:
+    /** Write a single value in its binary representation */
+    template <typename T>
+    void write(const T& value) {
+        out.write(reinterpret_cast<const char*>(&value), sizeof(T));
+    }
+
+    /** Read a single value in its binary representation */
+    template <typename T>
+    static void read(std::istream& in, T& value) {
+        in.read(reinterpret_cast<char*>(&value), sizeof(T));
+    }
+
+    /** The output stream of the log */
+    std::ofstream out;
+
+    /** a lock to sequentialize the emission of records */
+    std::mutex lock;
+};
+
+}  // namespace profile
+
 /**
  * Profile Event Singleton
  */
@@ -46,11 +343,64 @@ class ProfileEventSingleton {
     profile::ProfileDatabase database;
     std::string filename{""};
 
+    /** streamed binary log, used instead of the database when enabled */
+    profile::ProfileBinaryLog log;
+    std::atomic<bool> streaming{false};
+
+    /**
+     * Long fixpoints produce one record per rule and iteration; recording
+     * all of them makes the profile log grow linearly with the iteration
+     * count. Iteration-scoped events are therefore recorded at adaptive
+     * granularity: the first FULL_DETAIL_ITERATIONS iterations are kept
+     * individually, beyond that SAMPLES_PER_OCTAVE iterations per doubling
+     * of the iteration count. Timings and hardware counters of skipped
+     * iterations are folded into the next emitted sample, so sums over all
+     * recorded iterations remain exact and the convergence curve keeps its
+     * shape at logarithmic log size.
+     */
+    enum { FULL_DETAIL_ITERATIONS = 1024, SAMPLES_PER_OCTAVE = 512 };
+
+    /** the aggregate of iterations absorbed since the last emitted sample */
+    struct IterationBucket {
+        uint64_t duration = 0;
+        uint64_t quantity = 0;
+        uint64_t cycles = 0;
+        uint64_t cacheMisses = 0;
+        uint64_t branchMisses = 0;
+    };
+
+    /** pending aggregates, keyed by event signature */
+    std::unordered_map<std::string, IterationBucket> iterationBuckets;
+
+    /** a lock guarding the pending aggregates */
+    std::mutex bucketLock;
+
+    /** determines whether the given iteration is recorded individually */
+    static bool isSampledIteration(size_t iteration) {
+        if (iteration < FULL_DETAIL_ITERATIONS) {
+            return true;
+        }
+        // stride doubles with every octave, keeping SAMPLES_PER_OCTAVE
+        // (= 2^9) samples per doubling of the iteration count
+        const size_t octave = 63 - __builtin_clzll(iteration);
+        const size_t stride = size_t(1) << (octave - 9);
+        return iteration % stride == 0;
+    }
+
+    /** determines whether the given event signature is emitted once per iteration */
+    static bool isIterationScoped(const std::string& txt) {
+        const std::string keyword = txt.substr(0, txt.find(';'));
+        return keyword == "@t-recursive-rule" || keyword == "@t-recursive-relation" ||
+               keyword == "@n-recursive-rule" || keyword == "@n-recursive-relation" ||
+               keyword == "@c-recursive-relation";
+    }
+
     ProfileEventSingleton() = default;
 
 public:
     ~ProfileEventSingleton() {
         stopTimer();
+        stopSampler();
         ProfileEventSingleton::instance().dump();
     }
 
@@ -62,7 +412,7 @@ public:
 
     /** create config record */
     void makeConfigRecord(const std::string& key, const std::string& value) {
-        profile::EventProcessorSingleton::instance().process(database, "@config", key.c_str(), value.c_str());
+        enqueue(profile::ProfileBinaryLog::CONFIG, key, {}, value);
     }
 
     /** create stratum record */
@@ -70,13 +420,13 @@ public:
             const std::string& key, const std::string& value) {
         std::stringstream ss;
         ss << "@text;stratum;" << index << ';' << type << ';' << relName << ';' << key;
-        profile::EventProcessorSingleton::instance().process(database, ss.str().c_str(), value.c_str());
+        enqueue(profile::ProfileBinaryLog::TEXT, ss.str(), {}, value);
     }
 
     /** create time event */
     void makeTimeEvent(const std::string& txt) {
-        profile::EventProcessorSingleton::instance().process(
-                database, txt.c_str(), std::chrono::duration_cast<microseconds>(now().time_since_epoch()));
+        microseconds time = std::chrono::duration_cast<microseconds>(now().time_since_epoch());
+        enqueue(profile::ProfileBinaryLog::TIMEPOINT, txt, {{static_cast<uint64_t>(time.count())}});
     }
 
     /** create an event for recording start and end times */
@@ -84,13 +434,67 @@ public:
             size_t endMaxRSS, size_t size, size_t iteration) {
         microseconds start_ms = std::chrono::duration_cast<microseconds>(start.time_since_epoch());
         microseconds end_ms = std::chrono::duration_cast<microseconds>(end.time_since_epoch());
-        profile::EventProcessorSingleton::instance().process(
-                database, txt.c_str(), start_ms, end_ms, startMaxRSS, endMaxRSS, size, iteration);
+        uint64_t startUs = static_cast<uint64_t>(start_ms.count());
+        uint64_t endUs = static_cast<uint64_t>(end_ms.count());
+        uint64_t tuples = size;
+        if (isIterationScoped(txt)) {
+            std::lock_guard<std::mutex> guard(bucketLock);
+            auto& bucket = iterationBuckets[txt];
+            bucket.duration += endUs - startUs;
+            bucket.quantity += tuples;
+            if (!isSampledIteration(iteration)) {
+                return;
+            }
+            // emit the whole bucket as one record ending at this iteration;
+            // runtimes and tuple counts summed over the recorded iterations
+            // thus cover the skipped ones as well
+            startUs = endUs - bucket.duration;
+            tuples = bucket.quantity;
+            bucket.duration = 0;
+            bucket.quantity = 0;
+        }
+        enqueue(profile::ProfileBinaryLog::TIMING, txt,
+                {{startUs, endUs, startMaxRSS, endMaxRSS, tuples, iteration}});
+    }
+
+    /** create a hardware counter event for the given timing event signature */
+    void makeCounterEvent(const std::string& txt, const PerfCounters::Sample& counters, size_t iteration) {
+        // counters are only attributed to relation and rule timing events
+        const std::string keyword = txt.substr(0, txt.find(';'));
+        if (keyword != "@t-nonrecursive-relation" && keyword != "@t-nonrecursive-rule" &&
+                keyword != "@t-recursive-relation" && keyword != "@t-recursive-rule") {
+            return;
+        }
+        const std::string counterTxt = "@p-" + txt.substr(3);
+        uint64_t cycles = counters.cycles;
+        uint64_t cacheMisses = counters.cacheMisses;
+        uint64_t branchMisses = counters.branchMisses;
+        if (isIterationScoped(txt)) {
+            std::lock_guard<std::mutex> guard(bucketLock);
+            auto& bucket = iterationBuckets[counterTxt];
+            bucket.cycles += cycles;
+            bucket.cacheMisses += cacheMisses;
+            bucket.branchMisses += branchMisses;
+            if (!isSampledIteration(iteration)) {
+                return;
+            }
+            cycles = bucket.cycles;
+            cacheMisses = bucket.cacheMisses;
+            branchMisses = bucket.branchMisses;
+            bucket = IterationBucket();
+        }
+        enqueue(profile::ProfileBinaryLog::COUNTER, counterTxt, {{cycles, cacheMisses, branchMisses, iteration}});
     }
 
     /** create quantity event */
     void makeQuantityEvent(const std::string& txt, size_t number, int iteration) {
-        profile::EventProcessorSingleton::instance().process(database, txt.c_str(), number, iteration);
+        // iteration-scoped quantities are relation-size snapshots; skipped
+        // iterations need no aggregation, the next sample supersedes them
+        if (iteration >= 0 && isIterationScoped(txt) &&
+                !isSampledIteration(static_cast<size_t>(iteration))) {
+            return;
+        }
+        enqueue(profile::ProfileBinaryLog::QUANTITY, txt, {{number, static_cast<uint64_t>(iteration)}});
     }
 
     /** create utilisation event */
@@ -107,15 +511,33 @@ public:
         /* Maximum resident set size (kb) */
         size_t maxRSS = ru.ru_maxrss;
 
-        profile::EventProcessorSingleton::instance().process(
-                database, txt.c_str(), time, systemTime, userTime, maxRSS);
+        enqueue(profile::ProfileBinaryLog::UTILISATION, txt,
+                {{static_cast<uint64_t>(time.count()), systemTime, userTime, maxRSS}});
     }
 
     void setOutputFile(std::string filename) {
         this->filename = filename;
     }
+
+    /** Stream events to the output file in binary format as they occur,
+     * instead of accumulating them in the profile database. */
+    void enableStreaming() {
+        if (filename.empty() || streaming) {
+            return;
+        }
+        log.open(filename);
+        streaming = true;
+    }
+
     /** Dump all events */
     void dump() {
+        // deliver all buffered events before writing the output
+        stopCollector();
+        if (streaming) {
+            // the log has already been written incrementally
+            log.close();
+            return;
+        }
         if (!filename.empty()) {
             std::ofstream os(filename);
             if (!os.is_open()) {
@@ -139,15 +561,163 @@ public:
     void resetTimerInterval(uint32_t interval = 1) {
         timer.resetTimerInterval(interval);
     }
+
+    /** Start sampling the currently executing statement */
+    void startSampler() {
+        sampler.start();
+    }
+
+    /** Stop sampling and record the accumulated sample counts */
+    void stopSampler() {
+        sampler.stop();
+    }
     const profile::ProfileDatabase& getDB() const {
         return database;
     }
 
     void setDBFromFile(const std::string& filename) {
-        database = profile::ProfileDatabase(filename);
+        if (profile::ProfileBinaryLog::isBinaryLog(filename)) {
+            database = profile::ProfileDatabase();
+            profile::ProfileBinaryLog::replay(filename, database);
+        } else {
+            database = profile::ProfileDatabase(filename);
+        }
     }
 
 private:
+    /** A single buffered event awaiting collection */
+    struct BufferedEvent {
+        uint8_t kind = 0;
+        std::string text;
+        std::string aux;
+        std::array<uint64_t, 6> args{};
+    };
+
+    /**
+     * A bounded single-producer, single-consumer event ring. Each event
+     * producing thread owns one ring, written without locks; a collector
+     * thread drains all rings into the database or the binary log, keeping
+     * the database mutex entirely off the evaluation threads.
+     */
+    class EventBuffer {
+        /** ring capacity; must be a power of two */
+        static constexpr size_t CAPACITY = 1024;
+
+        /** the event slots */
+        std::array<BufferedEvent, CAPACITY> slots;
+
+        /** sequence number of the next slot to read, owned by the consumer */
+        alignas(64) std::atomic<size_t> head{0};
+
+        /** sequence number of the next slot to write, owned by the producer */
+        alignas(64) std::atomic<size_t> tail{0};
+
+    public:
+        /** append an event; blocks only if the collector has fallen a full
+         * ring behind */
+        void push(BufferedEvent&& event) {
+            size_t next = tail.load(std::memory_order_relaxed);
+            while (next - head.load(std::memory_order_acquire) == CAPACITY) {
+                std::this_thread::yield();
+            }
+            slots[next & (CAPACITY - 1)] = std::move(event);
+            tail.store(next + 1, std::memory_order_release);
+        }
+
+        /** remove the oldest event, if any */
+        bool pop(BufferedEvent& out) {
+            size_t next = head.load(std::memory_order_relaxed);
+            if (next == tail.load(std::memory_order_acquire)) {
+                return false;
+            }
+            out = std::move(slots[next & (CAPACITY - 1)]);
+            head.store(next + 1, std::memory_order_release);
+            return true;
+        }
+    };
+
+    /** per-thread event rings; the list only grows, guarded for registration */
+    std::vector<std::unique_ptr<EventBuffer>> buffers;
+    std::mutex buffersLock;
+
+    /** the collector thread draining the rings */
+    std::thread collector;
+    std::atomic<bool> collecting{false};
+    std::condition_variable collectorCondition;
+    std::mutex collectorMutex;
+
+    /** append the event to the calling thread's ring, starting the
+     * collector on first use */
+    void enqueue(uint8_t kind, std::string text, std::array<uint64_t, 6> args, std::string aux = "") {
+        BufferedEvent event;
+        event.kind = kind;
+        event.text = std::move(text);
+        event.aux = std::move(aux);
+        event.args = args;
+        threadBuffer().push(std::move(event));
+    }
+
+    /** obtain the calling thread's ring, registering it on first use */
+    EventBuffer& threadBuffer() {
+        thread_local EventBuffer* buffer = nullptr;
+        if (buffer == nullptr) {
+            auto owned = std::make_unique<EventBuffer>();
+            buffer = owned.get();
+            std::lock_guard<std::mutex> guard(buffersLock);
+            buffers.push_back(std::move(owned));
+            startCollector();
+        }
+        return *buffer;
+    }
+
+    /** deliver a single collected event to its destination */
+    void deliver(BufferedEvent& event) {
+        if (streaming) {
+            log.append(static_cast<profile::ProfileBinaryLog::Kind>(event.kind), event.text, event.args,
+                    event.aux);
+            return;
+        }
+        profile::ProfileBinaryLog::dispatch(database, event.kind, event.text, event.aux, event.args);
+    }
+
+    /** drain every ring completely */
+    void sweepBuffers() {
+        std::lock_guard<std::mutex> guard(buffersLock);
+        for (auto& buffer : buffers) {
+            BufferedEvent event;
+            while (buffer->pop(event)) {
+                deliver(event);
+            }
+        }
+    }
+
+    /** start the collector thread; the caller holds buffersLock */
+    void startCollector() {
+        if (collecting) {
+            return;
+        }
+        collecting = true;
+        collector = std::thread([this]() {
+            while (collecting) {
+                sweepBuffers();
+                std::unique_lock<std::mutex> lock(collectorMutex);
+                collectorCondition.wait_for(lock, std::chrono::milliseconds(1));
+            }
+        });
+    }
+
+    /** stop the collector and deliver all remaining events */
+    void stopCollector() {
+        if (collecting) {
+            collecting = false;
+            collectorCondition.notify_all();
+            if (collector.joinable()) {
+                collector.join();
+            }
+        }
+        sweepBuffers();
+    }
+
     /**  Profile Timer */
     class ProfileTimer {
     private:
@@ -232,7 +802,100 @@ private:
         }
     };
 
+    /**
+     * Statement sampler: a timer thread that periodically samples the id of
+     * the currently executing statement from the signal-handler progress
+     * table and accumulates a histogram, giving a statistical time profile
+     * without the per-scope timing overhead of the full profiler.
+     */
+    class StatementSampler {
+    private:
+        /** time interval between samples in microseconds */
+        uint32_t t;
+
+        /** sampler is running */
+        std::atomic<bool> running{false};
+
+        /** thread the sampler runs on */
+        std::thread th;
+
+        std::condition_variable conditionVariable;
+        std::mutex samplerMutex;
+
+        /** per-statement sample counts, indexed by statement id */
+        std::vector<uint64_t> histogram;
+
+        /** take one sample of the currently executing statement */
+        void sample() {
+            size_t id = SignalHandler::instance()->currentStatement();
+            if (id == static_cast<size_t>(-1)) {
+                return;
+            }
+            if (id >= histogram.size()) {
+                histogram.resize(id + 1, 0);
+            }
+            ++histogram[id];
+        }
+
+        /** emit the accumulated histogram into the profile */
+        void flush() {
+            for (size_t id = 0; id < histogram.size(); ++id) {
+                if (histogram[id] == 0) {
+                    continue;
+                }
+                const char* msg = SignalHandler::instance()->getProgressMessage(id);
+                if (msg == nullptr) {
+                    continue;
+                }
+                std::string txt(msg);
+                for (char& c : txt) {
+                    if (c == '\n' || c == '\t') {
+                        c = ' ';
+                    }
+                }
+                ProfileEventSingleton::instance().makeQuantityEvent("@sample;" + txt, histogram[id], 0);
+            }
+            histogram.clear();
+        }
+
+    public:
+        /*
+         *  @param interval the size of the sampling interval in microseconds
+         */
+        StatementSampler(uint32_t interval = 1000) : t(interval) {}
+
+        /** start the sampler on the thread th */
+        void start() {
+            if (running) {
+                return;
+            }
+            running = true;
+
+            th = std::thread([this]() {
+                while (running) {
+                    sample();
+                    std::unique_lock<std::mutex> lock(samplerMutex);
+                    conditionVariable.wait_for(lock, std::chrono::microseconds(t));
+                }
+            });
+        }
+
+        /** stop the sampler and emit the accumulated counts */
+        void stop() {
+            if (!running) {
+                return;
+            }
+            running = false;
+            conditionVariable.notify_all();
+            if (th.joinable()) {
+                th.join();
+            }
+            flush();
+        }
+    };
+
     ProfileTimer timer;
+    StatementSampler sampler;
 };
 
 }  // namespace souffle
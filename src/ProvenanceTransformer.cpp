@@ -10,7 +10,8 @@
  *
  * @file ProvenanceTransformer.cpp
  *
- * Implements AstTransformer for adding provenance information via two extra columns
+ * Implements AstTransformer for adding provenance information via one extra
+ * column holding the packed rule number and derivation height
  *
  ***********************************************************************/
 
@@ -28,6 +29,7 @@
 #include "AstVisitor.h"
 #include "BinaryConstraintOps.h"
 #include "FunctorOps.h"
+#include "RamTypes.h"
 #include "RelationRepresentation.h"
 #include "Util.h"
 #include <cassert>
@@ -299,25 +301,23 @@ bool ProvenanceTransformer::transform(AstTranslationUnit& translationUnit) {
             }
         }
 
+        // rule number and level number share a single packed column to keep
+        // the per-tuple overhead of instrumentation to one word
         relation->addAttribute(
-                std::make_unique<AstAttribute>(std::string("@rule_number"), AstTypeIdentifier("number")));
-        relation->addAttribute(
-                std::make_unique<AstAttribute>(std::string("@level_number"), AstTypeIdentifier("number")));
+                std::make_unique<AstAttribute>(std::string("@provenance"), AstTypeIdentifier("number")));
 
         for (auto clause : relation->getClauses()) {
-            // mapper to add two provenance columns to atoms
+            // mapper to add the provenance column to atoms
             struct M : public AstNodeMapper {
                 using AstNodeMapper::operator();
 
                 std::unique_ptr<AstNode> operator()(std::unique_ptr<AstNode> node) const override {
-                    // add provenance columns
+                    // add provenance column
                     if (auto atom = dynamic_cast<AstAtom*>(node.get())) {
                         atom->addArgument(std::make_unique<AstUnnamedVariable>());
-                        atom->addArgument(std::make_unique<AstUnnamedVariable>());
                     } else if (auto neg = dynamic_cast<AstNegation*>(node.get())) {
                         auto atom = neg->getAtom();
                         atom->addArgument(std::make_unique<AstUnnamedVariable>());
-                        atom->addArgument(std::make_unique<AstUnnamedVariable>());
                     }
 
                     // otherwise - apply mapper recursively
@@ -329,10 +329,9 @@ bool ProvenanceTransformer::transform(AstTranslationUnit& translationUnit) {
             // add unnamed vars to each atom nested in arguments of head
             clause->getHead()->apply(M());
 
-            // if fact, level number is 0
+            // if fact, rule and level number are 0
             if (clause->isFact()) {
                 clause->getHead()->addArgument(std::make_unique<AstNumberConstant>(0));
-                clause->getHead()->addArgument(std::make_unique<AstNumberConstant>(0));
             } else {
                 std::vector<AstArgument*> bodyLevels;
 
@@ -342,17 +341,22 @@ bool ProvenanceTransformer::transform(AstTranslationUnit& translationUnit) {
                     // add unnamed vars to each atom nested in arguments of lit
                     lit->apply(M());
 
-                    // add two provenance columns to lit; first is rule num, second is level num
+                    // add the packed provenance column to lit; the level
+                    // number occupies its high-order bits
                     if (auto atom = dynamic_cast<AstAtom*>(lit)) {
-                        atom->addArgument(std::make_unique<AstUnnamedVariable>());
                         atom->addArgument(std::make_unique<AstVariable>("@level_num_" + std::to_string(i)));
-                        bodyLevels.push_back(new AstVariable("@level_num_" + std::to_string(i)));
+                        bodyLevels.push_back(new AstIntrinsicFunctor(FunctorOp::DIV,
+                                std::make_unique<AstVariable>("@level_num_" + std::to_string(i)),
+                                std::make_unique<AstNumberConstant>(1 << PROVENANCE_RULE_BITS)));
                     }
                 }
 
-                // add two provenance columns to head lit
-                clause->getHead()->addArgument(std::make_unique<AstNumberConstant>(clause->getClauseNum()));
-                clause->getHead()->addArgument(std::unique_ptr<AstArgument>(getNextLevelNumber(bodyLevels)));
+                // add the packed provenance column to head lit
+                clause->getHead()->addArgument(std::make_unique<AstIntrinsicFunctor>(FunctorOp::ADD,
+                        std::make_unique<AstIntrinsicFunctor>(FunctorOp::MUL,
+                                std::unique_ptr<AstArgument>(getNextLevelNumber(bodyLevels)),
+                                std::make_unique<AstNumberConstant>(1 << PROVENANCE_RULE_BITS)),
+                        std::make_unique<AstNumberConstant>(clause->getClauseNum())));
             }
         }
     }
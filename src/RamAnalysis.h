@@ -39,6 +39,16 @@ public:
     /** @brief Run analysis for a RAM translation unit */
     virtual void run(const RamTranslationUnit& translationUnit) = 0;
 
+    /** @brief Invalidate cached results after a program change.
+     *
+     * Returning true keeps the analysis instance alive; it is re-run on
+     * its next use and may carry internal state across the re-run to
+     * refresh its results incrementally. Returning false (the default)
+     * discards the instance, and a fresh one is created on demand. */
+    virtual bool invalidate() {
+        return false;
+    }
+
     /** @brief Print the analysis result in HTML format */
     virtual void print(std::ostream& os) const {}
 
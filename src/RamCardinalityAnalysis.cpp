@@ -0,0 +1,109 @@
+/*
+ * Souffle - A Datalog Compiler
+ * Copyright (c) 2019, The Souffle Developers. All rights reserved
+ * Licensed under the Universal Permissive License v 1.0 as shown at:
+ * - https://opensource.org/licenses/UPL
+ * - <souffle root>/licenses/SOUFFLE-UPL.txt
+ */
+
+/************************************************************************
+ *
+ * @file RamCardinalityAnalysis.cpp
+ *
+ * Implementation of the RAM cardinality analysis, estimating relation
+ * sizes from facts-file line counts and profile feedback.
+ *
+ ***********************************************************************/
+
+#include "RamCardinalityAnalysis.h"
+#include "Global.h"
+#include "IODirectives.h"
+#include "RamProgram.h"
+#include "RamRelation.h"
+#include "RamStatement.h"
+#include "RamTranslationUnit.h"
+#include "RamVisitor.h"
+#include "profile/ProgramRun.h"
+#include "profile/Reader.h"
+#include "profile/Relation.h"
+#include <cassert>
+#include <fstream>
+#include <memory>
+#include <string>
+
+namespace souffle {
+
+namespace {
+
+/** @brief Count the number of lines of a facts file */
+bool countLines(const std::string& filename, size_t& lines) {
+    std::ifstream in(filename);
+    if (!in.is_open()) {
+        return false;
+    }
+    lines = 0;
+    std::string line;
+    while (std::getline(in, line)) {
+        lines++;
+    }
+    return true;
+}
+
+}  // namespace
+
+void RamCardinalityAnalysis::run(const RamTranslationUnit& translationUnit) {
+    const RamProgram& program = *translationUnit.getProgram();
+    estimates.clear();
+
+    // estimate input relations by the line counts of their facts files;
+    // a relation loaded from several files accumulates their counts
+    visitDepthFirst(program, [&](const RamLoad& load) {
+        for (const IODirectives& directives : load.getIODirectives()) {
+            if (directives.getIOType() != "file" || !directives.has("filename")) {
+                continue;
+            }
+            // consult the cache first; re-runs after an invalidation must
+            // not read the facts files again
+            const std::string& filename = directives.get("filename");
+            auto pos = fileLineCounts.find(filename);
+            if (pos == fileLineCounts.end()) {
+                size_t lines = 0;
+                const bool readable = countLines(filename, lines);
+                pos = fileLineCounts.emplace(filename, std::make_pair(readable, lines)).first;
+            }
+            if (pos->second.first) {
+                estimates[load.getRelation().getName()] += pos->second.second;
+            }
+        }
+    });
+
+    // profile feedback covers derived relations as well and reflects
+    // fixed-point sizes of an actual run; it takes precedence
+    if (Global::config().has("profile-use")) {
+        auto programRun = std::make_shared<profile::ProgramRun>(profile::ProgramRun());
+        profile::Reader(Global::config().get("profile-use"), programRun).processFile();
+        for (const auto& rel : program.getAllRelations()) {
+            if (const auto* profRel = programRun->getRelation(rel.first)) {
+                estimates[rel.first] = profRel->size();
+            }
+        }
+    }
+}
+
+void RamCardinalityAnalysis::print(std::ostream& os) const {
+    for (const auto& estimate : estimates) {
+        os << estimate.first << " " << estimate.second << std::endl;
+    }
+}
+
+bool RamCardinalityAnalysis::hasEstimate(const RamRelation& relation) const {
+    return estimates.find(relation.getName()) != estimates.end();
+}
+
+size_t RamCardinalityAnalysis::getEstimate(const RamRelation& relation) const {
+    auto it = estimates.find(relation.getName());
+    assert(it != estimates.end() && "no cardinality estimate for relation");
+    return it->second;
+}
+
+}  // end of namespace souffle
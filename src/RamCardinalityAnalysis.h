@@ -0,0 +1,79 @@
+/*
+ * Souffle - A Datalog Compiler
+ * Copyright (c) 2019, The Souffle Developers. All rights reserved
+ * Licensed under the Universal Permissive License v 1.0 as shown at:
+ * - https://opensource.org/licenses/UPL
+ * - <souffle root>/licenses/SOUFFLE-UPL.txt
+ */
+
+/************************************************************************
+ *
+ * @file RamCardinalityAnalysis.h
+ *
+ * Estimate the number of tuples held by RAM relations, for use in
+ * cost-based decisions of RAM transformations.
+ *
+ ***********************************************************************/
+
+#pragma once
+
+#include "RamAnalysis.h"
+#include <cstddef>
+#include <map>
+#include <string>
+
+namespace souffle {
+
+class RamRelation;
+
+/**
+ * @class RamCardinalityAnalysis
+ * @brief A RAM Analysis estimating relation cardinalities
+ *
+ * Estimates stem from two sources: the line counts of the facts files
+ * referenced by load statements, available for input relations, and
+ * the relation sizes recorded in a profile log given via the
+ * profile-use option, available for all relations of a profiled run.
+ * Profile sizes take precedence since they reflect the fixed-point
+ * sizes of an actual execution.
+ *
+ * Relations covered by neither source have no estimate; transformations
+ * consulting this analysis are expected to fall back to their
+ * size-oblivious behaviour in that case.
+ */
+class RamCardinalityAnalysis : public RamAnalysis {
+public:
+    RamCardinalityAnalysis(const char* id) : RamAnalysis(id) {}
+
+    static constexpr const char* name = "cardinality-analysis";
+
+    /** A relation with at most this many tuples is considered small;
+     *  per-tuple machinery such as indices cannot pay off for it */
+    static constexpr size_t smallRelationThreshold = 8;
+
+    void run(const RamTranslationUnit& translationUnit) override;
+
+    void print(std::ostream& os) const override;
+
+    /** a re-run rebuilds the estimates from the cached facts-file line
+     * counts, so the files are read only once per compilation */
+    bool invalidate() override {
+        return true;
+    }
+
+    /** @brief Check whether an estimate is known for a relation */
+    bool hasEstimate(const RamRelation& relation) const;
+
+    /** @brief Get the estimated number of tuples of a relation */
+    size_t getEstimate(const RamRelation& relation) const;
+
+protected:
+    /** Estimated number of tuples, keyed by relation name */
+    std::map<std::string, size_t> estimates;
+
+    /** Line counts of the facts files read so far, keyed by file name;
+     * the flag records whether the file could be read at all */
+    std::map<std::string, std::pair<bool, size_t>> fileLineCounts;
+};
+
+}  // end of namespace souffle
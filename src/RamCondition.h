@@ -397,6 +397,47 @@ public:
     }
 };
 
+/**
+ * @class RamSubsumptionCheck
+ * @brief Dominance check for a tuple in a subsumption relation
+ *
+ * The last attribute of a subsumption relation is a measure under which
+ * smaller tuples dominate larger ones. The check evaluates to true if the
+ * relation contains a tuple that agrees with the given tuple on all but the
+ * last attribute and carries a smaller or equal measure:
+ * ~~~~~~~~~~~~~~~~~~~~~~~~~~~
+ * (t0.0,t0.1,t0.2) ⊑ A
+ * ~~~~~~~~~~~~~~~~~~~~~~~~~~~
+ */
+class RamSubsumptionCheck : public RamAbstractExistenceCheck {
+public:
+    RamSubsumptionCheck(
+            std::unique_ptr<RamRelationReference> relRef, std::vector<std::unique_ptr<RamExpression>> vals)
+            : RamAbstractExistenceCheck(std::move(relRef), std::move(vals)) {}
+
+    void print(std::ostream& os) const override {
+        os << "("
+           << join(values, ",",
+                      [](std::ostream& out, const std::unique_ptr<RamExpression>& value) {
+                          if (!value) {
+                              out << "_";
+                          } else {
+                              out << *value;
+                          }
+                      })
+           << ") ⊑ " << getRelation().getName();
+    }
+
+    RamSubsumptionCheck* clone() const override {
+        std::vector<std::unique_ptr<RamExpression>> newValues;
+        for (auto& cur : values) {
+            newValues.emplace_back(cur->clone());
+        }
+        return new RamSubsumptionCheck(
+                std::unique_ptr<RamRelationReference>(relationRef->clone()), std::move(newValues));
+    }
+};
+
 /**
  * @class RamEmptinessCheck
  * @brief Emptiness check for a relation
@@ -15,9 +15,11 @@
  ***********************************************************************/
 
 #include "RamIndexAnalysis.h"
+#include "ParallelUtils.h"
 #include "RamCondition.h"
 #include "RamNode.h"
 #include "RamOperation.h"
+#include "RamStatement.h"
 #include "RamTranslationUnit.h"
 #include "RamVisitor.h"
 #include <cstdint>
@@ -25,6 +27,7 @@
 #include <iostream>
 #include <iterator>
 #include <queue>
+#include <vector>
 
 namespace souffle {
 
@@ -274,8 +277,10 @@ void RamIndexAnalysis::run(const RamTranslationUnit& translationUnit) {
     // 0-arity relation in a provenance program still need to be revisited.
 
     // visit all nodes to collect searches of each relation
-    visitDepthFirst(*translationUnit.getProgram(), [&](const RamNode& node) {
-        if (const auto* indexSearch = dynamic_cast<const RamIndexOperation*>(&node)) {
+    auto collectSearches = [&](const RamNode& node) {
+        if (dynamic_cast<const RamHashScan*>(&node) != nullptr) {
+            // hash scans probe a transient hash table; no index required
+        } else if (const auto* indexSearch = dynamic_cast<const RamIndexOperation*>(&node)) {
             MinIndexSelection& indexes = getIndexes(indexSearch->getRelation());
             indexes.addSearch(getSearchSignature(indexSearch));
         } else if (const auto* exists = dynamic_cast<const RamExistenceCheck*>(&node)) {
@@ -284,10 +289,23 @@ void RamIndexAnalysis::run(const RamTranslationUnit& translationUnit) {
         } else if (const auto* provExists = dynamic_cast<const RamProvenanceExistenceCheck*>(&node)) {
             MinIndexSelection& indexes = getIndexes(provExists->getRelation());
             indexes.addSearch(getSearchSignature(provExists));
+        } else if (const auto* subsumes = dynamic_cast<const RamSubsumptionCheck*>(&node)) {
+            MinIndexSelection& indexes = getIndexes(subsumes->getRelation());
+            indexes.addSearch(getSearchSignature(subsumes));
         } else if (const auto* ramRel = dynamic_cast<const RamRelation*>(&node)) {
             MinIndexSelection& indexes = getIndexes(*ramRel);
             indexes.addSearch(getSearchSignature(ramRel));
         }
+    };
+    visitDepthFirst(*translationUnit.getProgram(), [&](const RamNode& node) {
+        collectSearches(node);
+        // the alternative plans of a query are hidden from visitors;
+        // their searches still need index support
+        if (const auto* query = dynamic_cast<const RamQuery*>(&node)) {
+            for (const RamOperation* alt : query->getAlternatives()) {
+                visitDepthFirst(*alt, collectSearches);
+            }
+        }
     });
 
     // A swap happen between rel A and rel B indicates A should include all indices of B, vice versa.
@@ -314,11 +332,23 @@ void RamIndexAnalysis::run(const RamTranslationUnit& translationUnit) {
         }
     });
 
-    // find optimal indexes for relations
+    // find optimal indexes for relations; a relation whose search set is
+    // unchanged since the previous run reuses the cover solved back then,
+    // and the remaining (independent) instances are solved in parallel
+    std::vector<MinIndexSelection*> pending;
     for (auto& cur : minIndexCover) {
-        MinIndexSelection& indexes = cur.second;
-        indexes.solve();
+        auto cached = solvedCache.find(cur.first->getName());
+        if (cached != solvedCache.end() && cached->second.getSearches() == cur.second.getSearches()) {
+            cur.second = cached->second;
+        } else {
+            pending.push_back(&cur.second);
+        }
+    }
+    PARALLEL_START;
+    pfor(size_t i = 0; i < pending.size(); ++i) {
+        pending[i]->solve();
     }
+    PARALLEL_END;
 
     // Only case where indexSet is still empty is when relation has arity == 0
     for (auto& cur : minIndexCover) {
@@ -327,6 +357,12 @@ void RamIndexAnalysis::run(const RamTranslationUnit& translationUnit) {
             indexes.insertDefaultTotalIndex(0);
         }
     }
+
+    // remember the solved selections for the next run of this analysis
+    solvedCache.clear();
+    for (auto& cur : minIndexCover) {
+        solvedCache.emplace(cur.first->getName(), cur.second);
+    }
 }
 
 MinIndexSelection& RamIndexAnalysis::getIndexes(const RamRelation& rel) {
@@ -380,6 +416,16 @@ SearchSignature RamIndexAnalysis::getSearchSignature(const RamIndexOperation* se
             keys |= (1 << i);
         }
     }
+    // columns restricted by inequality bounds are covered by the index as well
+    if (search->hasRangeBounds()) {
+        std::vector<RamExpression*> lower = search->getRangeLowerBound();
+        std::vector<RamExpression*> upper = search->getRangeUpperBound();
+        for (int i = 0; i < (int)lower.size(); i++) {
+            if (!isRamUndefValue(lower[i]) || !isRamUndefValue(upper[i])) {
+                keys |= (1 << i);
+            }
+        }
+    }
     return keys;
 }
 
@@ -387,7 +433,21 @@ SearchSignature RamIndexAnalysis::getSearchSignature(
         const RamProvenanceExistenceCheck* provExistCheck) const {
     const auto values = provExistCheck->getValues();
     SearchSignature res = 0;
-    // values.size() - 1 because we discard the height annotation
+    // values.size() - 1 because we discard the packed provenance annotation
+    for (int i = 0; i < (int)values.size() - 1; i++) {
+        if (!isRamUndefValue(values[i])) {
+            res |= (1 << i);
+        }
+    }
+    return res;
+}
+
+SearchSignature RamIndexAnalysis::getSearchSignature(
+        const RamSubsumptionCheck* subsumptionCheck) const {
+    const auto values = subsumptionCheck->getValues();
+    SearchSignature res = 0;
+    // values.size() - 1 because the last attribute is the measure, which is
+    // matched by a range rather than by equality
     for (int i = 0; i < (int)values.size() - 1; i++) {
         if (!isRamUndefValue(values[i])) {
             res |= (1 << i);
@@ -324,6 +324,16 @@ public:
 
     void run(const RamTranslationUnit& translationUnit) override;
 
+    /** the solved covers are retained across the invalidation; a re-run
+     * reuses them for every relation whose search set is unchanged and
+     * only solves the remaining instances */
+    bool invalidate() override {
+        // the cover map is keyed by relation pointers which the program
+        // change may have deleted; only the name-keyed cache survives
+        minIndexCover.clear();
+        return true;
+    }
+
     void print(std::ostream& os) const override;
 
     /**
@@ -361,6 +371,13 @@ public:
      */
     SearchSignature getSearchSignature(const RamProvenanceExistenceCheck* existCheck) const;
 
+    /**
+     * @Brief Get the index signature for a subsumption check
+     * @param Subsumption check
+     * @result index signature of subsumption check
+     */
+    SearchSignature getSearchSignature(const RamSubsumptionCheck* subsumptionCheck) const;
+
     /**
      * @Brief Get the default index signature for a relation (the total-order index)
      * @param RamCreate node
@@ -382,6 +399,12 @@ private:
      * minimal index cover for relations, i.e., maps a relation to a set of indexes
      */
     std::map<const RamRelation*, MinIndexSelection> minIndexCover;
+
+    /**
+     * solved selections of the previous run, keyed by relation name;
+     * consulted by re-runs to skip re-solving unchanged search sets
+     */
+    std::map<std::string, MinIndexSelection> solvedCache;
 };
 
 }  // end of namespace souffle
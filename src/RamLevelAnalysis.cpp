@@ -195,6 +195,15 @@ int RamLevelAnalysis::getLevel(const RamNode* node) const {
             return level;
         }
 
+        // subsumption check
+        int visitSubsumptionCheck(const RamSubsumptionCheck& subsumes) override {
+            int level = -1;
+            for (const auto& cur : subsumes.getValues()) {
+                level = std::max(level, visit(cur));
+            }
+            return level;
+        }
+
         // emptiness check
         int visitEmptinessCheck(const RamEmptinessCheck& emptiness) override {
             return -1;  // can be in the top level
@@ -46,6 +46,12 @@ public:
 
     void run(const RamTranslationUnit& translationUnit) override {}
 
+    /** levels are computed on demand from the queried node; there is no
+     * cached state to refresh */
+    bool invalidate() override {
+        return true;
+    }
+
     /**
      * @brief Get level of a RAM expression/condition
      */
@@ -271,11 +271,66 @@ public:
         return toPtrVector(queryPattern);
     }
 
+    /**
+     * @brief Check whether inequality bounds have been attached
+     */
+    bool hasRangeBounds() const {
+        return !rangeLower.empty();
+    }
+
+    /**
+     * @brief Get inclusive lower bounds per column (undefined if unbounded)
+     * @return A std::vector of pointers to RamExpression objects
+     */
+    std::vector<RamExpression*> getRangeLowerBound() const {
+        return toPtrVector(rangeLower);
+    }
+
+    /**
+     * @brief Get inclusive upper bounds per column (undefined if unbounded)
+     * @return A std::vector of pointers to RamExpression objects
+     */
+    std::vector<RamExpression*> getRangeUpperBound() const {
+        return toPtrVector(rangeUpper);
+    }
+
+    /**
+     * @brief Attach inclusive per-column bounds restricting the range query
+     *
+     * The bounds merely prune the search; the original inequality
+     * constraints are expected to remain as filters in the nested
+     * operation such that the emitted range is only required to be
+     * a superset of the exact result.
+     */
+    void setRangeBounds(std::vector<std::unique_ptr<RamExpression>> lower,
+            std::vector<std::unique_ptr<RamExpression>> upper) {
+        assert(lower.size() == getRelation().getArity());
+        assert(upper.size() == getRelation().getArity());
+        rangeLower = std::move(lower);
+        rangeUpper = std::move(upper);
+    }
+
+    /** @brief Copy the range bounds of another index operation (used when cloning/converting) */
+    void copyRangeBounds(const RamIndexOperation& other) {
+        for (auto& cur : other.rangeLower) {
+            rangeLower.push_back(std::unique_ptr<RamExpression>(cur->clone()));
+        }
+        for (auto& cur : other.rangeUpper) {
+            rangeUpper.push_back(std::unique_ptr<RamExpression>(cur->clone()));
+        }
+    }
+
     std::vector<const RamNode*> getChildNodes() const override {
         auto res = RamRelationOperation::getChildNodes();
         for (auto& cur : queryPattern) {
             res.push_back(cur.get());
         }
+        for (auto& cur : rangeLower) {
+            res.push_back(cur.get());
+        }
+        for (auto& cur : rangeUpper) {
+            res.push_back(cur.get());
+        }
         return res;
     }
 
@@ -284,26 +339,51 @@ public:
         for (auto& cur : queryPattern) {
             cur = map(std::move(cur));
         }
+        for (auto& cur : rangeLower) {
+            cur = map(std::move(cur));
+        }
+        for (auto& cur : rangeUpper) {
+            cur = map(std::move(cur));
+        }
     }
 
 protected:
     /** Values of index per column of table (if indexable) */
     std::vector<std::unique_ptr<RamExpression>> queryPattern;
 
+    /** Inclusive lower bounds per column of table (if range-restricted) */
+    std::vector<std::unique_ptr<RamExpression>> rangeLower;
+
+    /** Inclusive upper bounds per column of table (if range-restricted) */
+    std::vector<std::unique_ptr<RamExpression>> rangeUpper;
+
     /** @brief Helper method for printing */
     void printIndex(std::ostream& os) const {
         bool first = true;
+        auto printTerm = [&](size_t i, const std::string& op, const RamExpression& expr) {
+            if (first) {
+                os << " ON INDEX ";
+                first = false;
+            } else {
+                os << " AND ";
+            }
+            os << "t" << getTupleId() << ".";
+            os << getRelation().getArg(i) << " " << op << " ";
+            os << expr;
+        };
         for (unsigned int i = 0; i < queryPattern.size(); ++i) {
             if (!isRamUndefValue(queryPattern[i].get())) {
-                if (first) {
-                    os << " ON INDEX ";
-                    first = false;
-                } else {
-                    os << " AND ";
-                }
-                os << "t" << getTupleId() << ".";
-                os << getRelation().getArg(i) << " = ";
-                os << *queryPattern[i];
+                printTerm(i, "=", *queryPattern[i]);
+            }
+        }
+        for (unsigned int i = 0; i < rangeLower.size(); ++i) {
+            if (!isRamUndefValue(rangeLower[i].get())) {
+                printTerm(i, ">=", *rangeLower[i]);
+            }
+        }
+        for (unsigned int i = 0; i < rangeUpper.size(); ++i) {
+            if (!isRamUndefValue(rangeUpper[i].get())) {
+                printTerm(i, "<=", *rangeUpper[i]);
             }
         }
     }
@@ -311,7 +391,8 @@ protected:
     bool equal(const RamNode& node) const override {
         assert(nullptr != dynamic_cast<const RamIndexOperation*>(&node));
         const auto& other = static_cast<const RamIndexOperation&>(node);
-        return RamRelationOperation::equal(other) && equal_targets(queryPattern, other.queryPattern);
+        return RamRelationOperation::equal(other) && equal_targets(queryPattern, other.queryPattern) &&
+               equal_targets(rangeLower, other.rangeLower) && equal_targets(rangeUpper, other.rangeUpper);
     }
 };
 
@@ -350,9 +431,11 @@ public:
         for (unsigned int i = 0; i < queryPattern.size(); ++i) {
             resQueryPattern[i] = std::unique_ptr<RamExpression>(queryPattern[i]->clone());
         }
-        return new RamIndexScan(std::unique_ptr<RamRelationReference>(relationRef->clone()), getTupleId(),
-                std::move(resQueryPattern), std::unique_ptr<RamOperation>(getOperation().clone()),
-                getProfileText());
+        RamIndexScan* res = new RamIndexScan(std::unique_ptr<RamRelationReference>(relationRef->clone()),
+                getTupleId(), std::move(resQueryPattern),
+                std::unique_ptr<RamOperation>(getOperation().clone()), getProfileText());
+        res->copyRangeBounds(*this);
+        return res;
     }
 };
 
@@ -390,9 +473,58 @@ public:
         for (unsigned int i = 0; i < queryPattern.size(); ++i) {
             resQueryPattern[i] = std::unique_ptr<RamExpression>(queryPattern[i]->clone());
         }
-        return new RamParallelIndexScan(std::unique_ptr<RamRelationReference>(relationRef->clone()),
-                getTupleId(), std::move(resQueryPattern),
-                std::unique_ptr<RamOperation>(getOperation().clone()), getProfileText());
+        RamParallelIndexScan* res = new RamParallelIndexScan(
+                std::unique_ptr<RamRelationReference>(relationRef->clone()), getTupleId(),
+                std::move(resQueryPattern), std::unique_ptr<RamOperation>(getOperation().clone()),
+                getProfileText());
+        res->copyRangeBounds(*this);
+        return res;
+    }
+};
+
+/**
+ * @class RamHashScan
+ * @brief Search for tuples matching an equality pattern by probing a
+ * transient hash table instead of a persistent index
+ *
+ * Chosen for one-shot joins where an index would be used exactly once;
+ * the hash table is built on the scanned relation at first use and
+ * discarded after the enclosing query.
+ *
+ * For example:
+ * ~~~~~~~~~~~~~~~~~~~~~~~~~~~
+ *  QUERY
+ *   ...
+ *	 HASH FOR t1 IN X ON INDEX t1.c = t0.0
+ *	 ...
+ * ~~~~~~~~~~~~~~~~~~~~~~~~~~~
+ */
+class RamHashScan : public RamIndexScan {
+public:
+    RamHashScan(std::unique_ptr<RamRelationReference> r, int ident,
+            std::vector<std::unique_ptr<RamExpression>> queryPattern, std::unique_ptr<RamOperation> nested,
+            std::string profileText = "")
+            : RamIndexScan(std::move(r), ident, std::move(queryPattern), std::move(nested),
+                      std::move(profileText)) {}
+
+    void print(std::ostream& os, int tabpos) const override {
+        const RamRelation& rel = getRelation();
+        os << times(" ", tabpos);
+        os << "HASH FOR t" << getTupleId() << " IN ";
+        os << rel.getName();
+        printIndex(os);
+        os << std::endl;
+        RamIndexOperation::print(os, tabpos + 1);
+    }
+
+    RamHashScan* clone() const override {
+        std::vector<std::unique_ptr<RamExpression>> resQueryPattern(queryPattern.size());
+        for (unsigned int i = 0; i < queryPattern.size(); ++i) {
+            resQueryPattern[i] = std::unique_ptr<RamExpression>(queryPattern[i]->clone());
+        }
+        return new RamHashScan(std::unique_ptr<RamRelationReference>(relationRef->clone()), getTupleId(),
+                std::move(resQueryPattern), std::unique_ptr<RamOperation>(getOperation().clone()),
+                getProfileText());
     }
 };
 
@@ -558,10 +690,7 @@ public:
     }
 
     void apply(const RamNodeMapper& map) override {
-        RamRelationOperation::apply(map);
-        for (auto& cur : queryPattern) {
-            cur = map(std::move(cur));
-        }
+        RamIndexOperation::apply(map);
         RamAbstractChoice::apply(map);
     }
 
@@ -579,6 +708,7 @@ public:
         RamIndexChoice* res = new RamIndexChoice(std::unique_ptr<RamRelationReference>(relationRef->clone()),
                 getTupleId(), std::unique_ptr<RamCondition>(condition->clone()), std::move(resQueryPattern),
                 std::unique_ptr<RamOperation>(getOperation().clone()), getProfileText());
+        res->copyRangeBounds(*this);
         return res;
     }
 
@@ -631,6 +761,7 @@ public:
                 std::unique_ptr<RamRelationReference>(relationRef->clone()), getTupleId(),
                 std::unique_ptr<RamCondition>(condition->clone()), std::move(resQueryPattern),
                 std::unique_ptr<RamOperation>(getOperation().clone()), getProfileText());
+        res->copyRangeBounds(*this);
         return res;
     }
 };
@@ -768,6 +899,45 @@ protected:
     }
 };
 
+/**
+ * @class RamParallelAggregate
+ * @brief Parallel aggregation function applied on some relation
+ *
+ * For example:
+ * ~~~~~~~~~~~~~~~~~~~~~~~~~~~
+ * PARALLEL t0.0 = COUNT FOR ALL t0 IN A
+ * ~~~~~~~~~~~~~~~~~~~~~~~~~~~
+ * The relation is aggregated partition-wise into per-thread partial
+ * results, which are combined with the function's monoid.
+ */
+class RamParallelAggregate : public RamAggregate, public RamAbstractParallel {
+public:
+    RamParallelAggregate(std::unique_ptr<RamOperation> nested, AggregateFunction fun,
+            std::unique_ptr<RamRelationReference> relRef, std::unique_ptr<RamExpression> expression,
+            std::unique_ptr<RamCondition> condition, int ident)
+            : RamAggregate(std::move(nested), fun, std::move(relRef), std::move(expression),
+                      std::move(condition), ident) {}
+
+    void print(std::ostream& os, int tabpos) const override {
+        os << times(" ", tabpos);
+        os << "PARALLEL t" << getTupleId() << ".0=";
+        RamAbstractAggregate::print(os, tabpos);
+        os << "FOR ALL t" << getTupleId() << " ∈ " << getRelation().getName();
+        if (!isRamTrue(condition.get())) {
+            os << " WHERE " << getCondition();
+        }
+        os << std::endl;
+        RamRelationOperation::print(os, tabpos + 1);
+    }
+
+    RamParallelAggregate* clone() const override {
+        return new RamParallelAggregate(std::unique_ptr<RamOperation>(getOperation().clone()), function,
+                std::unique_ptr<RamRelationReference>(relationRef->clone()),
+                std::unique_ptr<RamExpression>(expression->clone()),
+                std::unique_ptr<RamCondition>(condition->clone()), getTupleId());
+    }
+};
+
 /**
  * @class RamIndexAggregate
  * @brief Indexed aggregation on a relation
@@ -806,10 +976,13 @@ public:
         for (auto const& e : queryPattern) {
             pattern.push_back(std::unique_ptr<RamExpression>(e->clone()));
         }
-        return new RamIndexAggregate(std::unique_ptr<RamOperation>(getOperation().clone()), function,
+        RamIndexAggregate* res = new RamIndexAggregate(
+                std::unique_ptr<RamOperation>(getOperation().clone()), function,
                 std::unique_ptr<RamRelationReference>(relationRef->clone()),
                 std::unique_ptr<RamExpression>(expression->clone()),
                 std::unique_ptr<RamCondition>(condition->clone()), std::move(pattern), getTupleId());
+        res->copyRangeBounds(*this);
+        return res;
     }
 
     void apply(const RamNodeMapper& map) override {
@@ -999,6 +1172,81 @@ protected:
     }
 };
 
+/**
+ * @class RamSplit
+ * @brief Evaluates several independent operation bodies in the
+ * current tuple environment
+ *
+ * Produced by fusing queries whose outer loops scan the same
+ * relation, so that each tuple of the shared scan is read once
+ * for all rule bodies:
+ * ~~~~~~~~~~~~~~~~~~~~~~~~~~~
+ *  QUERY
+ *   FOR t0 IN A
+ *    SPLIT
+ *     ...
+ *    AND
+ *     ...
+ * ~~~~~~~~~~~~~~~~~~~~~~~~~~~
+ */
+class RamSplit : public RamOperation {
+public:
+    RamSplit(std::vector<std::unique_ptr<RamOperation>> bodies) : bodies(std::move(bodies)) {
+        assert(!this->bodies.empty() && "no bodies");
+        for (const auto& cur : this->bodies) {
+            assert(cur != nullptr && "body is a null-pointer");
+            (void)cur;
+        }
+    }
+
+    /** @brief Get bodies */
+    std::vector<RamOperation*> getBodies() const {
+        return toPtrVector(bodies);
+    }
+
+    void print(std::ostream& os, int tabpos) const override {
+        os << times(" ", tabpos) << "SPLIT" << std::endl;
+        for (size_t i = 0; i < bodies.size(); i++) {
+            if (i > 0) {
+                os << times(" ", tabpos) << "AND" << std::endl;
+            }
+            bodies[i]->print(os, tabpos + 1);
+        }
+    }
+
+    std::vector<const RamNode*> getChildNodes() const override {
+        std::vector<const RamNode*> res;
+        for (const auto& cur : bodies) {
+            res.push_back(cur.get());
+        }
+        return res;
+    }
+
+    RamSplit* clone() const override {
+        std::vector<std::unique_ptr<RamOperation>> newBodies;
+        for (const auto& cur : bodies) {
+            newBodies.emplace_back(cur->clone());
+        }
+        return new RamSplit(std::move(newBodies));
+    }
+
+    void apply(const RamNodeMapper& map) override {
+        for (auto& cur : bodies) {
+            cur = map(std::move(cur));
+        }
+    }
+
+protected:
+    /** Independent operation bodies */
+    std::vector<std::unique_ptr<RamOperation>> bodies;
+
+    bool equal(const RamNode& node) const override {
+        assert(nullptr != dynamic_cast<const RamSplit*>(&node));
+        const auto& other = static_cast<const RamSplit&>(node);
+        return equal_targets(bodies, other.bodies);
+    }
+};
+
 /**
  * @class RamProject
  * @brief Project a result into the target relation.
@@ -0,0 +1,1015 @@
+/*
+ * Souffle - A Datalog Compiler
+ * Copyright (c) 2019, The Souffle Developers. All rights reserved
+ * Licensed under the Universal Permissive License v 1.0 as shown at:
+ * - https://opensource.org/licenses/UPL
+ * - <souffle root>/licenses/SOUFFLE-UPL.txt
+ */
+
+/************************************************************************
+ *
+ * @file RamSerializer.cpp
+ *
+ * Implements the binary serializer for RAM programs.
+ *
+ ***********************************************************************/
+
+#include "RamSerializer.h"
+#include "BinaryConstraintOps.h"
+#include "FunctorOps.h"
+#include "IODirectives.h"
+#include "RamCondition.h"
+#include "RamExpression.h"
+#include "RamOperation.h"
+#include "RamRelation.h"
+#include "RamStatement.h"
+#include "RamVisitor.h"
+#include "RelationRepresentation.h"
+
+#include <istream>
+#include <ostream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace souffle {
+
+namespace {
+
+// 'S' 'R' 'A' 'M' -- souffle serialized RAM program
+const uint32_t MAGIC = 0x4d415253;
+const uint32_t VERSION = 1;
+
+/**
+ * Tags identifying the concrete type of a serialized node record. The
+ * values are part of the on-disk format; new tags may only be appended.
+ */
+enum class Tag : uint8_t {
+    Nil = 0,  // an absent expression slot
+
+    // expressions
+    TupleElement,
+    Number,
+    IntrinsicOperator,
+    UserDefinedOperator,
+    AutoIncrement,
+    PackRecord,
+    SubroutineArgument,
+    UndefValue,
+
+    // conditions
+    True,
+    False,
+    Conjunction,
+    Negation,
+    Constraint,
+    ExistenceCheck,
+    ProvenanceExistenceCheck,
+    SubsumptionCheck,
+    EmptinessCheck,
+
+    // operations
+    Scan,
+    ParallelScan,
+    IndexScan,
+    ParallelIndexScan,
+    HashScan,
+    Choice,
+    ParallelChoice,
+    IndexChoice,
+    ParallelIndexChoice,
+    Aggregate,
+    ParallelAggregate,
+    IndexAggregate,
+    UnpackRecord,
+    Filter,
+    Break,
+    Split,
+    Project,
+    SubroutineReturnValue,
+
+    // statements
+    Create,
+    Load,
+    Store,
+    Clear,
+    Drop,
+    Merge,
+    Swap,
+    Fact,
+    Query,
+    Sequence,
+    Parallel,
+    Loop,
+    Exit,
+    LogRelationTimer,
+    LogTimer,
+    DebugInfo,
+    Stratum,
+    LogSize,
+    FactTable
+};
+
+/**
+ * Visitor emitting one tagged record per node in pre-order; children
+ * are written after the scalar fields of their parent, matching the
+ * order in which the reader consumes them.
+ */
+class RamProgramWriter : public RamVisitor<void> {
+public:
+    RamProgramWriter(std::ostream& out) : out(out) {}
+
+    void writeNumber(uint64_t value) {
+        out.write(reinterpret_cast<const char*>(&value), sizeof(value));
+    }
+
+    void writeString(const std::string& str) {
+        writeNumber(str.size());
+        out.write(str.data(), str.size());
+    }
+
+    void writeTag(Tag tag) {
+        auto value = static_cast<uint8_t>(tag);
+        out.write(reinterpret_cast<const char*>(&value), sizeof(value));
+    }
+
+    /** @brief Write a relation reference as the name of its relation */
+    void writeRelation(const RamRelation& relation) {
+        writeString(relation.getName());
+    }
+
+    /** @brief Write a possibly absent expression */
+    void writeExpression(const RamExpression* expression) {
+        if (expression == nullptr) {
+            writeTag(Tag::Nil);
+        } else {
+            visit(*expression);
+        }
+    }
+
+    void writeExpressions(const std::vector<RamExpression*>& expressions) {
+        writeNumber(expressions.size());
+        for (const RamExpression* expression : expressions) {
+            writeExpression(expression);
+        }
+    }
+
+    /** @brief Write the optional inequality bounds of an index operation */
+    void writeRangeBounds(const RamIndexOperation& operation) {
+        writeNumber(operation.hasRangeBounds() ? 1 : 0);
+        if (operation.hasRangeBounds()) {
+            writeExpressions(operation.getRangeLowerBound());
+            writeExpressions(operation.getRangeUpperBound());
+        }
+    }
+
+    // -- expressions --
+
+    void visitTupleElement(const RamTupleElement& element) override {
+        writeTag(Tag::TupleElement);
+        writeNumber(element.getTupleId());
+        writeNumber(element.getElement());
+    }
+
+    void visitNumber(const RamNumber& number) override {
+        writeTag(Tag::Number);
+        writeNumber(static_cast<uint64_t>(static_cast<int64_t>(number.getConstant())));
+    }
+
+    void visitIntrinsicOperator(const RamIntrinsicOperator& op) override {
+        writeTag(Tag::IntrinsicOperator);
+        writeNumber(static_cast<uint64_t>(op.getOperator()));
+        writeExpressions(op.getArguments());
+    }
+
+    void visitUserDefinedOperator(const RamUserDefinedOperator& op) override {
+        writeTag(Tag::UserDefinedOperator);
+        writeString(op.getName());
+        writeString(op.getType());
+        writeExpressions(op.getArguments());
+    }
+
+    void visitAutoIncrement(const RamAutoIncrement&) override {
+        writeTag(Tag::AutoIncrement);
+    }
+
+    void visitPackRecord(const RamPackRecord& pack) override {
+        writeTag(Tag::PackRecord);
+        writeExpressions(pack.getArguments());
+    }
+
+    void visitSubroutineArgument(const RamSubroutineArgument& argument) override {
+        writeTag(Tag::SubroutineArgument);
+        writeNumber(argument.getArgument());
+    }
+
+    void visitUndefValue(const RamUndefValue&) override {
+        writeTag(Tag::UndefValue);
+    }
+
+    // -- conditions --
+
+    void visitTrue(const RamTrue&) override {
+        writeTag(Tag::True);
+    }
+
+    void visitFalse(const RamFalse&) override {
+        writeTag(Tag::False);
+    }
+
+    void visitConjunction(const RamConjunction& conjunction) override {
+        writeTag(Tag::Conjunction);
+        visit(conjunction.getLHS());
+        visit(conjunction.getRHS());
+    }
+
+    void visitNegation(const RamNegation& negation) override {
+        writeTag(Tag::Negation);
+        visit(negation.getOperand());
+    }
+
+    void visitConstraint(const RamConstraint& constraint) override {
+        writeTag(Tag::Constraint);
+        writeNumber(static_cast<uint64_t>(constraint.getOperator()));
+        visit(constraint.getLHS());
+        visit(constraint.getRHS());
+    }
+
+    void visitExistenceCheck(const RamExistenceCheck& check) override {
+        writeTag(Tag::ExistenceCheck);
+        writeRelation(check.getRelation());
+        writeExpressions(check.getValues());
+    }
+
+    void visitProvenanceExistenceCheck(const RamProvenanceExistenceCheck& check) override {
+        writeTag(Tag::ProvenanceExistenceCheck);
+        writeRelation(check.getRelation());
+        writeExpressions(check.getValues());
+    }
+
+    void visitSubsumptionCheck(const RamSubsumptionCheck& check) override {
+        writeTag(Tag::SubsumptionCheck);
+        writeRelation(check.getRelation());
+        writeExpressions(check.getValues());
+    }
+
+    void visitEmptinessCheck(const RamEmptinessCheck& check) override {
+        writeTag(Tag::EmptinessCheck);
+        writeRelation(check.getRelation());
+    }
+
+    // -- operations --
+
+    void visitScan(const RamScan& scan) override {
+        writeScan(Tag::Scan, scan);
+    }
+
+    void visitParallelScan(const RamParallelScan& scan) override {
+        writeScan(Tag::ParallelScan, scan);
+    }
+
+    void visitIndexScan(const RamIndexScan& scan) override {
+        writeIndexScan(Tag::IndexScan, scan);
+    }
+
+    void visitParallelIndexScan(const RamParallelIndexScan& scan) override {
+        writeIndexScan(Tag::ParallelIndexScan, scan);
+    }
+
+    void visitHashScan(const RamHashScan& scan) override {
+        writeIndexScan(Tag::HashScan, scan);
+    }
+
+    void visitChoice(const RamChoice& choice) override {
+        writeChoice(Tag::Choice, choice);
+    }
+
+    void visitParallelChoice(const RamParallelChoice& choice) override {
+        writeChoice(Tag::ParallelChoice, choice);
+    }
+
+    void visitIndexChoice(const RamIndexChoice& choice) override {
+        writeIndexChoice(Tag::IndexChoice, choice);
+    }
+
+    void visitParallelIndexChoice(const RamParallelIndexChoice& choice) override {
+        writeIndexChoice(Tag::ParallelIndexChoice, choice);
+    }
+
+    void visitAggregate(const RamAggregate& aggregate) override {
+        writeAggregate(Tag::Aggregate, aggregate);
+    }
+
+    void visitParallelAggregate(const RamParallelAggregate& aggregate) override {
+        writeAggregate(Tag::ParallelAggregate, aggregate);
+    }
+
+    void visitIndexAggregate(const RamIndexAggregate& aggregate) override {
+        writeTag(Tag::IndexAggregate);
+        writeRelation(aggregate.getRelation());
+        writeNumber(aggregate.getTupleId());
+        writeNumber(static_cast<uint64_t>(aggregate.getFunction()));
+        writeExpression(&aggregate.getExpression());
+        visit(aggregate.getCondition());
+        writeExpressions(aggregate.getRangePattern());
+        writeRangeBounds(aggregate);
+        visit(aggregate.getOperation());
+    }
+
+    void visitUnpackRecord(const RamUnpackRecord& unpack) override {
+        writeTag(Tag::UnpackRecord);
+        writeNumber(unpack.getTupleId());
+        writeExpression(&unpack.getExpression());
+        writeNumber(unpack.getArity());
+        visit(unpack.getOperation());
+    }
+
+    void visitFilter(const RamFilter& filter) override {
+        writeTag(Tag::Filter);
+        writeString(filter.getProfileText());
+        visit(filter.getCondition());
+        visit(filter.getOperation());
+    }
+
+    void visitBreak(const RamBreak& brk) override {
+        writeTag(Tag::Break);
+        writeString(brk.getProfileText());
+        visit(brk.getCondition());
+        visit(brk.getOperation());
+    }
+
+    void visitSplit(const RamSplit& split) override {
+        writeTag(Tag::Split);
+        const auto bodies = split.getBodies();
+        writeNumber(bodies.size());
+        for (const RamOperation* body : bodies) {
+            visit(*body);
+        }
+    }
+
+    void visitProject(const RamProject& project) override {
+        writeTag(Tag::Project);
+        writeRelation(project.getRelation());
+        writeExpressions(project.getValues());
+    }
+
+    void visitSubroutineReturnValue(const RamSubroutineReturnValue& ret) override {
+        writeTag(Tag::SubroutineReturnValue);
+        writeExpressions(ret.getValues());
+    }
+
+    // -- statements --
+
+    void visitCreate(const RamCreate& create) override {
+        writeTag(Tag::Create);
+        writeRelation(create.getRelation());
+    }
+
+    void visitLoad(const RamLoad& load) override {
+        writeTag(Tag::Load);
+        writeRelation(load.getRelation());
+        writeIODirectives(load.getIODirectives());
+    }
+
+    void visitStore(const RamStore& store) override {
+        writeTag(Tag::Store);
+        writeRelation(store.getRelation());
+        writeIODirectives(store.getIODirectives());
+    }
+
+    void visitClear(const RamClear& clear) override {
+        writeTag(Tag::Clear);
+        writeRelation(clear.getRelation());
+    }
+
+    void visitDrop(const RamDrop& drop) override {
+        writeTag(Tag::Drop);
+        writeRelation(drop.getRelation());
+    }
+
+    void visitMerge(const RamMerge& merge) override {
+        writeTag(Tag::Merge);
+        writeRelation(merge.getTargetRelation());
+        writeRelation(merge.getSourceRelation());
+    }
+
+    void visitSwap(const RamSwap& swap) override {
+        writeTag(Tag::Swap);
+        writeRelation(swap.getFirstRelation());
+        writeRelation(swap.getSecondRelation());
+    }
+
+    void visitFact(const RamFact& fact) override {
+        writeTag(Tag::Fact);
+        writeRelation(fact.getRelation());
+        writeExpressions(fact.getValues());
+    }
+
+    void visitFactTable(const RamFactTable& facts) override {
+        writeTag(Tag::FactTable);
+        writeRelation(facts.getRelation());
+        const auto& table = facts.getTable();
+        writeNumber(table.size());
+        for (const RamDomain value : table) {
+            writeNumber(static_cast<uint64_t>(static_cast<int64_t>(value)));
+        }
+    }
+
+    void visitQuery(const RamQuery& query) override {
+        writeTag(Tag::Query);
+        visit(query.getOperation());
+    }
+
+    void visitSequence(const RamSequence& sequence) override {
+        writeListStatement(Tag::Sequence, sequence);
+    }
+
+    void visitParallel(const RamParallel& parallel) override {
+        writeListStatement(Tag::Parallel, parallel);
+    }
+
+    void visitLoop(const RamLoop& loop) override {
+        writeTag(Tag::Loop);
+        visit(loop.getBody());
+    }
+
+    void visitExit(const RamExit& exit) override {
+        writeTag(Tag::Exit);
+        visit(exit.getCondition());
+    }
+
+    void visitLogRelationTimer(const RamLogRelationTimer& timer) override {
+        writeTag(Tag::LogRelationTimer);
+        writeRelation(timer.getRelation());
+        writeString(timer.getMessage());
+        visit(timer.getStatement());
+    }
+
+    void visitLogTimer(const RamLogTimer& timer) override {
+        writeTag(Tag::LogTimer);
+        writeString(timer.getMessage());
+        visit(timer.getStatement());
+    }
+
+    void visitDebugInfo(const RamDebugInfo& info) override {
+        writeTag(Tag::DebugInfo);
+        writeString(info.getMessage());
+        visit(info.getStatement());
+    }
+
+    void visitStratum(const RamStratum& stratum) override {
+        writeTag(Tag::Stratum);
+        writeNumber(stratum.getIndex());
+        visit(stratum.getBody());
+    }
+
+    void visitLogSize(const RamLogSize& size) override {
+        writeTag(Tag::LogSize);
+        writeRelation(size.getRelation());
+        writeString(size.getMessage());
+    }
+
+    void visitNode(const RamNode&) override {
+        throw std::invalid_argument("RAM program holds a construct the serializer does not support");
+    }
+
+private:
+    void writeScan(Tag tag, const RamScan& scan) {
+        writeTag(tag);
+        writeRelation(scan.getRelation());
+        writeNumber(scan.getTupleId());
+        writeString(scan.getProfileText());
+        visit(scan.getOperation());
+    }
+
+    void writeIndexScan(Tag tag, const RamIndexScan& scan) {
+        writeTag(tag);
+        writeRelation(scan.getRelation());
+        writeNumber(scan.getTupleId());
+        writeString(scan.getProfileText());
+        writeExpressions(scan.getRangePattern());
+        writeRangeBounds(scan);
+        visit(scan.getOperation());
+    }
+
+    void writeChoice(Tag tag, const RamChoice& choice) {
+        writeTag(tag);
+        writeRelation(choice.getRelation());
+        writeNumber(choice.getTupleId());
+        writeString(choice.getProfileText());
+        visit(choice.getCondition());
+        visit(choice.getOperation());
+    }
+
+    void writeIndexChoice(Tag tag, const RamIndexChoice& choice) {
+        writeTag(tag);
+        writeRelation(choice.getRelation());
+        writeNumber(choice.getTupleId());
+        writeString(choice.getProfileText());
+        visit(choice.getCondition());
+        writeExpressions(choice.getRangePattern());
+        writeRangeBounds(choice);
+        visit(choice.getOperation());
+    }
+
+    void writeAggregate(Tag tag, const RamAggregate& aggregate) {
+        writeTag(tag);
+        writeRelation(aggregate.getRelation());
+        writeNumber(aggregate.getTupleId());
+        writeNumber(static_cast<uint64_t>(aggregate.getFunction()));
+        writeExpression(&aggregate.getExpression());
+        visit(aggregate.getCondition());
+        visit(aggregate.getOperation());
+    }
+
+    void writeIODirectives(const std::vector<IODirectives>& directives) {
+        writeNumber(directives.size());
+        for (const IODirectives& cur : directives) {
+            const auto& map = cur.getDirectiveMap();
+            writeNumber(map.size());
+            for (const auto& pair : map) {
+                writeString(pair.first);
+                writeString(pair.second);
+            }
+        }
+    }
+
+    void writeListStatement(Tag tag, const RamListStatement& list) {
+        writeTag(tag);
+        const auto statements = list.getStatements();
+        writeNumber(statements.size());
+        for (const RamStatement* statement : statements) {
+            visit(*statement);
+        }
+    }
+
+    /** destination stream */
+    std::ostream& out;
+};
+
+/**
+ * Recursive-descent reader reconstructing the node tree from the tagged
+ * records; relation references are resolved against the declarations of
+ * the program under construction.
+ */
+class RamProgramReader {
+public:
+    RamProgramReader(std::istream& in, const RamProgram& program) : in(in), program(program) {}
+
+    uint64_t readNumber() {
+        uint64_t value = 0;
+        in.read(reinterpret_cast<char*>(&value), sizeof(value));
+        if (!in) {
+            fail();
+        }
+        return value;
+    }
+
+    std::string readString() {
+        std::string str(readNumber(), '\0');
+        in.read(&str[0], str.size());
+        if (!in) {
+            fail();
+        }
+        return str;
+    }
+
+    Tag readTag() {
+        uint8_t value = 0;
+        in.read(reinterpret_cast<char*>(&value), sizeof(value));
+        if (!in) {
+            fail();
+        }
+        return static_cast<Tag>(value);
+    }
+
+    std::unique_ptr<RamRelationReference> readRelationReference() {
+        const RamRelation* relation = program.getRelation(readString());
+        if (relation == nullptr) {
+            fail();
+        }
+        return std::make_unique<RamRelationReference>(relation);
+    }
+
+    std::unique_ptr<RamExpression> readExpression() {
+        switch (readTag()) {
+            case Tag::Nil:
+                return nullptr;
+            case Tag::TupleElement: {
+                auto ident = static_cast<size_t>(readNumber());
+                auto element = static_cast<size_t>(readNumber());
+                return std::make_unique<RamTupleElement>(ident, element);
+            }
+            case Tag::Number:
+                return std::make_unique<RamNumber>(
+                        static_cast<RamDomain>(static_cast<int64_t>(readNumber())));
+            case Tag::IntrinsicOperator: {
+                auto op = static_cast<FunctorOp>(readNumber());
+                return std::make_unique<RamIntrinsicOperator>(op, readExpressions());
+            }
+            case Tag::UserDefinedOperator: {
+                std::string name = readString();
+                std::string type = readString();
+                return std::make_unique<RamUserDefinedOperator>(
+                        std::move(name), std::move(type), readExpressions());
+            }
+            case Tag::AutoIncrement:
+                return std::make_unique<RamAutoIncrement>();
+            case Tag::PackRecord:
+                return std::make_unique<RamPackRecord>(readExpressions());
+            case Tag::SubroutineArgument:
+                return std::make_unique<RamSubroutineArgument>(static_cast<size_t>(readNumber()));
+            case Tag::UndefValue:
+                return std::make_unique<RamUndefValue>();
+            default:
+                fail();
+        }
+    }
+
+    std::vector<std::unique_ptr<RamExpression>> readExpressions() {
+        std::vector<std::unique_ptr<RamExpression>> expressions(readNumber());
+        for (auto& cur : expressions) {
+            cur = readExpression();
+        }
+        return expressions;
+    }
+
+    std::unique_ptr<RamCondition> readCondition() {
+        switch (readTag()) {
+            case Tag::True:
+                return std::make_unique<RamTrue>();
+            case Tag::False:
+                return std::make_unique<RamFalse>();
+            case Tag::Conjunction: {
+                auto lhs = readCondition();
+                auto rhs = readCondition();
+                return std::make_unique<RamConjunction>(std::move(lhs), std::move(rhs));
+            }
+            case Tag::Negation:
+                return std::make_unique<RamNegation>(readCondition());
+            case Tag::Constraint: {
+                auto op = static_cast<BinaryConstraintOp>(readNumber());
+                auto lhs = readExpression();
+                auto rhs = readExpression();
+                return std::make_unique<RamConstraint>(op, std::move(lhs), std::move(rhs));
+            }
+            case Tag::ExistenceCheck: {
+                auto relRef = readRelationReference();
+                return std::make_unique<RamExistenceCheck>(std::move(relRef), readExpressions());
+            }
+            case Tag::ProvenanceExistenceCheck: {
+                auto relRef = readRelationReference();
+                return std::make_unique<RamProvenanceExistenceCheck>(std::move(relRef), readExpressions());
+            }
+            case Tag::SubsumptionCheck: {
+                auto relRef = readRelationReference();
+                return std::make_unique<RamSubsumptionCheck>(std::move(relRef), readExpressions());
+            }
+            case Tag::EmptinessCheck:
+                return std::make_unique<RamEmptinessCheck>(readRelationReference());
+            default:
+                fail();
+        }
+    }
+
+    std::unique_ptr<RamOperation> readOperation() {
+        const Tag tag = readTag();
+        switch (tag) {
+            case Tag::Scan:
+            case Tag::ParallelScan: {
+                auto relRef = readRelationReference();
+                auto ident = static_cast<int>(readNumber());
+                std::string profileText = readString();
+                auto nested = readOperation();
+                if (tag == Tag::ParallelScan) {
+                    return std::make_unique<RamParallelScan>(
+                            std::move(relRef), ident, std::move(nested), std::move(profileText));
+                }
+                return std::make_unique<RamScan>(
+                        std::move(relRef), ident, std::move(nested), std::move(profileText));
+            }
+            case Tag::IndexScan:
+            case Tag::ParallelIndexScan:
+            case Tag::HashScan: {
+                auto relRef = readRelationReference();
+                auto ident = static_cast<int>(readNumber());
+                std::string profileText = readString();
+                auto pattern = readExpressions();
+                const bool hasBounds = readNumber() != 0;
+                auto lower = hasBounds ? readExpressions() : std::vector<std::unique_ptr<RamExpression>>();
+                auto upper = hasBounds ? readExpressions() : std::vector<std::unique_ptr<RamExpression>>();
+                auto nested = readOperation();
+                std::unique_ptr<RamIndexScan> scan;
+                if (tag == Tag::ParallelIndexScan) {
+                    scan = std::make_unique<RamParallelIndexScan>(std::move(relRef), ident,
+                            std::move(pattern), std::move(nested), std::move(profileText));
+                } else if (tag == Tag::HashScan) {
+                    scan = std::make_unique<RamHashScan>(std::move(relRef), ident, std::move(pattern),
+                            std::move(nested), std::move(profileText));
+                } else {
+                    scan = std::make_unique<RamIndexScan>(std::move(relRef), ident, std::move(pattern),
+                            std::move(nested), std::move(profileText));
+                }
+                if (hasBounds) {
+                    scan->setRangeBounds(std::move(lower), std::move(upper));
+                }
+                return scan;
+            }
+            case Tag::Choice:
+            case Tag::ParallelChoice: {
+                auto relRef = readRelationReference();
+                auto ident = static_cast<size_t>(readNumber());
+                std::string profileText = readString();
+                auto condition = readCondition();
+                auto nested = readOperation();
+                if (tag == Tag::ParallelChoice) {
+                    return std::make_unique<RamParallelChoice>(std::move(relRef), ident,
+                            std::move(condition), std::move(nested), std::move(profileText));
+                }
+                return std::make_unique<RamChoice>(std::move(relRef), ident, std::move(condition),
+                        std::move(nested), std::move(profileText));
+            }
+            case Tag::IndexChoice:
+            case Tag::ParallelIndexChoice: {
+                auto relRef = readRelationReference();
+                auto ident = static_cast<int>(readNumber());
+                std::string profileText = readString();
+                auto condition = readCondition();
+                auto pattern = readExpressions();
+                const bool hasBounds = readNumber() != 0;
+                auto lower = hasBounds ? readExpressions() : std::vector<std::unique_ptr<RamExpression>>();
+                auto upper = hasBounds ? readExpressions() : std::vector<std::unique_ptr<RamExpression>>();
+                auto nested = readOperation();
+                std::unique_ptr<RamIndexChoice> choice;
+                if (tag == Tag::ParallelIndexChoice) {
+                    choice = std::make_unique<RamParallelIndexChoice>(std::move(relRef), ident,
+                            std::move(condition), std::move(pattern), std::move(nested),
+                            std::move(profileText));
+                } else {
+                    choice = std::make_unique<RamIndexChoice>(std::move(relRef), ident,
+                            std::move(condition), std::move(pattern), std::move(nested),
+                            std::move(profileText));
+                }
+                if (hasBounds) {
+                    choice->setRangeBounds(std::move(lower), std::move(upper));
+                }
+                return choice;
+            }
+            case Tag::Aggregate:
+            case Tag::ParallelAggregate: {
+                auto relRef = readRelationReference();
+                auto ident = static_cast<int>(readNumber());
+                auto function = static_cast<AggregateFunction>(readNumber());
+                auto expression = readExpression();
+                auto condition = readCondition();
+                auto nested = readOperation();
+                if (tag == Tag::ParallelAggregate) {
+                    return std::make_unique<RamParallelAggregate>(std::move(nested), function,
+                            std::move(relRef), std::move(expression), std::move(condition), ident);
+                }
+                return std::make_unique<RamAggregate>(std::move(nested), function, std::move(relRef),
+                        std::move(expression), std::move(condition), ident);
+            }
+            case Tag::IndexAggregate: {
+                auto relRef = readRelationReference();
+                auto ident = static_cast<int>(readNumber());
+                auto function = static_cast<AggregateFunction>(readNumber());
+                auto expression = readExpression();
+                auto condition = readCondition();
+                auto pattern = readExpressions();
+                const bool hasBounds = readNumber() != 0;
+                auto lower = hasBounds ? readExpressions() : std::vector<std::unique_ptr<RamExpression>>();
+                auto upper = hasBounds ? readExpressions() : std::vector<std::unique_ptr<RamExpression>>();
+                auto nested = readOperation();
+                auto aggregate = std::make_unique<RamIndexAggregate>(std::move(nested), function,
+                        std::move(relRef), std::move(expression), std::move(condition), std::move(pattern),
+                        ident);
+                if (hasBounds) {
+                    aggregate->setRangeBounds(std::move(lower), std::move(upper));
+                }
+                return aggregate;
+            }
+            case Tag::UnpackRecord: {
+                auto ident = static_cast<int>(readNumber());
+                auto expression = readExpression();
+                auto arity = static_cast<size_t>(readNumber());
+                auto nested = readOperation();
+                return std::make_unique<RamUnpackRecord>(
+                        std::move(nested), ident, std::move(expression), arity);
+            }
+            case Tag::Filter:
+            case Tag::Break: {
+                std::string profileText = readString();
+                auto condition = readCondition();
+                auto nested = readOperation();
+                if (tag == Tag::Break) {
+                    return std::make_unique<RamBreak>(
+                            std::move(condition), std::move(nested), std::move(profileText));
+                }
+                return std::make_unique<RamFilter>(
+                        std::move(condition), std::move(nested), std::move(profileText));
+            }
+            case Tag::Split: {
+                std::vector<std::unique_ptr<RamOperation>> bodies(readNumber());
+                for (auto& cur : bodies) {
+                    cur = readOperation();
+                }
+                return std::make_unique<RamSplit>(std::move(bodies));
+            }
+            case Tag::Project: {
+                auto relRef = readRelationReference();
+                return std::make_unique<RamProject>(std::move(relRef), readExpressions());
+            }
+            case Tag::SubroutineReturnValue:
+                return std::make_unique<RamSubroutineReturnValue>(readExpressions());
+            default:
+                fail();
+        }
+    }
+
+    std::vector<IODirectives> readIODirectives() {
+        std::vector<IODirectives> directives(readNumber());
+        for (IODirectives& cur : directives) {
+            const uint64_t numEntries = readNumber();
+            for (uint64_t i = 0; i < numEntries; i++) {
+                std::string key = readString();
+                cur.set(key, readString());
+            }
+        }
+        return directives;
+    }
+
+    std::unique_ptr<RamStatement> readStatement() {
+        const Tag tag = readTag();
+        switch (tag) {
+            case Tag::Create:
+                return std::make_unique<RamCreate>(readRelationReference());
+            case Tag::Load: {
+                auto relRef = readRelationReference();
+                return std::make_unique<RamLoad>(std::move(relRef), readIODirectives());
+            }
+            case Tag::Store: {
+                auto relRef = readRelationReference();
+                return std::make_unique<RamStore>(std::move(relRef), readIODirectives());
+            }
+            case Tag::Clear:
+                return std::make_unique<RamClear>(readRelationReference());
+            case Tag::Drop:
+                return std::make_unique<RamDrop>(readRelationReference());
+            case Tag::Merge: {
+                auto target = readRelationReference();
+                auto source = readRelationReference();
+                return std::make_unique<RamMerge>(std::move(target), std::move(source));
+            }
+            case Tag::Swap: {
+                auto first = readRelationReference();
+                auto second = readRelationReference();
+                return std::make_unique<RamSwap>(std::move(first), std::move(second));
+            }
+            case Tag::Fact: {
+                auto relRef = readRelationReference();
+                return std::make_unique<RamFact>(std::move(relRef), readExpressions());
+            }
+            case Tag::FactTable: {
+                auto relRef = readRelationReference();
+                const uint64_t size = readNumber();
+                std::vector<RamDomain> table(size);
+                for (uint64_t i = 0; i < size; i++) {
+                    table[i] = static_cast<RamDomain>(static_cast<int64_t>(readNumber()));
+                }
+                return std::make_unique<RamFactTable>(std::move(relRef), std::move(table));
+            }
+            case Tag::Query:
+                return std::make_unique<RamQuery>(readOperation());
+            case Tag::Sequence:
+            case Tag::Parallel: {
+                std::unique_ptr<RamListStatement> list;
+                if (tag == Tag::Parallel) {
+                    list = std::make_unique<RamParallel>();
+                } else {
+                    list = std::make_unique<RamSequence>();
+                }
+                const uint64_t numStatements = readNumber();
+                for (uint64_t i = 0; i < numStatements; i++) {
+                    list->add(readStatement());
+                }
+                return list;
+            }
+            case Tag::Loop:
+                return std::make_unique<RamLoop>(readStatement());
+            case Tag::Exit:
+                return std::make_unique<RamExit>(readCondition());
+            case Tag::LogRelationTimer: {
+                auto relRef = readRelationReference();
+                std::string message = readString();
+                return std::make_unique<RamLogRelationTimer>(
+                        readStatement(), std::move(message), std::move(relRef));
+            }
+            case Tag::LogTimer: {
+                std::string message = readString();
+                return std::make_unique<RamLogTimer>(readStatement(), std::move(message));
+            }
+            case Tag::DebugInfo: {
+                std::string message = readString();
+                return std::make_unique<RamDebugInfo>(readStatement(), std::move(message));
+            }
+            case Tag::Stratum: {
+                auto index = static_cast<int>(readNumber());
+                return std::make_unique<RamStratum>(readStatement(), index);
+            }
+            case Tag::LogSize: {
+                auto relRef = readRelationReference();
+                return std::make_unique<RamLogSize>(std::move(relRef), readString());
+            }
+            default:
+                fail();
+        }
+    }
+
+private:
+    [[noreturn]] void fail() {
+        throw std::invalid_argument("Malformed serialized RAM program");
+    }
+
+    /** source stream */
+    std::istream& in;
+
+    /** program under construction, holding the relation declarations */
+    const RamProgram& program;
+};
+
+}  // namespace
+
+void RamSerializer::write(const RamProgram& program, std::ostream& out) {
+    RamProgramWriter writer(out);
+    out.write(reinterpret_cast<const char*>(&MAGIC), sizeof(MAGIC));
+    out.write(reinterpret_cast<const char*>(&VERSION), sizeof(VERSION));
+
+    const auto& relations = program.getAllRelations();
+    writer.writeNumber(relations.size());
+    for (const auto& cur : relations) {
+        const RamRelation& relation = *cur.second;
+        writer.writeString(relation.getName());
+        writer.writeNumber(relation.getArity());
+        writer.writeNumber(static_cast<uint64_t>(relation.getRepresentation()));
+        // getArg/getArgTypeQualifier pad missing entries, so the record
+        // is always arity-sized
+        for (uint32_t i = 0; i < relation.getArity(); i++) {
+            writer.writeString(relation.getArg(i));
+        }
+        for (uint32_t i = 0; i < relation.getArity(); i++) {
+            writer.writeString(relation.getArgTypeQualifier(i));
+        }
+    }
+
+    writer.visit(*program.getMain());
+
+    const auto subroutines = program.getSubroutines();
+    writer.writeNumber(subroutines.size());
+    for (const auto& cur : subroutines) {
+        writer.writeString(cur.first);
+        writer.visit(*cur.second);
+    }
+}
+
+std::unique_ptr<RamProgram> RamSerializer::read(std::istream& in) {
+    auto program = std::make_unique<RamProgram>();
+    RamProgramReader reader(in, *program);
+
+    uint32_t magic = 0;
+    uint32_t version = 0;
+    in.read(reinterpret_cast<char*>(&magic), sizeof(magic));
+    in.read(reinterpret_cast<char*>(&version), sizeof(version));
+    if (!in || magic != MAGIC || version != VERSION) {
+        throw std::invalid_argument("Malformed serialized RAM program");
+    }
+
+    const uint64_t numRelations = reader.readNumber();
+    for (uint64_t i = 0; i < numRelations; i++) {
+        std::string name = reader.readString();
+        auto arity = static_cast<size_t>(reader.readNumber());
+        auto representation = static_cast<RelationRepresentation>(reader.readNumber());
+        std::vector<std::string> attributeNames(arity);
+        for (auto& cur : attributeNames) {
+            cur = reader.readString();
+        }
+        std::vector<std::string> attributeTypeQualifiers(arity);
+        for (auto& cur : attributeTypeQualifiers) {
+            cur = reader.readString();
+        }
+        program->addRelation(std::make_unique<RamRelation>(
+                name, arity, attributeNames, attributeTypeQualifiers, representation));
+    }
+
+    program->setMain(reader.readStatement());
+
+    const uint64_t numSubroutines = reader.readNumber();
+    for (uint64_t i = 0; i < numSubroutines; i++) {
+        std::string name = reader.readString();
+        program->addSubroutine(std::move(name), reader.readStatement());
+    }
+
+    return program;
+}
+
+}  // end of namespace souffle
@@ -0,0 +1,59 @@
+/*
+ * Souffle - A Datalog Compiler
+ * Copyright (c) 2019, The Souffle Developers. All rights reserved
+ * Licensed under the Universal Permissive License v 1.0 as shown at:
+ * - https://opensource.org/licenses/UPL
+ * - <souffle root>/licenses/SOUFFLE-UPL.txt
+ */
+
+/************************************************************************
+ *
+ * @file RamSerializer.h
+ *
+ * Defines a binary serializer for RAM programs, used by the frontend
+ * cache to persist the result of parsing, AST transformation and RAM
+ * translation between runs.
+ *
+ ***********************************************************************/
+
+#pragma once
+
+#include "RamProgram.h"
+
+#include <iosfwd>
+#include <memory>
+
+namespace souffle {
+
+/**
+ * @class RamSerializer
+ * @brief Reads and writes RAM programs in a compact binary format
+ *
+ * The format is a pre-order encoding of the RAM program: the relation
+ * declarations first, followed by the main statement and the subroutines
+ * as tagged node records. Relation references are stored by relation
+ * name and re-resolved against the declarations when reading. Symbol
+ * ordinals appearing in RAM constants are not translated; a serialized
+ * program is only meaningful together with a snapshot of the symbol
+ * table it was created with (see SymbolTable::dump).
+ */
+class RamSerializer {
+public:
+    /**
+     * @brief Write the given program to the given stream
+     *
+     * Throws std::invalid_argument if the program contains a construct
+     * the serializer does not support.
+     */
+    static void write(const RamProgram& program, std::ostream& out);
+
+    /**
+     * @brief Read a program previously written by write
+     *
+     * Throws std::invalid_argument if the stream does not hold a
+     * well-formed serialized program of the current format version.
+     */
+    static std::unique_ptr<RamProgram> read(std::istream& in);
+};
+
+}  // end of namespace souffle
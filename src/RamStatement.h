@@ -451,6 +451,66 @@ protected:
     }
 };
 
+/**
+ * @class RamFactTable
+ * @brief Insert a table of constant ground facts into a relation
+ *
+ * All ground facts of a relation with constant arguments are batched
+ * into a single statement backed by a flat table of tuple values,
+ * avoiding one statement per fact.
+ *
+ * For example:
+ * ~~~~~~~~~~~~~~~~~~~~~~~~~~~
+ * INSERT TABLE (1000 TUPLES) INTO edge
+ * ~~~~~~~~~~~~~~~~~~~~~~~~~~~
+ */
+class RamFactTable : public RamRelationStatement {
+public:
+    RamFactTable(std::unique_ptr<RamRelationReference> relRef, std::vector<RamDomain> t)
+            : RamRelationStatement(std::move(relRef)), table(std::move(t)) {
+        assert(getRelation().getArity() > 0 && "nullary facts are not table-backed");
+        assert(table.size() % getRelation().getArity() == 0 && "partial tuple in fact table");
+    }
+
+    /** @brief Get the flat table of tuple values, arity values per tuple */
+    const std::vector<RamDomain>& getTable() const {
+        return table;
+    }
+
+    /** @brief Get the number of tuples stored in the table */
+    std::size_t getTupleCount() const {
+        return table.size() / getRelation().getArity();
+    }
+
+    void print(std::ostream& os, int tabpos) const override {
+        // a content digest keeps the printed form compact while still
+        // distinguishing different fact sets, e.g. for memoization keys
+        // derived from the printed program text
+        uint64_t digest = 14695981039346656037ull;
+        for (const RamDomain value : table) {
+            digest = (digest ^ static_cast<uint64_t>(value)) * 1099511628211ull;
+        }
+        os << times(" ", tabpos);
+        os << "INSERT TABLE (" << getTupleCount() << " TUPLES, DIGEST " << digest << ") INTO "
+           << getRelation().getName();
+        os << std::endl;
+    };
+
+    RamFactTable* clone() const override {
+        return new RamFactTable(std::unique_ptr<RamRelationReference>(relationRef->clone()), table);
+    }
+
+protected:
+    /** The flat table of tuple values */
+    std::vector<RamDomain> table;
+
+    bool equal(const RamNode& node) const override {
+        assert(nullptr != dynamic_cast<const RamFactTable*>(&node));
+        const auto& other = static_cast<const RamFactTable&>(node);
+        return RamRelationStatement::equal(other) && table == other.table;
+    }
+};
+
 /**
  * @class RamQuery
  * @brief A relational algebra query
@@ -475,17 +535,40 @@ public:
         return *operation;
     }
 
+    /** @brief Attach an alternative evaluation order for the same rule */
+    void addAlternative(std::unique_ptr<RamOperation> alt) {
+        assert(alt);
+        alternatives.push_back(std::move(alt));
+    }
+
+    /** @brief Get the alternative evaluation orders */
+    std::vector<RamOperation*> getAlternatives() const {
+        return toPtrVector(alternatives);
+    }
+
     void print(std::ostream& os, int tabpos) const override {
         os << times(" ", tabpos) << "QUERY" << std::endl;
         operation->print(os, tabpos + 1);
+        for (const auto& alt : alternatives) {
+            os << times(" ", tabpos) << "ALTERNATIVE" << std::endl;
+            alt->print(os, tabpos + 1);
+        }
     }
 
     std::vector<const RamNode*> getChildNodes() const override {
+        // alternatives are deliberately not exposed: they duplicate the
+        // tuple identifiers of the main operation, so per-query rewrites
+        // (e.g. tuple-id renumbering or condition hoisting) would corrupt
+        // them -- they are kept verbatim for the evaluation-time fallback
         return {operation.get()};
     }
 
     RamQuery* clone() const override {
-        return new RamQuery(std::unique_ptr<RamOperation>(operation->clone()));
+        RamQuery* res = new RamQuery(std::unique_ptr<RamOperation>(operation->clone()));
+        for (const auto& alt : alternatives) {
+            res->addAlternative(std::unique_ptr<RamOperation>(alt->clone()));
+        }
+        return res;
     }
 
     void apply(const RamNodeMapper& map) override {
@@ -496,10 +579,14 @@ protected:
     /** RAM operation */
     std::unique_ptr<RamOperation> operation;
 
+    /** Alternative orders of the same rule, tried when the chosen plan
+     * exceeds its run-time budget; hidden from mappers and visitors */
+    std::vector<std::unique_ptr<RamOperation>> alternatives;
+
     bool equal(const RamNode& node) const override {
         assert(nullptr != dynamic_cast<const RamQuery*>(&node));
         const auto& other = static_cast<const RamQuery&>(node);
-        return getOperation() == other.getOperation();
+        return getOperation() == other.getOperation() && equal_targets(alternatives, other.alternatives);
     }
 };
 
@@ -16,8 +16,11 @@
 
 #include "RamTransforms.h"
 #include "BinaryConstraintOps.h"
+#include "FunctorOps.h"
+#include "Global.h"
 #include "RamCondition.h"
 #include "RamExpression.h"
+#include "RamIndexAnalysis.h"
 #include "RamNode.h"
 #include "RamOperation.h"
 #include "RamProgram.h"
@@ -25,6 +28,11 @@
 #include "RamStatement.h"
 #include "RamTypes.h"
 #include "RamVisitor.h"
+#include "Util.h"
+#include <algorithm>
+#include <cmath>
+#include <map>
+#include <set>
 #include <utility>
 #include <vector>
 
@@ -182,6 +190,431 @@ bool HoistConditionsTransformer::hoistConditions(RamProgram& program) {
     return changed;
 }
 
+namespace {
+
+/** @brief Evaluate an intrinsic operator over constant arguments.
+ *  String operators are excluded since evaluating them requires the
+ *  symbol table; division and modulus by a constant zero are left
+ *  in place so the error surfaces at run time. */
+bool evalConstantIntrinsic(FunctorOp op, const std::vector<RamDomain>& args, RamDomain& result) {
+    switch (op) {
+        case FunctorOp::ORD:
+            result = args[0];
+            return true;
+        case FunctorOp::NEG:
+            result = -args[0];
+            return true;
+        case FunctorOp::BNOT:
+            result = ~args[0];
+            return true;
+        case FunctorOp::LNOT:
+            result = (args[0] == 0) ? 1 : 0;
+            return true;
+        case FunctorOp::ADD:
+            result = args[0] + args[1];
+            return true;
+        case FunctorOp::SUB:
+            result = args[0] - args[1];
+            return true;
+        case FunctorOp::MUL:
+            result = args[0] * args[1];
+            return true;
+        case FunctorOp::DIV:
+            if (args[1] == 0) {
+                return false;
+            }
+            result = args[0] / args[1];
+            return true;
+        case FunctorOp::EXP:
+            result = static_cast<RamDomain>(
+                    static_cast<int64_t>(std::pow(static_cast<int64_t>(args[0]), args[1])));
+            return true;
+        case FunctorOp::MOD:
+            if (args[1] == 0) {
+                return false;
+            }
+            result = args[0] % args[1];
+            return true;
+        case FunctorOp::BAND:
+            result = args[0] & args[1];
+            return true;
+        case FunctorOp::BOR:
+            result = args[0] | args[1];
+            return true;
+        case FunctorOp::BXOR:
+            result = args[0] ^ args[1];
+            return true;
+        case FunctorOp::LAND:
+            result = args[0] && args[1];
+            return true;
+        case FunctorOp::LOR:
+            result = args[0] || args[1];
+            return true;
+        case FunctorOp::MAX:
+            result = *std::max_element(args.begin(), args.end());
+            return true;
+        case FunctorOp::MIN:
+            result = *std::min_element(args.begin(), args.end());
+            return true;
+        default:
+            return false;
+    }
+}
+
+/** @brief Evaluate a numeric constraint over two constants.
+ *  String constraints are excluded since evaluating them requires the
+ *  symbol table. */
+bool evalConstantConstraint(BinaryConstraintOp op, RamDomain lhs, RamDomain rhs, bool& result) {
+    switch (op) {
+        case BinaryConstraintOp::EQ:
+            result = lhs == rhs;
+            return true;
+        case BinaryConstraintOp::NE:
+            result = lhs != rhs;
+            return true;
+        case BinaryConstraintOp::LT:
+            result = lhs < rhs;
+            return true;
+        case BinaryConstraintOp::LE:
+            result = lhs <= rhs;
+            return true;
+        case BinaryConstraintOp::GT:
+            result = lhs > rhs;
+            return true;
+        case BinaryConstraintOp::GE:
+            result = lhs >= rhs;
+            return true;
+        default:
+            return false;
+    }
+}
+
+/** @brief Whether dropping the expression changes program behaviour.
+ *  Counters advance on every evaluation and user-defined functors may
+ *  carry side effects, so neither may be eliminated. */
+bool isDroppableExpression(const RamExpression& expr) {
+    bool droppable = true;
+    visitDepthFirst(expr, [&](const RamNode& node) {
+        if (dynamic_cast<const RamAutoIncrement*>(&node) != nullptr ||
+                dynamic_cast<const RamUserDefinedOperator*>(&node) != nullptr) {
+            droppable = false;
+        }
+    });
+    return droppable;
+}
+
+/** @brief Strength-reduce affine operator chains with constant operands.
+ *
+ *  Rewrites that make a single constant-folding pass collapse chains
+ *  like ((x + 1) + 2) - 3 to one operation per tuple:
+ *  constants commute to the right operand, a subtraction of a constant
+ *  becomes an addition, adjacent constants of chained additions or
+ *  multiplications merge, and identity or absorbing constants drop the
+ *  operation altogether. All arithmetic is two's complement, so the
+ *  re-association yields the values the original chain computes.
+ *
+ *  Returns the reduced expression, or nullptr if no rule applies. */
+std::unique_ptr<RamExpression> reduceAffineChain(const RamIntrinsicOperator& op) {
+    const auto& args = op.getArguments();
+    const FunctorOp opcode = op.getOperator();
+    if (args.size() != 2 ||
+            (opcode != FunctorOp::ADD && opcode != FunctorOp::SUB && opcode != FunctorOp::MUL)) {
+        return nullptr;
+    }
+    const auto* lhsNum = dynamic_cast<const RamNumber*>(args[0]);
+    const auto* rhsNum = dynamic_cast<const RamNumber*>(args[1]);
+
+    auto makeBinary = [](FunctorOp o, std::unique_ptr<RamExpression> a, std::unique_ptr<RamExpression> b) {
+        std::vector<std::unique_ptr<RamExpression>> newArgs;
+        newArgs.push_back(std::move(a));
+        newArgs.push_back(std::move(b));
+        return std::make_unique<RamIntrinsicOperator>(o, std::move(newArgs));
+    };
+
+    // x - c becomes x + (-c), joining the addition chains
+    if (opcode == FunctorOp::SUB && rhsNum != nullptr && lhsNum == nullptr) {
+        return makeBinary(FunctorOp::ADD, std::unique_ptr<RamExpression>(args[0]->clone()),
+                std::make_unique<RamNumber>(-rhsNum->getConstant()));
+    }
+
+    if (opcode == FunctorOp::SUB) {
+        return nullptr;
+    }
+
+    // c + x and c * x commute the constant to the right
+    if (lhsNum != nullptr && rhsNum == nullptr) {
+        return makeBinary(opcode, std::unique_ptr<RamExpression>(args[1]->clone()),
+                std::make_unique<RamNumber>(lhsNum->getConstant()));
+    }
+
+    if (rhsNum == nullptr) {
+        return nullptr;
+    }
+
+    // identity constants drop the operation
+    if ((opcode == FunctorOp::ADD && rhsNum->getConstant() == 0) ||
+            (opcode == FunctorOp::MUL && rhsNum->getConstant() == 1)) {
+        return std::unique_ptr<RamExpression>(args[0]->clone());
+    }
+
+    // a multiplication by zero is the constant zero
+    if (opcode == FunctorOp::MUL && rhsNum->getConstant() == 0 && isDroppableExpression(*args[0])) {
+        return std::make_unique<RamNumber>(0);
+    }
+
+    // (x + c1) + c2 becomes x + (c1 + c2); likewise for multiplication
+    if (const auto* inner = dynamic_cast<const RamIntrinsicOperator*>(args[0])) {
+        if (inner->getOperator() == opcode && inner->getArguments().size() == 2) {
+            const auto* innerLhsNum = dynamic_cast<const RamNumber*>(inner->getArguments()[0]);
+            const auto* innerRhsNum = dynamic_cast<const RamNumber*>(inner->getArguments()[1]);
+            if (innerRhsNum != nullptr && innerLhsNum == nullptr) {
+                const RamDomain merged = opcode == FunctorOp::ADD
+                                                 ? innerRhsNum->getConstant() + rhsNum->getConstant()
+                                                 : innerRhsNum->getConstant() * rhsNum->getConstant();
+                return makeBinary(opcode,
+                        std::unique_ptr<RamExpression>(inner->getArguments()[0]->clone()),
+                        std::make_unique<RamNumber>(merged));
+            }
+        }
+    }
+
+    return nullptr;
+}
+
+}  // namespace
+
+bool ConstantPropagationTransformer::propagateConstants(RamProgram& program) {
+    // flag to determine whether the RAM program has changed
+    bool changed = false;
+
+    // fold constant expressions and conditions bottom-up, so that
+    // chains of constant operations collapse in a single pass
+    visitDepthFirst(program, [&](const RamQuery& query) {
+        std::function<std::unique_ptr<RamNode>(std::unique_ptr<RamNode>)> constRewriter =
+                [&](std::unique_ptr<RamNode> node) -> std::unique_ptr<RamNode> {
+            // rewrite sub-trees first so that operands are already folded
+            node->apply(makeLambdaRamMapper(constRewriter));
+            if (auto* intrinsic = dynamic_cast<RamIntrinsicOperator*>(node.get())) {
+                std::vector<RamDomain> args;
+                bool allConstant = true;
+                for (const RamExpression* arg : intrinsic->getArguments()) {
+                    if (const auto* num = dynamic_cast<const RamNumber*>(arg)) {
+                        args.push_back(num->getConstant());
+                    } else {
+                        allConstant = false;
+                        break;
+                    }
+                }
+                RamDomain result;
+                if (allConstant && evalConstantIntrinsic(intrinsic->getOperator(), args, result)) {
+                    changed = true;
+                    return std::make_unique<RamNumber>(result);
+                }
+                // strength-reduce affine chains; rewriting the reduced
+                // expression once more merges constants the rule made
+                // adjacent, so each chain collapses in a single pass
+                if (auto reduced = reduceAffineChain(*intrinsic)) {
+                    changed = true;
+                    return constRewriter(std::move(reduced));
+                }
+            } else if (auto* constraint = dynamic_cast<RamConstraint*>(node.get())) {
+                const auto* lhs = dynamic_cast<const RamNumber*>(&constraint->getLHS());
+                const auto* rhs = dynamic_cast<const RamNumber*>(&constraint->getRHS());
+                bool result;
+                if (lhs != nullptr && rhs != nullptr &&
+                        evalConstantConstraint(
+                                constraint->getOperator(), lhs->getConstant(), rhs->getConstant(), result)) {
+                    changed = true;
+                    if (result) {
+                        return std::make_unique<RamTrue>();
+                    }
+                    return std::make_unique<RamFalse>();
+                }
+            } else if (auto* conjunction = dynamic_cast<RamConjunction*>(node.get())) {
+                if (dynamic_cast<const RamTrue*>(&conjunction->getLHS()) != nullptr) {
+                    changed = true;
+                    return std::unique_ptr<RamCondition>(conjunction->getRHS().clone());
+                }
+                if (dynamic_cast<const RamTrue*>(&conjunction->getRHS()) != nullptr) {
+                    changed = true;
+                    return std::unique_ptr<RamCondition>(conjunction->getLHS().clone());
+                }
+                if (dynamic_cast<const RamFalse*>(&conjunction->getLHS()) != nullptr ||
+                        dynamic_cast<const RamFalse*>(&conjunction->getRHS()) != nullptr) {
+                    changed = true;
+                    return std::make_unique<RamFalse>();
+                }
+            } else if (auto* negation = dynamic_cast<RamNegation*>(node.get())) {
+                if (dynamic_cast<const RamTrue*>(&negation->getOperand()) != nullptr) {
+                    changed = true;
+                    return std::make_unique<RamFalse>();
+                }
+                if (dynamic_cast<const RamFalse*>(&negation->getOperand()) != nullptr) {
+                    changed = true;
+                    return std::make_unique<RamTrue>();
+                }
+            } else if (auto* filter = dynamic_cast<RamFilter*>(node.get())) {
+                // a condition that folded to true is established once and
+                // for all; the guard can be removed entirely
+                if (dynamic_cast<const RamTrue*>(&filter->getCondition()) != nullptr) {
+                    changed = true;
+                    return std::unique_ptr<RamOperation>(filter->getOperation().clone());
+                }
+            }
+            return node;
+        };
+        const_cast<RamQuery*>(&query)->apply(makeLambdaRamMapper(constRewriter));
+    });
+
+    // remove filter operations whose existence check is already
+    // established by an enclosing filter in the same loop nest
+    visitDepthFirst(program, [&](const RamQuery& query) {
+        std::set<std::string> established;
+        std::function<std::unique_ptr<RamNode>(std::unique_ptr<RamNode>)> dedupRewriter =
+                [&](std::unique_ptr<RamNode> node) -> std::unique_ptr<RamNode> {
+            if (auto* filter = dynamic_cast<RamFilter*>(node.get())) {
+                if (const auto* exists = dynamic_cast<const RamExistenceCheck*>(&filter->getCondition())) {
+                    std::string repr = toString(*exists);
+                    if (established.count(repr) != 0) {
+                        changed = true;
+                        auto nestedOp = std::unique_ptr<RamOperation>(filter->getOperation().clone());
+                        return dedupRewriter(std::move(nestedOp));
+                    }
+                    // the check only holds for the nested scope of the filter
+                    established.insert(repr);
+                    node->apply(makeLambdaRamMapper(dedupRewriter));
+                    established.erase(repr);
+                    return node;
+                }
+            }
+            node->apply(makeLambdaRamMapper(dedupRewriter));
+            return node;
+        };
+        const_cast<RamQuery*>(&query)->apply(makeLambdaRamMapper(dedupRewriter));
+    });
+    return changed;
+}
+
+bool EqualityCompressionTransformer::compressEqualities(RamProgram& program) {
+    // flag to determine whether the RAM program has changed
+    bool changed = false;
+
+    visitDepthFirst(program, [&](const RamQuery& query) {
+        // union-find over the printed representation of expressions;
+        // parent chains are never compressed so that a union can be
+        // undone when leaving the scope of the establishing filter
+        std::map<std::string, std::string> parent;
+
+        // owned prototype of each term, used to materialize the
+        // canonical representative of a class
+        std::map<std::string, std::unique_ptr<RamExpression>> terms;
+
+        std::function<std::string(std::string)> find = [&](std::string key) -> std::string {
+            auto pos = parent.find(key);
+            while (pos != parent.end()) {
+                key = pos->second;
+                pos = parent.find(key);
+            }
+            return key;
+        };
+
+        auto addTerm = [&](const RamExpression& expr) -> std::string {
+            std::string key = toString(expr);
+            if (terms.find(key) == terms.end()) {
+                terms[key] = std::unique_ptr<RamExpression>(expr.clone());
+            }
+            return key;
+        };
+
+        // constants make the best representatives, followed by the
+        // element of the outermost tuple; complex expressions are never
+        // substituted for an element
+        auto isPreferred = [&](const std::string& a, const std::string& b) -> bool {
+            const RamExpression* exprA = terms[a].get();
+            const RamExpression* exprB = terms[b].get();
+            const auto* numA = dynamic_cast<const RamNumber*>(exprA);
+            const auto* numB = dynamic_cast<const RamNumber*>(exprB);
+            if ((numA != nullptr) != (numB != nullptr)) {
+                return numA != nullptr;
+            }
+            const auto* elemA = dynamic_cast<const RamTupleElement*>(exprA);
+            const auto* elemB = dynamic_cast<const RamTupleElement*>(exprB);
+            if ((elemA != nullptr) != (elemB != nullptr)) {
+                return elemA != nullptr;
+            }
+            if (elemA != nullptr && elemB != nullptr) {
+                return std::make_pair(elemA->getTupleId(), elemA->getElement()) <
+                       std::make_pair(elemB->getTupleId(), elemB->getElement());
+            }
+            return a < b;
+        };
+
+        std::function<std::unique_ptr<RamNode>(std::unique_ptr<RamNode>)> equalityRewriter =
+                [&](std::unique_ptr<RamNode> node) -> std::unique_ptr<RamNode> {
+            // replace an element reference by the representative of its class
+            if (auto* element = dynamic_cast<RamTupleElement*>(node.get())) {
+                std::string root = find(toString(*element));
+                auto pos = terms.find(root);
+                if (pos != terms.end() && root != toString(*element)) {
+                    changed = true;
+                    return std::unique_ptr<RamNode>(pos->second->clone());
+                }
+                return node;
+            }
+
+            if (auto* filter = dynamic_cast<RamFilter*>(node.get())) {
+                const auto* constraint = dynamic_cast<const RamConstraint*>(&filter->getCondition());
+                if (constraint != nullptr && constraint->getOperator() == BinaryConstraintOp::EQ) {
+                    // canonicalize both operands w.r.t. the enclosing equalities
+                    auto lhsNode = equalityRewriter(
+                            std::unique_ptr<RamNode>(constraint->getLHS().clone()));
+                    auto rhsNode = equalityRewriter(
+                            std::unique_ptr<RamNode>(constraint->getRHS().clone()));
+                    auto lhs = std::unique_ptr<RamExpression>(
+                            dynamic_cast<RamExpression*>(lhsNode.release()));
+                    auto rhs = std::unique_ptr<RamExpression>(
+                            dynamic_cast<RamExpression*>(rhsNode.release()));
+
+                    std::string lhsRoot = find(addTerm(*lhs));
+                    std::string rhsRoot = find(addTerm(*rhs));
+
+                    // the equality is already established; drop the filter
+                    if (lhsRoot == rhsRoot) {
+                        changed = true;
+                        auto nestedOp = std::unique_ptr<RamOperation>(filter->getOperation().clone());
+                        return equalityRewriter(std::move(nestedOp));
+                    }
+
+                    // establish the equality for the nested scope
+                    std::string undoKey;
+                    if (isPreferred(lhsRoot, rhsRoot)) {
+                        parent[rhsRoot] = lhsRoot;
+                        undoKey = rhsRoot;
+                    } else {
+                        parent[lhsRoot] = rhsRoot;
+                        undoKey = lhsRoot;
+                    }
+
+                    auto nestedNode = equalityRewriter(
+                            std::unique_ptr<RamNode>(filter->getOperation().clone()));
+                    parent.erase(undoKey);
+
+                    return std::make_unique<RamFilter>(
+                            std::make_unique<RamConstraint>(
+                                    BinaryConstraintOp::EQ, std::move(lhs), std::move(rhs)),
+                            std::unique_ptr<RamOperation>(
+                                    dynamic_cast<RamOperation*>(nestedNode.release())),
+                            filter->getProfileText());
+                }
+            }
+            node->apply(makeLambdaRamMapper(equalityRewriter));
+            return node;
+        };
+        const_cast<RamQuery*>(&query)->apply(makeLambdaRamMapper(equalityRewriter));
+    });
+    return changed;
+}
+
 std::unique_ptr<RamExpression> MakeIndexTransformer::getExpression(
         RamCondition* c, size_t& element, int identifier) {
     if (auto* binRelOp = dynamic_cast<RamConstraint*>(c)) {
@@ -205,9 +638,46 @@ std::unique_ptr<RamExpression> MakeIndexTransformer::getExpression(
     return nullptr;
 }
 
-std::unique_ptr<RamCondition> MakeIndexTransformer::constructPattern(
-        std::vector<std::unique_ptr<RamExpression>>& queryPattern, bool& indexable,
+std::unique_ptr<RamExpression> MakeIndexTransformer::getBoundExpression(
+        RamCondition* c, size_t& element, bool& isLowerBound, int identifier) {
+    if (auto* binRelOp = dynamic_cast<RamConstraint*>(c)) {
+        const BinaryConstraintOp op = binRelOp->getOperator();
+        if (op != BinaryConstraintOp::LT && op != BinaryConstraintOp::LE &&
+                op != BinaryConstraintOp::GT && op != BinaryConstraintOp::GE) {
+            return nullptr;
+        }
+        if (const auto* lhs = dynamic_cast<const RamTupleElement*>(&binRelOp->getLHS())) {
+            const RamExpression* rhs = &binRelOp->getRHS();
+            if (lhs->getTupleId() == identifier && rla->getLevel(rhs) < identifier) {
+                element = lhs->getElement();
+                // t.x > <expr> / t.x >= <expr> restricts the element from below
+                isLowerBound = (op == BinaryConstraintOp::GT || op == BinaryConstraintOp::GE);
+                return std::unique_ptr<RamExpression>(rhs->clone());
+            }
+        }
+        if (const auto* rhs = dynamic_cast<const RamTupleElement*>(&binRelOp->getRHS())) {
+            const RamExpression* lhs = &binRelOp->getLHS();
+            if (rhs->getTupleId() == identifier && rla->getLevel(lhs) < identifier) {
+                element = rhs->getElement();
+                // <expr> < t.x / <expr> <= t.x restricts the element from below
+                isLowerBound = (op == BinaryConstraintOp::LT || op == BinaryConstraintOp::LE);
+                return std::unique_ptr<RamExpression>(lhs->clone());
+            }
+        }
+    }
+    return nullptr;
+}
+
+std::unique_ptr<RamCondition> MakeIndexTransformer::constructPattern(const RamRelation& rel,
+        std::vector<std::unique_ptr<RamExpression>>& queryPattern,
+        std::vector<std::unique_ptr<RamExpression>>& rangeLower,
+        std::vector<std::unique_ptr<RamExpression>>& rangeUpper, bool& indexable,
         std::vector<std::unique_ptr<RamCondition>> conditionList, int identifier) {
+    // Range bounds are only supported by the ordered b-tree indices
+    const bool rangeIndexable = rel.getRepresentation() != RelationRepresentation::BRIE &&
+                                rel.getRepresentation() != RelationRepresentation::EQREL &&
+                                rel.getRepresentation() != RelationRepresentation::GROUPED;
+
     // Remaining conditions which cannot be handled by an index
     std::unique_ptr<RamCondition> condition;
     auto addCondition = [&](std::unique_ptr<RamCondition> c) {
@@ -221,6 +691,7 @@ std::unique_ptr<RamCondition> MakeIndexTransformer::constructPattern(
     // Build query pattern and remaining condition
     for (auto& cond : conditionList) {
         size_t element = 0;
+        bool isLowerBound = false;
         if (std::unique_ptr<RamExpression> value = getExpression(cond.get(), element, identifier)) {
             if (queryPattern[element] == nullptr) {
                 indexable = true;
@@ -229,12 +700,37 @@ std::unique_ptr<RamCondition> MakeIndexTransformer::constructPattern(
                 addCondition(std::make_unique<RamConstraint>(BinaryConstraintOp::EQ, std::move(value),
                         std::unique_ptr<RamExpression>(queryPattern[element]->clone())));
             }
-        } else {
-            addCondition(std::move(cond));
+            continue;
+        }
+        if (rangeIndexable) {
+            if (std::unique_ptr<RamExpression> bound =
+                            getBoundExpression(cond.get(), element, isLowerBound, identifier)) {
+                auto& slot = isLowerBound ? rangeLower[element] : rangeUpper[element];
+                if (slot == nullptr) {
+                    slot = std::move(bound);
+                }
+                // the inequality always remains as a filter; the attached
+                // bound is inclusive and merely prunes the scanned range
+                addCondition(std::move(cond));
+                continue;
+            }
         }
+        addCondition(std::move(cond));
     }
 
-    // Avoid null-pointers for condition and query pattern
+    // a column constrained by equality needs no additional bounds
+    bool hasBounds = false;
+    for (size_t i = 0; i < queryPattern.size(); i++) {
+        if (queryPattern[i] != nullptr) {
+            rangeLower[i] = nullptr;
+            rangeUpper[i] = nullptr;
+        }
+        if (rangeLower[i] != nullptr || rangeUpper[i] != nullptr) {
+            hasBounds = true;
+        }
+    }
+
+    // Avoid null-pointers for condition, query pattern, and bounds
     if (condition == nullptr) {
         condition = std::make_unique<RamTrue>();
     }
@@ -244,23 +740,72 @@ std::unique_ptr<RamCondition> MakeIndexTransformer::constructPattern(
             p = std::make_unique<RamUndefValue>();
         }
     }
+
+    if (hasBounds) {
+        indexable = true;
+        for (auto& p : rangeLower) {
+            if (p == nullptr) {
+                p = std::make_unique<RamUndefValue>();
+            }
+        }
+        for (auto& p : rangeUpper) {
+            if (p == nullptr) {
+                p = std::make_unique<RamUndefValue>();
+            }
+        }
+    } else {
+        rangeLower.clear();
+        rangeUpper.clear();
+    }
+    return condition;
+}
+
+std::unique_ptr<RamCondition> MakeIndexTransformer::addEqualityFilters(
+        std::unique_ptr<RamCondition> condition,
+        const std::vector<std::unique_ptr<RamExpression>>& queryPattern, int identifier) {
+    for (size_t i = 0; i < queryPattern.size(); i++) {
+        if (!isRamUndefValue(queryPattern[i].get())) {
+            auto eq = std::make_unique<RamConstraint>(BinaryConstraintOp::EQ,
+                    std::make_unique<RamTupleElement>(identifier, i),
+                    std::unique_ptr<RamExpression>(queryPattern[i]->clone()));
+            if (isRamTrue(condition.get())) {
+                condition = std::move(eq);
+            } else {
+                condition = std::make_unique<RamConjunction>(std::move(condition), std::move(eq));
+            }
+        }
+    }
     return condition;
 }
 
 std::unique_ptr<RamOperation> MakeIndexTransformer::rewriteAggregate(const RamAggregate* agg) {
     if (dynamic_cast<const RamTrue*>(&agg->getCondition()) == nullptr) {
         const RamRelation& rel = agg->getRelation();
+        // indexing a small relation does not pay off; see rewriteScan
+        if (rca->hasEstimate(rel) &&
+                rca->getEstimate(rel) <= RamCardinalityAnalysis::smallRelationThreshold) {
+            return nullptr;
+        }
         int identifier = agg->getTupleId();
         std::vector<std::unique_ptr<RamExpression>> queryPattern(rel.getArity());
+        std::vector<std::unique_ptr<RamExpression>> rangeLower(rel.getArity());
+        std::vector<std::unique_ptr<RamExpression>> rangeUpper(rel.getArity());
         bool indexable = false;
-        std::unique_ptr<RamCondition> condition = constructPattern(
-                queryPattern, indexable, toConjunctionList(&agg->getCondition()), identifier);
+        std::unique_ptr<RamCondition> condition = constructPattern(rel, queryPattern, rangeLower,
+                rangeUpper, indexable, toConjunctionList(&agg->getCondition()), identifier);
         if (indexable) {
-            return std::make_unique<RamIndexAggregate>(
+            if (!rangeLower.empty()) {
+                condition = addEqualityFilters(std::move(condition), queryPattern, identifier);
+            }
+            auto iagg = std::make_unique<RamIndexAggregate>(
                     std::unique_ptr<RamOperation>(agg->getOperation().clone()), agg->getFunction(),
                     std::make_unique<RamRelationReference>(&rel),
                     std::unique_ptr<RamExpression>(agg->getExpression().clone()), std::move(condition),
                     std::move(queryPattern), agg->getTupleId());
+            if (!rangeLower.empty()) {
+                iagg->setRangeBounds(std::move(rangeLower), std::move(rangeUpper));
+            }
+            return std::move(iagg);
         }
     }
     return nullptr;
@@ -269,18 +814,33 @@ std::unique_ptr<RamOperation> MakeIndexTransformer::rewriteAggregate(const RamAg
 std::unique_ptr<RamOperation> MakeIndexTransformer::rewriteScan(const RamScan* scan) {
     if (const auto* filter = dynamic_cast<const RamFilter*>(&scan->getOperation())) {
         const RamRelation& rel = scan->getRelation();
+        // for a relation of a handful of tuples a sequential scan is as
+        // cheap as an index lookup; keep the scan and spare the index
+        if (rca->hasEstimate(rel) &&
+                rca->getEstimate(rel) <= RamCardinalityAnalysis::smallRelationThreshold) {
+            return nullptr;
+        }
         const int identifier = scan->getTupleId();
         std::vector<std::unique_ptr<RamExpression>> queryPattern(rel.getArity());
+        std::vector<std::unique_ptr<RamExpression>> rangeLower(rel.getArity());
+        std::vector<std::unique_ptr<RamExpression>> rangeUpper(rel.getArity());
         bool indexable = false;
-        std::unique_ptr<RamCondition> condition = constructPattern(
-                queryPattern, indexable, toConjunctionList(&filter->getCondition()), identifier);
+        std::unique_ptr<RamCondition> condition = constructPattern(rel, queryPattern, rangeLower,
+                rangeUpper, indexable, toConjunctionList(&filter->getCondition()), identifier);
         if (indexable) {
+            if (!rangeLower.empty()) {
+                condition = addEqualityFilters(std::move(condition), queryPattern, identifier);
+            }
             std::unique_ptr<RamOperation> op = std::unique_ptr<RamOperation>(filter->getOperation().clone());
             if (!isRamTrue(condition.get())) {
                 op = std::make_unique<RamFilter>(std::move(condition), std::move(op));
             }
-            return std::make_unique<RamIndexScan>(std::make_unique<RamRelationReference>(&rel), identifier,
-                    std::move(queryPattern), std::move(op), scan->getProfileText());
+            auto iscan = std::make_unique<RamIndexScan>(std::make_unique<RamRelationReference>(&rel),
+                    identifier, std::move(queryPattern), std::move(op), scan->getProfileText());
+            if (!rangeLower.empty()) {
+                iscan->setRangeBounds(std::move(rangeLower), std::move(rangeUpper));
+            }
+            return std::move(iscan);
         }
     }
     return nullptr;
@@ -291,11 +851,17 @@ std::unique_ptr<RamOperation> MakeIndexTransformer::rewriteIndexScan(const RamIn
         const RamRelation& rel = iscan->getRelation();
         const int identifier = iscan->getTupleId();
         std::vector<std::unique_ptr<RamExpression>> queryPattern(rel.getArity());
+        std::vector<std::unique_ptr<RamExpression>> rangeLower(rel.getArity());
+        std::vector<std::unique_ptr<RamExpression>> rangeUpper(rel.getArity());
         bool indexable = false;
-        std::unique_ptr<RamCondition> condition = constructPattern(
-                queryPattern, indexable, toConjunctionList(&filter->getCondition()), identifier);
+        std::unique_ptr<RamCondition> condition = constructPattern(rel, queryPattern, rangeLower,
+                rangeUpper, indexable, toConjunctionList(&filter->getCondition()), identifier);
         if (indexable) {
-            // Merge Index Pattern here
+            // Merge Index Pattern here; the rewrite is only performed if the
+            // merged result actually extends the previous scan, since the
+            // retained inequality filters would otherwise be re-discovered
+            // over and over again
+            bool extended = false;
             const auto prevPattern = iscan->getRangePattern();
             auto addCondition = [&](std::unique_ptr<RamCondition> c) {
                 if (condition != nullptr) {
@@ -305,25 +871,81 @@ std::unique_ptr<RamOperation> MakeIndexTransformer::rewriteIndexScan(const RamIn
                 }
             };
             for (std::size_t i = 0; i < rel.getArity(); i++) {
-                if (prevPattern[i] != nullptr) {
-                    if (queryPattern[i] == nullptr) {
-                        // found a new indexable attribute
+                if (!isRamUndefValue(prevPattern[i])) {
+                    if (isRamUndefValue(queryPattern[i].get())) {
                         queryPattern[i] = std::unique_ptr<RamExpression>(prevPattern[i]->clone());
-                    } else {
+                    } else if (!(*prevPattern[i] == *queryPattern[i])) {
                         // found a new constraint that is not dependent on the current scan level
                         // and can be hoisted in a later transformation.
                         addCondition(std::make_unique<RamConstraint>(BinaryConstraintOp::EQ,
                                 std::unique_ptr<RamExpression>(prevPattern[i]->clone()),
                                 std::unique_ptr<RamExpression>(queryPattern[i]->clone())));
+                        extended = true;
                     }
+                } else if (!isRamUndefValue(queryPattern[i].get())) {
+                    // found a new indexable attribute
+                    extended = true;
                 }
             }
+            // merge the inequality bounds of the previous scan; a column that
+            // is now constrained by equality needs no bounds anymore
+            const auto prevLower = iscan->getRangeLowerBound();
+            const auto prevUpper = iscan->getRangeUpperBound();
+            if (rangeLower.empty() && !prevLower.empty()) {
+                for (std::size_t i = 0; i < rel.getArity(); i++) {
+                    rangeLower.push_back(std::make_unique<RamUndefValue>());
+                    rangeUpper.push_back(std::make_unique<RamUndefValue>());
+                }
+            }
+            for (std::size_t i = 0; i < rangeLower.size(); i++) {
+                if (!isRamUndefValue(queryPattern[i].get())) {
+                    rangeLower[i] = std::make_unique<RamUndefValue>();
+                    rangeUpper[i] = std::make_unique<RamUndefValue>();
+                    continue;
+                }
+                const bool prevHasLower = !prevLower.empty() && !isRamUndefValue(prevLower[i]);
+                const bool prevHasUpper = !prevUpper.empty() && !isRamUndefValue(prevUpper[i]);
+                if (!isRamUndefValue(rangeLower[i].get()) && !prevHasLower) {
+                    extended = true;
+                }
+                if (!isRamUndefValue(rangeUpper[i].get()) && !prevHasUpper) {
+                    extended = true;
+                }
+                // an already established bound takes precedence
+                if (prevHasLower) {
+                    rangeLower[i] = std::unique_ptr<RamExpression>(prevLower[i]->clone());
+                }
+                if (prevHasUpper) {
+                    rangeUpper[i] = std::unique_ptr<RamExpression>(prevUpper[i]->clone());
+                }
+            }
+            // drop the bounds entirely if none of them is defined
+            bool hasBounds = false;
+            for (std::size_t i = 0; i < rangeLower.size(); i++) {
+                if (!isRamUndefValue(rangeLower[i].get()) || !isRamUndefValue(rangeUpper[i].get())) {
+                    hasBounds = true;
+                }
+            }
+            if (!hasBounds) {
+                rangeLower.clear();
+                rangeUpper.clear();
+            }
+            if (!extended) {
+                return nullptr;
+            }
+            if (!rangeLower.empty()) {
+                condition = addEqualityFilters(std::move(condition), queryPattern, identifier);
+            }
             std::unique_ptr<RamOperation> op = std::unique_ptr<RamOperation>(filter->getOperation().clone());
             if (!isRamTrue(condition.get())) {
                 op = std::make_unique<RamFilter>(std::move(condition), std::move(op));
             }
-            return std::make_unique<RamIndexScan>(std::make_unique<RamRelationReference>(&rel), identifier,
-                    std::move(queryPattern), std::move(op), iscan->getProfileText());
+            auto res = std::make_unique<RamIndexScan>(std::make_unique<RamRelationReference>(&rel),
+                    identifier, std::move(queryPattern), std::move(op), iscan->getProfileText());
+            if (!rangeLower.empty()) {
+                res->setRangeBounds(std::move(rangeLower), std::move(rangeUpper));
+            }
+            return std::move(res);
         }
     }
     return nullptr;
@@ -416,6 +1038,13 @@ bool IfConversionTransformer::convertIndexScans(RamProgram& program) {
 }
 
 std::unique_ptr<RamOperation> ChoiceConversionTransformer::rewriteScan(const RamScan* scan) {
+    // the early exit of a choice cannot save noticeable work on a
+    // relation of a handful of tuples; keep the canonical scan form
+    if (rca->hasEstimate(scan->getRelation()) &&
+            rca->getEstimate(scan->getRelation()) <= RamCardinalityAnalysis::smallRelationThreshold) {
+        return nullptr;
+    }
+
     bool transformTuple = false;
 
     // Check that RamFilter follows the Scan in the loop nest
@@ -449,6 +1078,13 @@ std::unique_ptr<RamOperation> ChoiceConversionTransformer::rewriteScan(const Ram
 }
 
 std::unique_ptr<RamOperation> ChoiceConversionTransformer::rewriteIndexScan(const RamIndexScan* indexScan) {
+    // see rewriteScan for the cardinality-based gate
+    if (rca->hasEstimate(indexScan->getRelation()) &&
+            rca->getEstimate(indexScan->getRelation()) <=
+                    RamCardinalityAnalysis::smallRelationThreshold) {
+        return nullptr;
+    }
+
     bool transformTuple = false;
 
     // Check that RamFilter follows the IndexScan in the loop nest
@@ -483,9 +1119,12 @@ std::unique_ptr<RamOperation> ChoiceConversionTransformer::rewriteIndexScan(cons
             newValues.emplace_back(val);
         }
 
-        return std::make_unique<RamIndexChoice>(std::make_unique<RamRelationReference>(&rel), identifier,
-                std::unique_ptr<RamCondition>(filter->getCondition().clone()), std::move(newValues),
-                std::unique_ptr<RamOperation>(filter->getOperation().clone()), indexScan->getProfileText());
+        auto res = std::make_unique<RamIndexChoice>(std::make_unique<RamRelationReference>(&rel),
+                identifier, std::unique_ptr<RamCondition>(filter->getCondition().clone()),
+                std::move(newValues), std::unique_ptr<RamOperation>(filter->getOperation().clone()),
+                indexScan->getProfileText());
+        res->copyRangeBounds(*indexScan);
+        return std::move(res);
     }
     return nullptr;
 }
@@ -516,69 +1155,889 @@ bool ChoiceConversionTransformer::convertScans(RamProgram& program) {
     return changed;
 }
 
-bool TupleIdTransformer::reorderOperations(RamProgram& program) {
-    // flag to determine whether the RAM program has changed
+bool ScanOrderTransformer::orderScans(RamProgram& program) {
     bool changed = false;
-
     visitDepthFirst(program, [&](const RamQuery& query) {
-        // Maps old tupleIds to new tupleIds
-        std::map<int, int> reorder;
-        int ctr = 0;
-
-        visitDepthFirst(query, [&](const RamTupleOperation& search) {
-            if (ctr != search.getTupleId()) {
-                changed = true;
+        std::function<std::unique_ptr<RamNode>(std::unique_ptr<RamNode>)> scanRewriter =
+                [&](std::unique_ptr<RamNode> node) -> std::unique_ptr<RamNode> {
+            if (const RamScan* scan = dynamic_cast<RamScan*>(node.get())) {
+                // a full scan nested directly in a full scan is a cross
+                // product; neither scan can depend on the other's tuple
+                if (const auto* inner = dynamic_cast<const RamScan*>(&scan->getOperation())) {
+                    const RamRelation& outerRel = scan->getRelation();
+                    const RamRelation& innerRel = inner->getRelation();
+                    if (rca->hasEstimate(outerRel) && rca->hasEstimate(innerRel) &&
+                            rca->getEstimate(outerRel) < rca->getEstimate(innerRel)) {
+                        changed = true;
+                        // tuple identifiers travel with their relation;
+                        // TupleIdTransformer restores the nesting order
+                        auto newInner = std::make_unique<RamScan>(
+                                std::make_unique<RamRelationReference>(&outerRel), scan->getTupleId(),
+                                std::unique_ptr<RamOperation>(inner->getOperation().clone()),
+                                scan->getProfileText());
+                        node = std::make_unique<RamScan>(
+                                std::make_unique<RamRelationReference>(&innerRel), inner->getTupleId(),
+                                std::move(newInner), inner->getProfileText());
+                    }
+                }
             }
-            reorder[search.getTupleId()] = ctr;
-            const_cast<RamTupleOperation*>(&search)->setTupleId(ctr);
-            ctr++;
-        });
+            node->apply(makeLambdaRamMapper(scanRewriter));
+            return node;
+        };
+        const_cast<RamQuery*>(&query)->apply(makeLambdaRamMapper(scanRewriter));
+    });
+    return changed;
+}
 
-        std::function<std::unique_ptr<RamNode>(std::unique_ptr<RamNode>)> elementRewriter =
+bool HashJoinTransformer::convertIndexScans(RamTranslationUnit& translationUnit) {
+    bool changed = false;
+    RamProgram& program = *translationUnit.getProgram();
+    RamIndexAnalysis* isa = translationUnit.getAnalysis<RamIndexAnalysis>();
+
+    // count how often each search signature of each relation is used;
+    // only searches whose index would serve exactly one scan qualify
+    std::map<std::pair<std::string, SearchSignature>, int> searchUses;
+    visitDepthFirst(program, [&](const RamNode& node) {
+        if (const auto* indexSearch = dynamic_cast<const RamIndexOperation*>(&node)) {
+            searchUses[{indexSearch->getRelation().getName(), isa->getSearchSignature(indexSearch)}]++;
+        } else if (const auto* exists = dynamic_cast<const RamExistenceCheck*>(&node)) {
+            searchUses[{exists->getRelation().getName(), isa->getSearchSignature(exists)}]++;
+        } else if (const auto* provExists = dynamic_cast<const RamProvenanceExistenceCheck*>(&node)) {
+            searchUses[{provExists->getRelation().getName(), isa->getSearchSignature(provExists)}]++;
+        } else if (const auto* subsumes = dynamic_cast<const RamSubsumptionCheck*>(&node)) {
+            searchUses[{subsumes->getRelation().getName(), isa->getSearchSignature(subsumes)}]++;
+        }
+    });
+
+    // relations involved in a swap share their index sets, so their
+    // indices cannot be elided based on local usage counts
+    std::set<std::string> swapped;
+    visitDepthFirst(program, [&](const RamSwap& swap) {
+        swapped.insert(swap.getFirstRelation().getName());
+        swapped.insert(swap.getSecondRelation().getName());
+    });
+
+    // index scans inside loops run once per iteration and keep their index
+    std::set<const RamNode*> repeated;
+    visitDepthFirst(program, [&](const RamLoop& loop) {
+        visitDepthFirst(loop, [&](const RamIndexScan& iscan) { repeated.insert(&iscan); });
+    });
+
+    visitDepthFirst(program, [&](const RamQuery& query) {
+        std::function<std::unique_ptr<RamNode>(std::unique_ptr<RamNode>)> scanRewriter =
                 [&](std::unique_ptr<RamNode> node) -> std::unique_ptr<RamNode> {
-            if (auto* element = dynamic_cast<RamTupleElement*>(node.get())) {
-                if (reorder[element->getTupleId()] != element->getTupleId()) {
+            if (const RamIndexScan* iscan = dynamic_cast<RamIndexScan*>(node.get())) {
+                const RamRelation& rel = iscan->getRelation();
+                const auto representation = rel.getRepresentation();
+                const bool plainScan = dynamic_cast<RamAbstractParallel*>(node.get()) == nullptr &&
+                                       dynamic_cast<RamHashScan*>(node.get()) == nullptr;
+                const bool plainRepresentation = representation == RelationRepresentation::DEFAULT ||
+                                                 representation == RelationRepresentation::BTREE ||
+                                                 representation == RelationRepresentation::BRIE;
+                const SearchSignature signature = isa->getSearchSignature(iscan);
+                if (plainScan && plainRepresentation && !iscan->hasRangeBounds() && signature != 0 &&
+                        repeated.count(iscan) == 0 && swapped.count(rel.getName()) == 0 &&
+                        searchUses[{rel.getName(), signature}] == 1) {
                     changed = true;
-                    node = std::make_unique<RamTupleElement>(
-                            reorder[element->getTupleId()], element->getElement());
+                    std::vector<std::unique_ptr<RamExpression>> newValues;
+                    for (auto& cur : iscan->getRangePattern()) {
+                        newValues.emplace_back(cur->clone());
+                    }
+                    node = std::make_unique<RamHashScan>(std::make_unique<RamRelationReference>(&rel),
+                            iscan->getTupleId(), std::move(newValues),
+                            std::unique_ptr<RamOperation>(iscan->getOperation().clone()),
+                            iscan->getProfileText());
                 }
             }
-            node->apply(makeLambdaRamMapper(elementRewriter));
+            node->apply(makeLambdaRamMapper(scanRewriter));
+
             return node;
         };
-        const_cast<RamQuery*>(&query)->apply(makeLambdaRamMapper(elementRewriter));
+        const_cast<RamQuery*>(&query)->apply(makeLambdaRamMapper(scanRewriter));
     });
 
     return changed;
 }
 
-bool HoistAggregateTransformer::hoistAggregate(RamProgram& program) {
+bool QueryFusionTransformer::fuseQueries(RamTranslationUnit& translationUnit) {
+    // fusing rules would merge their profile counters
+    if (Global::config().has("profile")) {
+        return false;
+    }
+
     // flag to determine whether the RAM program has changed
     bool changed = false;
 
-    // hoist a single aggregate to an outer scope
-    // most outer permissible aggregate is hoisted
-    visitDepthFirst(program, [&](const RamQuery& query) {
-        // new level of aggregate
-        int newLevel = -1;
+    // relations a query reads, i.e. scans, probes or checks for membership
+    auto getReads = [](const RamQuery& query) {
+        std::set<std::string> reads;
+        visitDepthFirst(query, [&](const RamNode& node) {
+            if (const auto* relOp = dynamic_cast<const RamRelationOperation*>(&node)) {
+                reads.insert(relOp->getRelation().getName());
+            } else if (const auto* exists = dynamic_cast<const RamExistenceCheck*>(&node)) {
+                reads.insert(exists->getRelation().getName());
+            } else if (const auto* provExists = dynamic_cast<const RamProvenanceExistenceCheck*>(&node)) {
+                reads.insert(provExists->getRelation().getName());
+            } else if (const auto* subsumes = dynamic_cast<const RamSubsumptionCheck*>(&node)) {
+                reads.insert(subsumes->getRelation().getName());
+            } else if (const auto* empty = dynamic_cast<const RamEmptinessCheck*>(&node)) {
+                reads.insert(empty->getRelation().getName());
+            }
+        });
+        return reads;
+    };
 
-        // new aggregate
-        std::unique_ptr<RamNestedOperation> newAgg;
+    // relations a query writes
+    auto getWrites = [](const RamQuery& query) {
+        std::set<std::string> writes;
+        visitDepthFirst(query, [&](const RamProject& project) {
+            writes.insert(project.getRelation().getName());
+        });
+        return writes;
+    };
 
-        // level of last non-aggregate
-        int lastNonAggLevel = -1;
+    // a fusable query together with the wrappers peeled off on the way to
+    // its outer scan: the debug-info statement of a rule version and any
+    // tuple-independent guard filters above the scan
+    struct FusableQuery {
+        const RamQuery* query = nullptr;
+        const RamScan* scan = nullptr;
+        std::vector<const RamCondition*> guards;
+        const RamDebugInfo* debugInfo = nullptr;
+    };
 
-        // The rewriter has two tasks: (1) identify a single aggregate that can be hoisted
-        // and (2) insert it at the outermost level if there is a dependency.
-        std::function<std::unique_ptr<RamNode>(std::unique_ptr<RamNode>)> aggRewriter =
-                [&](std::unique_ptr<RamNode> node) -> std::unique_ptr<RamNode> {
-            // identify whether it is an aggregate that can be hoisted
-            if (const RamAggregate* agg = dynamic_cast<RamAggregate*>(node.get())) {
-                // assuming that RamTupleOperations have monotonic increasing tupleIds
-                if (rla->getLevel(agg) < agg->getTupleId() - 1) {
-                    // If all tuple ops between the rla->getLevel(agg) and agg
-                    // are aggregates, then we do not transform
-                    if (rla->getLevel(agg) != lastNonAggLevel) {
+    // view a statement as a fusable query; rule versions in recursive loops
+    // are wrapped in debug-info statements and carry guard filters at the
+    // root of the query, so both are peeled before looking for the scan
+    auto getFusableQuery = [](const RamStatement* stmt) -> FusableQuery {
+        FusableQuery res;
+        if (const auto* info = dynamic_cast<const RamDebugInfo*>(stmt)) {
+            res.debugInfo = info;
+            stmt = &info->getStatement();
+        }
+        res.query = dynamic_cast<const RamQuery*>(stmt);
+        if (res.query == nullptr) {
+            return res;
+        }
+        // guard filters at the root of a query precede every tuple
+        // operation and hence cannot depend on any tuple
+        const RamOperation* op = &res.query->getOperation();
+        while (const auto* filter = dynamic_cast<const RamFilter*>(op)) {
+            res.guards.push_back(&filter->getCondition());
+            op = &filter->getOperation();
+        }
+        const auto* scan = dynamic_cast<const RamScan*>(op);
+        if (scan == nullptr) {
+            return res;
+        }
+        bool admissible = true;
+        visitDepthFirst(*res.query, [&](const RamBreak&) { admissible = false; });
+        visitDepthFirst(*res.query, [&](const RamSubroutineReturnValue&) { admissible = false; });
+        if (admissible) {
+            res.scan = scan;
+        }
+        return res;
+    };
+
+    // the scan at the head of a split body eligible for prefix factoring:
+    // a serial full scan, or an index scan without attached range bounds
+    auto headScan = [](const RamOperation* op) -> const RamRelationOperation* {
+        if (dynamic_cast<const RamAbstractParallel*>(op) != nullptr) {
+            return nullptr;
+        }
+        if (const auto* indexScan = dynamic_cast<const RamIndexScan*>(op)) {
+            return indexScan->hasRangeBounds() ? nullptr : indexScan;
+        }
+        if (const auto* scan = dynamic_cast<const RamScan*>(op)) {
+            return scan;
+        }
+        return nullptr;
+    };
+
+    // factor a scan common to the head of every body of a split into a
+    // single shared scan, recursively sharing deeper rule prefixes
+    std::function<std::unique_ptr<RamOperation>(std::unique_ptr<RamSplit>)> factorCommonScans =
+            [&](std::unique_ptr<RamSplit> split) -> std::unique_ptr<RamOperation> {
+        auto bodies = split->getBodies();
+        const RamRelationOperation* shared = headScan(bodies[0]);
+        for (size_t i = 1; shared != nullptr && i < bodies.size(); i++) {
+            const RamRelationOperation* cur = headScan(bodies[i]);
+            if (cur == nullptr || cur->getRelation() != shared->getRelation()) {
+                shared = nullptr;
+                break;
+            }
+            const auto* sharedIndex = dynamic_cast<const RamIndexScan*>(shared);
+            const auto* curIndex = dynamic_cast<const RamIndexScan*>(cur);
+            if ((sharedIndex != nullptr) != (curIndex != nullptr)) {
+                shared = nullptr;
+                break;
+            }
+            if (sharedIndex != nullptr) {
+                // equal patterns can only reference shared outer tuples,
+                // as the tuple ids local to different bodies are disjoint
+                auto sharedPattern = sharedIndex->getRangePattern();
+                auto curPattern = curIndex->getRangePattern();
+                for (size_t k = 0; k < sharedPattern.size(); k++) {
+                    if (!(*sharedPattern[k] == *curPattern[k])) {
+                        shared = nullptr;
+                        break;
+                    }
+                }
+            }
+        }
+        if (shared == nullptr) {
+            return split;
+        }
+
+        // strip the shared scan off every body, redirecting references to
+        // a body's own scan tuple to the shared one
+        const int sharedId = shared->getTupleId();
+        std::vector<std::unique_ptr<RamOperation>> inner;
+        for (const RamOperation* body : bodies) {
+            const RamRelationOperation* cur = headScan(body);
+            std::unique_ptr<RamOperation> nested(cur->getOperation().clone());
+            const int curId = cur->getTupleId();
+            if (curId != sharedId) {
+                std::function<std::unique_ptr<RamNode>(std::unique_ptr<RamNode>)> redirect =
+                        [&](std::unique_ptr<RamNode> node) -> std::unique_ptr<RamNode> {
+                    if (auto* element = dynamic_cast<RamTupleElement*>(node.get())) {
+                        if (element->getTupleId() == curId) {
+                            node = std::make_unique<RamTupleElement>(sharedId, element->getElement());
+                        }
+                    }
+                    node->apply(makeLambdaRamMapper(redirect));
+                    return node;
+                };
+                nested->apply(makeLambdaRamMapper(redirect));
+            }
+            inner.emplace_back(std::move(nested));
+        }
+        std::unique_ptr<RamOperation> factored =
+                factorCommonScans(std::make_unique<RamSplit>(std::move(inner)));
+        if (const auto* sharedIndex = dynamic_cast<const RamIndexScan*>(shared)) {
+            std::vector<std::unique_ptr<RamExpression>> pattern;
+            for (const RamExpression* expr : sharedIndex->getRangePattern()) {
+                pattern.emplace_back(expr->clone());
+            }
+            return std::make_unique<RamIndexScan>(
+                    std::make_unique<RamRelationReference>(&shared->getRelation()), sharedId,
+                    std::move(pattern), std::move(factored), shared->getProfileText());
+        }
+        return std::make_unique<RamScan>(std::make_unique<RamRelationReference>(&shared->getRelation()),
+                sharedId, std::move(factored), shared->getProfileText());
+    };
+
+    // fuse a run of queries into a single query scanning the shared
+    // relation once and evaluating the bodies of all queries per tuple
+    auto fuseRun = [&](const std::vector<FusableQuery>& run) -> std::unique_ptr<RamStatement> {
+        const RamScan* scan = run.front().scan;
+        const int scanId = scan->getTupleId();
+        int nextId = scanId + 1;
+        std::vector<std::unique_ptr<RamOperation>> bodies;
+        std::stringstream debugMessage;
+        bool anyDebugInfo = false;
+        for (const FusableQuery& fusable : run) {
+            const RamScan* cur = fusable.scan;
+            std::unique_ptr<RamOperation> body(cur->getOperation().clone());
+            // re-establish the query's guard filters around its body; they
+            // are tuple-independent, so checking them per tuple is sound
+            for (auto it = fusable.guards.rbegin(); it != fusable.guards.rend(); ++it) {
+                body = std::make_unique<RamFilter>(
+                        std::unique_ptr<RamCondition>((*it)->clone()), std::move(body));
+            }
+            if (fusable.debugInfo != nullptr) {
+                debugMessage << (anyDebugInfo ? "\n" : "") << fusable.debugInfo->getMessage();
+                anyDebugInfo = true;
+            }
+
+            // renumber the tuple ids of the body so all bodies can share
+            // one tuple environment
+            std::map<int, int> reorder{{scanId, scanId}};
+            visitDepthFirst(*body, [&](const RamTupleOperation& search) {
+                reorder[search.getTupleId()] = nextId;
+                const_cast<RamTupleOperation*>(&search)->setTupleId(nextId);
+                nextId++;
+            });
+            std::function<std::unique_ptr<RamNode>(std::unique_ptr<RamNode>)> elementRewriter =
+                    [&](std::unique_ptr<RamNode> node) -> std::unique_ptr<RamNode> {
+                if (auto* element = dynamic_cast<RamTupleElement*>(node.get())) {
+                    if (reorder[element->getTupleId()] != element->getTupleId()) {
+                        node = std::make_unique<RamTupleElement>(
+                                reorder[element->getTupleId()], element->getElement());
+                    }
+                }
+                node->apply(makeLambdaRamMapper(elementRewriter));
+                return node;
+            };
+            body->apply(makeLambdaRamMapper(elementRewriter));
+            bodies.emplace_back(std::move(body));
+        }
+        // factor scan prefixes the bodies still share beyond the outer
+        // scan, so rules agreeing on several leading atoms walk the whole
+        // common prefix once
+        std::unique_ptr<RamOperation> fusedBody =
+                factorCommonScans(std::make_unique<RamSplit>(std::move(bodies)));
+        std::unique_ptr<RamOperation> outer;
+        if (dynamic_cast<const RamParallelScan*>(scan) != nullptr) {
+            outer = std::make_unique<RamParallelScan>(
+                    std::make_unique<RamRelationReference>(&scan->getRelation()), scanId,
+                    std::move(fusedBody), scan->getProfileText());
+        } else {
+            outer = std::make_unique<RamScan>(std::make_unique<RamRelationReference>(&scan->getRelation()),
+                    scanId, std::move(fusedBody), scan->getProfileText());
+        }
+        std::unique_ptr<RamStatement> fused = std::make_unique<RamQuery>(std::move(outer));
+        if (anyDebugInfo) {
+            fused = std::make_unique<RamDebugInfo>(std::move(fused), debugMessage.str());
+        }
+        return fused;
+    };
+
+    // rewrite all sequences, fusing maximal runs of adjacent queries
+    std::function<std::unique_ptr<RamNode>(std::unique_ptr<RamNode>)> sequenceRewriter =
+            [&](std::unique_ptr<RamNode> node) -> std::unique_ptr<RamNode> {
+        node->apply(makeLambdaRamMapper(sequenceRewriter));
+        if (const auto* sequence = dynamic_cast<const RamSequence*>(node.get())) {
+            auto statements = sequence->getStatements();
+            bool fusedAny = false;
+            auto replacement = std::make_unique<RamSequence>();
+            size_t i = 0;
+            while (i < statements.size()) {
+                std::vector<FusableQuery> run;
+                std::set<std::string> runReads;
+                std::set<std::string> runWrites;
+                const RamScan* runScan = nullptr;
+                for (size_t j = i; j < statements.size(); j++) {
+                    FusableQuery fusable = getFusableQuery(statements[j]);
+                    if (fusable.scan == nullptr) {
+                        break;
+                    }
+                    const RamScan* scan = fusable.scan;
+                    if (runScan != nullptr) {
+                        // the scans must traverse the same relation with the
+                        // same tuple id and the same degree of parallelism
+                        if (scan->getRelation() != runScan->getRelation() ||
+                                scan->getTupleId() != runScan->getTupleId() ||
+                                (dynamic_cast<const RamParallelScan*>(scan) != nullptr) !=
+                                        (dynamic_cast<const RamParallelScan*>(runScan) != nullptr)) {
+                            break;
+                        }
+                    }
+                    // evaluating the bodies per tuple instead of per query
+                    // must not change what any of them observes
+                    std::set<std::string> reads = getReads(*fusable.query);
+                    std::set<std::string> writes = getWrites(*fusable.query);
+                    bool interferes = false;
+                    for (const auto& rel : writes) {
+                        if (runReads.find(rel) != runReads.end() || reads.find(rel) != reads.end()) {
+                            interferes = true;
+                        }
+                    }
+                    for (const auto& rel : runWrites) {
+                        if (reads.find(rel) != reads.end()) {
+                            interferes = true;
+                        }
+                    }
+                    if (interferes) {
+                        break;
+                    }
+                    run.push_back(fusable);
+                    runReads.insert(reads.begin(), reads.end());
+                    runWrites.insert(writes.begin(), writes.end());
+                    runScan = scan;
+                }
+                if (run.size() >= 2) {
+                    replacement->add(fuseRun(run));
+                    fusedAny = true;
+                    changed = true;
+                    i += run.size();
+                } else {
+                    replacement->add(std::unique_ptr<RamStatement>(statements[i]->clone()));
+                    i++;
+                }
+            }
+            if (fusedAny) {
+                return replacement;
+            }
+        }
+        return node;
+    };
+    translationUnit.getProgram()->apply(makeLambdaRamMapper(sequenceRewriter));
+
+    return changed;
+}
+
+bool CopyElisionTransformer::elideCopies(RamTranslationUnit& translationUnit) {
+    // replacing copy queries would remove their frequency counters
+    if (Global::config().has("profile")) {
+        return false;
+    }
+
+    RamProgram& program = *translationUnit.getProgram();
+    bool changed = false;
+
+    // whether all values are the identity projection of the given scan,
+    // i.e. value i reads element i of the scanned tuple
+    auto isIdentity = [](const std::vector<RamExpression*>& values, int tupleId, size_t arity) {
+        if (values.size() != arity) {
+            return false;
+        }
+        for (size_t i = 0; i < values.size(); i++) {
+            const auto* element = dynamic_cast<const RamTupleElement*>(values[i]);
+            if (element == nullptr || element->getTupleId() != tupleId || element->getElement() != i) {
+                return false;
+            }
+        }
+        return true;
+    };
+
+    // determine whether a query is a pure copy of one relation into
+    // another, and if so, yield the equivalent merge statement
+    auto asMerge = [&](const RamQuery& query) -> std::unique_ptr<RamMerge> {
+        const auto* scan = dynamic_cast<const RamScan*>(&query.getOperation());
+        if (scan == nullptr) {
+            return nullptr;
+        }
+        const RamRelation& source = scan->getRelation();
+        if (source.getArity() == 0) {
+            return nullptr;
+        }
+
+        // skip over a guard that only re-checks membership in the target;
+        // set-insertion semantics make it redundant
+        const RamOperation* nested = &scan->getOperation();
+        const RamFilter* filter = dynamic_cast<const RamFilter*>(nested);
+        if (filter != nullptr) {
+            nested = &filter->getOperation();
+        }
+        const auto* project = dynamic_cast<const RamProject*>(nested);
+        if (project == nullptr) {
+            return nullptr;
+        }
+        const RamRelation& target = project->getRelation();
+
+        // the projection must copy the scanned tuple unchanged
+        if (target == source || target.getArity() != source.getArity() ||
+                !isIdentity(project->getValues(), scan->getTupleId(), source.getArity())) {
+            return nullptr;
+        }
+
+        // merging into an equivalence relation extends the source with the
+        // target's knowledge, which a copy does not
+        if (target.getRepresentation() == RelationRepresentation::EQREL ||
+                source.getRepresentation() == RelationRepresentation::EQREL) {
+            return nullptr;
+        }
+
+        // the guard, if any, may only consist of negated existence checks
+        // of the copied tuple in the target
+        if (filter != nullptr) {
+            for (auto const& cur : toConjunctionList(&filter->getCondition())) {
+                const auto* neg = dynamic_cast<const RamNegation*>(cur.get());
+                if (neg == nullptr) {
+                    return nullptr;
+                }
+                const auto* exists = dynamic_cast<const RamExistenceCheck*>(&neg->getOperand());
+                if (exists == nullptr || exists->getRelation() != target ||
+                        !isIdentity(exists->getValues(), scan->getTupleId(), source.getArity())) {
+                    return nullptr;
+                }
+            }
+        }
+
+        return std::make_unique<RamMerge>(std::make_unique<RamRelationReference>(&target),
+                std::make_unique<RamRelationReference>(&source));
+    };
+
+    // replace all qualifying queries by merge statements
+    std::function<std::unique_ptr<RamNode>(std::unique_ptr<RamNode>)> copyRewriter =
+            [&](std::unique_ptr<RamNode> node) -> std::unique_ptr<RamNode> {
+        if (const auto* query = dynamic_cast<const RamQuery*>(node.get())) {
+            if (auto merge = asMerge(*query)) {
+                changed = true;
+                return merge;
+            }
+        }
+        node->apply(makeLambdaRamMapper(copyRewriter));
+        return node;
+    };
+    program.apply(makeLambdaRamMapper(copyRewriter));
+
+    return changed;
+}
+
+bool RelationAliasTransformer::aliasRelations(RamTranslationUnit& translationUnit) {
+    RamProgram& program = *translationUnit.getProgram();
+    RamStatement* main = program.getMain();
+    if (main == nullptr) {
+        return false;
+    }
+
+    // locate the top-level sequence of strata; under profiling the
+    // sequence is wrapped into the main runtime timer
+    auto* sequence = dynamic_cast<RamSequence*>(main);
+    if (sequence == nullptr) {
+        if (auto* timer = dynamic_cast<RamLogTimer*>(main)) {
+            sequence = dynamic_cast<RamSequence*>(const_cast<RamStatement*>(&timer->getStatement()));
+        }
+    }
+    if (sequence == nullptr) {
+        return false;
+    }
+    const auto statements = sequence->getStatements();
+
+    // per relation: the position of the last top-level statement writing
+    // it and the number of writes; barred relations are left alone
+    std::map<std::string, size_t> lastWrite;
+    std::map<std::string, size_t> writeCount;
+    std::set<std::string> barred;
+
+    auto recordWrite = [&](const RamRelation& rel, size_t position) {
+        auto pos = lastWrite.find(rel.getName());
+        if (pos == lastWrite.end() || pos->second < position) {
+            lastWrite[rel.getName()] = position;
+        }
+        writeCount[rel.getName()]++;
+    };
+
+    for (size_t i = 0; i < statements.size(); i++) {
+        visitDepthFirst(*statements[i], [&](const RamNode& node) {
+            if (const auto* project = dynamic_cast<const RamProject*>(&node)) {
+                recordWrite(project->getRelation(), i);
+            } else if (const auto* merge = dynamic_cast<const RamMerge*>(&node)) {
+                recordWrite(merge->getTargetRelation(), i);
+            } else if (const auto* load = dynamic_cast<const RamLoad*>(&node)) {
+                recordWrite(load->getRelation(), i);
+            } else if (const auto* fact = dynamic_cast<const RamFact*>(&node)) {
+                recordWrite(fact->getRelation(), i);
+            } else if (const auto* facts = dynamic_cast<const RamFactTable*>(&node)) {
+                recordWrite(facts->getRelation(), i);
+            } else if (const auto* swap = dynamic_cast<const RamSwap*>(&node)) {
+                barred.insert(swap->getFirstRelation().getName());
+                barred.insert(swap->getSecondRelation().getName());
+            } else if (const auto* clear = dynamic_cast<const RamClear*>(&node)) {
+                barred.insert(clear->getRelation().getName());
+            } else if (const auto* drop = dynamic_cast<const RamDrop*>(&node)) {
+                barred.insert(drop->getRelation().getName());
+            } else if (const auto* query = dynamic_cast<const RamQuery*>(&node)) {
+                // the alternative plans of a query are hidden from mappers
+                // and would keep reading an aliased relation
+                for (const RamOperation* alt : query->getAlternatives()) {
+                    visitDepthFirst(*alt, [&](const RamRelationReference& ref) {
+                        barred.insert(ref.get()->getName());
+                    });
+                }
+            }
+        });
+        // a merge executed repeatedly inside a loop is no plain bridge
+        visitDepthFirst(*statements[i], [&](const RamLoop& loop) {
+            visitDepthFirst(loop, [&](const RamMerge& merge) {
+                barred.insert(merge.getTargetRelation().getName());
+            });
+        });
+    }
+
+    // writes reachable through subroutines escape the position analysis
+    for (const auto& cur : program.getSubroutines()) {
+        visitDepthFirst(*cur.second, [&](const RamNode& node) {
+            if (const auto* project = dynamic_cast<const RamProject*>(&node)) {
+                barred.insert(project->getRelation().getName());
+            } else if (const auto* merge = dynamic_cast<const RamMerge*>(&node)) {
+                barred.insert(merge->getTargetRelation().getName());
+            }
+        });
+    }
+
+    // relations with non-set insertion semantics are excluded: merging
+    // into or from them is not equivalent to sharing the source object
+    auto isSetRepresentation = [](const RamRelation& rel) {
+        switch (rel.getRepresentation()) {
+            case RelationRepresentation::EQREL:
+            case RelationRepresentation::SUBSUMPTION:
+            case RelationRepresentation::FUNCTIONAL: return false;
+            default: return true;
+        }
+    };
+
+    // collect the bridges: a merge that is the only write of its target,
+    // with a source completely computed before the merge runs
+    std::map<std::string, const RamRelation*> candidates;
+    for (size_t i = 0; i < statements.size(); i++) {
+        visitDepthFirst(*statements[i], [&](const RamMerge& merge) {
+            const RamRelation& target = merge.getTargetRelation();
+            const RamRelation& source = merge.getSourceRelation();
+            if (target == source || target.getArity() != source.getArity()) {
+                return;
+            }
+            if (!isSetRepresentation(target) || !isSetRepresentation(source)) {
+                return;
+            }
+            if (barred.count(target.getName()) != 0 || barred.count(source.getName()) != 0) {
+                return;
+            }
+            if (writeCount[target.getName()] != 1) {
+                return;
+            }
+            const auto sourceWrite = lastWrite.find(source.getName());
+            if (sourceWrite != lastWrite.end() && sourceWrite->second >= i) {
+                return;
+            }
+            candidates[target.getName()] = &source;
+        });
+    }
+    if (candidates.empty()) {
+        return false;
+    }
+
+    // resolve chains of bridges to their ultimate source, dropping cycles
+    std::map<std::string, const RamRelation*> aliasOf;
+    for (const auto& cur : candidates) {
+        std::set<std::string> visited = {cur.first};
+        const RamRelation* source = cur.second;
+        bool cyclic = false;
+        auto pos = candidates.find(source->getName());
+        while (pos != candidates.end()) {
+            if (!visited.insert(source->getName()).second) {
+                cyclic = true;
+                break;
+            }
+            source = pos->second;
+            pos = candidates.find(source->getName());
+        }
+        if (!cyclic) {
+            aliasOf[cur.first] = source;
+        }
+    }
+    if (aliasOf.empty()) {
+        return false;
+    }
+
+    // redirect all references of a bridge target to its source and drop
+    // the target's creation and the bridging merge itself
+    std::function<std::unique_ptr<RamNode>(std::unique_ptr<RamNode>)> aliasRewriter =
+            [&](std::unique_ptr<RamNode> node) -> std::unique_ptr<RamNode> {
+        if (const auto* ref = dynamic_cast<const RamRelationReference*>(node.get())) {
+            auto pos = aliasOf.find(ref->get()->getName());
+            if (pos != aliasOf.end()) {
+                return std::make_unique<RamRelationReference>(pos->second);
+            }
+            return node;
+        }
+        if (const auto* create = dynamic_cast<const RamCreate*>(node.get())) {
+            if (aliasOf.count(create->getRelation().getName()) != 0) {
+                return std::make_unique<RamSequence>();
+            }
+        }
+        if (const auto* merge = dynamic_cast<const RamMerge*>(node.get())) {
+            if (aliasOf.count(merge->getTargetRelation().getName()) != 0) {
+                return std::make_unique<RamSequence>();
+            }
+        }
+        node->apply(makeLambdaRamMapper(aliasRewriter));
+        return node;
+    };
+    program.apply(makeLambdaRamMapper(aliasRewriter));
+
+    return true;
+}
+
+bool EagerDropTransformer::eagerDrops(RamTranslationUnit& translationUnit) {
+    RamProgram& program = *translationUnit.getProgram();
+    RamStatement* main = program.getMain();
+    if (main == nullptr) {
+        return false;
+    }
+
+    // locate the top-level sequence of strata; under profiling the
+    // sequence is wrapped into the main runtime timer
+    auto* sequence = dynamic_cast<RamSequence*>(main);
+    if (sequence == nullptr) {
+        if (auto* timer = dynamic_cast<RamLogTimer*>(main)) {
+            sequence = dynamic_cast<RamSequence*>(const_cast<RamStatement*>(&timer->getStatement()));
+        }
+    }
+    if (sequence == nullptr) {
+        return false;
+    }
+
+    const auto statements = sequence->getStatements();
+
+    // per relation: the last top-level statement truly using it (any
+    // reference but its own drop), the statement holding its drop, and
+    // the total number of drops across the program
+    std::map<std::string, size_t> lastUse;
+    std::map<std::string, size_t> dropAt;
+    std::map<std::string, size_t> dropCount;
+    for (size_t i = 0; i < statements.size(); i++) {
+        std::map<std::string, size_t> refs;
+        std::map<std::string, size_t> drops;
+        visitDepthFirst(*statements[i], [&](const RamRelationReference& ref) {
+            refs[ref.get()->getName()]++;
+        });
+        visitDepthFirst(*statements[i], [&](const RamDrop& drop) {
+            drops[drop.getRelation().getName()]++;
+        });
+        for (const auto& pair : refs) {
+            auto d = drops.find(pair.first);
+            const size_t dropRefs = (d == drops.end()) ? 0 : d->second;
+            if (pair.second > dropRefs) {
+                lastUse[pair.first] = i;
+            }
+        }
+        for (const auto& pair : drops) {
+            dropAt[pair.first] = i;
+            dropCount[pair.first] += pair.second;
+        }
+    }
+
+    // determine which drops move forward: the last user must be an
+    // earlier top-level stratum with a sequence body the drop can be
+    // appended to
+    std::map<size_t, std::vector<std::string>> insertions;
+    std::set<std::string> moved;
+    for (const auto& pair : dropAt) {
+        // relations dropped more than once follow a bespoke protocol
+        // (e.g. the distributed engines) and are left alone
+        if (dropCount[pair.first] != 1) {
+            continue;
+        }
+        const auto use = lastUse.find(pair.first);
+        // never read nor written => the conservative position is as good
+        // as any
+        if (use == lastUse.end()) {
+            continue;
+        }
+        // already dropped by its last user, or used after the drop
+        if (use->second >= pair.second) {
+            continue;
+        }
+        const auto* stratum = dynamic_cast<const RamStratum*>(statements[use->second]);
+        if (stratum == nullptr) {
+            // e.g. a parallel block of strata: a concurrently executing
+            // stratum completes at an unknown time, keep the drop where
+            // the translator put it
+            continue;
+        }
+        if (dynamic_cast<const RamSequence*>(&stratum->getBody()) == nullptr) {
+            continue;
+        }
+        insertions[use->second].push_back(pair.first);
+        moved.insert(pair.first);
+    }
+    if (moved.empty()) {
+        return false;
+    }
+
+    // remove the relocated drops from their conservative positions
+    std::function<std::unique_ptr<RamNode>(std::unique_ptr<RamNode>)> dropRemover =
+            [&](std::unique_ptr<RamNode> node) -> std::unique_ptr<RamNode> {
+        node->apply(makeLambdaRamMapper(dropRemover));
+        if (const auto* seq = dynamic_cast<const RamSequence*>(node.get())) {
+            bool removesAny = false;
+            for (const RamStatement* stmt : seq->getStatements()) {
+                const auto* drop = dynamic_cast<const RamDrop*>(stmt);
+                if (drop != nullptr && moved.find(drop->getRelation().getName()) != moved.end()) {
+                    removesAny = true;
+                }
+            }
+            if (removesAny) {
+                auto replacement = std::make_unique<RamSequence>();
+                for (const RamStatement* stmt : seq->getStatements()) {
+                    const auto* drop = dynamic_cast<const RamDrop*>(stmt);
+                    if (drop != nullptr && moved.find(drop->getRelation().getName()) != moved.end()) {
+                        continue;
+                    }
+                    replacement->add(std::unique_ptr<RamStatement>(stmt->clone()));
+                }
+                return replacement;
+            }
+        }
+        return node;
+    };
+    for (const auto& pair : dropAt) {
+        if (moved.find(pair.first) == moved.end()) {
+            continue;
+        }
+        statements[pair.second]->apply(makeLambdaRamMapper(dropRemover));
+    }
+
+    // append each relocated drop behind the last user in its stratum
+    for (const auto& pair : insertions) {
+        const auto* stratum = static_cast<const RamStratum*>(statements[pair.first]);
+        auto* body = const_cast<RamSequence*>(static_cast<const RamSequence*>(&stratum->getBody()));
+        for (const std::string& name : pair.second) {
+            const RamRelation* rel = program.getRelation(name);
+            assert(rel != nullptr && "dropped relation not part of the program");
+            body->add(std::make_unique<RamDrop>(std::make_unique<RamRelationReference>(rel)));
+        }
+    }
+
+    return true;
+}
+
+bool TupleIdTransformer::reorderOperations(RamProgram& program) {
+    // flag to determine whether the RAM program has changed
+    bool changed = false;
+
+    visitDepthFirst(program, [&](const RamQuery& query) {
+        // Maps old tupleIds to new tupleIds
+        std::map<int, int> reorder;
+        int ctr = 0;
+
+        visitDepthFirst(query, [&](const RamTupleOperation& search) {
+            if (ctr != search.getTupleId()) {
+                changed = true;
+            }
+            reorder[search.getTupleId()] = ctr;
+            const_cast<RamTupleOperation*>(&search)->setTupleId(ctr);
+            ctr++;
+        });
+
+        std::function<std::unique_ptr<RamNode>(std::unique_ptr<RamNode>)> elementRewriter =
+                [&](std::unique_ptr<RamNode> node) -> std::unique_ptr<RamNode> {
+            if (auto* element = dynamic_cast<RamTupleElement*>(node.get())) {
+                if (reorder[element->getTupleId()] != element->getTupleId()) {
+                    changed = true;
+                    node = std::make_unique<RamTupleElement>(
+                            reorder[element->getTupleId()], element->getElement());
+                }
+            }
+            node->apply(makeLambdaRamMapper(elementRewriter));
+            return node;
+        };
+        const_cast<RamQuery*>(&query)->apply(makeLambdaRamMapper(elementRewriter));
+    });
+
+    return changed;
+}
+
+bool HoistAggregateTransformer::hoistAggregate(RamProgram& program) {
+    // flag to determine whether the RAM program has changed
+    bool changed = false;
+
+    // hoist a single aggregate to an outer scope
+    // most outer permissible aggregate is hoisted
+    visitDepthFirst(program, [&](const RamQuery& query) {
+        // new level of aggregate
+        int newLevel = -1;
+
+        // new aggregate
+        std::unique_ptr<RamNestedOperation> newAgg;
+
+        // level of last non-aggregate
+        int lastNonAggLevel = -1;
+
+        // The rewriter has two tasks: (1) identify a single aggregate that can be hoisted
+        // and (2) insert it at the outermost level if there is a dependency.
+        std::function<std::unique_ptr<RamNode>(std::unique_ptr<RamNode>)> aggRewriter =
+                [&](std::unique_ptr<RamNode> node) -> std::unique_ptr<RamNode> {
+            // identify whether it is an aggregate that can be hoisted
+            if (const RamAggregate* agg = dynamic_cast<RamAggregate*>(node.get())) {
+                // assuming that RamTupleOperations have monotonic increasing tupleIds
+                if (rla->getLevel(agg) < agg->getTupleId() - 1) {
+                    // If all tuple ops between the rla->getLevel(agg) and agg
+                    // are aggregates, then we do not transform
+                    if (rla->getLevel(agg) != lastNonAggLevel) {
                         changed = true;
 
                         // set insertion position
@@ -638,6 +2097,163 @@ bool HoistAggregateTransformer::hoistAggregate(RamProgram& program) {
     return changed;
 }
 
+namespace {
+
+/** @brief Redirect references to tuple `from` to tuple `to` in the subtree below `root` */
+void renumberTupleId(RamNode& root, int from, int to) {
+    std::function<std::unique_ptr<RamNode>(std::unique_ptr<RamNode>)> renumber =
+            [&](std::unique_ptr<RamNode> node) -> std::unique_ptr<RamNode> {
+        if (const RamTupleElement* element = dynamic_cast<RamTupleElement*>(node.get())) {
+            if (element->getTupleId() == from) {
+                return std::make_unique<RamTupleElement>(to, element->getElement());
+            }
+        }
+        node->apply(makeLambdaRamMapper(renumber));
+        return node;
+    };
+    root.apply(makeLambdaRamMapper(renumber));
+}
+
+/**
+ * @brief Check whether an aggregate's contribution per tuple is fixed
+ *
+ * The per-iteration delta folding is only sound if the value a tuple
+ * contributes to the aggregate cannot change once the tuple has been
+ * seen. That holds if condition and target expression refer to no
+ * tuple but the aggregate's own and do not consult other relations.
+ */
+bool hasFixedContribution(const RamAggregate* agg) {
+    bool fixed = true;
+    auto check = [&](const RamNode& root) {
+        visitDepthFirst(root, [&](const RamNode& node) {
+            if (const RamTupleElement* element = dynamic_cast<const RamTupleElement*>(&node)) {
+                if (element->getTupleId() != agg->getTupleId()) {
+                    fixed = false;
+                }
+            } else if (dynamic_cast<const RamAbstractExistenceCheck*>(&node) != nullptr ||
+                       dynamic_cast<const RamEmptinessCheck*>(&node) != nullptr) {
+                fixed = false;
+            }
+        });
+    };
+    check(agg->getCondition());
+    check(agg->getExpression());
+    return fixed;
+}
+
+}  // namespace
+
+bool IncrementalAggregateTransformer::incrementAggregates(RamProgram& program) {
+    // flag to determine whether the RAM program has changed
+    bool changed = false;
+
+    // number cache relations consecutively across the whole program
+    int cacheCounter = 0;
+
+    // cache creation statements to be placed in front of their loops
+    std::map<const RamLoop*, std::vector<std::unique_ptr<RamStatement>>> loopPrologues;
+
+    visitDepthFirst(program, [&](const RamLoop& loop) {
+        // delta relations maintained by this fixpoint loop
+        std::set<std::string> deltas;
+        visitDepthFirst(loop, [&](const RamSwap& swap) {
+            deltas.insert(swap.getFirstRelation().getName());
+            deltas.insert(swap.getSecondRelation().getName());
+        });
+
+        // per-iteration maintenance queries, prepended to the loop body
+        std::vector<std::unique_ptr<RamStatement>> updates;
+        std::vector<std::unique_ptr<RamStatement>> creates;
+
+        std::function<std::unique_ptr<RamNode>(std::unique_ptr<RamNode>)> aggRewriter =
+                [&](std::unique_ptr<RamNode> node) -> std::unique_ptr<RamNode> {
+            if (const RamAggregate* agg = dynamic_cast<RamAggregate*>(node.get())) {
+                const RamRelation& rel = agg->getRelation();
+                const RamRelation* delta = program.getRelation("@delta_" + rel.getName());
+                if (rel.getName().front() != '@' && delta != nullptr &&
+                        deltas.find(delta->getName()) != deltas.end() && hasFixedContribution(agg)) {
+                    changed = true;
+
+                    // unary relation caching the per-iteration partial aggregates;
+                    // the first iteration's delta equals the stable part of the
+                    // relation, so no separate initialisation is needed
+                    const std::string cacheName = "@agg_cache_" + std::to_string(cacheCounter++);
+                    program.addRelation(std::make_unique<RamRelation>(cacheName, 1,
+                            std::vector<std::string>(), std::vector<std::string>(),
+                            RelationRepresentation::DEFAULT));
+                    const RamRelation* cache = program.getRelation(cacheName);
+                    creates.push_back(std::make_unique<RamCreate>(
+                            std::make_unique<RamRelationReference>(cache)));
+
+                    // fold this iteration's delta tuples into the cache
+                    std::vector<std::unique_ptr<RamExpression>> values;
+                    values.push_back(std::make_unique<RamTupleElement>(0, 0));
+                    auto update = std::make_unique<RamAggregate>(
+                            std::make_unique<RamProject>(
+                                    std::make_unique<RamRelationReference>(cache), std::move(values)),
+                            agg->getFunction(), std::make_unique<RamRelationReference>(delta),
+                            std::unique_ptr<RamExpression>(agg->getExpression().clone()),
+                            std::unique_ptr<RamCondition>(agg->getCondition().clone()), 0);
+                    renumberTupleId(*update, agg->getTupleId(), 0);
+                    updates.push_back(std::make_unique<RamQuery>(std::move(update)));
+
+                    // fold the cached partials instead of rescanning the relation;
+                    // the deltas of successive iterations are disjoint, so a count
+                    // becomes a sum of the partial counts while min/max/sum are
+                    // idempotent respectively associative over the partials
+                    return std::make_unique<RamAggregate>(
+                            std::unique_ptr<RamOperation>(agg->getOperation().clone()),
+                            agg->getFunction() == souffle::COUNT ? souffle::SUM : agg->getFunction(),
+                            std::make_unique<RamRelationReference>(cache),
+                            std::make_unique<RamTupleElement>(agg->getTupleId(), 0),
+                            std::make_unique<RamTrue>(), agg->getTupleId());
+                }
+            }
+            node->apply(makeLambdaRamMapper(aggRewriter));
+            return node;
+        };
+        const_cast<RamLoop&>(loop).apply(makeLambdaRamMapper(aggRewriter));
+
+        if (!updates.empty()) {
+            // prepend the maintenance queries to the loop body
+            std::function<std::unique_ptr<RamNode>(std::unique_ptr<RamNode>)> prepend =
+                    [&](std::unique_ptr<RamNode> node) -> std::unique_ptr<RamNode> {
+                auto seq = std::make_unique<RamSequence>();
+                for (auto& update : updates) {
+                    seq->add(std::move(update));
+                }
+                seq->add(std::unique_ptr<RamStatement>(dynamic_cast<RamStatement*>(node.release())));
+                return seq;
+            };
+            const_cast<RamLoop&>(loop).apply(makeLambdaRamMapper(prepend));
+            loopPrologues[&loop] = std::move(creates);
+        }
+    });
+
+    // create the cache relations right in front of their loops
+    if (!loopPrologues.empty()) {
+        std::function<std::unique_ptr<RamNode>(std::unique_ptr<RamNode>)> createRewriter =
+                [&](std::unique_ptr<RamNode> node) -> std::unique_ptr<RamNode> {
+            if (const RamLoop* loop = dynamic_cast<RamLoop*>(node.get())) {
+                auto it = loopPrologues.find(loop);
+                if (it != loopPrologues.end()) {
+                    auto seq = std::make_unique<RamSequence>();
+                    for (auto& create : it->second) {
+                        seq->add(std::move(create));
+                    }
+                    seq->add(std::unique_ptr<RamStatement>(dynamic_cast<RamStatement*>(node.release())));
+                    return seq;
+                }
+            }
+            node->apply(makeLambdaRamMapper(createRewriter));
+            return node;
+        };
+        program.getMain()->apply(makeLambdaRamMapper(createRewriter));
+    }
+
+    return changed;
+}
+
 bool ParallelTransformer::parallelizeOperations(RamProgram& program) {
     // flag to determine whether the RAM program has changed
     bool changed = false;
@@ -680,11 +2296,13 @@ bool ParallelTransformer::parallelizeOperations(RamProgram& program) {
                             queryPattern.push_back(nullptr);
                         }
                     }
-                    return std::make_unique<RamParallelIndexScan>(
+                    auto res = std::make_unique<RamParallelIndexScan>(
                             std::make_unique<RamRelationReference>(&rel), indexScan->getTupleId(),
                             std::move(queryPattern),
                             std::unique_ptr<RamOperation>(indexScan->getOperation().clone()),
                             indexScan->getProfileText());
+                    res->copyRangeBounds(*indexScan);
+                    return std::move(res);
                 }
             } else if (const RamIndexChoice* indexChoice = dynamic_cast<RamIndexChoice*>(node.get())) {
                 if (indexChoice->getTupleId() == 0) {
@@ -698,12 +2316,28 @@ bool ParallelTransformer::parallelizeOperations(RamProgram& program) {
                             queryPattern.push_back(nullptr);
                         }
                     }
-                    return std::make_unique<RamParallelIndexChoice>(
+                    auto res = std::make_unique<RamParallelIndexChoice>(
                             std::make_unique<RamRelationReference>(&rel), indexChoice->getTupleId(),
                             std::unique_ptr<RamCondition>(indexChoice->getCondition().clone()),
                             std::move(queryPattern),
                             std::unique_ptr<RamOperation>(indexChoice->getOperation().clone()),
                             indexChoice->getProfileText());
+                    res->copyRangeBounds(*indexChoice);
+                    return std::move(res);
+                }
+            } else if (const RamAggregate* agg = dynamic_cast<RamAggregate*>(node.get())) {
+                // counting an unrestricted predicate is answered by the
+                // relation size and needs no loop; columnar relations
+                // provide no tuple partitioning
+                if (agg->getTupleId() == 0 && agg->getRelation().getArity() > 0 &&
+                        agg->getRelation().getRepresentation() != RelationRepresentation::COLUMNAR &&
+                        !(agg->getFunction() == souffle::COUNT && isRamTrue(&agg->getCondition()))) {
+                    changed = true;
+                    return std::make_unique<RamParallelAggregate>(
+                            std::unique_ptr<RamOperation>(agg->getOperation().clone()), agg->getFunction(),
+                            std::make_unique<RamRelationReference>(&agg->getRelation()),
+                            std::unique_ptr<RamExpression>(agg->getExpression().clone()),
+                            std::unique_ptr<RamCondition>(agg->getCondition().clone()), agg->getTupleId());
                 }
             }
             node->apply(makeLambdaRamMapper(parallelRewriter));
@@ -714,4 +2348,193 @@ bool ParallelTransformer::parallelizeOperations(RamProgram& program) {
     return changed;
 }
 
+std::unique_ptr<RamOperation> IndexConsolidationTransformer::rewriteToPrefix(
+        const RamIndexScan* iscan, SearchSignature prefix) {
+    const RamRelation& rel = iscan->getRelation();
+    const int identifier = iscan->getTupleId();
+    const auto pattern = iscan->getRangePattern();
+    std::vector<std::unique_ptr<RamExpression>> queryPattern(rel.getArity());
+    std::unique_ptr<RamCondition> condition;
+    for (size_t i = 0; i < rel.getArity(); i++) {
+        if (isRamUndefValue(pattern[i])) {
+            queryPattern[i] = std::make_unique<RamUndefValue>();
+        } else if ((prefix & (SearchSignature(1) << i)) != 0) {
+            queryPattern[i] = std::unique_ptr<RamExpression>(pattern[i]->clone());
+        } else {
+            // no longer part of the index prefix; re-check the equality
+            queryPattern[i] = std::make_unique<RamUndefValue>();
+            auto eq = std::make_unique<RamConstraint>(BinaryConstraintOp::EQ,
+                    std::make_unique<RamTupleElement>(identifier, i),
+                    std::unique_ptr<RamExpression>(pattern[i]->clone()));
+            if (condition == nullptr) {
+                condition = std::move(eq);
+            } else {
+                condition = std::make_unique<RamConjunction>(std::move(condition), std::move(eq));
+            }
+        }
+    }
+    std::unique_ptr<RamOperation> op(iscan->getOperation().clone());
+    if (condition != nullptr) {
+        op = std::make_unique<RamFilter>(std::move(condition), std::move(op));
+    }
+    if (dynamic_cast<const RamParallelIndexScan*>(iscan) != nullptr) {
+        return std::make_unique<RamParallelIndexScan>(std::make_unique<RamRelationReference>(&rel),
+                identifier, std::move(queryPattern), std::move(op), iscan->getProfileText());
+    }
+    return std::make_unique<RamIndexScan>(std::make_unique<RamRelationReference>(&rel), identifier,
+            std::move(queryPattern), std::move(op), iscan->getProfileText());
+}
+
+bool IndexConsolidationTransformer::consolidate(RamTranslationUnit& translationUnit) {
+    RamProgram& program = *translationUnit.getProgram();
+    RamIndexAnalysis* ria = translationUnit.getAnalysis<RamIndexAnalysis>();
+
+    // collect, per relation, the plain scans per search signature and the
+    // signatures that must keep exact index support
+    std::map<const RamRelation*, std::map<SearchSignature, std::vector<const RamIndexScan*>>> scans;
+    std::map<const RamRelation*, std::set<SearchSignature>> exact;
+    std::set<const RamRelation*> swapped;
+
+    visitDepthFirst(program, [&](const RamNode& node) {
+        if (dynamic_cast<const RamHashScan*>(&node) != nullptr) {
+            // hash scans probe a transient hash table; no index involved
+        } else if (const auto* iscan = dynamic_cast<const RamIndexScan*>(&node)) {
+            const RamRelation& rel = iscan->getRelation();
+            SearchSignature keys = ria->getSearchSignature(iscan);
+            if (!iscan->hasRangeBounds() && keys != 0) {
+                scans[&rel][keys].push_back(iscan);
+            } else {
+                // inequality bounds rely on the exact column order
+                exact[&rel].insert(keys);
+            }
+        } else if (const auto* indexOp = dynamic_cast<const RamIndexOperation*>(&node)) {
+            // choices and aggregates must see the exact range
+            exact[&indexOp->getRelation()].insert(ria->getSearchSignature(indexOp));
+        } else if (const auto* exists = dynamic_cast<const RamExistenceCheck*>(&node)) {
+            exact[&exists->getRelation()].insert(ria->getSearchSignature(exists));
+        } else if (const auto* provExists = dynamic_cast<const RamProvenanceExistenceCheck*>(&node)) {
+            exact[&provExists->getRelation()].insert(ria->getSearchSignature(provExists));
+        } else if (const auto* subsumes = dynamic_cast<const RamSubsumptionCheck*>(&node)) {
+            exact[&subsumes->getRelation()].insert(ria->getSearchSignature(subsumes));
+        } else if (const auto* ramRel = dynamic_cast<const RamRelation*>(&node)) {
+            exact[ramRel].insert(ria->getSearchSignature(ramRel));
+        }
+    });
+
+    // relations involved in a swap must carry identical index sets; any
+    // one-sided consolidation would break that invariant
+    visitDepthFirst(program, [&](const RamSwap& swap) {
+        swapped.insert(&swap.getFirstRelation());
+        swapped.insert(&swap.getSecondRelation());
+    });
+
+    auto card = [](SearchSignature cols) {
+        size_t count = 0;
+        for (; cols != 0; cols &= cols - 1) {
+            ++count;
+        }
+        return count;
+    };
+
+    // decide, per relation, which scans are weakened onto which retained index
+    std::map<const RamIndexScan*, SearchSignature> weakened;
+    for (auto& entry : scans) {
+        const RamRelation* rel = entry.first;
+        if (swapped.count(rel) != 0) {
+            continue;
+        }
+        auto& perSig = entry.second;
+        const MinIndexSelection& selection = ria->getIndexes(*rel);
+        const auto chains = selection.getAllChains();
+        const auto orders = selection.getAllOrders();
+        if (chains.size() < 2 || chains.size() != orders.size()) {
+            continue;
+        }
+        const auto& exactSigs = exact[rel];
+
+        // an index is retained if any of its searches needs exact ranges;
+        // the full-order search of emit/load operations always pins one
+        std::vector<bool> retained(chains.size(), false);
+        for (size_t c = 0; c < chains.size(); ++c) {
+            for (auto sig : chains[c]) {
+                if (exactSigs.count(sig) != 0 || perSig.count(sig) == 0) {
+                    retained[c] = true;
+                    break;
+                }
+            }
+        }
+
+        for (size_t c = 0; c < chains.size(); ++c) {
+            if (retained[c]) {
+                continue;
+            }
+            // find a retained host index for every search of this chain whose
+            // order prefix covers at least half of the search columns
+            std::map<SearchSignature, SearchSignature> plan;
+            bool coverable = true;
+            for (auto sig : chains[c]) {
+                size_t bestLength = 0;
+                SearchSignature bestPrefix = 0;
+                for (size_t h = 0; h < chains.size(); ++h) {
+                    if (h == c || !retained[h]) {
+                        continue;
+                    }
+                    size_t length = 0;
+                    SearchSignature covered = 0;
+                    for (int column : orders[h]) {
+                        if ((sig & (SearchSignature(1) << column)) == 0) {
+                            break;
+                        }
+                        covered |= SearchSignature(1) << column;
+                        ++length;
+                    }
+                    if (length > bestLength) {
+                        bestLength = length;
+                        bestPrefix = covered;
+                    }
+                }
+                if (bestLength == 0 || 2 * bestLength < card(sig)) {
+                    coverable = false;
+                    break;
+                }
+                plan[sig] = bestPrefix;
+            }
+            if (!coverable) {
+                // other chains may still redirect their searches to this one
+                retained[c] = true;
+                continue;
+            }
+            for (auto& redirect : plan) {
+                if (redirect.second == redirect.first) {
+                    // already a pure prefix of the host; nothing to rewrite
+                    continue;
+                }
+                for (const auto* scan : perSig[redirect.first]) {
+                    weakened[scan] = redirect.second;
+                }
+            }
+        }
+    }
+
+    if (weakened.empty()) {
+        return false;
+    }
+
+    visitDepthFirst(program, [&](const RamQuery& query) {
+        std::function<std::unique_ptr<RamNode>(std::unique_ptr<RamNode>)> prefixRewriter =
+                [&](std::unique_ptr<RamNode> node) -> std::unique_ptr<RamNode> {
+            if (const RamIndexScan* iscan = dynamic_cast<RamIndexScan*>(node.get())) {
+                auto pos = weakened.find(iscan);
+                if (pos != weakened.end()) {
+                    node = rewriteToPrefix(iscan, pos->second);
+                }
+            }
+            node->apply(makeLambdaRamMapper(prefixRewriter));
+            return node;
+        };
+        const_cast<RamQuery*>(&query)->apply(makeLambdaRamMapper(prefixRewriter));
+    });
+    return true;
+}
+
 }  // end of namespace souffle
@@ -16,6 +16,7 @@
 
 #pragma once
 
+#include "RamCardinalityAnalysis.h"
 #include "RamIndexAnalysis.h"
 #include "RamLevelAnalysis.h"
 #include "RamTransformer.h"
@@ -180,6 +181,121 @@ protected:
     }
 };
 
+/**
+ * @class ConstantPropagationTransformer
+ * @brief Evaluates constant sub-expressions and conditions at transformation time
+ *
+ * Intrinsic operators whose arguments are all constants are replaced
+ * by their result, and constraints over two constants are replaced by
+ * true/false. Filters guarded by a condition that folded to true are
+ * removed, so the condition is evaluated once (at transformation time)
+ * instead of once per iteration. For example ..
+ *
+ * ~~~~~~~~~~~~~~~~~~~~~~~~~~~
+ *  QUERY
+ *   ...
+ *    IF (number(2) < number(3))
+ *     ...
+ * ~~~~~~~~~~~~~~~~~~~~~~~~~~~
+ *
+ * will be rewritten to
+ *
+ * ~~~~~~~~~~~~~~~~~~~~~~~~~~~
+ *  QUERY
+ *   ...
+ * ~~~~~~~~~~~~~~~~~~~~~~~~~~~
+ *
+ * Affine operator chains over a non-constant operand are strength
+ * reduced as well: constants commute to the right, subtractions of a
+ * constant become additions, and adjacent constants of chained
+ * additions or multiplications merge, so an expression such as
+ * ((x + 1) + 2) - 3 costs a single operation per tuple instead of an
+ * expression-tree walk in both the interpreter and generated code.
+ *
+ * The transformer also removes filter operations whose existence check
+ * is already established by an enclosing filter in the same loop nest,
+ * so identical existence checks are evaluated at most once per query.
+ * Conditions that cannot be decided here (string operators need the
+ * symbol table, division by a constant zero must fail at run time)
+ * are left untouched; ground conditions that survive folding are
+ * hoisted to the query level by HoistConditionsTransformer, where they
+ * act as a boolean computed once per statement.
+ */
+class ConstantPropagationTransformer : public RamTransformer {
+public:
+    std::string getName() const override {
+        return "ConstantPropagationTransformer";
+    }
+
+    /**
+     * @brief Propagate constants through expressions and conditions.
+     * @param program that is transformed
+     * @return Flag showing whether the program has been changed by the transformation
+     */
+    bool propagateConstants(RamProgram& program);
+
+protected:
+    bool transform(RamTranslationUnit& translationUnit) override {
+        return propagateConstants(*translationUnit.getProgram());
+    }
+};
+
+/**
+ * @class EqualityCompressionTransformer
+ * @brief Canonicalizes tuple-element references and removes redundant
+ * equality filters.
+ *
+ * An equality filter establishes that its two operands carry the same
+ * value for the whole nested scope. The transformer tracks these
+ * equivalence classes along the loop nest, rewrites tuple-element
+ * references below an equality to a canonical representative of their
+ * class, and drops equality filters whose operands are already known
+ * to be equal.
+ *
+ * For example ..
+ *
+ * ~~~~~~~~~~~~~~~~~~~~~~~~~~~
+ *  QUERY
+ *   ...
+ *    IF t1.0 = t0.0
+ *     IF t2.0 = t1.0
+ *      IF t2.0 = t0.0
+ *       ...
+ * ~~~~~~~~~~~~~~~~~~~~~~~~~~~
+ *
+ * will be rewritten to
+ *
+ * ~~~~~~~~~~~~~~~~~~~~~~~~~~~
+ *  QUERY
+ *   ...
+ *    IF t1.0 = t0.0
+ *     IF t2.0 = t0.0
+ *      ...
+ * ~~~~~~~~~~~~~~~~~~~~~~~~~~~
+ *
+ * Constants are preferred as representatives, followed by the element
+ * of the outermost tuple, so canonicalization also feeds constant
+ * propagation and gives later filters the smallest possible level.
+ */
+class EqualityCompressionTransformer : public RamTransformer {
+public:
+    std::string getName() const override {
+        return "EqualityCompressionTransformer";
+    }
+
+    /**
+     * @brief Canonicalize element references and remove redundant equalities
+     * @param program Program that is transformed
+     * @return Flag showing whether the program has been changed by the transformation
+     */
+    bool compressEqualities(RamProgram& program);
+
+protected:
+    bool transform(RamTranslationUnit& translationUnit) override {
+        return compressEqualities(*translationUnit.getProgram());
+    }
+};
+
 /**
  * @class MakeIndexTransformer
  * @brief Make indexable operations to indexed operations.
@@ -205,6 +321,12 @@ protected:
  *     IF C
  *      ...
  * ~~~~~~~~~~~~~~~~~~~~~~~~~~~
+ *
+ * Inequality conditions of the format t1.x < <expression> (and <=, >, >=)
+ * are turned into inclusive range bounds on the selected index such that
+ * the scan only covers the relevant section of the ordered index. The
+ * inequality conditions themselves are retained as filters since the
+ * bounds merely prune the range that is searched.
  */
 
 class MakeIndexTransformer : public RamTransformer {
@@ -225,16 +347,52 @@ public:
      */
     std::unique_ptr<RamExpression> getExpression(RamCondition* c, size_t& element, int level);
 
+    /**
+     * @brief Get bound expression of an inequality constraint
+     *
+     * @param Inequality constraint of the format t1.x <op> <expression> or <expression> <op> t1.x
+     *        where <op> is one of <, <=, >, >=
+     * @param Element that was accessed, e.g., for t1.x this would be the index of attribute x.
+     * @param Flag set to true if the expression is a lower bound of the element, false for an upper bound
+     * @param Tuple identifier
+     *
+     * The method retrieves the (inclusive) bound expression of an inequality constraint;
+     * strict inequalities are relaxed to inclusive bounds since the original constraint
+     * is always retained as a filter.
+     */
+    std::unique_ptr<RamExpression> getBoundExpression(
+            RamCondition* c, size_t& element, bool& isLowerBound, int level);
+
     /**
      * @brief Construct query patterns for an indexable operation
+     * @param Relation that is queried by the operation
      * @param Query pattern that is to be constructed
+     * @param Lower bounds per column that are to be constructed (cleared if no bound is found)
+     * @param Upper bounds per column that are to be constructed (cleared if no bound is found)
      * @param Flag to indicate whether operation is indexable
      * @param A list of conditions that will be transformed to query patterns
      * @param Tuple identifier of the indexable operation
      * @result Remaining conditions that could not be transformed to an index
      */
-    std::unique_ptr<RamCondition> constructPattern(std::vector<std::unique_ptr<RamExpression>>& queryPattern,
-            bool& indexable, std::vector<std::unique_ptr<RamCondition>> conditionList, int identifier);
+    std::unique_ptr<RamCondition> constructPattern(const RamRelation& rel,
+            std::vector<std::unique_ptr<RamExpression>>& queryPattern,
+            std::vector<std::unique_ptr<RamExpression>>& rangeLower,
+            std::vector<std::unique_ptr<RamExpression>>& rangeUpper, bool& indexable,
+            std::vector<std::unique_ptr<RamCondition>> conditionList, int identifier);
+
+    /**
+     * @brief Re-establish equality constraints of a query pattern as filters
+     * @param Remaining condition the equalities are appended to
+     * @param Query pattern whose defined entries are turned into equality constraints
+     * @param Tuple identifier of the indexable operation
+     * @result The extended condition
+     *
+     * A range query with inequality bounds is only exact for a pure equality
+     * prefix of the selected index; the equalities therefore need to be
+     * re-checked by a filter when bounds are attached.
+     */
+    std::unique_ptr<RamCondition> addEqualityFilters(std::unique_ptr<RamCondition> condition,
+            const std::vector<std::unique_ptr<RamExpression>>& queryPattern, int identifier);
 
     /**
      * @brief Rewrite a scan operation to an indexed scan operation
@@ -269,8 +427,10 @@ public:
 
 protected:
     RamLevelAnalysis* rla{nullptr};
+    RamCardinalityAnalysis* rca{nullptr};
     bool transform(RamTranslationUnit& translationUnit) override {
         rla = translationUnit.getAnalysis<RamLevelAnalysis>();
+        rca = translationUnit.getAnalysis<RamCardinalityAnalysis>();
         return makeIndex(*translationUnit.getProgram());
     }
 };
@@ -402,12 +562,269 @@ public:
 
 protected:
     RamLevelAnalysis* rla{nullptr};
+    RamCardinalityAnalysis* rca{nullptr};
     bool transform(RamTranslationUnit& translationUnit) override {
         rla = translationUnit.getAnalysis<RamLevelAnalysis>();
+        rca = translationUnit.getAnalysis<RamCardinalityAnalysis>();
         return convertScans(*translationUnit.getProgram());
     }
 };
 
+/**
+ * @class ScanOrderTransformer
+ * @brief Order nested full scans by decreasing relation cardinality
+ *
+ * A pair of directly nested full scans forms a cross product whose
+ * iteration count is independent of the loop order. Placing the larger
+ * relation in the outer loop keeps the inner relation resident in
+ * cache and gives a later parallelisation of the outer loop more
+ * chunks to distribute. Using the estimates of RamCardinalityAnalysis,
+ *
+ * ~~~~~~~~~~~~~~~~~~~~~~~~~~~
+ *  QUERY
+ *   FOR t0 IN A       // small
+ *    FOR t1 IN B      // large
+ *     ...
+ * ~~~~~~~~~~~~~~~~~~~~~~~~~~~
+ *
+ * will be rewritten to
+ *
+ * ~~~~~~~~~~~~~~~~~~~~~~~~~~~
+ *  QUERY
+ *   FOR t1 IN B
+ *    FOR t0 IN A
+ *     ...
+ * ~~~~~~~~~~~~~~~~~~~~~~~~~~~
+ *
+ * Scans with patterns or intervening filters are never reordered since
+ * they may depend on outer tuples. The swap leaves tuple identifiers
+ * out of nesting order, so the transformer must be followed by
+ * TupleIdTransformer.
+ */
+class ScanOrderTransformer : public RamTransformer {
+public:
+    std::string getName() const override {
+        return "ScanOrderTransformer";
+    }
+
+    /**
+     * @brief Reorder directly nested full scans by cardinality
+     * @param RAM program that is transformed
+     * @result Flag that indicates whether the input program has changed
+     */
+    bool orderScans(RamProgram& program);
+
+protected:
+    RamCardinalityAnalysis* rca{nullptr};
+    bool transform(RamTranslationUnit& translationUnit) override {
+        rca = translationUnit.getAnalysis<RamCardinalityAnalysis>();
+        return orderScans(*translationUnit.getProgram());
+    }
+};
+
+/**
+ * @class HashJoinTransformer
+ * @brief Convert one-shot IndexScan operations to HashScan operations
+ *
+ * If an index of a relation would be used by exactly one equality
+ * IndexScan in the whole program, and that scan sits outside of any
+ * loop, maintaining the index for a single traversal is wasted work;
+ * the scan is rewritten to probe a transient hash table built on the
+ * scanned relation instead.
+ *
+ * For example,
+ *
+ * ~~~~~~~~~~~~~~~~~~~~~~~~~~~
+ *  QUERY
+ *   ...
+ *    FOR t1 IN A ON INDEX t1.x = t0.0
+ *      ...
+ * ~~~~~~~~~~~~~~~~~~~~~~~~~~~
+ *
+ * will be rewritten to
+ *
+ * ~~~~~~~~~~~~~~~~~~~~~~~~~~~
+ *  QUERY
+ *   ...
+ *    HASH FOR t1 IN A ON INDEX t1.x = t0.0
+ *      ...
+ * ~~~~~~~~~~~~~~~~~~~~~~~~~~~
+ *
+ */
+class HashJoinTransformer : public RamTransformer {
+public:
+    std::string getName() const override {
+        return "HashJoinTransformer";
+    }
+
+    /**
+     * @brief Apply hash-join conversion to the whole program
+     * @param RAM program
+     * @result A flag indicating whether the RAM program has been changed.
+     *
+     * Search for one-shot equality IndexScans outside of loops and
+     * rewrite them to HashScans.
+     */
+    bool convertIndexScans(RamTranslationUnit& translationUnit);
+
+protected:
+    bool transform(RamTranslationUnit& translationUnit) override {
+        return convertIndexScans(translationUnit);
+    }
+};
+
+/**
+ * @class QueryFusionTransformer
+ * @brief Fuse adjacent queries whose outer loops scan the same relation
+ *
+ * When several rules of a stratum scan the same relation, evaluating
+ * them one after another re-reads that relation from memory for every
+ * rule. Fusing them under a single scan evaluates all rule bodies
+ * while the current tuple is still cache-resident.
+ *
+ * For example,
+ *
+ * ~~~~~~~~~~~~~~~~~~~~~~~~~~~
+ *  QUERY
+ *   FOR t0 IN A
+ *    ...
+ *  QUERY
+ *   FOR t0 IN A
+ *    ...
+ * ~~~~~~~~~~~~~~~~~~~~~~~~~~~
+ *
+ * will be rewritten to
+ *
+ * ~~~~~~~~~~~~~~~~~~~~~~~~~~~
+ *  QUERY
+ *   FOR t0 IN A
+ *    SPLIT
+ *     ...
+ *    AND
+ *     ...
+ * ~~~~~~~~~~~~~~~~~~~~~~~~~~~
+ *
+ * Queries are only fused if no query of the run writes a relation
+ * another one reads, so the fused evaluation order is observationally
+ * equivalent to the sequential one.
+ *
+ * Within a fused query, scan prefixes the rule bodies still share
+ * beyond the outer loop are factored as well: bodies opening with the
+ * same scan of the same relation -- for index scans, with an identical
+ * range pattern -- hand their continuations to one shared scan, so
+ * rules agreeing on several leading atoms walk the whole common
+ * prefix once.
+ */
+class QueryFusionTransformer : public RamTransformer {
+public:
+    std::string getName() const override {
+        return "QueryFusionTransformer";
+    }
+
+    /**
+     * @brief Apply query fusion to the whole program
+     * @param RAM translation unit
+     * @result A flag indicating whether the RAM program has been changed.
+     *
+     * Search for runs of adjacent queries sharing an outer scan and
+     * fuse them into a single query.
+     */
+    bool fuseQueries(RamTranslationUnit& translationUnit);
+
+protected:
+    bool transform(RamTranslationUnit& translationUnit) override {
+        return fuseQueries(translationUnit);
+    }
+};
+
+/**
+ * @class CopyElisionTransformer
+ * @brief Rewrite pure copy rules into relation-level merges
+ *
+ * Rules of the form R(x,y) :- S(x,y) translate into a query scanning S
+ * and projecting every tuple unchanged into R, i.e. a tuple-by-tuple
+ * copy through the full operation machinery. Such queries are detected
+ * and replaced by a merge statement, which the engines execute as a
+ * bulk insertAll on the target data structure.
+ *
+ * For example,
+ *
+ * ~~~~~~~~~~~~~~~~~~~~~~~~~~~
+ *  QUERY
+ *   FOR t0 IN S
+ *    IF (t0.0, t0.1) ∉ R
+ *     PROJECT (t0.0, t0.1) INTO R
+ * ~~~~~~~~~~~~~~~~~~~~~~~~~~~
+ *
+ * will be rewritten to
+ *
+ * ~~~~~~~~~~~~~~~~~~~~~~~~~~~
+ *  MERGE R WITH S
+ * ~~~~~~~~~~~~~~~~~~~~~~~~~~~
+ *
+ * The guarding non-existence check is redundant under set-insertion
+ * semantics and may be elided with the copy. Equivalence relations are
+ * excluded, as merging into them extends the source relation with the
+ * target's knowledge, which a plain copy does not.
+ */
+class CopyElisionTransformer : public RamTransformer {
+public:
+    std::string getName() const override {
+        return "CopyElisionTransformer";
+    }
+
+    /**
+     * @brief Replace copy queries by merge statements
+     * @param RAM translation unit
+     * @result A flag indicating whether the RAM program has been changed.
+     */
+    bool elideCopies(RamTranslationUnit& translationUnit);
+
+protected:
+    bool transform(RamTranslationUnit& translationUnit) override {
+        return elideCopies(translationUnit);
+    }
+};
+
+/**
+ * @class RelationAliasTransformer
+ * @brief Share one relation object between a bridge relation and its source
+ *
+ * Component composition produces bridging relations that are populated by
+ * a single pure copy rule, which copy elision has already turned into
+ *
+ * ~~~~~~~~~~~~~~~~~~~~~~~~~~~
+ *  MERGE R WITH S
+ * ~~~~~~~~~~~~~~~~~~~~~~~~~~~
+ *
+ * When this merge is the only write of R and S receives no further tuples
+ * once it runs, R holds exactly the content of S and its materialization
+ * is redundant: every reference to R is redirected to S and both R's
+ * creation and the merge are removed, leaving one relation object carrying
+ * both names. Store statements keep their own IO directives, so the
+ * outputs of R are still written under R's external name. Relations with
+ * non-set insertion semantics (equivalence, subsumption and functional
+ * relations) are excluded on either side.
+ */
+class RelationAliasTransformer : public RamTransformer {
+public:
+    std::string getName() const override {
+        return "RelationAliasTransformer";
+    }
+
+    /**
+     * @brief Alias bridge relations to their sources
+     * @param RAM translation unit
+     * @result A flag indicating whether the RAM program has been changed.
+     */
+    bool aliasRelations(RamTranslationUnit& translationUnit);
+
+protected:
+    bool transform(RamTranslationUnit& translationUnit) override {
+        return aliasRelations(translationUnit);
+    }
+};
+
 /**
  * @class TupleIdTransformer
  * @brief Ordering tupleIds in RamTupleOperation operations correctly
@@ -482,6 +899,74 @@ protected:
     }
 };
 
+/**
+ * @class IncrementalAggregateTransformer
+ * @brief Maintain monotone aggregates inside fixpoint loops incrementally
+ *
+ * An aggregate over a recursive relation that sits inside the
+ * relation's own fixpoint loop is recomputed from scratch in every
+ * semi-naive iteration, even though only the delta tuples are new.
+ * Since min/max/count/sum are monotone folds and the delta relations
+ * of successive iterations are disjoint, the aggregate can instead be
+ * maintained in a unary cache relation that is updated from the delta
+ * relation once per iteration.
+ *
+ * For example,
+ *
+ * ~~~~~~~~~~~~~~~~~~~~~~~~~~~
+ *  LOOP
+ *   QUERY
+ *    t0.0 = MAX t1.1 FOR ALL t1 IN A
+ *     ...
+ *   ...
+ *   SWAP (@delta_A, @new_A)
+ *  END LOOP
+ * ~~~~~~~~~~~~~~~~~~~~~~~~~~~
+ *
+ * will be rewritten to
+ *
+ * ~~~~~~~~~~~~~~~~~~~~~~~~~~~
+ *  CREATE @agg_cache_0
+ *  LOOP
+ *   QUERY
+ *    t0.0 = MAX t0.1 FOR ALL t0 IN @delta_A
+ *     PROJECT (t0.0) INTO @agg_cache_0
+ *   QUERY
+ *    t0.0 = MAX t0.0 FOR ALL t0 IN @agg_cache_0
+ *     ...
+ *   ...
+ *   SWAP (@delta_A, @new_A)
+ *  END LOOP
+ * ~~~~~~~~~~~~~~~~~~~~~~~~~~~
+ *
+ * A count over the cache sums the per-iteration partial counts, so
+ * COUNT is rewritten to a SUM over the cached values. Aggregates are
+ * only rewritten if their condition and target expression refer to no
+ * tuple but the aggregate's own and the condition does not consult
+ * another relation; otherwise the per-tuple contribution may change
+ * between iterations and the delta-folding argument breaks down.
+ * Grouped aggregates (RamIndexAggregate) are left untouched, hence
+ * this transformer must run before index conversion.
+ */
+class IncrementalAggregateTransformer : public RamTransformer {
+public:
+    std::string getName() const override {
+        return "IncrementalAggregateTransformer";
+    }
+
+    /**
+     * @brief Apply incremental aggregate maintenance to the whole program
+     * @param RAM program
+     * @result A flag indicating whether the RAM program has been changed.
+     */
+    bool incrementAggregates(RamProgram& program);
+
+protected:
+    bool transform(RamTranslationUnit& translationUnit) override {
+        return incrementAggregates(*translationUnit.getProgram());
+    }
+};
+
 /**
  * @class ParallelTransformer
  * @brief Transforms Choice/IndexChoice/IndexScan/Scan into parallel versions.
@@ -522,6 +1007,124 @@ protected:
     }
 };
 
+/**
+ * @class IndexConsolidationTransformer
+ * @brief Shares one index among prefix-compatible searches.
+ *
+ * The minimal chain cover of RamIndexAnalysis merges searches along
+ * subset chains, but every remaining chain still materializes a full
+ * copy of the relation. This transformer drops an index whose searches
+ * all stem from plain scans by weakening those scans to a prefix of a
+ * retained index, re-checking the no-longer-indexed equalities with a
+ * filter:
+ *
+ * ~~~~~~~~~~~~~~~~~~~~~~~~~~~
+ *  QUERY
+ *   ...
+ *   SEARCH t1 IN A INDEX t1.x=10 AND t1.z=30  // needs index (x,z)
+ *    ...
+ * ~~~~~~~~~~~~~~~~~~~~~~~~~~~
+ *
+ * given a retained index ordered (x,y,...) will be rewritten to
+ *
+ * ~~~~~~~~~~~~~~~~~~~~~~~~~~~
+ *  QUERY
+ *   ...
+ *   SEARCH t1 IN A INDEX t1.x=10
+ *    IF t1.z=30
+ *     ...
+ * ~~~~~~~~~~~~~~~~~~~~~~~~~~~
+ *
+ * Existence checks, choices and aggregates need exact ranges and pin
+ * their indexes; an index is only dropped when every search of its
+ * chain can be redirected to a retained index whose order prefix
+ * covers at least half of the search columns, bounding the extra
+ * tuples the weakened scans have to filter out.
+ */
+class IndexConsolidationTransformer : public RamTransformer {
+public:
+    std::string getName() const override {
+        return "IndexConsolidationTransformer";
+    }
+
+    /**
+     * @brief Weaken a scan to an equality prefix of a retained index
+     * @param An IndexScan whose search is redirected to another index
+     * @param The subset of the search columns the retained index covers as a prefix
+     * @result The weakened IndexScan with the remaining equalities as filters
+     */
+    std::unique_ptr<RamOperation> rewriteToPrefix(const RamIndexScan* iscan, SearchSignature prefix);
+
+    /**
+     * @brief Consolidate the index sets of all relations
+     * @param RAM translation unit
+     * @result A flag indicating whether the RAM program has been changed.
+     */
+    bool consolidate(RamTranslationUnit& translationUnit);
+
+protected:
+    bool transform(RamTranslationUnit& translationUnit) override {
+        return consolidate(translationUnit);
+    }
+};
+
+/**
+ * @class EagerDropTransformer
+ * @brief Move relation drops directly behind their last reader
+ *
+ * The AST translator emits drops at conservatively computed stratum
+ * exit points, so a relation only read by early strata can sit in
+ * memory for the remainder of the run. This transformer computes the
+ * precise last use of each dropped relation over the top-level strata
+ * of the main program and relocates its drop to the end of that
+ * stratum, releasing the memory as soon as the final reader completes.
+ *
+ * For example,
+ *
+ * ~~~~~~~~~~~~~~~~~~~~~~~~~~~
+ *  BEGIN_STRATUM 1
+ *   ... last use of A ...
+ *  END_STRATUM 1
+ *  ...
+ *  BEGIN_STRATUM 7
+ *   DROP A
+ *  END_STRATUM 7
+ * ~~~~~~~~~~~~~~~~~~~~~~~~~~~
+ *
+ * will be rewritten to
+ *
+ * ~~~~~~~~~~~~~~~~~~~~~~~~~~~
+ *  BEGIN_STRATUM 1
+ *   ... last use of A ...
+ *   DROP A
+ *  END_STRATUM 1
+ * ~~~~~~~~~~~~~~~~~~~~~~~~~~~
+ *
+ * Only existing drops are moved; relations the translator decided to
+ * keep (e.g. under provenance) remain untouched. Drops whose last use
+ * lies in a parallel block of strata are left at their conservative
+ * position, as a concurrently executing stratum completes at an
+ * unknown time.
+ */
+class EagerDropTransformer : public RamTransformer {
+public:
+    std::string getName() const override {
+        return "EagerDropTransformer";
+    }
+
+    /**
+     * @brief Relocate drops to the stratum of their last reader
+     * @param RAM translation unit
+     * @result A flag indicating whether the RAM program has been changed.
+     */
+    bool eagerDrops(RamTranslationUnit& translationUnit);
+
+protected:
+    bool transform(RamTranslationUnit& translationUnit) override {
+        return eagerDrops(translationUnit);
+    }
+};
+
 /**
  * @class ReportIndexSetsTransformer
  * @brief does not transform the program but reports on the index sets
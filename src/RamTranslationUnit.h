@@ -26,6 +26,7 @@
 #include <map>
 #include <memory>
 #include <mutex>
+#include <set>
 #include <string>
 
 namespace souffle {
@@ -58,6 +59,9 @@ public:
             if (it == analyses.end()) {
                 analyses[name] = std::move(analysis);
             }
+        } else if (staleAnalyses.erase(name) != 0) {
+            // the analysis survived an invalidation; refresh its results
+            it->second->run(*this);
         }
         return dynamic_cast<Analysis*>(analyses[name].get());
     }
@@ -71,9 +75,18 @@ public:
         return result;
     }
 
-    /** @brief throw away all alive analyses of the translation unit */
+    /** @brief throw away invalidated analyses of the translation unit.
+     * Analyses able to refresh their results incrementally survive and
+     * are re-run on their next use; all others are discarded. */
     void invalidateAnalyses() {
-        analyses.clear();
+        for (auto it = analyses.begin(); it != analyses.end();) {
+            if (it->second->invalidate()) {
+                staleAnalyses.insert(it->first);
+                ++it;
+            } else {
+                it = analyses.erase(it);
+            }
+        }
     }
 
     /** @brief get the const RAM Program of the translation unit  */
@@ -115,6 +128,10 @@ protected:
     /* cached analyses */
     mutable std::map<std::string, std::unique_ptr<RamAnalysis>> analyses;
 
+    /* analyses that survived an invalidation and must be re-run before
+     * their next use */
+    mutable std::set<std::string> staleAnalyses;
+
     /* Program RAM */
     std::unique_ptr<RamProgram> program;
 
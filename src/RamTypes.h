@@ -48,4 +48,25 @@ using RamDomain = int32_t;
  * no value exists (i.e. attribute is unbounded) in the search. */
 using SearchSignature = uint64_t;
 
+/** With provenance instrumentation enabled, the rule number and derivation
+ * height of a tuple are packed into a single hidden attribute. The rule
+ * number occupies the low-order bits and the height the remaining bits, so
+ * comparing packed annotations compares heights first. */
+constexpr int PROVENANCE_RULE_BITS = 12;
+
+/** pack a rule number and a derivation height into a single annotation */
+inline RamDomain packProvenance(RamDomain ruleNum, RamDomain levelNum) {
+    return (levelNum << PROVENANCE_RULE_BITS) | ruleNum;
+}
+
+/** extract the rule number from a packed provenance annotation */
+inline RamDomain provenanceRuleNumber(RamDomain packed) {
+    return packed & ((RamDomain(1) << PROVENANCE_RULE_BITS) - 1);
+}
+
+/** extract the derivation height from a packed provenance annotation */
+inline RamDomain provenanceLevelNumber(RamDomain packed) {
+    return packed >> PROVENANCE_RULE_BITS;
+}
+
 }  // end of namespace souffle
@@ -96,6 +96,7 @@ struct RamVisitor : public ram_visitor_tag {
         FORWARD(EmptinessCheck);
         FORWARD(ExistenceCheck);
         FORWARD(ProvenanceExistenceCheck);
+        FORWARD(SubsumptionCheck);
         FORWARD(Conjunction);
         FORWARD(Negation);
         FORWARD(Constraint);
@@ -103,23 +104,27 @@ struct RamVisitor : public ram_visitor_tag {
         // Operations
         FORWARD(Filter);
         FORWARD(Break);
+        FORWARD(Split);
         FORWARD(Project);
         FORWARD(SubroutineReturnValue);
         FORWARD(UnpackRecord);
         FORWARD(ParallelScan);
         FORWARD(Scan);
         FORWARD(ParallelIndexScan);
+        FORWARD(HashScan);
         FORWARD(IndexScan);
         FORWARD(ParallelChoice);
         FORWARD(Choice);
         FORWARD(ParallelIndexChoice);
         FORWARD(IndexChoice);
+        FORWARD(ParallelAggregate);
         FORWARD(Aggregate);
         FORWARD(IndexAggregate);
 
         // Statements
         FORWARD(Create);
         FORWARD(Fact);
+        FORWARD(FactTable);
         FORWARD(Load);
         FORWARD(Store);
         FORWARD(Query);
@@ -171,6 +176,7 @@ protected:
     // -- statements --
     LINK(Create, RelationStatement);
     LINK(Fact, RelationStatement);
+    LINK(FactTable, RelationStatement);
     LINK(Load, AbstractLoadStore);
     LINK(Store, AbstractLoadStore);
     LINK(AbstractLoadStore, RelationStatement);
@@ -205,11 +211,13 @@ protected:
     LINK(ParallelScan, Scan);
     LINK(IndexScan, IndexOperation);
     LINK(ParallelIndexScan, IndexScan);
+    LINK(HashScan, IndexScan);
     LINK(Choice, RelationOperation);
     LINK(ParallelChoice, Choice);
     LINK(IndexChoice, IndexOperation);
     LINK(ParallelIndexChoice, IndexChoice);
     LINK(RelationOperation, TupleOperation);
+    LINK(ParallelAggregate, Aggregate);
     LINK(Aggregate, RelationOperation);
     LINK(IndexAggregate, IndexOperation);
     LINK(IndexOperation, RelationOperation);
@@ -217,6 +225,7 @@ protected:
     LINK(Filter, AbstractConditional);
     LINK(Break, AbstractConditional);
     LINK(AbstractConditional, NestedOperation);
+    LINK(Split, Operation);
     LINK(NestedOperation, Operation);
 
     LINK(Operation, Node);
@@ -229,6 +238,7 @@ protected:
     LINK(Constraint, Condition);
     LINK(ExistenceCheck, AbstractExistenceCheck);
     LINK(ProvenanceExistenceCheck, AbstractExistenceCheck);
+    LINK(SubsumptionCheck, AbstractExistenceCheck);
     LINK(EmptinessCheck, Condition);
     LINK(AbstractExistenceCheck, Condition);
 
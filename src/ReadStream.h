@@ -28,21 +28,85 @@ class ReadStream {
 public:
     ReadStream(const std::vector<bool>& symbolMask, SymbolTable& symbolTable, const bool prov)
             : symbolMask(symbolMask), symbolTable(symbolTable), isProvenance(prov),
-              arity(symbolMask.size() - (prov ? 2 : 0)) {}
+              arity(symbolMask.size() - (prov ? 1 : 0)) {}
     template <typename T>
     void readAll(T& relation) {
+        // batch-capable streams parse whole blocks of tuples at once and
+        // synchronize symbol-table accesses internally, enabling parallel
+        // parsing and insertion
+        if (canReadBatches()) {
+            const auto width = symbolMask.size();
+            std::vector<RamDomain> buffer;
+            std::size_t count;
+            while ((count = readNextBatch(buffer)) > 0) {
+#ifdef _OPENMP
+#pragma omp parallel for schedule(dynamic, 1024)
+#endif
+                for (std::size_t i = 0; i < count; ++i) {
+                    relation.insert(&buffer[i * width]);
+                }
+            }
+            return;
+        }
+
         auto lease = symbolTable.acquireLock();
         (void)lease;
-        while (const auto next = readNextTuple()) {
-            const RamDomain* ramDomain = next.get();
-            relation.insert(ramDomain);
+        std::vector<RamDomain> tuple(symbolMask.size());
+        while (readNextTupleInto(tuple.data())) {
+            relation.insert(tuple.data());
+        }
+    }
+
+    /**
+     * Reads the whole stream into a flat buffer of symbolMask.size()-wide
+     * tuples, deferring relation insertion to the caller. Only batch-capable
+     * streams support this: they synchronize their symbol-table accesses
+     * internally and may hence parse concurrently with rule evaluation.
+     *
+     * @return false if this stream cannot be staged into a buffer
+     */
+    bool readAllInto(std::vector<RamDomain>& buffer) {
+        if (!canReadBatches()) {
+            return false;
         }
+        const auto width = symbolMask.size();
+        std::vector<RamDomain> batch;
+        std::size_t count;
+        while ((count = readNextBatch(batch)) > 0) {
+            buffer.insert(buffer.end(), batch.begin(), batch.begin() + count * width);
+        }
+        return true;
     }
 
     virtual ~ReadStream() = default;
 
 protected:
-    virtual std::unique_ptr<RamDomain[]> readNextTuple() = 0;
+    /**
+     * Reads the next tuple into the caller-provided buffer of
+     * symbolMask.size() values, keeping the load path free of per-tuple
+     * allocations.
+     *
+     * @return false if no tuple was readable
+     */
+    virtual bool readNextTupleInto(RamDomain* tuple) = 0;
+
+    /**
+     * Determines whether this stream hands out whole batches of tuples
+     * via readNextBatch() instead of single tuples.
+     */
+    virtual bool canReadBatches() const {
+        return false;
+    }
+
+    /**
+     * Reads the next batch of tuples into the given buffer, holding
+     * symbolMask.size() consecutive values per tuple.
+     *
+     * @return the number of tuples read, 0 at the end of the stream
+     */
+    virtual std::size_t readNextBatch(std::vector<RamDomain>& /* buffer */) {
+        return 0;
+    }
     const std::vector<bool>& symbolMask;
     SymbolTable& symbolTable;
     const bool isProvenance;
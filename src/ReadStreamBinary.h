@@ -0,0 +1,202 @@
+/*
+ * Souffle - A Datalog Compiler
+ * Copyright (c) 2013, 2014, Oracle and/or its affiliates. All rights reserved
+ * Licensed under the Universal Permissive License v 1.0 as shown at:
+ * - https://opensource.org/licenses/UPL
+ * - <souffle root>/licenses/SOUFFLE-UPL.txt
+ */
+
+/************************************************************************
+ *
+ * @file ReadStreamBinary.h
+ *
+ * A reader for the native binary relation format produced by
+ * WriteStreamBinary.h. Tuples are handed out in whole batches via the
+ * batch-reading hook of ReadStream, requiring no per-value parsing --
+ * only symbol columns are translated from their file-local indices
+ * into the current symbol table.
+ *
+ * The file is attached as a shared read-only memory mapping rather than
+ * being read into private buffers. All processes loading the same fact
+ * base therefore share a single physical copy of its pages, and those
+ * pages remain clean, file-backed memory the kernel can simply drop
+ * under pressure -- a fleet of analysis variants over one large fact
+ * base keeps it in memory once instead of once per process.
+ *
+ ***********************************************************************/
+
+#pragma once
+
+#include "IODirectives.h"
+#include "RamTypes.h"
+#include "ReadStream.h"
+#include "SymbolTable.h"
+#include "WriteStreamBinary.h"
+
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace souffle {
+
+class ReadFileBinary : public ReadStream {
+public:
+    ReadFileBinary(const std::vector<bool>& symbolMask, SymbolTable& symbolTable,
+            const IODirectives& ioDirectives, const bool provenance = false)
+            : ReadStream(symbolMask, symbolTable, provenance) {
+        const std::string filename = getFileName(ioDirectives);
+        int fd = ::open(filename.c_str(), O_RDONLY);
+        if (fd < 0) {
+            if (!ioDirectives.has("intermediate")) {
+                throw std::invalid_argument("Cannot open fact file " + filename + "\n");
+            }
+            return;
+        }
+        struct stat status;
+        if (fstat(fd, &status) != 0 || static_cast<std::size_t>(status.st_size) < sizeof(header)) {
+            close(fd);
+            throw std::invalid_argument("Cannot read header of fact file " + filename + "\n");
+        }
+        size = status.st_size;
+
+        // attach the file as a shared read-only mapping; the mapping (and
+        // thereby the physical pages) is shared with every other process
+        // loading the same file
+        void* mem = mmap(nullptr, size, PROT_READ, MAP_SHARED, fd, 0);
+        close(fd);
+        if (mem == MAP_FAILED) {
+            throw std::invalid_argument("Cannot map fact file " + filename + "\n");
+        }
+        data = static_cast<const char*>(mem);
+#ifdef MADV_SEQUENTIAL
+        madvise(mem, size, MADV_SEQUENTIAL);
+#endif
+
+        // the destructor does not run when the constructor throws -- drop
+        // the mapping explicitly on the validation paths
+        auto fail = [&](const std::string& message) {
+            munmap(mem, size);
+            data = nullptr;
+            throw std::invalid_argument(message);
+        };
+
+        std::memcpy(&header, data, sizeof(header));
+        if (header.magic != BinaryRelationHeader::MAGIC ||
+                header.version != BinaryRelationHeader::VERSION ||
+                header.domainSize != sizeof(RamDomain) || header.width != symbolMask.size()) {
+            fail("Incompatible binary fact file " + filename + "\n");
+        }
+        auto tupleBytes = header.numTuples * header.width * sizeof(RamDomain);
+        if (size < sizeof(header) + tupleBytes) {
+            fail("Corrupted binary fact file " + filename + "\n");
+        }
+
+        // resolve each file-local symbol index of the trailing symbol-table
+        // segment against the current symbol table
+        const char* cur = data + sizeof(header) + tupleBytes;
+        const char* end = data + size;
+        translation.reserve(header.numSymbols);
+        translationIsIdentity = true;
+        for (uint64_t i = 0; i < header.numSymbols; ++i) {
+            uint32_t length = 0;
+            if (cur + sizeof(length) > end) {
+                fail("Corrupted binary fact file " + filename + "\n");
+            }
+            std::memcpy(&length, cur, sizeof(length));
+            cur += sizeof(length);
+            if (cur + length > end) {
+                fail("Corrupted binary fact file " + filename + "\n");
+            }
+            RamDomain index = symbolTable.lookup(std::string(cur, length));
+            translationIsIdentity &= (index == static_cast<RamDomain>(i));
+            translation.push_back(index);
+            cur += length;
+        }
+    }
+
+    ~ReadFileBinary() override {
+        if (data != nullptr) {
+            munmap(const_cast<char*>(data), size);
+        }
+    }
+
+protected:
+    // the number of tuples handed out per batch
+    enum { BATCH_TUPLES = 1 << 20 };
+
+    bool canReadBatches() const override {
+        return header.width > 0;
+    }
+
+    std::size_t readNextBatch(std::vector<RamDomain>& buffer) override {
+        auto count = std::min<uint64_t>(header.numTuples - tuplesRead, BATCH_TUPLES);
+        if (count == 0) {
+            return 0;
+        }
+        buffer.resize(count * header.width);
+        std::memcpy(buffer.data(),
+                data + sizeof(header) + tuplesRead * header.width * sizeof(RamDomain),
+                buffer.size() * sizeof(RamDomain));
+        // translate symbol columns into the current symbol table; skipped
+        // entirely when the file-local indices already match, e.g. after a
+        // symbol-table snapshot restore
+        if (!translationIsIdentity) {
+            for (uint32_t col = 0; col < header.width; ++col) {
+                if (!symbolMask.at(col)) {
+                    continue;
+                }
+                for (std::size_t i = 0; i < count; ++i) {
+                    buffer[i * header.width + col] = translation.at(buffer[i * header.width + col]);
+                }
+            }
+        }
+        tuplesRead += count;
+        return count;
+    }
+
+    // only exercised for nullary relations; all others are batch-read
+    bool readNextTupleInto(RamDomain* /* tuple */) override {
+        if (tuplesRead >= header.numTuples) {
+            return false;
+        }
+        ++tuplesRead;
+        return true;
+    }
+
+    std::string getFileName(const IODirectives& ioDirectives) const {
+        if (ioDirectives.has("filename")) {
+            return ioDirectives.get("filename");
+        }
+        return ioDirectives.getRelationName() + ".facts";
+    }
+
+    const char* data = nullptr;
+    std::size_t size = 0;
+    BinaryRelationHeader header;
+    std::vector<RamDomain> translation;
+    bool translationIsIdentity = true;
+    uint64_t tuplesRead = 0;
+};
+
+class ReadFileBinaryFactory : public ReadStreamFactory {
+public:
+    std::unique_ptr<ReadStream> getReader(const std::vector<bool>& symbolMask, SymbolTable& symbolTable,
+            const IODirectives& ioDirectives, const bool provenance) override {
+        return std::make_unique<ReadFileBinary>(symbolMask, symbolTable, ioDirectives, provenance);
+    }
+    const std::string& getName() const override {
+        static const std::string name = "binary";
+        return name;
+    }
+    ~ReadFileBinaryFactory() override = default;
+};
+
+} /* namespace souffle */
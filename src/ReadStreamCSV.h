@@ -20,17 +20,34 @@
 #include "SymbolTable.h"
 #include "Util.h"
 
+#ifdef USE_LIBZSTD
+#include "zstdfstream.h"
+#endif
 #ifdef USE_LIBZ
 #include "gzfstream.h"
-#else
-#include <fstream>
 #endif
+#include <fstream>
 
+#include <algorithm>
+#include <limits>
 #include <map>
 #include <memory>
 #include <sstream>
 #include <stdexcept>
 #include <string>
+#include <string_view>
+#include <unordered_map>
+
+#include <cstdint>
+#include <cstring>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
 
 namespace souffle {
 
@@ -39,31 +56,71 @@ public:
     ReadStreamCSV(std::istream& file, const std::vector<bool>& symbolMask, SymbolTable& symbolTable,
             const IODirectives& ioDirectives, const bool provenance = false)
             : ReadStream(symbolMask, symbolTable, provenance), delimiter(getDelimiter(ioDirectives)),
-              file(file), lineNumber(0), inputMap(getInputColumnMap(ioDirectives, arity)) {
+              file(file), lineNumber(0), inputMap(getInputColumnMap(ioDirectives, arity)),
+              symbolCache(arity), symbolCacheEnabled(arity, true) {
         while (inputMap.size() < arity) {
             int size = inputMap.size();
             inputMap[size] = size;
         }
+        // flatten the column map and mask into a dense action table, so
+        // the parse loop neither probes the map nor branches on the mask
+        // per cell
+        for (const auto& cur : inputMap) {
+            if (cur.first >= static_cast<int>(columnActions.size())) {
+                columnActions.resize(cur.first + 1);
+            }
+            columnActions[cur.first].used = true;
+            columnActions[cur.first].target = cur.second;
+            columnActions[cur.first].symbol = symbolMask.at(cur.second);
+        }
+        if (ioDirectives.has("dictionary") && ioDirectives.get("dictionary") == "true") {
+            loadDictionary(ioDirectives);
+            dictionaryEnabled = true;
+        }
     }
 
     ~ReadStreamCSV() override = default;
 
+    static std::string getDelimiter(const IODirectives& ioDirectives) {
+        if (ioDirectives.has("delimiter")) {
+            return ioDirectives.get("delimiter");
+        }
+        return "\t";
+    }
+
+    static std::map<int, int> getInputColumnMap(const IODirectives& ioDirectives, const unsigned arity) {
+        std::string columnString = "";
+        if (ioDirectives.has("columns")) {
+            columnString = ioDirectives.get("columns");
+        }
+        std::map<int, int> inputMap;
+
+        if (!columnString.empty()) {
+            std::istringstream iss(columnString);
+            std::string mapping;
+            int index = 0;
+            while (std::getline(iss, mapping, ':')) {
+                inputMap[stoi(mapping)] = index++;
+            }
+            if (inputMap.size() < arity) {
+                throw std::invalid_argument("Invalid column set was given: <" + columnString + ">");
+            }
+        } else {
+            while (inputMap.size() < arity) {
+                int size = inputMap.size();
+                inputMap[size] = size;
+            }
+        }
+        return inputMap;
+    }
+
 protected:
-    /**
-     * Read and return the next tuple.
-     *
-     * Returns nullptr if no tuple was readable.
-     * @return
-     */
-    std::unique_ptr<RamDomain[]> readNextTuple() override {
+    bool readNextTupleInto(RamDomain* tuple) override {
         if (file.eof()) {
-            return nullptr;
+            return false;
         }
-        std::string line;
-        std::unique_ptr<RamDomain[]> tuple = std::make_unique<RamDomain[]>(symbolMask.size());
-
         if (!getline(file, line)) {
-            return nullptr;
+            return false;
         }
         // Handle Windows line endings on non-Windows systems
         if (!line.empty() && line.back() == '\r') {
@@ -77,77 +134,156 @@ protected:
             if (end == std::string::npos) {
                 end = line.length();
             }
-            std::string element;
-            if (start <= end) {
-                element = line.substr(start, end - start);
-            } else {
+            if (start > end) {
                 std::stringstream errorMessage;
                 errorMessage << "Values missing in line " << lineNumber << "; ";
                 throw std::invalid_argument(errorMessage.str());
             }
+            const char* first = line.data() + start;
+            const char* last = line.data() + end;
             start = end + delimiter.size();
-            if (inputMap.count(column) == 0) {
+            if (column >= columnActions.size() || !columnActions[column].used) {
                 continue;
             }
+            const ColumnAction& action = columnActions[column];
             ++columnsFilled;
-            if (symbolMask.at(inputMap[column])) {
-                tuple[inputMap[column]] = symbolTable.unsafeLookup(element);
-            } else {
-                try {
-#if RAM_DOMAIN_SIZE == 64
-                    tuple[inputMap[column]] = std::stoll(element);
-#else
-                    tuple[inputMap[column]] = std::stoi(element);
-#endif
-                } catch (...) {
-                    std::stringstream errorMessage;
-                    errorMessage << "Error converting number <" + element + "> in column " << column + 1
-                                 << " in line " << lineNumber << "; ";
-                    throw std::invalid_argument(errorMessage.str());
+            if (action.symbol) {
+                if (dictionaryEnabled) {
+                    RamDomain ordinal = 0;
+                    if (!scanNumber(first, last, ordinal) || ordinal < 0 ||
+                            static_cast<size_t>(ordinal) >= dictionary.size()) {
+                        std::stringstream errorMessage;
+                        errorMessage << "Invalid dictionary ordinal <" << std::string(first, last - first)
+                                     << "> in column " << column + 1 << " in line " << lineNumber << "; ";
+                        throw std::invalid_argument(errorMessage.str());
+                    }
+                    tuple[action.target] = dictionary[ordinal];
+                } else {
+                    tuple[action.target] = lookupSymbol(action.target, std::string(first, last - first));
                 }
+            } else if (!scanNumber(first, last, tuple[action.target])) {
+                std::stringstream errorMessage;
+                errorMessage << "Error converting number <" + std::string(first, last - first)
+                             << "> in column " << column + 1 << " in line " << lineNumber << "; ";
+                throw std::invalid_argument(errorMessage.str());
             }
         }
 
-        return tuple;
+        return true;
     }
 
-    std::string getDelimiter(const IODirectives& ioDirectives) const {
-        if (ioDirectives.has("delimiter")) {
-            return ioDirectives.get("delimiter");
+    /**
+     * A noexcept numeric scanner replacing the exception-driven standard
+     * conversions in the hot load loop; malformed input is reported
+     * through the return value instead.
+     */
+    static bool scanNumber(const char* from, const char* to, RamDomain& result) noexcept {
+        const char* p = from;
+        bool negative = false;
+        if (p < to && (*p == '-' || *p == '+')) {
+            negative = (*p == '-');
+            ++p;
         }
-        return "\t";
+        if (p == to) {
+            return false;
+        }
+        // accumulate the magnitude unsigned; one extra step of headroom
+        // covers the most negative representable value
+        const uint64_t limit =
+                static_cast<uint64_t>(std::numeric_limits<RamDomain>::max()) + (negative ? 1 : 0);
+        uint64_t value = 0;
+        for (; p < to; ++p) {
+            if (*p < '0' || *p > '9') {
+                return false;
+            }
+            const uint64_t digit = static_cast<uint64_t>(*p - '0');
+            if (value > (limit - digit) / 10) {
+                return false;
+            }
+            value = value * 10 + digit;
+        }
+        result = static_cast<RamDomain>(negative ? -value : value);
+        return true;
     }
 
-    std::map<int, int> getInputColumnMap(const IODirectives& ioDirectives, const unsigned arity) const {
-        std::string columnString = "";
-        if (ioDirectives.has("columns")) {
-            columnString = ioDirectives.get("columns");
+    // the number of distinct values per column a cache may hold; a column
+    // exceeding it is considered high-cardinality and caching stops
+    enum { SYMBOL_CACHE_CAPACITY = 1024 };
+
+    /**
+     * Resolves a symbol through a small per-column dictionary instead of
+     * the global symbol map. Enumerated columns (a few hundred distinct
+     * values over many rows) resolve almost every cell from the local
+     * table; columns whose leading rows already show more distinct values
+     * than the cache holds drop their dictionary and fall back to direct
+     * lookups.
+     */
+    RamDomain lookupSymbol(const int column, const std::string& element) {
+        if (!symbolCacheEnabled[column]) {
+            return symbolTable.unsafeLookup(element);
         }
-        std::map<int, int> inputMap;
+        auto& cache = symbolCache[column];
+        auto pos = cache.find(element);
+        if (pos != cache.end()) {
+            return pos->second;
+        }
+        if (cache.size() >= SYMBOL_CACHE_CAPACITY) {
+            symbolCacheEnabled[column] = false;
+            cache.clear();
+            return symbolTable.unsafeLookup(element);
+        }
+        const RamDomain index = symbolTable.unsafeLookup(element);
+        cache.emplace(element, index);
+        return index;
+    }
 
-        if (!columnString.empty()) {
-            std::istringstream iss(columnString);
-            std::string mapping;
-            int index = 0;
-            while (std::getline(iss, mapping, ':')) {
-                inputMap[stoi(mapping)] = index++;
-            }
-            if (inputMap.size() < arity) {
-                throw std::invalid_argument("Invalid column set was given: <" + columnString + ">");
-            }
-        } else {
-            while (inputMap.size() < arity) {
-                int size = inputMap.size();
-                inputMap[size] = size;
+    /**
+     * Loads the symbol sidecar written by the dictionary-encoded output
+     * mode (see WriteDictFileCSV) and resolves each symbol once, so
+     * cells carrying ordinals translate into symbol indices through a
+     * plain vector lookup.
+     */
+    void loadDictionary(const IODirectives& ioDirectives) {
+        if (!ioDirectives.has("filename")) {
+            throw std::invalid_argument("dictionary-encoded input requires a file source\n");
+        }
+        const std::string dictFileName = ioDirectives.get("filename") + ".dict";
+        std::ifstream dictFile(dictFileName);
+        if (!dictFile.is_open()) {
+            throw std::invalid_argument("Cannot open dictionary file " + dictFileName + "\n");
+        }
+        std::string symbol;
+        while (getline(dictFile, symbol)) {
+            if (!symbol.empty() && symbol.back() == '\r') {
+                symbol.pop_back();
             }
+            dictionary.push_back(symbolTable.unsafeLookup(symbol));
         }
-        return inputMap;
     }
 
+    /** Per input column: whether it is consumed at all, its position in
+     * the tuple and whether it holds symbols */
+    struct ColumnAction {
+        int target = 0;
+        bool used = false;
+        bool symbol = false;
+    };
+
     const std::string delimiter;
     std::istream& file;
     size_t lineNumber;
     std::map<int, int> inputMap;
+    // line buffer reused across tuples
+    std::string line;
+    // per-column symbol dictionaries, dropped for high-cardinality columns
+    std::vector<std::unordered_map<std::string, RamDomain>> symbolCache;
+    std::vector<bool> symbolCacheEnabled;
+    // the dense per-column dispatch table driving the parse loop
+    std::vector<ColumnAction> columnActions;
+    // whether symbol columns carry dictionary ordinals instead of text
+    bool dictionaryEnabled = false;
+    // symbol index per dictionary ordinal, loaded from the sidecar
+    std::vector<RamDomain> dictionary;
 };
 
 class ReadFileCSV : public ReadStreamCSV {
@@ -168,15 +304,9 @@ public:
             }
         }
     }
-    /**
-     * Read and return the next tuple.
-     *
-     * Returns nullptr if no tuple was readable.
-     * @return
-     */
-    std::unique_ptr<RamDomain[]> readNextTuple() override {
+    bool readNextTupleInto(RamDomain* tuple) override {
         try {
-            return ReadStreamCSV::readNextTuple();
+            return ReadStreamCSV::readNextTupleInto(tuple);
         } catch (std::exception& e) {
             std::stringstream errorMessage;
             errorMessage << e.what();
@@ -202,6 +332,326 @@ protected:
 #endif
 };
 
+#ifdef USE_LIBZSTD
+/**
+ * A fact-file reader for zstd-compressed input, selected through the
+ * IO directive `compress=zstd`.
+ */
+class ReadZstdFileCSV : public ReadStreamCSV {
+public:
+    ReadZstdFileCSV(const std::vector<bool>& symbolMask, SymbolTable& symbolTable,
+            const IODirectives& ioDirectives, const bool provenance = false)
+            : ReadStreamCSV(fileHandle, symbolMask, symbolTable, ioDirectives, provenance),
+              baseName(souffle::baseName(getFileName(ioDirectives))),
+              fileHandle(getFileName(ioDirectives), std::ios::in | std::ios::binary) {
+        if (!ioDirectives.has("intermediate")) {
+            if (!fileHandle.is_open()) {
+                throw std::invalid_argument("Cannot open fact file " + baseName + "\n");
+            }
+            // Strip headers if we're using them
+            if (ioDirectives.has("headers") && ioDirectives.get("headers") == "true") {
+                std::string line;
+                getline(file, line);
+            }
+        }
+    }
+
+    bool readNextTupleInto(RamDomain* tuple) override {
+        try {
+            return ReadStreamCSV::readNextTupleInto(tuple);
+        } catch (std::exception& e) {
+            std::stringstream errorMessage;
+            errorMessage << e.what();
+            errorMessage << "cannot parse fact file " << baseName << "!\n";
+            throw std::invalid_argument(errorMessage.str());
+        }
+    }
+
+    ~ReadZstdFileCSV() override = default;
+
+protected:
+    std::string getFileName(const IODirectives& ioDirectives) const {
+        if (ioDirectives.has("filename")) {
+            return ioDirectives.get("filename");
+        }
+        return ioDirectives.getRelationName() + ".facts";
+    }
+    std::string baseName;
+    zstdfstream::izstdfstream fileHandle;
+};
+#endif
+
+/**
+ * A fact-file reader parsing its input in parallel. The file is memory
+ * mapped and split at newline boundaries into chunks; each chunk is
+ * scanned by a separate thread with hand-rolled number/symbol parsers
+ * into a thread-local buffer, and the resulting batches are inserted
+ * concurrently by the generic load loop (see ReadStream::readAll).
+ *
+ * Only applicable to plain, uncompressed files; selectable through the
+ * IO directive `IO=file-parallel`.
+ */
+class ReadFileCSVParallel : public ReadStream {
+public:
+    ReadFileCSVParallel(const std::vector<bool>& symbolMask, SymbolTable& symbolTable,
+            const IODirectives& ioDirectives, const bool provenance = false)
+            : ReadStream(symbolMask, symbolTable, provenance),
+              baseName(souffle::baseName(getFileName(ioDirectives))),
+              delimiter(ReadStreamCSV::getDelimiter(ioDirectives)),
+              inputMap(ReadStreamCSV::getInputColumnMap(ioDirectives, arity)) {
+        while (inputMap.size() < arity) {
+            int size = inputMap.size();
+            inputMap[size] = size;
+        }
+
+        // map the fact file into memory
+        fd = open(getFileName(ioDirectives).c_str(), O_RDONLY);
+        if (fd < 0) {
+            if (!ioDirectives.has("intermediate")) {
+                throw std::invalid_argument("Cannot open fact file " + baseName + "\n");
+            }
+            return;
+        }
+        struct stat fileStatus;
+        if (fstat(fd, &fileStatus) != 0) {
+            throw std::invalid_argument("Cannot stat fact file " + baseName + "\n");
+        }
+        size = fileStatus.st_size;
+        if (size > 0) {
+            data = static_cast<const char*>(mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0));
+            if (data == MAP_FAILED) {
+                data = nullptr;
+                throw std::invalid_argument("Cannot map fact file " + baseName + "\n");
+            }
+        }
+
+        // strip headers if we're using them
+        if (ioDirectives.has("headers") && ioDirectives.get("headers") == "true") {
+            while (pos < size && data[pos] != '\n') {
+                ++pos;
+            }
+            if (pos < size) {
+                ++pos;
+            }
+        }
+    }
+
+    ~ReadFileCSVParallel() override {
+        if (data) {
+            munmap(const_cast<char*>(data), size);
+        }
+        if (fd >= 0) {
+            close(fd);
+        }
+    }
+
+protected:
+    // the size of the file region processed per batch
+    enum { BATCH_BYTES = 1 << 26 };
+
+    // tuples are only handed out in whole batches
+    bool readNextTupleInto(RamDomain* /* tuple */) override {
+        return false;
+    }
+
+    bool canReadBatches() const override {
+        return true;
+    }
+
+    std::size_t readNextBatch(std::vector<RamDomain>& buffer) override {
+        if (pos >= size) {
+            return 0;
+        }
+
+        // determine the region covered by this batch ...
+        std::size_t end = std::min(size, pos + (std::size_t)BATCH_BYTES);
+        while (end < size && data[end - 1] != '\n') {
+            ++end;
+        }
+
+        // ... and split it into per-thread chunks at newline boundaries
+        std::size_t numChunks = 1;
+#ifdef _OPENMP
+        numChunks = omp_get_max_threads();
+#endif
+        std::vector<std::size_t> bounds(numChunks + 1);
+        bounds[0] = pos;
+        for (std::size_t i = 1; i < numChunks; ++i) {
+            std::size_t cut = pos + (end - pos) * i / numChunks;
+            while (cut < end && data[cut - 1] != '\n') {
+                ++cut;
+            }
+            bounds[i] = std::max(cut, bounds[i - 1]);
+        }
+        bounds[numChunks] = end;
+
+        // parse all chunks concurrently into thread-local buffers
+        std::vector<std::vector<RamDomain>> parts(numChunks);
+        std::string error;
+#ifdef _OPENMP
+#pragma omp parallel for schedule(dynamic)
+#endif
+        for (std::size_t i = 0; i < numChunks; ++i) {
+            try {
+                parseChunk(data + bounds[i], data + bounds[i + 1], parts[i]);
+            } catch (std::exception& e) {
+#ifdef _OPENMP
+#pragma omp critical
+#endif
+                error = e.what();
+            }
+        }
+        if (!error.empty()) {
+            throw std::invalid_argument(error + "cannot parse fact file " + baseName + "!\n");
+        }
+
+        // concatenate the partial results
+        buffer.clear();
+        for (auto& part : parts) {
+            buffer.insert(buffer.end(), part.begin(), part.end());
+        }
+        pos = end;
+        return buffer.size() / symbolMask.size();
+    }
+
+    /**
+     * Parses all lines within the given range of characters, appending
+     * the resulting tuples to the given buffer.
+     */
+    void parseChunk(const char* cur, const char* last, std::vector<RamDomain>& out) {
+        const auto width = symbolMask.size();
+        // per-column symbol dictionaries local to this chunk, avoiding the
+        // shared symbol-table lock for repeated values of enumerated
+        // columns; keys view the mapped file, so cache hits allocate
+        // nothing. Columns showing more distinct values than a dictionary
+        // holds fall back to direct lookups (see ReadStreamCSV::lookupSymbol)
+        enum { SYMBOL_CACHE_CAPACITY = 1024 };
+        std::vector<std::unordered_map<std::string_view, RamDomain>> caches(width);
+        std::vector<bool> cacheEnabled(width, true);
+        auto lookupSymbol = [&](const int column, const char* from, const char* to) {
+            const std::string_view key(from, to - from);
+            if (!cacheEnabled[column]) {
+                return symbolTable.lookup(key);
+            }
+            auto& cache = caches[column];
+            auto pos = cache.find(key);
+            if (pos != cache.end()) {
+                return pos->second;
+            }
+            if (cache.size() >= SYMBOL_CACHE_CAPACITY) {
+                cacheEnabled[column] = false;
+                cache.clear();
+                return symbolTable.lookup(key);
+            }
+            const RamDomain index = symbolTable.lookup(key);
+            cache.emplace(key, index);
+            return index;
+        };
+        while (cur < last) {
+            // locate the end of the current line
+            const char* eol = static_cast<const char*>(memchr(cur, '\n', last - cur));
+            if (!eol) {
+                eol = last;
+            }
+            const char* next = eol + 1;
+            // handle Windows line endings
+            if (eol > cur && *(eol - 1) == '\r') {
+                --eol;
+            }
+            // skip empty lines
+            if (cur == eol && arity > 0) {
+                cur = next;
+                continue;
+            }
+
+            auto base = out.size();
+            out.resize(base + width, 0);
+
+            std::size_t columnsFilled = 0;
+            for (uint32_t column = 0; columnsFilled < arity; column++) {
+                const char* stop = findDelimiter(cur, eol);
+                if (cur > eol) {
+                    throw std::invalid_argument("Values missing in fact file " + baseName + "; ");
+                }
+                if (inputMap.count(column) != 0) {
+                    ++columnsFilled;
+                    if (symbolMask.at(inputMap[column])) {
+                        out[base + inputMap[column]] = lookupSymbol(inputMap[column], cur, stop);
+                    } else {
+                        out[base + inputMap[column]] = parseNumber(cur, stop);
+                    }
+                }
+                cur = stop + ((stop < eol) ? delimiter.size() : 1);
+            }
+            cur = next;
+        }
+    }
+
+    /**
+     * Locates the next occurrence of the delimiter within the given
+     * range, or the end of the range if there is none.
+     */
+    const char* findDelimiter(const char* from, const char* to) const {
+        if (delimiter.size() == 1) {
+            auto* hit = static_cast<const char*>(memchr(from, delimiter[0], to - from));
+            return hit ? hit : to;
+        }
+        return std::search(from, to, delimiter.begin(), delimiter.end());
+    }
+
+    /**
+     * A hand-rolled numeric scanner avoiding the locale and exception
+     * overhead of the standard conversion functions.
+     */
+    RamDomain parseNumber(const char* from, const char* to) const {
+        const char* p = from;
+        bool negative = false;
+        if (p < to && (*p == '-' || *p == '+')) {
+            negative = (*p == '-');
+            ++p;
+        }
+        if (p == to) {
+            throw std::invalid_argument(
+                    "Error converting number <" + std::string(from, to - from) + ">; ");
+        }
+        // accumulate the magnitude unsigned; one extra step of headroom
+        // covers the most negative representable value
+        const uint64_t limit =
+                static_cast<uint64_t>(std::numeric_limits<RamDomain>::max()) + (negative ? 1 : 0);
+        uint64_t result = 0;
+        for (; p < to; ++p) {
+            if (*p < '0' || *p > '9') {
+                throw std::invalid_argument(
+                        "Error converting number <" + std::string(from, to - from) + ">; ");
+            }
+            const uint64_t digit = static_cast<uint64_t>(*p - '0');
+            if (result > (limit - digit) / 10) {
+                throw std::invalid_argument(
+                        "Error converting number <" + std::string(from, to - from) + ">; ");
+            }
+            result = result * 10 + digit;
+        }
+        return static_cast<RamDomain>(negative ? -result : result);
+    }
+
+    std::string getFileName(const IODirectives& ioDirectives) const {
+        if (ioDirectives.has("filename")) {
+            return ioDirectives.get("filename");
+        }
+        return ioDirectives.getRelationName() + ".facts";
+    }
+
+    std::string baseName;
+    const std::string delimiter;
+    std::map<int, int> inputMap;
+
+    // the mapped file region and the current read position therein
+    int fd = -1;
+    const char* data = nullptr;
+    std::size_t size = 0;
+    std::size_t pos = 0;
+};
+
 class ReadCinCSVFactory : public ReadStreamFactory {
 public:
     std::unique_ptr<ReadStream> getReader(const std::vector<bool>& symbolMask, SymbolTable& symbolTable,
@@ -219,6 +669,11 @@ class ReadFileCSVFactory : public ReadStreamFactory {
 public:
     std::unique_ptr<ReadStream> getReader(const std::vector<bool>& symbolMask, SymbolTable& symbolTable,
             const IODirectives& ioDirectives, const bool provenance) override {
+#ifdef USE_LIBZSTD
+        if (ioDirectives.has("compress") && ioDirectives.get("compress") == "zstd") {
+            return std::make_unique<ReadZstdFileCSV>(symbolMask, symbolTable, ioDirectives, provenance);
+        }
+#endif
         return std::make_unique<ReadFileCSV>(symbolMask, symbolTable, ioDirectives, provenance);
     }
     const std::string& getName() const override {
@@ -229,4 +684,23 @@ public:
     ~ReadFileCSVFactory() override = default;
 };
 
+class ReadFileCSVParallelFactory : public ReadStreamFactory {
+public:
+    std::unique_ptr<ReadStream> getReader(const std::vector<bool>& symbolMask, SymbolTable& symbolTable,
+            const IODirectives& ioDirectives, const bool provenance) override {
+        // the parallel parser does not decode dictionary ordinals; such
+        // inputs fall back to the sequential reader
+        if (ioDirectives.has("dictionary") && ioDirectives.get("dictionary") == "true") {
+            return std::make_unique<ReadFileCSV>(symbolMask, symbolTable, ioDirectives, provenance);
+        }
+        return std::make_unique<ReadFileCSVParallel>(symbolMask, symbolTable, ioDirectives, provenance);
+    }
+    const std::string& getName() const override {
+        static const std::string name = "file-parallel";
+        return name;
+    }
+
+    ~ReadFileCSVParallelFactory() override = default;
+};
+
 } /* namespace souffle */
@@ -45,19 +45,11 @@ public:
     }
 
 protected:
-    /**
-     * Read and return the next tuple.
-     *
-     * Returns nullptr if no tuple was readable.
-     * @return
-     */
-    std::unique_ptr<RamDomain[]> readNextTuple() override {
+    bool readNextTupleInto(RamDomain* tuple) override {
         if (sqlite3_step(selectStatement) != SQLITE_ROW) {
-            return nullptr;
+            return false;
         }
 
-        std::unique_ptr<RamDomain[]> tuple = std::make_unique<RamDomain[]>(arity + (isProvenance ? 2 : 0));
-
         uint32_t column;
         for (column = 0; column < arity; column++) {
             std::string element(reinterpret_cast<const char*>(sqlite3_column_text(selectStatement, column)));
@@ -82,7 +74,50 @@ protected:
             }
         }
 
-        return tuple;
+        return true;
+    }
+
+    bool canReadBatches() const override {
+        return true;
+    }
+
+    /**
+     * Fetches up to batchSize rows per call into the reusable buffer,
+     * so the generic load loop can bulk-insert whole batches instead of
+     * allocating and inserting row by row.
+     */
+    std::size_t readNextBatch(std::vector<RamDomain>& buffer) override {
+        const auto width = symbolMask.size();
+        buffer.resize(batchSize * width);
+        std::size_t count = 0;
+        while (count < batchSize && sqlite3_step(selectStatement) == SQLITE_ROW) {
+            RamDomain* tuple = &buffer[count * width];
+            for (uint32_t column = 0; column < arity; column++) {
+                std::string element(
+                        reinterpret_cast<const char*>(sqlite3_column_text(selectStatement, column)));
+
+                if (element.empty()) {
+                    element = "n/a";
+                }
+                if (symbolMask.at(column)) {
+                    tuple[column] = symbolTable.lookup(element);
+                } else {
+                    try {
+#if RAM_DOMAIN_SIZE == 64
+                        tuple[column] = std::stoll(element);
+#else
+                        tuple[column] = std::stoi(element);
+#endif
+                    } catch (...) {
+                        std::stringstream errorMessage;
+                        errorMessage << "Error converting number in column " << (column) + 1;
+                        throw std::invalid_argument(errorMessage.str());
+                    }
+                }
+            }
+            ++count;
+        }
+        return count;
     }
 
     void executeSQL(const std::string& sql) {
@@ -146,6 +181,8 @@ protected:
         sqlite3_finalize(tableStatement);
         throw std::invalid_argument("Required table and view does not exist for relation " + relationName);
     }
+    static constexpr std::size_t batchSize = 10000;
+
     const std::string& dbFilename;
     const std::string& relationName;
     sqlite3_stmt* selectStatement = nullptr;
@@ -29,7 +29,19 @@ enum class RelationRepresentation {
     // btree data-structure
     BRIE,
     // equivalence relation
-    EQREL
+    EQREL,
+    // column-major (structure-of-arrays) storage for scan-heavy relations
+    COLUMNAR,
+    // bitset over a dense ordinal domain, for unary relations
+    BITSET,
+    // relation dropping tuples subsumed by a smaller last attribute
+    SUBSUMPTION,
+    // relation keeping the first tuple inserted for each key (all attributes but the last)
+    FUNCTIONAL,
+    // per-key grouped storage for prefix-bound, high-fanout access patterns
+    GROUPED,
+    // representation chosen at runtime after sampling the inserted data
+    AUTO
 };
 
 inline std::ostream& operator<<(std::ostream& os, RelationRepresentation structure) {
@@ -43,6 +55,24 @@ inline std::ostream& operator<<(std::ostream& os, RelationRepresentation structu
         case RelationRepresentation::EQREL:
             os << "eqrel";
             break;
+        case RelationRepresentation::COLUMNAR:
+            os << "columnar";
+            break;
+        case RelationRepresentation::BITSET:
+            os << "bitset";
+            break;
+        case RelationRepresentation::SUBSUMPTION:
+            os << "subsumption";
+            break;
+        case RelationRepresentation::FUNCTIONAL:
+            os << "functional";
+            break;
+        case RelationRepresentation::GROUPED:
+            os << "grouped";
+            break;
+        case RelationRepresentation::AUTO:
+            os << "auto";
+            break;
         case RelationRepresentation::DEFAULT:
         default:
             break;
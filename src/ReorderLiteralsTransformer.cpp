@@ -23,9 +23,13 @@
 #include "AstRelation.h"
 #include "AstTransforms.h"
 #include "AstTranslationUnit.h"
+#include "AstUtils.h"
 #include "AstVisitor.h"
 #include "Global.h"
+#include "PrecedenceGraph.h"
 #include <cmath>
+#include <map>
+#include <memory>
 #include <set>
 #include <string>
 #include <utility>
@@ -375,52 +379,114 @@ bool ReorderLiteralsTransformer::transform(AstTranslationUnit& translationUnit)
     }
 
     // --- profile-guided reordering ---
-    if (Global::config().has("profile-use")) {
+    // a statistics catalog from a previous run serves as the cost-model
+    // input when no profile is supplied
+    if (Global::config().has("profile-use") || Global::config().has("stats-file")) {
         // parse supplied profile information
         auto* profileUse = translationUnit.getAnalysis<AstProfileUse>();
+        auto* sccGraph = translationUnit.getAnalysis<SCCGraph>();
+        auto* recursiveClauses = translationUnit.getAnalysis<RecursiveClauses>();
+
+        // Creates a cost-based SIPS function scheduling the cheapest join next.
+        // Metric: cost(atom_R) = log(card(atom_R)) * #free/#args
+        //         - exception: propositions are prioritised
+        // where card is the estimated cardinality of the atom, taken from the
+        // given per-atom estimates.
+        auto makeProfilerSips = [](const std::map<const AstAtom*, double>& logCardinalities) {
+            return [logCardinalities](
+                           std::vector<AstAtom*> atoms, const std::set<std::string>& boundVariables) {
+                double currOptimalVal = -1;
+                unsigned int currOptimalIdx = 0U;
+                bool set = false;
+
+                for (unsigned int i = 0; i < atoms.size(); i++) {
+                    const AstAtom* currAtom = atoms[i];
+
+                    if (currAtom == nullptr) {
+                        // already processed - move on
+                        continue;
+                    }
 
-        auto profilerSips = [&](std::vector<AstAtom*> atoms, const std::set<std::string>& boundVariables) {
-            // Goal: reorder based on the given profiling information
-            // Metric: cost(atom_R) = log(|atom_R|) * #free/#args
-            //         - exception: propositions are prioritised
+                    if (isProposition(currAtom)) {
+                        // prioritise propositions
+                        return i;
+                    }
 
-            double currOptimalVal = -1;
-            unsigned int currOptimalIdx = 0U;
-            bool set = false;
+                    // calculate log(card(R)) * #free/#args
+                    int numBound = numBoundArguments(currAtom, boundVariables);
+                    int numArgs = currAtom->getArity();
+                    int numFree = numArgs - numBound;
+                    double value = logCardinalities.at(currAtom);
+                    value *= (numFree * 1.0) / numArgs;
+
+                    if (!set || value < currOptimalVal) {
+                        set = true;
+                        currOptimalVal = value;
+                        currOptimalIdx = i;
+                    }
+                }
 
-            for (unsigned int i = 0; i < atoms.size(); i++) {
-                const AstAtom* currAtom = atoms[i];
+                return currOptimalIdx;
+            };
+        };
 
-                if (currAtom == nullptr) {
-                    // already processed - move on
+        for (const AstRelation* rel : program.getRelations()) {
+            for (AstClause* clause : rel->getClauses()) {
+                // ignore clauses with fixed execution plans
+                if (clause->getExecutionPlan() != nullptr) {
                     continue;
                 }
 
-                if (isProposition(currAtom)) {
-                    // prioritise propositions
-                    return i;
+                // full-relation cardinality estimates from the profile
+                std::map<const AstAtom*, double> logCardinalities;
+                for (const AstAtom* atom : clause->getAtoms()) {
+                    logCardinalities[atom] = log(profileUse->getRelationSize(atom->getName()));
                 }
 
-                // calculate log(|R|) * #free/#args
-                int numBound = numBoundArguments(currAtom, boundVariables);
-                int numArgs = currAtom->getArity();
-                int numFree = numArgs - numBound;
-                double value = log(profileUse->getRelationSize(currAtom->getName()));
-                value *= (numFree * 1.0) / numArgs;
-
-                if (!set || value < currOptimalVal) {
-                    set = true;
-                    currOptimalVal = value;
-                    currOptimalIdx = i;
+                // reorder the clause itself, which covers the non-recursive case
+                changed |= reorderClauseWithSips(makeProfilerSips(logCardinalities), clause);
+
+                if (!recursiveClauses->recursive(clause)) {
+                    continue;
                 }
-            }
 
-            return currOptimalIdx;
-        };
+                // For recursive clauses the translator creates one version per
+                // body atom within the head's SCC, with that atom replaced by
+                // its delta relation. The delta holds roughly a single
+                // iteration's worth of tuples, so schedule each version
+                // separately with the delta atom's cardinality scaled down by
+                // the iteration count recorded in the profile.
+                const size_t headScc = sccGraph->getSCC(rel);
+                auto atoms = clause->getAtoms();
+                auto plan = std::make_unique<AstExecutionPlan>();
+                int version = 0;
+                bool isTrivial = true;
+                for (const AstAtom* atom : atoms) {
+                    const AstRelation* atomRelation = getAtomRelation(atom, &program);
+                    if (atomRelation == nullptr || sccGraph->getSCC(atomRelation) != headScc) {
+                        continue;
+                    }
 
-        for (const AstRelation* rel : program.getRelations()) {
-            for (AstClause* clause : rel->getClauses()) {
-                changed |= reorderClauseWithSips(profilerSips, clause);
+                    auto versionCardinalities = logCardinalities;
+                    versionCardinalities[atom] -= log(profileUse->getIterations(atom->getName()));
+
+                    std::vector<unsigned int> versionOrder =
+                            applySips(makeProfilerSips(versionCardinalities), atoms);
+                    auto executionOrder = std::make_unique<AstExecutionOrder>();
+                    for (unsigned int i = 0; i < versionOrder.size(); i++) {
+                        isTrivial &= (versionOrder[i] == i);
+                        // execution orders are one-based
+                        executionOrder->appendAtomIndex(versionOrder[i] + 1);
+                    }
+                    plan->setOrderFor(version, std::move(executionOrder));
+                    version++;
+                }
+
+                // a plan only ordering every version as-is carries no information
+                if (version > 0 && !isTrivial) {
+                    clause->setExecutionPlan(std::move(plan));
+                    changed = true;
+                }
             }
         }
     }
@@ -18,14 +18,55 @@
 
 #include <atomic>
 #include <cassert>
+#include <chrono>
 #include <csignal>
+#include <cstdint>
+#include <cstdio>
 #include <cstring>
 #include <iostream>
+#include <memory>
 #include <mutex>
 #include <string>
 
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+
 namespace souffle {
 
+/**
+ * The on-disk layout of the progress map, a file-backed shared-memory
+ * segment every run publishes under /tmp/souffle-<pid>.progress. An
+ * external profiler can map it read-only and observe which statements a
+ * long-running evaluation is executing, without profiling having been
+ * requested at launch.
+ */
+struct ProgressMapHeader {
+    // identifies the file as a progress map of the expected layout
+    uint64_t magic;
+    // number of statement records following the header
+    uint64_t slots;
+};
+
+struct ProgressMapRecord {
+    // number of times the statement has been entered
+    std::atomic<uint64_t> hits;
+    // steady-clock tick of the most recent entry
+    std::atomic<int64_t> stamp;
+    // guards the one-time initialization of msg
+    std::atomic<uint32_t> init;
+    // the statement's source text, truncated to the record size
+    char msg[236];
+};
+
+// expected value of ProgressMapHeader::magic ("SOUFPROG")
+constexpr uint64_t PROGRESS_MAP_MAGIC = 0x534f554650524f47ull;
+
+/** The location of the progress map published by the given process */
+inline std::string progressMapPath(int pid) {
+    return "/tmp/souffle-" + std::to_string(pid) + ".progress";
+}
+
 /**
  * Class SignalHandler captures signals
  * and reports the context where the signal occurs.
@@ -43,30 +84,69 @@ public:
     void enableLogging() {
         logMessages = true;
     }
-    // set signal message
-    void setMsg(const char* m) {
+    /**
+     * Sizes the per-statement progress table. Every statement owns one
+     * cache-line-aligned slot, so that concurrently executing statements
+     * never write to a shared line; the table may only be (re)sized while
+     * no evaluation is running.
+     */
+    void setProgressSlots(size_t count) {
+        if (count > numSlots) {
+            slots = std::make_unique<ProgressSlot[]>(count);
+            numSlots = count;
+            publishProgressMap(count);
+        }
+    }
+
+    /**
+     * Records entry into the statement with the given id. The hot path is
+     * two relaxed stores into the statement's own slot; the message is only
+     * formatted lazily, on signal receipt.
+     */
+    void enterStatement(size_t id, const char* m) {
+        assert(id < numSlots && "progress slot out of range");
+        auto now = std::chrono::steady_clock::now().time_since_epoch().count();
+        auto& slot = slots[id];
+        slot.msg.store(m, std::memory_order_relaxed);
+        slot.stamp.store(now, std::memory_order_relaxed);
+        if (sharedRecords != nullptr && id < sharedSlots) {
+            auto& record = sharedRecords[id];
+            // copy the statement text into the record on first entry only
+            if (record.init.load(std::memory_order_relaxed) == 0 && m != nullptr &&
+                    record.init.exchange(1) == 0) {
+                strncpy(record.msg, m, sizeof(record.msg) - 1);
+                record.msg[sizeof(record.msg) - 1] = '\0';
+            }
+            record.stamp.store(now, std::memory_order_relaxed);
+            record.hits.fetch_add(1, std::memory_order_relaxed);
+        }
         if (logMessages && m != nullptr) {
-            static std::mutex outputMutex;
-            static bool sameLine = false;
-            std::lock_guard<std::mutex> guard(outputMutex);
-            if (msg != nullptr && strcmp(m, msg) == 0) {
-                std::cout << ".";
-                sameLine = true;
-            } else {
-                if (sameLine) {
-                    sameLine = false;
-                    std::cout << std::endl;
-                }
-                std::string outputMessage(m);
-                for (char& c : outputMessage) {
-                    if (c == '\n' || c == '\t') {
-                        c = ' ';
-                    }
-                }
-                std::cout << "Starting work on " << outputMessage << std::endl;
+            logEntry(m);
+        }
+    }
+
+    /**
+     * Determine the id of the most recently entered statement, or
+     * (size_t)-1 if no statement has been entered yet. Used by the
+     * sampling profiler.
+     */
+    size_t currentStatement() const {
+        size_t current = static_cast<size_t>(-1);
+        int64_t best = 0;
+        for (size_t i = 0; i < numSlots; ++i) {
+            auto stamp = slots[i].stamp.load(std::memory_order_relaxed);
+            if (stamp > best) {
+                best = stamp;
+                current = i;
             }
         }
-        msg = m;
+        return current;
+    }
+
+    /** Return the message registered for the given statement id */
+    const char* getProgressMessage(size_t id) const {
+        assert(id < numSlots && "progress slot out of range");
+        return slots[id].msg.load(std::memory_order_relaxed);
     }
 
     /***
@@ -116,6 +196,7 @@ public:
             }
             isSet = false;
         }
+        unpublishProgressMap();
     }
 
     /***
@@ -123,6 +204,7 @@ public:
      */
 
     void error(const std::string& error) {
+        const char* msg = currentMsg();
         if (msg != nullptr) {
             std::cerr << error << " in rule:\n" << msg << std::endl;
         } else {
@@ -132,14 +214,103 @@ public:
     }
 
 private:
-    // signal context information
-    std::atomic<const char*> msg;
+    /** A per-statement progress record, padded to its own cache line */
+    struct alignas(64) ProgressSlot {
+        std::atomic<const char*> msg{nullptr};
+        std::atomic<int64_t> stamp{0};
+    };
+
+    // per-statement progress slots, indexed by statement id
+    std::unique_ptr<ProgressSlot[]> slots;
+    size_t numSlots = 0;
+
+    // the memory-mapped progress records shared with external profilers
+    ProgressMapRecord* sharedRecords = nullptr;
+    size_t sharedSlots = 0;
+
+    /**
+     * Publishes the progress table as a file-backed shared-memory segment,
+     * such that souffle-profile can attach to this process. Failure to
+     * publish (e.g. an unwritable /tmp) silently disables attaching.
+     */
+    void publishProgressMap(size_t count) {
+        unpublishProgressMap();
+        std::string path = progressMapPath(getpid());
+        int fd = open(path.c_str(), O_RDWR | O_CREAT | O_TRUNC, 0644);
+        if (fd == -1) {
+            return;
+        }
+        size_t length = sizeof(ProgressMapHeader) + count * sizeof(ProgressMapRecord);
+        if (ftruncate(fd, length) == -1) {
+            close(fd);
+            remove(path.c_str());
+            return;
+        }
+        void* base = mmap(nullptr, length, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+        close(fd);
+        if (base == MAP_FAILED) {
+            remove(path.c_str());
+            return;
+        }
+        auto* header = static_cast<ProgressMapHeader*>(base);
+        header->slots = count;
+        // the magic is written last, so that an attaching profiler never
+        // observes a partially initialized map
+        header->magic = PROGRESS_MAP_MAGIC;
+        sharedRecords = reinterpret_cast<ProgressMapRecord*>(header + 1);
+        sharedSlots = count;
+    }
+
+    /** Withdraws the published progress map, if any */
+    void unpublishProgressMap() {
+        if (sharedRecords == nullptr) {
+            return;
+        }
+        auto* header = reinterpret_cast<ProgressMapHeader*>(sharedRecords) - 1;
+        munmap(header, sizeof(ProgressMapHeader) + sharedSlots * sizeof(ProgressMapRecord));
+        sharedRecords = nullptr;
+        sharedSlots = 0;
+        remove(progressMapPath(getpid()).c_str());
+    }
+
+    // the message most recently echoed in verbose mode
+    const char* lastLogged = nullptr;
 
     // state of signal handler
     bool isSet = false;
 
     bool logMessages = false;
 
+    /** Determine the message of the most recently entered statement */
+    const char* currentMsg() const {
+        size_t current = currentStatement();
+        return (current == static_cast<size_t>(-1)) ? nullptr : getProgressMessage(current);
+    }
+
+    /** Echo the entered statement in verbose mode, collapsing repetitions */
+    void logEntry(const char* m) {
+        static std::mutex outputMutex;
+        static bool sameLine = false;
+        std::lock_guard<std::mutex> guard(outputMutex);
+        if (lastLogged != nullptr && strcmp(m, lastLogged) == 0) {
+            std::cout << ".";
+            sameLine = true;
+        } else {
+            if (sameLine) {
+                sameLine = false;
+                std::cout << std::endl;
+            }
+            std::string outputMessage(m);
+            for (char& c : outputMessage) {
+                if (c == '\n' || c == '\t') {
+                    c = ' ';
+                }
+            }
+            std::cout << "Starting work on " << outputMessage << std::endl;
+        }
+        lastLogged = m;
+    }
+
     // previous signal handler routines
     void (*prevFpeHandler)(int) = nullptr;
     void (*prevIntHandler)(int) = nullptr;
@@ -149,7 +320,7 @@ private:
      * Signal handler for various types of signals.
      */
     static void handler(int signal) {
-        const char* msg = instance()->msg;
+        const char* msg = instance()->currentMsg();
         std::string error;
         switch (signal) {
             case SIGINT:
@@ -173,7 +344,11 @@ private:
         exit(1);
     }
 
-    SignalHandler() : msg(nullptr) {}
+    SignalHandler() = default;
+
+    ~SignalHandler() {
+        unpublishProgressMap();
+    }
 };
 
 }  // namespace souffle
@@ -0,0 +1,220 @@
+/*
+ * Souffle - A Datalog Compiler
+ * Copyright (c) 2020, The Souffle Developers. All rights reserved
+ * Licensed under the Universal Permissive License v 1.0 as shown at:
+ * - https://opensource.org/licenses/UPL
+ * - <souffle root>/licenses/SOUFFLE-UPL.txt
+ */
+
+/************************************************************************
+ *
+ * @file SouffleCInterface.h
+ *
+ * A C ABI over SouffleProgram and ProgramFactory, exported from every
+ * compiled program library. Non-C++ embedders (Go via cgo, Rust via an
+ * extern block, anything with a C FFI) can dlopen the .so produced by
+ * souffle-compile and drive a resident program instance directly:
+ * create it once, feed input tuples as flat int32 batches, run, read
+ * the results back column-wise, reset and repeat. This replaces the
+ * spawn-a-process-per-request pattern, whose cost is dominated by
+ * process startup and CSV (de)serialization rather than evaluation.
+ *
+ * The functions below are definitions, not declarations; this header is
+ * included exactly once, by CompiledSouffle.h, into the single
+ * translation unit the synthesizer generates per program.
+ *
+ * ABI notes for binding authors:
+ *  - All handles are opaque pointers. A relation handle is owned by its
+ *    program and remains valid until the program is destroyed.
+ *  - Tuple elements are 32-bit signed integers (RamDomain). Symbol
+ *    attributes (type prefix "s:") carry symbol-table ordinals; encode
+ *    strings with souffle_encode_symbol before inserting and decode
+ *    result columns with souffle_decode_symbol.
+ *  - Batches are row-major on insert and column-wise on export, which
+ *    matches how typical bindings build input and consume output.
+ *  - Functions returning int report 0 on success; on failure they
+ *    return -1 and souffle_error_message() describes the error. The
+ *    error message is thread-local and overwritten by the next failing
+ *    call on the same thread.
+ *  - A program instance is not thread-safe; embedders wanting parallel
+ *    requests should keep a pool of instances.
+ *
+ ***********************************************************************/
+
+#pragma once
+
+#include "souffle/RamTypes.h"
+#include "souffle/SouffleInterface.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <exception>
+#include <string>
+#include <type_traits>
+
+static_assert(std::is_same<souffle::RamDomain, int32_t>::value,
+        "the C ABI fixes tuple elements to int32_t and must follow a RamDomain change");
+
+namespace souffle {
+namespace capi {
+
+/** The error message of the last failing C API call on this thread. */
+inline std::string& lastError() {
+    static thread_local std::string error;
+    return error;
+}
+
+/** Runs the given body, capturing any escaping exception as the
+ * thread's last error; C callers cannot unwind C++ exceptions. */
+template <typename Body>
+int guarded(Body&& body) {
+    try {
+        body();
+        return 0;
+    } catch (const std::exception& e) {
+        lastError() = e.what();
+        return -1;
+    } catch (...) {
+        lastError() = "unknown error";
+        return -1;
+    }
+}
+
+}  // namespace capi
+}  // namespace souffle
+
+extern "C" {
+
+/** Opaque handle of a program instance. */
+struct souffle_program;
+
+/** Opaque handle of a relation of a program instance. */
+struct souffle_relation;
+
+/**
+ * Create an instance of the program registered under the given name,
+ * as passed to souffle's -l option when the library was compiled.
+ * Returns nullptr if no such program is linked into this library; the
+ * instance must be released with souffle_destroy.
+ */
+souffle_program* souffle_create(const char* name) {
+    return reinterpret_cast<souffle_program*>(souffle::ProgramFactory::newInstance(name));
+}
+
+/** Destroy a program instance and all its relation handles. */
+void souffle_destroy(souffle_program* program) {
+    delete reinterpret_cast<souffle::SouffleProgram*>(program);
+}
+
+/** Set the number of evaluation threads; 0 keeps the compiled default. */
+void souffle_set_num_threads(souffle_program* program, size_t numThreads) {
+    reinterpret_cast<souffle::SouffleProgram*>(program)->setNumThreads(numThreads);
+}
+
+/** Evaluate the program on the tuples inserted since the last reset. */
+int souffle_run(souffle_program* program) {
+    return souffle::capi::guarded(
+            [&]() { reinterpret_cast<souffle::SouffleProgram*>(program)->run(); });
+}
+
+/**
+ * Purge all relations of the instance, keeping it alive for the next
+ * request. Symbol ordinals handed out so far remain valid, so encoded
+ * inputs may be reused across resets.
+ */
+void souffle_reset(souffle_program* program) {
+    reinterpret_cast<souffle::SouffleProgram*>(program)->reset();
+}
+
+/** Read all input relations from fact files in the given directory. */
+int souffle_load_all(souffle_program* program, const char* inputDirectory) {
+    return souffle::capi::guarded([&]() {
+        reinterpret_cast<souffle::SouffleProgram*>(program)->loadAll(inputDirectory);
+    });
+}
+
+/** Write all output relations to CSV files in the given directory. */
+int souffle_print_all(souffle_program* program, const char* outputDirectory) {
+    return souffle::capi::guarded([&]() {
+        reinterpret_cast<souffle::SouffleProgram*>(program)->printAll(outputDirectory);
+    });
+}
+
+/** Obtain a relation by name, or nullptr if the program has none. */
+souffle_relation* souffle_relation_by_name(souffle_program* program, const char* name) {
+    return reinterpret_cast<souffle_relation*>(
+            reinterpret_cast<souffle::SouffleProgram*>(program)->getRelation(name));
+}
+
+/** The number of attributes of the relation. */
+size_t souffle_relation_arity(const souffle_relation* relation) {
+    return reinterpret_cast<const souffle::Relation*>(relation)->getArity();
+}
+
+/** The number of tuples currently in the relation. */
+size_t souffle_relation_size(const souffle_relation* relation) {
+    return reinterpret_cast<const souffle::Relation*>(relation)->size();
+}
+
+/** The type of an attribute, as a "<kind>:<name>" string such as "s:symbol". */
+const char* souffle_relation_attr_type(const souffle_relation* relation, size_t index) {
+    return reinterpret_cast<const souffle::Relation*>(relation)->getAttrType(index);
+}
+
+/** The name of an attribute. */
+const char* souffle_relation_attr_name(const souffle_relation* relation, size_t index) {
+    return reinterpret_cast<const souffle::Relation*>(relation)->getAttrName(index);
+}
+
+/**
+ * Insert a batch of tuples given as numTuples x arity elements in
+ * row-major order. Symbol attributes must already carry ordinals
+ * obtained from souffle_encode_symbol.
+ */
+void souffle_insert_batch(souffle_relation* relation, const int32_t* data, size_t numTuples) {
+    reinterpret_cast<souffle::Relation*>(relation)->insert(data, numTuples);
+}
+
+/**
+ * Copy the content of the relation into one caller-provided array per
+ * attribute, each with capacity for souffle_relation_size elements; a
+ * nullptr entry skips that attribute. Returns the number of tuples
+ * written per column.
+ */
+size_t souffle_export_batch(const souffle_relation* relation, int32_t* const* columns) {
+    return reinterpret_cast<const souffle::Relation*>(relation)->extract(columns);
+}
+
+/** Remove all tuples from the relation. */
+void souffle_relation_purge(souffle_relation* relation) {
+    reinterpret_cast<souffle::Relation*>(relation)->purge();
+}
+
+/**
+ * Intern a string in the symbol table of the instance and return its
+ * ordinal, for use in symbol attributes of inserted tuples.
+ */
+int32_t souffle_encode_symbol(souffle_program* program, const char* symbol) {
+    return reinterpret_cast<souffle::SouffleProgram*>(program)->getSymbolTable().lookup(symbol);
+}
+
+/**
+ * Resolve a symbol ordinal back to its string. The returned pointer is
+ * owned by the symbol table and stays valid until the program is
+ * destroyed; returns nullptr for an ordinal never handed out.
+ */
+const char* souffle_decode_symbol(souffle_program* program, int32_t ordinal) {
+    souffle::SymbolTable& symbolTable =
+            reinterpret_cast<souffle::SouffleProgram*>(program)->getSymbolTable();
+    if (ordinal < 0 || static_cast<size_t>(ordinal) >= symbolTable.size()) {
+        return nullptr;
+    }
+    return symbolTable.resolve(ordinal).data();
+}
+
+/** The error message of the last failing call on this thread, or "". */
+const char* souffle_error_message() {
+    return souffle::capi::lastError().c_str();
+}
+
+}  // extern "C"
@@ -265,6 +265,43 @@ public:
      */
     virtual void insert(const tuple& t) = 0;
 
+    /**
+     * Insert a batch of tuples given as a contiguous buffer into the relation.
+     *
+     * The buffer holds numTuples tuples of the arity of this relation, one
+     * after the other, in the internal RamDomain representation; elements of
+     * string type have to be given as their index in the symbol table of the
+     * program (see SymbolTable::lookup()). In contrast to inserting via the
+     * tuple class, the whole batch is inserted with a single dispatch and
+     * without constructing any intermediate objects, which is significantly
+     * faster when feeding large numbers of facts from another application.
+     *
+     * @param data Buffer of numTuples * getArity() elements
+     * @param numTuples The number of tuples to be inserted
+     */
+    virtual void insert(const RamDomain* data, std::size_t numTuples);
+
+    /**
+     * Copy the tuples of the relation into caller-provided column arrays.
+     *
+     * The i-th element of every tuple is appended to columns[i], in the
+     * iteration order of the relation; columns has to hold getArity()
+     * pointers, each to a buffer with room for size() elements, and a null
+     * column pointer skips that attribute. Elements are delivered in the
+     * internal RamDomain representation, i.e. elements of string type
+     * arrive as their ordinal in the symbol table of the program, which
+     * can be translated in bulk through SymbolTable::resolve() or written
+     * out once via SymbolTable::dump(). In contrast to consuming the
+     * relation through iterators and the tuple class, the whole relation
+     * is exported with a single dispatch and without constructing any
+     * intermediate objects, which is significantly faster when feeding
+     * large results into another application.
+     *
+     * @param columns Array of getArity() column buffer pointers
+     * @return The number of tuples written to each column
+     */
+    virtual std::size_t extract(RamDomain* const* columns) const;
+
     /**
      * Check whether a tuple exists in a relation.
      * The definition of contains has to be defined by the child class of relation class.
@@ -581,6 +618,41 @@ public:
     }
 };
 
+/**
+ * Fallback implementation of the bulk insertion, inserting the buffer tuple
+ * by tuple; implementations are expected to override this with a direct
+ * insertion into the underlying data structure.
+ */
+inline void Relation::insert(const RamDomain* data, std::size_t numTuples) {
+    const size_t arity = getArity();
+    tuple t(this);
+    for (std::size_t i = 0; i < numTuples; i++, data += arity) {
+        for (std::size_t j = 0; j < arity; j++) {
+            t[j] = data[j];
+        }
+        insert(t);
+    }
+}
+
+/**
+ * Fallback implementation of the columnar export, draining the relation
+ * through its iterators; implementations are expected to override this
+ * with a direct scan of the underlying data structure.
+ */
+inline std::size_t Relation::extract(RamDomain* const* columns) const {
+    const size_t arity = getArity();
+    std::size_t row = 0;
+    for (iterator it = begin(); it != end(); ++it, ++row) {
+        const tuple& t = *it;
+        for (std::size_t j = 0; j < arity; j++) {
+            if (columns[j] != nullptr) {
+                columns[j][row] = t[j];
+            }
+        }
+    }
+    return row;
+}
+
 /**
  * Abstract base class for generated Datalog programs.
  */
@@ -654,6 +726,25 @@ public:
      */
     virtual void run(size_t stratumIndex = -1) {}
 
+    /**
+     * Re-execute the souffle program after further facts have been inserted,
+     * without any loads or stores.
+     *
+     * After an initial run(), input tuples may be added through the Relation
+     * interface and the derived relations brought up to date by calling this
+     * method. Only strata whose referenced relations changed since their last
+     * execution are re-evaluated; an update touching a single input typically
+     * re-runs a small fraction of the program. Since relations are sets,
+     * re-evaluating a stratum only adds conclusions that involve the new
+     * facts.
+     *
+     * Only insertions are supported: retracting a fact requires a full
+     * re-run on a fresh program instance.
+     */
+    virtual void runIncremental() {
+        run();
+    }
+
     /**
      * Execute program, loading inputs and storing outputs as required.
      * Read all input relations and store all output relations from the given directory.
@@ -826,6 +917,26 @@ public:
         }
     }
 
+    /**
+     * Reset the program for a further run on fresh input.
+     *
+     * All relations are purged in place, keeping the relation objects and
+     * their wrappers alive for reuse; the symbol table is retained, as it
+     * is append-only and the ordinals of previously interned symbols stay
+     * valid. Together with SymbolTable::seed(), this lets an embedding
+     * application keep one instance (or a pool of instances) alive across
+     * many small invocations instead of paying the full construction cost
+     * of ProgramFactory::newInstance() for each of them.
+     *
+     * @see Relation::purge()
+     * @see SymbolTable::seed()
+     */
+    virtual void reset() {
+        for (Relation* relation : allRelations) {
+            relation->purge();
+        }
+    }
+
     /**
      * Helper function for the wrapper function Relation::insert() and Relation::contains().
      */
@@ -15,7 +15,11 @@
  ***********************************************************************/
 
 #pragma once
+#include <algorithm>
 #include <iostream>
+#include <memory>
+#include <string_view>
+#include <vector>
 
 #include <stdio.h>
 #include <stdlib.h>
@@ -25,6 +29,70 @@
 
 namespace souffle {
 
+/**
+ * @class StringArena
+ *
+ * A bump-allocated arena owning the bytes of interned strings. Strings
+ * are copied into large chunks and referenced through string views, so
+ * storing a symbol costs its bytes plus a terminator instead of a heap
+ * block and a std::string header per symbol, and symbols interned
+ * together are laid out adjacently. Stored bytes are never moved or
+ * freed individually; views remain valid for the lifetime of the arena.
+ */
+class StringArena {
+public:
+    /**
+     * Copies the given string into the arena and returns a view of the
+     * stored copy. A terminator is placed behind the stored bytes, so
+     * the data() pointer of the returned view is also a valid C string.
+     */
+    std::string_view store(std::string_view str) {
+        size_t needed = str.size() + 1;
+        if (needed > remaining) {
+            size_t size = std::max(needed, CHUNK_SIZE);
+            chunks.emplace_back(new char[size]);
+            pos = chunks.back().get();
+            remaining = size;
+        }
+        char* dst = pos;
+        memcpy(dst, str.data(), str.size());
+        dst[str.size()] = '\0';
+        pos += needed;
+        remaining -= needed;
+        used += needed;
+        return std::string_view(dst, str.size());
+    }
+
+    /** Releases all stored strings, invalidating all handed-out views. */
+    void clear() {
+        chunks.clear();
+        pos = nullptr;
+        remaining = 0;
+        used = 0;
+    }
+
+    /** Obtains an estimate of the memory usage of this arena. */
+    size_t getMemoryUsage() const {
+        return sizeof(*this) + used + remaining + chunks.size() * sizeof(chunks.front());
+    }
+
+private:
+    /** The allocation granularity of the arena. */
+    static constexpr size_t CHUNK_SIZE = 1 << 20;
+
+    /** The chunks owning the stored bytes. */
+    std::vector<std::unique_ptr<char[]>> chunks;
+
+    /** The bump pointer into the current chunk. */
+    char* pos = nullptr;
+
+    /** The number of bytes left in the current chunk. */
+    size_t remaining = 0;
+
+    /** The number of bytes handed out, including terminators. */
+    size_t used = 0;
+};
+
 #define SLOOKUP(s) StringPool::instance()->lookup(s)
 
 class StringPool {
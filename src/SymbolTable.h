@@ -17,7 +17,9 @@
 #pragma once
 
 #include "ParallelUtils.h"
+#include "PiggyList.h"
 #include "RamTypes.h"
+#include "StringPool.h"
 #include "Util.h"
 
 #ifdef USE_MPI
@@ -25,12 +27,18 @@
 #include <thread>
 #endif
 
+#include <array>
 #include <cassert>
-#include <deque>
+#include <cstdint>
+#include <fstream>
 #include <initializer_list>
 #include <iostream>
+#include <memory>
+#include <stdexcept>
 #include <string>
+#include <string_view>
 #include <unordered_map>
+#include <vector>
 
 namespace souffle {
 
@@ -121,13 +129,13 @@ public:
                 case RESOLVE: {
                     RamDomain index;
                     mpi::recv(index, status);
-                    mpi::send(resolve(index), status);
+                    mpi::send(std::string(resolve(index)), status);
                     break;
                 }
                 case UNSAFE_RESOLVE: {
                     RamDomain index;
                     mpi::recv(index, status);
-                    mpi::send(unsafeResolve(index), status);
+                    mpi::send(std::string(unsafeResolve(index)), status);
                     break;
                 }
                 case SIZE: {
@@ -175,53 +183,101 @@ public:
 #endif
 
 private:
-    /** A lock to synchronize parallel accesses */
+    /** The number of lock stripes of the string-to-index map; must be a power of two. */
+    static constexpr size_t STRIPE_COUNT = 64;
+
+    /**
+     * A lock-striped fragment of the string-to-index map. Each symbol is
+     * owned by exactly one stripe, selected by its hash, so concurrent
+     * lookups of distinct symbols proceed without contending on a single
+     * table-wide lock. Each stripe owns the bytes of its symbols in a
+     * bump-allocated arena; the map keys and the index-to-string side are
+     * views into that arena, costing the symbol bytes plus a terminator
+     * instead of a heap block and a std::string header per symbol.
+     */
+    struct Stripe {
+        /** A lock to synchronize parallel accesses to this stripe */
+        mutable Lock access;
+
+        /** The arena owning the bytes of the symbols of this stripe. */
+        StringArena arena;
+
+        /** Map strings to indices, keyed by views into the arena. */
+        std::unordered_map<std::string_view, size_t> strToNum;
+    };
+
+    /** A lock to synchronize full-table operations (see acquireLock) */
     mutable Lock access;
 
-    /** Map indices to strings. */
-    std::deque<std::string> numToStr;
+    /** The lock stripes covering the string-to-index direction. */
+    mutable std::array<Stripe, STRIPE_COUNT> stripes;
 
-    /** Map strings to indices. */
-    std::unordered_map<std::string, size_t> strToNum;
+    /** Map indices to strings, viewing into the stripe arenas. Appends are
+     * lock-free and index-to-string resolution requires no lock at all. */
+    std::unique_ptr<PiggyList<std::string_view>> numToStr =
+            std::make_unique<PiggyList<std::string_view>>();
+
+    /** Determines the stripe owning the given symbol. */
+    Stripe& getStripe(std::string_view symbol) const {
+        return stripes[std::hash<std::string_view>()(symbol) & (STRIPE_COUNT - 1)];
+    }
 
     /** Convenience method to place a new symbol in the table, if it does not exist, and return the index of
      * it. */
-    inline size_t newSymbolOfIndex(const std::string& symbol) {
-        size_t index;
-        auto it = strToNum.find(symbol);
-        if (it == strToNum.end()) {
-            index = numToStr.size();
-            strToNum[symbol] = index;
-            numToStr.push_back(symbol);
-        } else {
-            index = it->second;
+    inline size_t newSymbolOfIndex(std::string_view symbol) {
+        auto& stripe = getStripe(symbol);
+        auto it = stripe.strToNum.find(symbol);
+        if (it != stripe.strToNum.end()) {
+            return it->second;
         }
+        std::string_view stored = stripe.arena.store(symbol);
+        size_t index = numToStr->createNode();
+        stripe.strToNum.emplace(stored, index);
+        numToStr->get(index) = stored;
         return index;
     }
 
     /** Convenience method to place a new symbol in the table, if it does not exist. */
-    inline void newSymbol(const std::string& symbol) {
-        if (strToNum.find(symbol) == strToNum.end()) {
-            strToNum[symbol] = numToStr.size();
-            numToStr.push_back(symbol);
+    inline void newSymbol(std::string_view symbol) {
+        newSymbolOfIndex(symbol);
+    }
+
+    /** Re-creates the content of the given table in this (empty) table,
+     * preserving all indices. */
+    void copyAll(const SymbolTable& other) {
+        for (size_t index = 0; index < other.size(); ++index) {
+            newSymbol(other.numToStr->get(index));
         }
     }
 
+    /** Removes all content from this table. */
+    void clear() {
+        for (auto& stripe : stripes) {
+            stripe.strToNum.clear();
+            stripe.arena.clear();
+        }
+        numToStr->clear();
+    }
+
 public:
     /** Empty constructor. */
     SymbolTable() = default;
 
     /** Copy constructor, performs a deep copy. */
-    SymbolTable(const SymbolTable& other) : numToStr(other.numToStr), strToNum(other.strToNum) {}
+    SymbolTable(const SymbolTable& other) {
+        copyAll(other);
+    }
 
     /** Copy constructor for r-value reference. */
     SymbolTable(SymbolTable&& other) noexcept {
+        for (size_t i = 0; i < STRIPE_COUNT; ++i) {
+            stripes[i].strToNum.swap(other.stripes[i].strToNum);
+            std::swap(stripes[i].arena, other.stripes[i].arena);
+        }
         numToStr.swap(other.numToStr);
-        strToNum.swap(other.strToNum);
     }
 
     SymbolTable(std::initializer_list<std::string> symbols) {
-        strToNum.reserve(symbols.size());
         for (const auto& symbol : symbols) {
             newSymbol(symbol);
         }
@@ -235,45 +291,61 @@ public:
         if (this == &other) {
             return *this;
         }
-        numToStr = other.numToStr;
-        strToNum = other.strToNum;
+        clear();
+        copyAll(other);
         return *this;
     }
 
     /** Assignment operator for r-value references. */
     SymbolTable& operator=(SymbolTable&& other) noexcept {
+        for (size_t i = 0; i < STRIPE_COUNT; ++i) {
+            stripes[i].strToNum.swap(other.stripes[i].strToNum);
+            std::swap(stripes[i].arena, other.stripes[i].arena);
+        }
         numToStr.swap(other.numToStr);
-        strToNum.swap(other.strToNum);
         return *this;
     }
 
     /** Find the index of a symbol in the table, inserting a new symbol if it does not exist there
      * already. */
-    RamDomain lookup(const std::string& symbol) {
+    RamDomain lookup(std::string_view symbol) {
 #ifdef USE_MPI
         if (mpi::commRank() != 0) {
-            return cacheLookup(symbol, LOOKUP);
+            return cacheLookup(std::string(symbol), LOOKUP);
         } else
 #endif
         {
-            auto lease = access.acquire();
+            auto lease = getStripe(symbol).access.acquire();
             (void)lease;  // avoid warning;
             return static_cast<RamDomain>(newSymbolOfIndex(symbol));
         }
     }
 
+    /** Find the indices of a batch of symbols in the table, inserting new symbols if they do not
+     * exist there already. This is the bulk variant of lookup(), used when feeding large numbers
+     * of facts through the program interface. */
+    std::vector<RamDomain> lookup(const std::vector<std::string>& symbols) {
+        std::vector<RamDomain> indices;
+        indices.reserve(symbols.size());
+        for (const auto& symbol : symbols) {
+            indices.push_back(lookup(symbol));
+        }
+        return indices;
+    }
+
     /** Finds the index of a symbol in the table, giving an error if it's not found */
-    RamDomain lookupExisting(const std::string& symbol) const {
+    RamDomain lookupExisting(std::string_view symbol) const {
 #ifdef USE_MPI
         if (mpi::commRank() != 0) {
-            return cacheLookup(symbol, LOOKUP_EXISTING);
+            return cacheLookup(std::string(symbol), LOOKUP_EXISTING);
         } else
 #endif
         {
-            auto lease = access.acquire();
+            auto& stripe = getStripe(symbol);
+            auto lease = stripe.access.acquire();
             (void)lease;  // avoid warning;
-            auto result = strToNum.find(symbol);
-            if (result == strToNum.end()) {
+            auto result = stripe.strToNum.find(symbol);
+            if (result == stripe.strToNum.end()) {
                 std::cerr << "Error string not found in call to SymbolTable::lookupExisting.\n";
                 exit(1);
             }
@@ -283,44 +355,66 @@ public:
 
     /** Find the index of a symbol in the table, inserting a new symbol if it does not exist there
      * already. */
-    RamDomain unsafeLookup(const std::string& symbol) {
+    RamDomain unsafeLookup(std::string_view symbol) {
 #ifdef USE_MPI
         if (mpi::commRank() != 0) {
-            return cacheLookup(symbol, UNSAFE_LOOKUP);
+            return cacheLookup(std::string(symbol), UNSAFE_LOOKUP);
         } else
 #endif
             return newSymbolOfIndex(symbol);
     }
 
     /** Find a symbol in the table by its index, note that this gives an error if the index is out of
-     * bounds.
+     * bounds. The returned view stays valid for the lifetime of the table;
+     * its data() pointer is also a valid C string, since the arenas place
+     * a terminator behind every stored symbol.
      */
-    const std::string& resolve(const RamDomain index) const {
+    std::string_view resolve(const RamDomain index) const {
 #ifdef USE_MPI
         if (mpi::commRank() != 0) {
             return cacheResolve(index, RESOLVE);
         } else
 #endif
         {
-            auto lease = access.acquire();
-            (void)lease;  // avoid warning;
             auto pos = static_cast<size_t>(index);
             if (pos >= size()) {
                 // TODO: use different error reporting here!!
                 std::cerr << "Error index out of bounds in call to SymbolTable::resolve.\n";
                 exit(1);
             }
-            return numToStr[pos];
+            return numToStr->get(pos);
         }
     }
 
-    const std::string& unsafeResolve(const RamDomain index) const {
+    std::string_view unsafeResolve(const RamDomain index) const {
 #ifdef USE_MPI
         if (mpi::commRank() != 0) {
             return cacheResolve(index, UNSAFE_RESOLVE);
         } else
 #endif
-            return numToStr[static_cast<size_t>(index)];
+            return numToStr->get(static_cast<size_t>(index));
+    }
+
+    /** Renumbers the symbols of the table according to the given permutation,
+     * where mapping[old] is the new index of the symbol currently stored at
+     * index old. Not thread-safe; the caller must ensure the table is
+     * quiescent, as it is between a completed parallel load and evaluation.
+     */
+    void rearrange(const std::vector<size_t>& mapping) {
+        assert(mapping.size() == size());
+        auto reordered = std::make_unique<PiggyList<std::string_view>>();
+        for (size_t old = 0; old < mapping.size(); ++old) {
+            reordered->createNode();
+        }
+        for (size_t old = 0; old < mapping.size(); ++old) {
+            reordered->get(mapping[old]) = numToStr->get(old);
+        }
+        numToStr = std::move(reordered);
+        for (auto& stripe : stripes) {
+            for (auto& entry : stripe.strToNum) {
+                entry.second = mapping[entry.second];
+            }
+        }
     }
 
     /* Return the size of the symbol table, being the number of symbols it currently holds. */
@@ -333,7 +427,20 @@ public:
             return size;
         } else
 #endif
-            return numToStr.size();
+            return numToStr->size();
+    }
+
+    /** Obtains an estimate of the memory usage of this table, including the
+     * stored symbols themselves. */
+    size_t getMemoryUsage() const {
+        size_t total = sizeof(*this) + numToStr->getMemoryUsage();
+        for (const auto& stripe : stripes) {
+            total += stripe.arena.getMemoryUsage();
+            total += stripe.strToNum.bucket_count() * sizeof(void*);
+            total += stripe.strToNum.size() *
+                     (sizeof(std::pair<const std::string_view, size_t>) + 2 * sizeof(void*));
+        }
+        return total;
     }
 
     /** Bulk insert symbols into the table, note that this operation is more efficient than repeated
@@ -346,11 +453,8 @@ public:
         } else
 #endif
         {
-            auto lease = access.acquire();
-            (void)lease;  // avoid warning;
-            strToNum.reserve(size() + symbols.size());
             for (auto& symbol : symbols) {
-                newSymbol(symbol);
+                insert(symbol);
             }
         }
     }
@@ -358,14 +462,14 @@ public:
     /** Insert a single symbol into the table, not that this operation should not be used if inserting
      * symbols
      * in bulk. */
-    void insert(const std::string& symbol) {
+    void insert(std::string_view symbol) {
 #ifdef USE_MPI
         if (mpi::commRank() != 0) {
-            mpi::send(symbol, 0, INSERT_STRING);
+            mpi::send(std::string(symbol), 0, INSERT_STRING);
         } else
 #endif
         {
-            auto lease = access.acquire();
+            auto lease = getStripe(symbol).access.acquire();
             (void)lease;  // avoid warning;
             newSymbol(symbol);
         }
@@ -380,21 +484,117 @@ public:
 #endif
         {
             out << "SymbolTable: {\n\t";
-            out << join(strToNum, "\n\t",
-                           [](std::ostream& out, const std::pair<std::string, std::size_t>& entry) {
-                               out << entry.first << "\t => " << entry.second;
-                           })
-                << "\n";
+            for (size_t index = 0; index < size(); ++index) {
+                out << numToStr->get(index) << "\t => " << index << "\n\t";
+            }
+            out << "\n";
             out << "}\n";
         }
     }
 
+    /**
+     * The fixed-size header preceding the string arena of a symbol-table
+     * snapshot file, shared between dump and restore.
+     */
+    struct SnapshotHeader {
+        // 'S' 'S' 'Y' 'M' -- souffle symbol-table snapshot
+        static const uint32_t MAGIC = 0x4d595353;
+        static const uint32_t VERSION = 1;
+
+        uint32_t magic = MAGIC;
+        uint32_t version = VERSION;
+        uint64_t numSymbols = 0;
+        uint64_t arenaSize = 0;
+    };
+
+    /**
+     * Writes an ordinal-stable snapshot of the table to the given file: a
+     * fixed header, the symbol lengths in ordinal order, and the
+     * concatenated symbol bytes as a single string arena. A later run
+     * restoring the snapshot assigns every symbol its old ordinal, so
+     * fact files written with numeric symbol ordinals stay valid.
+     */
+    void dump(const std::string& filename) const {
+        std::ofstream file(filename, std::ios::out | std::ios::binary);
+        if (!file.is_open()) {
+            throw std::invalid_argument("Cannot open symbol table snapshot file " + filename);
+        }
+        SnapshotHeader header;
+        header.numSymbols = size();
+        std::vector<uint32_t> lengths(header.numSymbols);
+        for (size_t index = 0; index < header.numSymbols; ++index) {
+            lengths[index] = numToStr->get(index).size();
+            header.arenaSize += lengths[index];
+        }
+        file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+        file.write(reinterpret_cast<const char*>(lengths.data()), lengths.size() * sizeof(uint32_t));
+        for (size_t index = 0; index < header.numSymbols; ++index) {
+            file.write(numToStr->get(index).data(), lengths[index]);
+        }
+    }
+
+    /**
+     * Restores a snapshot written by dump, re-interning every symbol at
+     * its old ordinal; each distinct symbol is hashed once instead of
+     * once per fact referencing it. The table may already hold a prefix
+     * of the snapshot - typically the program symbols seeded by the
+     * constructor - as long as the ordinals agree. A missing file is
+     * ignored, so the first (cold) run of a warm-start setup proceeds
+     * normally and creates the snapshot at the end. Not thread-safe; to
+     * be called before evaluation starts.
+     */
+    void restore(const std::string& filename) {
+        std::ifstream file(filename, std::ios::in | std::ios::binary);
+        if (!file.is_open()) {
+            return;
+        }
+        SnapshotHeader header;
+        file.read(reinterpret_cast<char*>(&header), sizeof(header));
+        if (!file || header.magic != SnapshotHeader::MAGIC || header.version != SnapshotHeader::VERSION) {
+            throw std::invalid_argument("Invalid symbol table snapshot file " + filename);
+        }
+        std::vector<uint32_t> lengths(header.numSymbols);
+        file.read(reinterpret_cast<char*>(lengths.data()), lengths.size() * sizeof(uint32_t));
+        std::vector<char> arena(header.arenaSize);
+        file.read(arena.data(), arena.size());
+        if (!file) {
+            throw std::invalid_argument("Truncated symbol table snapshot file " + filename);
+        }
+        const char* pos = arena.data();
+        for (uint64_t index = 0; index < header.numSymbols; ++index) {
+            if (newSymbolOfIndex(std::string_view(pos, lengths[index])) != index) {
+                throw std::invalid_argument(
+                        "Symbol table snapshot " + filename + " is inconsistent with this program");
+            }
+            pos += lengths[index];
+        }
+    }
+
+    /**
+     * Seeds this table from the given base table, re-interning every
+     * symbol of the base at its ordinal there. The in-memory counterpart
+     * of restore() for embedded settings that keep one read-only base
+     * table and stamp out many short-lived program instances against it.
+     * The table may already hold a prefix of the base - typically the
+     * program symbols seeded by the constructor - as long as the
+     * ordinals agree. Not thread-safe; to be called before evaluation
+     * starts.
+     */
+    void seed(const SymbolTable& base) {
+        for (size_t index = 0; index < base.numToStr->size(); ++index) {
+            if (newSymbolOfIndex(base.numToStr->get(index)) != index) {
+                throw std::invalid_argument("Base symbol table is inconsistent with this program");
+            }
+        }
+    }
+
     /** Check if the symbol table contains a string */
-    bool contains(const std::string& symbol) const {
-        auto lease = access.acquire();
+    bool contains(std::string_view symbol) const {
+        auto& stripe = getStripe(symbol);
+        auto lease = stripe.access.acquire();
         (void)lease;  // avoid warning;
-        auto result = strToNum.find(symbol);
-        if (result == strToNum.end()) {
+        auto result = stripe.strToNum.find(symbol);
+        if (result == stripe.strToNum.end()) {
             return false;
         } else {
             return true;
@@ -403,8 +603,6 @@ public:
 
     /** Check if the symbol table contains an index */
     bool contains(const RamDomain index) const {
-        auto lease = access.acquire();
-        (void)lease;  // avoid warning;
         auto pos = static_cast<size_t>(index);
         if (pos >= size()) {
             return false;
@@ -424,4 +622,66 @@ public:
     }
 };
 
+/**
+ * @class StringFunctorMemo
+ *
+ * A small per-thread memo table for string functor results. Entries map a
+ * functor tag and up to three argument ordinals to the ordinal of the
+ * result, so repeated evaluations over the same arguments bypass string
+ * construction and the symbol-table stripe locks entirely. The table is
+ * direct-mapped and of fixed size: a colliding entry is simply replaced.
+ */
+class StringFunctorMemo {
+public:
+    /** The memoizable functor tags. */
+    enum Op : uint8_t { TOSTRING, CAT, SUBSTR };
+
+    /**
+     * Returns the memoized result of the given functor application, or
+     * evaluates and memoizes the given computation on a miss. Unused
+     * argument slots are to be passed as zero.
+     */
+    template <typename Compute>
+    RamDomain getOrCompute(
+            Op op, size_t nargs, RamDomain a0, RamDomain a1, RamDomain a2, Compute&& compute) {
+        Entry& entry = entries[slot(op, a0, a1, a2)];
+        if (entry.valid && entry.op == op && entry.nargs == nargs && entry.args[0] == a0 &&
+                entry.args[1] == a1 && entry.args[2] == a2) {
+            return entry.result;
+        }
+        RamDomain result = compute();
+        entry = {{a0, a1, a2}, result, op, static_cast<uint8_t>(nargs), true};
+        return result;
+    }
+
+    /** Returns the memo of the calling thread. */
+    static StringFunctorMemo& instance() {
+        static thread_local StringFunctorMemo memo;
+        return memo;
+    }
+
+private:
+    struct Entry {
+        RamDomain args[3];
+        RamDomain result;
+        Op op;
+        uint8_t nargs;
+        bool valid = false;
+    };
+
+    /** The number of entries; must be a power of two. */
+    static constexpr size_t SIZE = 4096;
+
+    /** Determines the entry owning the given functor application. */
+    static size_t slot(Op op, RamDomain a0, RamDomain a1, RamDomain a2) {
+        uint64_t h = static_cast<uint64_t>(op) + 0x9e3779b97f4a7c15ull;
+        h = (h ^ static_cast<uint32_t>(a0)) * 0x100000001b3ull;
+        h = (h ^ static_cast<uint32_t>(a1)) * 0x100000001b3ull;
+        h = (h ^ static_cast<uint32_t>(a2)) * 0x100000001b3ull;
+        return static_cast<size_t>(h ^ (h >> 32)) & (SIZE - 1);
+    }
+
+    std::array<Entry, SIZE> entries{};
+};
+
 }  // namespace souffle
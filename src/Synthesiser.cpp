@@ -36,6 +36,7 @@
 #include <cassert>
 #include <cctype>
 #include <cstdlib>
+#include <fstream>
 #include <functional>
 #include <iostream>
 #include <sstream>
@@ -73,6 +74,102 @@ size_t Synthesiser::lookupReadIdx(const std::string& txt) {
     }
 }
 
+/** Collect the relations whose contents are fully known at compile time */
+void Synthesiser::computeConstantFacts() {
+    const RamProgram& prog = *translationUnit.getProgram();
+
+    // relations receiving any run-time write are not constant
+    std::set<std::string> mutated;
+    visitDepthFirst(prog, [&](const RamProject& project) { mutated.insert(project.getRelation().getName()); });
+    visitDepthFirst(prog, [&](const RamMerge& merge) { mutated.insert(merge.getTargetRelation().getName()); });
+    visitDepthFirst(prog, [&](const RamSwap& swap) {
+        mutated.insert(swap.getFirstRelation().getName());
+        mutated.insert(swap.getSecondRelation().getName());
+    });
+    visitDepthFirst(prog, [&](const RamLoad& load) { mutated.insert(load.getRelation().getName()); });
+    visitDepthFirst(prog, [&](const RamClear& clear) { mutated.insert(clear.getRelation().getName()); });
+
+    visitDepthFirst(prog, [&](const RamFact& fact) {
+        const std::string& name = fact.getRelation().getName();
+        // equivalence relations answer membership via their closure; their
+        // contents are not the facts alone
+        if (fact.getRelation().getRepresentation() == RelationRepresentation::EQREL) {
+            mutated.insert(name);
+            return;
+        }
+        std::vector<RamDomain> tuple;
+        for (const RamExpression* value : fact.getValues()) {
+            if (const auto* number = dynamic_cast<const RamNumber*>(value)) {
+                tuple.push_back(number->getConstant());
+            } else {
+                // a non-constant fact value defeats the specialization
+                mutated.insert(name);
+                return;
+            }
+        }
+        constantFacts[name].insert(tuple);
+    });
+
+    visitDepthFirst(prog, [&](const RamFactTable& facts) {
+        const std::string& name = facts.getRelation().getName();
+        // equivalence relations answer membership via their closure; their
+        // contents are not the facts alone
+        if (facts.getRelation().getRepresentation() == RelationRepresentation::EQREL) {
+            mutated.insert(name);
+            return;
+        }
+        const size_t arity = facts.getRelation().getArity();
+        const auto& table = facts.getTable();
+        for (size_t i = 0; i < table.size(); i += arity) {
+            constantFacts[name].insert(
+                    std::vector<RamDomain>(table.begin() + i, table.begin() + i + arity));
+        }
+    });
+
+    for (const std::string& name : mutated) {
+        constantFacts.erase(name);
+    }
+}
+
+void Synthesiser::computeRuleWrittenRelations() {
+    const RamProgram& prog = *translationUnit.getProgram();
+    visitDepthFirst(prog, [&](const RamProject& project) {
+        ruleWrittenRelations.insert(project.getRelation().getName());
+    });
+    visitDepthFirst(prog, [&](const RamMerge& merge) {
+        ruleWrittenRelations.insert(merge.getTargetRelation().getName());
+    });
+    visitDepthFirst(prog, [&](const RamSwap& swap) {
+        ruleWrittenRelations.insert(swap.getFirstRelation().getName());
+        ruleWrittenRelations.insert(swap.getSecondRelation().getName());
+    });
+}
+
+bool Synthesiser::isRuleWritten(const std::string& relName) const {
+    return ruleWrittenRelations.find(relName) != ruleWrittenRelations.end();
+}
+
+/** Check whether a Bloom filter pre-check applies to a membership probe
+ * into the given relation at the current emission point */
+bool Synthesiser::bloomFilterApplies(const std::string& relName) const {
+    if (!emittingStratum) {
+        return false;
+    }
+    if (bloomFilteredRelations.find(relName) == bloomFilteredRelations.end()) {
+        return false;
+    }
+    // the probing stratum must run after the filter has been built
+    auto pos = bloomBuildStratum.find(relName);
+    return pos != bloomBuildStratum.end() && pos->second < currentStratum;
+}
+
+/** Return the sorted tuples of a compile-time constant relation, or
+ * nullptr if the relation is mutated at run time */
+const std::set<std::vector<RamDomain>>* Synthesiser::getConstantFacts(const std::string& relName) const {
+    auto pos = constantFacts.find(relName);
+    return (pos == constantFacts.end()) ? nullptr : &pos->second;
+}
+
 /** Convert RAM identifier */
 const std::string Synthesiser::convertRamIdent(const std::string& name) {
     auto it = identifiers.find(name);
@@ -177,6 +274,8 @@ std::set<const RamRelation*> Synthesiser::getReferencedRelations(const RamOperat
             res.insert(&exists->getRelation());
         } else if (auto provExists = dynamic_cast<const RamProvenanceExistenceCheck*>(&node)) {
             res.insert(&provExists->getRelation());
+        } else if (auto subsumes = dynamic_cast<const RamSubsumptionCheck*>(&node)) {
+            res.insert(&subsumes->getRelation());
         } else if (auto project = dynamic_cast<const RamProject*>(&node)) {
             res.insert(&project->getRelation());
         }
@@ -207,6 +306,212 @@ void Synthesiser::emitCode(std::ostream& out, const RamStatement& stmt) {
         std::ostringstream preamble;
         bool preambleIssued = false;
 
+        /** relations of the current query whose insertions are staged in
+         * per-thread buffers, indexed by their synthesised name */
+        std::map<std::string, const RamRelation*> stagedRelations;
+
+        /** frequency and read counters of the current query that are
+         * accumulated in local counters and flushed once at the end,
+         * instead of bumping the shared counter arrays per tuple */
+        std::set<size_t> stagedFreqIdx;
+        std::set<size_t> stagedReadIdx;
+
+        /** whether the condition currently emitted is the operand of a
+         * negation, making a Bloom filter pre-check worthwhile */
+        bool insideNegation = false;
+
+        /** Determines whether the given expression is cheap, branch-free
+         * arithmetic: constants, tuple accesses, and intrinsics that can
+         * not fault. Divisions are excluded -- unconditional evaluation
+         * must not trip guards a preceding conjunct would have enforced. */
+        static bool isCheapArithmetic(const RamExpression& expr) {
+            if (dynamic_cast<const RamNumber*>(&expr) != nullptr) {
+                return true;
+            }
+            if (dynamic_cast<const RamTupleElement*>(&expr) != nullptr) {
+                return true;
+            }
+            if (const auto* op = dynamic_cast<const RamIntrinsicOperator*>(&expr)) {
+                switch (op->getOperator()) {
+                    case FunctorOp::NEG:
+                    case FunctorOp::BNOT:
+                    case FunctorOp::LNOT:
+                    case FunctorOp::ADD:
+                    case FunctorOp::SUB:
+                    case FunctorOp::MUL:
+                    case FunctorOp::BAND:
+                    case FunctorOp::BOR:
+                    case FunctorOp::BXOR:
+                    case FunctorOp::LAND:
+                    case FunctorOp::LOR:
+                    case FunctorOp::MAX:
+                    case FunctorOp::MIN:
+                        break;
+                    default:
+                        return false;
+                }
+                for (const RamExpression* arg : op->getArguments()) {
+                    if (!isCheapArithmetic(*arg)) {
+                        return false;
+                    }
+                }
+                return true;
+            }
+            return false;
+        }
+
+        /** Determines whether the given condition is a cheap arithmetic
+         * comparison that can be evaluated branchlessly over a batch */
+        static bool isVectorizableCondition(const RamCondition& cond) {
+            const auto* constraint = dynamic_cast<const RamConstraint*>(&cond);
+            if (constraint == nullptr) {
+                return false;
+            }
+            switch (constraint->getOperator()) {
+                case BinaryConstraintOp::EQ:
+                case BinaryConstraintOp::NE:
+                case BinaryConstraintOp::LT:
+                case BinaryConstraintOp::LE:
+                case BinaryConstraintOp::GT:
+                case BinaryConstraintOp::GE:
+                    break;
+                default:
+                    return false;
+            }
+            return isCheapArithmetic(constraint->getLHS()) && isCheapArithmetic(constraint->getRHS());
+        }
+
+        /** Determines whether the given filter consists solely of cheap
+         * arithmetic comparisons, making it eligible for the batched,
+         * branchless evaluation in visitScan */
+        static bool isVectorizableFilter(const RamFilter& filter) {
+            for (const auto& cur : toConjunctionList(&filter.getCondition())) {
+                if (!isVectorizableCondition(*cur)) {
+                    return false;
+                }
+            }
+            return true;
+        }
+
+        /** Determines whether the given condition is a (possibly negated)
+         * total existence check that can be answered through the batched
+         * containsBatch probe of the underlying data structure: the key
+         * columns are cheap arithmetic, the generated relation type offers
+         * a batched probe, and none of the scalar fast paths of
+         * visitExistenceCheck (constant-fact tables, Bloom filters) would
+         * serve it better */
+        bool isBatchableProbe(const RamCondition& cond) const {
+            const RamCondition* inner = &cond;
+            bool negated = false;
+            if (const auto* neg = dynamic_cast<const RamNegation*>(inner)) {
+                inner = &neg->getOperand();
+                negated = true;
+            }
+            const auto* exists = dynamic_cast<const RamExistenceCheck*>(inner);
+            if (exists == nullptr) {
+                return false;
+            }
+            const auto& rel = exists->getRelation();
+            if (rel.getArity() == 0 || !isa->isTotalSignature(exists)) {
+                return false;
+            }
+            if (synthesiser.getConstantFacts(rel.getName()) != nullptr) {
+                return false;
+            }
+            if (negated && synthesiser.bloomFilterApplies(rel.getName())) {
+                return false;
+            }
+            for (const RamExpression* expr : exists->getValues()) {
+                if (!isCheapArithmetic(*expr)) {
+                    return false;
+                }
+            }
+            const bool isProvInfo = rel.getName().find("@info") != std::string::npos;
+            auto relationType = SynthesiserRelation::getSynthesiserRelation(rel, isa->getIndexes(rel),
+                    Global::config().has("provenance") && !isProvInfo &&
+                            synthesiser.isRuleWritten(rel.getName()));
+            return relationType->hasBatchedContains();
+        }
+
+        /** Determines whether the given filter consists solely of cheap
+         * arithmetic comparisons and batchable membership probes, making
+         * it eligible for the batched evaluation in visitScan */
+        bool isBatchableFilter(const RamFilter& filter) const {
+            for (const auto& cur : toConjunctionList(&filter.getCondition())) {
+                if (!isVectorizableCondition(*cur) && !isBatchableProbe(*cur)) {
+                    return false;
+                }
+            }
+            return true;
+        }
+
+        /** Determines whether the given relation can be snapshotted for
+         * the experimental offload path: plain btree representation and
+         * numeric columns only, since an offloaded kernel cannot consult
+         * the symbol or record tables */
+        static bool isOffloadableRelation(const RamRelation& rel) {
+            if (rel.getArity() == 0) {
+                return false;
+            }
+            if (rel.getRepresentation() != RelationRepresentation::DEFAULT &&
+                    rel.getRepresentation() != RelationRepresentation::BTREE) {
+                return false;
+            }
+            for (const std::string& type : rel.getAttributeTypeQualifiers()) {
+                if (!type.empty() && type[0] != 'i') {
+                    return false;
+                }
+            }
+            return true;
+        }
+
+        /** Determines whether the given loop nest qualifies for the
+         * experimental offload path: a parallel scan over flat scans,
+         * index lookups and arithmetic filters, projecting into a numeric
+         * relation. Existence checks, aggregates and choices disqualify,
+         * as they would need host data structures inside the kernel. */
+        static bool isOffloadableQuery(const RamOperation& root) {
+            if (dynamic_cast<const RamParallelScan*>(&root) == nullptr) {
+                return false;
+            }
+            const RamOperation* op = &root;
+            while (true) {
+                if (const auto* indexScan = dynamic_cast<const RamIndexScan*>(op)) {
+                    if (!isOffloadableRelation(indexScan->getRelation())) {
+                        return false;
+                    }
+                    for (const RamExpression* expr : indexScan->getRangePattern()) {
+                        if (!isRamUndefValue(expr) && !isCheapArithmetic(*expr)) {
+                            return false;
+                        }
+                    }
+                    op = &indexScan->getOperation();
+                } else if (const auto* scan = dynamic_cast<const RamScan*>(op)) {
+                    if (!isOffloadableRelation(scan->getRelation())) {
+                        return false;
+                    }
+                    op = &scan->getOperation();
+                } else if (const auto* filter = dynamic_cast<const RamFilter*>(op)) {
+                    if (!isVectorizableFilter(*filter)) {
+                        return false;
+                    }
+                    op = &filter->getOperation();
+                } else if (const auto* project = dynamic_cast<const RamProject*>(op)) {
+                    if (!isOffloadableRelation(project->getRelation())) {
+                        return false;
+                    }
+                    for (const RamExpression* expr : project->getValues()) {
+                        if (!isCheapArithmetic(*expr)) {
+                            return false;
+                        }
+                    }
+                    return true;
+                } else {
+                    return false;
+                }
+            }
+        }
+
     public:
         CodeEmitter(Synthesiser& syn)
                 : synthesiser(syn), isa(syn.getTranslationUnit().getAnalysis<RamIndexAnalysis>()) {
@@ -227,9 +532,35 @@ void Synthesiser::emitCode(std::ostream& out, const RamStatement& stmt) {
             PRINT_END_COMMENT(out);
         }
 
+        void visitFactTable(const RamFactTable& facts, std::ostream& out) override {
+            PRINT_BEGIN_COMMENT(out);
+            const auto& rel = facts.getRelation();
+            const size_t arity = rel.getArity();
+            const auto& table = facts.getTable();
+            // embed the fact tuples as one static constant table and
+            // bulk-insert it instead of one statement per fact
+            out << "{\n";
+            out << "static const RamDomain table[" << table.size() << "] = {" << join(table, ",")
+                << "};\n";
+            out << "for (size_t i = 0; i < " << table.size() << "; i += " << arity << ") {\n";
+            out << synthesiser.getRelationName(rel) << "->insert(";
+            for (size_t i = 0; i < arity; i++) {
+                out << (i == 0 ? "" : ",") << "table[i + " << i << "]";
+            }
+            out << ");\n";
+            out << "}\n";
+            out << "}\n";
+            PRINT_END_COMMENT(out);
+        }
+
         void visitLoad(const RamLoad& load, std::ostream& out) override {
             PRINT_BEGIN_COMMENT(out);
-            out << "if (performIO) {\n";
+            if (Global::config().has("pipeline-store")) {
+                out << "joinPendingStore(\"" << synthesiser.getRelationName(load.getRelation())
+                    << "\");\n";
+            }
+            // outline the one-off I/O code into a cold section
+            out << "if (performIO) [&]() SOUFFLE_COLD_ATTRIBUTES {\n";
             std::vector<bool> symbolMask;
             for (auto& cur : load.getRelation().getAttributeTypeQualifiers()) {
                 symbolMask.push_back(cur[0] == 's');
@@ -253,13 +584,26 @@ void Synthesiser::emitCode(std::ostream& out, const RamStatement& stmt) {
                 out << "} catch (std::exception& e) {std::cerr << \"Error loading data: \" << e.what() << "
                        "'\\n';}\n";
             }
-            out << "}\n";
+            out << "}();\n";
             PRINT_END_COMMENT(out);
         }
 
         void visitStore(const RamStore& store, std::ostream& out) override {
             PRINT_BEGIN_COMMENT(out);
-            out << "if (performIO) {\n";
+            const bool async = Global::config().has("pipeline-store");
+            const std::string relName = synthesiser.getRelationName(store.getRelation());
+            if (async) {
+                // hand the write to a background I/O thread; the mutation
+                // sites and the end of runFunction join it before the
+                // relation can change again
+                out << "if (performIO) {\n";
+                out << "joinPendingStore(\"" << relName << "\");\n";
+                out << "pendingStores[\"" << relName << "\"] = std::async(std::launch::async, "
+                       "[this,outputDirectory]() SOUFFLE_COLD_ATTRIBUTES {\n";
+            } else {
+                // outline the one-off I/O code into a cold section
+                out << "if (performIO) [&]() SOUFFLE_COLD_ATTRIBUTES {\n";
+            }
             std::vector<bool> symbolMask;
             for (auto& cur : store.getRelation().getAttributeTypeQualifiers()) {
                 symbolMask.push_back(cur[0] == 's');
@@ -276,16 +620,183 @@ void Synthesiser::emitCode(std::ostream& out, const RamStatement& stmt) {
                 out << "std::vector<bool>({" << join(symbolMask) << "})";
                 out << ", symTable, ioDirectives";
                 out << ", " << (Global::config().has("provenance") ? "true" : "false");
-                out << ")->writeAll(*" << synthesiser.getRelationName(store.getRelation()) << ");\n";
+                out << ")->writeAll(*" << relName << ");\n";
                 out << "} catch (std::exception& e) {std::cerr << e.what();exit(1);}\n";
             }
-            out << "}\n";
+            if (async) {
+                out << "});\n";
+                out << "}\n";
+            } else {
+                out << "}();\n";
+            }
             PRINT_END_COMMENT(out);
         }
 
+        /** Emits the loops of an offloaded nest; in the counting pass the
+         * projection increments the match counter, in the filling pass it
+         * claims a slot of the pre-sized result buffer */
+        void emitOffloadedNest(const RamOperation& op, bool fill, std::ostream& out) {
+            if (const auto* indexScan = dynamic_cast<const RamIndexScan*>(&op)) {
+                const auto id = indexScan->getTupleId();
+                const size_t arity = indexScan->getRelation().getArity();
+                const auto& pattern = indexScan->getRangePattern();
+                out << "const RamDomain key_" << id << "[] = {";
+                bool first = true;
+                for (size_t i = 0; i < pattern.size(); i++) {
+                    if (!isRamUndefValue(pattern[i])) {
+                        out << (first ? "" : ",");
+                        visit(*pattern[i], out);
+                        first = false;
+                    }
+                }
+                out << "};\n";
+                out << "const std::size_t cols_" << id << "[] = {";
+                size_t keyLength = 0;
+                for (size_t i = 0; i < pattern.size(); i++) {
+                    if (!isRamUndefValue(pattern[i])) {
+                        out << (keyLength == 0 ? "" : ",") << i;
+                        keyLength++;
+                    }
+                }
+                out << "};\n";
+                out << "const std::size_t lo_" << id << " = offload::lowerBound(data_" << id << ",rows_"
+                    << id << "," << arity << ",cols_" << id << ",key_" << id << "," << keyLength << ");\n";
+                out << "const std::size_t hi_" << id << " = offload::upperBound(data_" << id << ",rows_"
+                    << id << "," << arity << ",cols_" << id << ",key_" << id << "," << keyLength << ");\n";
+                out << "for(std::size_t i" << id << " = lo_" << id << "; i" << id << " < hi_" << id
+                    << "; i" << id << "++) {\n";
+                out << "const RamDomain* env" << id << " = data_" << id << " + i" << id << " * " << arity
+                    << ";\n";
+                emitOffloadedNest(indexScan->getOperation(), fill, out);
+                out << "}\n";
+            } else if (const auto* scan = dynamic_cast<const RamScan*>(&op)) {
+                const auto id = scan->getTupleId();
+                const size_t arity = scan->getRelation().getArity();
+                out << "for(std::size_t i" << id << " = 0; i" << id << " < rows_" << id << "; i" << id
+                    << "++) {\n";
+                out << "const RamDomain* env" << id << " = data_" << id << " + i" << id << " * " << arity
+                    << ";\n";
+                emitOffloadedNest(scan->getOperation(), fill, out);
+                out << "}\n";
+            } else if (const auto* filter = dynamic_cast<const RamFilter*>(&op)) {
+                out << "if(";
+                visit(filter->getCondition(), out);
+                out << ") {\n";
+                emitOffloadedNest(filter->getOperation(), fill, out);
+                out << "}\n";
+            } else if (const auto* project = dynamic_cast<const RamProject*>(&op)) {
+                if (!fill) {
+                    out << "offload_count++;\n";
+                } else {
+                    const auto values = project->getValues();
+                    out << "std::size_t offload_slot;\n";
+                    out << "#pragma omp atomic capture\n";
+                    out << "offload_slot = offload_cursor++;\n";
+                    for (size_t i = 0; i < values.size(); i++) {
+                        out << "offload_buf[offload_slot * " << values.size() << " + " << i << "] = ";
+                        visit(*values[i], out);
+                        out << ";\n";
+                    }
+                }
+            }
+        }
+
+        /** Emits the offloaded variant of a qualifying loop nest: the
+         * scanned relations are snapshotted into flat sorted arrays on
+         * the host, the nest itself runs as an OpenMP target region in
+         * two passes -- one counting matches, one filling a pre-sized
+         * result buffer -- and the result is inserted back on the host */
+        void emitOffloadedQuery(const RamOperation& root, std::ostream& out) {
+            // collect the scans and the projection of the nest; its shape
+            // was validated by isOffloadableQuery
+            std::vector<const RamRelationOperation*> scans;
+            const RamProject* project = nullptr;
+            const RamOperation* op = &root;
+            while (project == nullptr) {
+                if (const auto* scan = dynamic_cast<const RamRelationOperation*>(op)) {
+                    scans.push_back(scan);
+                    op = &scan->getOperation();
+                } else if (const auto* filter = dynamic_cast<const RamFilter*>(op)) {
+                    op = &filter->getOperation();
+                } else {
+                    project = dynamic_cast<const RamProject*>(op);
+                }
+            }
+            const size_t outArity = project->getValues().size();
+
+            out << "{\n";
+
+            // snapshot the scanned relations into flat arrays, sorted on
+            // the bound columns of their scans
+            for (const auto* scan : scans) {
+                const auto id = scan->getTupleId();
+                const auto& rel = scan->getRelation();
+                const auto relName = synthesiser.getRelationName(rel);
+                out << "offload::Snapshot snap_" << id << "(" << rel.getArity() << ");\n";
+                out << "snap_" << id << ".reserve(" << relName << "->size());\n";
+                out << "for(const auto& env : *" << relName << ") {\n";
+                for (size_t i = 0; i < rel.getArity(); i++) {
+                    out << "snap_" << id << ".append(env[" << i << "]);\n";
+                }
+                out << "}\n";
+                if (const auto* indexScan = dynamic_cast<const RamIndexScan*>(scan)) {
+                    out << "snap_" << id << ".sort({";
+                    const auto& pattern = indexScan->getRangePattern();
+                    bool first = true;
+                    for (size_t i = 0; i < pattern.size(); i++) {
+                        if (!isRamUndefValue(pattern[i])) {
+                            out << (first ? "" : ",") << i;
+                            first = false;
+                        }
+                    }
+                    out << "});\n";
+                }
+                out << "const RamDomain* data_" << id << " = snap_" << id << ".data();\n";
+                out << "const std::size_t rows_" << id << " = snap_" << id << ".rows();\n";
+            }
+            std::stringstream mapSnapshots;
+            mapSnapshots << " map(to : ";
+            for (const auto* scan : scans) {
+                const auto id = scan->getTupleId();
+                mapSnapshots << (scan == scans.front() ? "" : ",") << "data_" << id << "[0:rows_" << id
+                             << "*" << scan->getRelation().getArity() << "]";
+            }
+            mapSnapshots << ")";
+
+            // first pass: count the matches of the nest
+            out << "std::size_t offload_count = 0;\n";
+            out << "#pragma omp target teams distribute parallel for reduction(+ : offload_count)"
+                << mapSnapshots.str() << "\n";
+            emitOffloadedNest(root, false, out);
+
+            // second pass: fill a result buffer of the counted size
+            out << "std::vector<RamDomain> offload_result(offload_count * " << outArity << ");\n";
+            out << "RamDomain* offload_buf = offload_result.data();\n";
+            out << "std::size_t offload_cursor = 0;\n";
+            out << "#pragma omp target teams distribute parallel for map(tofrom : offload_cursor)"
+                << " map(from : offload_buf[0:offload_count*" << outArity << "])" << mapSnapshots.str()
+                << "\n";
+            emitOffloadedNest(root, true, out);
+
+            // insert the result into the target relation on the host
+            out << "for(std::size_t i = 0; i < offload_count; i++) {\n";
+            out << "Tuple<RamDomain," << outArity << "> tuple;\n";
+            for (size_t i = 0; i < outArity; i++) {
+                out << "tuple[" << i << "] = offload_buf[i * " << outArity << " + " << i << "];\n";
+            }
+            out << synthesiser.getRelationName(project->getRelation()) << "->insert(tuple);\n";
+            out << "}\n";
+
+            out << "}\n";
+        }
+
         void visitQuery(const RamQuery& query, std::ostream& out) override {
             PRINT_BEGIN_COMMENT(out);
 
+            // counters staged by a previous query are out of scope here
+            stagedFreqIdx.clear();
+            stagedReadIdx.clear();
+
             // split terms of conditions of outer filter operation
             // into terms that require a context and terms that
             // do not require a context
@@ -314,17 +825,55 @@ void Synthesiser::emitCode(std::ostream& out, const RamStatement& stmt) {
                 }
             }
 
-            // outline each search operation to improve compilation time
+            // experimental accelerator offload: if the nest qualifies,
+            // emit the offloaded variant alongside the regular one; the
+            // generated program selects between them when it is compiled
+            const bool offloaded = Global::config().has("offload") && !Global::config().has("profile") &&
+                                   requireCtx.empty() && isOffloadableQuery(*next);
+            if (offloaded) {
+                out << "#ifdef SOUFFLE_USE_OFFLOAD\n";
+                emitOffloadedQuery(*next, out);
+                out << "#else\n";
+            }
+
+            // outline each search operation into its own function; the
+            // lambda is kept out of line so every rule body becomes a
+            // separate, tight function instead of being folded into one
+            // megabyte-scale run function, improving both compilation
+            // time and instruction-cache behavior
 #ifdef __clang__
 #if __clang_major > 3
-            out << "[&]()";
+            out << "[&]() SOUFFLE_RULE_ATTRIBUTES";
 #endif
 #else
-            out << "[&]()";
+            out << "[&]() SOUFFLE_RULE_ATTRIBUTES";
 #endif
             // enclose operation in its own scope
             out << "{\n";
 
+            // build the transient hash tables of the hash scans in this
+            // query; built once up front, they are shared read-only by
+            // all threads of a parallel loop nest
+            visitDepthFirst(*next, [&](const RamHashScan& hscan) {
+                const auto& rel = hscan.getRelation();
+                auto relName = synthesiser.getRelationName(rel);
+                auto identifier = hscan.getTupleId();
+                const auto& rangePattern = hscan.getRangePattern();
+                out << "JoinHashTable hash_" << identifier << "({";
+                bool first = true;
+                for (size_t i = 0; i < rangePattern.size(); i++) {
+                    if (!isRamUndefValue(rangePattern[i])) {
+                        out << (first ? "" : ",") << i;
+                        first = false;
+                    }
+                }
+                out << "}," << rel.getArity() << ");\n";
+                out << "hash_" << identifier << ".reserve(" << relName << "->size());\n";
+                out << "for(const auto& env : *" << relName << ") {\n";
+                out << "hash_" << identifier << ".insert(&env[0]);\n";
+                out << "}\n";
+            });
+
             // check whether loop nest can be parallelized
             bool isParallel = false;
             visitDepthFirst(*next, [&](const RamAbstractParallel& node) { isParallel = true; });
@@ -341,6 +890,62 @@ void Synthesiser::emitCode(std::ostream& out, const RamStatement& stmt) {
                 preamble << "->createContext());\n";
             }
 
+            // determine the relations whose insertions can be staged in
+            // per-thread buffers; a relation qualifies if the loop nest only
+            // writes to it, so deferring its tuples to the end of the
+            // parallel section cannot change the outcome of any read and the
+            // innermost rule body is freed of cross-thread synchronization
+            stagedRelations.clear();
+            if (isParallel) {
+                visitDepthFirst(*next, [&](const RamProject& project) {
+                    const RamRelation& rel = project.getRelation();
+                    if (rel.getArity() > 0 && rel.getRepresentation() != RelationRepresentation::EQREL) {
+                        stagedRelations[synthesiser.getRelationName(rel)] = &rel;
+                    }
+                });
+                visitDepthFirst(*next, [&](const RamNode& node) {
+                    if (auto* op = dynamic_cast<const RamRelationOperation*>(&node)) {
+                        stagedRelations.erase(synthesiser.getRelationName(op->getRelation()));
+                    } else if (auto* exists = dynamic_cast<const RamExistenceCheck*>(&node)) {
+                        stagedRelations.erase(synthesiser.getRelationName(exists->getRelation()));
+                    } else if (auto* provExists = dynamic_cast<const RamProvenanceExistenceCheck*>(&node)) {
+                        stagedRelations.erase(synthesiser.getRelationName(provExists->getRelation()));
+                    } else if (auto* subsumes = dynamic_cast<const RamSubsumptionCheck*>(&node)) {
+                        stagedRelations.erase(synthesiser.getRelationName(subsumes->getRelation()));
+                    } else if (auto* empty = dynamic_cast<const RamEmptinessCheck*>(&node)) {
+                        stagedRelations.erase(synthesiser.getRelationName(empty->getRelation()));
+                    }
+                });
+                for (const auto& cur : stagedRelations) {
+                    preamble << "std::vector<Tuple<RamDomain," << cur.second->getArity() << ">> stage_"
+                             << cur.first << ";\n";
+                }
+            }
+
+            // stage the profile counters touched by this query in local
+            // counters; per-tuple increments of the shared counter arrays
+            // would contend between threads, so each invocation (each
+            // thread of a parallel loop nest) accumulates locally and
+            // flushes once at the end of the query
+            if (Global::config().has("profile")) {
+                visitDepthFirst(*next, [&](const RamNestedOperation& nested) {
+                    if (!nested.getProfileText().empty()) {
+                        stagedFreqIdx.insert(synthesiser.lookupFreqIdx(nested.getProfileText()));
+                    }
+                });
+                visitDepthFirst(*next, [&](const RamExistenceCheck& exists) {
+                    if (!exists.getRelation().isTemp()) {
+                        stagedReadIdx.insert(synthesiser.lookupReadIdx(exists.getRelation().getName()));
+                    }
+                });
+                for (auto idx : stagedFreqIdx) {
+                    preamble << "size_t freq_local_" << idx << "{};\n";
+                }
+                for (auto idx : stagedReadIdx) {
+                    preamble << "size_t read_local_" << idx << "{};\n";
+                }
+            }
+
             // discharge conditions that require a context
             if (isParallel) {
                 if (requireCtx.size() > 0) {
@@ -365,8 +970,38 @@ void Synthesiser::emitCode(std::ostream& out, const RamStatement& stmt) {
                 }
             }
 
+            // flush the locally accumulated profile counters into the
+            // shared arrays; one relaxed atomic add per counter per
+            // invocation, instead of one increment per tuple
+            auto flushProfileCounters = [&](std::ostream& o) {
+                for (auto idx : stagedFreqIdx) {
+                    o << "freqs[" << idx << "].fetch_add(freq_local_" << idx
+                      << ", std::memory_order_relaxed);\n";
+                }
+                for (auto idx : stagedReadIdx) {
+                    o << "reads[" << idx << "].fetch_add(read_local_" << idx
+                      << ", std::memory_order_relaxed);\n";
+                }
+            };
+
             if (isParallel) {
+                // merge the per-thread staging buffers into their target
+                // relations; every thread bulk-inserts its own buffer, in
+                // sorted order to maximise the value of the insert hints
+                for (const auto& cur : stagedRelations) {
+                    out << "if (!stage_" << cur.first << ".empty()) {\n";
+                    out << "std::sort(stage_" << cur.first << ".begin(), stage_" << cur.first
+                        << ".end());\n";
+                    out << "for(const auto& env : stage_" << cur.first << ") {\n";
+                    out << cur.first << "->insert(env,READ_OP_CONTEXT("
+                        << synthesiser.getOpContextName(*cur.second) << "));\n";
+                    out << "}\n";
+                    out << "}\n";
+                }
+                flushProfileCounters(out);
                 out << "PARALLEL_END;\n";  // end parallel
+            } else {
+                flushProfileCounters(out);
             }
 
             out << "}\n";
@@ -377,36 +1012,95 @@ void Synthesiser::emitCode(std::ostream& out, const RamStatement& stmt) {
 #else
             out << "();";  // call lambda
 #endif
+            if (offloaded) {
+                out << "\n#endif\n";
+            }
             if (freeOfCtx.size() > 0) {
                 out << "}\n";
             }
 
+            // the local counters end their scope with the query
+            stagedFreqIdx.clear();
+            stagedReadIdx.clear();
+
             PRINT_END_COMMENT(out);
         }
 
         void visitMerge(const RamMerge& merge, std::ostream& out) override {
             PRINT_BEGIN_COMMENT(out);
+            const auto& srcName = synthesiser.getRelationName(merge.getSourceRelation());
+            const auto& trgName = synthesiser.getRelationName(merge.getTargetRelation());
+            if (Global::config().has("pipeline-store")) {
+                out << "joinPendingStore(\"" << srcName << "\");\n";
+                out << "joinPendingStore(\"" << trgName << "\");\n";
+            }
             if (merge.getTargetRelation().getRepresentation() == RelationRepresentation::EQREL) {
-                out << synthesiser.getRelationName(merge.getSourceRelation()) << "->"
+                out << srcName << "->"
                     << "extend("
-                    << "*" << synthesiser.getRelationName(merge.getTargetRelation()) << ");\n";
+                    << "*" << trgName << ");\n";
+                out << trgName << "->"
+                    << "insertAll("
+                    << "*" << srcName << ");\n";
+                PRINT_END_COMMENT(out);
+                return;
+            }
+            // merge large relations partition-wise in parallel; the source
+            // partitions are processed by concurrent threads inserting into
+            // the target with their own operation context
+            if (merge.getTargetRelation().getArity() > 0) {
+                out << "if (" << srcName << "->size() > 10000) {\n";
+                out << "auto part = " << srcName << "->partition();\n";
+                out << "PARALLEL_START;\n";
+                out << "CREATE_OP_CONTEXT(" << synthesiser.getOpContextName(merge.getTargetRelation())
+                    << "," << trgName << "->createContext());\n";
+                out << "pfor(auto it = part.begin(); it<part.end();++it){\n";
+                out << "try{\n";
+                out << "for(const auto& env0 : *it) {\n";
+                out << trgName << "->insert(env0,READ_OP_CONTEXT("
+                    << synthesiser.getOpContextName(merge.getTargetRelation()) << "));\n";
+                out << "}\n";
+                out << "} catch(std::exception &e) { SignalHandler::instance()->error(e.what());}\n";
+                out << "}\n";
+                out << "PARALLEL_END;\n";
+                out << "} else {\n";
+                out << trgName << "->"
+                    << "insertAll("
+                    << "*" << srcName << ");\n";
+                out << "}\n";
+            } else {
+                out << trgName << "->"
+                    << "insertAll("
+                    << "*" << srcName << ");\n";
             }
-            out << synthesiser.getRelationName(merge.getTargetRelation()) << "->"
-                << "insertAll("
-                << "*" << synthesiser.getRelationName(merge.getSourceRelation()) << ");\n";
             PRINT_END_COMMENT(out);
         }
 
         void visitClear(const RamClear& clear, std::ostream& out) override {
             PRINT_BEGIN_COMMENT(out);
-            out << synthesiser.getRelationName(clear.getRelation()) << "->"
-                << "purge();\n";
+            if (Global::config().has("pipeline-store")) {
+                out << "joinPendingStore(\"" << synthesiser.getRelationName(clear.getRelation())
+                    << "\");\n";
+            }
+            if (clear.getRelation().isTemp()) {
+                // delta and new relations are re-filled with a similar shape
+                // in the very next iteration -- keep their node memory for
+                // reuse instead of returning it just to request it back
+                out << synthesiser.getRelationName(clear.getRelation()) << "->"
+                    << "recycle();\n";
+            } else {
+                out << synthesiser.getRelationName(clear.getRelation()) << "->"
+                    << "purge();\n";
+            }
             PRINT_END_COMMENT(out);
         }
 
         void visitDrop(const RamDrop& drop, std::ostream& out) override {
             PRINT_BEGIN_COMMENT(out);
 
+            if (Global::config().has("pipeline-store") && !drop.getRelation().isTemp()) {
+                out << "joinPendingStore(\"" << synthesiser.getRelationName(drop.getRelation())
+                    << "\");\n";
+            }
             out << "if (!isHintsProfilingEnabled()"
                 << (drop.getRelation().isTemp() ? ") " : "&& performIO) ");
             out << synthesiser.getRelationName(drop.getRelation()) << "->"
@@ -483,6 +1177,10 @@ void Synthesiser::emitCode(std::ostream& out, const RamStatement& stmt) {
             const std::string& deltaKnowledge = synthesiser.getRelationName(swap.getFirstRelation());
             const std::string& newKnowledge = synthesiser.getRelationName(swap.getSecondRelation());
 
+            if (Global::config().has("pipeline-store")) {
+                out << "joinPendingStore(\"" << deltaKnowledge << "\");\n";
+                out << "joinPendingStore(\"" << newKnowledge << "\");\n";
+            }
             out << "std::swap(" << deltaKnowledge << ", " << newKnowledge << ");\n";
             PRINT_END_COMMENT(out);
         }
@@ -534,7 +1232,8 @@ void Synthesiser::emitCode(std::ostream& out, const RamStatement& stmt) {
 
         void visitDebugInfo(const RamDebugInfo& dbg, std::ostream& out) override {
             PRINT_BEGIN_COMMENT(out);
-            out << "SignalHandler::instance()->setMsg(R\"_(";
+            out << "SignalHandler::instance()->enterStatement(" << synthesiser.debugStatementId++
+                << ", R\"_(";
             out << dbg.getMessage();
             out << ")_\");\n";
 
@@ -553,7 +1252,12 @@ void Synthesiser::emitCode(std::ostream& out, const RamStatement& stmt) {
         void visitNestedOperation(const RamNestedOperation& nested, std::ostream& out) override {
             visit(nested.getOperation(), out);
             if (Global::config().has("profile") && !nested.getProfileText().empty()) {
-                out << "freqs[" << synthesiser.lookupFreqIdx(nested.getProfileText()) << "]++;\n";
+                auto idx = synthesiser.lookupFreqIdx(nested.getProfileText());
+                if (stagedFreqIdx.count(idx) != 0u) {
+                    out << "freq_local_" << idx << "++;\n";
+                } else {
+                    out << "freqs[" << idx << "].fetch_add(1, std::memory_order_relaxed);\n";
+                }
             }
         }
 
@@ -576,18 +1280,36 @@ void Synthesiser::emitCode(std::ostream& out, const RamStatement& stmt) {
 
             PRINT_BEGIN_COMMENT(out);
 
-            out << "auto part = " << relName << "->partition();\n";
-            out << "PARALLEL_START;\n";
-            out << preamble.str();
-            out << "pfor(auto it = part.begin(); it<part.end();++it){\n";
-            out << "try{\n";
-            out << "for(const auto& env0 : *it) {\n";
+            if (rel.getRepresentation() == RelationRepresentation::COLUMNAR) {
+                // iterate over row ranges of the column store; only the columns
+                // accessed by the loop body are materialized
+                out << "auto part = " << relName << "->partitionScan();\n";
+                out << "PARALLEL_START;\n";
+                out << preamble.str();
+                out << "pfor(auto it = part.begin(); it<part.end();++it){\n";
+                out << "try{\n";
+                out << "for(std::size_t row0 = it->first; row0 < it->second; ++row0) {\n";
+                out << "const auto env0 = " << relName << "->scanAt(row0);\n";
 
-            visitTupleOperation(pscan, out);
+                visitTupleOperation(pscan, out);
 
-            out << "}\n";
-            out << "} catch(std::exception &e) { SignalHandler::instance()->error(e.what());}\n";
-            out << "}\n";
+                out << "}\n";
+                out << "} catch(std::exception &e) { SignalHandler::instance()->error(e.what());}\n";
+                out << "}\n";
+            } else {
+                out << "auto part = " << relName << "->partition();\n";
+                out << "PARALLEL_START;\n";
+                out << preamble.str();
+                out << "pfor(auto it = part.begin(); it<part.end();++it){\n";
+                out << "try{\n";
+                out << "for(const auto& env0 : *it) {\n";
+
+                visitTupleOperation(pscan, out);
+
+                out << "}\n";
+                out << "} catch(std::exception &e) { SignalHandler::instance()->error(e.what());}\n";
+                out << "}\n";
+            }
 
             PRINT_END_COMMENT(out);
         }
@@ -601,12 +1323,112 @@ void Synthesiser::emitCode(std::ostream& out, const RamStatement& stmt) {
 
             assert(rel.getArity() > 0 && "AstTranslator failed/no scans for nullaries");
 
-            out << "for(const auto& env" << id << " : "
-                << "*" << relName << ") {\n";
+            if (rel.getRepresentation() == RelationRepresentation::COLUMNAR) {
+                // iterate over the column store; only the columns accessed by
+                // the loop body are materialized
+                out << "for(std::size_t row" << id << " = 0, rows" << id << " = " << relName
+                    << "->scanSize(); row" << id << " < rows" << id << "; ++row" << id << ") {\n";
+                out << "const auto env" << id << " = " << relName << "->scanAt(row" << id << ");\n";
 
-            visitTupleOperation(scan, out);
+                visitTupleOperation(scan, out);
 
-            out << "}\n";
+                out << "}\n";
+            } else if (const auto* filter = dynamic_cast<const RamFilter*>(&scan.getOperation());
+                       filter != nullptr && !Global::config().has("profile") &&
+                       isBatchableFilter(*filter)) {
+                // vectorized filter evaluation: gather batches of tuples
+                // into a buffer, evaluate the purely arithmetic conjuncts
+                // branchlessly over the whole batch, answer membership
+                // probes through the batched containsBatch interface --
+                // which overlaps the cache misses of many descents -- and
+                // run the loop body on the survivors
+                const auto conditions = toConjunctionList(&filter->getCondition());
+                std::vector<const RamCondition*> arithConds;
+                std::vector<std::pair<const RamExistenceCheck*, bool>> probeConds;
+                for (const auto& cur : conditions) {
+                    if (isVectorizableCondition(*cur)) {
+                        arithConds.push_back(cur.get());
+                        continue;
+                    }
+                    const RamCondition* inner = cur.get();
+                    bool negated = false;
+                    if (const auto* neg = dynamic_cast<const RamNegation*>(inner)) {
+                        inner = &neg->getOperand();
+                        negated = true;
+                    }
+                    probeConds.emplace_back(static_cast<const RamExistenceCheck*>(inner), negated);
+                }
+                out << "{\n";
+                out << "constexpr std::size_t BATCH" << id << " = 64;\n";
+                out << "Tuple<RamDomain," << rel.getArity() << "> buf" << id << "[BATCH" << id
+                    << "];\n";
+                out << "uint8_t keep" << id << "[BATCH" << id << "];\n";
+                out << "auto it" << id << " = " << relName << "->begin();\n";
+                out << "const auto end" << id << " = " << relName << "->end();\n";
+                out << "while(it" << id << " != end" << id << ") {\n";
+                out << "std::size_t num" << id << " = 0;\n";
+                out << "for(; num" << id << " < BATCH" << id << " && it" << id << " != end" << id
+                    << "; ++it" << id << ") {\n";
+                out << "buf" << id << "[num" << id << "++] = *it" << id << ";\n";
+                out << "}\n";
+                out << "for(std::size_t i" << id << " = 0; i" << id << " < num" << id << "; ++i" << id
+                    << ") {\n";
+                out << "const auto& env" << id << " = buf" << id << "[i" << id << "];\n";
+                out << "keep" << id << "[i" << id << "] = ";
+                if (arithConds.empty()) {
+                    out << "1";
+                }
+                for (std::size_t i = 0; i < arithConds.size(); ++i) {
+                    if (i > 0) {
+                        out << " & ";
+                    }
+                    visit(*arithConds[i], out);
+                }
+                out << ";\n";
+                out << "}\n";
+                for (std::size_t j = 0; j < probeConds.size(); ++j) {
+                    const RamExistenceCheck& probe = *probeConds[j].first;
+                    const bool negated = probeConds[j].second;
+                    const auto& probeRel = probe.getRelation();
+                    const auto probeRelName = synthesiser.getRelationName(probeRel);
+                    const auto probeArity = probeRel.getArity();
+                    out << "{\n";
+                    out << "Tuple<RamDomain," << probeArity << "> keys" << id << "_" << j << "[BATCH"
+                        << id << "];\n";
+                    out << "bool hit" << id << "_" << j << "[BATCH" << id << "];\n";
+                    out << "for(std::size_t i" << id << " = 0; i" << id << " < num" << id << "; ++i"
+                        << id << ") {\n";
+                    out << "const auto& env" << id << " = buf" << id << "[i" << id << "];\n";
+                    out << "keys" << id << "_" << j << "[i" << id << "] = Tuple<RamDomain," << probeArity
+                        << ">({{" << join(probe.getValues(), ",", rec) << "}});\n";
+                    out << "}\n";
+                    out << probeRelName << "->containsBatch(keys" << id << "_" << j << ", num" << id
+                        << ", hit" << id << "_" << j << ");\n";
+                    out << "for(std::size_t i" << id << " = 0; i" << id << " < num" << id << "; ++i"
+                        << id << ") {\n";
+                    out << "keep" << id << "[i" << id << "] &= " << (negated ? "!" : "") << "hit" << id
+                        << "_" << j << "[i" << id << "];\n";
+                    out << "}\n";
+                    out << "}\n";
+                }
+                out << "for(std::size_t i" << id << " = 0; i" << id << " < num" << id << "; ++i" << id
+                    << ") {\n";
+                out << "if(keep" << id << "[i" << id << "] == 0) continue;\n";
+                out << "const auto& env" << id << " = buf" << id << "[i" << id << "];\n";
+
+                visitNestedOperation(*filter, out);
+
+                out << "}\n";
+                out << "}\n";
+                out << "}\n";
+            } else {
+                out << "for(const auto& env" << id << " : "
+                    << "*" << relName << ") {\n";
+
+                visitTupleOperation(scan, out);
+
+                out << "}\n";
+            }
 
             PRINT_END_COMMENT(out);
         }
@@ -673,6 +1495,41 @@ void Synthesiser::emitCode(std::ostream& out, const RamStatement& stmt) {
             PRINT_END_COMMENT(out);
         }
 
+        /** @brief Emit the lower and upper bound tuples of a range-restricted index operation */
+        void genRangeBoundTuples(const RamIndexOperation& op, size_t arity, std::ostream& out) {
+            const auto rangePattern = op.getRangePattern();
+            const auto lowBound = op.getRangeLowerBound();
+            const auto highBound = op.getRangeUpperBound();
+            out << "const Tuple<RamDomain," << arity << "> low({{";
+            for (size_t i = 0; i < arity; i++) {
+                if (!isRamUndefValue(rangePattern[i])) {
+                    visit(rangePattern[i], out);
+                } else if (!isRamUndefValue(lowBound[i])) {
+                    visit(lowBound[i], out);
+                } else {
+                    out << "MIN_RAM_DOMAIN";
+                }
+                if (i + 1 < arity) {
+                    out << ",";
+                }
+            }
+            out << "}});\n";
+            out << "const Tuple<RamDomain," << arity << "> high({{";
+            for (size_t i = 0; i < arity; i++) {
+                if (!isRamUndefValue(rangePattern[i])) {
+                    visit(rangePattern[i], out);
+                } else if (!isRamUndefValue(highBound[i])) {
+                    visit(highBound[i], out);
+                } else {
+                    out << "MAX_RAM_DOMAIN";
+                }
+                if (i + 1 < arity) {
+                    out << ",";
+                }
+            }
+            out << "}});\n";
+        }
+
         void visitIndexScan(const RamIndexScan& iscan, std::ostream& out) override {
             const auto& rel = iscan.getRelation();
             auto relName = synthesiser.getRelationName(rel);
@@ -685,26 +1542,61 @@ void Synthesiser::emitCode(std::ostream& out, const RamStatement& stmt) {
 
             PRINT_BEGIN_COMMENT(out);
 
-            out << "const Tuple<RamDomain," << arity << "> key({{";
-            for (size_t i = 0; i < arity; i++) {
+            auto ctxName = "READ_OP_CONTEXT(" + synthesiser.getOpContextName(rel) + ")";
+
+            if (iscan.hasRangeBounds()) {
+                genRangeBoundTuples(iscan, arity, out);
+                out << "auto range = " << relName << "->"
+                    << "lowerUpperBound_" << keys << "(low,high," << ctxName << ");\n";
+            } else {
+                out << "const Tuple<RamDomain," << arity << "> key({{";
+                for (size_t i = 0; i < arity; i++) {
+                    if (!isRamUndefValue(rangePattern[i])) {
+                        visit(rangePattern[i], out);
+                    } else {
+                        out << "0";
+                    }
+                    if (i + 1 < arity) {
+                        out << ",";
+                    }
+                }
+                out << "}});\n";
+
+                out << "auto range = " << relName << "->"
+                    << "equalRange_" << keys << "(key," << ctxName << ");\n";
+            }
+            out << "for(const auto& env" << identifier << " : range) {\n";
+
+            visitTupleOperation(iscan, out);
+
+            out << "}\n";
+            PRINT_END_COMMENT(out);
+        }
+
+        void visitHashScan(const RamHashScan& hscan, std::ostream& out) override {
+            const auto identifier = hscan.getTupleId();
+            const auto& rangePattern = hscan.getRangePattern();
+
+            PRINT_BEGIN_COMMENT(out);
+
+            // evaluate the probe key over the bound columns
+            out << "const RamDomain key_" << identifier << "[] = {";
+            bool first = true;
+            for (size_t i = 0; i < rangePattern.size(); i++) {
                 if (!isRamUndefValue(rangePattern[i])) {
+                    if (!first) {
+                        out << ",";
+                    }
                     visit(rangePattern[i], out);
-                } else {
-                    out << "0";
-                }
-                if (i + 1 < arity) {
-                    out << ",";
+                    first = false;
                 }
             }
-            out << "}});\n";
+            out << "};\n";
 
-            auto ctxName = "READ_OP_CONTEXT(" + synthesiser.getOpContextName(rel) + ")";
-
-            out << "auto range = " << relName << "->"
-                << "equalRange_" << keys << "(key," << ctxName << ");\n";
-            out << "for(const auto& env" << identifier << " : range) {\n";
+            out << "for(const auto env" << identifier << " : hash_" << identifier << ".equalRange(key_"
+                << identifier << ")) {\n";
 
-            visitTupleOperation(iscan, out);
+            visitTupleOperation(hscan, out);
 
             out << "}\n";
             PRINT_END_COMMENT(out);
@@ -726,22 +1618,30 @@ void Synthesiser::emitCode(std::ostream& out, const RamStatement& stmt) {
 
             PRINT_BEGIN_COMMENT(out);
 
-            out << "const Tuple<RamDomain," << arity << "> key({{";
-            for (size_t i = 0; i < arity; i++) {
-                if (!isRamUndefValue(rangePattern[i])) {
-                    visit(rangePattern[i], out);
-                } else {
-                    out << "0";
-                }
-                if (i + 1 < arity) {
-                    out << ",";
+            if (piscan.hasRangeBounds()) {
+                genRangeBoundTuples(piscan, arity, out);
+                out << "auto range = " << relName
+                    << "->"
+                    // TODO (b-scholz): context may be missing here?
+                    << "lowerUpperBound_" << keys << "(low,high);\n";
+            } else {
+                out << "const Tuple<RamDomain," << arity << "> key({{";
+                for (size_t i = 0; i < arity; i++) {
+                    if (!isRamUndefValue(rangePattern[i])) {
+                        visit(rangePattern[i], out);
+                    } else {
+                        out << "0";
+                    }
+                    if (i + 1 < arity) {
+                        out << ",";
+                    }
                 }
+                out << "}});\n";
+                out << "auto range = " << relName
+                    << "->"
+                    // TODO (b-scholz): context may be missing here?
+                    << "equalRange_" << keys << "(key);\n";
             }
-            out << "}});\n";
-            out << "auto range = " << relName
-                << "->"
-                // TODO (b-scholz): context may be missing here?
-                << "equalRange_" << keys << "(key);\n";
             out << "auto part = range.partition();\n";
             out << "PARALLEL_START;\n";
             out << preamble.str();
@@ -770,23 +1670,29 @@ void Synthesiser::emitCode(std::ostream& out, const RamStatement& stmt) {
             // check list of keys
             assert(arity > 0 && "AstTranslator failed");
 
-            out << "const Tuple<RamDomain," << arity << "> key({{";
-            for (size_t i = 0; i < arity; i++) {
-                if (!isRamUndefValue(rangePattern[i])) {
-                    visit(rangePattern[i], out);
-                } else {
-                    out << "0";
-                }
-                if (i + 1 < arity) {
-                    out << ",";
-                }
-            }
-            out << "}});\n";
-
             auto ctxName = "READ_OP_CONTEXT(" + synthesiser.getOpContextName(rel) + ")";
 
-            out << "auto range = " << relName << "->"
-                << "equalRange_" << keys << "(key," << ctxName << ");\n";
+            if (ichoice.hasRangeBounds()) {
+                genRangeBoundTuples(ichoice, arity, out);
+                out << "auto range = " << relName << "->"
+                    << "lowerUpperBound_" << keys << "(low,high," << ctxName << ");\n";
+            } else {
+                out << "const Tuple<RamDomain," << arity << "> key({{";
+                for (size_t i = 0; i < arity; i++) {
+                    if (!isRamUndefValue(rangePattern[i])) {
+                        visit(rangePattern[i], out);
+                    } else {
+                        out << "0";
+                    }
+                    if (i + 1 < arity) {
+                        out << ",";
+                    }
+                }
+                out << "}});\n";
+
+                out << "auto range = " << relName << "->"
+                    << "equalRange_" << keys << "(key," << ctxName << ");\n";
+            }
             out << "for(const auto& env" << identifier << " : range) {\n";
             out << "if( ";
 
@@ -820,22 +1726,30 @@ void Synthesiser::emitCode(std::ostream& out, const RamStatement& stmt) {
 
             PRINT_BEGIN_COMMENT(out);
 
-            out << "const Tuple<RamDomain," << arity << "> key({{";
-            for (size_t i = 0; i < arity; i++) {
-                if (!isRamUndefValue(rangePattern[i])) {
-                    visit(rangePattern[i], out);
-                } else {
-                    out << "0";
-                }
-                if (i + 1 < arity) {
-                    out << ",";
+            if (pichoice.hasRangeBounds()) {
+                genRangeBoundTuples(pichoice, arity, out);
+                out << "auto range = " << relName
+                    << "->"
+                    // TODO (b-scholz): context may be missing here?
+                    << "lowerUpperBound_" << keys << "(low,high);\n";
+            } else {
+                out << "const Tuple<RamDomain," << arity << "> key({{";
+                for (size_t i = 0; i < arity; i++) {
+                    if (!isRamUndefValue(rangePattern[i])) {
+                        visit(rangePattern[i], out);
+                    } else {
+                        out << "0";
+                    }
+                    if (i + 1 < arity) {
+                        out << ",";
+                    }
                 }
+                out << "}});\n";
+                out << "auto range = " << relName
+                    << "->"
+                    // TODO (b-scholz): context may be missing here?
+                    << "equalRange_" << keys << "(key);\n";
             }
-            out << "}});\n";
-            out << "auto range = " << relName
-                << "->"
-                // TODO (b-scholz): context may be missing here?
-                << "equalRange_" << keys << "(key);\n";
             out << "auto part = range.partition();\n";
             out << "PARALLEL_START;\n";
             out << preamble.str();
@@ -876,41 +1790,165 @@ void Synthesiser::emitCode(std::ostream& out, const RamStatement& stmt) {
 
             out << "{\n";
 
-            // continue with condition checks and nested body
-            visitTupleOperation(lookup, out);
+            // continue with condition checks and nested body
+            visitTupleOperation(lookup, out);
+
+            out << "}\n";
+            PRINT_END_COMMENT(out);
+        }
+
+        void visitIndexAggregate(const RamIndexAggregate& aggregate, std::ostream& out) override {
+            PRINT_BEGIN_COMMENT(out);
+            // get some properties
+            const auto& rel = aggregate.getRelation();
+            auto arity = rel.getArity();
+            auto relName = synthesiser.getRelationName(rel);
+            auto ctxName = "READ_OP_CONTEXT(" + synthesiser.getOpContextName(rel) + ")";
+            auto identifier = aggregate.getTupleId();
+
+            // aggregate tuple storing the result of aggregate
+            std::string tuple_type = "ram::Tuple<RamDomain," + toString(arity) + ">";
+
+            // declare environment variable
+            out << "ram::Tuple<RamDomain,1> env" << identifier << ";\n";
+
+            // get range to aggregate
+            auto keys = isa->getSearchSignature(&aggregate);
+
+            // special case: counting number elements over an unrestricted predicate
+            if (aggregate.getFunction() == souffle::COUNT && keys == 0 &&
+                    isRamTrue(&aggregate.getCondition())) {
+                // shortcut: use relation size
+                out << "env" << identifier << "[0] = " << relName << "->"
+                    << "size();\n";
+                visitTupleOperation(aggregate, out);
+                PRINT_END_COMMENT(out);
+                return;
+            }
+
+            // init result
+            std::string init;
+            switch (aggregate.getFunction()) {
+                case souffle::MIN:
+                    init = "MAX_RAM_DOMAIN";
+                    break;
+                case souffle::MAX:
+                    init = "MIN_RAM_DOMAIN";
+                    break;
+                case souffle::COUNT:
+                    init = "0";
+                    break;
+                case souffle::SUM:
+                    init = "0";
+                    break;
+                default:
+                    abort();
+            }
+            out << "RamDomain res" << identifier << " = " << init << ";\n";
+
+            // check whether there is an index to use
+            if (keys == 0) {
+                out << "for(const auto& env" << identifier << " : "
+                    << "*" << relName << ") {\n";
+            } else if (aggregate.hasRangeBounds()) {
+                genRangeBoundTuples(aggregate, arity, out);
+                out << "auto range = " << relName << "->"
+                    << "lowerUpperBound_" << keys << "(low,high," << ctxName << ");\n";
+
+                // aggregate result
+                out << "for(const auto& env" << identifier << " : range) {\n";
+            } else {
+                // a lambda for printing boundary key values
+                auto printKeyTuple = [&]() {
+                    for (size_t i = 0; i < arity; i++) {
+                        if (!isRamUndefValue(aggregate.getRangePattern()[i])) {
+                            visit(aggregate.getRangePattern()[i], out);
+                        } else {
+                            out << "0";
+                        }
+                        if (i + 1 < arity) {
+                            out << ",";
+                        }
+                    }
+                };
+
+                // get index
+                auto index = synthesiser.toIndex(keys);
+                out << "const " << tuple_type << " key({{";
+                printKeyTuple();
+                out << "}});\n";
+                out << "auto range = " << relName << "->"
+                    << "equalRange_" << keys << "(key," << ctxName << ");\n";
+
+                // aggregate result
+                out << "for(const auto& env" << identifier << " : range) {\n";
+            }
+
+            // produce condition inside the loop
+            out << "if( ";
+            visit(aggregate.getCondition(), out);
+            out << ") {\n";
+
+            switch (aggregate.getFunction()) {
+                case souffle::MIN:
+                    out << "res" << identifier << " = std::min (res" << identifier << ",";
+                    visit(aggregate.getExpression(), out);
+                    out << ");\n";
+                    break;
+                case souffle::MAX:
+                    out << "res" << identifier << " = std::max (res" << identifier << ",";
+                    visit(aggregate.getExpression(), out);
+                    out << ");\n";
+                    break;
+                case souffle::COUNT:
+                    // count is easy
+                    out << "++res" << identifier << "\n;";
+                    break;
+                case souffle::SUM:
+                    out << "res" << identifier << " += ";
+                    visit(aggregate.getExpression(), out);
+                    out << ";\n";
+                    break;
+                default:
+                    abort();
+            }
+
+            out << "}\n";
+
+            // end aggregator loop
+            out << "}\n";
+
+            // write result into environment tuple
+            out << "env" << identifier << "[0] = res" << identifier << ";\n";
+
+            if (aggregate.getFunction() == souffle::MIN || aggregate.getFunction() == souffle::MAX) {
+                // check whether there exists a min/max first before next loop
+                out << "if(res" << identifier << " != " << init << "){\n";
+                visitTupleOperation(aggregate, out);
+                out << "}\n";
+            } else {
+                visitTupleOperation(aggregate, out);
+            }
 
-            out << "}\n";
             PRINT_END_COMMENT(out);
         }
 
-        void visitIndexAggregate(const RamIndexAggregate& aggregate, std::ostream& out) override {
+        void visitParallelAggregate(const RamParallelAggregate& aggregate, std::ostream& out) override {
             PRINT_BEGIN_COMMENT(out);
             // get some properties
             const auto& rel = aggregate.getRelation();
-            auto arity = rel.getArity();
             auto relName = synthesiser.getRelationName(rel);
-            auto ctxName = "READ_OP_CONTEXT(" + synthesiser.getOpContextName(rel) + ")";
             auto identifier = aggregate.getTupleId();
 
-            // aggregate tuple storing the result of aggregate
-            std::string tuple_type = "ram::Tuple<RamDomain," + toString(arity) + ">";
-
-            // declare environment variable
-            out << "ram::Tuple<RamDomain,1> env" << identifier << ";\n";
-
-            // get range to aggregate
-            auto keys = isa->getSearchSignature(&aggregate);
+            assert(identifier == 0 && "not outer-most loop");
+            assert(!preambleIssued && "only first loop can be made parallel");
+            preambleIssued = true;
 
-            // special case: counting number elements over an unrestricted predicate
-            if (aggregate.getFunction() == souffle::COUNT && keys == 0 &&
-                    isRamTrue(&aggregate.getCondition())) {
-                // shortcut: use relation size
-                out << "env" << identifier << "[0] = " << relName << "->"
-                    << "size();\n";
-                visitTupleOperation(aggregate, out);
-                PRINT_END_COMMENT(out);
-                return;
-            }
+            // counting an unrestricted predicate is answered by the relation
+            // size; the transformer keeps that case sequential
+            assert(!(aggregate.getFunction() == souffle::COUNT &&
+                           isRamTrue(&aggregate.getCondition())) &&
+                    "unrestricted count is not parallelized");
 
             // init result
             std::string init;
@@ -930,61 +1968,39 @@ void Synthesiser::emitCode(std::ostream& out, const RamStatement& stmt) {
                 default:
                     abort();
             }
-            out << "RamDomain res" << identifier << " = " << init << ";\n";
-
-            // check whether there is an index to use
-            if (keys == 0) {
-                out << "for(const auto& env" << identifier << " : "
-                    << "*" << relName << ") {\n";
-            } else {
-                // a lambda for printing boundary key values
-                auto printKeyTuple = [&]() {
-                    for (size_t i = 0; i < arity; i++) {
-                        if (!isRamUndefValue(aggregate.getRangePattern()[i])) {
-                            visit(aggregate.getRangePattern()[i], out);
-                        } else {
-                            out << "0";
-                        }
-                        if (i + 1 < arity) {
-                            out << ",";
-                        }
-                    }
-                };
 
-                // get index
-                auto index = synthesiser.toIndex(keys);
-                out << "const " << tuple_type << " key({{";
-                printKeyTuple();
-                out << "}});\n";
-                out << "auto range = " << relName << "->"
-                    << "equalRange_" << keys << "(key," << ctxName << ");\n";
+            // shared result of the reduction
+            out << "RamDomain res" << identifier << " = " << init << ";\n";
 
-                // aggregate result
-                out << "for(const auto& env" << identifier << " : range) {\n";
-            }
+            // aggregate the partitions into per-thread partial results
+            out << "auto part = " << relName << "->partition();\n";
+            out << "PARALLEL_START;\n";
+            out << preamble.str();
+            out << "RamDomain part_res" << identifier << " = " << init << ";\n";
+            out << "pfor(auto it = part.begin(); it<part.end();++it){\n";
+            out << "try{\n";
+            out << "for(const auto& env" << identifier << " : *it) {\n";
 
-            // produce condition inside the loop
             out << "if( ";
             visit(aggregate.getCondition(), out);
             out << ") {\n";
 
             switch (aggregate.getFunction()) {
                 case souffle::MIN:
-                    out << "res" << identifier << " = std::min (res" << identifier << ",";
+                    out << "part_res" << identifier << " = std::min(part_res" << identifier << ",";
                     visit(aggregate.getExpression(), out);
                     out << ");\n";
                     break;
                 case souffle::MAX:
-                    out << "res" << identifier << " = std::max (res" << identifier << ",";
+                    out << "part_res" << identifier << " = std::max(part_res" << identifier << ",";
                     visit(aggregate.getExpression(), out);
                     out << ");\n";
                     break;
                 case souffle::COUNT:
-                    // count is easy
-                    out << "++res" << identifier << "\n;";
+                    out << "++part_res" << identifier << "\n;";
                     break;
                 case souffle::SUM:
-                    out << "res" << identifier << " += ";
+                    out << "part_res" << identifier << " += ";
                     visit(aggregate.getExpression(), out);
                     out << ";\n";
                     break;
@@ -992,12 +2008,39 @@ void Synthesiser::emitCode(std::ostream& out, const RamStatement& stmt) {
                     abort();
             }
 
+            out << "}\n";
+            out << "}\n";
+            out << "} catch(std::exception &e) { SignalHandler::instance()->error(e.what());}\n";
             out << "}\n";
 
-            // end aggregator loop
+            // combine the per-thread partials with the aggregate's monoid
+            out << "AGGREGATE_COMBINE\n";
+            out << "{\n";
+            switch (aggregate.getFunction()) {
+                case souffle::MIN:
+                    out << "res" << identifier << " = std::min(res" << identifier << ", part_res"
+                        << identifier << ");\n";
+                    break;
+                case souffle::MAX:
+                    out << "res" << identifier << " = std::max(res" << identifier << ", part_res"
+                        << identifier << ");\n";
+                    break;
+                case souffle::COUNT:
+                case souffle::SUM:
+                    out << "res" << identifier << " += part_res" << identifier << ";\n";
+                    break;
+                default:
+                    abort();
+            }
             out << "}\n";
 
+            // all partials must be in before one thread resumes the loop nest
+            out << "AGGREGATE_BARRIER\n";
+            out << "AGGREGATE_SINGLE\n";
+            out << "{\n";
+
             // write result into environment tuple
+            out << "ram::Tuple<RamDomain,1> env" << identifier << ";\n";
             out << "env" << identifier << "[0] = res" << identifier << ";\n";
 
             if (aggregate.getFunction() == souffle::MIN || aggregate.getFunction() == souffle::MAX) {
@@ -1009,6 +2052,7 @@ void Synthesiser::emitCode(std::ostream& out, const RamStatement& stmt) {
                 visitTupleOperation(aggregate, out);
             }
 
+            out << "}\n";
             PRINT_END_COMMENT(out);
         }
 
@@ -1125,6 +2169,17 @@ void Synthesiser::emitCode(std::ostream& out, const RamStatement& stmt) {
             PRINT_END_COMMENT(out);
         }
 
+        void visitSplit(const RamSplit& split, std::ostream& out) override {
+            PRINT_BEGIN_COMMENT(out);
+            // evaluate each fused rule body on the current tuple
+            for (const RamOperation* body : split.getBodies()) {
+                out << "{\n";
+                visit(*body, out);
+                out << "}\n";
+            }
+            PRINT_END_COMMENT(out);
+        }
+
         void visitProject(const RamProject& project, std::ostream& out) override {
             PRINT_BEGIN_COMMENT(out);
             const auto& rel = project.getRelation();
@@ -1140,9 +2195,13 @@ void Synthesiser::emitCode(std::ostream& out, const RamStatement& stmt) {
                     << join(project.getValues(), "),static_cast<RamDomain>(", rec) << ")}});\n";
             }
 
-            // insert tuple
-            out << relName << "->"
-                << "insert(tuple," << ctxName << ");\n";
+            // stage or insert tuple
+            if (stagedRelations.find(relName) != stagedRelations.end()) {
+                out << "stage_" << relName << ".push_back(tuple);\n";
+            } else {
+                out << relName << "->"
+                    << "insert(tuple," << ctxName << ");\n";
+            }
 
             PRINT_END_COMMENT(out);
         }
@@ -1171,9 +2230,15 @@ void Synthesiser::emitCode(std::ostream& out, const RamStatement& stmt) {
 
         void visitNegation(const RamNegation& neg, std::ostream& out) override {
             PRINT_BEGIN_COMMENT(out);
+            // existence checks under a negation usually miss; flag the
+            // operand so it may consult the relation's Bloom filter before
+            // descending into the b-tree
+            bool saved = insideNegation;
+            insideNegation = dynamic_cast<const RamExistenceCheck*>(&neg.getOperand()) != nullptr;
             out << "!(";
             visit(neg.getOperand(), out);
             out << ")";
+            insideNegation = saved;
             PRINT_END_COMMENT(out);
         }
 
@@ -1281,12 +2346,74 @@ void Synthesiser::emitCode(std::ostream& out, const RamStatement& stmt) {
             assert(arity > 0 && "AstTranslator failed");
             std::string before, after;
             if (Global::config().has("profile") && !exists.getRelation().isTemp()) {
-                out << R"_((reads[)_" << synthesiser.lookupReadIdx(rel.getName()) << R"_(]++,)_";
+                auto idx = synthesiser.lookupReadIdx(rel.getName());
+                if (stagedReadIdx.count(idx) != 0u) {
+                    out << "(read_local_" << idx << "++,";
+                } else {
+                    out << "(reads[" << idx << "].fetch_add(1, std::memory_order_relaxed),";
+                }
                 after = ")";
             }
 
             // if it is total we use the contains function
             if (isa->isTotalSignature(&exists)) {
+                // existence checks on compile-time constant relations bypass
+                // the index machinery: tiny relations become a chain of
+                // direct comparisons, small ones a branchless binary search
+                // over a sorted inline array
+                const size_t directComparisonMax = 4;
+                const size_t inlineArrayMax = 64;
+                const auto* facts = synthesiser.getConstantFacts(rel.getName());
+                if (facts != nullptr && facts->size() <= directComparisonMax) {
+                    out << "([&]() -> bool { const Tuple<RamDomain," << arity << "> key{{"
+                        << join(exists.getValues(), ",", rec) << "}}; return ";
+                    if (facts->empty()) {
+                        out << "false";
+                    }
+                    out << join(*facts, " || ", [&](std::ostream& out, const std::vector<RamDomain>& tuple) {
+                        out << "(";
+                        for (size_t i = 0; i < tuple.size(); i++) {
+                            out << (i == 0 ? "" : " && ") << "key[" << i << "] == RamDomain(" << tuple[i]
+                                << ")";
+                        }
+                        out << ")";
+                    });
+                    out << "; }())" << after;
+                    PRINT_END_COMMENT(out);
+                    return;
+                }
+                if (facts != nullptr && facts->size() <= inlineArrayMax) {
+                    out << "([&]() -> bool {\n";
+                    out << "static const Tuple<RamDomain," << arity << "> table[" << facts->size()
+                        << "] = {";
+                    out << join(*facts, ",", [&](std::ostream& out, const std::vector<RamDomain>& tuple) {
+                        out << "{{" << join(tuple, ",") << "}}";
+                    });
+                    out << "};\n";
+                    out << "const Tuple<RamDomain," << arity << "> key{{"
+                        << join(exists.getValues(), ",", rec) << "}};\n";
+                    out << "size_t base = 0;\n";
+                    out << "for (size_t n = " << facts->size() << "; n > 1;) {\n";
+                    out << "const size_t half = n >> 1;\n";
+                    out << "base = (table[base + half - 1] < key) ? base + half : base;\n";
+                    out << "n -= half;\n";
+                    out << "}\n";
+                    out << "return table[base] == key;\n";
+                    out << "}())" << after;
+                    PRINT_END_COMMENT(out);
+                    return;
+                }
+                // a negated check over a relation completed in an earlier
+                // stratum consults its Bloom filter first, turning most
+                // misses into two cache-resident bit probes
+                if (insideNegation && synthesiser.bloomFilterApplies(rel.getName())) {
+                    out << "([&]() -> bool { const Tuple<RamDomain," << arity << "> key{{"
+                        << join(exists.getValues(), ",", rec) << "}}; return (!useBloomFilters || bloom_"
+                        << relName << ".mayContain(BloomFilter::hash(key))) && " << relName
+                        << "->contains(key," << ctxName << "); }())" << after;
+                    PRINT_END_COMMENT(out);
+                    return;
+                }
                 out << relName << "->"
                     << "contains(Tuple<RamDomain," << arity << ">({{" << join(exists.getValues(), ",", rec)
                     << "}})," << ctxName << ")" << after;
@@ -1335,13 +2462,51 @@ void Synthesiser::emitCode(std::ostream& out, const RamStatement& stmt) {
                 }
                 out << ",";
             }
-            // extra 0 for provenance height annotation
+            // extra 0 for the packed provenance annotation
+            out << "0";
+
+            out << "}})," << ctxName << ");\n";
+            // the annotation orders tuples by height first, so the first tuple
+            // of the range carries the minimal height
+            out << "if (existenceCheck.empty()) return false; else return "
+                   "provenanceLevelNumber((*existenceCheck.begin())["
+                << arity - 1 << "]) <= provenanceLevelNumber(";
+            visit(*(provExists.getValues()[arity - 1]), out);
+            out << ");}()\n";
+            PRINT_END_COMMENT(out);
+        }
+
+        void visitSubsumptionCheck(const RamSubsumptionCheck& subsumes, std::ostream& out) override {
+            PRINT_BEGIN_COMMENT(out);
+            // get some details
+            const auto& rel = subsumes.getRelation();
+            auto relName = synthesiser.getRelationName(rel);
+            auto ctxName = "READ_OP_CONTEXT(" + synthesiser.getOpContextName(rel) + ")";
+            auto arity = rel.getArity();
+
+            // scan the tuples agreeing on the key attributes; the index
+            // orders them by the measure, hence the first one is minimal
+            out << "[&]() -> bool {\n";
+            out << "auto existenceCheck = " << relName << "->"
+                << "equalRange";
+            out << "_" << isa->getSearchSignature(&subsumes);
+            out << "(Tuple<RamDomain," << arity << ">({{";
+            for (size_t i = 0; i < subsumes.getValues().size() - 1; i++) {
+                RamExpression* val = subsumes.getValues()[i];
+                if (!isRamUndefValue(val)) {
+                    visit(*val, out);
+                } else {
+                    out << "0";
+                }
+                out << ",";
+            }
+            // extra 0 for the measure attribute
             out << "0";
 
             out << "}})," << ctxName << ");\n";
             out << "if (existenceCheck.empty()) return false; else return (*existenceCheck.begin())["
                 << arity - 1 << "] <= ";
-            visit(*(provExists.getValues()[arity - 1]), out);
+            visit(*(subsumes.getValues()[arity - 1]), out);
             out << ";}()\n";
             PRINT_END_COMMENT(out);
         }
@@ -1399,9 +2564,12 @@ void Synthesiser::emitCode(std::ostream& out, const RamStatement& stmt) {
                     break;
                 }
                 case FunctorOp::TOSTRING: {
-                    out << "symTable.lookup(std::to_string(";
+                    // memoize recurring conversions in the per-thread cache
+                    out << "[&](RamDomain a0){return StringFunctorMemo::instance().getOrCompute("
+                           "StringFunctorMemo::TOSTRING,1,a0,0,0,"
+                           "[&]{return symTable.lookup(std::to_string(a0));});}(";
                     visit(op.getArgument(0), out);
-                    out << "))";
+                    out << ")";
                     break;
                 }
                 case FunctorOp::TONUMBER: {
@@ -1524,28 +2692,60 @@ void Synthesiser::emitCode(std::ostream& out, const RamStatement& stmt) {
 
                 // strings
                 case FunctorOp::CAT: {
-                    out << "symTable.lookup(";
-                    for (size_t i = 0; i < op.getArgCount() - 1; i++) {
-                        out << "symTable.resolve(";
-                        visit(op.getArgument(i), out);
-                        out << ") + ";
+                    const size_t nargs = op.getArgCount();
+                    // small concatenations over recurring arguments are
+                    // served from the per-thread memo
+                    if (nargs <= 3) {
+                        out << "[&](";
+                        for (size_t i = 0; i < nargs; i++) {
+                            out << (i > 0 ? "," : "") << "RamDomain a" << i;
+                        }
+                        out << "){return StringFunctorMemo::instance().getOrCompute("
+                               "StringFunctorMemo::CAT,"
+                            << nargs;
+                        for (size_t i = 0; i < 3; i++) {
+                            out << (i < nargs ? ",a" + std::to_string(i) : ",0");
+                        }
+                        out << ",[&]{return symTable.lookup(";
+                        // resolve returns views; concatenate through one string
+                        out << "std::string(symTable.resolve(a0))";
+                        for (size_t i = 1; i < nargs; i++) {
+                            out << ".append(symTable.resolve(a" << i << "))";
+                        }
+                        out << ");});}(";
+                        for (size_t i = 0; i < nargs; i++) {
+                            if (i > 0) {
+                                out << ",";
+                            }
+                            visit(op.getArgument(i), out);
+                        }
+                        out << ")";
+                        break;
                     }
-                    out << "symTable.resolve(";
-                    visit(op.getArgument(op.getArgCount() - 1), out);
+                    out << "symTable.lookup(std::string(symTable.resolve(";
+                    visit(op.getArgument(0), out);
                     out << "))";
+                    for (size_t i = 1; i < nargs; i++) {
+                        out << ".append(symTable.resolve(";
+                        visit(op.getArgument(i), out);
+                        out << "))";
+                    }
+                    out << ")";
                     break;
                 }
 
                 /** Ternary Functor Operators */
                 case FunctorOp::SUBSTR: {
-                    out << "symTable.lookup(";
-                    out << "substr_wrapper(symTable.resolve(";
+                    out << "[&](RamDomain a0,RamDomain a1,RamDomain a2){"
+                           "return StringFunctorMemo::instance().getOrCompute("
+                           "StringFunctorMemo::SUBSTR,3,a0,a1,a2,"
+                           "[&]{return symTable.lookup(substr_wrapper(symTable.resolve(a0),(a1),(a2)));});}(";
                     visit(op.getArgument(0), out);
-                    out << "),(";
+                    out << ",";
                     visit(op.getArgument(1), out);
-                    out << "),(";
+                    out << ",";
                     visit(op.getArgument(2), out);
-                    out << ")))";
+                    out << ")";
                     break;
                 }
 
@@ -1579,7 +2779,7 @@ void Synthesiser::emitCode(std::ostream& out, const RamStatement& stmt) {
                 } else {
                     out << "symTable.resolve((RamDomain)";
                     visit(op.getArgument(i), out);
-                    out << ").c_str()";
+                    out << ").data()";
                 }
             }
             out << ")";
@@ -1708,7 +2908,8 @@ void Synthesiser::emitCode(std::ostream& out, const RamStatement& stmt) {
     CodeEmitter(*this).visit(stmt, out);
 }
 
-void Synthesiser::generateCode(std::ostream& os, const std::string& id, bool& withSharedLibrary) {
+void Synthesiser::generateCode(std::ostream& os, std::ostream& epilogue,
+        std::vector<std::string>& stratumDefinitions, const std::string& id, bool& withSharedLibrary) {
     // ---------------------------------------------------------------
     //                      Auto-Index Generation
     // ---------------------------------------------------------------
@@ -1716,6 +2917,60 @@ void Synthesiser::generateCode(std::ostream& os, const std::string& id, bool& wi
     const RamProgram& prog = *translationUnit.getProgram();
     auto* idxAnalysis = translationUnit.getAnalysis<RamIndexAnalysis>();
 
+    // determine which relations hold compile-time constant facts, so
+    // existence checks on them can be specialized
+    computeConstantFacts();
+
+    // under provenance, relations never written by a rule carry constant
+    // annotation columns and keep the cheaper plain b-tree layout
+    computeRuleWrittenRelations();
+
+    // determine the relations worth a Bloom filter pre-check: relations
+    // probed by a negated, fully bound existence check from a stratum
+    // after their last write; the filter is built when the writing
+    // stratum completes and consulted before the b-tree descent
+    bloomFilteredRelations.clear();
+    bloomBuildStratum.clear();
+    visitDepthFirst(*(prog.getMain()), [&](const RamStratum& stratum) {
+        auto index = (size_t)stratum.getIndex();
+        auto noteWrite = [&](const RamRelation& rel) {
+            auto pos = bloomBuildStratum.find(rel.getName());
+            if (pos == bloomBuildStratum.end() || pos->second < index) {
+                bloomBuildStratum[rel.getName()] = index;
+            }
+        };
+        visitDepthFirst(stratum, [&](const RamProject& project) { noteWrite(project.getRelation()); });
+        visitDepthFirst(stratum, [&](const RamMerge& merge) { noteWrite(merge.getTargetRelation()); });
+        visitDepthFirst(stratum, [&](const RamSwap& swap) {
+            noteWrite(swap.getFirstRelation());
+            noteWrite(swap.getSecondRelation());
+        });
+        visitDepthFirst(stratum, [&](const RamClear& clear) { noteWrite(clear.getRelation()); });
+        visitDepthFirst(stratum, [&](const RamLoad& load) { noteWrite(load.getRelation()); });
+        visitDepthFirst(stratum, [&](const RamFact& fact) { noteWrite(fact.getRelation()); });
+        visitDepthFirst(stratum, [&](const RamFactTable& facts) { noteWrite(facts.getRelation()); });
+    });
+    visitDepthFirst(*(prog.getMain()), [&](const RamStratum& stratum) {
+        visitDepthFirst(stratum, [&](const RamNegation& neg) {
+            const auto* exists = dynamic_cast<const RamExistenceCheck*>(&neg.getOperand());
+            if (exists == nullptr) {
+                return;
+            }
+            const RamRelation& rel = exists->getRelation();
+            if (rel.getName()[0] == '@' || rel.getArity() == 0) {
+                return;
+            }
+            if (!idxAnalysis->isTotalSignature(exists)) {
+                return;
+            }
+            auto write = bloomBuildStratum.find(rel.getName());
+            if (write == bloomBuildStratum.end() || write->second >= (size_t)stratum.getIndex()) {
+                return;
+            }
+            bloomFilteredRelations.insert(rel.getName());
+        });
+    });
+
     // ---------------------------------------------------------------
     //                      Code Generation
     // ---------------------------------------------------------------
@@ -1742,6 +2997,19 @@ void Synthesiser::generateCode(std::ostream& os, const std::string& id, bool& wi
         os << "#include <thread>\n";
         os << "#include \"souffle/profile/Tui.h\"\n";
     }
+    if (Global::config().has("pipeline-store")) {
+        os << "#include <future>\n";
+    }
+    // grouped relations hash their key column
+    bool hasGroupedRelation = false;
+    visitDepthFirst(prog, [&](const RamRelationReference& ref) {
+        if (ref.get()->getRepresentation() == RelationRepresentation::GROUPED) {
+            hasGroupedRelation = true;
+        }
+    });
+    if (hasGroupedRelation) {
+        os << "#include <unordered_map>\n";
+    }
     os << "\n";
     // produce external definitions for user-defined functors
     std::map<std::string, std::string> functors;
@@ -1783,8 +3051,8 @@ void Synthesiser::generateCode(std::ostream& os, const std::string& id, bool& wi
         const std::string& raw_name = rel.getName();
 
         bool isProvInfo = raw_name.find("@info") != std::string::npos;
-        auto relationType = SynthesiserRelation::getSynthesiserRelation(
-                rel, idxAnalysis->getIndexes(rel), Global::config().has("provenance") && !isProvInfo);
+        auto relationType = SynthesiserRelation::getSynthesiserRelation(rel, idxAnalysis->getIndexes(rel),
+                Global::config().has("provenance") && !isProvInfo && isRuleWritten(raw_name));
 
         generateRelationTypeStruct(os, std::move(relationType));
     });
@@ -1794,9 +3062,9 @@ void Synthesiser::generateCode(std::ostream& os, const std::string& id, bool& wi
 
     // regex wrapper
     os << "private:\n";
-    os << "static inline bool regex_wrapper(const std::string& pattern, const std::string& text) {\n";
+    os << "static inline bool regex_wrapper(std::string_view pattern, std::string_view text) {\n";
     os << "   bool result = false; \n";
-    os << "   try { result = std::regex_match(text, std::regex(pattern)); } catch(...) { \n";
+    os << "   try { result = std::regex_match(text.begin(), text.end(), std::regex(pattern.begin(), pattern.end())); } catch(...) { \n";
     os << "     std::cerr << \"warning: wrong pattern provided for match(\\\"\" << pattern << \"\\\",\\\"\" "
           "<< text << \"\\\").\\n\";\n}\n";
     os << "   return result;\n";
@@ -1804,7 +3072,7 @@ void Synthesiser::generateCode(std::ostream& os, const std::string& id, bool& wi
 
     // substring wrapper
     os << "private:\n";
-    os << "static inline std::string substr_wrapper(const std::string& str, size_t idx, size_t len) {\n";
+    os << "static inline std::string substr_wrapper(std::string_view str, size_t idx, size_t len) {\n";
     os << "   std::string result; \n";
     os << "   try { result = str.substr(idx,len); } catch(...) { \n";
     os << "     std::cerr << \"warning: wrong index position provided by substr(\\\"\";\n";
@@ -1815,9 +3083,9 @@ void Synthesiser::generateCode(std::ostream& os, const std::string& id, bool& wi
 
     // to number wrapper
     os << "private:\n";
-    os << "static inline RamDomain wrapper_tonumber(const std::string& str) {\n";
+    os << "static inline RamDomain wrapper_tonumber(std::string_view str) {\n";
     os << "   RamDomain result=0; \n";
-    os << "   try { result = stord(str); } catch(...) { \n";
+    os << "   try { result = stord(std::string(str)); } catch(...) { \n";
     os << "     std::cerr << \"error: wrong string provided by to_number(\\\"\";\n";
     os << R"(     std::cerr << str << "\") )";
     os << "functor.\\n\";\n";
@@ -1854,6 +3122,20 @@ void Synthesiser::generateCode(std::ostream& os, const std::string& id, bool& wi
         os << "std::string profiling_fname;\n";
     }
 
+    if (Global::config().has("pipeline-store")) {
+        // output writes running on background I/O threads, joined before
+        // the stored relation can change again
+        os << "std::map<std::string, std::future<void>> pendingStores;\n";
+        os << "void joinPendingStore(const std::string& name) {\n";
+        os << "auto pos = pendingStores.find(name);\n";
+        os << "if (pos != pendingStores.end()) { pos->second.wait(); pendingStores.erase(pos); }\n";
+        os << "}\n";
+        os << "void joinPendingStores() {\n";
+        os << "for (auto& cur : pendingStores) { cur.second.wait(); }\n";
+        os << "pendingStores.clear();\n";
+        os << "}\n";
+    }
+
     os << "public:\n";
 
     // declare symbol table
@@ -1873,12 +3155,18 @@ void Synthesiser::generateCode(std::ostream& os, const std::string& id, bool& wi
         os << "private:\n";
         size_t numFreq = 0;
         visitDepthFirst(*(prog.getMain()), [&](const RamStatement& node) { numFreq++; });
-        os << "  size_t freqs[" << numFreq << "]{};\n";
+        os << "  std::atomic<size_t> freqs[" << numFreq << "]{};\n";
         size_t numRead = 0;
         visitDepthFirst(*(prog.getMain()), [&](const RamCreate& node) {
             if (!node.getRelation().isTemp()) numRead++;
         });
-        os << "  size_t reads[" << numRead << "]{};\n";
+        os << "  std::atomic<size_t> reads[" << numRead << "]{};\n";
+    }
+    if (!bloomFilteredRelations.empty()) {
+        // runtime switch for the Bloom filters guarding negated probes;
+        // the options file can disable them without recompiling
+        os << "private:\n";
+        os << "bool useBloomFilters = !Global::config().has(\"no-bloom-filters\");\n";
     }
 
     // print relation definitions
@@ -1903,8 +3191,8 @@ void Synthesiser::generateCode(std::ostream& os, const std::string& id, bool& wi
         // ensure that the type of the new knowledge is the same as that of the delta knowledge
         bool isDelta = rel.isTemp() && raw_name.find("@delta") != std::string::npos;
         bool isProvInfo = raw_name.find("@info") != std::string::npos;
-        auto relationType = SynthesiserRelation::getSynthesiserRelation(
-                rel, idxAnalysis->getIndexes(rel), Global::config().has("provenance") && !isProvInfo);
+        auto relationType = SynthesiserRelation::getSynthesiserRelation(rel, idxAnalysis->getIndexes(rel),
+                Global::config().has("provenance") && !isProvInfo && isRuleWritten(raw_name));
         tempType = isDelta ? relationType->getTypeName() : tempType;
         const std::string& type = (rel.isTemp()) ? tempType : relationType->getTypeName();
 
@@ -1912,6 +3200,9 @@ void Synthesiser::generateCode(std::ostream& os, const std::string& id, bool& wi
         os << "// -- Table: " << raw_name << "\n";
 
         os << "std::unique_ptr<" << type << "> " << name << " = std::make_unique<" << type << ">();\n";
+        if (bloomFilteredRelations.find(raw_name) != bloomFilteredRelations.end()) {
+            os << "BloomFilter bloom_" << name << ";\n";
+        }
         if (!rel.isTemp()) {
             os << "souffle::RelationWrapper<";
             os << relCtr++ << ",";
@@ -1970,7 +3261,17 @@ void Synthesiser::generateCode(std::ostream& os, const std::string& id, bool& wi
     os << "{\n";
     if (Global::config().has("profile")) {
         os << "ProfileEventSingleton::instance().setOutputFile(profiling_fname);\n";
+        if (Global::config().has("profile-binary") && !Global::config().has("live-profile")) {
+            os << "ProfileEventSingleton::instance().enableStreaming();\n";
+        }
     }
+    // allocate one progress slot per debug-info statement (See SignalHandler)
+    size_t numDebugStatements = 0;
+    visitDepthFirst(*(prog.getMain()), [&](const RamDebugInfo&) { ++numDebugStatements; });
+    for (auto& sub : prog.getSubroutines()) {
+        visitDepthFirst(*sub.second, [&](const RamDebugInfo&) { ++numDebugStatements; });
+    }
+    os << "SignalHandler::instance()->setProgressSlots(" << numDebugStatements << ");\n";
     os << registerRel;
     os << "}\n";
     // -- destructor --
@@ -1980,7 +3281,8 @@ void Synthesiser::generateCode(std::ostream& os, const std::string& id, bool& wi
 
     // -- run function --
     os << "private:\nvoid runFunction(std::string inputDirectory = \".\", "
-          "std::string outputDirectory = \".\", size_t stratumIndex = (size_t) -1, bool performIO = false) "
+          "std::string outputDirectory = \".\", size_t stratumIndex = (size_t) -1, bool performIO = false, "
+          "bool incremental = false) "
           "{\n";
 
     os << "SignalHandler::instance()->set();\n";
@@ -1997,14 +3299,31 @@ void Synthesiser::generateCode(std::ostream& os, const std::string& id, bool& wi
     }
     os << "std::atomic<size_t> iter(0);\n\n";
 
+    // the signature shared by all stratum member functions, carrying the
+    // state local to runFunction into the out-of-line stratum definitions
+    std::string stratumParameters =
+            "std::string& inputDirectory, std::string& outputDirectory, bool performIO, "
+            "std::atomic<size_t>& iter";
+    std::string stratumArguments = "inputDirectory, outputDirectory, performIO, iter";
+    if (hasIncrement) {
+        stratumParameters += ", std::atomic<RamDomain>& ctr";
+        stratumArguments += ", ctr";
+    }
+
     // set default threads (in embedded mode)
     // if this is not set, and omp is used, the default omp setting of number of cores is used.
     os << "#if defined(_OPENMP)\n";
     os << "if (getNumThreads() > 0) {omp_set_num_threads(getNumThreads());}\n";
+    os << "pinThreads(getNumThreads());\n";
     os << "#endif\n\n";
 
     // add actual program body
     os << "// -- query evaluation --\n";
+    if (Global::config().has("profile-sampling")) {
+        os << "ProfileEventSingleton::instance().setOutputFile(R\"_("
+           << Global::config().get("profile-sampling") << ")_\");\n";
+        os << "ProfileEventSingleton::instance().startSampler();\n";
+    }
     if (Global::config().has("profile")) {
         os << "ProfileEventSingleton::instance().startTimer();\n";
         os << R"_(ProfileEventSingleton::instance().makeTimeEvent("@time;starttime");)_" << '\n';
@@ -2018,8 +3337,9 @@ void Synthesiser::generateCode(std::ostream& os, const std::string& id, bool& wi
         // Store configuration
         os << R"_(ProfileEventSingleton::instance().makeConfigRecord("relationCount", std::to_string()_"
            << relationCount << "));";
-        // Outline stratum records for faster compilation
-        os << "[](){\n";
+        // Outline stratum records for faster compilation; the records are
+        // written once, so the section is kept cold
+        os << "[]() SOUFFLE_COLD_ATTRIBUTES {\n";
 
         // Record relations created in each stratum
         visitDepthFirst(*(prog.getMain()), [&](const RamStratum& stratum) {
@@ -2037,6 +3357,20 @@ void Synthesiser::generateCode(std::ostream& os, const std::string& id, bool& wi
                    << '\n';
             }
         });
+        // Record the b-tree leaf size chosen per relation, for tuning
+        visitDepthFirst(*(prog.getMain()), [&](const RamCreate& create) {
+            const RamRelation& rel = create.getRelation();
+            const auto representation = rel.getRepresentation();
+            if (rel.getName()[0] == '@' || (representation != RelationRepresentation::DEFAULT &&
+                                                   representation != RelationRepresentation::BTREE)) {
+                return;
+            }
+            bool isProvInfo = rel.getName().find("@info") != std::string::npos;
+            auto relationType = SynthesiserRelation::getSynthesiserRelation(rel, idxAnalysis->getIndexes(rel),
+                    Global::config().has("provenance") && !isProvInfo && isRuleWritten(rel.getName()));
+            os << R"_(ProfileEventSingleton::instance().makeConfigRecord("btree-block-size;)_"
+               << rel.getName() << R"_(", ")_" << relationType->getBTreeBlockSize() << R"_(");)_" << '\n';
+        });
         // End stratum record outlining
         os << "}();\n";
     }
@@ -2061,22 +3395,182 @@ void Synthesiser::generateCode(std::ostream& os, const std::string& id, bool& wi
         }
     }
 
-    // Set up stratum
+    // determine, for every non-temporary relation, the last stratum writing
+    // to it; its memory footprint is recorded there, before any later drop
+    std::map<std::string, size_t> lastStratumWrite;
+    if (Global::config().has("profile")) {
+        visitDepthFirst(*(prog.getMain()), [&](const RamStratum& stratum) {
+            auto index = stratum.getIndex();
+            visitDepthFirst(stratum, [&](const RamProject& project) {
+                lastStratumWrite[project.getRelation().getName()] = index;
+            });
+            visitDepthFirst(stratum, [&](const RamMerge& merge) {
+                lastStratumWrite[merge.getTargetRelation().getName()] = index;
+            });
+            visitDepthFirst(stratum, [&](const RamSwap& swap) {
+                lastStratumWrite[swap.getFirstRelation().getName()] = index;
+                lastStratumWrite[swap.getSecondRelation().getName()] = index;
+            });
+            visitDepthFirst(stratum, [&](const RamLoad& load) {
+                lastStratumWrite[load.getRelation().getName()] = index;
+            });
+            visitDepthFirst(stratum, [&](const RamFact& fact) {
+                lastStratumWrite[fact.getRelation().getName()] = index;
+            });
+            visitDepthFirst(stratum, [&](const RamFactTable& facts) {
+                lastStratumWrite[facts.getRelation().getName()] = index;
+            });
+        });
+    }
+
+    // determine, for every stratum, the non-temporary relations it references;
+    // an incremental re-run skips a stratum when none of them changed since
+    // its last execution, as re-evaluating it could only rederive known tuples
+    std::map<size_t, std::vector<std::string>> stratumRelations;
     visitDepthFirst(*(prog.getMain()), [&](const RamStratum& stratum) {
-        os << "/* BEGIN STRATUM " << stratum.getIndex() << " */\n";
+        std::set<std::string> names;
+        visitDepthFirst(stratum, [&](const RamNode& node) {
+            if (const auto* relOp = dynamic_cast<const RamRelationOperation*>(&node)) {
+                names.insert(relOp->getRelation().getName());
+            } else if (const auto* exists = dynamic_cast<const RamAbstractExistenceCheck*>(&node)) {
+                names.insert(exists->getRelation().getName());
+            } else if (const auto* empty = dynamic_cast<const RamEmptinessCheck*>(&node)) {
+                names.insert(empty->getRelation().getName());
+            } else if (const auto* project = dynamic_cast<const RamProject*>(&node)) {
+                names.insert(project->getRelation().getName());
+            } else if (const auto* merge = dynamic_cast<const RamMerge*>(&node)) {
+                names.insert(merge->getTargetRelation().getName());
+                names.insert(merge->getSourceRelation().getName());
+            } else if (const auto* swap = dynamic_cast<const RamSwap*>(&node)) {
+                names.insert(swap->getFirstRelation().getName());
+                names.insert(swap->getSecondRelation().getName());
+            } else if (const auto* load = dynamic_cast<const RamLoad*>(&node)) {
+                names.insert(load->getRelation().getName());
+            } else if (const auto* fact = dynamic_cast<const RamFact*>(&node)) {
+                names.insert(fact->getRelation().getName());
+            } else if (const auto* facts = dynamic_cast<const RamFactTable*>(&node)) {
+                names.insert(facts->getRelation().getName());
+            }
+        });
+        for (const auto& name : names) {
+            if (name[0] != '@') {
+                stratumRelations[stratum.getIndex()].push_back(name);
+            }
+        }
+    });
+
+    // Set up stratum; each stratum body becomes an out-of-line member
+    // function, so the strata can be split across translation units
+    auto emitStratum = [&](const RamStratum& stratum, std::ostream& run, const std::string& arguments) {
+        run << "/* BEGIN STRATUM " << stratum.getIndex() << " */\n";
         if (Global::config().has("engine")) {
             // go to the stratum with the max value for int as a suffix if calling the master stratum
             auto i = stratum.getIndex();
-            os << "STRATUM_" << i << ":\n";
-        }
-        os << "[&]() {\n";
-        emitCode(os, stratum.getBody());
-        os << "}();\n";
+            run << "STRATUM_" << i << ":\n";
+        }
+        // on an incremental re-run, skip the stratum if no relation it
+        // references changed since it last executed
+        run << "if (!incremental || !executed_stratum_" << stratum.getIndex();
+        const auto& watched = stratumRelations[stratum.getIndex()];
+        for (size_t i = 0; i < watched.size(); i++) {
+            run << " || inputSizes_stratum_" << stratum.getIndex() << "[" << i
+                << "] != " << getRelationName(watched[i]) << "->size()";
+        }
+        run << ") {\n";
+        // a per-stratum thread count from the runtime options file
+        // temporarily overrides the global team size
+        run << "#if defined(_OPENMP)\n";
+        run << "const std::string& jobsOverride_" << stratum.getIndex()
+            << " = Global::config().get(\"jobs-stratum-" << stratum.getIndex() << "\");\n";
+        run << "const int priorJobs_" << stratum.getIndex() << " = omp_get_max_threads();\n";
+        run << "if (!jobsOverride_" << stratum.getIndex() << ".empty() && std::stoi(jobsOverride_"
+            << stratum.getIndex() << ") > 0) omp_set_num_threads(std::stoi(jobsOverride_"
+            << stratum.getIndex() << "));\n";
+        run << "#endif\n";
+        run << "runStratum_" << stratum.getIndex() << "(" << arguments << ");\n";
+        run << "#if defined(_OPENMP)\n";
+        run << "if (!jobsOverride_" << stratum.getIndex() << ".empty()) omp_set_num_threads(priorJobs_"
+            << stratum.getIndex() << ");\n";
+        run << "#endif\n";
+        run << "}\n";
         if (Global::config().has("engine")) {
-            os << "if (stratumIndex != (size_t) -1) goto EXIT;\n";
+            run << "if (stratumIndex != (size_t) -1) goto EXIT;\n";
+        }
+        run << "/* END STRATUM " << stratum.getIndex() << " */\n";
+
+        std::ostringstream definition;
+        definition << "void " << classname << "::runStratum_" << stratum.getIndex() << "("
+                   << stratumParameters << ") {\n";
+        currentStratum = stratum.getIndex();
+        emittingStratum = true;
+        emitCode(definition, stratum.getBody());
+        emittingStratum = false;
+        // build the Bloom filters of the relations this stratum wrote
+        // last; later strata consult them before their membership probes
+        for (const auto& name : bloomFilteredRelations) {
+            if (bloomBuildStratum[name] == (size_t)stratum.getIndex()) {
+                definition << "if (useBloomFilters) bloom_" << getRelationName(name) << ".build(*"
+                           << getRelationName(name) << ");\n";
+            }
         }
-        os << "/* END STRATUM " << stratum.getIndex() << " */\n";
-    });
+        // snapshot the sizes of the referenced relations; an incremental
+        // re-run compares against these to decide whether to skip the stratum
+        definition << "executed_stratum_" << stratum.getIndex() << " = true;\n";
+        for (size_t i = 0; i < watched.size(); i++) {
+            definition << "inputSizes_stratum_" << stratum.getIndex() << "[" << i
+                       << "] = " << getRelationName(watched[i]) << "->size();\n";
+        }
+        // record the final memory footprint of every relation this stratum
+        // wrote last
+        for (const auto& cur : lastStratumWrite) {
+            if (cur.second != stratum.getIndex() || cur.first[0] == '@') {
+                continue;
+            }
+            definition << "ProfileEventSingleton::instance().makeQuantityEvent(R\"(@relation-memory;"
+                       << cur.first << ")\", " << getRelationName(cur.first) << "->getMemoryUsage(), "
+                       << stratum.getIndex() << ");\n";
+        }
+        definition << "}\n";
+        stratumDefinitions.push_back(definition.str());
+    };
+
+    // walk the main program; strata grouped into a parallel block by the
+    // translator (parallel-strata mode) are executed concurrently, one
+    // section per stratum, each with its own iteration counter
+    std::function<void(const RamStatement&)> emitStrata = [&](const RamStatement& stmt) {
+        if (const auto* seq = dynamic_cast<const RamSequence*>(&stmt)) {
+            for (const auto& cur : seq->getStatements()) {
+                emitStrata(*cur);
+            }
+        } else if (const auto* parallel = dynamic_cast<const RamParallel*>(&stmt)) {
+            const auto& stmts = parallel->getStatements();
+            if (stmts.size() == 1) {
+                emitStrata(*stmts[0]);
+                return;
+            }
+            std::string sectionArguments = "inputDirectory, outputDirectory, performIO, sectionIter";
+            if (hasIncrement) {
+                sectionArguments += ", ctr";
+            }
+            os << "STRATA_SECTIONS_START;\n";
+            for (const auto& cur : stmts) {
+                const auto* stratum = dynamic_cast<const RamStratum*>(cur);
+                assert(stratum != nullptr && "parallel strata block contains a non-stratum statement");
+                os << "STRATA_SECTION_START;\n";
+                os << "std::atomic<size_t> sectionIter(0);\n";
+                emitStratum(*stratum, os, sectionArguments);
+                os << "STRATA_SECTION_END\n";
+            }
+            os << "STRATA_SECTIONS_END;\n";
+        } else if (const auto* stratum = dynamic_cast<const RamStratum*>(&stmt)) {
+            emitStratum(*stratum, os, stratumArguments);
+        } else if (const auto* timer = dynamic_cast<const RamLogTimer*>(&stmt)) {
+            emitStrata(timer->getStatement());
+        } else if (const auto* dbg = dynamic_cast<const RamDebugInfo*>(&stmt)) {
+            emitStrata(dbg->getStatement());
+        }
+    };
+    emitStrata(*(prog.getMain()));
 
     if (Global::config().has("engine")) {
         os << "EXIT:{}";
@@ -2087,6 +3581,9 @@ void Synthesiser::generateCode(std::ostream& os, const std::string& id, bool& wi
         os << "ProfileEventSingleton::instance().stopTimer();\n";
         os << "dumpFreqs();\n";
     }
+    if (Global::config().has("profile-sampling")) {
+        os << "ProfileEventSingleton::instance().stopSampler();\n";
+    }
 
     // add code printing hint statistics
     os << "\n// -- relation hint statistics --\n";
@@ -2100,13 +3597,31 @@ void Synthesiser::generateCode(std::ostream& os, const std::string& id, bool& wi
     });
     os << "}\n";
 
+    if (Global::config().has("pipeline-store")) {
+        os << "joinPendingStores();\n";
+    }
     os << "SignalHandler::instance()->reset();\n";
 
     os << "}\n";  // end of runFunction() method
 
+    // declare the stratum member functions; their definitions are emitted
+    // out-of-line (possibly into separate translation units)
+    os << "private:\n";
+    visitDepthFirst(*(prog.getMain()), [&](const RamStratum& stratum) {
+        os << "void runStratum_" << stratum.getIndex() << "(" << stratumParameters << ");\n";
+        os << "bool executed_stratum_" << stratum.getIndex() << " = false;\n";
+        const auto& watched = stratumRelations[stratum.getIndex()];
+        if (!watched.empty()) {
+            os << "std::size_t inputSizes_stratum_" << stratum.getIndex() << "[" << watched.size()
+               << "] = {};\n";
+        }
+    });
+
     // add methods to run with and without performing IO (mainly for the interface)
     os << "public:\nvoid run(size_t stratumIndex = (size_t) -1) override { runFunction(\".\", \".\", "
           "stratumIndex, false); }\n";
+    os << "public:\nvoid runIncremental() override { runFunction(\".\", \".\", (size_t) -1, false, "
+          "true); }\n";
     os << "public:\nvoid runAll(std::string inputDirectory = \".\", std::string outputDirectory = \".\", "
           "size_t stratumIndex = (size_t) -1) "
           "override { ";
@@ -2279,90 +3794,156 @@ void Synthesiser::generateCode(std::ostream& os, const std::string& id, bool& wi
     os << "};\n";  // end of class declaration
 
     // hidden hooks
-    os << "SouffleProgram *newInstance_" << id << "(){return new " << classname << ";}\n";
-    os << "SymbolTable *getST_" << id << "(SouffleProgram *p){return &reinterpret_cast<" << classname
+    epilogue << "SouffleProgram *newInstance_" << id << "(){return new " << classname << ";}\n";
+    epilogue << "SymbolTable *getST_" << id << "(SouffleProgram *p){return &reinterpret_cast<" << classname
        << "*>(p)->symTable;}\n";
 
-    os << "\n#ifdef __EMBEDDED_SOUFFLE__\n";
-    os << "class factory_" << classname << ": public souffle::ProgramFactory {\n";
-    os << "SouffleProgram *newInstance() {\n";
-    os << "return new " << classname << "();\n";
-    os << "};\n";
-    os << "public:\n";
-    os << "factory_" << classname << "() : ProgramFactory(\"" << id << "\"){}\n";
-    os << "};\n";
-    os << "static factory_" << classname << " __factory_" << classname << "_instance;\n";
-    os << "}\n";
-    os << "#else\n";
-    os << "}\n";
-    os << "int main(int argc, char** argv)\n{\n";
-    os << "try{\n";
+    epilogue << "\n#ifdef __EMBEDDED_SOUFFLE__\n";
+    epilogue << "class factory_" << classname << ": public souffle::ProgramFactory {\n";
+    epilogue << "SouffleProgram *newInstance() {\n";
+    epilogue << "return new " << classname << "();\n";
+    epilogue << "};\n";
+    epilogue << "public:\n";
+    epilogue << "factory_" << classname << "() : ProgramFactory(\"" << id << "\"){}\n";
+    epilogue << "};\n";
+    epilogue << "static factory_" << classname << " __factory_" << classname << "_instance;\n";
+    epilogue << "}\n";
+    epilogue << "#else\n";
+    epilogue << "}\n";
+    epilogue << "int main(int argc, char** argv)\n{\n";
+    epilogue << "try{\n";
 
     // parse arguments
-    os << "souffle::CmdOptions opt(";
-    os << "R\"(" << Global::config().get("") << ")\",\n";
-    os << "R\"(.)\",\n";
-    os << "R\"(.)\",\n";
+    epilogue << "souffle::CmdOptions opt(";
+    epilogue << "R\"(" << Global::config().get("") << ")\",\n";
+    epilogue << "R\"(.)\",\n";
+    epilogue << "R\"(.)\",\n";
     if (Global::config().has("profile")) {
-        os << "true,\n";
-        os << "R\"(" << Global::config().get("profile") << ")\",\n";
+        epilogue << "true,\n";
+        epilogue << "R\"(" << Global::config().get("profile") << ")\",\n";
     } else {
-        os << "false,\n";
-        os << "R\"()\",\n";
+        epilogue << "false,\n";
+        epilogue << "R\"()\",\n";
     }
-    os << std::stoi(Global::config().get("jobs")) << ",\n";
-    os << "-1";
-    os << ");\n";
+    epilogue << std::stoi(Global::config().get("jobs")) << ",\n";
+    epilogue << "-1";
+    epilogue << ");\n";
 
-    os << "if (!opt.parse(argc,argv)) return 1;\n";
+    epilogue << "if (!opt.parse(argc,argv)) return 1;\n";
 
-    os << "souffle::";
+    epilogue << "souffle::";
     if (Global::config().has("profile")) {
-        os << classname + " obj(opt.getProfileName());\n";
+        epilogue << classname + " obj(opt.getProfileName());\n";
     } else {
-        os << classname + " obj;\n";
+        epilogue << classname + " obj;\n";
     }
 
-    os << "#if defined(_OPENMP) \n";
-    os << "obj.setNumThreads(opt.getNumJobs());\n";
-    os << "\n#endif\n";
+    epilogue << "#if defined(_OPENMP) \n";
+    epilogue << "obj.setNumThreads(opt.getNumJobs());\n";
+    epilogue << "\n#endif\n";
 
     if (Global::config().has("profile")) {
-        os << R"_(souffle::ProfileEventSingleton::instance().makeConfigRecord("", opt.getSourceFileName());)_"
+        epilogue << R"_(souffle::ProfileEventSingleton::instance().makeConfigRecord("", opt.getSourceFileName());)_"
            << '\n';
-        os << R"_(souffle::ProfileEventSingleton::instance().makeConfigRecord("fact-dir", opt.getInputFileDir());)_"
+        epilogue << R"_(souffle::ProfileEventSingleton::instance().makeConfigRecord("fact-dir", opt.getInputFileDir());)_"
            << '\n';
-        os << R"_(souffle::ProfileEventSingleton::instance().makeConfigRecord("jobs", std::to_string(opt.getNumJobs()));)_"
+        epilogue << R"_(souffle::ProfileEventSingleton::instance().makeConfigRecord("jobs", std::to_string(opt.getNumJobs()));)_"
            << '\n';
-        os << R"_(souffle::ProfileEventSingleton::instance().makeConfigRecord("output-dir", opt.getOutputFileDir());)_"
+        epilogue << R"_(souffle::ProfileEventSingleton::instance().makeConfigRecord("output-dir", opt.getOutputFileDir());)_"
            << '\n';
-        os << R"_(souffle::ProfileEventSingleton::instance().makeConfigRecord("version", ")_"
+        epilogue << R"_(souffle::ProfileEventSingleton::instance().makeConfigRecord("version", ")_"
            << Global::config().get("version") << R"_(");)_" << '\n';
     }
 #ifdef USE_MPI
     if (Global::config().get("engine") == "mpi") {
-        os << "\n#ifdef USE_MPI\n";
-        os << "souffle::mpi::init(argc, argv);";
-        os << "int rank = souffle::mpi::commRank();";
-        os << "int stratum = (rank == 0) ? " << std::numeric_limits<int>::max() << " : rank - 1;";
-        os << "obj.runAll(opt.getInputFileDir(), opt.getOutputFileDir(), stratum);\n";
-        os << "souffle::mpi::finalize();";
-        os << "\n#endif\n";
+        epilogue << "\n#ifdef USE_MPI\n";
+        epilogue << "souffle::mpi::init(argc, argv);";
+        epilogue << "int rank = souffle::mpi::commRank();";
+        epilogue << "int stratum = (rank == 0) ? " << std::numeric_limits<int>::max() << " : rank - 1;";
+        epilogue << "obj.runAll(opt.getInputFileDir(), opt.getOutputFileDir(), stratum);\n";
+        epilogue << "souffle::mpi::finalize();";
+        epilogue << "\n#endif\n";
     } else
 #endif
     {
-        os << "obj.runAll(opt.getInputFileDir(), opt.getOutputFileDir(), opt.getStratumIndex());\n";
+        // restoring a symbol-table snapshot re-interns the fact symbols of a
+        // previous run at their old ordinals, so warm starts skip the
+        // per-fact string interning during loading; the snapshot is
+        // (re-)written after the run, which also covers the cold start
+        epilogue << "if (!opt.getSymbolTableName().empty()) "
+                    "obj.getSymbolTable().restore(opt.getSymbolTableName());\n";
+        epilogue << "obj.runAll(opt.getInputFileDir(), opt.getOutputFileDir(), opt.getStratumIndex());\n";
+        epilogue << "if (!opt.getSymbolTableName().empty()) "
+                    "obj.getSymbolTable().dump(opt.getSymbolTableName());\n";
     }
 
     if (Global::config().get("provenance") == "explain") {
-        os << "explain(obj, false);\n";
+        epilogue << "explain(obj, false);\n";
     } else if (Global::config().get("provenance") == "explore") {
-        os << "explain(obj, true);\n";
+        epilogue << "explain(obj, true);\n";
+    } else if (Global::config().get("provenance").rfind("server", 0) == 0) {
+        epilogue << "explainServer(obj, \"" << Global::config().get("provenance") << "\");\n";
     }
-    os << "return 0;\n";
-    os << "} catch(std::exception &e) { souffle::SignalHandler::instance()->error(e.what());}\n";
-    os << "}\n";
-    os << "\n#endif\n";
+    epilogue << "return 0;\n";
+    epilogue << "} catch(std::exception &e) { souffle::SignalHandler::instance()->error(e.what());}\n";
+    epilogue << "}\n";
+    epilogue << "\n#endif\n";
+}
+
+void Synthesiser::generateCode(std::ostream& os, const std::string& id, bool& withSharedLibrary) {
+    std::ostringstream prologue;
+    std::ostringstream epilogue;
+    std::vector<std::string> stratumDefinitions;
+    generateCode(prologue, epilogue, stratumDefinitions, id, withSharedLibrary);
+
+    os << prologue.str();
+    for (const auto& definition : stratumDefinitions) {
+        os << definition;
+    }
+    os << epilogue.str();
+}
+
+std::vector<std::string> Synthesiser::generateCode(
+        const std::string& baseFilename, const std::string& id, bool& withSharedLibrary) {
+    std::ostringstream prologue;
+    std::ostringstream epilogue;
+    std::vector<std::string> stratumDefinitions;
+    generateCode(prologue, epilogue, stratumDefinitions, id, withSharedLibrary);
+
+    // the shared header holds the program class and its relation types
+    std::string headerFilename = baseFilename + ".hpp";
+    {
+        std::ofstream os(headerFilename);
+        os << "#pragma once\n";
+        os << prologue.str();
+        os << "}\n";  // end of namespace souffle
+    }
+
+    std::vector<std::string> sourceFilenames;
+
+    // the primary source file holds the instance hooks, factory and main
+    {
+        std::string filename = baseFilename + ".cpp";
+        std::ofstream os(filename);
+        os << "\n#include \"" << baseName(headerFilename) << "\"\n";
+        os << "namespace souffle {\n";
+        os << epilogue.str();
+        sourceFilenames.push_back(filename);
+    }
+
+    // one source file per stratum
+    for (size_t i = 0; i < stratumDefinitions.size(); i++) {
+        std::string filename = baseFilename + "-stratum-" + std::to_string(i) + ".cpp";
+        std::ofstream os(filename);
+        os << "\n#include \"" << baseName(headerFilename) << "\"\n";
+        os << "namespace souffle {\n";
+        os << "using namespace ram;\n";
+        os << stratumDefinitions[i];
+        os << "}\n";  // end of namespace souffle
+        sourceFilenames.push_back(filename);
+    }
+
+    return sourceFilenames;
 }
 
 }  // end of namespace souffle
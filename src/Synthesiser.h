@@ -23,6 +23,7 @@
 #include <ostream>
 #include <set>
 #include <string>
+#include <vector>
 
 namespace souffle {
 
@@ -51,6 +52,32 @@ private:
     /** Cache for generated types for relations */
     std::set<std::string> typeCache;
 
+    /** Sorted tuples of relations whose contents are fully known at
+     * compile time, i.e. only ever written by constant facts */
+    std::map<std::string, std::set<std::vector<RamDomain>>> constantFacts;
+
+    /** Relations written by a rule; under provenance, all other relations
+     * keep the plain b-tree layout */
+    std::set<std::string> ruleWrittenRelations;
+
+    /** Relations guarded by a Bloom filter: probed by a negated, fully
+     * bound existence check from a stratum after their last write */
+    std::set<std::string> bloomFilteredRelations;
+
+    /** Last stratum writing each Bloom-filtered relation; the filter is
+     * built when that stratum completes */
+    std::map<std::string, size_t> bloomBuildStratum;
+
+    /** Index of the stratum whose body is currently being emitted */
+    size_t currentStratum = 0;
+
+    /** Whether a stratum body is currently being emitted (as opposed to
+     * e.g. a provenance subroutine) */
+    bool emittingStratum = false;
+
+    /** Next available progress slot for a debug-info statement */
+    size_t debugStatementId = 0;
+
 protected:
     /** Convert RAM identifier */
     const std::string convertRamIdent(const std::string& name);
@@ -85,6 +112,33 @@ protected:
     /** Lookup read counter */
     size_t lookupReadIdx(const std::string& txt);
 
+    /** Collect the relations whose contents are fully known at compile time */
+    void computeConstantFacts();
+
+    /** Return the sorted tuples of a compile-time constant relation, or
+     * nullptr if the relation is mutated at run time */
+    const std::set<std::vector<RamDomain>>* getConstantFacts(const std::string& relName) const;
+
+    /** Check whether a Bloom filter pre-check applies to a membership
+     * probe into the given relation at the current emission point */
+    bool bloomFilterApplies(const std::string& relName) const;
+
+    /** Collect the relations written by a rule */
+    void computeRuleWrittenRelations();
+
+    /** Check whether a relation is written by a rule */
+    bool isRuleWritten(const std::string& relName) const;
+
+    /**
+     * Generate code into its three building blocks: the prologue holds
+     * everything up to and including the program class (leaving namespace
+     * souffle open), each stratum definition holds the out-of-line member
+     * function evaluating one stratum, and the epilogue holds the instance
+     * hooks, factory and main function (closing the namespace).
+     */
+    void generateCode(std::ostream& prologue, std::ostream& epilogue,
+            std::vector<std::string>& stratumDefinitions, const std::string& id, bool& withSharedLibrary);
+
 public:
     Synthesiser(RamTranslationUnit& tUnit) : translationUnit(tUnit) {}
     virtual ~Synthesiser() = default;
@@ -96,5 +150,15 @@ public:
 
     /** Generate code */
     void generateCode(std::ostream& os, const std::string& id, bool& withSharedLibrary);
+
+    /**
+     * Generate code split across multiple translation units: a shared
+     * header, a primary source file and one source file per stratum, so
+     * large programs can be compiled in parallel.
+     *
+     * @return the paths of all generated source files, primary file first
+     */
+    std::vector<std::string> generateCode(
+            const std::string& baseFilename, const std::string& id, bool& withSharedLibrary);
 };
 }  // end of namespace souffle
@@ -32,9 +32,45 @@ std::unique_ptr<SynthesiserRelation> SynthesiserRelation::getSynthesiserRelation
         rel = new SynthesiserBrieRelation(ramRel, indexSet, isProvenance);
     } else if (ramRel.getRepresentation() == RelationRepresentation::EQREL) {
         rel = new SynthesiserEqrelRelation(ramRel, indexSet, isProvenance);
+    } else if (ramRel.getRepresentation() == RelationRepresentation::COLUMNAR) {
+        rel = new SynthesiserColumnarRelation(ramRel, indexSet, isProvenance);
+    } else if (ramRel.getRepresentation() == RelationRepresentation::BITSET) {
+        rel = new SynthesiserBitsetRelation(ramRel, indexSet, isProvenance);
+    } else if (ramRel.getRepresentation() == RelationRepresentation::FUNCTIONAL) {
+        // functional relations enforce their key constraint in the insert
+        // path of the direct representation
+        rel = new SynthesiserDirectRelation(ramRel, indexSet, isProvenance);
+    } else if (ramRel.getRepresentation() == RelationRepresentation::GROUPED) {
+        // grouped storage answers searches bound on a prefix of the
+        // attribute list only; a relation also searched on non-prefix
+        // columns falls back to the direct representation
+        bool prefixOnly = true;
+        for (auto search : indexSet.getSearches()) {
+            if ((search & (search + 1)) != 0) {
+                prefixOnly = false;
+            }
+        }
+        if (prefixOnly) {
+            rel = new SynthesiserGroupedRelation(ramRel, indexSet, isProvenance);
+        } else {
+            rel = new SynthesiserDirectRelation(ramRel, indexSet, isProvenance);
+        }
     } else {
         // Handle the data structure command line flag
-        if (ramRel.getArity() > 6) {
+        //
+        // Relations marked auto also end up here: generated code fixes its
+        // data structures at compile time and can not migrate at runtime,
+        // so the static footprint heuristic below applies instead
+        //
+        // A direct representation pays a full tuple copy per index, an
+        // indirect one a single tuple copy in the data table plus one
+        // pointer per index; wide or multi-indexed relations are kept
+        // indirect when that is the smaller footprint
+        const size_t numIndexes = std::max<size_t>(1, indexSet.getAllOrders().size());
+        const size_t wordsPerPointer = sizeof(void*) / sizeof(RamDomain);
+        const size_t directWords = numIndexes * ramRel.getArity();
+        const size_t indirectWords = ramRel.getArity() + numIndexes * wordsPerPointer;
+        if (ramRel.getArity() > 6 || indirectWords < directWords) {
             rel = new SynthesiserIndirectRelation(ramRel, indexSet, isProvenance);
         } else {
             rel = new SynthesiserDirectRelation(ramRel, indexSet, isProvenance);
@@ -90,27 +126,22 @@ void SynthesiserDirectRelation::computeIndices() {
             // If this relation is used with provenance,
             // we must expand all search orders to be full indices,
             // since weak/strong comparators and updaters need this,
-            // and also add provenance annotations to the indices
+            // and also add the provenance annotation to the indices
             if (isProvenance) {
                 // expand index to be full
-                for (size_t i = 0; i < getArity() - 2; i++) {
+                for (size_t i = 0; i < getArity() - 1; i++) {
                     if (curIndexElems.find(i) == curIndexElems.end()) {
                         ind.push_back(i);
                     }
                 }
 
-                // remove any provenance annotations already in the index order
+                // remove the provenance annotation if already in the index order
                 if (curIndexElems.find(getArity() - 1) != curIndexElems.end()) {
                     ind.erase(std::find(ind.begin(), ind.end(), getArity() - 1));
                 }
 
-                if (curIndexElems.find(getArity() - 2) != curIndexElems.end()) {
-                    ind.erase(std::find(ind.begin(), ind.end(), getArity() - 2));
-                }
-
-                // add provenance annotations to the index, but in reverse order
+                // add the provenance annotation as the last index column
                 ind.push_back(getArity() - 1);
-                ind.push_back(getArity() - 2);
             } else {
                 // expand index to be full
                 for (size_t i = 0; i < getArity(); i++) {
@@ -132,6 +163,15 @@ std::string SynthesiserDirectRelation::getTypeName() {
     std::stringstream res;
     res << "t_btree_" << getArity();
 
+    // relations differing only in their leaf size need distinct types
+    if (getBTreeBlockSize() != 256) {
+        res << "__blk" << getBTreeBlockSize();
+    }
+
+    if (getRamRelation().getRepresentation() == RelationRepresentation::FUNCTIONAL) {
+        res << "__functional";
+    }
+
     for (auto& ind : getIndices()) {
         res << "__" << join(ind, "_");
     }
@@ -160,7 +200,6 @@ void SynthesiserDirectRelation::generateTypeStruct(std::ostream& out) {
     if (isProvenance) {
         out << "struct updater_" << getTypeName() << " {\n";
         out << "void update(t_tuple& old_t, const t_tuple& new_t) {\n";
-        out << "old_t[" << arity - 2 << "] = new_t[" << arity - 2 << "];\n";
         out << "old_t[" << arity - 1 << "] = new_t[" << arity - 1 << "];\n";
         out << "}\n";
         out << "};\n";
@@ -178,23 +217,37 @@ void SynthesiserDirectRelation::generateTypeStruct(std::ostream& out) {
         // also strong/weak comparators and updater methods
         if (isProvenance) {
             out << "using t_ind_" << i << " = btree_set<t_tuple, index_utils::comparator<" << join(ind);
-            out << ">, std::allocator<t_tuple>, 256, typename "
+            out << ">, std::allocator<t_tuple>, " << getBTreeBlockSize()
+                << ", typename "
                    "souffle::detail::default_strategy<t_tuple>::type, index_utils::comparator<";
-            out << join(ind.begin(), ind.end() - 2) << ">, updater_" << getTypeName() << ">;\n";
+            out << join(ind.begin(), ind.end() - 1) << ">, updater_" << getTypeName() << ">;\n";
 
             // without provenance, some indices may be not full, so we use btree_multiset for those
         } else {
             if (ind.size() == arity) {
                 out << "using t_ind_" << i << " = btree_set<t_tuple, index_utils::comparator<" << join(ind)
-                    << ">>;\n";
+                    << ">, std::allocator<t_tuple>, " << getBTreeBlockSize() << ">;\n";
             } else {
                 out << "using t_ind_" << i << " = btree_multiset<t_tuple, index_utils::comparator<"
-                    << join(ind) << ">>;\n";
+                    << join(ind) << ">, std::allocator<t_tuple>, " << getBTreeBlockSize() << ">;\n";
             }
         }
         out << "t_ind_" << i << " ind_" << i << ";\n";
     }
 
+    const bool functional = getRamRelation().getRepresentation() == RelationRepresentation::FUNCTIONAL;
+
+    // functional relations keep one tuple per key (all attributes but the
+    // last); a set ordered on the key attributes only decides at insert
+    // time whether a key is already mapped, so the first writer wins
+    if (functional) {
+        std::vector<size_t> keyColumns(arity - 1);
+        std::iota(keyColumns.begin(), keyColumns.end(), 0);
+        out << "using t_ind_key = btree_set<t_tuple, index_utils::comparator<" << join(keyColumns)
+            << ">, std::allocator<t_tuple>, " << getBTreeBlockSize() << ">;\n";
+        out << "t_ind_key ind_key;\n";
+    }
+
     // typedef master index iterator to be struct iterator
     out << "using iterator = t_ind_" << masterIndex << "::iterator;\n";
 
@@ -203,6 +256,9 @@ void SynthesiserDirectRelation::generateTypeStruct(std::ostream& out) {
     for (size_t i = 0; i < numIndexes; i++) {
         out << "t_ind_" << i << "::operation_hints hints_" << i << ";\n";
     }
+    if (functional) {
+        out << "t_ind_key::operation_hints hints_key;\n";
+    }
     out << "};\n";
     out << "context createContext() { return context(); }\n";
 
@@ -213,6 +269,11 @@ void SynthesiserDirectRelation::generateTypeStruct(std::ostream& out) {
     out << "}\n";  // end of insert(t_tuple&)
 
     out << "bool insert(const t_tuple& t, context& h) {\n";
+    if (functional) {
+        // the key set accepts exactly one tuple per key; a losing insert
+        // leaves the indices untouched and the established tuple in place
+        out << "if (!ind_key.insert(t, h.hints_key)) return false;\n";
+    }
     out << "if (ind_" << masterIndex << ".insert(t, h.hints_" << masterIndex << ")) {\n";
     for (size_t i = 0; i < numIndexes; i++) {
         if (i != masterIndex) {
@@ -250,8 +311,15 @@ void SynthesiserDirectRelation::generateTypeStruct(std::ostream& out) {
     out << "}\n";  // end of insertAll<T>
 
     out << "void insertAll(" << getTypeName() << "& other) {\n";
-    for (size_t i = 0; i < numIndexes; i++) {
-        out << "ind_" << i << ".insertAll(other.ind_" << i << ");\n";
+    if (functional) {
+        // merging indices wholesale would bypass the key constraint
+        out << "for (auto const& cur : other) {\n";
+        out << "insert(cur);\n";
+        out << "}\n";
+    } else {
+        for (size_t i = 0; i < numIndexes; i++) {
+            out << "ind_" << i << ".insertAll(other.ind_" << i << ");\n";
+        }
     }
     out << "}\n";  // end of insertAll(relationType& other)
 
@@ -265,6 +333,11 @@ void SynthesiserDirectRelation::generateTypeStruct(std::ostream& out) {
     out << "return contains(t, h);\n";
     out << "}\n";
 
+    // batched probe, overlapping the descents of several membership tests
+    out << "void containsBatch(const t_tuple* ts, std::size_t count, bool* result) const {\n";
+    out << "ind_" << masterIndex << ".containsBatch(ts, count, result);\n";
+    out << "}\n";
+
     // size method
     out << "std::size_t size() const {\n";
     out << "return ind_" << masterIndex << ".size();\n";
@@ -334,6 +407,25 @@ void SynthesiserDirectRelation::generateTypeStruct(std::ostream& out) {
         out << "}\n";
     }
 
+    // lowerUpperBound methods for range queries on the indexed search patterns;
+    // the caller provides fully padded lower and upper bound tuples
+    for (int64_t search : getMinIndexSelection().getSearches()) {
+        auto lexOrder = getMinIndexSelection().getLexOrder(search);
+        size_t indNum = indexToNumMap[lexOrder];
+
+        out << "range<t_ind_" << indNum << "::iterator> lowerUpperBound_" << search;
+        out << "(const t_tuple& low, const t_tuple& high, context& h) const {\n";
+        out << "return make_range(ind_" << indNum << ".lower_bound(low, h.hints_" << indNum << "), ind_"
+            << indNum << ".upper_bound(high, h.hints_" << indNum << "));\n";
+        out << "}\n";
+
+        out << "range<t_ind_" << indNum << "::iterator> lowerUpperBound_" << search;
+        out << "(const t_tuple& low, const t_tuple& high) const {\n";
+        out << "context h;\n";
+        out << "return lowerUpperBound_" << search << "(low, high, h);\n";
+        out << "}\n";
+    }
+
     // empty method
     out << "bool empty() const {\n";
     out << "return ind_" << masterIndex << ".empty();\n";
@@ -341,7 +433,7 @@ void SynthesiserDirectRelation::generateTypeStruct(std::ostream& out) {
 
     // partition method for parallelism
     out << "std::vector<range<iterator>> partition() const {\n";
-    out << "return ind_" << masterIndex << ".getChunks(400);\n";
+    out << "return ind_" << masterIndex << ".partition(400);\n";
     out << "}\n";
 
     // purge method
@@ -349,6 +441,21 @@ void SynthesiserDirectRelation::generateTypeStruct(std::ostream& out) {
     for (size_t i = 0; i < numIndexes; i++) {
         out << "ind_" << i << ".clear();\n";
     }
+    if (functional) {
+        out << "ind_key.clear();\n";
+    }
+    out << "}\n";
+
+    // getMemoryUsage method
+    out << "std::size_t getMemoryUsage() const {\n";
+    out << "return ";
+    for (size_t i = 0; i < numIndexes; i++) {
+        out << (i > 0 ? " + " : "") << "ind_" << i << ".getMemoryUsage()";
+    }
+    if (functional) {
+        out << " + ind_key.getMemoryUsage()";
+    }
+    out << ";\n";
     out << "}\n";
 
     // begin and end iterators
@@ -627,6 +734,24 @@ void SynthesiserIndirectRelation::generateTypeStruct(std::ostream& out) {
         out << "}\n";
     }
 
+    // lowerUpperBound methods for range queries on the indexed search patterns;
+    // the caller provides fully padded lower and upper bound tuples
+    for (int64_t search : getMinIndexSelection().getSearches()) {
+        auto lexOrder = getMinIndexSelection().getLexOrder(search);
+        size_t indNum = indexToNumMap[lexOrder];
+
+        out << "range<iterator_" << indNum << "> lowerUpperBound_" << search;
+        out << "(const t_tuple& low, const t_tuple& high, context& h) const {\n";
+        out << "return range<iterator_" << indNum << ">(ind_" << indNum << ".lower_bound(&low, h.hints_"
+            << indNum << "), ind_" << indNum << ".upper_bound(&high, h.hints_" << indNum << "));\n";
+        out << "}\n";
+
+        out << "range<iterator_" << indNum << "> lowerUpperBound_" << search;
+        out << "(const t_tuple& low, const t_tuple& high) const {\n";
+        out << "context h; return lowerUpperBound_" << search << "(low, high, h);\n";
+        out << "}\n";
+    }
+
     // empty method
     out << "bool empty() const {\n";
     out << "return ind_" << masterIndex << ".empty();\n";
@@ -635,7 +760,7 @@ void SynthesiserIndirectRelation::generateTypeStruct(std::ostream& out) {
     // partition method
     out << "std::vector<range<iterator>> partition() const {\n";
     out << "std::vector<range<iterator>> res;\n";
-    out << "for (const auto& cur : ind_" << masterIndex << ".getChunks(400)) {\n";
+    out << "for (const auto& cur : ind_" << masterIndex << ".partition(400)) {\n";
     out << "    res.push_back(make_range(derefIter(cur.begin()), derefIter(cur.end())));\n";
     out << "}\n";
     out << "return res;\n";
@@ -649,6 +774,15 @@ void SynthesiserIndirectRelation::generateTypeStruct(std::ostream& out) {
     out << "dataTable.clear();\n";
     out << "}\n";
 
+    // getMemoryUsage method
+    out << "std::size_t getMemoryUsage() const {\n";
+    out << "return dataTable.getMemoryUsage()";
+    for (size_t i = 0; i < numIndexes; i++) {
+        out << " + ind_" << i << ".getMemoryUsage()";
+    }
+    out << ";\n";
+    out << "}\n";
+
     // begin and end iterators
     out << "iterator begin() const {\n";
     out << "return ind_" << masterIndex << ".begin();\n";
@@ -683,11 +817,11 @@ void SynthesiserIndirectRelation::generateTypeStruct(std::ostream& out) {
     out << "};\n";
 }
 
-// -------- Brie Relation --------
+// -------- Columnar (Structure-of-Arrays) Relation --------
 
-/** Generate index set for a brie relation */
-void SynthesiserBrieRelation::computeIndices() {
-    assert(!isProvenance && "bries cannot be used with provenance");
+/** Generate index set for a columnar relation */
+void SynthesiserColumnarRelation::computeIndices() {
+    assert(!isProvenance && "columnar relations cannot be used with provenance");
 
     // Generate and set indices
     MinIndexSelection::OrderCollection inds = indices.getAllOrders();
@@ -699,9 +833,9 @@ void SynthesiserBrieRelation::computeIndices() {
         inds.push_back(fullInd);
     }
 
-    // expand all indexes to be full
+    // expand all search orders to be full
     for (auto& ind : inds) {
-        if (ind.size() != getArity()) {
+        if (ind.size() < getArity()) {
             // use a set as a cache for fast lookup
             std::set<int> curIndexElems(ind.begin(), ind.end());
 
@@ -712,18 +846,22 @@ void SynthesiserBrieRelation::computeIndices() {
                 }
             }
         }
-
-        assert(ind.size() == getArity());
     }
+
     masterIndex = 0;
 
     computedIndices = inds;
 }
 
-/** Generate type name of a brie relation */
-std::string SynthesiserBrieRelation::getTypeName() {
+/** Generate type name of a columnar relation */
+std::string SynthesiserColumnarRelation::getTypeName() {
     std::stringstream res;
-    res << "t_brie_" << getArity();
+    res << "t_columnar_" << getArity();
+
+    // relations differing only in their leaf size need distinct types
+    if (getBTreeBlockSize() != 256) {
+        res << "__blk" << getBTreeBlockSize();
+    }
 
     for (auto& ind : getIndices()) {
         res << "__" << join(ind, "_");
@@ -736,8 +874,15 @@ std::string SynthesiserBrieRelation::getTypeName() {
     return res.str();
 }
 
-/** Generate type struct of a brie relation */
-void SynthesiserBrieRelation::generateTypeStruct(std::ostream& out) {
+/** Generate type struct of a columnar relation.
+ * Point and range queries are served by row-major b-tree indices as for a
+ * direct relation; in addition, a column-major copy of the tuples is kept
+ * so that full scans read only the columns the scan body actually accesses,
+ * trading memory for scan bandwidth on wide relations. Each column is held
+ * at the narrowest physical width fitting its observed values (see
+ * CompactColumn), so the many columns holding small ordinals cost a
+ * fraction of a full RamDomain per tuple. */
+void SynthesiserColumnarRelation::generateTypeStruct(std::ostream& out) {
     size_t arity = getArity();
     const auto& inds = getIndices();
     size_t numIndexes = inds.size();
@@ -746,60 +891,70 @@ void SynthesiserBrieRelation::generateTypeStruct(std::ostream& out) {
     // struct definition
     out << "struct " << getTypeName() << " {\n";
 
-    // define trie structures
+    // stored tuple type
+    out << "using t_tuple = Tuple<RamDomain, " << arity << ">;\n";
+
+    // generate the btree type for each relation
     for (size_t i = 0; i < inds.size(); i++) {
+        auto& ind = inds[i];
+
         if (i < getMinIndexSelection().getAllOrders().size()) {
             indexToNumMap[getMinIndexSelection().getAllOrders()[i]] = i;
         }
-        out << "using t_ind_" << i << " = Trie<" << inds[i].size() << ">;\n";
+
+        if (ind.size() == arity) {
+            out << "using t_ind_" << i << " = btree_set<t_tuple, index_utils::comparator<" << join(ind)
+                << ">, std::allocator<t_tuple>, " << getBTreeBlockSize() << ">;\n";
+        } else {
+            out << "using t_ind_" << i << " = btree_multiset<t_tuple, index_utils::comparator<" << join(ind)
+                << ">, std::allocator<t_tuple>, " << getBTreeBlockSize() << ">;\n";
+        }
         out << "t_ind_" << i << " ind_" << i << ";\n";
     }
-    out << "using t_tuple = t_ind_" << masterIndex << "::entry_type;\n";
-
-    // generate auxiliary iterators that use orderOut
-    for (size_t i = 0; i < numIndexes; i++) {
-        // generate auxiliary iterators which orderOut
-        out << "class iterator_" << i << " : public std::iterator<std::forward_iterator_tag, t_tuple> {\n";
-        out << "    using nested_iterator = typename t_ind_" << i << "::iterator;\n";
-        out << "    nested_iterator nested;\n";
-        out << "    t_tuple value;\n";
-
-        out << "public:\n";
-        out << "    iterator_" << i << "() = default;\n";
-        out << "    iterator_" << i << "(const nested_iterator& iter) : nested(iter), value(orderOut_" << i
-            << "(*iter)) {}\n";
-        out << "    iterator_" << i << "(const iterator_" << i << "& other) = default;\n";
-        out << "    iterator_" << i << "& operator=(const iterator_" << i << "& other) = default;\n";
 
-        out << "    bool operator==(const iterator_" << i << "& other) const {\n";
-        out << "        return nested == other.nested;\n";
-        out << "    }\n";
+    // typedef master index iterator to be struct iterator
+    out << "using iterator = t_ind_" << masterIndex << "::iterator;\n";
 
-        out << "    bool operator!=(const iterator_" << i << "& other) const {\n";
-        out << "        return !(*this == other);\n";
-        out << "    }\n";
+    // column-major copy of the tuples in insertion order; each column is
+    // stored at the narrowest physical width fitting its observed values
+    // and widened back to RamDomain only on access. The lock serialises
+    // appends issued by concurrent inserts
+    out << "CompactColumn columns[" << arity << "];\n";
+    out << "Lock append_lock;\n";
+
+    // a lightweight reference to a row of the column store; only the
+    // columns accessed through operator[] are ever touched
+    out << "struct scan_reference {\n";
+    out << "const " << getTypeName() << "* rel;\n";
+    out << "std::size_t row;\n";
+    out << "RamDomain operator[](std::size_t col) const {\n";
+    out << "return rel->columns[col][row];\n";
+    out << "}\n";
+    out << "};\n";
 
-        out << "    const t_tuple& operator*() const {\n";
-        out << "        return value;\n";
-        out << "    }\n";
+    out << "scan_reference scanAt(std::size_t row) const {\n";
+    out << "return scan_reference{this, row};\n";
+    out << "}\n";
 
-        out << "    const t_tuple* operator->() const {\n";
-        out << "        return &value;\n";
-        out << "    }\n";
+    out << "std::size_t scanSize() const {\n";
+    out << "return columns[0].size();\n";
+    out << "}\n";
 
-        out << "    iterator_" << i << "& operator++() {\n";
-        out << "        ++nested;\n";
-        out << "        value = orderOut_" << i << "(*nested);\n";
-        out << "        return *this;\n";
-        out << "    }\n";
-        out << "};\n";
-    }
-    out << "using iterator = iterator_" << masterIndex << ";\n";
+    // row ranges for parallel scans over the column store
+    out << "std::vector<std::pair<std::size_t,std::size_t>> partitionScan() const {\n";
+    out << "std::vector<std::pair<std::size_t,std::size_t>> res;\n";
+    out << "std::size_t n = scanSize();\n";
+    out << "std::size_t step = n / 400 + 1;\n";
+    out << "for (std::size_t i = 0; i < n; i += step) {\n";
+    out << "res.push_back(std::make_pair(i, std::min(i + step, n)));\n";
+    out << "}\n";
+    out << "return res;\n";
+    out << "}\n";
 
-    // hints struct
+    // create a struct storing hints for each btree
     out << "struct context {\n";
     for (size_t i = 0; i < numIndexes; i++) {
-        out << "t_ind_" << i << "::op_context hints_" << i << ";\n";
+        out << "t_ind_" << i << "::operation_hints hints_" << i << ";\n";
     }
     out << "};\n";
     out << "context createContext() { return context(); }\n";
@@ -808,19 +963,25 @@ void SynthesiserBrieRelation::generateTypeStruct(std::ostream& out) {
     out << "bool insert(const t_tuple& t) {\n";
     out << "context h;\n";
     out << "return insert(t, h);\n";
-    out << "}\n";
+    out << "}\n";  // end of insert(t_tuple&)
 
     out << "bool insert(const t_tuple& t, context& h) {\n";
-    out << "if (ind_" << masterIndex << ".insert(orderIn_" << masterIndex << "(t), h.hints_" << masterIndex
-        << ")) {\n";
+    out << "if (ind_" << masterIndex << ".insert(t, h.hints_" << masterIndex << ")) {\n";
     for (size_t i = 0; i < numIndexes; i++) {
         if (i != masterIndex) {
-            out << "ind_" << i << ".insert(orderIn_" << i << "(t), h.hints_" << i << ");\n";
+            out << "ind_" << i << ".insert(t, h.hints_" << i << ");\n";
         }
     }
+    out << "{\n";
+    out << "auto lease = append_lock.acquire();\n";
+    out << "(void)lease;\n";
+    for (size_t i = 0; i < arity; i++) {
+        out << "columns[" << i << "].push_back(t[" << i << "]);\n";
+    }
+    out << "}\n";
     out << "return true;\n";
     out << "} else return false;\n";
-    out << "}\n";
+    out << "}\n";  // end of insert(t_tuple&, context&)
 
     out << "bool insert(const RamDomain* ramDomain) {\n";
     out << "RamDomain data[" << arity << "];\n";
@@ -828,38 +989,30 @@ void SynthesiserBrieRelation::generateTypeStruct(std::ostream& out) {
     out << "const t_tuple& tuple = reinterpret_cast<const t_tuple&>(data);\n";
     out << "context h;\n";
     out << "return insert(tuple, h);\n";
-    out << "}\n";
-
-    // insertAll method
-    out << "template <typename T>\n";
-    out << "void insertAll(T& other) {\n";
-    out << "for (auto const& cur : other) {\n";
-    out << "insert(cur);\n";
-    out << "}\n";
-    out << "}\n";
-
-    // insertAll using the index method
-    out << "void insertAll(" << getTypeName() << "& other) {\n";
-    for (size_t i = 0; i < numIndexes; i++) {
-        out << "ind_" << i << ".insertAll(other.ind_" << i << ");\n";
-    }
-    out << "}\n";
+    out << "}\n";  // end of insert(RamDomain*)
 
-    // insert method
     std::vector<std::string> decls, params;
     for (size_t i = 0; i < arity; i++) {
         decls.push_back("RamDomain a" + std::to_string(i));
         params.push_back("a" + std::to_string(i));
     }
-    out << "bool insert(" << join(decls, ",") << ") {\nRamDomain data[";
-    out << arity << "] = {" << join(params, ",") << "};\n";
+    out << "bool insert(" << join(decls, ",") << ") {\n";
+    out << "RamDomain data[" << arity << "] = {" << join(params, ",") << "};\n";
     out << "return insert(data);\n";
+    out << "}\n";  // end of insert(RamDomain x1, RamDomain x2, ...)
+
+    // insertAll method
+    // do not use a specialized insertAll as the column store must be kept in sync
+    out << "template <typename T>\n";
+    out << "void insertAll(T& other) {\n";
+    out << "for (auto const& cur : other) {\n";
+    out << "insert(cur);\n";
     out << "}\n";
+    out << "}\n";  // end of insertAll<T>
 
     // contains methods
     out << "bool contains(const t_tuple& t, context& h) const {\n";
-    out << "return ind_" << masterIndex << ".contains(orderIn_" << masterIndex << "(t), h.hints_"
-        << masterIndex << ");\n";
+    out << "return ind_" << masterIndex << ".contains(t, h.hints_" << masterIndex << ");\n";
     out << "}\n";
 
     out << "bool contains(const t_tuple& t) const {\n";
@@ -873,17 +1026,14 @@ void SynthesiserBrieRelation::generateTypeStruct(std::ostream& out) {
     out << "}\n";
 
     // find methods
-    if (arity > 1) {
-        out << "iterator find(const t_tuple& t, context& h) const {\n";
-        out << "return ind_" << masterIndex << ".find(orderIn_" << masterIndex << "(t), h.hints_"
-            << masterIndex << ");\n";
-        out << "}\n";
+    out << "iterator find(const t_tuple& t, context& h) const {\n";
+    out << "return ind_" << masterIndex << ".find(t, h.hints_" << masterIndex << ");\n";
+    out << "}\n";
 
-        out << "iterator find(const t_tuple& t) const {\n";
-        out << "context h;\n";
-        out << "return find(t, h);\n";
-        out << "}\n";
-    }
+    out << "iterator find(const t_tuple& t) const {\n";
+    out << "context h;\n";
+    out << "return find(t, h);\n";
+    out << "}\n";
 
     // empty equalRange method
     out << "range<iterator> equalRange_0(const t_tuple& t, context& h) const {\n";
@@ -894,31 +1044,67 @@ void SynthesiserBrieRelation::generateTypeStruct(std::ostream& out) {
     out << "return range<iterator>(ind_" << masterIndex << ".begin(),ind_" << masterIndex << ".end());\n";
     out << "}\n";
 
-    // equalRange methods
+    // equalRange methods for each pattern which is used to search this relation
     for (int64_t search : getMinIndexSelection().getSearches()) {
         auto lexOrder = getMinIndexSelection().getLexOrder(search);
         size_t indNum = indexToNumMap[lexOrder];
 
-        out << "range<iterator_" << indNum << "> equalRange_" << search;
+        out << "range<t_ind_" << indNum << "::iterator> equalRange_" << search;
         out << "(const t_tuple& t, context& h) const {\n";
 
-        // compute size of sub-index
+        // count size of search pattern
         size_t indSize = 0;
-        for (size_t i = 0; i < arity; i++) {
-            if ((search >> i) & 1) {
+        for (size_t column = 0; column < arity; column++) {
+            if ((search >> column) & 1) {
                 indSize++;
             }
         }
 
-        out << "auto r = ind_" << indNum << ".template getBoundaries<" << indSize << ">(orderIn_" << indNum
-            << "(t), h.hints_" << indNum << ");\n";
-        out << "return make_range(iterator_" << indNum << "(r.begin()), iterator_" << indNum
-            << "(r.end()));\n";
+        // use the more efficient find() method if the search pattern is full
+        if (indSize == arity) {
+            out << "auto pos = ind_" << indNum << ".find(t, h.hints_" << indNum << ");\n";
+            out << "auto fin = ind_" << indNum << ".end();\n";
+            out << "if (pos != fin) {fin = pos; ++fin;}\n";
+            out << "return make_range(pos, fin);\n";
+        } else {
+            // generate lower and upper bounds for range search
+            out << "t_tuple low(t); t_tuple high(t);\n";
+            // check which indices to pad out
+            for (size_t column = 0; column < arity; column++) {
+                // if bit number column is set
+                if (!((search >> column) & 1)) {
+                    out << "low[" << column << "] = MIN_RAM_DOMAIN;\n";
+                    out << "high[" << column << "] = MAX_RAM_DOMAIN;\n";
+                }
+            }
+            out << "return make_range(ind_" << indNum << ".lower_bound(low, h.hints_" << indNum << "), ind_"
+                << indNum << ".upper_bound(high, h.hints_" << indNum << "));\n";
+        }
         out << "}\n";
 
-        out << "range<iterator_" << indNum << "> equalRange_" << search;
+        out << "range<t_ind_" << indNum << "::iterator> equalRange_" << search;
         out << "(const t_tuple& t) const {\n";
-        out << "context h; return equalRange_" << search << "(t, h);\n";
+        out << "context h;\n";
+        out << "return equalRange_" << search << "(t, h);\n";
+        out << "}\n";
+    }
+
+    // lowerUpperBound methods for range queries on the indexed search patterns;
+    // the caller provides fully padded lower and upper bound tuples
+    for (int64_t search : getMinIndexSelection().getSearches()) {
+        auto lexOrder = getMinIndexSelection().getLexOrder(search);
+        size_t indNum = indexToNumMap[lexOrder];
+
+        out << "range<t_ind_" << indNum << "::iterator> lowerUpperBound_" << search;
+        out << "(const t_tuple& low, const t_tuple& high, context& h) const {\n";
+        out << "return make_range(ind_" << indNum << ".lower_bound(low, h.hints_" << indNum << "), ind_"
+            << indNum << ".upper_bound(high, h.hints_" << indNum << "));\n";
+        out << "}\n";
+
+        out << "range<t_ind_" << indNum << "::iterator> lowerUpperBound_" << search;
+        out << "(const t_tuple& low, const t_tuple& high) const {\n";
+        out << "context h;\n";
+        out << "return lowerUpperBound_" << search << "(low, high, h);\n";
         out << "}\n";
     }
 
@@ -927,13 +1113,9 @@ void SynthesiserBrieRelation::generateTypeStruct(std::ostream& out) {
     out << "return ind_" << masterIndex << ".empty();\n";
     out << "}\n";
 
-    // partition method
+    // partition method for parallelism
     out << "std::vector<range<iterator>> partition() const {\n";
-    out << "std::vector<range<iterator>> res;\n";
-    out << "for (const auto& cur : ind_" << masterIndex << ".partition(10000)) {\n";
-    out << "    res.push_back(make_range(iterator(cur.begin()), iterator(cur.end())));\n";
-    out << "}\n";
-    out << "return res;\n";
+    out << "return ind_" << masterIndex << ".partition(400);\n";
     out << "}\n";
 
     // purge method
@@ -941,55 +1123,1010 @@ void SynthesiserBrieRelation::generateTypeStruct(std::ostream& out) {
     for (size_t i = 0; i < numIndexes; i++) {
         out << "ind_" << i << ".clear();\n";
     }
+    for (size_t i = 0; i < arity; i++) {
+        out << "columns[" << i << "].clear();\n";
+    }
     out << "}\n";
 
-    // begin and end iterators
-    out << "iterator begin() const {\n";
-    out << "return iterator_" << masterIndex << "(ind_" << masterIndex << ".begin());\n";
-    out << "}\n";
+    // getMemoryUsage method
+    out << "std::size_t getMemoryUsage() const {\n";
+    out << "std::size_t bytes = 0;\n";
+    for (size_t i = 0; i < numIndexes; i++) {
+        out << "bytes += ind_" << i << ".getMemoryUsage();\n";
+    }
+    for (size_t i = 0; i < arity; i++) {
+        out << "bytes += columns[" << i << "].getMemoryUsage();\n";
+    }
+    out << "return bytes;\n";
+    out << "}\n";
+
+    // begin and end iterators
+    out << "iterator begin() const {\n";
+    out << "return ind_" << masterIndex << ".begin();\n";
+    out << "}\n";
+
+    out << "iterator end() const {\n";
+    out << "return ind_" << masterIndex << ".end();\n";
+    out << "}\n";
+
+    // printHintStatistics method
+    out << "void printHintStatistics(std::ostream& o, const std::string prefix) const {\n";
+    for (size_t i = 0; i < numIndexes; i++) {
+        out << "const auto& stats_" << i << " = ind_" << i << ".getHintStatistics();\n";
+        out << "o << prefix << \"arity " << getArity() << " columnar b-tree index " << inds[i]
+            << ": (hits/misses/total)\\n\";\n";
+        out << "o << prefix << \"Insert: \" << stats_" << i << ".inserts.getHits() << \"/\" << stats_" << i
+            << ".inserts.getMisses() << \"/\" << stats_" << i << ".inserts.getAccesses() << \"\\n\";\n";
+        out << "o << prefix << \"Contains: \" << stats_" << i << ".contains.getHits() << \"/\" << stats_" << i
+            << ".contains.getMisses() << \"/\" << stats_" << i << ".contains.getAccesses() << \"\\n\";\n";
+        out << "o << prefix << \"Lower-bound: \" << stats_" << i
+            << ".lower_bound.getHits() << \"/\" << stats_" << i
+            << ".lower_bound.getMisses() << \"/\" << stats_" << i
+            << ".lower_bound.getAccesses() << \"\\n\";\n";
+        out << "o << prefix << \"Upper-bound: \" << stats_" << i
+            << ".upper_bound.getHits() << \"/\" << stats_" << i
+            << ".upper_bound.getMisses() << \"/\" << stats_" << i
+            << ".upper_bound.getAccesses() << \"\\n\";\n";
+    }
+    out << "}\n";
+
+    // end struct
+    out << "};\n";
+}
+
+// -------- Brie Relation --------
+
+/** Generate index set for a brie relation */
+void SynthesiserBrieRelation::computeIndices() {
+    assert(!isProvenance && "bries cannot be used with provenance");
+
+    // Generate and set indices
+    MinIndexSelection::OrderCollection inds = indices.getAllOrders();
+
+    // generate a full index if no indices exist
+    if (inds.empty()) {
+        MinIndexSelection::LexOrder fullInd(getArity());
+        std::iota(fullInd.begin(), fullInd.end(), 0);
+        inds.push_back(fullInd);
+    }
+
+    // expand all indexes to be full
+    for (auto& ind : inds) {
+        if (ind.size() != getArity()) {
+            // use a set as a cache for fast lookup
+            std::set<int> curIndexElems(ind.begin(), ind.end());
+
+            // expand index to be full
+            for (size_t i = 0; i < getArity(); i++) {
+                if (curIndexElems.find(i) == curIndexElems.end()) {
+                    ind.push_back(i);
+                }
+            }
+        }
+
+        assert(ind.size() == getArity());
+    }
+    masterIndex = 0;
+
+    computedIndices = inds;
+}
+
+/** Generate type name of a brie relation */
+std::string SynthesiserBrieRelation::getTypeName() {
+    std::stringstream res;
+    res << "t_brie_" << getArity();
+
+    for (auto& ind : getIndices()) {
+        res << "__" << join(ind, "_");
+    }
+
+    for (auto& search : getMinIndexSelection().getSearches()) {
+        res << "__" << search;
+    }
+
+    return res.str();
+}
+
+/** Generate type struct of a brie relation */
+void SynthesiserBrieRelation::generateTypeStruct(std::ostream& out) {
+    size_t arity = getArity();
+    const auto& inds = getIndices();
+    size_t numIndexes = inds.size();
+    std::map<MinIndexSelection::LexOrder, int> indexToNumMap;
+
+    // struct definition
+    out << "struct " << getTypeName() << " {\n";
+
+    // define trie structures
+    for (size_t i = 0; i < inds.size(); i++) {
+        if (i < getMinIndexSelection().getAllOrders().size()) {
+            indexToNumMap[getMinIndexSelection().getAllOrders()[i]] = i;
+        }
+        out << "using t_ind_" << i << " = Trie<" << inds[i].size() << ">;\n";
+        out << "t_ind_" << i << " ind_" << i << ";\n";
+    }
+    out << "using t_tuple = t_ind_" << masterIndex << "::entry_type;\n";
+
+    // generate auxiliary iterators that use orderOut
+    for (size_t i = 0; i < numIndexes; i++) {
+        // generate auxiliary iterators which orderOut
+        out << "class iterator_" << i << " : public std::iterator<std::forward_iterator_tag, t_tuple> {\n";
+        out << "    using nested_iterator = typename t_ind_" << i << "::iterator;\n";
+        out << "    nested_iterator nested;\n";
+        out << "    t_tuple value;\n";
+
+        out << "public:\n";
+        out << "    iterator_" << i << "() = default;\n";
+        out << "    iterator_" << i << "(const nested_iterator& iter) : nested(iter), value(orderOut_" << i
+            << "(*iter)) {}\n";
+        out << "    iterator_" << i << "(const iterator_" << i << "& other) = default;\n";
+        out << "    iterator_" << i << "& operator=(const iterator_" << i << "& other) = default;\n";
+
+        out << "    bool operator==(const iterator_" << i << "& other) const {\n";
+        out << "        return nested == other.nested;\n";
+        out << "    }\n";
+
+        out << "    bool operator!=(const iterator_" << i << "& other) const {\n";
+        out << "        return !(*this == other);\n";
+        out << "    }\n";
+
+        out << "    const t_tuple& operator*() const {\n";
+        out << "        return value;\n";
+        out << "    }\n";
+
+        out << "    const t_tuple* operator->() const {\n";
+        out << "        return &value;\n";
+        out << "    }\n";
+
+        out << "    iterator_" << i << "& operator++() {\n";
+        out << "        ++nested;\n";
+        out << "        value = orderOut_" << i << "(*nested);\n";
+        out << "        return *this;\n";
+        out << "    }\n";
+        out << "};\n";
+    }
+    out << "using iterator = iterator_" << masterIndex << ";\n";
+
+    // hints struct
+    out << "struct context {\n";
+    for (size_t i = 0; i < numIndexes; i++) {
+        out << "t_ind_" << i << "::op_context hints_" << i << ";\n";
+    }
+    out << "};\n";
+    out << "context createContext() { return context(); }\n";
+
+    // insert methods
+    out << "bool insert(const t_tuple& t) {\n";
+    out << "context h;\n";
+    out << "return insert(t, h);\n";
+    out << "}\n";
+
+    out << "bool insert(const t_tuple& t, context& h) {\n";
+    out << "if (ind_" << masterIndex << ".insert(orderIn_" << masterIndex << "(t), h.hints_" << masterIndex
+        << ")) {\n";
+    for (size_t i = 0; i < numIndexes; i++) {
+        if (i != masterIndex) {
+            out << "ind_" << i << ".insert(orderIn_" << i << "(t), h.hints_" << i << ");\n";
+        }
+    }
+    out << "return true;\n";
+    out << "} else return false;\n";
+    out << "}\n";
+
+    out << "bool insert(const RamDomain* ramDomain) {\n";
+    out << "RamDomain data[" << arity << "];\n";
+    out << "std::copy(ramDomain, ramDomain + " << arity << ", data);\n";
+    out << "const t_tuple& tuple = reinterpret_cast<const t_tuple&>(data);\n";
+    out << "context h;\n";
+    out << "return insert(tuple, h);\n";
+    out << "}\n";
+
+    // insertAll method
+    out << "template <typename T>\n";
+    out << "void insertAll(T& other) {\n";
+    out << "for (auto const& cur : other) {\n";
+    out << "insert(cur);\n";
+    out << "}\n";
+    out << "}\n";
+
+    // insertAll using the index method
+    out << "void insertAll(" << getTypeName() << "& other) {\n";
+    for (size_t i = 0; i < numIndexes; i++) {
+        out << "ind_" << i << ".insertAll(other.ind_" << i << ");\n";
+    }
+    out << "}\n";
+
+    // insert method
+    std::vector<std::string> decls, params;
+    for (size_t i = 0; i < arity; i++) {
+        decls.push_back("RamDomain a" + std::to_string(i));
+        params.push_back("a" + std::to_string(i));
+    }
+    out << "bool insert(" << join(decls, ",") << ") {\nRamDomain data[";
+    out << arity << "] = {" << join(params, ",") << "};\n";
+    out << "return insert(data);\n";
+    out << "}\n";
+
+    // contains methods
+    out << "bool contains(const t_tuple& t, context& h) const {\n";
+    out << "return ind_" << masterIndex << ".contains(orderIn_" << masterIndex << "(t), h.hints_"
+        << masterIndex << ");\n";
+    out << "}\n";
+
+    out << "bool contains(const t_tuple& t) const {\n";
+    out << "context h;\n";
+    out << "return contains(t, h);\n";
+    out << "}\n";
+
+    // batched probe, permuting the keys once and sharing one trie context
+    out << "void containsBatch(const t_tuple* ts, std::size_t count, bool* result) const {\n";
+    out << "std::vector<t_tuple> keys(count);\n";
+    out << "for (std::size_t i = 0; i < count; ++i) {\n";
+    out << "keys[i] = orderIn_" << masterIndex << "(ts[i]);\n";
+    out << "}\n";
+    out << "ind_" << masterIndex << ".containsBatch(keys.data(), count, result);\n";
+    out << "}\n";
+
+    // size method
+    out << "std::size_t size() const {\n";
+    out << "return ind_" << masterIndex << ".size();\n";
+    out << "}\n";
+
+    // find methods
+    if (arity > 1) {
+        out << "iterator find(const t_tuple& t, context& h) const {\n";
+        out << "return ind_" << masterIndex << ".find(orderIn_" << masterIndex << "(t), h.hints_"
+            << masterIndex << ");\n";
+        out << "}\n";
+
+        out << "iterator find(const t_tuple& t) const {\n";
+        out << "context h;\n";
+        out << "return find(t, h);\n";
+        out << "}\n";
+    }
+
+    // empty equalRange method
+    out << "range<iterator> equalRange_0(const t_tuple& t, context& h) const {\n";
+    out << "return range<iterator>(ind_" << masterIndex << ".begin(),ind_" << masterIndex << ".end());\n";
+    out << "}\n";
+
+    out << "range<iterator> equalRange_0(const t_tuple& t) const {\n";
+    out << "return range<iterator>(ind_" << masterIndex << ".begin(),ind_" << masterIndex << ".end());\n";
+    out << "}\n";
+
+    // equalRange methods
+    for (int64_t search : getMinIndexSelection().getSearches()) {
+        auto lexOrder = getMinIndexSelection().getLexOrder(search);
+        size_t indNum = indexToNumMap[lexOrder];
+
+        out << "range<iterator_" << indNum << "> equalRange_" << search;
+        out << "(const t_tuple& t, context& h) const {\n";
+
+        // compute size of sub-index
+        size_t indSize = 0;
+        for (size_t i = 0; i < arity; i++) {
+            if ((search >> i) & 1) {
+                indSize++;
+            }
+        }
+
+        out << "auto r = ind_" << indNum << ".template getBoundaries<" << indSize << ">(orderIn_" << indNum
+            << "(t), h.hints_" << indNum << ");\n";
+        out << "return make_range(iterator_" << indNum << "(r.begin()), iterator_" << indNum
+            << "(r.end()));\n";
+        out << "}\n";
+
+        out << "range<iterator_" << indNum << "> equalRange_" << search;
+        out << "(const t_tuple& t) const {\n";
+        out << "context h; return equalRange_" << search << "(t, h);\n";
+        out << "}\n";
+    }
+
+    // empty method
+    out << "bool empty() const {\n";
+    out << "return ind_" << masterIndex << ".empty();\n";
+    out << "}\n";
+
+    // partition method
+    out << "std::vector<range<iterator>> partition() const {\n";
+    out << "std::vector<range<iterator>> res;\n";
+    out << "for (const auto& cur : ind_" << masterIndex << ".partition(10000)) {\n";
+    out << "    res.push_back(make_range(iterator(cur.begin()), iterator(cur.end())));\n";
+    out << "}\n";
+    out << "return res;\n";
+    out << "}\n";
+
+    // purge method
+    out << "void purge() {\n";
+    for (size_t i = 0; i < numIndexes; i++) {
+        out << "ind_" << i << ".clear();\n";
+    }
+    out << "}\n";
+
+    // getMemoryUsage method
+    out << "std::size_t getMemoryUsage() const {\n";
+    out << "return ";
+    for (size_t i = 0; i < numIndexes; i++) {
+        out << (i > 0 ? " + " : "") << "ind_" << i << ".getMemoryUsage()";
+    }
+    out << ";\n";
+    out << "}\n";
+
+    // begin and end iterators
+    out << "iterator begin() const {\n";
+    out << "return iterator_" << masterIndex << "(ind_" << masterIndex << ".begin());\n";
+    out << "}\n";
+
+    out << "iterator end() const {\n";
+    out << "return iterator_" << masterIndex << "(ind_" << masterIndex << ".end());\n";
+    out << "}\n";
+
+    // TODO: finish printHintStatistics method
+    out << "void printHintStatistics(std::ostream& o, const std::string prefix) const {\n";
+    for (size_t i = 0; i < numIndexes; i++) {
+        out << "const auto& stats_" << i << " = ind_" << i << ".getHintStatistics();\n";
+        out << "o << prefix << \"arity " << arity << " brie index " << inds[i]
+            << ": (hits/misses/total)\\n\";\n";
+        out << "o << prefix << \"Insert: \" << stats_" << i << ".inserts.getHits() << \"/\" << stats_" << i
+            << ".inserts.getMisses() << \"/\" << stats_" << i << ".inserts.getAccesses() << \"\\n\";\n";
+        out << "o << prefix << \"Contains: \" << stats_" << i << ".contains.getHits() << \"/\" << stats_" << i
+            << ".contains.getMisses() << \"/\" << stats_" << i << ".contains.getAccesses() << \"\\n\";\n";
+        out << "o << prefix << \"Range-query: \" << stats_" << i
+            << ".get_boundaries.getHits() << \"/\" << stats_" << i
+            << ".get_boundaries.getMisses() << \"/\" << stats_" << i
+            << ".get_boundaries.getAccesses() << \"\\n\";\n";
+    }
+    out << "}\n";
+
+    // orderOut and orderIn methods for reordering tuples according to index orders
+    for (size_t i = 0; i < numIndexes; i++) {
+        auto ind = inds[i];
+        out << "static t_tuple orderIn_" << i << "(const t_tuple& t) {\n";
+        out << "t_tuple res;\n";
+        for (size_t j = 0; j < ind.size(); j++) {
+            out << "res[" << j << "] = t[" << ind[j] << "];\n";
+        }
+        out << "return res;\n";
+        out << "}\n";
+
+        out << "static t_tuple orderOut_" << i << "(const t_tuple& t) {\n";
+        out << "t_tuple res;\n";
+        for (size_t j = 0; j < ind.size(); j++) {
+            out << "res[" << ind[j] << "] = t[" << j << "];\n";
+        }
+        out << "return res;\n";
+        out << "}\n";
+    }
+
+    // end class
+    out << "};\n";
+}
+
+// -------- Bitset Relation --------
+
+/** Generate index set for a bitset relation */
+void SynthesiserBitsetRelation::computeIndices() {
+    assert(!isProvenance && "bitset relations cannot be used with provenance");
+    assert(getArity() == 1 && "bitset relations must be unary");
+
+    masterIndex = 0;
+    computedIndices = {{0}};
+}
+
+/** Generate type name of a bitset relation */
+std::string SynthesiserBitsetRelation::getTypeName() {
+    return "t_bitset";
+}
+
+/** Generate type struct of a bitset relation.
+ * Each non-negative value of the dense ordinal domain is represented by
+ * a single bit, providing O(1) insert and contains and word-at-a-time
+ * iteration. */
+void SynthesiserBitsetRelation::generateTypeStruct(std::ostream& out) {
+    // struct definition
+    out << "struct " << getTypeName() << " {\n";
+
+    out << "using t_tuple = Tuple<RamDomain, 1>;\n";
+    out << "static constexpr std::size_t BITS = 64;\n";
+
+    // bit v % BITS of words[v / BITS] represents the value v; the lock
+    // serialises concurrent inserts
+    out << "std::vector<uint64_t> words;\n";
+    out << "std::size_t count = 0;\n";
+    out << "Lock insert_lock;\n";
+
+    // iterator scanning the bitset word at a time
+    out << "class iterator : public std::iterator<std::forward_iterator_tag, t_tuple> {\n";
+    out << "    const std::vector<uint64_t>* words = nullptr;\n";
+    out << "    std::size_t word = 0;\n";
+    out << "    uint64_t bits = 0;\n";
+    out << "    t_tuple value;\n";
+
+    out << "public:\n";
+    out << "    iterator() = default;\n";
+    out << "    iterator(const std::vector<uint64_t>& words, std::size_t word)\n";
+    out << "            : iterator(words, word, word < words.size() ? words[word] : 0) {}\n";
+    out << "    iterator(const std::vector<uint64_t>& words, std::size_t word, uint64_t bits)\n";
+    out << "            : words(&words), word(word), bits(bits) {\n";
+    out << "        advance();\n";
+    out << "    }\n";
+    out << "    iterator(const iterator& other) = default;\n";
+    out << "    iterator& operator=(const iterator& other) = default;\n";
+
+    out << "    bool operator==(const iterator& other) const {\n";
+    out << "        return word == other.word && bits == other.bits;\n";
+    out << "    }\n";
+
+    out << "    bool operator!=(const iterator& other) const {\n";
+    out << "        return !(*this == other);\n";
+    out << "    }\n";
+
+    out << "    const t_tuple& operator*() const {\n";
+    out << "        return value;\n";
+    out << "    }\n";
+
+    out << "    const t_tuple* operator->() const {\n";
+    out << "        return &value;\n";
+    out << "    }\n";
+
+    out << "    iterator& operator++() {\n";
+    out << "        bits &= bits - 1;\n";
+    out << "        advance();\n";
+    out << "        return *this;\n";
+    out << "    }\n";
+
+    out << "private:\n";
+    out << "    void advance() {\n";
+    out << "        while (bits == 0 && word + 1 < words->size()) {\n";
+    out << "            bits = (*words)[++word];\n";
+    out << "        }\n";
+    out << "        if (bits == 0) {\n";
+    out << "            word = words->size();\n";
+    out << "        } else {\n";
+    out << "            value[0] = static_cast<RamDomain>(word * BITS + __builtin_ctzll(bits));\n";
+    out << "        }\n";
+    out << "    }\n";
+    out << "};\n";
+
+    // the iterator positioned at the first value >= v
+    out << "iterator find_ge(int64_t v) const {\n";
+    out << "if (v < 0) v = 0;\n";
+    out << "std::size_t word = static_cast<std::size_t>(v) / BITS;\n";
+    out << "if (word >= words.size()) return end();\n";
+    out << "return iterator(words, word, words[word] & (~uint64_t(0) << (v % BITS)));\n";
+    out << "}\n";
+
+    // no hints are required for a bitset
+    out << "struct context {\n";
+    out << "};\n";
+    out << "context createContext() { return context(); }\n";
+
+    // insert methods
+    out << "bool insert(const t_tuple& t) {\n";
+    out << "assert(t[0] >= 0 && \"bitset relations require non-negative values\");\n";
+    out << "auto lease = insert_lock.acquire();\n";
+    out << "(void)lease;\n";
+    out << "std::size_t word = static_cast<std::size_t>(t[0]) / BITS;\n";
+    out << "if (word >= words.size()) words.resize(word + 1, 0);\n";
+    out << "uint64_t mask = uint64_t(1) << (static_cast<std::size_t>(t[0]) % BITS);\n";
+    out << "if ((words[word] & mask) != 0) return false;\n";
+    out << "words[word] |= mask;\n";
+    out << "++count;\n";
+    out << "return true;\n";
+    out << "}\n";
+
+    out << "bool insert(const t_tuple& t, context& h) {\n";
+    out << "return insert(t);\n";
+    out << "}\n";
+
+    out << "bool insert(const RamDomain* ramDomain) {\n";
+    out << "const t_tuple& tuple = reinterpret_cast<const t_tuple&>(*ramDomain);\n";
+    out << "return insert(tuple);\n";
+    out << "}\n";
+
+    out << "bool insert(RamDomain a0) {\n";
+    out << "RamDomain data[1] = {a0};\n";
+    out << "return insert(data);\n";
+    out << "}\n";
+
+    // insertAll method
+    out << "template <typename T>\n";
+    out << "void insertAll(T& other) {\n";
+    out << "for (auto const& cur : other) {\n";
+    out << "insert(cur);\n";
+    out << "}\n";
+    out << "}\n";
+
+    // contains methods
+    out << "bool contains(const t_tuple& t) const {\n";
+    out << "if (t[0] < 0) return false;\n";
+    out << "std::size_t word = static_cast<std::size_t>(t[0]) / BITS;\n";
+    out << "return word < words.size() && (words[word] & (uint64_t(1) << (static_cast<std::size_t>(t[0]) % "
+           "BITS))) != 0;\n";
+    out << "}\n";
+
+    out << "bool contains(const t_tuple& t, context& h) const {\n";
+    out << "return contains(t);\n";
+    out << "}\n";
+
+    // size method
+    out << "std::size_t size() const {\n";
+    out << "return count;\n";
+    out << "}\n";
+
+    // find methods
+    out << "iterator find(const t_tuple& t) const {\n";
+    out << "return contains(t) ? find_ge(t[0]) : end();\n";
+    out << "}\n";
+
+    out << "iterator find(const t_tuple& t, context& h) const {\n";
+    out << "return find(t);\n";
+    out << "}\n";
+
+    // empty equalRange method
+    out << "range<iterator> equalRange_0(const t_tuple& t, context& h) const {\n";
+    out << "return make_range(begin(), end());\n";
+    out << "}\n";
+
+    out << "range<iterator> equalRange_0(const t_tuple& t) const {\n";
+    out << "return make_range(begin(), end());\n";
+    out << "}\n";
+
+    // equalRange method for the only possible search pattern
+    out << "range<iterator> equalRange_1(const t_tuple& t, context& h) const {\n";
+    out << "auto pos = find(t);\n";
+    out << "auto fin = end();\n";
+    out << "if (pos != fin) {fin = pos; ++fin;}\n";
+    out << "return make_range(pos, fin);\n";
+    out << "}\n";
+
+    out << "range<iterator> equalRange_1(const t_tuple& t) const {\n";
+    out << "context h;\n";
+    out << "return equalRange_1(t, h);\n";
+    out << "}\n";
+
+    // lowerUpperBound method for range queries;
+    // the caller provides inclusive lower and upper bounds
+    out << "range<iterator> lowerUpperBound_1(const t_tuple& low, const t_tuple& high, context& h) const {\n";
+    out << "return make_range(find_ge(low[0]), find_ge(static_cast<int64_t>(high[0]) + 1));\n";
+    out << "}\n";
+
+    out << "range<iterator> lowerUpperBound_1(const t_tuple& low, const t_tuple& high) const {\n";
+    out << "context h;\n";
+    out << "return lowerUpperBound_1(low, high, h);\n";
+    out << "}\n";
+
+    // empty method
+    out << "bool empty() const {\n";
+    out << "return count == 0;\n";
+    out << "}\n";
+
+    // partition method; word-aligned boundaries keep the chunks disjoint
+    out << "std::vector<range<iterator>> partition() const {\n";
+    out << "std::vector<range<iterator>> res;\n";
+    out << "std::size_t n = words.size();\n";
+    out << "std::size_t step = n / 400 + 1;\n";
+    out << "for (std::size_t w = 0; w < n; w += step) {\n";
+    out << "res.push_back(make_range(iterator(words, w), iterator(words, std::min(w + step, n))));\n";
+    out << "}\n";
+    out << "if (res.empty()) res.push_back(make_range(begin(), end()));\n";
+    out << "return res;\n";
+    out << "}\n";
+
+    // purge method
+    out << "void purge() {\n";
+    out << "words.clear();\n";
+    out << "count = 0;\n";
+    out << "}\n";
+
+    // getMemoryUsage method
+    out << "std::size_t getMemoryUsage() const {\n";
+    out << "return sizeof(*this) + words.capacity() * sizeof(uint64_t);\n";
+    out << "}\n";
+
+    // begin and end iterators
+    out << "iterator begin() const {\n";
+    out << "return iterator(words, 0);\n";
+    out << "}\n";
 
     out << "iterator end() const {\n";
-    out << "return iterator_" << masterIndex << "(ind_" << masterIndex << ".end());\n";
+    out << "return iterator(words, words.size());\n";
     out << "}\n";
 
-    // TODO: finish printHintStatistics method
+    // printHintStatistics method
     out << "void printHintStatistics(std::ostream& o, const std::string prefix) const {\n";
-    for (size_t i = 0; i < numIndexes; i++) {
-        out << "const auto& stats_" << i << " = ind_" << i << ".getHintStatistics();\n";
-        out << "o << prefix << \"arity " << arity << " brie index " << inds[i]
-            << ": (hits/misses/total)\\n\";\n";
-        out << "o << prefix << \"Insert: \" << stats_" << i << ".inserts.getHits() << \"/\" << stats_" << i
-            << ".inserts.getMisses() << \"/\" << stats_" << i << ".inserts.getAccesses() << \"\\n\";\n";
-        out << "o << prefix << \"Contains: \" << stats_" << i << ".contains.getHits() << \"/\" << stats_" << i
-            << ".contains.getMisses() << \"/\" << stats_" << i << ".contains.getAccesses() << \"\\n\";\n";
-        out << "o << prefix << \"Range-query: \" << stats_" << i
-            << ".get_boundaries.getHits() << \"/\" << stats_" << i
-            << ".get_boundaries.getMisses() << \"/\" << stats_" << i
-            << ".get_boundaries.getAccesses() << \"\\n\";\n";
+    out << "o << \"bitset index: no hint statistics supported\\n\";\n";
+    out << "}\n";
+
+    // end struct
+    out << "};\n";
+}
+
+// -------- Grouped Relation --------
+
+/** Generate index set for a grouped relation */
+void SynthesiserGroupedRelation::computeIndices() {
+    assert(!isProvenance && "grouped relations cannot be used with provenance");
+    assert(getArity() >= 2 && "grouped relations require a key and a grouped attribute");
+
+    // a single conceptual index: the key column followed by the sorted
+    // remaining columns in attribute order
+    MinIndexSelection::LexOrder fullInd(getArity());
+    std::iota(fullInd.begin(), fullInd.end(), 0);
+
+    masterIndex = 0;
+    computedIndices = {fullInd};
+}
+
+/** Generate type name of a grouped relation */
+std::string SynthesiserGroupedRelation::getTypeName() {
+    std::stringstream res;
+    res << "t_grouped_" << getArity();
+
+    for (auto& search : getMinIndexSelection().getSearches()) {
+        res << "__" << search;
+    }
+
+    return res.str();
+}
+
+/** Generate type struct of a grouped relation.
+ * A hash map takes the first attribute to the list of remaining columns
+ * of all tuples sharing it, so a scan bound on the key is a pointer-bump
+ * iteration over one compact list. Inserts merely append; the pending
+ * tail of each list is sorted, merged and deduplicated on the next
+ * query, keeping bulk insertion at a push_back per tuple even for keys
+ * of high fanout. */
+void SynthesiserGroupedRelation::generateTypeStruct(std::ostream& out) {
+    const size_t arity = getArity();
+    const size_t suffixArity = arity - 1;
+
+    // struct definition
+    out << "struct " << getTypeName() << " {\n";
+
+    out << "using t_tuple = Tuple<RamDomain, " << arity << ">;\n";
+    out << "using t_suffix = Tuple<RamDomain, " << suffixArity << ">;\n";
+
+    // a group: the remaining columns of all tuples sharing a key; the
+    // sorted marker separates the ordered prefix from the pending tail
+    out << "struct t_group {\n";
+    out << "std::vector<t_suffix> data;\n";
+    out << "std::size_t sorted = 0;\n";
+    out << "};\n";
+    out << "using t_map = std::unordered_map<RamDomain, t_group>;\n";
+
+    // queries flush pending tails, so the containers are mutable; the
+    // lock serialises inserts and the flush
+    out << "mutable t_map groups;\n";
+    out << "mutable std::size_t tuples = 0;\n";
+    out << "mutable std::atomic<bool> dirty{false};\n";
+    out << "mutable Lock access_lock;\n";
+
+    // strip the key column off a tuple
+    out << "static t_suffix suffixOf(const t_tuple& t) {\n";
+    out << "t_suffix s;\n";
+    for (size_t i = 0; i < suffixArity; i++) {
+        out << "s[" << i << "] = t[" << i + 1 << "];\n";
+    }
+    out << "return s;\n";
+    out << "}\n";
+
+    // sort, merge and deduplicate the pending tail of every group; the
+    // double check keeps concurrent readers off the lock once clean
+    out << "void flush() const {\n";
+    out << "if (!dirty.load(std::memory_order_acquire)) return;\n";
+    out << "auto lease = access_lock.acquire();\n";
+    out << "(void)lease;\n";
+    out << "if (!dirty.load(std::memory_order_acquire)) return;\n";
+    out << "tuples = 0;\n";
+    out << "for (auto& cur : groups) {\n";
+    out << "auto& d = cur.second.data;\n";
+    out << "if (cur.second.sorted < d.size()) {\n";
+    out << "std::sort(d.begin() + cur.second.sorted, d.end());\n";
+    out << "std::inplace_merge(d.begin(), d.begin() + cur.second.sorted, d.end());\n";
+    out << "d.erase(std::unique(d.begin(), d.end()), d.end());\n";
+    out << "cur.second.sorted = d.size();\n";
+    out << "}\n";
+    out << "tuples += d.size();\n";
+    out << "}\n";
+    out << "dirty.store(false, std::memory_order_release);\n";
+    out << "}\n";
+
+    // iterator over all groups, materializing full tuples
+    out << "class iterator : public std::iterator<std::forward_iterator_tag, t_tuple> {\n";
+    out << "    using group_iterator = t_map::const_iterator;\n";
+    out << "    group_iterator cur;\n";
+    out << "    group_iterator fin;\n";
+    out << "    std::size_t idx = 0;\n";
+    out << "    t_tuple value;\n";
+
+    out << "public:\n";
+    out << "    iterator() = default;\n";
+    out << "    iterator(group_iterator cur, group_iterator fin, std::size_t idx = 0)\n";
+    out << "            : cur(cur), fin(fin), idx(idx) {\n";
+    out << "        load();\n";
+    out << "    }\n";
+    out << "    iterator(const iterator& other) = default;\n";
+    out << "    iterator& operator=(const iterator& other) = default;\n";
+
+    out << "    bool operator==(const iterator& other) const {\n";
+    out << "        return cur == other.cur && idx == other.idx;\n";
+    out << "    }\n";
+
+    out << "    bool operator!=(const iterator& other) const {\n";
+    out << "        return !(*this == other);\n";
+    out << "    }\n";
+
+    out << "    const t_tuple& operator*() const {\n";
+    out << "        return value;\n";
+    out << "    }\n";
+
+    out << "    const t_tuple* operator->() const {\n";
+    out << "        return &value;\n";
+    out << "    }\n";
+
+    out << "    iterator& operator++() {\n";
+    out << "        if (++idx >= cur->second.data.size()) {\n";
+    out << "            ++cur;\n";
+    out << "            idx = 0;\n";
+    out << "        }\n";
+    out << "        load();\n";
+    out << "        return *this;\n";
+    out << "    }\n";
+
+    out << "private:\n";
+    out << "    void load() {\n";
+    out << "        if (cur == fin) return;\n";
+    out << "        value[0] = cur->first;\n";
+    out << "        const t_suffix& s = cur->second.data[idx];\n";
+    for (size_t i = 0; i < suffixArity; i++) {
+        out << "        value[" << i + 1 << "] = s[" << i << "];\n";
+    }
+    out << "    }\n";
+    out << "};\n";
+
+    // iterator over one group: a pointer bump through its list
+    out << "class elem_iterator : public std::iterator<std::forward_iterator_tag, t_tuple> {\n";
+    out << "    const t_suffix* ptr = nullptr;\n";
+    out << "    const t_suffix* stop = nullptr;\n";
+    out << "    t_tuple value;\n";
+
+    out << "public:\n";
+    out << "    elem_iterator() = default;\n";
+    out << "    elem_iterator(RamDomain key, const t_suffix* ptr, const t_suffix* stop)\n";
+    out << "            : ptr(ptr), stop(stop) {\n";
+    out << "        value[0] = key;\n";
+    out << "        load();\n";
+    out << "    }\n";
+    out << "    elem_iterator(const elem_iterator& other) = default;\n";
+    out << "    elem_iterator& operator=(const elem_iterator& other) = default;\n";
+
+    out << "    bool operator==(const elem_iterator& other) const {\n";
+    out << "        return ptr == other.ptr;\n";
+    out << "    }\n";
+
+    out << "    bool operator!=(const elem_iterator& other) const {\n";
+    out << "        return !(*this == other);\n";
+    out << "    }\n";
+
+    out << "    const t_tuple& operator*() const {\n";
+    out << "        return value;\n";
+    out << "    }\n";
+
+    out << "    const t_tuple* operator->() const {\n";
+    out << "        return &value;\n";
+    out << "    }\n";
+
+    out << "    elem_iterator& operator++() {\n";
+    out << "        ++ptr;\n";
+    out << "        load();\n";
+    out << "        return *this;\n";
+    out << "    }\n";
+
+    out << "private:\n";
+    out << "    void load() {\n";
+    out << "        if (ptr == stop) return;\n";
+    for (size_t i = 0; i < suffixArity; i++) {
+        out << "        value[" << i + 1 << "] = (*ptr)[" << i << "];\n";
     }
+    out << "    }\n";
+    out << "};\n";
+
+    // no hints are required for a hash map
+    out << "struct context {\n";
+    out << "};\n";
+    out << "context createContext() { return context(); }\n";
+
+    // insert methods; duplicates are kept until the next flush discards
+    // them, so insertion is a hash probe and a push_back
+    out << "bool insert(const t_tuple& t) {\n";
+    out << "auto lease = access_lock.acquire();\n";
+    out << "(void)lease;\n";
+    out << "groups[t[0]].data.push_back(suffixOf(t));\n";
+    out << "dirty.store(true, std::memory_order_release);\n";
+    out << "return true;\n";
     out << "}\n";
 
-    // orderOut and orderIn methods for reordering tuples according to index orders
-    for (size_t i = 0; i < numIndexes; i++) {
-        auto ind = inds[i];
-        out << "static t_tuple orderIn_" << i << "(const t_tuple& t) {\n";
-        out << "t_tuple res;\n";
-        for (size_t j = 0; j < ind.size(); j++) {
-            out << "res[" << j << "] = t[" << ind[j] << "];\n";
+    out << "bool insert(const t_tuple& t, context& h) {\n";
+    out << "return insert(t);\n";
+    out << "}\n";
+
+    out << "bool insert(const RamDomain* ramDomain) {\n";
+    out << "RamDomain data[" << arity << "];\n";
+    out << "std::copy(ramDomain, ramDomain + " << arity << ", data);\n";
+    out << "const t_tuple& tuple = reinterpret_cast<const t_tuple&>(data);\n";
+    out << "return insert(tuple);\n";
+    out << "}\n";
+
+    std::vector<std::string> decls, params;
+    for (size_t i = 0; i < arity; i++) {
+        decls.push_back("RamDomain a" + std::to_string(i));
+        params.push_back("a" + std::to_string(i));
+    }
+    out << "bool insert(" << join(decls, ",") << ") {\nRamDomain data[";
+    out << arity << "] = {" << join(params, ",") << "};\n";
+    out << "return insert(data);\n";
+    out << "}\n";
+
+    // insertAll method
+    out << "template <typename T>\n";
+    out << "void insertAll(T& other) {\n";
+    out << "for (auto const& cur : other) {\n";
+    out << "insert(cur);\n";
+    out << "}\n";
+    out << "}\n";
+
+    // contains methods
+    out << "bool contains(const t_tuple& t) const {\n";
+    out << "flush();\n";
+    out << "auto group = groups.find(t[0]);\n";
+    out << "if (group == groups.end()) return false;\n";
+    out << "const auto& d = group->second.data;\n";
+    out << "return std::binary_search(d.begin(), d.end(), suffixOf(t));\n";
+    out << "}\n";
+
+    out << "bool contains(const t_tuple& t, context& h) const {\n";
+    out << "return contains(t);\n";
+    out << "}\n";
+
+    // size method
+    out << "std::size_t size() const {\n";
+    out << "flush();\n";
+    out << "return tuples;\n";
+    out << "}\n";
+
+    // find methods
+    out << "iterator find(const t_tuple& t) const {\n";
+    out << "flush();\n";
+    out << "auto group = groups.find(t[0]);\n";
+    out << "if (group == groups.end()) return end();\n";
+    out << "const auto& d = group->second.data;\n";
+    out << "const t_suffix s = suffixOf(t);\n";
+    out << "auto pos = std::lower_bound(d.begin(), d.end(), s);\n";
+    out << "if (pos == d.end() || !(*pos == s)) return end();\n";
+    out << "return iterator(group, groups.end(), pos - d.begin());\n";
+    out << "}\n";
+
+    out << "iterator find(const t_tuple& t, context& h) const {\n";
+    out << "return find(t);\n";
+    out << "}\n";
+
+    // empty equalRange method
+    out << "range<iterator> equalRange_0(const t_tuple& t, context& h) const {\n";
+    out << "return make_range(begin(), end());\n";
+    out << "}\n";
+
+    out << "range<iterator> equalRange_0(const t_tuple& t) const {\n";
+    out << "return make_range(begin(), end());\n";
+    out << "}\n";
+
+    // comparators on the leading suffix columns used by the prefix
+    // searches below
+    std::set<size_t> boundSuffixLengths;
+    for (auto search : getMinIndexSelection().getSearches()) {
+        size_t keyColumns = static_cast<size_t>(__builtin_popcountll(search));
+        if (keyColumns > 1 && keyColumns < arity) {
+            boundSuffixLengths.insert(keyColumns - 1);
         }
-        out << "return res;\n";
+    }
+    for (size_t len : boundSuffixLengths) {
+        out << "static bool prefixLess_" << len << "(const t_suffix& a, const t_suffix& b) {\n";
+        for (size_t i = 0; i < len; i++) {
+            out << "if (a[" << i << "] < b[" << i << "]) return true;\n";
+            out << "if (b[" << i << "] < a[" << i << "]) return false;\n";
+        }
+        out << "return false;\n";
         out << "}\n";
+    }
 
-        out << "static t_tuple orderOut_" << i << "(const t_tuple& t) {\n";
-        out << "t_tuple res;\n";
-        for (size_t j = 0; j < ind.size(); j++) {
-            out << "res[" << ind[j] << "] = t[" << j << "];\n";
+    // equalRange methods; every search is bound on a prefix of the
+    // attribute list, so each maps to one contiguous slice of one group
+    for (auto search : getMinIndexSelection().getSearches()) {
+        const size_t keyColumns = static_cast<size_t>(__builtin_popcountll(search));
+        assert((search & (search + 1)) == 0 && "grouped relations serve prefix searches only");
+
+        out << "range<elem_iterator> equalRange_" << search;
+        out << "(const t_tuple& t, context& h) const {\n";
+        out << "flush();\n";
+        out << "auto group = groups.find(t[0]);\n";
+        out << "if (group == groups.end()) return make_range(elem_iterator(), elem_iterator());\n";
+        out << "const auto& d = group->second.data;\n";
+        if (keyColumns == 1) {
+            out << "return make_range(elem_iterator(t[0], d.data(), d.data() + d.size()),\n";
+            out << "elem_iterator(t[0], d.data() + d.size(), d.data() + d.size()));\n";
+        } else {
+            out << "const t_suffix s = suffixOf(t);\n";
+            if (keyColumns == arity) {
+                out << "auto r = std::equal_range(d.data(), d.data() + d.size(), s);\n";
+            } else {
+                out << "auto r = std::equal_range(d.data(), d.data() + d.size(), s, prefixLess_"
+                    << keyColumns - 1 << ");\n";
+            }
+            out << "return make_range(elem_iterator(t[0], r.first, r.second),\n";
+            out << "elem_iterator(t[0], r.second, r.second));\n";
         }
-        out << "return res;\n";
+        out << "}\n";
+
+        out << "range<elem_iterator> equalRange_" << search;
+        out << "(const t_tuple& t) const {\n";
+        out << "context h; return equalRange_" << search << "(t, h);\n";
         out << "}\n";
     }
 
-    // end class
+    // empty method
+    out << "bool empty() const {\n";
+    out << "flush();\n";
+    out << "return tuples == 0;\n";
+    out << "}\n";
+
+    // partition method splitting at group boundaries
+    out << "std::vector<range<iterator>> partition() const {\n";
+    out << "flush();\n";
+    out << "std::vector<range<iterator>> res;\n";
+    out << "std::size_t step = groups.size() / 400 + 1;\n";
+    out << "auto cur = groups.begin();\n";
+    out << "while (cur != groups.end()) {\n";
+    out << "auto next = cur;\n";
+    out << "for (std::size_t i = 0; i < step && next != groups.end(); i++) ++next;\n";
+    out << "res.push_back(make_range(iterator(cur, groups.end()), iterator(next, groups.end())));\n";
+    out << "cur = next;\n";
+    out << "}\n";
+    out << "if (res.empty()) res.push_back(make_range(end(), end()));\n";
+    out << "return res;\n";
+    out << "}\n";
+
+    // purge method
+    out << "void purge() {\n";
+    out << "groups.clear();\n";
+    out << "tuples = 0;\n";
+    out << "dirty.store(false, std::memory_order_release);\n";
+    out << "}\n";
+
+    // getMemoryUsage method
+    out << "std::size_t getMemoryUsage() const {\n";
+    out << "std::size_t res = sizeof(*this) + groups.size() * (sizeof(RamDomain) + sizeof(t_group));\n";
+    out << "for (const auto& cur : groups) {\n";
+    out << "res += cur.second.data.capacity() * sizeof(t_suffix);\n";
+    out << "}\n";
+    out << "return res;\n";
+    out << "}\n";
+
+    // begin and end iterators
+    out << "iterator begin() const {\n";
+    out << "flush();\n";
+    out << "return iterator(groups.begin(), groups.end());\n";
+    out << "}\n";
+
+    out << "iterator end() const {\n";
+    out << "return iterator(groups.end(), groups.end());\n";
+    out << "}\n";
+
+    // printHintStatistics method
+    out << "void printHintStatistics(std::ostream& o, const std::string prefix) const {\n";
+    out << "o << \"grouped index: no hint statistics supported\\n\";\n";
+    out << "}\n";
+
+    // end struct
     out << "};\n";
 }
 
@@ -1143,8 +2280,15 @@ void SynthesiserEqrelRelation::generateTypeStruct(std::ostream& out) {
                 indSize++;
             }
         }
-        out << "auto r = ind_" << masterIndex << ".template getBoundaries<" << indSize << ">(orderIn_"
-            << masterIndex << "(t), h.hints_" << masterIndex << ");\n";
+        if (i == 2) {
+            // binding only the posterior column enumerates the members of the bound
+            // element's equivalence class through the posterior iterator
+            out << "auto r = make_range(ind_" << masterIndex << ".posteriorIt(orderIn_" << masterIndex
+                << "(t)[1]), ind_" << masterIndex << ".end());\n";
+        } else {
+            out << "auto r = ind_" << masterIndex << ".template getBoundaries<" << indSize << ">(orderIn_"
+                << masterIndex << "(t), h.hints_" << masterIndex << ");\n";
+        }
         out << "return make_range(iterator(r.begin()), iterator(r.end()));\n";
         out << "}\n";
 
@@ -1175,6 +2319,15 @@ void SynthesiserEqrelRelation::generateTypeStruct(std::ostream& out) {
     }
     out << "}\n";
 
+    // getMemoryUsage method
+    out << "std::size_t getMemoryUsage() const {\n";
+    out << "return ";
+    for (size_t i = 0; i < numIndexes; i++) {
+        out << (i > 0 ? " + " : "") << "ind_" << i << ".getMemoryUsage()";
+    }
+    out << ";\n";
+    out << "}\n";
+
     // begin and end iterators
     out << "iterator begin() const {\n";
     out << "return iterator_" << masterIndex << "(ind_" << masterIndex << ".begin());\n";
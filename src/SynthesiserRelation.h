@@ -11,6 +11,7 @@
 #include "RamIndexAnalysis.h"
 #include "RamRelation.h"
 
+#include <algorithm>
 #include <memory>
 #include <ostream>
 #include <string>
@@ -55,6 +56,27 @@ public:
         return relation;
     }
 
+    /**
+     * The leaf-node block size, in bytes, of the b-tree indices of this
+     * relation.
+     *
+     * The b-tree default of 256 bytes leaves wide tuples with a tiny
+     * fan-out and correspondingly deep trees. Leaves are therefore sized
+     * to hold a fixed number of keys; the temporary delta and
+     * new-knowledge relations of fixpoints, which are rebuilt every
+     * iteration, settle for half of that to keep insertions cheap.
+     */
+    size_t getBTreeBlockSize() const {
+        const size_t keyBytes = getArity() * sizeof(RamDomain);
+        const size_t keysPerNode = relation.isTemp() ? 16 : 32;
+        return std::max<size_t>(256, keysPerNode * keyBytes);
+    }
+
+    /** Whether the generated type offers a batched containsBatch probe */
+    virtual bool hasBatchedContains() const {
+        return false;
+    }
+
     /** Print type name */
     virtual std::string getTypeName() = 0;
 
@@ -101,6 +123,10 @@ public:
     SynthesiserDirectRelation(const RamRelation& ramRel, const MinIndexSelection& indexSet, bool isProvenance)
             : SynthesiserRelation(ramRel, indexSet, isProvenance) {}
 
+    bool hasBatchedContains() const override {
+        return true;
+    }
+
     void computeIndices() override;
     std::string getTypeName() override;
     void generateTypeStruct(std::ostream& out) override;
@@ -117,11 +143,46 @@ public:
     void generateTypeStruct(std::ostream& out) override;
 };
 
+class SynthesiserColumnarRelation : public SynthesiserRelation {
+public:
+    SynthesiserColumnarRelation(
+            const RamRelation& ramRel, const MinIndexSelection& indexSet, bool isProvenance)
+            : SynthesiserRelation(ramRel, indexSet, isProvenance) {}
+
+    void computeIndices() override;
+    std::string getTypeName() override;
+    void generateTypeStruct(std::ostream& out) override;
+};
+
 class SynthesiserBrieRelation : public SynthesiserRelation {
 public:
     SynthesiserBrieRelation(const RamRelation& ramRel, const MinIndexSelection& indexSet, bool isProvenance)
             : SynthesiserRelation(ramRel, indexSet, isProvenance) {}
 
+    bool hasBatchedContains() const override {
+        return true;
+    }
+
+    void computeIndices() override;
+    std::string getTypeName() override;
+    void generateTypeStruct(std::ostream& out) override;
+};
+
+class SynthesiserBitsetRelation : public SynthesiserRelation {
+public:
+    SynthesiserBitsetRelation(const RamRelation& ramRel, const MinIndexSelection& indexSet, bool isProvenance)
+            : SynthesiserRelation(ramRel, indexSet, isProvenance) {}
+
+    void computeIndices() override;
+    std::string getTypeName() override;
+    void generateTypeStruct(std::ostream& out) override;
+};
+
+class SynthesiserGroupedRelation : public SynthesiserRelation {
+public:
+    SynthesiserGroupedRelation(const RamRelation& ramRel, const MinIndexSelection& indexSet, bool isProvenance)
+            : SynthesiserRelation(ramRel, indexSet, isProvenance) {}
+
     void computeIndices() override;
     std::string getTypeName() override;
     void generateTypeStruct(std::ostream& out) override;
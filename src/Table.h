@@ -11,12 +11,16 @@
  * @file Table.h
  *
  * An implementation of a generic Table storing a position-fixed collection
- * of objects in main memory.
+ * of objects in main memory. Blocks are carved from an arena pool, such
+ * that large tables benefit from huge-page backing and are released in
+ * near constant time when cleared.
  *
  ***********************************************************************/
 
 #pragma once
 
+#include "MemoryPool.h"
+
 #include <iterator>
 
 namespace souffle {
@@ -47,6 +51,9 @@ class Table {
 
     std::size_t count = 0;
 
+    // the pool all blocks of this table are carved from
+    MemoryPool pool;
+
 public:
     class iterator : public std::iterator<std::forward_iterator_tag, T> {
         Block* block;
@@ -101,16 +108,20 @@ public:
         return count;
     }
 
+    std::size_t getMemoryUsage() const {
+        return sizeof(*this) + pool.getMemoryUsage();
+    }
+
     const T& insert(const T& element) {
         // check whether the head is initialized
         if (!head) {
-            head = new Block();
+            head = new (pool.allocate(sizeof(Block))) Block();
             tail = head;
         }
 
         // check whether tail is full
         if (tail->isFull()) {
-            tail->next = new Block();
+            tail->next = new (pool.allocate(sizeof(Block))) Block();
             tail = tail->next;
         }
 
@@ -130,11 +141,14 @@ public:
     }
 
     void clear() {
+        // invoke the destructors of the blocks, then release their memory
+        // wholesale through the pool
         while (head != nullptr) {
             auto cur = head;
             head = head->next;
-            delete cur;
+            cur->~Block();
         }
+        pool.reset();
         count = 0;
         head = nullptr;
         tail = nullptr;
@@ -76,6 +76,11 @@ public:
         return sz;
     };
 
+    /** @return the number of bytes held by the underlying node storage */
+    std::size_t getMemoryUsage() const {
+        return a_blocks.getMemoryUsage();
+    }
+
     /**
      * Yield reference to the node by its node index
      * @param node node to be searched
@@ -88,24 +93,45 @@ public:
 
     /**
      * Equivalent to the find() function in union/find
-     * Find the highest ancestor of the provided node - flattening as we go
+     * Find the highest ancestor of the provided node, fully compressing the
+     * visited path to point at the root
      * @param x the node to find the parent of, whilst flattening its set-tree
      * @return The parent of x
      */
     parent_t findNode(parent_t x) {
-        // while x's parent is not itself
-        while (x != b2p(get(x))) {
+        // first pass - locate the root of x's tree
+        parent_t root = x;
+        while (root != b2p(get(root))) {
+            root = b2p(get(root));
+        }
+
+        // second pass - repoint every node on the visited path directly at the root
+        // a failed update signals a concurrent union or compression, and is simply
+        // skipped; the node that raced us points at an ancestor either way
+        while (x != root) {
             block_t xState = get(x);
-            // yield x's parent's parent
-            parent_t newParent = b2p(get(b2p(xState)));
-            // construct block out of the original rank and the new parent
-            block_t newState = pr2b(newParent, b2r(xState));
+            parent_t next = b2p(xState);
+            if (next == root) break;
 
-            this->get(x).compare_exchange_strong(xState, newState);
+            this->get(x).compare_exchange_strong(xState, pr2b(root, b2r(xState)));
 
-            x = newParent;
+            x = next;
         }
-        return x;
+        return root;
+    }
+
+    /**
+     * Points every node directly at the root of its tree, in parallel, such
+     * that all subsequent finds complete in constant time. Intended to run
+     * between the insertion phase and a read-heavy phase.
+     */
+    void flatten() {
+        size_t dSetSize = a_blocks.size();
+        PARALLEL_START;
+        pfor(size_t i = 0; i < dSetSize; ++i) {
+            findNode(i);
+        }
+        PARALLEL_END;
     }
 
 private:
@@ -185,6 +211,40 @@ public:
         }
     }
 
+    /**
+     * Union the two specified index nodes, assuming the caller holds
+     * exclusive access to the forest. Links the lower-ranked root under the
+     * higher-ranked one with plain stores, skipping the retry loop and the
+     * compare-and-swap traffic of unionNodes(). Intended for bulk merges of
+     * whole forests (e.g. merging the delta of one equivalence relation into
+     * another between semi-naive iterations), where no concurrent mutation
+     * can occur.
+     * @param x node to be unioned
+     * @param y node to be unioned
+     * @return the root of the combined tree
+     */
+    parent_t unionNodesExclusive(parent_t x, parent_t y) {
+        x = findNode(x);
+        y = findNode(y);
+
+        // no need to union if both already in same set
+        if (x == y) return x;
+
+        rank_t xrank = b2r(get(x));
+        rank_t yrank = b2r(get(y));
+
+        // if x comes before y (better rank or earlier & equal node)
+        if (xrank > yrank || ((xrank == yrank) && x > y)) {
+            std::swap(x, y);
+            std::swap(xrank, yrank);
+        }
+        // no competing updates - link the trees with unconditional stores
+        get(x).store(pr2b(y, xrank), std::memory_order_relaxed);
+        // make sure that the ranks are orderable
+        if (xrank == yrank) get(y).store(pr2b(y, yrank + 1), std::memory_order_relaxed);
+        return y;
+    }
+
     /**
      * Create a node with its parent as itself, rank 0
      * @return the newly created block
@@ -321,10 +381,26 @@ public:
         ds.unionNodes(toDense(x), toDense(y));
     };
 
+    /* union the nodes without synchronisation; the caller must hold exclusive access */
+    inline void unionNodesExclusive(SparseDomain x, SparseDomain y) {
+        ds.unionNodesExclusive(toDense(x), toDense(y));
+    };
+
+    /* compress all paths in the underlying disjoint set, making future finds constant-time */
+    inline void flatten() {
+        ds.flatten();
+    };
+
     inline std::size_t size() {
         return ds.size();
     };
 
+    /** @return the number of bytes held by the disjoint set and both direction mappings */
+    std::size_t getMemoryUsage() const {
+        return ds.getMemoryUsage() + sparseToDenseMap.getMemoryUsage() +
+               denseToSparseMap.getMemoryUsage();
+    }
+
     /**
      * Remove all elements from this disjoint set
      */
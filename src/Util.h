@@ -1363,6 +1363,65 @@ public:
     }
 };
 
+// a specialization for a two-entry cache distinguishing a hot and a cold
+// entry; bimodal access patterns alternating between two locations are
+// covered without the linked-list bookkeeping of the generic case
+template <typename T>
+class LRUCache<T, 2> {
+    // the most recently accessed entry
+    T hot;
+
+    // the entry accessed before the hot one
+    T cold;
+
+public:
+    // creates a new, empty cache
+    LRUCache() : hot(), cold() {}
+
+    // creates a new, empty cache storing the given value
+    LRUCache(const T& val) : hot(val), cold(val) {}
+
+    // clears the content of this cache
+    void clear(const T& val = T()) {
+        hot = val;
+        cold = val;
+    }
+
+    // registers an access to the given element
+    void access(const T& val) {
+        if (val == hot) {
+            return;
+        }
+        // demote the hot entry; covers both the promotion of the cold
+        // entry and the eviction of the least recently used one
+        cold = hot;
+        hot = val;
+    }
+
+    /**
+     * See description in most general case.
+     */
+    template <typename Op>
+    bool forEachInOrder(const Op& op) const {
+        if (op(hot)) {
+            return true;
+        }
+        return op(cold);
+    }
+
+    // equivalent to forEachInOrder
+    template <typename Op>
+    bool any(const Op& op) const {
+        return forEachInOrder(op);
+    }
+
+    // --- print support ---
+
+    friend std::ostream& operator<<(std::ostream& out, const LRUCache& cache) {
+        return out << cache.hot << "," << cache.cold;
+    }
+};
+
 // a specialization for no-entry caches.
 template <typename T>
 class LRUCache<T, 0> {
@@ -1413,6 +1472,40 @@ inline bool isHintsProfilingEnabled() {
     return std::getenv("SOUFFLE_PROFILE_HINTS");
 }
 
+#ifdef NDEBUG
+
+/**
+ * In release builds the hint statistics are compiled out entirely; the
+ * hint maintenance on the hot paths must not pay for bookkeeping that
+ * is never reported.
+ */
+class CacheAccessCounter {
+public:
+    CacheAccessCounter(bool = false) {}
+
+    CacheAccessCounter(const CacheAccessCounter&) {}
+
+    void addHit() {}
+
+    void addMiss() {}
+
+    std::size_t getHits() const {
+        return 0;
+    }
+
+    std::size_t getMisses() const {
+        return 0;
+    }
+
+    std::size_t getAccesses() const {
+        return 0;
+    }
+
+    void reset() {}
+};
+
+#else
+
 /**
  * A utility class to keep track of cache hits/misses.
  */
@@ -1457,4 +1550,6 @@ public:
     }
 };
 
+#endif  // NDEBUG
+
 }  // end namespace souffle
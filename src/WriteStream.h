@@ -15,10 +15,19 @@
 #pragma once
 
 #include "IODirectives.h"
+#include "ParallelUtils.h"
 #include "RamTypes.h"
 #include "SymbolTable.h"
 
+#include <algorithm>
 #include <cassert>
+#include <cstdlib>
+#include <iterator>
+#include <memory>
+#include <ostream>
+#include <random>
+#include <sstream>
+#include <stdexcept>
 #include <string>
 #include <vector>
 
@@ -29,7 +38,44 @@ public:
     WriteStream(const std::vector<bool>& symbolMask, const SymbolTable& symbolTable, const bool prov,
             bool summary = false)
             : symbolMask(symbolMask), symbolTable(symbolTable), isProvenance(prov), summary(summary),
-              arity(symbolMask.size() - (prov ? 2 : 0)) {}
+              arity(symbolMask.size() - (prov ? 1 : 0)) {}
+
+    /**
+     * This constructor additionally parses the output-bounding directives
+     * 'limit', 'sample', 'top' and 'sort'; writers passing their IO
+     * directives here thus support bounded output.
+     */
+    WriteStream(const std::vector<bool>& symbolMask, const SymbolTable& symbolTable,
+            const IODirectives& ioDirectives, const bool prov, bool summary = false)
+            : WriteStream(symbolMask, symbolTable, prov, summary) {
+        if (ioDirectives.has("limit")) {
+            limitCount = std::stoul(ioDirectives.get("limit"));
+        }
+        if (ioDirectives.has("sample")) {
+            sampleCount = std::stoul(ioDirectives.get("sample"));
+        }
+        if (ioDirectives.has("top")) {
+            topCount = std::stoul(ioDirectives.get("top"));
+        }
+        if (ioDirectives.has("sort")) {
+            std::stringstream columns(ioDirectives.get("sort"));
+            std::string column;
+            while (std::getline(columns, column, ',')) {
+                const int col = std::stoi(column);
+                if (col == 0 || static_cast<std::size_t>(std::abs(col)) > arity) {
+                    throw std::invalid_argument("sort column <" + column + "> is out of range");
+                }
+                sortColumns.push_back(col);
+            }
+        }
+        // the default top-k order is the lexicographical order over all columns
+        if (topCount > 0 && sortColumns.empty()) {
+            for (std::size_t col = 1; col <= arity; ++col) {
+                sortColumns.push_back(static_cast<int>(col));
+            }
+        }
+    }
+
     template <typename T>
     void writeAll(const T& relation) {
         if (summary) {
@@ -43,6 +89,20 @@ public:
             }
             return;
         }
+        if (limitCount > 0 || sampleCount > 0 || topCount > 0) {
+            // bounded output bypasses the parallel paths; it emits at
+            // most max(limit, sample, top) tuples anyway
+            writeBounded(relation);
+            return;
+        }
+        if (getNumShards() > 1) {
+            writeSharded(relation, 0);
+            return;
+        }
+        if (MAX_THREADS > 1 && getOrderedStream() != nullptr) {
+            writeOrdered(relation, *getOrderedStream(), 0);
+            return;
+        }
         for (const auto& current : relation) {
             writeNext(current);
         }
@@ -60,6 +120,14 @@ protected:
     const bool isProvenance;
     const bool summary;
     const size_t arity;
+    /** Maximum number of tuples to emit; 0 leaves the output unbounded */
+    std::size_t limitCount = 0;
+    /** Size of the uniform sample emitted instead of the full relation */
+    std::size_t sampleCount = 0;
+    /** Number of leading tuples in sort order to emit */
+    std::size_t topCount = 0;
+    /** Sort key of the top-k output: 1-based column numbers, negative for descending order */
+    std::vector<int> sortColumns;
 
     virtual void writeNullary() = 0;
     virtual void writeNextTuple(const RamDomain* tuple) = 0;
@@ -70,6 +138,243 @@ protected:
     void writeNext(const Tuple tuple) {
         writeNextTuple(tuple.data);
     }
+
+    /**
+     * The number of output shards of this writer; single-file writers
+     * report 0 and emit through writeNextTuple directly.
+     */
+    virtual std::size_t getNumShards() const {
+        return 0;
+    }
+
+    /**
+     * Creates the writer emitting the shard with the given index.
+     */
+    virtual std::unique_ptr<WriteStream> getShardWriter(std::size_t) {
+        return nullptr;
+    }
+
+    /**
+     * The output stream of this writer if its output is a plain byte
+     * stream of formatted tuples; returning it enables the ordered
+     * parallel path, which formats partitions of the relation into
+     * buffers concurrently and concatenates them in key order, producing
+     * the same bytes as the sequential loop. Writers with per-tuple side
+     * effects report nullptr and are written sequentially.
+     */
+    virtual std::ostream* getOrderedStream() {
+        return nullptr;
+    }
+
+    /**
+     * Formats the given tuple into the given buffer; invoked concurrently
+     * by the ordered parallel path and must thus not touch writer state.
+     */
+    virtual void writeNextTuple(std::ostream&, const RamDomain*) const {
+        assert(false && "writer does not support buffered formatting");
+    }
+
+private:
+    /**
+     * Distributes the partitions of the given relation over the shard
+     * writers, formatting and writing all shards in parallel. Relations
+     * without a partitioning interface are written sequentially.
+     */
+    template <typename T>
+    auto writeSharded(const T& relation, int) -> decltype(relation.partitionScan(std::size_t(0)), void()) {
+        writePartitions(relation.partitionScan(getNumShards()));
+    }
+    template <typename T>
+    auto writeSharded(const T& relation, long) -> decltype(relation.partition(), void()) {
+        writePartitions(relation.partition());
+    }
+    template <typename T>
+    void writeSharded(const T& relation, ...) {
+        for (const auto& current : relation) {
+            writeNext(current);
+        }
+    }
+
+    /**
+     * Writes the given relation through the ordered parallel path: its
+     * partitions are formatted into one buffer each in parallel and the
+     * buffers are appended to the output stream in partition order, which
+     * coincides with the iteration order of the relation. Relations
+     * without a partitioning interface are written sequentially.
+     */
+    template <typename T>
+    auto writeOrdered(const T& relation, std::ostream& destination, int)
+            -> decltype(relation.partitionScan(std::size_t(0)), void()) {
+        writeOrderedPartitions(relation.partitionScan(NUM_WORK_CHUNKS(0)), destination);
+    }
+    template <typename T>
+    auto writeOrdered(const T& relation, std::ostream& destination, long)
+            -> decltype(relation.partition(), void()) {
+        writeOrderedPartitions(relation.partition(), destination);
+    }
+    template <typename T>
+    void writeOrdered(const T& relation, std::ostream&, ...) {
+        for (const auto& current : relation) {
+            writeNext(current);
+        }
+    }
+
+    template <typename Partitions>
+    void writeOrderedPartitions(Partitions&& partitions, std::ostream& destination) {
+        auto first = partitions.begin();
+        auto numParts = static_cast<std::size_t>(std::distance(partitions.begin(), partitions.end()));
+        std::vector<std::string> buffers(numParts);
+        PARALLEL_START;
+        pfor(std::size_t part = 0; part < numParts; ++part) {
+            std::ostringstream buffer;
+            for (const auto& current : *(first + part)) {
+                writeNextTuple(buffer, getTupleBase(current, 0));
+            }
+            buffers[part] = buffer.str();
+        }
+        PARALLEL_END;
+        for (const auto& buffer : buffers) {
+            destination.write(buffer.data(), static_cast<std::streamsize>(buffer.size()));
+        }
+    }
+
+    template <typename Partitions>
+    void writePartitions(Partitions&& partitions) {
+        auto first = partitions.begin();
+        auto numParts = static_cast<std::size_t>(std::distance(partitions.begin(), partitions.end()));
+        auto numShards = std::min(getNumShards(), std::max<std::size_t>(numParts, 1));
+        PARALLEL_START;
+        pfor(std::size_t shard = 0; shard < numShards; ++shard) {
+            auto writer = getShardWriter(shard);
+            auto from = first + (numParts * shard) / numShards;
+            auto to = first + (numParts * (shard + 1)) / numShards;
+            for (auto it = from; it != to; ++it) {
+                for (const auto& current : *it) {
+                    writer->writeNextTuple(getTupleBase(current, 0));
+                }
+            }
+        }
+        PARALLEL_END;
+    }
+
+    /**
+     * Writes the relation under the output-bounding directives: 'top'
+     * retains the k first tuples in sort order, 'sample' a uniform sample,
+     * and 'limit' cuts the output after the first tuples; memory stays
+     * proportional to the bound.
+     */
+    template <typename T>
+    void writeBounded(const T& relation) {
+        if (topCount > 0) {
+            writeTopK(relation);
+            return;
+        }
+        if (sampleCount > 0) {
+            writeSample(relation);
+            return;
+        }
+        std::size_t seen = 0;
+        for (const auto& current : relation) {
+            if (seen++ == limitCount) {
+                break;
+            }
+            writeNext(current);
+        }
+    }
+
+    /**
+     * Writes the k first tuples of the relation in the order of the sort
+     * columns; the candidates are retained in a heap of size k holding
+     * the weakest of them on top, so a scan over the full relation costs
+     * one comparison against the heap top per non-qualifying tuple.
+     */
+    template <typename T>
+    void writeTopK(const T& relation) {
+        auto weaker = [&](const std::vector<RamDomain>& a, const std::vector<RamDomain>& b) {
+            return precedes(a.data(), b.data());
+        };
+        std::vector<std::vector<RamDomain>> heap;
+        heap.reserve(topCount + 1);
+        for (const auto& current : relation) {
+            const RamDomain* tuple = getTupleBase(current, 0);
+            if (heap.size() == topCount && !precedes(tuple, heap.front().data())) {
+                continue;
+            }
+            heap.emplace_back(tuple, tuple + symbolMask.size());
+            std::push_heap(heap.begin(), heap.end(), weaker);
+            if (heap.size() > topCount) {
+                std::pop_heap(heap.begin(), heap.end(), weaker);
+                heap.pop_back();
+            }
+        }
+        std::sort_heap(heap.begin(), heap.end(), weaker);
+        for (const auto& tuple : heap) {
+            writeNextTuple(tuple.data());
+        }
+    }
+
+    /**
+     * Writes a uniform sample of the relation maintained by reservoir
+     * sampling; the generator is seeded with the sample size, so repeated
+     * runs over the same relation emit the same sample.
+     */
+    template <typename T>
+    void writeSample(const T& relation) {
+        std::vector<std::vector<RamDomain>> reservoir;
+        reservoir.reserve(sampleCount);
+        std::mt19937_64 generator(sampleCount);
+        std::size_t seen = 0;
+        for (const auto& current : relation) {
+            const RamDomain* tuple = getTupleBase(current, 0);
+            if (reservoir.size() < sampleCount) {
+                reservoir.emplace_back(tuple, tuple + symbolMask.size());
+            } else {
+                std::uniform_int_distribution<std::size_t> replace(0, seen);
+                const std::size_t slot = replace(generator);
+                if (slot < sampleCount) {
+                    reservoir[slot].assign(tuple, tuple + symbolMask.size());
+                }
+            }
+            ++seen;
+        }
+        for (const auto& tuple : reservoir) {
+            writeNextTuple(tuple.data());
+        }
+    }
+
+    /**
+     * Determines whether tuple a is emitted before tuple b under the
+     * configured sort columns; numeric columns compare by value, symbol
+     * columns by their symbol text.
+     */
+    bool precedes(const RamDomain* a, const RamDomain* b) const {
+        for (const int column : sortColumns) {
+            const auto col = static_cast<std::size_t>(std::abs(column)) - 1;
+            int cmp;
+            if (symbolMask.at(col)) {
+                cmp = symbolTable.unsafeResolve(a[col]).compare(symbolTable.unsafeResolve(b[col]));
+            } else {
+                cmp = (a[col] > b[col]) - (a[col] < b[col]);
+            }
+            if (cmp != 0) {
+                return column < 0 ? cmp > 0 : cmp < 0;
+            }
+        }
+        return false;
+    }
+
+    // obtains the raw component array of the differently shaped tuple types
+    template <typename Tuple>
+    static auto getTupleBase(const Tuple& tuple, int) -> decltype(tuple.getBase()) {
+        return tuple.getBase();
+    }
+    template <typename Tuple>
+    static auto getTupleBase(const Tuple& tuple, long) -> decltype(&tuple.data[0]) {
+        return &tuple.data[0];
+    }
+    static const RamDomain* getTupleBase(const RamDomain* tuple, int) {
+        return tuple;
+    }
 };
 
 class WriteStreamFactory {
@@ -0,0 +1,130 @@
+/*
+ * Souffle - A Datalog Compiler
+ * Copyright (c) 2013, 2014, Oracle and/or its affiliates. All rights reserved
+ * Licensed under the Universal Permissive License v 1.0 as shown at:
+ * - https://opensource.org/licenses/UPL
+ * - <souffle root>/licenses/SOUFFLE-UPL.txt
+ */
+
+/************************************************************************
+ *
+ * @file WriteStreamBinary.h
+ *
+ * A writer for the native binary relation format, avoiding the text
+ * formatting costs of CSV for intermediate relation hand-offs. A file
+ * consists of a fixed header, the packed array of RamDomain tuples and
+ * a trailing symbol-table segment; symbol columns are remapped to
+ * file-local dense indices so files remain valid across runs.
+ *
+ ***********************************************************************/
+
+#pragma once
+
+#include "IODirectives.h"
+#include "RamTypes.h"
+#include "SymbolTable.h"
+#include "WriteStream.h"
+
+#include <cstdint>
+#include <fstream>
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace souffle {
+
+/**
+ * The fixed-size header preceding the tuple array of a binary relation
+ * file, shared between reader and writer.
+ */
+struct BinaryRelationHeader {
+    // 'S' 'B' 'R' 'L' -- souffle binary relation
+    static const uint32_t MAGIC = 0x4c524253;
+    static const uint32_t VERSION = 1;
+
+    uint32_t magic = MAGIC;
+    uint32_t version = VERSION;
+    uint32_t domainSize = sizeof(RamDomain);
+    uint32_t width = 0;
+    uint64_t numTuples = 0;
+    uint64_t numSymbols = 0;
+};
+
+class WriteFileBinary : public WriteStream {
+public:
+    WriteFileBinary(const std::vector<bool>& symbolMask, const SymbolTable& symbolTable,
+            const IODirectives& ioDirectives, const bool provenance = false)
+            : WriteStream(symbolMask, symbolTable, ioDirectives, provenance),
+              file(ioDirectives.getFileName(), std::ios::out | std::ios::binary) {
+        header.width = symbolMask.size();
+        // reserve space for the header; it is patched with the final
+        // counts once all tuples have been written
+        file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    }
+
+    ~WriteFileBinary() override {
+        // append the symbol-table segment
+        for (const auto& symbol : symbols) {
+            uint32_t length = symbol.size();
+            file.write(reinterpret_cast<const char*>(&length), sizeof(length));
+            file.write(symbol.data(), length);
+        }
+        // patch the header
+        file.seekp(0, std::ios::beg);
+        file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    }
+
+protected:
+    void writeNullary() override {
+        ++header.numTuples;
+    }
+
+    void writeNextTuple(const RamDomain* tuple) override {
+        std::vector<RamDomain> encoded(tuple, tuple + header.width);
+        for (uint32_t col = 0; col < header.width; ++col) {
+            if (symbolMask.at(col)) {
+                encoded[col] = encodeSymbol(tuple[col]);
+            }
+        }
+        file.write(reinterpret_cast<const char*>(encoded.data()), header.width * sizeof(RamDomain));
+        ++header.numTuples;
+    }
+
+    /**
+     * Maps a symbol-table index to its file-local dense index,
+     * registering the symbol on its first occurrence.
+     */
+    RamDomain encodeSymbol(RamDomain symbol) {
+        auto pos = encoding.find(symbol);
+        if (pos != encoding.end()) {
+            return pos->second;
+        }
+        RamDomain index = symbols.size();
+        symbols.emplace_back(symbolTable.unsafeResolve(symbol));
+        encoding[symbol] = index;
+        ++header.numSymbols;
+        return index;
+    }
+
+    BinaryRelationHeader header;
+    std::ofstream file;
+    std::map<RamDomain, RamDomain> encoding;
+    std::vector<std::string> symbols;
+};
+
+class WriteFileBinaryFactory : public WriteStreamFactory {
+public:
+    std::unique_ptr<WriteStream> getWriter(const std::vector<bool>& symbolMask,
+            const SymbolTable& symbolTable, const IODirectives& ioDirectives,
+            const bool provenance) override {
+        return std::make_unique<WriteFileBinary>(symbolMask, symbolTable, ioDirectives, provenance);
+    }
+    const std::string& getName() const override {
+        static const std::string name = "binary";
+        return name;
+    }
+    ~WriteFileBinaryFactory() override = default;
+};
+
+} /* namespace souffle */
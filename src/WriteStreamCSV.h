@@ -21,12 +21,17 @@
 #ifdef USE_LIBZ
 #include "gzfstream.h"
 #endif
+#ifdef USE_LIBZSTD
+#include "zstdfstream.h"
+#endif
 
 #include <cassert>
 #include <fstream>
 #include <memory>
 #include <ostream>
 #include <string>
+#include <unordered_map>
+#include <vector>
 
 namespace souffle {
 
@@ -44,7 +49,8 @@ class WriteFileCSV : public WriteStreamCSV, public WriteStream {
 public:
     WriteFileCSV(const std::vector<bool>& symbolMask, const SymbolTable& symbolTable,
             const IODirectives& ioDirectives, const bool provenance = false)
-            : WriteStream(symbolMask, symbolTable, provenance), delimiter(getDelimiter(ioDirectives)),
+            : WriteStream(symbolMask, symbolTable, ioDirectives, provenance),
+              delimiter(getDelimiter(ioDirectives)),
               file(ioDirectives.getFileName(), std::ios::out | std::ios::binary) {
         if (ioDirectives.has("headers") && ioDirectives.get("headers") == "true") {
             file << ioDirectives.get("attributeNames") << std::endl;
@@ -62,20 +68,28 @@ protected:
     }
 
     void writeNextTuple(const RamDomain* tuple) override {
+        writeNextTuple(file, tuple);
+    }
+
+    std::ostream* getOrderedStream() override {
+        return &file;
+    }
+
+    void writeNextTuple(std::ostream& destination, const RamDomain* tuple) const override {
         if (symbolMask.at(0)) {
-            file << symbolTable.unsafeResolve(tuple[0]);
+            destination << symbolTable.unsafeResolve(tuple[0]);
         } else {
-            file << tuple[0];
+            destination << tuple[0];
         }
         for (size_t col = 1; col < arity; ++col) {
-            file << delimiter;
+            destination << delimiter;
             if (symbolMask.at(col)) {
-                file << symbolTable.unsafeResolve(tuple[col]);
+                destination << symbolTable.unsafeResolve(tuple[col]);
             } else {
-                file << tuple[col];
+                destination << tuple[col];
             }
         }
-        file << "\n";
+        destination << "\n";
     }
 };
 
@@ -84,7 +98,8 @@ class WriteGZipFileCSV : public WriteStreamCSV, public WriteStream {
 public:
     WriteGZipFileCSV(const std::vector<bool>& symbolMask, const SymbolTable& symbolTable,
             const IODirectives& ioDirectives, const bool provenance = false)
-            : WriteStream(symbolMask, symbolTable, provenance), delimiter(getDelimiter(ioDirectives)),
+            : WriteStream(symbolMask, symbolTable, ioDirectives, provenance),
+              delimiter(getDelimiter(ioDirectives)),
               file(ioDirectives.getFileName(), std::ios::out | std::ios::binary) {
         if (ioDirectives.has("headers") && ioDirectives.get("headers") == "true") {
             file << ioDirectives.get("attributeNames") << std::endl;
@@ -93,6 +108,124 @@ public:
 
     ~WriteGZipFileCSV() override = default;
 
+protected:
+    void writeNullary() override {
+        file << "()\n";
+    }
+
+    void writeNextTuple(const RamDomain* tuple) override {
+        writeNextTuple(file, tuple);
+    }
+
+    std::ostream* getOrderedStream() override {
+        return &file;
+    }
+
+    void writeNextTuple(std::ostream& destination, const RamDomain* tuple) const override {
+        if (symbolMask.at(0)) {
+            destination << symbolTable.unsafeResolve(tuple[0]);
+        } else {
+            destination << tuple[0];
+        }
+        for (size_t col = 1; col < arity; ++col) {
+            destination << delimiter;
+            if (symbolMask.at(col)) {
+                destination << symbolTable.unsafeResolve(tuple[col]);
+            } else {
+                destination << tuple[col];
+            }
+        }
+        destination << "\n";
+    }
+
+    const std::string delimiter;
+    gzfstream::ogzfstream file;
+};
+#endif
+
+#ifdef USE_LIBZSTD
+class WriteZstdFileCSV : public WriteStreamCSV, public WriteStream {
+public:
+    WriteZstdFileCSV(const std::vector<bool>& symbolMask, const SymbolTable& symbolTable,
+            const IODirectives& ioDirectives, const bool provenance = false)
+            : WriteStream(symbolMask, symbolTable, ioDirectives, provenance),
+              delimiter(getDelimiter(ioDirectives)),
+              file(ioDirectives.getFileName(), std::ios::out | std::ios::binary) {
+        if (ioDirectives.has("headers") && ioDirectives.get("headers") == "true") {
+            file << ioDirectives.get("attributeNames") << std::endl;
+        }
+    }
+
+    ~WriteZstdFileCSV() override = default;
+
+protected:
+    void writeNullary() override {
+        file << "()\n";
+    }
+
+    void writeNextTuple(const RamDomain* tuple) override {
+        writeNextTuple(file, tuple);
+    }
+
+    std::ostream* getOrderedStream() override {
+        return &file;
+    }
+
+    void writeNextTuple(std::ostream& destination, const RamDomain* tuple) const override {
+        if (symbolMask.at(0)) {
+            destination << symbolTable.unsafeResolve(tuple[0]);
+        } else {
+            destination << tuple[0];
+        }
+        for (size_t col = 1; col < arity; ++col) {
+            destination << delimiter;
+            if (symbolMask.at(col)) {
+                destination << symbolTable.unsafeResolve(tuple[col]);
+            } else {
+                destination << tuple[col];
+            }
+        }
+        destination << "\n";
+    }
+
+    const std::string delimiter;
+    zstdfstream::ozstdfstream file;
+};
+#endif
+
+/**
+ * A writer emitting symbol columns as dictionary ordinals. Each distinct
+ * symbol receives a dense ordinal on first use and is written once to a
+ * sidecar file "<name>.dict" holding one symbol per line in ordinal
+ * order; the tuples carry the ordinals only. Relations repeating long
+ * symbols across many tuples shrink by roughly the average symbol
+ * length, and reloading resolves each distinct symbol exactly once.
+ * Requested via the IO directive 'dictionary=true' and read back by
+ * ReadStreamCSV under the same directive.
+ *
+ * Ordinal assignment is stateful, so this writer stays off the parallel
+ * formatting path.
+ */
+class WriteDictFileCSV : public WriteStreamCSV, public WriteStream {
+public:
+    WriteDictFileCSV(const std::vector<bool>& symbolMask, const SymbolTable& symbolTable,
+            const IODirectives& ioDirectives, const bool provenance = false)
+            : WriteStream(symbolMask, symbolTable, ioDirectives, provenance),
+              delimiter(getDelimiter(ioDirectives)),
+              file(ioDirectives.getFileName(), std::ios::out | std::ios::binary),
+              dictFileName(ioDirectives.getFileName() + ".dict") {
+        if (ioDirectives.has("headers") && ioDirectives.get("headers") == "true") {
+            file << ioDirectives.get("attributeNames") << std::endl;
+        }
+    }
+
+    ~WriteDictFileCSV() override {
+        std::ofstream dictFile(dictFileName, std::ios::out | std::ios::binary);
+        for (const RamDomain symbol : symbols) {
+            dictFile << symbolTable.unsafeResolve(symbol) << "\n";
+        }
+    }
+
 protected:
     void writeNullary() override {
         file << "()\n";
@@ -100,14 +233,14 @@ protected:
 
     void writeNextTuple(const RamDomain* tuple) override {
         if (symbolMask.at(0)) {
-            file << symbolTable.unsafeResolve(tuple[0]);
+            file << ordinalOf(tuple[0]);
         } else {
             file << tuple[0];
         }
         for (size_t col = 1; col < arity; ++col) {
             file << delimiter;
             if (symbolMask.at(col)) {
-                file << symbolTable.unsafeResolve(tuple[col]);
+                file << ordinalOf(tuple[col]);
             } else {
                 file << tuple[col];
             }
@@ -115,16 +248,95 @@ protected:
         file << "\n";
     }
 
+private:
+    /** Returns the ordinal of the given symbol, assigning the next free
+     * one on its first occurrence */
+    RamDomain ordinalOf(const RamDomain symbol) {
+        auto pos = ordinals.emplace(symbol, static_cast<RamDomain>(symbols.size()));
+        if (pos.second) {
+            symbols.push_back(symbol);
+        }
+        return pos.first->second;
+    }
+
     const std::string delimiter;
-    gzfstream::ogzfstream file;
+    std::ofstream file;
+    const std::string dictFileName;
+
+    /** Assigned ordinal per symbol index */
+    std::unordered_map<RamDomain, RamDomain> ordinals;
+
+    /** Symbol indices in ordinal order, dumped to the sidecar at the end */
+    std::vector<RamDomain> symbols;
 };
+
+/**
+ * A writer distributing a relation over several CSV files written in
+ * parallel. The relation is partitioned via the underlying index
+ * structure and each shard formats and writes its share independently,
+ * producing file.0.csv, file.1.csv, ... next to the configured name.
+ * Requested via the 'shards' IO directive.
+ */
+class WriteFileShardedCSV : public WriteStreamCSV, public WriteStream {
+public:
+    WriteFileShardedCSV(const std::vector<bool>& symbolMask, const SymbolTable& symbolTable,
+            const IODirectives& ioDirectives, const bool provenance = false)
+            : WriteStream(symbolMask, symbolTable, provenance), ioDirectives(ioDirectives),
+              shards(std::stoul(ioDirectives.get("shards"))) {}
+
+    ~WriteFileShardedCSV() override = default;
+
+protected:
+    std::size_t getNumShards() const override {
+        return shards;
+    }
+
+    std::unique_ptr<WriteStream> getShardWriter(std::size_t shard) override {
+        IODirectives directives(ioDirectives);
+        directives.setFileName(getShardFileName(shard));
+#ifdef USE_LIBZSTD
+        if (directives.has("compress") && directives.get("compress") == "zstd") {
+            return std::make_unique<WriteZstdFileCSV>(symbolMask, symbolTable, directives, isProvenance);
+        }
 #endif
+#ifdef USE_LIBZ
+        if (directives.has("compress")) {
+            return std::make_unique<WriteGZipFileCSV>(symbolMask, symbolTable, directives, isProvenance);
+        }
+#endif
+        return std::make_unique<WriteFileCSV>(symbolMask, symbolTable, directives, isProvenance);
+    }
+
+    void writeNullary() override {
+        std::ofstream(ioDirectives.getFileName()) << "()\n";
+    }
+
+    void writeNextTuple(const RamDomain*) override {
+        assert(false && "sharded writers emit tuples through their shards");
+    }
+
+private:
+    /** Places the shard number in front of the file extension. */
+    std::string getShardFileName(std::size_t shard) const {
+        const std::string& name = ioDirectives.getFileName();
+        auto pos = name.rfind('.');
+        auto slash = name.rfind('/');
+        if (pos == std::string::npos || (slash != std::string::npos && slash > pos)) {
+            pos = name.size();
+        }
+        return name.substr(0, pos) + "." + std::to_string(shard) + name.substr(pos);
+    }
+
+    const IODirectives ioDirectives;
+    const std::size_t shards;
+};
 
 class WriteCoutCSV : public WriteStreamCSV, public WriteStream {
 public:
     WriteCoutCSV(const std::vector<bool>& symbolMask, const SymbolTable& symbolTable,
             const IODirectives& ioDirectives, const bool provenance = false)
-            : WriteStream(symbolMask, symbolTable, provenance), delimiter(getDelimiter(ioDirectives)) {
+            : WriteStream(symbolMask, symbolTable, ioDirectives, provenance),
+              delimiter(getDelimiter(ioDirectives)) {
         std::cout << "---------------\n" << ioDirectives.getRelationName();
         if (ioDirectives.has("headers") && ioDirectives.get("headers") == "true") {
             std::cout << "\n" << ioDirectives.get("attributeNames");
@@ -142,20 +354,28 @@ protected:
     }
 
     void writeNextTuple(const RamDomain* tuple) override {
+        writeNextTuple(std::cout, tuple);
+    }
+
+    std::ostream* getOrderedStream() override {
+        return &std::cout;
+    }
+
+    void writeNextTuple(std::ostream& destination, const RamDomain* tuple) const override {
         if (symbolMask.at(0)) {
-            std::cout << symbolTable.unsafeResolve(tuple[0]);
+            destination << symbolTable.unsafeResolve(tuple[0]);
         } else {
-            std::cout << tuple[0];
+            destination << tuple[0];
         }
         for (size_t col = 1; col < arity; ++col) {
-            std::cout << delimiter;
+            destination << delimiter;
             if (symbolMask.at(col)) {
-                std::cout << symbolTable.unsafeResolve(tuple[col]);
+                destination << symbolTable.unsafeResolve(tuple[col]);
             } else {
-                std::cout << tuple[col];
+                destination << tuple[col];
             }
         }
-        std::cout << "\n";
+        destination << "\n";
     }
 
     const std::string delimiter;
@@ -191,6 +411,19 @@ public:
     std::unique_ptr<WriteStream> getWriter(const std::vector<bool>& symbolMask,
             const SymbolTable& symbolTable, const IODirectives& ioDirectives,
             const bool provenance) override {
+        // dictionary encoding assigns ordinals in tuple order and thus
+        // takes precedence over the sharded and compressed writers
+        if (ioDirectives.has("dictionary") && ioDirectives.get("dictionary") == "true") {
+            return std::make_unique<WriteDictFileCSV>(symbolMask, symbolTable, ioDirectives, provenance);
+        }
+        if (ioDirectives.has("shards") && std::stoul(ioDirectives.get("shards")) > 1) {
+            return std::make_unique<WriteFileShardedCSV>(symbolMask, symbolTable, ioDirectives, provenance);
+        }
+#ifdef USE_LIBZSTD
+        if (ioDirectives.has("compress") && ioDirectives.get("compress") == "zstd") {
+            return std::make_unique<WriteZstdFileCSV>(symbolMask, symbolTable, ioDirectives, provenance);
+        }
+#endif
 #ifdef USE_LIBZ
         if (ioDirectives.has("compress")) {
             return std::make_unique<WriteGZipFileCSV>(symbolMask, symbolTable, ioDirectives, provenance);
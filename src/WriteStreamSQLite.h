@@ -35,10 +35,15 @@ public:
         openDB();
         createTables();
         prepareStatements();
-        //        executeSQL("BEGIN TRANSACTION", db);
+        executeSQL("BEGIN TRANSACTION", db);
     }
 
     ~WriteStreamSQLite() override {
+        try {
+            executeSQL("COMMIT", db);
+        } catch (...) {
+            // Don't throw exceptions.
+        }
         sqlite3_finalize(insertStatement);
         sqlite3_finalize(symbolInsertStatement);
         sqlite3_finalize(symbolSelectStatement);
@@ -69,6 +74,13 @@ protected:
         }
         sqlite3_clear_bindings(insertStatement);
         sqlite3_reset(insertStatement);
+        // committing per batch instead of per tuple keeps the journal
+        // overhead off the bulk-insert path
+        if (++tuplesInBatch == batchSize) {
+            tuplesInBatch = 0;
+            executeSQL("COMMIT", db);
+            executeSQL("BEGIN TRANSACTION", db);
+        }
     }
 
 private:
@@ -95,7 +107,7 @@ private:
     }
 
     uint64_t getSymbolTableIDFromDB(int index) {
-        if (sqlite3_bind_text(symbolSelectStatement, 1, symbolTable.unsafeResolve(index).c_str(), -1,
+        if (sqlite3_bind_text(symbolSelectStatement, 1, symbolTable.unsafeResolve(index).data(), -1,
                     SQLITE_TRANSIENT) != SQLITE_OK) {
             throwError("SQLite error in sqlite3_bind_text: ");
         }
@@ -112,7 +124,7 @@ private:
             return dbSymbolTable[index];
         }
 
-        if (sqlite3_bind_text(symbolInsertStatement, 1, symbolTable.unsafeResolve(index).c_str(), -1,
+        if (sqlite3_bind_text(symbolInsertStatement, 1, symbolTable.unsafeResolve(index).data(), -1,
                     SQLITE_TRANSIENT) != SQLITE_OK) {
             throwError("SQLite error in sqlite3_bind_text: ");
         }
@@ -137,7 +149,7 @@ private:
         }
         sqlite3_extended_result_codes(db, 1);
         executeSQL("PRAGMA synchronous = OFF", db);
-        executeSQL("PRAGMA journal_mode = MEMORY", db);
+        executeSQL("PRAGMA journal_mode = WAL", db);
     }
 
     void prepareStatements() {
@@ -246,6 +258,9 @@ private:
     const std::string& relationName;
     const std::string symbolTableName = "__SymbolTable";
 
+    static constexpr std::size_t batchSize = 100000;
+    std::size_t tuplesInBatch = 0;
+
     std::unordered_map<uint64_t, uint64_t> dbSymbolTable;
     sqlite3_stmt* insertStatement = nullptr;
     sqlite3_stmt* symbolInsertStatement = nullptr;
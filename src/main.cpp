@@ -27,10 +27,13 @@
 #include "Global.h"
 #include "InterpreterEngine.h"
 #include "InterpreterProgInterface.h"
+#include "MemoryPool.h"
 #include "ParserDriver.h"
+#include "ProfileEvent.h"
 #include "RamIndexAnalysis.h"
 #include "RamLevelAnalysis.h"
 #include "RamProgram.h"
+#include "RamSerializer.h"
 #include "RamTransformer.h"
 #include "RamTransforms.h"
 #include "RamTranslationUnit.h"
@@ -50,15 +53,19 @@
 #include <cstdio>
 #include <cstdlib>
 #include <fstream>
+#include <iomanip>
 #include <iostream>
 #include <memory>
 #include <set>
+#include <sstream>
 #include <stdexcept>
 #include <string>
 #include <thread>
 #include <utility>
 #include <vector>
 
+#include <sys/stat.h>
+
 namespace souffle {
 /**
  * Executes a binary file.
@@ -143,6 +150,110 @@ void compileToBinary(std::string compileCmd, const std::string& sourceFilename)
     }
 }
 
+/** Constructs the sequence of RAM optimization passes applied before execution */
+std::unique_ptr<RamTransformer> makeRamTransformerSequence() {
+    return std::make_unique<RamTransformerSequence>(std::make_unique<IncrementalAggregateTransformer>(),
+            std::make_unique<RamLoopTransformer>(
+                    std::make_unique<RamTransformerSequence>(std::make_unique<ExpandFilterTransformer>(),
+                            std::make_unique<ConstantPropagationTransformer>(),
+                            std::make_unique<EqualityCompressionTransformer>(),
+                            std::make_unique<HoistConditionsTransformer>(),
+                            std::make_unique<MakeIndexTransformer>())),
+            std::make_unique<IfConversionTransformer>(), std::make_unique<ChoiceConversionTransformer>(),
+            std::make_unique<CollapseFiltersTransformer>(), std::make_unique<ScanOrderTransformer>(),
+            std::make_unique<TupleIdTransformer>(),
+            std::make_unique<RamLoopTransformer>(std::make_unique<RamTransformerSequence>(
+                    std::make_unique<HoistAggregateTransformer>(), std::make_unique<TupleIdTransformer>())),
+            std::make_unique<ExpandFilterTransformer>(), std::make_unique<ConstantPropagationTransformer>(),
+            std::make_unique<EqualityCompressionTransformer>(),
+            std::make_unique<HoistConditionsTransformer>(), std::make_unique<CopyElisionTransformer>(),
+            std::make_unique<RelationAliasTransformer>(),
+            std::make_unique<RamConditionalTransformer>(
+                    // job count of 0 means all cores are used.
+                    []() -> bool { return std::stoi(Global::config().get("jobs")) != 1; },
+                    std::make_unique<ParallelTransformer>()),
+            std::make_unique<HashJoinTransformer>(), std::make_unique<QueryFusionTransformer>(),
+            std::make_unique<EagerDropTransformer>(), std::make_unique<IndexConsolidationTransformer>(),
+            std::make_unique<ReportIndexTransfomer>());
+}
+
+/** Computes a 64-bit FNV-1a hash of the given content, rendered as hex. */
+std::string contentHash(const std::string& content) {
+    uint64_t hash = 14695981039346656037ull;
+    for (const char c : content) {
+        hash ^= static_cast<unsigned char>(c);
+        hash *= 1099511628211ull;
+    }
+    std::stringstream hexHash;
+    hexHash << std::hex << std::setw(16) << std::setfill('0') << hash;
+    return hexHash.str();
+}
+
+/**
+ * Computes a stable content hash of the given RAM program, its symbol table
+ * and all configuration options influencing code generation; used as the key
+ * of the compilation cache.
+ */
+std::string ramProgramHash(RamTranslationUnit& ramTranslationUnit) {
+    std::stringstream content;
+    content << *ramTranslationUnit.getProgram();
+    ramTranslationUnit.getSymbolTable().print(content);
+    for (const char* option : {"", "version", "jobs", "profile", "profile-binary", "profile-sampling",
+                 "provenance", "engine", "live-profile", "verbose", "generate-many", "offload",
+                 "pipeline-store"}) {
+        content << ";" << (Global::config().has(option) ? Global::config().get(option) : "");
+    }
+    return contentHash(content.str());
+}
+
+/**
+ * Computes a stable content hash of the pre-processed input program and all
+ * configuration options influencing the RAM program produced by the
+ * frontend; used as the key of the frontend cache.
+ */
+std::string frontendProgramHash(const std::string& programText) {
+    std::stringstream content;
+    content << programText;
+    for (const char* option : {"", "version", "jobs", "profile", "profile-use", "no-warn",
+                 "magic-transform", "disable-transformers", "provenance", "auto-inline", "query",
+                 "stats-file", "gauss-seidel", "rule-budget", "warm-start-dir"}) {
+        content << ";" << (Global::config().has(option) ? Global::config().get(option) : "");
+    }
+    return contentHash(content.str());
+}
+
+/**
+ * Determines the directory of the compilation cache, creating it if
+ * necessary. SOUFFLE_CACHE_DIR overrides the default of
+ * $HOME/.cache/souffle; an empty result disables caching.
+ */
+std::string compilationCacheDir() {
+    std::string cacheDir;
+    if (const char* env = std::getenv("SOUFFLE_CACHE_DIR")) {
+        cacheDir = env;
+    } else if (const char* home = std::getenv("HOME")) {
+        cacheDir = std::string(home) + "/.cache";
+        mkdir(cacheDir.c_str(), 0755);
+        cacheDir += "/souffle";
+    } else {
+        return std::string();
+    }
+    mkdir(cacheDir.c_str(), 0755);
+    return existDir(cacheDir) ? cacheDir : std::string();
+}
+
+/** Copies a binary file, marking the destination as executable. */
+bool copyBinaryFile(const std::string& from, const std::string& to) {
+    std::ifstream source(from, std::ios::binary);
+    std::ofstream destination(to, std::ios::binary | std::ios::trunc);
+    if (!source.is_open() || !destination.is_open()) {
+        return false;
+    }
+    destination << source.rdbuf();
+    destination.close();
+    return !destination.fail() && chmod(to.c_str(), 0755) == 0;
+}
+
 int main(int argc, char** argv) {
     /* Time taking for overall runtime */
     auto souffle_start = std::chrono::high_resolution_clock::now();
@@ -190,6 +301,12 @@ int main(int argc, char** argv) {
                 {"generate", 'g', "FILE", "", false,
                         "Generate C++ source code for the given Datalog program and write it to "
                         "<FILE>."},
+                {"generate-many", 0, "", "", false,
+                        "Generate C++ source code split into multiple files, one per stratum, so "
+                        "large programs can be compiled in parallel."},
+                {"parallel-strata", 0, "", "", false,
+                        "Execute mutually independent strata concurrently. Ignored when profiling "
+                        "or a communication engine is enabled."},
                 {"swig", 's', "LANG", "", false,
                         "Generate SWIG interface for given language. The values <LANG> accepts is java and "
                         "python. "},
@@ -207,17 +324,85 @@ int main(int argc, char** argv) {
                         "binary executable (without executing it)."},
                 {"live-profile", '\4', "", "", false, "Enable live profiling."},
                 {"profile", 'p', "FILE", "", false, "Enable profiling, and write profile data to <FILE>."},
+                {"profile-binary", '\6', "", "", false,
+                        "Stream the profile log in a binary format with bounded memory overhead "
+                        "(ignored with live profiling)."},
+                {"profile-sampling", '\13', "FILE", "", false,
+                        "Periodically sample the executing rule instead of timing every scope, "
+                        "and write the sample counts to <FILE>."},
                 {"profile-use", 'u', "FILE", "", false,
                         "Use profile log-file <FILE> for profile-guided optimization."},
+                {"data-structure-stats", '\26', "", "", false,
+                        "Record per-index data structure statistics (tuples, node counts, depth, "
+                        "fill, memory, hits) in the profile log at stratum boundaries; requires "
+                        "profiling (interpreter only)."},
                 {"debug-report", 'r', "FILE", "", false, "Write HTML debug report to <FILE>."},
                 {"pragma", 'P', "OPTIONS", "", false, "Set pragma options."},
-                {"provenance", 't', "[ none | explain | explore ]", "", false,
-                        "Enable provenance instrumentation and interaction."},
+                {"provenance", 't', "[ none | explain | explore | server[:port] ]", "", false,
+                        "Enable provenance instrumentation and interaction. The server mode answers "
+                        "provenance queries from many concurrent clients over a TCP socket (default "
+                        "port 14321) instead of the interactive interface."},
                 {"engine", 'e', "[ file | mpi ]", "", false,
                         "Specify communication engine for distributed execution."},
                 {"hostfile", '\2', "FILE", "", false,
                         "Specify --hostfile option for call to mpiexec when using mpi as "
                         "execution engine."},
+                {"huge-pages", '\23', "", "", false,
+                        "Back tuple storage by huge pages (MAP_HUGETLB when reserved, transparent "
+                        "huge pages otherwise), reducing TLB misses on large working sets."},
+                {"spill-dir", '\7', "DIR", "", false,
+                        "Back tuple storage by memory-mapped files in <DIR>, letting the OS page "
+                        "relations exceeding main memory out to disk."},
+                {"checkpoint-dir", '\10', "DIR", "", false,
+                        "Write a snapshot of the evaluation state to <DIR> after each completed "
+                        "stratum (interpreter only)."},
+                {"resume", '\11', "", "", false,
+                        "Resume from the snapshots in the checkpoint directory, skipping strata "
+                        "completed by a previous run."},
+                {"memo-dir", '\15', "DIR", "", false,
+                        "Cache the output relations of pure strata in <DIR>, keyed by their RAM "
+                        "program and inputs, and reuse them across runs (interpreter only)."},
+                {"warm-start-dir", '\27', "DIR", "", false,
+                        "Seed recursive output relations with their results from a previous run "
+                        "stored in <DIR>, re-checking old tuples in one iteration instead of "
+                        "re-deriving them; only sound when the program is monotone and the "
+                        "previous run's inputs were a subset of the current ones."},
+                {"rule-budget", '\24', "SECONDS", "", false,
+                        "Abort a rule plan running longer than <SECONDS> and re-execute the rule "
+                        "with the remaining orders of its .plan, the last one without a deadline "
+                        "(interpreter only)."},
+                {"gauss-seidel", '\21', "", "", false,
+                        "Evaluate mutually recursive relations sequentially in dependency order, "
+                        "feeding tuples derived in an iteration into rules evaluated later in the "
+                        "same iteration."},
+                {"offload", '\22', "", "", false,
+                        "Emit an experimental accelerator offload path for eligible flat loop "
+                        "nests in synthesized code; the generated program runs them as OpenMP "
+                        "target regions when compiled with -DSOUFFLE_USE_OFFLOAD."},
+                {"pgo", '\20', "FILE", "", false,
+                        "Profile-guided compilation: evaluate the program once in the interpreter "
+                        "with profiling enabled, write the profile to <FILE>, and use it to guide "
+                        "the optimizing passes when compiling."},
+                {"stats-file", '\17', "FILE", "", false,
+                        "Write per-relation statistics (cardinality, per-column distinct counts, "
+                        "index hits) to <FILE> after evaluation, and use them as the default "
+                        "cost-model input on later runs when no profile is given."},
+                {"query", '\16', "ATOM", "", false,
+                        "Evaluate only the given query atom, e.g. 'reachable(\"main\",X)'; the "
+                        "atom becomes the sole output and the program is specialized towards "
+                        "its constants with the magic set transformation."},
+                {"pipeline-load", '\12', "", "", false,
+                        "Parse input fact files on background I/O threads, overlapping fact "
+                        "loading with rule evaluation (interpreter only)."},
+                {"stable-ordinals", '\30', "", "", false,
+                        "Renumber the symbols assigned during pipelined loading into the order "
+                        "a sequential load would produce, making outputs byte-identical across "
+                        "runs; no effect without --pipeline-load."},
+                {"pipeline-store", '\25', "", "", false,
+                        "Write output relations on background I/O threads, overlapping stores "
+                        "with rule evaluation."},
+                {"auto-inline", '\14', "", "", false,
+                        "Automatically inline small single-use intermediate relations."},
                 {"verbose", 'v', "", "", false, "Verbose output."},
                 {"version", '\3', "", "", false, "Version."},
                 {"transformed-datalog", '\4', "", "", false, "Output dl after all transformations."},
@@ -266,6 +451,45 @@ int main(int argc, char** argv) {
         }
 #endif
 
+        /* if a spill directory is given, check it exists and enable disk-backed tuple storage */
+        if (Global::config().has("spill-dir")) {
+            if (!existDir(Global::config().get("spill-dir"))) {
+                throw std::runtime_error(
+                        "spill directory " + Global::config().get("spill-dir") + " does not exists");
+            }
+            MemoryPool::setSpillDirectory(Global::config().get("spill-dir"));
+            // export the setting such that compiled programs inherit it
+            setenv("SOUFFLE_SPILL_DIR", Global::config().get("spill-dir").c_str(), 1);
+        }
+
+        /* if huge pages are requested, enable them for the tuple storage arenas */
+        if (Global::config().has("huge-pages")) {
+            MemoryPool::setHugePages(true);
+            // export the setting such that compiled programs inherit it
+            setenv("SOUFFLE_HUGE_PAGES", "1", 1);
+        }
+
+        /* if a checkpoint directory is given, check it exists */
+        if (Global::config().has("checkpoint-dir") &&
+                !existDir(Global::config().get("checkpoint-dir"))) {
+            throw std::runtime_error(
+                    "checkpoint directory " + Global::config().get("checkpoint-dir") + " does not exists");
+        }
+        if (Global::config().has("resume") && !Global::config().has("checkpoint-dir")) {
+            throw std::runtime_error("--resume requires a checkpoint directory (--checkpoint-dir)");
+        }
+
+        /* if a memo directory is given, check it exists */
+        if (Global::config().has("memo-dir") && !existDir(Global::config().get("memo-dir"))) {
+            throw std::runtime_error(
+                    "memo directory " + Global::config().get("memo-dir") + " does not exists");
+        }
+
+        /* a point query relies on the magic set transformation to specialize the program */
+        if (Global::config().has("query") && !Global::config().has("magic-transform")) {
+            Global::config().set("magic-transform", "*");
+        }
+
         /* if an output directory is given, check it exists */
         if (Global::config().has("output-dir") && !Global::config().has("output-dir", "-") &&
                 !existDir(Global::config().get("output-dir")) &&
@@ -392,14 +616,16 @@ int main(int argc, char** argv) {
     /* Time taking for parsing */
     auto parser_start = std::chrono::high_resolution_clock::now();
 
-    // ------- parse program -------------
-
-    // parse file
-    SymbolTable symTab;
-    ErrorReport errReport(Global::config().has("no-warn"));
-    DebugReport debugReport;
-    std::unique_ptr<AstTranslationUnit> astTranslationUnit =
-            ParserDriver::parseTranslationUnit("<stdin>", in, symTab, errReport, debugReport);
+    // drain the pre-processed program into memory; the full text keys the
+    // frontend cache below
+    std::string programText;
+    {
+        char chunk[1 << 16];
+        size_t bytes;
+        while ((bytes = fread(chunk, 1, sizeof(chunk), in)) > 0) {
+            programText.append(chunk, bytes);
+        }
+    }
 
     // close input pipe
     int preprocessor_status = pclose(in);
@@ -408,134 +634,221 @@ int main(int argc, char** argv) {
         throw std::runtime_error("failed to close pre-processor pipe");
     }
 
-    /* Report run-time of the parser if verbose flag is set */
-    if (Global::config().has("verbose")) {
-        auto parser_end = std::chrono::high_resolution_clock::now();
-        std::cout << "Parse Time: " << std::chrono::duration<double>(parser_end - parser_start).count()
-                  << "sec\n";
+    // determine the frontend cache entry for this program; options that
+    // need the AST itself bypass the cache
+    std::string frontendCacheStem;
+    if (!Global::config().has("parse-errors") && !Global::config().has("transformed-datalog") &&
+            Global::config().get("debug-report").empty()) {
+        const std::string cacheDir = compilationCacheDir();
+        if (!cacheDir.empty()) {
+            frontendCacheStem = cacheDir + "/" + frontendProgramHash(programText);
+        }
     }
+#ifdef USE_MPI
+    // the mpi driver consults AST analyses after translation
+    frontendCacheStem.clear();
+#endif
 
-    if (Global::config().has("parse-errors")) {
-        std::cout << astTranslationUnit->getErrorReport();
-        return astTranslationUnit->getErrorReport().getNumErrors();
-    }
+    SymbolTable symTab;
+    ErrorReport errReport(Global::config().has("no-warn"));
+    DebugReport debugReport;
 
-    // ------- check for parse errors -------------
-    if (astTranslationUnit->getErrorReport().getNumErrors() != 0) {
-        std::cerr << astTranslationUnit->getErrorReport();
-        std::cerr << std::to_string(astTranslationUnit->getErrorReport().getNumErrors()) +
-                             " errors generated, evaluation aborted"
-                  << std::endl;
-        exit(1);
+    // on a cache hit the serialized RAM program and the matching symbol
+    // table snapshot replace parsing, AST transformation and RAM
+    // translation altogether
+    std::unique_ptr<RamTranslationUnit> ramTranslationUnit;
+    if (!frontendCacheStem.empty() && existFile(frontendCacheStem + ".ram") &&
+            existFile(frontendCacheStem + ".sym")) {
+        try {
+            std::ifstream cache(frontendCacheStem + ".ram", std::ios::in | std::ios::binary);
+            std::unique_ptr<RamProgram> ramProgram = RamSerializer::read(cache);
+            symTab.restore(frontendCacheStem + ".sym");
+            ramTranslationUnit = std::make_unique<RamTranslationUnit>(
+                    std::move(ramProgram), symTab, errReport, debugReport);
+            if (Global::config().has("verbose")) {
+                std::cout << "Reusing cached frontend: " << frontendCacheStem << ".ram\n";
+            }
+        } catch (const std::exception&) {
+            // a stale or truncated entry is not fatal; run the full frontend
+            ramTranslationUnit.reset();
+        }
     }
 
-    // ------- rewriting / optimizations -------------
-
-    /* set up additional global options based on pragma declaratives */
-    (std::make_unique<AstPragmaChecker>())->apply(*astTranslationUnit);
-
-    /* construct the transformation pipeline */
-
-    // Magic-Set pipeline
-    auto magicPipeline = std::make_unique<ConditionalTransformer>(Global::config().has("magic-transform"),
-            std::make_unique<PipelineTransformer>(std::make_unique<NormaliseConstraintsTransformer>(),
-                    std::make_unique<MagicSetTransformer>(), std::make_unique<ResolveAliasesTransformer>(),
-                    std::make_unique<RemoveRelationCopiesTransformer>(),
-                    std::make_unique<RemoveEmptyRelationsTransformer>(),
-                    std::make_unique<RemoveRedundantRelationsTransformer>()));
-
-    // Equivalence pipeline
-    auto equivalencePipeline =
-            std::make_unique<PipelineTransformer>(std::make_unique<MinimiseProgramTransformer>(),
-                    std::make_unique<RemoveRelationCopiesTransformer>(),
-                    std::make_unique<RemoveEmptyRelationsTransformer>(),
-                    std::make_unique<RemoveRedundantRelationsTransformer>());
-
-    // Provenance pipeline
-    auto provenancePipeline = std::make_unique<PipelineTransformer>(std::make_unique<ConditionalTransformer>(
-            Global::config().has("provenance"), std::make_unique<ProvenanceTransformer>()));
-
-    // Main pipeline
-    auto pipeline = std::make_unique<PipelineTransformer>(std::make_unique<AstComponentChecker>(),
-            std::make_unique<ComponentInstantiationTransformer>(),
-            std::make_unique<UniqueAggregationVariablesTransformer>(), std::make_unique<AstSemanticChecker>(),
-            std::make_unique<RemoveTypecastsTransformer>(),
-            std::make_unique<RemoveBooleanConstraintsTransformer>(),
-            std::make_unique<ResolveAliasesTransformer>(), std::make_unique<MinimiseProgramTransformer>(),
-            std::make_unique<InlineRelationsTransformer>(), std::make_unique<ResolveAliasesTransformer>(),
-            std::make_unique<RemoveRedundantRelationsTransformer>(),
-            std::make_unique<RemoveRelationCopiesTransformer>(),
-            std::make_unique<RemoveEmptyRelationsTransformer>(),
-            std::make_unique<ReplaceSingletonVariablesTransformer>(),
-            std::make_unique<FixpointTransformer>(
-                    std::make_unique<PipelineTransformer>(std::make_unique<ReduceExistentialsTransformer>(),
-                            std::make_unique<RemoveRedundantRelationsTransformer>())),
-            std::make_unique<RemoveRelationCopiesTransformer>(),
-            std::make_unique<PartitionBodyLiteralsTransformer>(),
-            std::make_unique<MinimiseProgramTransformer>(),
-            std::make_unique<RemoveRelationCopiesTransformer>(),
-            std::make_unique<ReorderLiteralsTransformer>(),
-            std::make_unique<PipelineTransformer>(std::make_unique<ResolveAliasesTransformer>(),
-                    std::make_unique<MaterializeAggregationQueriesTransformer>()),
-            std::make_unique<RemoveRedundantSumsTransformer>(),
-            std::make_unique<RemoveEmptyRelationsTransformer>(),
-            std::make_unique<ReorderLiteralsTransformer>(), std::move(magicPipeline),
-            std::make_unique<AstExecutionPlanChecker>(), std::move(provenancePipeline));
-
-    // Disable unwanted transformations
-    if (Global::config().has("disable-transformers")) {
-        std::vector<std::string> givenTransformers =
-                splitString(Global::config().get("disable-transformers"), ',');
-        pipeline->disableTransformers(
-                std::set<std::string>(givenTransformers.begin(), givenTransformers.end()));
-    }
+    if (ramTranslationUnit == nullptr) {
+        // ------- parse program -------------
 
-    // Set up the debug report if necessary
-    if (!Global::config().get("debug-report").empty()) {
-        auto parser_end = std::chrono::high_resolution_clock::now();
-        std::string runtimeStr =
-                "(" + std::to_string(std::chrono::duration<double>(parser_end - parser_start).count()) + "s)";
-        DebugReporter::generateDebugReport(*astTranslationUnit, "Parsing", "After Parsing " + runtimeStr);
+        // parse file
+        std::unique_ptr<AstTranslationUnit> astTranslationUnit =
+                ParserDriver::parseTranslationUnit(programText, symTab, errReport, debugReport);
 
-        pipeline->setDebugReport();
-    }
+        /* Report run-time of the parser if verbose flag is set */
+        if (Global::config().has("verbose")) {
+            auto parser_end = std::chrono::high_resolution_clock::now();
+            std::cout << "Parse Time: " << std::chrono::duration<double>(parser_end - parser_start).count()
+                      << "sec\n";
+        }
 
-    // Toggle pipeline verbosity
-    pipeline->setVerbosity(Global::config().has("verbose"));
+        if (Global::config().has("parse-errors")) {
+            std::cout << astTranslationUnit->getErrorReport();
+            return astTranslationUnit->getErrorReport().getNumErrors();
+        }
 
-    // Apply all the transformations
-    pipeline->apply(*astTranslationUnit);
+        // ------- check for parse errors -------------
+        if (astTranslationUnit->getErrorReport().getNumErrors() != 0) {
+            std::cerr << astTranslationUnit->getErrorReport();
+            std::cerr << std::to_string(astTranslationUnit->getErrorReport().getNumErrors()) +
+                                 " errors generated, evaluation aborted"
+                      << std::endl;
+            exit(1);
+        }
 
-    // Output the transformed datalog and return
-    if (Global::config().has("transformed-datalog")) {
-        std::cout << *astTranslationUnit->getProgram() << std::endl;
-        return 0;
-    }
-    // ------- execution -------------
+        // ------- rewriting / optimizations -------------
+
+        /* set up additional global options based on pragma declaratives */
+        (std::make_unique<AstPragmaChecker>())->apply(*astTranslationUnit);
+
+        /* construct the transformation pipeline */
+
+        // Point-query pipeline
+        auto pointQueryPipeline = std::make_unique<ConditionalTransformer>(
+                Global::config().has("query"), std::make_unique<PointQueryTransformer>());
+
+        // Magic-Set pipeline
+        auto magicPipeline = std::make_unique<ConditionalTransformer>(Global::config().has("magic-transform"),
+                std::make_unique<PipelineTransformer>(std::make_unique<NormaliseConstraintsTransformer>(),
+                        std::make_unique<MagicSetTransformer>(), std::make_unique<ResolveAliasesTransformer>(),
+                        std::make_unique<RemoveRelationCopiesTransformer>(),
+                        std::make_unique<RemoveEmptyRelationsTransformer>(),
+                        std::make_unique<RemoveRedundantRelationsTransformer>()));
+
+        // Equivalence pipeline
+        auto equivalencePipeline =
+                std::make_unique<PipelineTransformer>(std::make_unique<MinimiseProgramTransformer>(),
+                        std::make_unique<RemoveRelationCopiesTransformer>(),
+                        std::make_unique<RemoveEmptyRelationsTransformer>(),
+                        std::make_unique<RemoveRedundantRelationsTransformer>());
+
+        // Provenance pipeline
+        auto provenancePipeline = std::make_unique<PipelineTransformer>(std::make_unique<ConditionalTransformer>(
+                Global::config().has("provenance"), std::make_unique<ProvenanceTransformer>()));
+
+        // Main pipeline
+        auto pipeline = std::make_unique<PipelineTransformer>(std::make_unique<AstComponentChecker>(),
+                std::make_unique<ComponentInstantiationTransformer>(),
+                std::make_unique<UniqueAggregationVariablesTransformer>(), std::make_unique<AstSemanticChecker>(),
+                std::make_unique<RemoveTypecastsTransformer>(),
+                std::make_unique<RemoveBooleanConstraintsTransformer>(),
+                std::make_unique<ResolveAliasesTransformer>(), std::make_unique<MinimiseProgramTransformer>(),
+                std::make_unique<InlineRelationsTransformer>(), std::make_unique<ResolveAliasesTransformer>(),
+                std::make_unique<RemoveRedundantRelationsTransformer>(),
+                std::make_unique<RemoveRelationCopiesTransformer>(),
+                std::make_unique<RemoveEmptyRelationsTransformer>(),
+                std::make_unique<ReplaceSingletonVariablesTransformer>(),
+                std::make_unique<DeadColumnEliminationTransformer>(),
+                std::make_unique<FixpointTransformer>(
+                        std::make_unique<PipelineTransformer>(std::make_unique<ReduceExistentialsTransformer>(),
+                                std::make_unique<RemoveRedundantRelationsTransformer>())),
+                std::make_unique<RemoveRelationCopiesTransformer>(),
+                std::make_unique<PartitionBodyLiteralsTransformer>(),
+                std::make_unique<MinimiseProgramTransformer>(),
+                std::make_unique<RemoveRelationCopiesTransformer>(),
+                std::make_unique<ReorderLiteralsTransformer>(),
+                std::make_unique<PipelineTransformer>(std::make_unique<ResolveAliasesTransformer>(),
+                        std::make_unique<MaterializeAggregationQueriesTransformer>()),
+                std::make_unique<RemoveRedundantSumsTransformer>(),
+                std::make_unique<RemoveEmptyRelationsTransformer>(),
+                std::make_unique<ReorderLiteralsTransformer>(), std::move(pointQueryPipeline),
+                std::move(magicPipeline),
+                std::make_unique<AstExecutionPlanChecker>(), std::move(provenancePipeline));
+
+        // Disable unwanted transformations
+        if (Global::config().has("disable-transformers")) {
+            std::vector<std::string> givenTransformers =
+                    splitString(Global::config().get("disable-transformers"), ',');
+            pipeline->disableTransformers(
+                    std::set<std::string>(givenTransformers.begin(), givenTransformers.end()));
+        }
 
-    /* translate AST to RAM */
-    std::unique_ptr<RamTranslationUnit> ramTranslationUnit =
-            AstTranslator().translateUnit(*astTranslationUnit);
+        // ------- profile-guided compilation -------
+        // Evaluate the program once in the interpreter with profiling enabled,
+        // then feed the collected profile into the optimizing passes below as
+        // if --profile-use had been given, so that index selection, join
+        // orders and parallel-region choices are driven by measured sizes.
+        if (Global::config().has("pgo") && !Global::config().has("profile-use") &&
+                (Global::config().has("compile") || Global::config().has("dl-program") ||
+                        Global::config().has("generate") || Global::config().has("swig"))) {
+            const std::string profileFile = Global::config().get("pgo");
+            auto profileUnit = std::make_unique<AstTranslationUnit>(
+                    std::unique_ptr<AstProgram>(astTranslationUnit->getProgram()->clone()), symTab,
+                    errReport, debugReport, Global::config().has("no-warn"));
+            pipeline->apply(*profileUnit);
+            auto profileRam = AstTranslator().translateUnit(*profileUnit);
+            makeRamTransformerSequence()->apply(*profileRam);
+            if (profileRam->getProgram()->getMain() != nullptr) {
+                Global::config().set("profile", profileFile);
+                InterpreterEngine(*profileRam).executeMain();
+                // the profile database is normally written at process exit;
+                // write it now so the passes below can read it back
+                ProfileEventSingleton::instance().dump();
+                ProfileEventSingleton::instance().setOutputFile("");
+                Global::config().unset("profile");
+                Global::config().set("profile-use", profileFile);
+            }
+        }
 
-    std::unique_ptr<RamTransformer> ramTransform = std::make_unique<RamTransformerSequence>(
-            std::make_unique<RamLoopTransformer>(
-                    std::make_unique<RamTransformerSequence>(std::make_unique<ExpandFilterTransformer>(),
-                            std::make_unique<HoistConditionsTransformer>(),
-                            std::make_unique<MakeIndexTransformer>())),
-            std::make_unique<IfConversionTransformer>(), std::make_unique<ChoiceConversionTransformer>(),
-            std::make_unique<CollapseFiltersTransformer>(), std::make_unique<TupleIdTransformer>(),
-            std::make_unique<RamLoopTransformer>(std::make_unique<RamTransformerSequence>(
-                    std::make_unique<HoistAggregateTransformer>(), std::make_unique<TupleIdTransformer>())),
-            std::make_unique<ExpandFilterTransformer>(), std::make_unique<HoistConditionsTransformer>(),
-            std::make_unique<RamConditionalTransformer>(
-                    // job count of 0 means all cores are used.
-                    []() -> bool { return std::stoi(Global::config().get("jobs")) != 1; },
-                    std::make_unique<ParallelTransformer>()),
-            std::make_unique<ReportIndexTransfomer>());
+        // Set up the debug report if necessary
+        if (!Global::config().get("debug-report").empty()) {
+            auto parser_end = std::chrono::high_resolution_clock::now();
+            std::string runtimeStr =
+                    "(" + std::to_string(std::chrono::duration<double>(parser_end - parser_start).count()) + "s)";
+            DebugReporter::generateDebugReport(*astTranslationUnit, "Parsing", "After Parsing " + runtimeStr);
+
+            pipeline->setDebugReport();
+        }
+
+        // Toggle pipeline verbosity
+        pipeline->setVerbosity(Global::config().has("verbose"));
 
-    ramTransform->apply(*ramTranslationUnit);
-    if (ramTranslationUnit->getErrorReport().getNumIssues() != 0) {
-        std::cerr << ramTranslationUnit->getErrorReport();
+        // Apply all the transformations
+        pipeline->apply(*astTranslationUnit);
+
+        // Output the transformed datalog and return
+        if (Global::config().has("transformed-datalog")) {
+            std::cout << *astTranslationUnit->getProgram() << std::endl;
+            return 0;
+        }
+        // ------- execution -------------
+
+        /* translate AST to RAM */
+        ramTranslationUnit = AstTranslator().translateUnit(*astTranslationUnit);
+
+        std::unique_ptr<RamTransformer> ramTransform = makeRamTransformerSequence();
+
+        ramTransform->apply(*ramTranslationUnit);
+        if (ramTranslationUnit->getErrorReport().getNumIssues() != 0) {
+            std::cerr << ramTranslationUnit->getErrorReport();
+        }
+
+        // populate the frontend cache for subsequent runs; the entry is
+        // written to a scratch name and renamed so a concurrent run never
+        // reads a half-written program
+        if (!frontendCacheStem.empty() && ramTranslationUnit->getProgram()->getMain() != nullptr &&
+                ramTranslationUnit->getErrorReport().getNumIssues() == 0) {
+            const std::string partName = frontendCacheStem + ".ram.part";
+            try {
+                std::ofstream cache(partName, std::ios::out | std::ios::binary | std::ios::trunc);
+                RamSerializer::write(*ramTranslationUnit->getProgram(), cache);
+                cache.close();
+                if (!cache.fail()) {
+                    symTab.dump(frontendCacheStem + ".sym");
+                    std::rename(partName.c_str(), (frontendCacheStem + ".ram").c_str());
+                }
+            } catch (const std::exception&) {
+                // programs holding constructs the serializer does not cover
+                // simply run uncached
+                std::remove(partName.c_str());
+            }
+        }
     }
 
     if (!ramTranslationUnit->getProgram()->getMain()) {
@@ -560,6 +873,14 @@ int main(int argc, char** argv) {
         if (profiler.joinable()) {
             profiler.join();
         }
+        // render the executed RAM program, annotated with the measured
+        // per-operation tuple counts and times, into the debug report
+        if (Global::config().has("profile") && !Global::config().get("debug-report").empty()) {
+            std::stringstream explainAnalysis;
+            interpreter->printExplainAnalysis(explainAnalysis);
+            debugReport.addSection(DebugReporter::getCodeSection(
+                    "explain-analysis", "Explain Analysis (measured RAM program)", explainAnalysis.str()));
+        }
         // only run explain interface if interpreted
         if (Global::config().has("provenance")) {
             InterpreterProgInterface interface(*interpreter);
@@ -567,6 +888,8 @@ int main(int argc, char** argv) {
                 explain(interface, false);
             } else if (Global::config().get("provenance") == "explore") {
                 explain(interface, true);
+            } else if (Global::config().get("provenance").rfind("server", 0) == 0) {
+                explainServer(interface, Global::config().get("provenance"));
             }
         }
     } else {
@@ -603,32 +926,65 @@ int main(int argc, char** argv) {
             std::string baseIdentifier = identifier(simpleName(baseFilename));
             std::string sourceFilename = baseFilename + ".cpp";
 
-            bool withSharedLibrary;
-            std::ofstream os(sourceFilename);
-            synthesiser->generateCode(os, baseIdentifier, withSharedLibrary);
-            os.close();
+            // consult the compilation cache: if a binary for exactly this RAM
+            // program has been compiled before, reuse it and skip both code
+            // generation and compilation
+            std::string cachedBinary;
+            if (Global::config().has("compile") && !Global::config().has("swig") &&
+                    !Global::config().has("generate")) {
+                const std::string cacheDir = compilationCacheDir();
+                if (!cacheDir.empty()) {
+                    cachedBinary = cacheDir + "/" + ramProgramHash(*ramTranslationUnit);
+                }
+            }
+            bool cacheHit = !cachedBinary.empty() && isExecutable(cachedBinary) &&
+                            copyBinaryFile(cachedBinary, baseFilename);
+            if (cacheHit && Global::config().has("verbose")) {
+                std::cout << "Reusing cached binary: " << cachedBinary << "\n";
+            }
 
-            if (withSharedLibrary) {
-                if (!Global::config().has("libraries")) {
-                    Global::config().set("libraries", "functors");
+            if (!cacheHit) {
+                bool withSharedLibrary;
+                std::vector<std::string> sourceFilenames;
+                if (Global::config().has("generate-many") && !Global::config().has("swig")) {
+                    sourceFilenames =
+                            synthesiser->generateCode(baseFilename, baseIdentifier, withSharedLibrary);
+                } else {
+                    std::ofstream os(sourceFilename);
+                    synthesiser->generateCode(os, baseIdentifier, withSharedLibrary);
+                    os.close();
+                    sourceFilenames.push_back(sourceFilename);
                 }
-                if (!Global::config().has("library-dir")) {
-                    Global::config().set("library-dir", ".");
+
+                if (withSharedLibrary) {
+                    if (!Global::config().has("libraries")) {
+                        Global::config().set("libraries", "functors");
+                    }
+                    if (!Global::config().has("library-dir")) {
+                        Global::config().set("library-dir", ".");
+                    }
                 }
-            }
 
-            if (Global::config().has("swig")) {
-                compileCmd += "-s " + Global::config().get("swig") + " ";
-                compileToBinary(compileCmd, sourceFilename);
-            } else if (Global::config().has("compile")) {
-                auto start = std::chrono::high_resolution_clock::now();
-                compileToBinary(compileCmd, sourceFilename);
-                /* Report overall run-time in verbose mode */
-                if (Global::config().has("verbose")) {
-                    auto end = std::chrono::high_resolution_clock::now();
-                    std::cout << "Compilation Time: " << std::chrono::duration<double>(end - start).count()
-                              << "sec\n";
+                if (Global::config().has("swig")) {
+                    compileCmd += "-s " + Global::config().get("swig") + " ";
+                    compileToBinary(compileCmd, sourceFilename);
+                } else if (Global::config().has("compile")) {
+                    auto start = std::chrono::high_resolution_clock::now();
+                    compileToBinary(compileCmd, toString(join(sourceFilenames, " ")));
+                    // populate the cache for subsequent runs
+                    if (!cachedBinary.empty()) {
+                        copyBinaryFile(baseFilename, cachedBinary);
+                    }
+                    /* Report overall run-time in verbose mode */
+                    if (Global::config().has("verbose")) {
+                        auto end = std::chrono::high_resolution_clock::now();
+                        std::cout << "Compilation Time: "
+                                  << std::chrono::duration<double>(end - start).count() << "sec\n";
+                    }
                 }
+            }
+
+            if (Global::config().has("compile")) {
                 // run compiled C++ program if requested.
                 if (!Global::config().has("dl-program") && !Global::config().has("swig")) {
                     executeBinary(baseFilename
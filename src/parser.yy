@@ -88,6 +88,12 @@
 %token BRIE_QUALIFIER            "BRIE datastructure qualifier"
 %token BTREE_QUALIFIER           "BTREE datastructure qualifier"
 %token EQREL_QUALIFIER           "equivalence relation qualifier"
+%token COLUMNAR_QUALIFIER        "columnar datastructure qualifier"
+%token BITSET_QUALIFIER          "bitset datastructure qualifier"
+%token SUBSUMPTION_QUALIFIER     "subsumption relation qualifier"
+%token FUNCTIONAL_QUALIFIER      "functional relation qualifier"
+%token AUTO_QUALIFIER            "auto datastructure qualifier"
+%token GROUPED_QUALIFIER         "grouped datastructure qualifier"
 %token OVERRIDABLE_QUALIFIER     "relation qualifier overidable"
 %token INLINE_QUALIFIER          "relation qualifier inline"
 %token TMATCH                    "match predicate"
@@ -511,20 +517,50 @@ qualifiers
         $$ = $1 | INLINE_RELATION;
     }
   | qualifiers BRIE_QUALIFIER {
-        if($1 & (BRIE_RELATION|BTREE_RELATION|EQREL_RELATION))
-            driver.error(@2, "btree/brie/eqrel qualifier already set");
+        if($1 & (BRIE_RELATION|BTREE_RELATION|EQREL_RELATION|COLUMNAR_RELATION|BITSET_RELATION|SUBSUMPTION_RELATION|FUNCTIONAL_RELATION|AUTO_RELATION|GROUPED_RELATION))
+            driver.error(@2, "btree/brie/eqrel/columnar/bitset/subsumption/functional/auto/grouped qualifier already set");
         $$ = $1 | BRIE_RELATION;
     }
   | qualifiers BTREE_QUALIFIER {
-        if($1 & (BRIE_RELATION|BTREE_RELATION|EQREL_RELATION))
-            driver.error(@2, "btree/brie/eqrel qualifier already set");
+        if($1 & (BRIE_RELATION|BTREE_RELATION|EQREL_RELATION|COLUMNAR_RELATION|BITSET_RELATION|SUBSUMPTION_RELATION|FUNCTIONAL_RELATION|AUTO_RELATION|GROUPED_RELATION))
+            driver.error(@2, "btree/brie/eqrel/columnar/bitset/subsumption/functional/auto/grouped qualifier already set");
         $$ = $1 | BTREE_RELATION;
     }
   | qualifiers EQREL_QUALIFIER {
-        if($1 & (BRIE_RELATION|BTREE_RELATION|EQREL_RELATION))
-            driver.error(@2, "btree/brie/eqrel qualifier already set");
+        if($1 & (BRIE_RELATION|BTREE_RELATION|EQREL_RELATION|COLUMNAR_RELATION|BITSET_RELATION|SUBSUMPTION_RELATION|FUNCTIONAL_RELATION|AUTO_RELATION|GROUPED_RELATION))
+            driver.error(@2, "btree/brie/eqrel/columnar/bitset/subsumption/functional/auto/grouped qualifier already set");
         $$ = $1 | EQREL_RELATION;
     }
+  | qualifiers COLUMNAR_QUALIFIER {
+        if($1 & (BRIE_RELATION|BTREE_RELATION|EQREL_RELATION|COLUMNAR_RELATION|BITSET_RELATION|SUBSUMPTION_RELATION|FUNCTIONAL_RELATION|AUTO_RELATION|GROUPED_RELATION))
+            driver.error(@2, "btree/brie/eqrel/columnar/bitset/subsumption/functional/auto/grouped qualifier already set");
+        $$ = $1 | COLUMNAR_RELATION;
+    }
+  | qualifiers BITSET_QUALIFIER {
+        if($1 & (BRIE_RELATION|BTREE_RELATION|EQREL_RELATION|COLUMNAR_RELATION|BITSET_RELATION|SUBSUMPTION_RELATION|FUNCTIONAL_RELATION|AUTO_RELATION|GROUPED_RELATION))
+            driver.error(@2, "btree/brie/eqrel/columnar/bitset/subsumption/functional/auto/grouped qualifier already set");
+        $$ = $1 | BITSET_RELATION;
+    }
+  | qualifiers SUBSUMPTION_QUALIFIER {
+        if($1 & (BRIE_RELATION|BTREE_RELATION|EQREL_RELATION|COLUMNAR_RELATION|BITSET_RELATION|SUBSUMPTION_RELATION|FUNCTIONAL_RELATION|AUTO_RELATION|GROUPED_RELATION))
+            driver.error(@2, "btree/brie/eqrel/columnar/bitset/subsumption/functional/auto/grouped qualifier already set");
+        $$ = $1 | SUBSUMPTION_RELATION;
+    }
+  | qualifiers FUNCTIONAL_QUALIFIER {
+        if($1 & (BRIE_RELATION|BTREE_RELATION|EQREL_RELATION|COLUMNAR_RELATION|BITSET_RELATION|SUBSUMPTION_RELATION|FUNCTIONAL_RELATION|AUTO_RELATION|GROUPED_RELATION))
+            driver.error(@2, "btree/brie/eqrel/columnar/bitset/subsumption/functional/auto/grouped qualifier already set");
+        $$ = $1 | FUNCTIONAL_RELATION;
+    }
+  | qualifiers AUTO_QUALIFIER {
+        if($1 & (BRIE_RELATION|BTREE_RELATION|EQREL_RELATION|COLUMNAR_RELATION|BITSET_RELATION|SUBSUMPTION_RELATION|FUNCTIONAL_RELATION|AUTO_RELATION|GROUPED_RELATION))
+            driver.error(@2, "btree/brie/eqrel/columnar/bitset/subsumption/functional/auto/grouped qualifier already set");
+        $$ = $1 | AUTO_RELATION;
+    }
+  | qualifiers GROUPED_QUALIFIER {
+        if($1 & (BRIE_RELATION|BTREE_RELATION|EQREL_RELATION|COLUMNAR_RELATION|BITSET_RELATION|SUBSUMPTION_RELATION|FUNCTIONAL_RELATION|AUTO_RELATION|GROUPED_RELATION))
+            driver.error(@2, "btree/brie/eqrel/columnar/bitset/subsumption/functional/auto/grouped qualifier already set");
+        $$ = $1 | GROUPED_RELATION;
+    }
   | %empty {
         $$ = 0;
     }
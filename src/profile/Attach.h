@@ -0,0 +1,151 @@
+/*
+ * Souffle - A Datalog Compiler
+ * Copyright (c) 2020, The Souffle Developers. All rights reserved
+ * Licensed under the Universal Permissive License v 1.0 as shown at:
+ * - https://opensource.org/licenses/UPL
+ * - <souffle root>/licenses/SOUFFLE-UPL.txt
+ */
+
+#pragma once
+
+#include "../SignalHandler.h"
+#include "StringUtils.h"
+
+#include <algorithm>
+#include <chrono>
+#include <csignal>
+#include <cstdio>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace souffle {
+namespace profile {
+
+/*
+ * Attaches to the progress map a running souffle process publishes under
+ * /tmp/souffle-<pid>.progress and periodically renders the statements it
+ * is executing, most recently active first. Unlike live mode, this does
+ * not require the process to have been started with profiling enabled.
+ */
+class Attach {
+private:
+    int pid;
+    const ProgressMapHeader* header = nullptr;
+    const ProgressMapRecord* records = nullptr;
+    size_t length = 0;
+
+public:
+    Attach(const std::string& pidStr) : pid(std::stoi(pidStr)) {}
+
+    ~Attach() {
+        if (header != nullptr) {
+            munmap(const_cast<ProgressMapHeader*>(header), length);
+        }
+    }
+
+    void run() {
+        if (!attach()) {
+            return;
+        }
+        std::printf("Attached to souffle process %d; Ctrl-C to detach.\n", pid);
+        while (alive()) {
+            render();
+            std::this_thread::sleep_for(std::chrono::seconds(1));
+        }
+        std::printf("Process %d has exited.\n", pid);
+    }
+
+private:
+    bool attach() {
+        std::string path = progressMapPath(pid);
+        int fd = open(path.c_str(), O_RDONLY);
+        if (fd == -1) {
+            std::cout << "Error: no progress map found for process " << pid << ".\n"
+                      << "The process is not running, is not a souffle program, or has not\n"
+                      << "started evaluating yet.\n";
+            return false;
+        }
+        struct stat status;
+        if (fstat(fd, &status) == -1 || (size_t)status.st_size < sizeof(ProgressMapHeader)) {
+            std::cout << "Error: the progress map of process " << pid << " is truncated.\n";
+            close(fd);
+            return false;
+        }
+        length = status.st_size;
+        void* base = mmap(nullptr, length, PROT_READ, MAP_SHARED, fd, 0);
+        close(fd);
+        if (base == MAP_FAILED) {
+            std::cout << "Error: cannot map the progress map of process " << pid << ".\n";
+            return false;
+        }
+        header = static_cast<const ProgressMapHeader*>(base);
+        if (header->magic != PROGRESS_MAP_MAGIC ||
+                length < sizeof(ProgressMapHeader) + header->slots * sizeof(ProgressMapRecord)) {
+            std::cout << "Error: the progress map of process " << pid
+                      << " has an unexpected layout; are the souffle and souffle-profile\n"
+                         "versions the same?\n";
+            munmap(const_cast<ProgressMapHeader*>(header), length);
+            header = nullptr;
+            return false;
+        }
+        records = reinterpret_cast<const ProgressMapRecord*>(header + 1);
+        return true;
+    }
+
+    /** Whether the attached process still exists and publishes its map */
+    bool alive() const {
+        struct stat status;
+        return kill(pid, 0) == 0 && stat(progressMapPath(pid).c_str(), &status) == 0;
+    }
+
+    void render() const {
+        // snapshot the entered statements, most recently active first
+        std::vector<size_t> active;
+        for (size_t i = 0; i < header->slots; ++i) {
+            if (records[i].hits.load(std::memory_order_relaxed) > 0) {
+                active.push_back(i);
+            }
+        }
+        std::sort(active.begin(), active.end(), [&](size_t a, size_t b) {
+            return records[a].stamp.load(std::memory_order_relaxed) >
+                   records[b].stamp.load(std::memory_order_relaxed);
+        });
+
+        auto now = std::chrono::steady_clock::now().time_since_epoch().count();
+        std::printf("\n ----- souffle process %d: %zu of %zu statements entered -----\n", pid,
+                active.size(), (size_t)header->slots);
+        std::printf("%8s%8s %s\n", "HITS", "LAST", "STATEMENT");
+        size_t limit = 20;
+        for (size_t i = 0; i < active.size() && i < limit; ++i) {
+            const auto& record = records[active[i]];
+            auto ago = std::chrono::duration_cast<std::chrono::microseconds>(
+                    std::chrono::steady_clock::duration(
+                            std::max<int64_t>(0, now - record.stamp.load(std::memory_order_relaxed))));
+            std::string statement(record.msg);
+            for (char& c : statement) {
+                if (c == '\n' || c == '\t') {
+                    c = ' ';
+                }
+            }
+            if (statement.size() > 60) {
+                statement = statement.substr(0, 57) + "...";
+            }
+            std::printf("%8s%8s %s\n",
+                    Tools::formatNum(0, record.hits.load(std::memory_order_relaxed)).c_str(),
+                    Tools::formatTime(ago).c_str(), statement.c_str());
+        }
+        if (active.size() > limit) {
+            std::printf("%zu statements not shown\n", active.size() - limit);
+        }
+    }
+};
+
+}  // namespace profile
+}  // namespace souffle
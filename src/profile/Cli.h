@@ -8,6 +8,8 @@
 
 #pragma once
 
+#include "Attach.h"
+#include "Compare.h"
 #include "StringUtils.h"
 #include "Tui.h"
 
@@ -32,7 +34,7 @@ public:
         int c;
         option longOptions[1];
         longOptions[0] = {nullptr, 0, nullptr, 0};
-        while ((c = getopt_long(argc, argv, "c:hj::", longOptions, nullptr)) != EOF) {
+        while ((c = getopt_long(argc, argv, "a:c:d:hj::t:", longOptions, nullptr)) != EOF) {
             // An invalid argument was given
             if (c == '?') {
                 exit(1);
@@ -58,22 +60,42 @@ public:
             exit(1);
         }
 
-        if (args.count('h') != 0 || args.count('f') == 0) {
+        if (args.count('h') != 0 || (args.count('f') == 0 && args.count('a') == 0)) {
             std::cout << "Souffle Profiler" << std::endl
                       << "Usage: souffle-profile <log-file> [ -h | -c <command> [options] | -j ]" << std::endl
                       << "<log-file>            The log file to profile." << std::endl
+                      << "-a <pid>              Attach to the running souffle process with the given pid"
+                      << std::endl
+                      << "                      and show its currently executing statements." << std::endl
                       << "-c <command>          Run the given command on the log file, try with  "
                          "'-c help' for a list"
                       << std::endl
                       << "                      of commands." << std::endl
+                      << "-d <baseline>         Compare the log file against the given baseline log rule"
+                      << std::endl
+                      << "                      by rule and report regressions; the exit status is 1 if"
+                      << std::endl
+                      << "                      any rule regressed beyond the threshold." << std::endl
+                      << "-t <factor>           The runtime growth factor from which a rule counts as"
+                      << std::endl
+                      << "                      regressed in compare mode (default 1.5)." << std::endl
                       << "-j[filename]          Generate a GUI (html/js) version of the profiler."
                       << std::endl
                       << "                      Default filename is profiler_html/[num].html" << std::endl
                       << "-h                    Print this help message." << std::endl;
             exit(0);
         }
+
+        if (args.count('a') != 0) {
+            Attach(args['a']).run();
+            return;
+        }
         std::string filename = args['f'];
 
+        if (args.count('d') != 0) {
+            double threshold = args.count('t') != 0 ? std::stod(args['t']) : 1.5;
+            exit(Compare(args['d'], filename, threshold).run() == 0 ? 0 : 1);
+        }
         if (args.count('c') != 0) {
             Tui tui(filename, false, false);
             for (auto& command : Tools::split(args['c'], ";")) {
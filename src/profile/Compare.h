@@ -0,0 +1,147 @@
+/*
+ * Souffle - A Datalog Compiler
+ * Copyright (c) 2020, The Souffle Developers. All rights reserved
+ * Licensed under the Universal Permissive License v 1.0 as shown at:
+ * - https://opensource.org/licenses/UPL
+ * - <souffle root>/licenses/SOUFFLE-UPL.txt
+ */
+
+#pragma once
+
+#include "ProgramRun.h"
+#include "Reader.h"
+#include "Relation.h"
+#include "Rule.h"
+#include "StringUtils.h"
+
+#include <chrono>
+#include <iostream>
+#include <map>
+#include <memory>
+#include <string>
+
+namespace souffle {
+namespace profile {
+
+/*
+ * Compares two profile databases rule by rule -- runtime, tuple counts and
+ * iteration counts -- and reports every entry whose runtime grew beyond a
+ * threshold factor over the baseline, so a nightly run can name the rule a
+ * change made slower instead of only showing the overall slowdown.
+ */
+class Compare {
+private:
+    /** the measurements of one rule or relation, aggregated over iterations */
+    struct Entry {
+        std::chrono::microseconds time{};
+        long tuples = 0;
+        size_t iterations = 0;
+    };
+
+    std::shared_ptr<ProgramRun> baseline;
+    std::shared_ptr<ProgramRun> current;
+
+    /** the runtime growth factor from which an entry counts as regressed */
+    double threshold;
+
+    /** runtimes below this are noise and never flagged */
+    static constexpr std::chrono::microseconds MIN_TIME{1000};
+
+    /** a stable cross-run key: rules are identified by their source
+     * locator and version, which survive re-running the same program */
+    static std::string key(const Relation& rel, const Rule& rule) {
+        std::string res = rel.getName() + " " + rule.getLocator();
+        if (rule.getVersion() > 0) {
+            res += " [v" + std::to_string(rule.getVersion()) + "]";
+        }
+        return res;
+    }
+
+    static std::map<std::string, Entry> collect(const ProgramRun& run) {
+        std::map<std::string, Entry> res;
+        for (const auto& cur : run.getRelationMap()) {
+            const auto& rel = cur.second;
+            Entry& relEntry = res["relation " + rel->getName()];
+            relEntry.time = rel->getNonRecTime() + rel->getRecTime() + rel->getCopyTime();
+            relEntry.tuples = rel->size();
+            relEntry.iterations = rel->getIterations().size();
+            for (const auto& rulePair : rel->getRuleMap()) {
+                Entry& e = res["rule " + key(*rel, *rulePair.second)];
+                e.time += rulePair.second->getRuntime();
+                e.tuples += rulePair.second->size();
+            }
+            for (const auto& rule : rel->getRuleRecList()) {
+                Entry& e = res["rule " + key(*rel, *rule)];
+                e.time += rule->getRuntime();
+                e.tuples += rule->size();
+                e.iterations++;
+            }
+        }
+        return res;
+    }
+
+public:
+    Compare(const std::string& baselineFile, const std::string& currentFile, double threshold)
+            : baseline(std::make_shared<ProgramRun>(ProgramRun())),
+              current(std::make_shared<ProgramRun>(ProgramRun())), threshold(threshold) {
+        // the reader replaces the singleton profile database wholly, so
+        // the two files can be processed one after the other
+        Reader baselineReader(baselineFile, baseline);
+        baselineReader.processFile();
+        Reader currentReader(currentFile, current);
+        currentReader.processFile();
+    }
+
+    /**
+     * Prints all regressions beyond the threshold.
+     *
+     * @return the number of regressions found
+     */
+    int run() {
+        std::cout << "baseline total runtime: " << baseline->getRuntime()
+                  << ", current total runtime: " << current->getRuntime() << "\n";
+        auto before = collect(*baseline);
+        auto after = collect(*current);
+        int regressions = 0;
+        for (const auto& cur : after) {
+            auto pos = before.find(cur.first);
+            if (pos == before.end()) {
+                std::cout << "new        " << cur.first << ": "
+                          << Tools::formatTime(cur.second.time) << ", " << cur.second.tuples
+                          << " tuples\n";
+                continue;
+            }
+            const Entry& was = pos->second;
+            const Entry& is = cur.second;
+            if (is.time < MIN_TIME || was.time.count() == 0 ||
+                    static_cast<double>(is.time.count()) <
+                            threshold * static_cast<double>(was.time.count())) {
+                continue;
+            }
+            double factor = static_cast<double>(is.time.count()) / static_cast<double>(was.time.count());
+            std::cout << "regression " << cur.first << ": time " << Tools::formatTime(was.time)
+                      << " -> " << Tools::formatTime(is.time) << " (" << Tools::formatNum(factor)
+                      << "x), tuples " << was.tuples << " -> " << is.tuples;
+            if (was.iterations != is.iterations) {
+                std::cout << ", iterations " << was.iterations << " -> " << is.iterations;
+            }
+            std::cout << "\n";
+            ++regressions;
+        }
+        for (const auto& cur : before) {
+            if (after.find(cur.first) == after.end()) {
+                std::cout << "removed    " << cur.first << "\n";
+            }
+        }
+        if (regressions == 0) {
+            std::cout << "no regressions beyond " << Tools::formatNum(threshold) << "x found\n";
+        } else {
+            std::cout << regressions << " regression(s) beyond " << Tools::formatNum(threshold)
+                      << "x found\n";
+        }
+        return regressions;
+    }
+};
+
+}  // namespace profile
+}  // namespace souffle
@@ -27,6 +27,9 @@ private:
     std::chrono::microseconds starttime{};
     std::chrono::microseconds endtime{};
     size_t numTuples = 0;
+    size_t cycles = 0;
+    size_t cacheMisses = 0;
+    size_t branchMisses = 0;
     std::chrono::microseconds copytime{};
     std::string locator = "";
 
@@ -75,6 +78,30 @@ public:
         this->numTuples = numTuples;
     }
 
+    size_t getCycles() const {
+        return cycles;
+    }
+
+    size_t getCacheMisses() const {
+        return cacheMisses;
+    }
+
+    size_t getBranchMisses() const {
+        return branchMisses;
+    }
+
+    void addCycles(size_t cycles) {
+        this->cycles += cycles;
+    }
+
+    void addCacheMisses(size_t cacheMisses) {
+        this->cacheMisses += cacheMisses;
+    }
+
+    void addBranchMisses(size_t branchMisses) {
+        this->branchMisses += branchMisses;
+    }
+
     std::chrono::microseconds getCopytime() const {
         return copytime;
     }
@@ -69,6 +69,7 @@ public:
  * ROW[10] = SAVETIME
  * ROW[11] = MAXRSSDIFF
  * ROW[12] = READS
+ * ROW[13] = MEMORY
  *
  */
 Table inline OutputProcessor::getRelTable() const {
@@ -77,7 +78,7 @@ Table inline OutputProcessor::getRelTable() const {
     Table table;
     for (auto& rel : relationMap) {
         std::shared_ptr<Relation> r = rel.second;
-        Row row(13);
+        Row row(14);
         auto total_time = r->getNonRecTime() + r->getRecTime() + r->getCopyTime();
         row[0] = std::make_shared<Cell<std::chrono::microseconds>>(total_time);
         row[1] = std::make_shared<Cell<std::chrono::microseconds>>(r->getNonRecTime());
@@ -96,6 +97,7 @@ Table inline OutputProcessor::getRelTable() const {
         row[10] = std::make_shared<Cell<std::chrono::microseconds>>(r->getSavetime());
         row[11] = std::make_shared<Cell<long>>(r->getMaxRSSDiff());
         row[12] = std::make_shared<Cell<long>>(r->getReads());
+        row[13] = std::make_shared<Cell<long>>(r->getMemory());
 
         table.addRow(std::make_shared<Row>(row));
     }
@@ -52,6 +52,12 @@ public:
     void visit(SizeEntry& size) override {
         if (size.getKey() == "num-tuples") {
             base.setNumTuples(size.getSize());
+        } else if (size.getKey() == "cpu-cycles") {
+            base.addCycles(size.getSize());
+        } else if (size.getKey() == "cache-misses") {
+            base.addCacheMisses(size.getSize());
+        } else if (size.getKey() == "branch-misses") {
+            base.addBranchMisses(size.getSize());
         }
     }
     void visit(DirectoryEntry& ruleEntry) override {}
@@ -258,6 +264,8 @@ public:
     void visit(SizeEntry& size) override {
         if (size.getKey() == "reads") {
             base.addReads(size.getSize());
+        } else if (size.getKey() == "memory") {
+            base.setMemory(size.getSize());
         } else {
             DSNVisitor::visit(size);
         }
@@ -32,6 +32,9 @@ private:
     std::chrono::microseconds loadtime{};
     std::chrono::microseconds savetime{};
     long nonRecTuples = 0;
+    size_t nonRecCycles = 0;
+    size_t nonRecCacheMisses = 0;
+    size_t nonRecBranchMisses = 0;
     size_t preMaxRSS = 0;
     size_t postMaxRSS = 0;
     const std::string id;
@@ -39,6 +42,7 @@ private:
     int ruleId = 0;
     int recursiveId = 0;
     size_t tuplesRead = 0;
+    size_t memory = 0;
 
     std::vector<std::shared_ptr<Iteration>> iterations;
 
@@ -111,6 +115,42 @@ public:
         return nonRecTuples + result;
     }
 
+    size_t getCycles() const {
+        size_t result = nonRecCycles;
+        for (auto& iter : iterations) {
+            result += iter->getCycles();
+        }
+        return result;
+    }
+
+    size_t getCacheMisses() const {
+        size_t result = nonRecCacheMisses;
+        for (auto& iter : iterations) {
+            result += iter->getCacheMisses();
+        }
+        return result;
+    }
+
+    size_t getBranchMisses() const {
+        size_t result = nonRecBranchMisses;
+        for (auto& iter : iterations) {
+            result += iter->getBranchMisses();
+        }
+        return result;
+    }
+
+    void addCycles(size_t cycles) {
+        nonRecCycles += cycles;
+    }
+
+    void addCacheMisses(size_t cacheMisses) {
+        nonRecCacheMisses += cacheMisses;
+    }
+
+    void addBranchMisses(size_t branchMisses) {
+        nonRecBranchMisses += branchMisses;
+    }
+
     size_t getMaxRSSDiff() const {
         return postMaxRSS - preMaxRSS;
     }
@@ -246,6 +286,14 @@ public:
     void addReads(size_t tuplesRead) {
         this->tuplesRead += tuplesRead;
     }
+
+    size_t getMemory() const {
+        return memory;
+    }
+
+    void setMemory(size_t memory) {
+        this->memory = memory;
+    }
 };
 
 }  // namespace profile
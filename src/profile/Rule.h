@@ -50,6 +50,9 @@ protected:
     std::chrono::microseconds starttime{};
     std::chrono::microseconds endtime{};
     long numTuples{0};
+    size_t cycles = 0;
+    size_t cacheMisses = 0;
+    size_t branchMisses = 0;
     std::string identifier;
     std::string locator{};
     std::set<Atom> atoms;
@@ -96,6 +99,30 @@ public:
         this->numTuples = numTuples;
     }
 
+    size_t getCycles() const {
+        return cycles;
+    }
+
+    size_t getCacheMisses() const {
+        return cacheMisses;
+    }
+
+    size_t getBranchMisses() const {
+        return branchMisses;
+    }
+
+    void addCycles(size_t cycles) {
+        this->cycles += cycles;
+    }
+
+    void addCacheMisses(size_t cacheMisses) {
+        this->cacheMisses += cacheMisses;
+    }
+
+    void addBranchMisses(size_t branchMisses) {
+        this->branchMisses += branchMisses;
+    }
+
     void addAtomFrequency(const std::string& subruleName, std::string atom, size_t level, size_t frequency) {
         atoms.emplace(atom, subruleName, level, frequency);
     }
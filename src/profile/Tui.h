@@ -21,6 +21,8 @@
 #include <memory>
 #include <string>
 #include <thread>
+#include <unordered_map>
+#include <utility>
 #include <vector>
 #include <dirent.h>
 #include <sys/ioctl.h>
@@ -167,6 +169,8 @@ public:
             }
         } else if (c[0].compare("memory") == 0) {
             memoryUsage();
+        } else if (c[0].compare("index") == 0) {
+            indexStats();
         } else if (c[0].compare("usage") == 0) {
             if (c.size() > 1) {
                 if (c[1][0] == 'R') {
@@ -189,6 +193,8 @@ public:
                     std::cout << "Invalid parameters to limit command.\n";
                 }
             }
+        } else if (c[0].compare("counters") == 0) {
+            counters();
         } else if (c[0].compare("configuration") == 0) {
             configuration();
         } else {
@@ -685,6 +691,10 @@ public:
         std::printf("  %-30s%-5s %s\n", "usage [relation id|rule id]", "-",
                 "display CPU usage graphs for a relation or rule.");
         std::printf("  %-30s%-5s %s\n", "memory", "-", "display memory usage.");
+        std::printf("  %-30s%-5s %s\n", "index", "-",
+                "display per-index data structure statistics (--data-structure-stats runs).");
+        std::printf("  %-30s%-5s %s\n", "counters", "-",
+                "display hardware performance counters per relation and rule.");
         std::printf("  %-30s%-5s %s\n", "help", "-", "print this.");
 
         std::cout << "\nInteractive mode only commands:" << std::endl;
@@ -965,6 +975,53 @@ public:
         }
         std::cout << std::endl;
     }
+    void indexStats() {
+        auto* relations = dynamic_cast<DirectoryEntry*>(
+                ProfileEventSingleton::instance().getDB().lookupEntry({"program", "relation"}));
+        if (relations == nullptr) {
+            std::cout << "No relations recorded in this profile.\n";
+            return;
+        }
+        std::cout << " ----- Index Statistics -----\n";
+        std::printf("%12s%10s%7s%7s%10s%12s %s\n\n", "TUPLES", "NODES", "DEPTH", "FILL", "MEM", "HITS",
+                "RELATION [INDEX]");
+        bool found = false;
+        for (const auto& relationName : relations->getKeys()) {
+            auto* relation = relations->readDirectoryEntry(relationName);
+            if (relation == nullptr) {
+                continue;
+            }
+            auto* indexes = dynamic_cast<DirectoryEntry*>(relation->readEntry("index-stats"));
+            if (indexes == nullptr) {
+                continue;
+            }
+            for (const auto& order : indexes->getKeys()) {
+                auto* metrics = dynamic_cast<DirectoryEntry*>(indexes->readEntry(order));
+                if (metrics == nullptr) {
+                    continue;
+                }
+                auto metric = [&](const std::string& key) -> size_t {
+                    auto* entry = dynamic_cast<SizeEntry*>(metrics->readEntry(key));
+                    return entry == nullptr ? 0 : entry->getSize();
+                };
+                std::string fill = metrics->readEntry("fill") == nullptr
+                                           ? "-"
+                                           : std::to_string(metric("fill")) + "%";
+                std::printf("%12s%10s%7s%7s%10s%12s %s\n",
+                        std::to_string(metric("elements")).c_str(), std::to_string(metric("nodes")).c_str(),
+                        std::to_string(metric("depth")).c_str(), fill.c_str(),
+                        Tools::formatMemory(metric("memory") / 1024).c_str(),
+                        std::to_string(metric("hits")).c_str(),
+                        (relationName + " [" + order + "]").c_str());
+                found = true;
+            }
+        }
+        if (!found) {
+            std::cout << "No index statistics recorded; run souffle with --data-structure-stats "
+                         "and profiling enabled.\n";
+        }
+    }
+
     void setupTabCompletion() {
         linereader.clearTabCompletion();
 
@@ -977,6 +1034,8 @@ public:
         linereader.appendTabCompletion("usage");
         linereader.appendTabCompletion("limit ");
         linereader.appendTabCompletion("memory");
+        linereader.appendTabCompletion("index");
+        linereader.appendTabCompletion("counters");
         linereader.appendTabCompletion("configuration");
 
         // add rel tab completes after the rest so users can see all commands first
@@ -1069,9 +1128,10 @@ public:
     void rel(size_t limit, bool showLimit = true) {
         relationTable.sort(sortColumn);
         std::cout << " ----- Relation Table -----\n";
-        std::printf("%8s%8s%8s%8s%8s%8s%8s%8s%8s%6s %s\n\n", "TOT_T", "NREC_T", "REC_T", "COPY_T", "LOAD_T",
-                "SAVE_T", "TUPLES", "READS", "TUP/s", "ID", "NAME");
+        std::printf("%8s%8s%8s%8s%8s%8s%8s%8s%8s%8s%6s %s\n\n", "TOT_T", "NREC_T", "REC_T", "COPY_T",
+                "LOAD_T", "SAVE_T", "TUPLES", "READS", "MEM", "TUP/s", "ID", "NAME");
         size_t count = 0;
+        auto rows = relationTable.getRows();
         for (auto& row : Tools::formatTable(relationTable, precision)) {
             if (++count > limit) {
                 if (showLimit) {
@@ -1080,9 +1140,12 @@ public:
                 }
                 break;
             }
-            std::printf("%8s%8s%8s%8s%8s%8s%8s%8s%8s%6s %s\n", row[0].c_str(), row[1].c_str(), row[2].c_str(),
-                    row[3].c_str(), row[9].c_str(), row[10].c_str(), row[4].c_str(), row[12].c_str(),
-                    row[8].c_str(), row[6].c_str(), row[5].c_str());
+            // the memory footprint is recorded in bytes; pretty-print it
+            // rather than showing a raw count
+            std::string memory = Tools::formatMemory((*rows[count - 1])[13]->getLongVal() / 1024);
+            std::printf("%8s%8s%8s%8s%8s%8s%8s%8s%8s%8s%6s %s\n", row[0].c_str(), row[1].c_str(),
+                    row[2].c_str(), row[3].c_str(), row[9].c_str(), row[10].c_str(), row[4].c_str(),
+                    row[12].c_str(), memory.c_str(), row[8].c_str(), row[6].c_str(), row[5].c_str());
         }
     }
 
@@ -1104,6 +1167,95 @@ public:
         }
     }
 
+    void counters() {
+        const std::shared_ptr<ProgramRun>& run = out.getProgramRun();
+
+        // gather relations with counter data, sorted by consumed cycles
+        std::vector<std::shared_ptr<Relation>> relations;
+        for (auto& cur : run->getRelationMap()) {
+            relations.push_back(cur.second);
+        }
+        std::sort(relations.begin(), relations.end(),
+                [](const std::shared_ptr<Relation>& a, const std::shared_ptr<Relation>& b) {
+                    return a->getCycles() > b->getCycles();
+                });
+
+        size_t totalCycles = 0;
+        for (auto& relation : relations) {
+            totalCycles += relation->getCycles();
+        }
+        if (totalCycles == 0) {
+            std::cout << "No hardware counter data recorded in this profile.\n";
+            std::cout << "Counters require perf_event support and access to the PMU.\n";
+            return;
+        }
+
+        std::cout << " ----- Counters of Relations -----\n";
+        std::printf("%8s%10s%10s%10s%6s %s\n\n", "CYCLES", "LLC_MISS", "BR_MISS", "MISS/K_CYC", "ID", "NAME");
+        size_t count = 0;
+        for (auto& relation : relations) {
+            if (++count > resultLimit) {
+                std::cout << (relations.size() - resultLimit) << " rows not shown" << std::endl;
+                break;
+            }
+            double missRate =
+                    relation->getCycles() == 0
+                            ? 0.0
+                            : 1000.0 * static_cast<double>(relation->getCacheMisses()) /
+                                      static_cast<double>(relation->getCycles());
+            std::printf("%8s%10s%10s%10.2f%6s %s\n",
+                    run->formatNum(precision, relation->getCycles()).c_str(),
+                    run->formatNum(precision, relation->getCacheMisses()).c_str(),
+                    run->formatNum(precision, relation->getBranchMisses()).c_str(), missRate,
+                    relation->getId().c_str(), relation->getName().c_str());
+        }
+
+        // aggregate rule counters over iterations, keyed by rule id
+        struct RuleCounters {
+            size_t cycles = 0;
+            size_t cacheMisses = 0;
+            size_t branchMisses = 0;
+            std::string relation;
+        };
+        std::unordered_map<std::string, RuleCounters> ruleCounters;
+        for (auto& relation : relations) {
+            for (auto& rule : relation->getRuleMap()) {
+                auto& entry = ruleCounters[rule.second->getId()];
+                entry.cycles += rule.second->getCycles();
+                entry.cacheMisses += rule.second->getCacheMisses();
+                entry.branchMisses += rule.second->getBranchMisses();
+                entry.relation = relation->getName();
+            }
+            for (auto& rule : relation->getRuleRecList()) {
+                auto& entry = ruleCounters[rule->getId()];
+                entry.cycles += rule->getCycles();
+                entry.cacheMisses += rule->getCacheMisses();
+                entry.branchMisses += rule->getBranchMisses();
+                entry.relation = relation->getName();
+            }
+        }
+        std::vector<std::pair<std::string, RuleCounters>> rules(ruleCounters.begin(), ruleCounters.end());
+        std::sort(rules.begin(), rules.end(),
+                [](const std::pair<std::string, RuleCounters>& a,
+                        const std::pair<std::string, RuleCounters>& b) {
+                    return a.second.cycles > b.second.cycles;
+                });
+
+        std::cout << "\n ----- Counters of Rules -----\n";
+        std::printf("%8s%10s%10s%8s %s\n\n", "CYCLES", "LLC_MISS", "BR_MISS", "ID", "RELATION");
+        count = 0;
+        for (auto& rule : rules) {
+            if (++count > resultLimit) {
+                std::cout << (rules.size() - resultLimit) << " rows not shown" << std::endl;
+                break;
+            }
+            std::printf("%8s%10s%10s%8s %s\n", run->formatNum(precision, rule.second.cycles).c_str(),
+                    run->formatNum(precision, rule.second.cacheMisses).c_str(),
+                    run->formatNum(precision, rule.second.branchMisses).c_str(), rule.first.c_str(),
+                    rule.second.relation.c_str());
+        }
+    }
+
     void id(std::string col) {
         ruleTable.sort(6);
         std::vector<std::vector<std::string>> table = Tools::formatTable(ruleTable, precision);
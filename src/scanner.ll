@@ -24,6 +24,7 @@
 #endif
 
     #include <stdio.h>
+    #include <stdint.h>
     #include <libgen.h>
     #include <ctype.h>
     #include <sys/stat.h>
@@ -102,6 +103,12 @@
 "inline"                              { return yy::parser::make_INLINE_QUALIFIER(yylloc); }
 "brie"                                { return yy::parser::make_BRIE_QUALIFIER(yylloc); }
 "btree"                               { return yy::parser::make_BTREE_QUALIFIER(yylloc); }
+"columnar"                            { return yy::parser::make_COLUMNAR_QUALIFIER(yylloc); }
+"bitset"                              { return yy::parser::make_BITSET_QUALIFIER(yylloc); }
+"subsumption"                         { return yy::parser::make_SUBSUMPTION_QUALIFIER(yylloc); }
+"functional"                          { return yy::parser::make_FUNCTIONAL_QUALIFIER(yylloc); }
+"auto"                                { return yy::parser::make_AUTO_QUALIFIER(yylloc); }
+"grouped"                             { return yy::parser::make_GROUPED_QUALIFIER(yylloc); }
 "min"                                 { return yy::parser::make_MIN(yylloc); }
 "max"                                 { return yy::parser::make_MAX(yylloc); }
 "as"                                  { return yy::parser::make_AS(yylloc); }
@@ -178,12 +185,18 @@
                                         }
                                       }
 0|([1-9][0-9]*)                       {
-                                        try {
-                                          return yy::parser::make_NUMBER(std::stoull(yytext, NULL, 10), yylloc);
-                                        } catch (...) {
-                                          driver.error(yylloc, "int out of range");
-                                          return yy::parser::make_NUMBER(0, yylloc);
+                                        /* the pattern guarantees plain decimal digits, so convert
+                                           inline instead of through the locale-aware std::stoull */
+                                        uint64_t value = 0;
+                                        for (const char* s = yytext; *s != 0; ++s) {
+                                          uint64_t digit = (uint64_t)(*s - '0');
+                                          if (value > (UINT64_MAX - digit) / 10) {
+                                            driver.error(yylloc, "int out of range");
+                                            return yy::parser::make_NUMBER(0, yylloc);
+                                          }
+                                          value = value * 10 + digit;
                                         }
+                                        return yy::parser::make_NUMBER((RamDomain)value, yylloc);
                                       }
 [\?a-zA-Z]|[_\?a-zA-Z][_\?a-zA-Z0-9]+ {
                                         return yy::parser::make_IDENT(SLOOKUP(yytext), yylloc);
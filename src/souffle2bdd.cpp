@@ -48,8 +48,10 @@
 #include <chrono>
 #include <cstdio>
 #include <cstdlib>
+#include <deque>
 #include <exception>
 #include <fstream>
+#include <future>
 #include <iostream>
 #include <iterator>
 #include <limits>
@@ -57,6 +59,7 @@
 #include <sstream>
 #include <stdexcept>
 #include <string>
+#include <thread>
 #include <utility>
 #include <vector>
 
@@ -121,11 +124,31 @@ private:
         }
         out << "\n";
 
-        // rules
-        for (const auto& rel : program.getRelations()) {
+        // rules -- the clauses of each relation are translated by an
+        // independent worker into its own buffer, and the buffers are written
+        // in declaration order as they complete; the window keeps at most one
+        // translated relation per worker in memory instead of the whole
+        // translated program (the auxiliary variables introduced for functors
+        // are clause-local, so the per-worker counters cannot clash)
+        const auto relations = program.getRelations();
+        auto translateRelation = [](const AstRelation* rel) {
+            BddBddBTranslator worker;
+            std::stringstream text;
             for (const auto& clause : rel->getClauses()) {
-                visit(*clause, out);
+                worker.visit(*clause, text);
+            }
+            return text.str();
+        };
+        std::size_t numThreads = std::max(1u, std::thread::hardware_concurrency());
+        std::deque<std::future<std::string>> pending;
+        std::size_t next = 0;
+        while (next < relations.size() || !pending.empty()) {
+            while (next < relations.size() && pending.size() < numThreads) {
+                pending.push_back(std::async(std::launch::async, translateRelation, relations[next++]));
             }
+            // conversion errors of the workers re-surface here
+            out << pending.front().get();
+            pending.pop_front();
         }
         out << "\n";
     }
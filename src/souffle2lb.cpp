@@ -47,14 +47,17 @@
 #include <chrono>
 #include <cstdio>
 #include <cstdlib>
+#include <deque>
 #include <exception>
 #include <fstream>
+#include <future>
 #include <iostream>
 #include <iterator>
 #include <memory>
 #include <sstream>
 #include <stdexcept>
 #include <string>
+#include <thread>
 #include <utility>
 #include <vector>
 
@@ -78,22 +81,22 @@ class LogicbloxConverter : private AstVisitor<void, std::ostream&> {
     std::vector<std::string> extra_literals;
     const IOType* ioTypes = nullptr;
 
-    std::ostream& iout;
-    std::ostream& eout;
-    std::ostream& dout;
+    std::ostream* iout = nullptr;
+    std::ostream* eout = nullptr;
+    std::ostream* dout = nullptr;
 
 public:
     LogicbloxConverter(std::ostream& imOut, std::ostream& exOut, std::ostream& decOut)
-            : iout(imOut), eout(exOut), dout(decOut) {
-        iout << "option,delimiter,\"\\t\"\n";
-        iout << "option,hasColumnNames,false\n";
-        iout << "\n";
-        iout << "\n";
-
-        eout << "option,delimiter,\"\\t\"\n";
-        eout << "option,hasColumnNames,false\n";
-        eout << "\n";
-        eout << "\n";
+            : iout(&imOut), eout(&exOut), dout(&decOut) {
+        *iout << "option,delimiter,\"\\t\"\n";
+        *iout << "option,hasColumnNames,false\n";
+        *iout << "\n";
+        *iout << "\n";
+
+        *eout << "option,delimiter,\"\\t\"\n";
+        *eout << "option,hasColumnNames,false\n";
+        *eout << "\n";
+        *eout << "\n";
     }
 
     void convert(std::ostream& out, const AstTranslationUnit& tu) {
@@ -102,6 +105,10 @@ public:
     }
 
 private:
+    // light-weight converter for the clause translation workers; it never
+    // touches the import/export/declaration streams
+    LogicbloxConverter() = default;
+
     AstTypeIdentifier convertTypeName(const AstTypeIdentifier& name) {
         if (name == "number") {
             return AstTypeIdentifier("int[32]");
@@ -122,11 +129,30 @@ private:
         }
         out << "\n";
 
-        // rules
-        for (const auto& rel : program.getRelations()) {
+        // rules -- the clauses of each relation are translated by an
+        // independent worker into its own buffer, and the buffers are written
+        // in declaration order as they complete; the window keeps at most one
+        // translated relation per worker in memory instead of the whole
+        // translated program
+        const auto relations = program.getRelations();
+        auto translateRelation = [](const AstRelation* rel) {
+            LogicbloxConverter worker;
+            std::stringstream text;
             for (const auto& clause : rel->getClauses()) {
-                visit(*clause, out);
+                worker.visit(*clause, text);
+            }
+            return text.str();
+        };
+        std::size_t numThreads = std::max(1u, std::thread::hardware_concurrency());
+        std::deque<std::future<std::string>> pending;
+        std::size_t next = 0;
+        while (next < relations.size() || !pending.empty()) {
+            while (next < relations.size() && pending.size() < numThreads) {
+                pending.push_back(std::async(std::launch::async, translateRelation, relations[next++]));
             }
+            // conversion errors of the workers re-surface here
+            out << pending.front().get();
+            pending.pop_front();
         }
         out << "\n";
     }
@@ -135,54 +161,54 @@ private:
      * Converting a relation by creating its declaration.
      */
     void visitRelation(const AstRelation& rel, std::ostream& /* out */) override {
-        visitRelationIdentifier(rel.getName(), dout);
+        visitRelationIdentifier(rel.getName(), *dout);
 
         // make nullary relations single-element relations
-        dout << "(";
-        dout << join(rel.getAttributes(), ",",
+        *dout << "(";
+        *dout << join(rel.getAttributes(), ",",
                 [&](std::ostream& os, AstAttribute* cur) { os << cur->getAttributeName(); });
-        dout << ") -> ";
+        *dout << ") -> ";
 
-        dout << join(rel.getAttributes(), ",", [&](std::ostream& os, AstAttribute* cur) {
+        *dout << join(rel.getAttributes(), ",", [&](std::ostream& os, AstAttribute* cur) {
             os << convertTypeName(cur->getTypeName()) << "(" << cur->getAttributeName() << ")";
         });
 
-        dout << ".";
-        dout << "\n";
+        *dout << ".";
+        *dout << "\n";
 
         if (ioTypes->isInput(&rel)) {
             int i = 0;
-            iout << "fromFile,"
-                 << "\"" << rel.getName() << ".facts\",";
-            iout << join(rel.getAttributes(), ",", [&](std::ostream& os, AstAttribute* cur) {
+            *iout << "fromFile,"
+                  << "\"" << rel.getName() << ".facts\",";
+            *iout << join(rel.getAttributes(), ",", [&](std::ostream& os, AstAttribute* cur) {
                 os << "column:" << (i) << "," << rel.getName() << ":" << (i);
                 i++;
             });
-            iout << "\n";
-            iout << "toPredicate," << rel.getName() << ",";
+            *iout << "\n";
+            *iout << "toPredicate," << rel.getName() << ",";
             i = 0;
-            iout << join(rel.getAttributes(), ",", [&](std::ostream& os, AstAttribute* cur) {
+            *iout << join(rel.getAttributes(), ",", [&](std::ostream& os, AstAttribute* cur) {
                 os << rel.getName() << ":" << (i);
                 i++;
             });
-            iout << "\n";
+            *iout << "\n";
         }
         if (ioTypes->isOutput(&rel)) {
             int i = 0;
-            eout << "fromPredicate," << rel.getName() << ",";
-            eout << join(rel.getAttributes(), ",", [&](std::ostream& os, AstAttribute* cur) {
+            *eout << "fromPredicate," << rel.getName() << ",";
+            *eout << join(rel.getAttributes(), ",", [&](std::ostream& os, AstAttribute* cur) {
                 os << rel.getName() << ":" << (i);
                 i++;
             });
-            eout << "\n";
+            *eout << "\n";
             i = 0;
-            eout << "toFile,"
-                 << "\"" << rel.getName() << ".csv\",";
-            eout << join(rel.getAttributes(), ",", [&](std::ostream& os, AstAttribute* cur) {
+            *eout << "toFile,"
+                  << "\"" << rel.getName() << ".csv\",";
+            *eout << join(rel.getAttributes(), ",", [&](std::ostream& os, AstAttribute* cur) {
                 os << "column:" << (i) << "," << rel.getName() << ":" << (i);
                 i++;
             });
-            eout << "\n";
+            *eout << "\n";
         }
     }
 
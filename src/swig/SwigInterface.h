@@ -26,6 +26,81 @@
 
 #pragma once
 
+/**
+ * Materialized column-major copy of a relation for bulk export.
+ *
+ * The tuples of a relation are copied once into a flat array of rows() x
+ * cols() RamDomain values, where column j occupies the elements
+ * data()[j * rows()] to data()[j * rows() + rows() - 1]. Elements of
+ * string type are stored as their ordinal in the symbol table of the
+ * program (see SWIGSouffleProgram::dumpSymbolTable), so the whole buffer
+ * can be handed to a numpy/pandas style consumer as one block instead of
+ * crossing the language boundary once per field.
+ */
+class SWIGSouffleRelationBuffer {
+    /**
+     * flat column-major tuple storage
+     */
+    std::vector<souffle::RamDomain> buffer;
+
+    /**
+     * number of tuples held by the buffer
+     */
+    std::size_t numRows = 0;
+
+    /**
+     * arity of the copied relation
+     */
+    std::size_t numCols = 0;
+
+public:
+    SWIGSouffleRelationBuffer(const souffle::Relation& relation)
+            : buffer(relation.size() * relation.getArity()), numCols(relation.getArity()) {
+        std::vector<souffle::RamDomain*> columns(numCols);
+        for (std::size_t j = 0; j < numCols; j++) {
+            columns[j] = buffer.data() + j * relation.size();
+        }
+        numRows = relation.extract(columns.data());
+    }
+
+    /**
+     * Returns the number of tuples held by the buffer
+     */
+    std::size_t rows() const {
+        return numRows;
+    }
+
+    /**
+     * Returns the arity of the copied relation
+     */
+    std::size_t cols() const {
+        return numCols;
+    }
+
+    /**
+     * Returns the size of a single element in bytes, for choosing the
+     * matching integer dtype on the consuming side
+     */
+    std::size_t elementSize() const {
+        return sizeof(souffle::RamDomain);
+    }
+
+    /**
+     * Returns the start of the flat column-major storage; valid for the
+     * lifetime of this buffer
+     */
+    const souffle::RamDomain* data() const {
+        return buffer.data();
+    }
+
+    /**
+     * Element access for target languages without buffer support
+     */
+    long get(std::size_t row, std::size_t col) const {
+        return buffer[col * numRows + row];
+    }
+};
+
 /**
  * Abstract base class for generated Datalog programs
  */
@@ -83,6 +158,41 @@ public:
     void dumpOutputs(std::ostream& out = std::cout) {
         program->dumpOutputs(out);
     }
+
+    /**
+     * Calls the corresponding method souffle::SouffleProgram::reset in SouffleInterface.h
+     */
+    void reset() {
+        program->reset();
+    }
+
+    /**
+     * Copies the relation of the given name into a flat buffer through
+     * souffle::Relation::extract, suitable for bulk transfer into the
+     * host language; returns null if no such relation exists. The caller
+     * owns the returned buffer.
+     */
+    SWIGSouffleRelationBuffer* getRelationBuffer(const std::string& name) {
+        souffle::Relation* relation = program->getRelation(name);
+        if (relation == nullptr) {
+            return nullptr;
+        }
+        return new SWIGSouffleRelationBuffer(*relation);
+    }
+
+    /**
+     * Returns all symbols of the program ordered by their ordinal, for
+     * translating the string columns of exported relation buffers in a
+     * single call.
+     */
+    std::vector<std::string> dumpSymbolTable() {
+        souffle::SymbolTable& symbolTable = program->getSymbolTable();
+        std::vector<std::string> symbols(symbolTable.size());
+        for (std::size_t i = 0; i < symbols.size(); i++) {
+            symbols[i] = std::string(symbolTable.resolve(static_cast<souffle::RamDomain>(i)));
+        }
+        return symbols;
+    }
 };
 
 /**
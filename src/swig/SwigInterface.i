@@ -21,6 +21,7 @@
 %include<std_vector.i>
 namespace std {
     %template(map_string_string) map<string, string>;
+    %template(vector_string) vector<string>;
 }
 
 %{
@@ -35,6 +36,25 @@ souffle::Relation* rel;
 souffle::Relation* rel_out;
 %}
 
-%include "SwigInterface.h" 
+%newobject SWIGSouffleProgram::getRelationBuffer;
+%include "SwigInterface.h"
 %newobject newInstance;
 SWIGSouffleProgram* newInstance(const std::string& name);
+
+#ifdef SWIGPYTHON
+%extend SWIGSouffleRelationBuffer {
+    /**
+     * Zero-copy buffer-protocol view of the column-major tuple storage;
+     * reshape on the Python side via
+     * numpy.frombuffer(buf.view(), dtype).reshape(cols, rows).T
+     * with the dtype matching elementSize(). The view is only valid
+     * while this buffer is alive.
+     */
+    PyObject* view() {
+        return PyMemoryView_FromMemory(
+                reinterpret_cast<char*>(const_cast<souffle::RamDomain*>($self->data())),
+                static_cast<Py_ssize_t>($self->rows() * $self->cols() * $self->elementSize()),
+                PyBUF_READ);
+    }
+}
+#endif
@@ -317,43 +317,23 @@ TEST(SparseArray, LowerBound) {
 }
 
 TEST(SparseArray, MemoryUsage) {
-    if (sizeof(void*) > 4) {
-        SparseArray<int> a;
-
-        // an empty one should be small
-        EXPECT_TRUE(a.empty());
-        // EXPECT_EQ(56, a.getMemoryUsage());
-        EXPECT_EQ(40, a.getMemoryUsage());
-
-        // a single element should have the same size as an empty one
-        a.update(12, 15);
-        EXPECT_FALSE(a.empty());
-        // EXPECT_EQ(56, a.getMemoryUsage());
-        EXPECT_EQ(560, a.getMemoryUsage());
-
-        // more than one => there are nodes
-        a.update(14, 18);
-        EXPECT_FALSE(a.empty());
-
-        // EXPECT_EQ(576, a.getMemoryUsage());
-        EXPECT_EQ(560, a.getMemoryUsage());
-    } else {
-        SparseArray<int> a;
-
-        // an empty one should be small
-        EXPECT_TRUE(a.empty());
-        EXPECT_EQ(28, a.getMemoryUsage());
-
-        // a single element should have the same size as an empty one
-        a.update(12, 15);
-        EXPECT_FALSE(a.empty());
-        EXPECT_EQ(288, a.getMemoryUsage());
-
-        // more than one => there are nodes
-        a.update(14, 18);
-        EXPECT_FALSE(a.empty());
-        EXPECT_EQ(288, a.getMemoryUsage());
-    }
+    SparseArray<int> a;
+
+    // an empty one should not hold any node storage
+    EXPECT_TRUE(a.empty());
+    auto empty_usage = a.getMemoryUsage();
+    EXPECT_EQ(sizeof(SparseArray<int>), empty_usage);
+
+    // a single element causes a chunk of nodes to be reserved
+    a.update(12, 15);
+    EXPECT_FALSE(a.empty());
+    auto one_usage = a.getMemoryUsage();
+    EXPECT_TRUE(empty_usage < one_usage);
+
+    // a second element in the same leaf does not require more memory
+    a.update(14, 18);
+    EXPECT_FALSE(a.empty());
+    EXPECT_EQ(one_usage, a.getMemoryUsage());
 }
 
 TEST(SparseBitMap, Basic) {
@@ -576,6 +576,43 @@ TEST(BTreeSet, ChunkSplitStress) {
     }
 }
 
+TEST(BTreeSet, PartitionBalance) {
+    using test_set = btree_set<int, detail::comparator<int>, std::allocator<int>, 16>;
+
+    test_set t;
+    for (int i = 0; i < 50000; i++) {
+        t.insert(i);
+    }
+
+    for (std::size_t j = 2; j < 20; j++) {
+        auto chunks = t.partition(j);
+        ASSERT_TRUE(!chunks.empty());
+
+        // the chunks cover all elements in order
+        int last = -1;
+        std::size_t total = 0;
+        for (const auto& cur : chunks) {
+            for (auto it = cur.begin(); it != cur.end(); ++it) {
+                EXPECT_EQ(last + 1, *it);
+                last = *it;
+                total++;
+            }
+        }
+        EXPECT_EQ(50000, last + 1);
+
+        // no chunk dominates the partition: each is bounded by twice the
+        // average plus the split-point granularity
+        std::size_t bound = 2 * (total / chunks.size()) + 256;
+        for (const auto& cur : chunks) {
+            std::size_t size = 0;
+            for (auto it = cur.begin(); it != cur.end(); ++it) {
+                size++;
+            }
+            EXPECT_TRUE(size <= bound);
+        }
+    }
+}
+
 using Entry = std::tuple<int, int>;
 
 std::vector<Entry> getData(unsigned numEntries) {
@@ -0,0 +1,352 @@
+/*
+ * Souffle - A Datalog Compiler
+ * Copyright (c) 2020, The Souffle Developers. All rights reserved
+ * Licensed under the Universal Permissive License v 1.0 as shown at:
+ * - https://opensource.org/licenses/UPL
+ * - <souffle root>/licenses/SOUFFLE-UPL.txt
+ */
+
+/************************************************************************
+ *
+ * @file data_structure_benchmark.cpp
+ *
+ * A micro-benchmark harness for the core data structures, run via
+ * `make benchmark`. It measures insert, lookup and scan throughput of
+ * the b-tree set/multiset, the trie, the equivalence relation and the
+ * symbol table under configurable sizes, arities, thread counts and
+ * key distributions, and reports one CSV row per measurement:
+ *
+ *    structure,operation,arity,size,threads,distribution,seconds,ops_per_sec,bytes_per_tuple
+ *
+ * Unlike the unit tests, this harness checks no results -- it exists to
+ * quantify performance differences between releases.
+ *
+ ***********************************************************************/
+
+#include "BTree.h"
+#include "Brie.h"
+#include "EquivalenceRelation.h"
+#include "SymbolTable.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+#include <getopt.h>
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+using namespace souffle;
+
+namespace {
+
+/** The benchmark parameters, filled in from the command line. */
+struct Config {
+    /** number of tuples inserted per structure */
+    size_t size = 1000000;
+    /** tuple arity for the b-trees and the trie (1..4) */
+    unsigned arity = 2;
+    /** number of OpenMP threads for the parallel phases */
+    unsigned threads = 1;
+    /** key distribution: sequential, shuffled or sparse */
+    std::string dist = "shuffled";
+    /** restrict the run to a single structure; empty runs all */
+    std::string structure;
+};
+
+/**
+ * Generates the keys to be inserted according to the requested
+ * distribution: "sequential" yields 0..N-1 in order, "shuffled" a random
+ * permutation thereof, and "sparse" uniform random draws from the full
+ * 32-bit domain (with duplicates).
+ */
+std::vector<uint64_t> makeKeys(const Config& config) {
+    std::vector<uint64_t> keys(config.size);
+    std::mt19937_64 generator(42);
+    if (config.dist == "sparse") {
+        std::uniform_int_distribution<uint64_t> domain(0, (uint64_t(1) << 32) - 1);
+        for (auto& key : keys) {
+            key = domain(generator);
+        }
+    } else {
+        for (size_t i = 0; i < keys.size(); ++i) {
+            keys[i] = i;
+        }
+        if (config.dist == "shuffled") {
+            std::shuffle(keys.begin(), keys.end(), generator);
+        }
+    }
+    return keys;
+}
+
+/** Splits a key over the columns of a tuple, most significant part first,
+ * so the tuple order follows the key order. */
+template <unsigned Arity>
+ram::Tuple<RamDomain, Arity> makeTuple(uint64_t key) {
+    ram::Tuple<RamDomain, Arity> tuple{};
+    const unsigned shift = 32 / Arity;
+    const uint64_t mask = (uint64_t(1) << shift) - 1;
+    for (unsigned i = 0; i < Arity; ++i) {
+        tuple[i] = static_cast<RamDomain>((key >> ((Arity - i - 1) * shift)) & mask);
+    }
+    return tuple;
+}
+
+/** Prints one CSV measurement row. */
+void report(const Config& config, const std::string& structure, const std::string& operation, unsigned arity,
+        double seconds, size_t bytes) {
+    std::printf("%s,%s,%u,%zu,%u,%s,%.6f,%.0f,%.1f\n", structure.c_str(), operation.c_str(), arity,
+            config.size, config.threads, config.dist.c_str(), seconds,
+            seconds > 0 ? config.size / seconds : 0.0, static_cast<double>(bytes) / config.size);
+}
+
+/** Times the given operation, returning elapsed wall-clock seconds. */
+template <typename Operation>
+double timed(const Operation& operation) {
+    auto start = std::chrono::steady_clock::now();
+    operation();
+    auto end = std::chrono::steady_clock::now();
+    return std::chrono::duration<double>(end - start).count();
+}
+
+/** The shared insert / lookup / scan cycle of the tuple-set structures. */
+template <typename Set, unsigned Arity>
+void benchTupleSet(const Config& config, const std::string& name, const std::vector<uint64_t>& keys) {
+    Set set;
+    double seconds = timed([&]() {
+#ifdef _OPENMP
+#pragma omp parallel num_threads(config.threads)
+        {
+            typename Set::operation_hints hints;
+#pragma omp for
+            for (size_t i = 0; i < keys.size(); ++i) {
+                set.insert(makeTuple<Arity>(keys[i]), hints);
+            }
+        }
+#else
+        typename Set::operation_hints hints;
+        for (size_t i = 0; i < keys.size(); ++i) {
+            set.insert(makeTuple<Arity>(keys[i]), hints);
+        }
+#endif
+    });
+    size_t bytes = set.getMemoryUsage();
+    report(config, name, "insert", Arity, seconds, bytes);
+
+    volatile size_t hits = 0;
+    seconds = timed([&]() {
+        size_t found = 0;
+#ifdef _OPENMP
+#pragma omp parallel num_threads(config.threads) reduction(+ : found)
+        {
+            typename Set::operation_hints hints;
+#pragma omp for
+            for (size_t i = 0; i < keys.size(); ++i) {
+                found += set.contains(makeTuple<Arity>(keys[i]), hints) ? 1 : 0;
+            }
+        }
+#else
+        typename Set::operation_hints hints;
+        for (size_t i = 0; i < keys.size(); ++i) {
+            found += set.contains(makeTuple<Arity>(keys[i]), hints) ? 1 : 0;
+        }
+#endif
+        hits = found;
+    });
+    (void)hits;
+    report(config, name, "lookup", Arity, seconds, bytes);
+
+    volatile RamDomain sink = 0;
+    seconds = timed([&]() {
+        RamDomain sum = 0;
+        for (const auto& tuple : set) {
+            sum += tuple[0];
+        }
+        sink = sum;
+    });
+    (void)sink;
+    report(config, name, "scan", Arity, seconds, bytes);
+}
+
+template <unsigned Arity>
+void benchBTrees(const Config& config, const std::vector<uint64_t>& keys) {
+    benchTupleSet<btree_set<ram::Tuple<RamDomain, Arity>>, Arity>(config, "btree_set", keys);
+    benchTupleSet<btree_multiset<ram::Tuple<RamDomain, Arity>>, Arity>(config, "btree_multiset", keys);
+}
+
+template <unsigned Arity>
+void benchTrie(const Config& config, const std::vector<uint64_t>& keys) {
+    benchTupleSet<Trie<Arity>, Arity>(config, "trie", keys);
+}
+
+void benchEquivalenceRelation(const Config& config, const std::vector<uint64_t>& keys) {
+    using eqrel = EquivalenceRelation<ram::Tuple<RamDomain, 2>>;
+    // group the keys into equivalence classes of ~64 elements so the
+    // structure sees both fresh classes and repeated union operations
+    const RamDomain classes = static_cast<RamDomain>(std::max<size_t>(1, config.size / 64));
+    eqrel relation;
+    double seconds = timed([&]() {
+#ifdef _OPENMP
+#pragma omp parallel for num_threads(config.threads)
+#endif
+        for (size_t i = 0; i < keys.size(); ++i) {
+            relation.insert(static_cast<RamDomain>(keys[i]), static_cast<RamDomain>(keys[i]) % classes);
+        }
+    });
+    size_t bytes = relation.getMemoryUsage();
+    report(config, "eqrel", "insert", 2, seconds, bytes);
+
+    volatile size_t hits = 0;
+    seconds = timed([&]() {
+        size_t found = 0;
+#ifdef _OPENMP
+#pragma omp parallel for num_threads(config.threads) reduction(+ : found)
+#endif
+        for (size_t i = 0; i < keys.size(); ++i) {
+            found += relation.contains(static_cast<RamDomain>(keys[i]),
+                             static_cast<RamDomain>(keys[i]) % classes)
+                             ? 1
+                             : 0;
+        }
+        hits = found;
+    });
+    (void)hits;
+    report(config, "eqrel", "lookup", 2, seconds, bytes);
+}
+
+void benchSymbolTable(const Config& config, const std::vector<uint64_t>& keys) {
+    std::vector<std::string> symbols;
+    symbols.reserve(keys.size());
+    for (auto key : keys) {
+        symbols.push_back("symbol_" + std::to_string(key));
+    }
+
+    SymbolTable table;
+    double seconds = timed([&]() {
+#ifdef _OPENMP
+#pragma omp parallel for num_threads(config.threads)
+#endif
+        for (size_t i = 0; i < symbols.size(); ++i) {
+            table.lookup(symbols[i]);
+        }
+    });
+    size_t bytes = table.getMemoryUsage();
+    report(config, "symbol_table", "insert", 1, seconds, bytes);
+
+    volatile RamDomain sink = 0;
+    seconds = timed([&]() {
+        RamDomain sum = 0;
+#ifdef _OPENMP
+#pragma omp parallel for num_threads(config.threads) reduction(+ : sum)
+#endif
+        for (size_t i = 0; i < symbols.size(); ++i) {
+            sum += table.lookup(symbols[i]);
+        }
+        sink = sum;
+    });
+    (void)sink;
+    report(config, "symbol_table", "lookup", 1, seconds, bytes);
+}
+
+/** Dispatches the compile-time arity of the tuple structures. */
+template <template <unsigned> class Benchmark>
+struct arity_dispatch {
+    static void run(const Config& config, const std::vector<uint64_t>& keys) {
+        switch (config.arity) {
+            case 1: Benchmark<1>::run(config, keys); break;
+            case 2: Benchmark<2>::run(config, keys); break;
+            case 3: Benchmark<3>::run(config, keys); break;
+            case 4: Benchmark<4>::run(config, keys); break;
+            default:
+                std::cerr << "Unsupported arity " << config.arity << "; supported range is 1..4.\n";
+                std::exit(1);
+        }
+    }
+};
+
+template <unsigned Arity>
+struct btree_benchmark {
+    static void run(const Config& config, const std::vector<uint64_t>& keys) {
+        benchBTrees<Arity>(config, keys);
+    }
+};
+
+template <unsigned Arity>
+struct trie_benchmark {
+    static void run(const Config& config, const std::vector<uint64_t>& keys) {
+        benchTrie<Arity>(config, keys);
+    }
+};
+
+void usage(const char* program) {
+    std::cout << "Usage: " << program << " [options]\n"
+              << "  --size <n>        number of tuples to insert (default 1000000)\n"
+              << "  --arity <n>       tuple arity for b-tree and trie, 1..4 (default 2)\n"
+              << "  --threads <n>     number of threads for the parallel phases (default 1)\n"
+              << "  --dist <d>        key distribution: sequential, shuffled or sparse\n"
+              << "                    (default shuffled)\n"
+              << "  --structure <s>   run only the given structure: btree, trie, eqrel or\n"
+              << "                    symbol_table (default: all)\n"
+              << "  --help            print this help message\n";
+}
+
+}  // namespace
+
+int main(int argc, char* argv[]) {
+    Config config;
+
+    option longOptions[] = {{"size", required_argument, nullptr, 's'},
+            {"arity", required_argument, nullptr, 'a'}, {"threads", required_argument, nullptr, 't'},
+            {"dist", required_argument, nullptr, 'd'}, {"structure", required_argument, nullptr, 'r'},
+            {"help", no_argument, nullptr, 'h'}, {nullptr, 0, nullptr, 0}};
+    int c;
+    while ((c = getopt_long(argc, argv, "s:a:t:d:r:h", longOptions, nullptr)) != EOF) {
+        switch (c) {
+            case 's': config.size = std::stoul(optarg); break;
+            case 'a': config.arity = std::stoul(optarg); break;
+            case 't': config.threads = std::stoul(optarg); break;
+            case 'd': config.dist = optarg; break;
+            case 'r': config.structure = optarg; break;
+            case 'h': usage(argv[0]); return 0;
+            default: usage(argv[0]); return 1;
+        }
+    }
+    if (config.dist != "sequential" && config.dist != "shuffled" && config.dist != "sparse") {
+        std::cerr << "Unknown distribution '" << config.dist
+                  << "'; expected sequential, shuffled or sparse.\n";
+        return 1;
+    }
+#ifndef _OPENMP
+    if (config.threads > 1) {
+        std::cerr << "Built without OpenMP; running single-threaded.\n";
+        config.threads = 1;
+    }
+#endif
+
+    auto keys = makeKeys(config);
+    auto selected = [&](const std::string& name) {
+        return config.structure.empty() || config.structure == name;
+    };
+
+    std::printf("structure,operation,arity,size,threads,distribution,seconds,ops_per_sec,bytes_per_tuple\n");
+    if (selected("btree")) {
+        arity_dispatch<btree_benchmark>::run(config, keys);
+    }
+    if (selected("trie")) {
+        arity_dispatch<trie_benchmark>::run(config, keys);
+    }
+    if (selected("eqrel")) {
+        benchEquivalenceRelation(config, keys);
+    }
+    if (selected("symbol_table")) {
+        benchSymbolTable(config, keys);
+    }
+    return 0;
+}
@@ -118,6 +118,16 @@ TEST(PiggyTest, Append) {
     for (size_t i = 3; i < N + 3; ++i) EXPECT_EQ(pl.get(i), 2);
 }
 
+TEST(PiggyTest, MemoryUsage) {
+    souffle::PiggyList<size_t> pl;
+    EXPECT_EQ(pl.getMemoryUsage(), sizeof(pl));
+
+    constexpr size_t N = 10000;
+    for (size_t i = 0; i < N; ++i) pl.append(i);
+    // the reported footprint covers at least the stored elements
+    EXPECT_TRUE(pl.getMemoryUsage() >= sizeof(pl) + N * sizeof(size_t));
+}
+
 TEST(PiggyTest, ElementCreation) {
     // test that we can use makeNode() and set the values properly
     souffle::PiggyList<size_t> pl;
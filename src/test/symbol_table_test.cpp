@@ -28,11 +28,11 @@ TEST(SymbolTable, Basics) {
 
     table.insert("Hello");
 
-    EXPECT_STREQ("Hello", table.resolve(table.lookup(table.resolve(table.lookup("Hello")))));
+    EXPECT_EQ("Hello", table.resolve(table.lookup(table.resolve(table.lookup("Hello")))));
 
     EXPECT_EQ(table.lookup("Hello"), table.lookup(table.resolve(table.lookup("Hello"))));
 
-    EXPECT_STREQ("Hello", table.resolve(table.lookup(table.resolve(table.lookup("Hello")))));
+    EXPECT_EQ("Hello", table.resolve(table.lookup(table.resolve(table.lookup("Hello")))));
 
     EXPECT_EQ(table.lookup("Hello"),
             table.lookup(table.resolve(table.lookup(table.resolve(table.lookup("Hello"))))));
@@ -50,15 +50,15 @@ TEST(SymbolTable, Copy) {
     // hash should be the same
     EXPECT_EQ(a_idx, b_idx);
 
-    EXPECT_STREQ("Hello", a->resolve(a_idx));
-    EXPECT_STREQ("Hello", b->resolve(b_idx));
+    EXPECT_EQ("Hello", a->resolve(a_idx));
+    EXPECT_EQ("Hello", b->resolve(b_idx));
 
     // should be the same actual string
-    EXPECT_STREQ(a->resolve(a_idx), b->resolve(b_idx));
+    EXPECT_EQ(a->resolve(a_idx), b->resolve(b_idx));
 
     // b should survive
     delete a;
-    EXPECT_STREQ("Hello", b->resolve(b_idx));
+    EXPECT_EQ("Hello", b->resolve(b_idx));
 
     delete b;
 }
@@ -80,14 +80,40 @@ TEST(SymbolTable, Assign) {
     EXPECT_EQ(a_idx, b_idx);
     EXPECT_EQ(b_idx, c_idx);
 
-    EXPECT_STREQ("Hello", a->resolve(a_idx));
-    EXPECT_STREQ("Hello", b.resolve(b_idx));
-    EXPECT_STREQ("Hello", c.resolve(c_idx));
+    EXPECT_EQ("Hello", a->resolve(a_idx));
+    EXPECT_EQ("Hello", b.resolve(b_idx));
+    EXPECT_EQ("Hello", c.resolve(c_idx));
 
     // b and c should survive
     delete a;
-    EXPECT_STREQ("Hello", b.resolve(b_idx));
-    EXPECT_STREQ("Hello", c.resolve(c_idx));
+    EXPECT_EQ("Hello", b.resolve(b_idx));
+    EXPECT_EQ("Hello", c.resolve(c_idx));
+}
+
+TEST(SymbolTable, Seed) {
+    SymbolTable base;
+    base.insert("A");
+    base.insert("B");
+    base.insert("C");
+
+    // a fresh instance holding a prefix of the base adopts its ordinals
+    SymbolTable table;
+    table.insert("A");
+    table.seed(base);
+    EXPECT_EQ(base.size(), table.size());
+    EXPECT_EQ(base.lookupExisting("B"), table.lookupExisting("B"));
+    EXPECT_EQ("C", table.resolve(table.lookupExisting("C")));
+
+    // a table whose ordinals disagree with the base is rejected
+    SymbolTable other;
+    other.insert("X");
+    bool rejected = false;
+    try {
+        other.seed(base);
+    } catch (const std::invalid_argument&) {
+        rejected = true;
+    }
+    EXPECT_TRUE(rejected);
 }
 
 TEST(SymbolTable, Inserts) {
@@ -43,6 +43,19 @@ TEST(Table, Basic) {
     EXPECT_EQ(1, count(table));
 }
 
+TEST(Table, MemoryUsage) {
+    Table<int> table;
+    auto empty = table.getMemoryUsage();
+    EXPECT_EQ(sizeof(table), empty);
+
+    for (int i = 0; i < 10000; ++i) {
+        table.insert(i);
+    }
+
+    // the reported footprint covers at least the stored elements
+    EXPECT_TRUE(table.getMemoryUsage() >= empty + 10000 * sizeof(int));
+}
+
 TEST(Table, Stress) {
     for (int i = 0; i < 10000; ++i) {
         Table<int> table;
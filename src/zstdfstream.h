@@ -0,0 +1,296 @@
+/*
+ * Souffle - A Datalog Compiler
+ * Copyright (c) 2019, The Souffle Developers. All rights reserved.
+ * Licensed under the Universal Permissive License v 1.0 as shown at:
+ * - https://opensource.org/licenses/UPL
+ * - <souffle root>/licenses/SOUFFLE-UPL.txt
+ */
+
+/************************************************************************
+ *
+ * @file zstdfstream.h
+ * A simple libzstd wrapper to provide zstd file streams. Compression
+ * uses the multi-threaded streaming interface, overlapping compression
+ * work with tuple formatting for considerably higher throughput than
+ * the single-threaded gzip streams.
+ *
+ ***********************************************************************/
+
+#pragma once
+
+#include <cstdio>
+#include <cstring>
+#include <iostream>
+#include <thread>
+
+#include <zstd.h>
+
+namespace souffle {
+
+namespace zstdfstream {
+
+namespace internal {
+
+class zstdfstreambuf : public std::streambuf {
+public:
+    zstdfstreambuf() {
+        setp(buffer, buffer + (bufferSize - 1));
+        setg(buffer + reserveSize, buffer + reserveSize, buffer + reserveSize);
+    }
+
+    zstdfstreambuf(const zstdfstreambuf&) = delete;
+
+    zstdfstreambuf(zstdfstreambuf&& old) = delete;
+
+    zstdfstreambuf* open(const std::string& filename, std::ios_base::openmode mode) {
+        if (is_open()) {
+            return nullptr;
+        }
+        if (!(mode ^ std::ios::in ^ std::ios::out)) {
+            return nullptr;
+        }
+
+        this->mode = mode;
+        fileHandle = fopen(filename.c_str(), mode & std::ios::in ? "rb" : "wb");
+        if (fileHandle == nullptr) {
+            return nullptr;
+        }
+
+        if (mode & std::ios::in) {
+            dctx = ZSTD_createDCtx();
+        } else {
+            cctx = ZSTD_createCCtx();
+            // let the codec distribute compression over the available
+            // cores; older libzstd builds reject the parameter, which
+            // silently results in single-threaded compression
+            ZSTD_CCtx_setParameter(cctx, ZSTD_c_nbWorkers, std::thread::hardware_concurrency());
+        }
+        chunk.resize(mode & std::ios::in ? ZSTD_DStreamInSize() : ZSTD_CStreamOutSize());
+        input = {chunk.data(), 0, 0};
+        isOpen = true;
+
+        return this;
+    }
+
+    zstdfstreambuf* close() {
+        if (is_open()) {
+            bool ok = sync() == 0;
+            if (mode & std::ios::out) {
+                ok = deflate(0, ZSTD_e_end) && ok;
+                ZSTD_freeCCtx(cctx);
+                cctx = nullptr;
+            } else {
+                ZSTD_freeDCtx(dctx);
+                dctx = nullptr;
+            }
+            isOpen = false;
+            if (fclose(fileHandle) == 0 && ok) {
+                return this;
+            }
+        }
+        return nullptr;
+    }
+
+    bool is_open() const {
+        return isOpen;
+    }
+
+    ~zstdfstreambuf() override {
+        try {
+            close();
+        } catch (...) {
+            // Don't throw exceptions.
+        }
+    }
+
+protected:
+    int_type overflow(int c = EOF) override {
+        if (!(mode & std::ios::out) || !isOpen) {
+            return EOF;
+        }
+
+        if (c != EOF) {
+            *pptr() = c;
+            pbump(1);
+        }
+        int toWrite = pptr() - pbase();
+        if (!deflate(toWrite, ZSTD_e_continue)) {
+            return EOF;
+        }
+        pbump(-toWrite);
+
+        return c;
+    }
+
+    int_type underflow() override {
+        if (!(mode & std::ios::in) || !isOpen) {
+            return EOF;
+        }
+        if (gptr() && (gptr() < egptr())) {
+            return traits_type::to_int_type(*gptr());
+        }
+
+        unsigned charsPutBack = gptr() - eback();
+        if (charsPutBack > reserveSize) {
+            charsPutBack = reserveSize;
+        }
+        memcpy(buffer + reserveSize - charsPutBack, gptr() - charsPutBack, charsPutBack);
+
+        // decompress until some plain data is available
+        ZSTD_outBuffer output = {buffer + reserveSize, bufferSize - reserveSize, 0};
+        while (output.pos == 0) {
+            if (input.pos == input.size) {
+                input.size = fread(chunk.data(), 1, chunk.size(), fileHandle);
+                input.pos = 0;
+                if (input.size == 0) {
+                    break;
+                }
+            }
+            if (ZSTD_isError(ZSTD_decompressStream(dctx, &output, &input))) {
+                return EOF;
+            }
+        }
+        if (output.pos == 0) {
+            return EOF;
+        }
+
+        setg(buffer + reserveSize - charsPutBack, buffer + reserveSize,
+                buffer + reserveSize + output.pos);
+
+        return traits_type::to_int_type(*gptr());
+    }
+
+    int sync() override {
+        if (pptr() && pptr() > pbase()) {
+            int toWrite = pptr() - pbase();
+            if (!deflate(toWrite, ZSTD_e_continue)) {
+                return -1;
+            }
+            pbump(-toWrite);
+        }
+        return 0;
+    }
+
+private:
+    /**
+     * Feeds the given number of bytes of the put area into the
+     * compressor, writing all produced compressed data to the file. An
+     * end directive flushes and finalizes the frame.
+     */
+    bool deflate(int toWrite, ZSTD_EndDirective endOp) {
+        ZSTD_inBuffer in = {pbase(), static_cast<size_t>(toWrite), 0};
+        size_t remaining = 0;
+        do {
+            ZSTD_outBuffer out = {chunk.data(), chunk.size(), 0};
+            remaining = ZSTD_compressStream2(cctx, &out, &in, endOp);
+            if (ZSTD_isError(remaining)) {
+                return false;
+            }
+            if (fwrite(chunk.data(), 1, out.pos, fileHandle) != out.pos) {
+                return false;
+            }
+        } while (endOp == ZSTD_e_end ? remaining != 0 : in.pos < in.size);
+        return true;
+    }
+
+    static constexpr unsigned int bufferSize = 65536;
+    static constexpr unsigned int reserveSize = 16;
+
+    char buffer[bufferSize] = {};
+    std::string chunk;
+    ZSTD_inBuffer input = {};
+    FILE* fileHandle = nullptr;
+    ZSTD_CCtx* cctx = nullptr;
+    ZSTD_DCtx* dctx = nullptr;
+    bool isOpen = false;
+    std::ios_base::openmode mode = std::ios_base::in;
+};
+
+class zstdfstream : virtual public std::ios {
+public:
+    zstdfstream() {
+        init(&buf);
+    }
+
+    zstdfstream(const std::string& filename, std::ios_base::openmode mode) {
+        init(&buf);
+        open(filename, mode);
+    }
+
+    zstdfstream(const zstdfstream&) = delete;
+
+    zstdfstream(zstdfstream&&) = delete;
+
+    ~zstdfstream() override = default;
+
+    void open(const std::string& filename, std::ios_base::openmode mode) {
+        if (!buf.open(filename, mode)) {
+            clear(rdstate() | std::ios::badbit);
+        }
+    }
+
+    bool is_open() {
+        return buf.is_open();
+    }
+
+    void close() {
+        if (buf.is_open()) {
+            if (!buf.close()) {
+                clear(rdstate() | std::ios::badbit);
+            }
+        }
+    }
+
+    zstdfstreambuf* rdbuf() const {
+        return &buf;
+    }
+
+protected:
+    mutable zstdfstreambuf buf;
+};
+
+}  // namespace internal
+
+class izstdfstream : public internal::zstdfstream, public std::istream {
+public:
+    izstdfstream() : internal::zstdfstream(), std::istream(&buf) {}
+
+    explicit izstdfstream(const std::string& filename, std::ios_base::openmode mode = std::ios::in)
+            : internal::zstdfstream(filename, mode), std::istream(&buf) {}
+
+    izstdfstream(const izstdfstream&) = delete;
+
+    izstdfstream(izstdfstream&&) = delete;
+
+    internal::zstdfstreambuf* rdbuf() const {
+        return internal::zstdfstream::rdbuf();
+    }
+
+    void open(const std::string& filename, std::ios_base::openmode mode = std::ios::in) {
+        internal::zstdfstream::open(filename, mode);
+    }
+};
+
+class ozstdfstream : public internal::zstdfstream, public std::ostream {
+public:
+    ozstdfstream() : std::ostream(&buf) {}
+
+    explicit ozstdfstream(const std::string& filename, std::ios_base::openmode mode = std::ios::out)
+            : internal::zstdfstream(filename, mode), std::ostream(&buf) {}
+
+    ozstdfstream(const ozstdfstream&) = delete;
+
+    ozstdfstream(ozstdfstream&&) = delete;
+
+    internal::zstdfstreambuf* rdbuf() const {
+        return internal::zstdfstream::rdbuf();
+    }
+
+    void open(const std::string& filename, std::ios_base::openmode mode = std::ios::out) {
+        internal::zstdfstream::open(filename, mode);
+    }
+};
+
+} /* namespace zstdfstream */
+
+} /* namespace souffle */
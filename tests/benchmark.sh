@@ -0,0 +1,125 @@
+#!/bin/bash
+
+# Souffle - A Datalog Compiler
+# Copyright (c) 2020, The Souffle Developers. All rights reserved
+# Licensed under the Universal Permissive License v 1.0 as shown at:
+# - https://opensource.org/licenses/UPL
+# - <souffle root>/licenses/SOUFFLE-UPL.txt
+
+# End-to-end engine benchmarks over the tests/ corpus, run via
+# `make -C tests benchmark`. Executes a designated subset of the
+# evaluation cases in both interpreter and compiled mode, records wall
+# time and peak RSS into a tab-separated report, and keeps the profile
+# log plus its per-relation timing breakdown of every run next to the
+# report so engine-level regressions can be tracked release to release.
+#
+# Usage: benchmark.sh [-s souffle] [-p souffle-profile] [-d report-dir]
+#                     [-n repeats] [-j threads] [case ...]
+
+set -u
+
+# the recursion-heavy evaluation cases and the graph workloads; override
+# by naming cases on the command line
+DEFAULT_CASES="mrtc match match2 match3 magic_samegen count_sccs1 components recursion rmut"
+
+TESTS_DIR="$(cd "$(dirname "$0")" && pwd)"
+SOUFFLE="souffle"
+SOUFFLE_PROFILE=""
+REPORT_DIR="benchmark-report-$(date +%Y%m%d-%H%M%S)"
+REPEATS=1
+THREADS=1
+
+while getopts "s:p:d:n:j:h" flag; do
+    case "$flag" in
+        s) SOUFFLE="$OPTARG" ;;
+        p) SOUFFLE_PROFILE="$OPTARG" ;;
+        d) REPORT_DIR="$OPTARG" ;;
+        n) REPEATS="$OPTARG" ;;
+        j) THREADS="$OPTARG" ;;
+        *)
+            echo "Usage: $0 [-s souffle] [-p souffle-profile] [-d report-dir] [-n repeats] [-j threads] [case ...]"
+            exit 1
+            ;;
+    esac
+done
+shift $((OPTIND - 1))
+CASES="${*:-$DEFAULT_CASES}"
+
+if ! "$SOUFFLE" --version >/dev/null 2>&1; then
+    echo "Error: cannot execute souffle binary '$SOUFFLE'; pass it with -s." >&2
+    exit 1
+fi
+# default the profiler to the directory of the souffle binary
+if [ -z "$SOUFFLE_PROFILE" ]; then
+    SOUFFLE_PROFILE="$(dirname "$SOUFFLE")/souffle-profile"
+fi
+# GNU time provides the peak RSS; without it only wall time is recorded
+GNU_TIME=""
+if /usr/bin/time -f '%e %M' true >/dev/null 2>&1; then
+    GNU_TIME="/usr/bin/time"
+fi
+
+mkdir -p "$REPORT_DIR"
+REPORT="$REPORT_DIR/report.tsv"
+printf 'case\tmode\trun\twall_seconds\tpeak_rss_kb\texit\n' > "$REPORT"
+
+# run one case in one mode and append its report row
+# $1 -- case name, $2 -- mode (interpreter or compiled), $3 -- run number
+run_one() {
+    local name="$1" mode="$2" run="$3"
+    local dir="$TESTS_DIR/evaluation/$name"
+    local facts="$dir"
+    [ -d "$dir/facts" ] && facts="$dir/facts"
+    local tag="$name-$mode-$run"
+    local out="$REPORT_DIR/$tag.out"
+    local log="$REPORT_DIR/$tag.log"
+    local flags="-j$THREADS"
+    [ "$mode" = "compiled" ] && flags="$flags -c"
+
+    mkdir -p "$out"
+    local wall rss status
+    if [ -n "$GNU_TIME" ]; then
+        local measurefile measurement
+        measurefile=$(mktemp)
+        "$GNU_TIME" -f '%e %M' -o "$measurefile" "$SOUFFLE" $flags -F "$facts" -D "$out" -p "$log" \
+                "$dir/$name.dl" >/dev/null 2>"$REPORT_DIR/$tag.err"
+        status=$?
+        measurement=$(tail -n 1 "$measurefile")
+        rm -f "$measurefile"
+        wall=$(echo "$measurement" | cut -d' ' -f1)
+        rss=$(echo "$measurement" | cut -d' ' -f2)
+    else
+        local start end
+        start=$(date +%s.%N)
+        "$SOUFFLE" $flags -F "$facts" -D "$out" -p "$log" "$dir/$name.dl" >/dev/null \
+                2>"$REPORT_DIR/$tag.err"
+        status=$?
+        end=$(date +%s.%N)
+        wall=$(echo "$start $end" | awk '{printf "%.2f", $2 - $1}')
+        rss="-"
+    fi
+    printf '%s\t%s\t%s\t%s\t%s\t%s\n' "$name" "$mode" "$run" "$wall" "$rss" "$status" >> "$REPORT"
+
+    # keep the per-relation timing breakdown of the run; the profile log
+    # has no stratum boundaries, so the relation table is the per-stage
+    # drilldown of record
+    if [ "$status" -eq 0 ] && [ -x "$SOUFFLE_PROFILE" ]; then
+        "$SOUFFLE_PROFILE" "$log" -c rel > "$REPORT_DIR/$tag.rel.txt" 2>/dev/null
+    fi
+    echo "  $name ($mode, run $run): ${wall}s, rss ${rss}kB, exit $status"
+}
+
+for name in $CASES; do
+    if [ ! -f "$TESTS_DIR/evaluation/$name/$name.dl" ]; then
+        echo "Warning: skipping unknown case '$name'." >&2
+        continue
+    fi
+    echo "Benchmarking $name ..."
+    for mode in interpreter compiled; do
+        for run in $(seq 1 "$REPEATS"); do
+            run_one "$name" "$mode" "$run"
+        done
+    done
+done
+
+echo "Report written to $REPORT"